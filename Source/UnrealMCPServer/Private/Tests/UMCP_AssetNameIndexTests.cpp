@@ -0,0 +1,51 @@
+#include "UMCP_AssetNameIndex.h" // For FUMCP_AssetNameIndex
+#include "Tests/TestHarnessAdapter.h" // For TEST_CASE_NAMED and CHECK_MESSAGE
+#include "AssetRegistry/IAssetRegistry.h"
+
+#if WITH_TESTS
+
+TEST_CASE_NAMED(FUMCP_AssetNameIndexTests_FindPackages, "Plugin.MCP.AssetNameIndex::FindPackages", "[AssetNameIndex][SmokeFilter]")
+{
+	// The build only starts once the AssetRegistry scan is done, which it isn't while the editor is still starting up
+	IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+	if (!AssetRegistry || AssetRegistry->IsLoadingAssets())
+	{
+		return;
+	}
+
+	FUMCP_AssetNameIndex Index;
+	TSet<FName> PackageNames;
+	CHECK_MESSAGE(TEXT("An index that isn't built should not answer lookups."), !Index.FindPackages(FUMCP_AssetNameIndex::EField::PackageName, TEXT("Cube"), PackageNames));
+
+	Index.Initialize();
+	const double Deadline = FPlatformTime::Seconds() + 120.0;
+	while (!Index.IsReady() && FPlatformTime::Seconds() < Deadline)
+	{
+		FPlatformProcess::Sleep(0.01f);
+	}
+	CHECK_MESSAGE(TEXT("The index should finish building."), Index.IsReady());
+
+	// Engine content that ships with every engine
+	const FName CubePackageName(TEXT("/Engine/BasicShapes/Cube"));
+	CHECK_MESSAGE(TEXT("Substring lookups should ignore case."), Index.FindPackages(FUMCP_AssetNameIndex::EField::PackageName, TEXT("basicSHAPES/cub"), PackageNames) && PackageNames.Contains(CubePackageName));
+	PackageNames.Reset();
+	Index.FindPackages(FUMCP_AssetNameIndex::EField::PackageName, TEXT("/Engine/BasicShapes/C*e"), PackageNames);
+	CHECK_MESSAGE(TEXT("Wildcard lookups should match the whole name."), PackageNames.Contains(CubePackageName));
+	PackageNames.Reset();
+	Index.FindPackages(FUMCP_AssetNameIndex::EField::PackageName, TEXT("BasicShapes/Cube*"), PackageNames);
+	CHECK_MESSAGE(TEXT("Wildcard lookups should not match the middle of the name."), !PackageNames.Contains(CubePackageName));
+	PackageNames.Reset();
+	Index.FindPackages(FUMCP_AssetNameIndex::EField::AssetName, TEXT("Cu"), PackageNames);
+	CHECK_MESSAGE(TEXT("Patterns shorter than a trigram should still match."), PackageNames.Contains(CubePackageName));
+	PackageNames.Reset();
+	Index.FindPackages(FUMCP_AssetNameIndex::EField::AssetName, TEXT("UMCP_NoAssetHasThisName"), PackageNames);
+	CHECK_MESSAGE(TEXT("A pattern nothing contains should match nothing."), PackageNames.Num() == 0);
+
+	const FUMCP_AssetNameIndexStats Stats = Index.GetStats();
+	CHECK_MESSAGE(TEXT("Stats should report the indexed assets."), Stats.bReady && Stats.NumAssets > 0 && Stats.NumTrigrams > 0 && Stats.MemoryBytes > 0);
+
+	Index.Shutdown();
+	CHECK_MESSAGE(TEXT("Shutdown should drop the index."), !Index.IsReady() && Index.GetStats().NumAssets == 0);
+}
+
+#endif //WITH_TESTS
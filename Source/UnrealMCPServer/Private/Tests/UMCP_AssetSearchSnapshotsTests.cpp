@@ -0,0 +1,53 @@
+#include "UMCP_AssetSearchSnapshots.h" // For FUMCP_AssetSearchSnapshots
+#include "Tests/TestHarnessAdapter.h" // For TEST_CASE_NAMED and CHECK_MESSAGE
+
+#if WITH_TESTS
+
+TEST_CASE_NAMED(FUMCP_AssetSearchSnapshotsTests_CursorsAndBudget, "Plugin.MCP.AssetSearchSnapshots::CursorsAndBudget", "[AssetSearchSnapshots][SmokeFilter]")
+{
+	auto MakeAssets = [](int32 NumAssets)
+	{
+		TArray<FAssetData> Assets;
+		for (int32 Index = 0; Index < NumAssets; ++Index)
+		{
+			Assets.Add(FAssetData(FName(*FString::Printf(TEXT("/Game/UMCP_SnapshotTest/Asset%d"), Index)), FName(TEXT("/Game/UMCP_SnapshotTest")), FName(*FString::Printf(TEXT("Asset%d"), Index)), FTopLevelAssetPath(TEXT("/Script/Engine"), TEXT("Texture2D"))));
+		}
+		return Assets;
+	};
+	TSharedPtr<FJsonObject> Arguments = MakeShared<FJsonObject>();
+	Arguments->SetStringField(TEXT("searchTerm"), TEXT("Asset"));
+
+	// Room for one snapshot of 100 assets, but not two
+	const int64 SnapshotBytes = MakeAssets(100).GetAllocatedSize() + sizeof(FUMCP_AssetSearchSnapshot);
+	FUMCP_AssetSearchSnapshots Snapshots;
+	Snapshots.Initialize(SnapshotBytes + SnapshotBytes / 2, 300.0);
+
+	const FString Cursor = Snapshots.CreateSnapshot(TEXT("search_assets"), Arguments, Snapshots.GetRegistryGeneration(), MakeAssets(100), 10);
+	CHECK_MESSAGE(TEXT("A snapshot within the budget should return a cursor."), !Cursor.IsEmpty());
+
+	int32 Offset = -1;
+	FString Error;
+	TSharedPtr<const FUMCP_AssetSearchSnapshot> Snapshot = Snapshots.FindSnapshot(TEXT("search_assets"), Cursor, Offset, Error);
+	CHECK_MESSAGE(TEXT("The cursor should find its snapshot."), Snapshot.IsValid() && Snapshot->Assets.Num() == 100 && Offset == 10);
+	CHECK_MESSAGE(TEXT("The snapshot should keep the search arguments."), Snapshot.IsValid() && Snapshot->Arguments->GetStringField(TEXT("searchTerm")) == TEXT("Asset"));
+	if (Snapshot.IsValid())
+	{
+		Snapshots.FindSnapshot(TEXT("search_assets"), FUMCP_AssetSearchSnapshots::MakeCursor(*Snapshot, 20), Offset, Error);
+		CHECK_MESSAGE(TEXT("A cursor made from the snapshot should carry its offset."), Offset == 20);
+	}
+
+	CHECK_MESSAGE(TEXT("A cursor should not be usable by another tool."), !Snapshots.FindSnapshot(TEXT("search_blueprints"), Cursor, Offset, Error).IsValid() && !Error.IsEmpty());
+	CHECK_MESSAGE(TEXT("A malformed cursor should be rejected."), !Snapshots.FindSnapshot(TEXT("search_assets"), TEXT("not a cursor"), Offset, Error).IsValid() && Error == TEXT("Invalid cursor"));
+	CHECK_MESSAGE(TEXT("A snapshot over the budget should not return a cursor."), Snapshots.CreateSnapshot(TEXT("search_assets"), Arguments, Snapshots.GetRegistryGeneration(), MakeAssets(1000), 10).IsEmpty());
+	CHECK_MESSAGE(TEXT("A snapshot of a search from an older registry generation should not return a cursor."), Snapshots.CreateSnapshot(TEXT("search_assets"), Arguments, Snapshots.GetRegistryGeneration() - 1, MakeAssets(10), 5).IsEmpty());
+
+	// A second snapshot of the same size evicts the first
+	const FString SecondCursor = Snapshots.CreateSnapshot(TEXT("search_assets"), Arguments, Snapshots.GetRegistryGeneration(), MakeAssets(100), 10);
+	CHECK_MESSAGE(TEXT("Going over the budget should evict the least recently used snapshot."), !SecondCursor.IsEmpty() && !Snapshots.FindSnapshot(TEXT("search_assets"), Cursor, Offset, Error).IsValid());
+	CHECK_MESSAGE(TEXT("Snapshots held by a caller should outlive their eviction."), !Snapshot.IsValid() || Snapshot->Assets.Num() == 100);
+
+	Snapshots.Shutdown();
+	CHECK_MESSAGE(TEXT("Shutdown should release every snapshot."), !Snapshots.FindSnapshot(TEXT("search_assets"), SecondCursor, Offset, Error).IsValid());
+}
+
+#endif //WITH_TESTS
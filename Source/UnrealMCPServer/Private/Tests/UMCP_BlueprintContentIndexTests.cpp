@@ -0,0 +1,56 @@
+#include "UMCP_BlueprintContentIndex.h" // For FUMCP_BlueprintContentIndex
+#include "Tests/TestHarnessAdapter.h" // For TEST_CASE_NAMED and CHECK_MESSAGE
+#include "AssetRegistry/IAssetRegistry.h"
+#include "EdGraph/EdGraph.h"
+#include "Engine/Blueprint.h"
+#include "UObject/Package.h"
+
+#if WITH_TESTS
+
+TEST_CASE_NAMED(FUMCP_BlueprintContentIndexTests_AddAndFind, "Plugin.MCP.BlueprintContentIndex::AddAndFind", "[BlueprintContentIndex][SmokeFilter]")
+{
+	IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+	if (!AssetRegistry || AssetRegistry->IsLoadingAssets())
+	{
+		return;
+	}
+
+	// A Blueprint that only exists in memory, so nothing on disk is touched and it is never written to the index file
+	UPackage* Package = CreatePackage(TEXT("/Temp/UMCP_BlueprintContentIndexTest"));
+	Package->SetDirtyFlag(false);
+	UBlueprint* Blueprint = NewObject<UBlueprint>(Package, TEXT("BP_UMCP_ContentIndexTest"), RF_Transient);
+	FBPVariableDescription Variable;
+	Variable.VarName = TEXT("UMCP_TestHealth");
+	Blueprint->NewVariables.Add(Variable);
+	Blueprint->FunctionGraphs.Add(NewObject<UEdGraph>(Blueprint, TEXT("UMCP_TestTakeDamage"), RF_Transient));
+
+	FUMCP_BlueprintContentIndex Index;
+	Index.Initialize();
+	const FName PackageName = Package->GetFName();
+	CHECK_MESSAGE(TEXT("A Blueprint that was never added should not be indexed."), !Index.IsIndexed(PackageName));
+
+	Index.AddBlueprint(Blueprint);
+	CHECK_MESSAGE(TEXT("An added Blueprint should be indexed."), Index.IsIndexed(PackageName));
+
+	TSet<FName> PackageNames;
+	Index.FindPackages(FUMCP_BlueprintContentIndex::EKind::Variable, TEXT("testHEALTH"), PackageNames);
+	CHECK_MESSAGE(TEXT("Variable lookups should match part of the name, ignoring case."), PackageNames.Contains(PackageName));
+	PackageNames.Reset();
+	Index.FindPackages(FUMCP_BlueprintContentIndex::EKind::Event, TEXT("UMCP_TestHealth"), PackageNames);
+	CHECK_MESSAGE(TEXT("Lookups should only match items of the requested kind."), !PackageNames.Contains(PackageName));
+
+	TArray<FUMCP_BlueprintContentIndex::FItem> Items;
+	Index.GetItems(PackageName, FUMCP_BlueprintContentIndex::EKind::Function, TEXT("TakeDamage"), Items);
+	CHECK_MESSAGE(TEXT("Function graphs should be indexed as function definitions."), Items.Num() == 1 && Items[0].Name == TEXT("UMCP_TestTakeDamage") && !Items[0].bReference);
+
+	const FUMCP_BlueprintContentIndexStats Stats = Index.GetStats();
+	CHECK_MESSAGE(TEXT("Stats should report the indexed Blueprint."), Stats.NumBlueprints > 0 && Stats.NumItems >= 2 && Stats.MemoryBytes > 0);
+
+	Index.Shutdown();
+	CHECK_MESSAGE(TEXT("Shutdown should drop the index."), !Index.IsIndexed(PackageName) && Index.GetStats().NumBlueprints == 0);
+
+	Blueprint->MarkAsGarbage();
+	Package->MarkAsGarbage();
+}
+
+#endif //WITH_TESTS
@@ -0,0 +1,73 @@
+#include "UMCP_DependencyGraph.h" // For FUMCP_DependencyGraph
+#include "Tests/TestHarnessAdapter.h" // For TEST_CASE_NAMED and CHECK_MESSAGE
+#include "AssetRegistry/IAssetRegistry.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+
+#if WITH_TESTS
+
+TEST_CASE_NAMED(FUMCP_DependencyGraphTests_SnapshotAndFile, "Plugin.MCP.DependencyGraph::SnapshotAndFile", "[DependencyGraph][SmokeFilter]")
+{
+	// Snapshots are refused while the AssetRegistry is still scanning, which it is while the editor is starting up
+	IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+	if (!AssetRegistry || AssetRegistry->IsLoadingAssets())
+	{
+		return;
+	}
+
+	FUMCP_DependencyGraph Graph;
+	Graph.Initialize();
+	FString Error;
+	TSharedPtr<const FUMCP_DependencyGraphSnapshot> Snapshot = Graph.GetSnapshot(Error);
+	CHECK_MESSAGE(TEXT("A snapshot should be built once the registry has loaded."), Snapshot.IsValid() && Error.IsEmpty());
+	if (!Snapshot.IsValid())
+	{
+		return;
+	}
+
+	// Engine content that ships with every engine
+	const int32* CubeNode = Snapshot->PackageIndices.Find(FName(TEXT("/Engine/BasicShapes/Cube")));
+	CHECK_MESSAGE(TEXT("Packages with assets should be nodes."), CubeNode && (Snapshot->NodeFlags[*CubeNode] & FUMCP_DependencyGraphSnapshot::Node_HasAssets) != 0);
+
+	bool bWellFormed = Snapshot->Offsets.Num() == Snapshot->Packages.Num() + 1 && Snapshot->Offsets.Last() == Snapshot->Targets.Num() && Snapshot->EdgeFlags.Num() == Snapshot->Targets.Num();
+	for (int32 Node = 0; bWellFormed && Node < Snapshot->Packages.Num(); ++Node)
+	{
+		for (int32 Edge = Snapshot->Offsets[Node]; Edge < Snapshot->Offsets[Node + 1]; ++Edge)
+		{
+			bWellFormed &= Snapshot->Targets[Edge] >= 0 && Snapshot->Targets[Edge] < Snapshot->Packages.Num() && Snapshot->EdgeFlags[Edge] != 0;
+			bWellFormed &= Edge == Snapshot->Offsets[Node] || Snapshot->Targets[Edge - 1] < Snapshot->Targets[Edge];
+		}
+	}
+	CHECK_MESSAGE(TEXT("Each node's edges should be distinct, flagged and point at nodes."), bWellFormed);
+
+	CHECK_MESSAGE(TEXT("An unchanged registry should return the same snapshot."), Graph.GetSnapshot(Error) == Snapshot || Graph.GetGeneration() != Snapshot->Generation);
+	TArray<FName> ChangedPackageNames;
+	CHECK_MESSAGE(TEXT("Deltas should be available from the first snapshot on."), Graph.GetChangedPackages(Snapshot->Generation, ChangedPackageNames));
+	CHECK_MESSAGE(TEXT("Deltas from before the first snapshot should be refused."), !Graph.GetChangedPackages(Snapshot->Generation - 1, ChangedPackageNames));
+
+	FString FilePath;
+	int64 FileBytes = 0;
+	CHECK_MESSAGE(TEXT("The snapshot should be written to a file."), Graph.SaveSnapshot(*Snapshot, FilePath, FileBytes, Error) && FileBytes > 32);
+	TArray<uint8> FileData;
+	if (FFileHelper::LoadFileToArray(FileData, *FilePath) && FileData.Num() >= 32)
+	{
+		uint32 NumNodes = 0;
+		uint32 NumEdges = 0;
+		int64 Generation = 0;
+		FMemory::Memcpy(&NumNodes, FileData.GetData() + 12, sizeof(NumNodes));
+		FMemory::Memcpy(&NumEdges, FileData.GetData() + 16, sizeof(NumEdges));
+		FMemory::Memcpy(&Generation, FileData.GetData() + 24, sizeof(Generation));
+		CHECK_MESSAGE(TEXT("The file should start with the magic."), FMemory::Memcmp(FileData.GetData(), "UMCPDEPG", 8) == 0);
+		CHECK_MESSAGE(TEXT("The file header should match the snapshot."), NumNodes == static_cast<uint32>(Snapshot->Packages.Num()) && NumEdges == static_cast<uint32>(Snapshot->Targets.Num()) && Generation == Snapshot->Generation && FileData.Num() == FileBytes);
+	}
+	else
+	{
+		CHECK_MESSAGE(TEXT("The snapshot file should be readable."), false);
+	}
+	IFileManager::Get().Delete(*FilePath);
+
+	Graph.Shutdown();
+	CHECK_MESSAGE(TEXT("Shutdown should drop the snapshot."), Graph.GetStats().NumPackages == 0);
+}
+
+#endif //WITH_TESTS
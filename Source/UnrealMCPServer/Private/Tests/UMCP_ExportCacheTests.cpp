@@ -0,0 +1,149 @@
+#include "UMCP_ExportCache.h" // For FUMCP_ExportCache
+#include "UMCP_PackageChangeNotifier.h" // For FUMCP_PackageChangeNotifier
+#include "Tests/TestHarnessAdapter.h" // For TEST_CASE_NAMED and CHECK_MESSAGE
+
+#if WITH_TESTS
+
+TEST_CASE_NAMED(FUMCP_ExportCacheTests_HitsMissesAndEviction, "Plugin.MCP.ExportCache::HitsMissesAndEviction", "[ExportCache][SmokeFilter]")
+{
+	// Paths of packages that don't exist, so no editor event can invalidate them during the test
+	const FString PathA = TEXT("/Game/UMCP_ExportCacheTest/A.A");
+	const FString PathB = TEXT("/Game/UMCP_ExportCacheTest/B.B");
+	const FString PathC = TEXT("/Game/UMCP_ExportCacheTest/C.C");
+	const FString ExportedText = FString::ChrN(100, TEXT('x'));
+
+	int32 NumExports = 0;
+	auto Export = [&NumExports, &ExportedText](FString& OutText, FString& OutError)
+	{
+		NumExports++;
+		OutText = ExportedText;
+		return true;
+	};
+	auto FailingExport = [&NumExports](FString& OutText, FString& OutError)
+	{
+		NumExports++;
+		OutError = TEXT("Export failed");
+		return false;
+	};
+
+	// Room for two entries of ~100 characters each, but not three
+	FUMCP_ExportCache Cache;
+	Cache.Initialize(2 * 160 * sizeof(TCHAR), 0);
+
+	FString Text;
+	FString Error;
+	CHECK_MESSAGE(TEXT("A miss should run the export."), Cache.GetOrExport(PathA, TEXT("T3D"), Export, Text, Error) && NumExports == 1 && Text == ExportedText);
+	CHECK_MESSAGE(TEXT("A hit should not run the export."), Cache.GetOrExport(PathA, TEXT("T3D"), Export, Text, Error) && NumExports == 1 && Text == ExportedText);
+	CHECK_MESSAGE(TEXT("Formats should be cached separately."), Cache.GetOrExport(PathA, TEXT("md"), Export, Text, Error) && NumExports == 2);
+
+	CHECK_MESSAGE(TEXT("Failed exports should be reported."), !Cache.GetOrExport(PathB, TEXT("T3D"), FailingExport, Text, Error) && Error == TEXT("Export failed"));
+	CHECK_MESSAGE(TEXT("Failed exports should not be cached."), !Cache.GetOrExport(PathB, TEXT("T3D"), FailingExport, Text, Error) && NumExports == 4);
+
+	FUMCP_ExportCacheStats Stats = Cache.GetStats();
+	CHECK_MESSAGE(TEXT("Hits should be counted."), Stats.Hits == 1);
+	CHECK_MESSAGE(TEXT("Misses should be counted, failed exports included."), Stats.Misses == 4);
+	CHECK_MESSAGE(TEXT("Only successful exports should be kept."), Stats.NumEntries == 2 && Stats.Evictions == 0);
+
+	// Touching A T3D makes A md the least recently used entry, so C evicts it
+	Cache.GetOrExport(PathA, TEXT("T3D"), Export, Text, Error);
+	Cache.GetOrExport(PathC, TEXT("T3D"), Export, Text, Error);
+	Stats = Cache.GetStats();
+	CHECK_MESSAGE(TEXT("Going over the budget should evict."), Stats.Evictions == 1 && Stats.NumEntries == 2);
+	CHECK_MESSAGE(TEXT("The memory in use should stay within the budget."), Stats.MemoryBytes <= 2 * 160 * static_cast<int64>(sizeof(TCHAR)));
+	const int32 NumExportsBefore = NumExports;
+	Cache.GetOrExport(PathA, TEXT("T3D"), Export, Text, Error);
+	CHECK_MESSAGE(TEXT("The most recently used entry should survive eviction."), NumExports == NumExportsBefore);
+	Cache.GetOrExport(PathA, TEXT("md"), Export, Text, Error);
+	CHECK_MESSAGE(TEXT("The least recently used entry should be evicted."), NumExports == NumExportsBefore + 1);
+
+	Cache.Shutdown();
+	CHECK_MESSAGE(TEXT("Shutdown should release every entry."), Cache.GetStats().NumEntries == 0 && Cache.GetStats().MemoryBytes == 0);
+	CHECK_MESSAGE(TEXT("A shut down cache should always run the export."), Cache.GetOrExport(PathA, TEXT("T3D"), Export, Text, Error) && NumExports == NumExportsBefore + 2);
+}
+
+TEST_CASE_NAMED(FUMCP_ExportCacheTests_Slices, "Plugin.MCP.ExportCache::Slices", "[ExportCache][SmokeFilter]")
+{
+	const FString Path = TEXT("/Game/UMCP_ExportCacheTest/Sliced.Sliced");
+	const FString ExportedText = TEXT("aaaa|bbbbbb|cc");
+	int32 NumExports = 0;
+	auto Export = [&NumExports, &ExportedText](FString& OutText, FString& OutError)
+	{
+		NumExports++;
+		OutText = ExportedText;
+		return true;
+	};
+	int32 NumBlockSearches = 0;
+	const FUMCP_ExportCache::FBlockFinder FindBlocks = [&NumBlockSearches](FStringView Text, TArray<int32>& OutBlockStarts)
+	{
+		NumBlockSearches++;
+		OutBlockStarts = { 0, 5, 12 };
+	};
+
+	FUMCP_ExportCache Cache;
+	Cache.Initialize(1024 * 1024, 0);
+
+	FUMCP_ExportRange Range;
+	Range.Offset = 2;
+	Range.Length = 6;
+	FUMCP_ExportSlice Slice;
+	FString Error;
+	CHECK_MESSAGE(TEXT("A miss should run the export and slice it."), Cache.GetOrExportSlice(Path, TEXT("T3D"), Export, Range, nullptr, Slice, Error) && NumExports == 1 && Slice.Text == TEXT("aa|bbb"));
+	CHECK_MESSAGE(TEXT("The slice should report where it is."), Slice.Offset == 2 && Slice.Length == 6 && Slice.TotalLength == ExportedText.Len() && Slice.NumBlocks == 0);
+
+	Range.Offset = 10;
+	CHECK_MESSAGE(TEXT("The next chunk should come from the cache, cut at the end."), Cache.GetOrExportSlice(Path, TEXT("T3D"), Export, Range, nullptr, Slice, Error) && NumExports == 1 && Slice.Text == TEXT("b|cc") && Slice.Length == 4);
+	Range.Offset = ExportedText.Len() + 1;
+	CHECK_MESSAGE(TEXT("An offset past the end should fail."), !Cache.GetOrExportSlice(Path, TEXT("T3D"), Export, Range, nullptr, Slice, Error) && !Error.IsEmpty());
+	Range.Offset = 0;
+	Range.Length = 0;
+	CHECK_MESSAGE(TEXT("An empty range should fail."), !Cache.GetOrExportSlice(Path, TEXT("T3D"), Export, Range, nullptr, Slice, Error) && !Error.IsEmpty());
+
+	Range = FUMCP_ExportRange();
+	Range.Block = 1;
+	CHECK_MESSAGE(TEXT("Blocks should need a block finder."), !Cache.GetOrExportSlice(Path, TEXT("T3D"), Export, Range, nullptr, Slice, Error));
+	CHECK_MESSAGE(TEXT("A block should be sliced out whole."), Cache.GetOrExportSlice(Path, TEXT("T3D"), Export, Range, FindBlocks, Slice, Error) && Slice.Text == TEXT("bbbbbb|") && Slice.TotalLength == 7 && Slice.NumBlocks == 3);
+	Range.Block = 2;
+	Range.Offset = 1;
+	CHECK_MESSAGE(TEXT("Offsets should be relative to the block."), Cache.GetOrExportSlice(Path, TEXT("T3D"), Export, Range, FindBlocks, Slice, Error) && Slice.Text == TEXT("c"));
+	CHECK_MESSAGE(TEXT("Blocks should be found once per cached export."), NumBlockSearches == 1 && NumExports == 1);
+	Range.Block = 3;
+	Range.Offset = 0;
+	CHECK_MESSAGE(TEXT("A block past the last should fail."), !Cache.GetOrExportSlice(Path, TEXT("T3D"), Export, Range, FindBlocks, Slice, Error) && !Error.IsEmpty());
+
+	Cache.Shutdown();
+	Range.Block = 0;
+	CHECK_MESSAGE(TEXT("A disabled cache should still slice."), Cache.GetOrExportSlice(Path, TEXT("T3D"), Export, Range, FindBlocks, Slice, Error) && Slice.Text == TEXT("aaaa|") && NumExports == 2);
+}
+
+TEST_CASE_NAMED(FUMCP_ExportCacheTests_PackageChanges, "Plugin.MCP.ExportCache::PackageChanges", "[ExportCache][SmokeFilter]")
+{
+	const FString Path = TEXT("/Game/UMCP_ExportCacheTest/Changed.Changed");
+	int32 NumExports = 0;
+	auto Export = [&NumExports](FString& OutText, FString& OutError)
+	{
+		NumExports++;
+		OutText = FString::Printf(TEXT("export %d"), NumExports);
+		return true;
+	};
+
+	// Not hooked to the engine, so only the changes reported here count
+	FUMCP_PackageChangeNotifier Notifier;
+	Notifier.Initialize(false);
+	FUMCP_ExportCache Cache;
+	Cache.Initialize(1024 * 1024, 0, &Notifier);
+
+	FString Text;
+	FString Error;
+	Cache.GetOrExport(Path, TEXT("T3D"), Export, Text, Error);
+	Notifier.NotifyPackageChanged(FName(TEXT("/Game/UMCP_ExportCacheTest/Unrelated")), EUMCP_PackageChangeKind::Edited);
+	CHECK_MESSAGE(TEXT("Changes to other packages should keep the export."), Cache.GetOrExport(Path, TEXT("T3D"), Export, Text, Error) && NumExports == 1);
+	Notifier.NotifyPackageChanged(FName(TEXT("/Game/UMCP_ExportCacheTest/Changed")), EUMCP_PackageChangeKind::Edited);
+	CHECK_MESSAGE(TEXT("A change to the package should export again."), Cache.GetOrExport(Path, TEXT("T3D"), Export, Text, Error) && NumExports == 2 && Text == TEXT("export 2"));
+	CHECK_MESSAGE(TEXT("The dropped export should be counted."), Cache.GetStats().Invalidations == 1);
+
+	Cache.Shutdown();
+	CHECK_MESSAGE(TEXT("Shutdown should stop listening."), !Notifier.OnPackageChanged().IsBound());
+	Notifier.Shutdown();
+}
+
+#endif //WITH_TESTS
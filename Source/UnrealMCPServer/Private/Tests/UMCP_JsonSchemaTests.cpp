@@ -0,0 +1,38 @@
+#include "UMCP_Types.h" // For UMCP_GenerateJsonSchemaFromStruct
+#include "UMCP_AssetTools.h" // For FUMCP_ExportAssetParams
+#include "Tests/TestHarnessAdapter.h" // For TEST_CASE_NAMED and CHECK_MESSAGE
+
+#if WITH_TESTS
+
+TEST_CASE_NAMED(FUMCP_JsonSchemaTests_CachedPerStruct, "Plugin.MCP.JsonSchema::CachedPerStruct", "[JsonSchema][SmokeFilter]")
+{
+	TMap<FString, FString> Descriptions;
+	Descriptions.Add(TEXT("objectPath"), TEXT("First description"));
+	TMap<FString, TArray<FString>> EnumValues;
+	EnumValues.Add(TEXT("format"), { TEXT("T3D"), TEXT("md") });
+	TSharedPtr<FJsonObject> First = UMCP_GenerateJsonSchemaFromStruct<FUMCP_ExportAssetParams>(Descriptions, { TEXT("objectPath") }, EnumValues);
+
+	// The second schema comes from the cached struct schema and must not see the first call's arguments
+	UMCP_JsonSchemaBuilder Builder = UMCP_DeferJsonSchemaFromStruct<FUMCP_ExportAssetParams>();
+	TSharedPtr<FJsonObject> Second = Builder();
+	CHECK_MESSAGE(TEXT("Both schemas should be generated."), First.IsValid() && Second.IsValid());
+	if (!First.IsValid() || !Second.IsValid())
+	{
+		return;
+	}
+
+	const TSharedPtr<FJsonObject> FirstObjectPath = First->GetObjectField(TEXT("properties"))->GetObjectField(TEXT("objectPath"));
+	const TSharedPtr<FJsonObject> FirstFormat = First->GetObjectField(TEXT("properties"))->GetObjectField(TEXT("format"));
+	const TSharedPtr<FJsonObject> SecondObjectPath = Second->GetObjectField(TEXT("properties"))->GetObjectField(TEXT("objectPath"));
+	const TSharedPtr<FJsonObject> SecondFormat = Second->GetObjectField(TEXT("properties"))->GetObjectField(TEXT("format"));
+	CHECK_MESSAGE(TEXT("Provided descriptions should be applied."), FirstObjectPath->GetStringField(TEXT("description")) == TEXT("First description"));
+	CHECK_MESSAGE(TEXT("Enum values should be applied to string properties."), FirstFormat->GetArrayField(TEXT("enum")).Num() == 2);
+	CHECK_MESSAGE(TEXT("Descriptions should not leak into later schemas of the same struct."), !SecondObjectPath->HasField(TEXT("description")));
+	CHECK_MESSAGE(TEXT("Enum values should not leak into later schemas of the same struct."), !SecondFormat->HasField(TEXT("enum")));
+	CHECK_MESSAGE(TEXT("Non-empty string defaults should come from the default instance."), SecondFormat->GetStringField(TEXT("default")) == TEXT("T3D"));
+	CHECK_MESSAGE(TEXT("Empty string defaults should be left out."), !SecondObjectPath->HasField(TEXT("default")));
+	CHECK_MESSAGE(TEXT("Explicit required fields should be used as given."), First->GetArrayField(TEXT("required")).Num() == 1);
+	CHECK_MESSAGE(TEXT("Without explicit required fields every property should be required."), Second->GetArrayField(TEXT("required")).Num() == 2);
+}
+
+#endif //WITH_TESTS
@@ -0,0 +1,142 @@
+#include "UMCP_Types.h" // For the UTF-8 JSON helpers and FUMCP_JsonRpcResponse
+#include "Tests/TestHarnessAdapter.h" // For TEST_CASE_NAMED and CHECK_MESSAGE
+#include "HAL/PlatformTime.h"
+
+#if WITH_TESTS
+
+namespace
+{
+	TSharedPtr<FJsonObject> ParseUtf8Object(const TArray<uint8>& Utf8Json)
+	{
+		TSharedPtr<FJsonValue> Value;
+		if (!UMCP_DeserializeJsonUtf8(Utf8Json, Value) || Value->Type != EJson::Object)
+		{
+			return nullptr;
+		}
+		return Value->AsObject();
+	}
+
+	// Roughly the shape of a Blueprint T3D export: many short lines with quotes, tabs and non-ASCII names
+	FString MakeLargeT3DText(int32 TargetLen)
+	{
+		const FString Line = TEXT("\tBegin Object Class=/Script/BlueprintGraph.K2Node_CallFunction Name=\"K2Node_CallFunction_\u00C9t\u00E9\"\r\n");
+		FString Text;
+		Text.Reserve(TargetLen + Line.Len());
+		while (Text.Len() < TargetLen)
+		{
+			Text += Line;
+		}
+		return Text;
+	}
+}
+
+// --- UTF-8 Escaping Tests ---
+
+TEST_CASE_NAMED(FUMCP_JsonUtf8Tests_RoundTrip, "Plugin.MCP.Json.Utf8::RoundTrip", "[Json][Utf8][SmokeFilter]")
+{
+	const FString Original = TEXT("quote \" backslash \\ newline \n tab \t bell \a caf\u00E9 \u65E5\u672C");
+
+	TArray<uint8> Utf8Json;
+	UMCP_AppendUtf8(Utf8Json, "{\"value\":");
+	UMCP_AppendJsonString(Utf8Json, Original);
+	UMCP_AppendUtf8(Utf8Json, "}");
+
+	TSharedPtr<FJsonObject> Parsed = ParseUtf8Object(Utf8Json);
+	CHECK_MESSAGE(TEXT("Escaped UTF-8 JSON should parse."), Parsed.IsValid());
+	CHECK_MESSAGE(TEXT("Escaped string should round trip unchanged."), Parsed.IsValid() && Parsed->GetStringField(TEXT("value")) == Original);
+}
+
+TEST_CASE_NAMED(FUMCP_JsonUtf8Tests_RawResult, "Plugin.MCP.Json.Utf8::RawResult", "[Json][Utf8][SmokeFilter]")
+{
+	FUMCP_JsonRpcResponse Response;
+	Response.id = FUMCP_JsonRpcId(7);
+	UMCP_AppendUtf8(Response.rawResult, "{\"tools\":[{\"name\":\"ping\"}]}");
+
+	TArray<uint8> Utf8Json;
+	CHECK_MESSAGE(TEXT("Response with a raw result should serialize."), Response.ToJsonUtf8(Utf8Json));
+
+	TSharedPtr<FJsonObject> Parsed = ParseUtf8Object(Utf8Json);
+	CHECK_MESSAGE(TEXT("Spliced response should be valid JSON."), Parsed.IsValid());
+	if (Parsed.IsValid())
+	{
+		CHECK_MESSAGE(TEXT("Response id should be kept."), Parsed->GetNumberField(TEXT("id")) == 7);
+		const TSharedPtr<FJsonObject>* Result = nullptr;
+		CHECK_MESSAGE(TEXT("Raw result should be spliced in as 'result'."), Parsed->TryGetObjectField(TEXT("result"), Result) && (*Result)->HasField(TEXT("tools")));
+	}
+}
+
+// --- Benchmark ---
+// Times turning a large resources/read result into a UTF-8 HTTP body. Only the timings are reported; the checks are on
+// the payload itself.
+// Before: USTRUCT -> DOM (copies every string), DOM -> TCHAR FString, FString -> UTF-8 as in FHttpServerResponse::Create.
+// After: each string is transcoded and escaped straight into the UTF-8 result, which ToJsonUtf8 splices into the body.
+
+TEST_CASE_NAMED(FUMCP_JsonUtf8Tests_ReadResourceBenchmark, "Plugin.MCP.Json.Utf8::ReadResourceBenchmark", "[Json][Utf8][Benchmark]")
+{
+	FUMCP_ReadResourceResult Result;
+	FUMCP_ReadResourceResultContent& Content = Result.contents.AddDefaulted_GetRef();
+	Content.uri = TEXT("unreal+t3d:///Game/Benchmark/BP_Large");
+	Content.mimeType = TEXT("application/vnd.unreal.t3d");
+	Content.text = MakeLargeT3DText(4 * 1024 * 1024);
+
+	// Legacy FString pipeline
+	const double LegacyStart = FPlatformTime::Seconds();
+	TArray<uint8> LegacyPayload;
+	{
+		TSharedPtr<FJsonObject> ResultJson = MakeShared<FJsonObject>();
+		UMCP_ToJsonObject(Result, ResultJson);
+
+		TSharedPtr<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+		ResponseJson->SetStringField(TEXT("jsonrpc"), TEXT("2.0"));
+		ResponseJson->SetNumberField(TEXT("id"), 1);
+		ResponseJson->SetObjectField(TEXT("result"), ResultJson);
+		FString JsonString;
+		FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), TJsonWriterFactory<>::Create(&JsonString));
+
+		FTCHARToUTF8 Convert(*JsonString, JsonString.Len());
+		LegacyPayload.Append(reinterpret_cast<const uint8*>(Convert.Get()), Convert.Length());
+	}
+	const double LegacyMs = (FPlatformTime::Seconds() - LegacyStart) * 1000.0;
+
+	// UTF-8 pipeline
+	const double Utf8Start = FPlatformTime::Seconds();
+	FUMCP_JsonRpcResponse Response;
+	Response.id = FUMCP_JsonRpcId(1);
+	TArray<uint8> Utf8Payload;
+	{
+		Result.AppendJsonUtf8(Response.rawResult);
+		Utf8Payload.Reserve(Response.rawResult.Num() + 128);
+		Response.ToJsonUtf8(Utf8Payload);
+	}
+	const double Utf8Ms = (FPlatformTime::Seconds() - Utf8Start) * 1000.0;
+
+	UE_LOG(LogTemp, Display, TEXT("ReadResourceBenchmark: %d chars of resource text"), Content.text.Len());
+	UE_LOG(LogTemp, Display, TEXT("ReadResourceBenchmark: FString pipeline made a %d byte body in %.2f ms"), LegacyPayload.Num(), LegacyMs);
+	UE_LOG(LogTemp, Display, TEXT("ReadResourceBenchmark: UTF-8 pipeline made a %d byte body in %.2f ms"), Utf8Payload.Num(), Utf8Ms);
+
+	// The result must reach the body byte for byte, however it is spliced in
+	bool bResultSpliced = false;
+	for (int32 Start = 0; !bResultSpliced && Start + Response.rawResult.Num() <= Utf8Payload.Num(); ++Start)
+	{
+		bResultSpliced = FMemory::Memcmp(Utf8Payload.GetData() + Start, Response.rawResult.GetData(), Response.rawResult.Num()) == 0;
+	}
+	CHECK_MESSAGE(TEXT("The UTF-8 result should be in the body unchanged."), Response.rawResult.Num() > 0 && bResultSpliced);
+
+	TSharedPtr<FJsonObject> Parsed = ParseUtf8Object(Utf8Payload);
+	const TSharedPtr<FJsonObject>* ParsedResult = nullptr;
+	const TArray<TSharedPtr<FJsonValue>>* ParsedContents = nullptr;
+	const bool bShapeValid = Parsed.IsValid() && Parsed->TryGetObjectField(TEXT("result"), ParsedResult)
+		&& (*ParsedResult)->TryGetArrayField(TEXT("contents"), ParsedContents) && ParsedContents->Num() == 1;
+	CHECK_MESSAGE(TEXT("UTF-8 payload should be a valid resources/read response."), bShapeValid);
+	if (bShapeValid)
+	{
+		// Compared as UTF-8 bytes, so a single wrongly transcoded character fails
+		const FString RoundTripped = (*ParsedContents)[0]->AsObject()->GetStringField(TEXT("text"));
+		const FTCHARToUTF8 ExpectedUtf8(*Content.text, Content.text.Len());
+		const FTCHARToUTF8 RoundTrippedUtf8(*RoundTripped, RoundTripped.Len());
+		CHECK_MESSAGE(TEXT("Resource text should survive the UTF-8 pipeline byte for byte."), ExpectedUtf8.Length() == RoundTrippedUtf8.Length()
+			&& FMemory::Memcmp(ExpectedUtf8.Get(), RoundTrippedUtf8.Get(), ExpectedUtf8.Length()) == 0);
+	}
+}
+
+#endif //WITH_TESTS
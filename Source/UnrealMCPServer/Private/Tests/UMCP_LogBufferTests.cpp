@@ -0,0 +1,78 @@
+#include "UMCP_LogBuffer.h" // For FUMCP_LogBuffer
+#include "Tests/TestHarnessAdapter.h" // For TEST_CASE_NAMED and CHECK_MESSAGE
+
+#if WITH_TESTS
+
+TEST_CASE_NAMED(FUMCP_LogBufferTests_CursorReads, "Plugin.MCP.LogBuffer::CursorReads", "[LogBuffer][SmokeFilter]")
+{
+	// Not attached to GLog, so only the lines written here are in it
+	FUMCP_LogBuffer Buffer;
+	Buffer.Initialize(4, false);
+	const FName TestCategory(TEXT("LogUMCPTest"));
+	const FName OtherCategory(TEXT("LogUMCPOther"));
+	const auto AcceptAll = [](const FUMCP_LogLine&) { return true; };
+
+	Buffer.Serialize(TEXT("first"), ELogVerbosity::Log, TestCategory);
+	Buffer.Serialize(TEXT("second"), ELogVerbosity::Warning, OtherCategory);
+	Buffer.Serialize(TEXT("third"), ELogVerbosity::Error, TestCategory);
+
+	TArray<FUMCP_LogLine> Lines;
+	uint64 NumMissed = 0;
+	uint64 Cursor = Buffer.ReadLines(0, 100, AcceptAll, Lines, NumMissed);
+	CHECK_MESSAGE(TEXT("All lines should be read in order."), Lines.Num() == 3 && Lines[0].Text == TEXT("first") && Lines[2].Text == TEXT("third"));
+	CHECK_MESSAGE(TEXT("Sequence numbers should start at 1."), Lines.Num() == 3 && Lines[0].Sequence == 1 && Lines[2].Sequence == 3);
+	CHECK_MESSAGE(TEXT("The cursor should point past the last line."), Cursor == 4 && Cursor == Buffer.GetNextSequence() && NumMissed == 0);
+
+	Lines.Reset();
+	CHECK_MESSAGE(TEXT("Reading at the cursor should return nothing new."), Buffer.ReadLines(Cursor, 100, AcceptAll, Lines, NumMissed) == Cursor && Lines.Num() == 0);
+
+	Lines.Reset();
+	Buffer.ReadLines(0, 100, [&TestCategory](const FUMCP_LogLine& Line) { return Line.Category == TestCategory && Line.Verbosity <= ELogVerbosity::Warning; }, Lines, NumMissed);
+	CHECK_MESSAGE(TEXT("Filters should apply to category and verbosity."), Lines.Num() == 1 && Lines[0].Text == TEXT("third"));
+
+	Lines.Reset();
+	Cursor = Buffer.ReadLines(0, 2, AcceptAll, Lines, NumMissed);
+	CHECK_MESSAGE(TEXT("MaxLines should stop the read and return the cursor of the next line."), Lines.Num() == 2 && Cursor == 3);
+
+	// Three more lines wrap the ring of four, so lines 1 and 2 are gone
+	Buffer.Serialize(TEXT("fourth"), ELogVerbosity::Log, TestCategory);
+	Buffer.Serialize(TEXT("fifth"), ELogVerbosity::Log, TestCategory);
+	Buffer.Serialize(TEXT("sixth"), ELogVerbosity::Log, TestCategory);
+	Lines.Reset();
+	Cursor = Buffer.ReadLines(1, 100, AcceptAll, Lines, NumMissed);
+	CHECK_MESSAGE(TEXT("Overwritten lines should be counted as missed."), NumMissed == 2);
+	CHECK_MESSAGE(TEXT("The lines still kept should be returned."), Lines.Num() == 4 && Lines[0].Sequence == 3 && Lines.Last().Text == TEXT("sixth") && Cursor == 7);
+
+	const FString LongLine = FString::ChrN(FUMCP_LogBuffer::MaxLineChars + 10, TEXT('x'));
+	Buffer.Serialize(*LongLine, ELogVerbosity::Log, TestCategory);
+	Lines.Reset();
+	Buffer.ReadLines(Cursor, 100, AcceptAll, Lines, NumMissed);
+	CHECK_MESSAGE(TEXT("Long lines should be cut at MaxLineChars."), Lines.Num() == 1 && Lines[0].bTruncated && Lines[0].Text.Len() == FUMCP_LogBuffer::MaxLineChars);
+
+	const FUMCP_LogBufferStats Stats = Buffer.GetStats();
+	CHECK_MESSAGE(TEXT("Stats should report the capacity and the next sequence number."), Stats.Capacity == 4 && Stats.NextSequence == 8 && Stats.NumDropped == 0 && Stats.MemoryBytes > 0);
+	Buffer.Shutdown();
+}
+
+TEST_CASE_NAMED(FUMCP_LogBufferTests_LineTimes, "Plugin.MCP.LogBuffer::LineTimes", "[LogBuffer][SmokeFilter]")
+{
+	FUMCP_LogBuffer Buffer;
+	Buffer.Initialize(4, false);
+	const FName TestCategory(TEXT("LogUMCPTest"));
+	const auto AcceptAll = [](const FUMCP_LogLine&) { return true; };
+
+	// An explicit time is already relative to GStartTime, as FOutputDevice callers pass it
+	Buffer.Serialize(TEXT("explicit"), ELogVerbosity::Log, TestCategory, 12.5);
+	const double Before = FPlatformTime::Seconds() - GStartTime;
+	Buffer.Serialize(TEXT("implicit"), ELogVerbosity::Log, TestCategory);
+	const double After = FPlatformTime::Seconds() - GStartTime;
+
+	TArray<FUMCP_LogLine> Lines;
+	uint64 NumMissed = 0;
+	Buffer.ReadLines(0, 100, AcceptAll, Lines, NumMissed);
+	CHECK_MESSAGE(TEXT("An explicit time should be stored unchanged."), Lines.Num() == 2 && Lines[0].Time == 12.5);
+	CHECK_MESSAGE(TEXT("A line without a time should be stamped with the seconds since startup."), Lines.Num() == 2 && Lines[1].Time >= Before && Lines[1].Time <= After);
+	Buffer.Shutdown();
+}
+
+#endif //WITH_TESTS
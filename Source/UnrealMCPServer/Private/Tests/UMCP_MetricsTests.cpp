@@ -0,0 +1,40 @@
+#include "UMCP_Server.h" // For FUMCP_LatencyHistogram
+#include "Tests/TestHarnessAdapter.h" // For TEST_CASE_NAMED and CHECK_MESSAGE
+
+#if WITH_TESTS
+
+TEST_CASE_NAMED(FUMCP_MetricsTests_Histogram, "Plugin.MCP.Metrics::Histogram", "[Metrics][SmokeFilter]")
+{
+	FUMCP_LatencyHistogram Histogram;
+	CHECK_MESSAGE(TEXT("An empty histogram should report zero."), Histogram.GetPercentileMs(50.0) == 0.0 && Histogram.GetAverageMs() == 0.0);
+
+	// 90 fast samples, 9 medium ones and one outlier past the last bound
+	for (int32 Index = 0; Index < 90; ++Index)
+	{
+		Histogram.Add(0.2);
+	}
+	for (int32 Index = 0; Index < 9; ++Index)
+	{
+		Histogram.Add(40.0);
+	}
+	Histogram.Add(12000.0);
+
+	CHECK_MESSAGE(TEXT("Every sample should be counted."), Histogram.Count == 100);
+	CHECK_MESSAGE(TEXT("Bounds are inclusive, so 0.2 ms lands in the 0.25 ms bucket."), Histogram.BucketCounts[1] == 90);
+	CHECK_MESSAGE(TEXT("Samples past the last bound should land in the overflow bucket."), Histogram.BucketCounts[FUMCP_LatencyHistogram::NumBuckets - 1] == 1);
+	CHECK_MESSAGE(TEXT("p50 should be the upper bound of the fast bucket."), Histogram.GetPercentileMs(50.0) == 0.25);
+	CHECK_MESSAGE(TEXT("p95 should be the upper bound of the medium bucket."), Histogram.GetPercentileMs(95.0) == 50.0);
+	CHECK_MESSAGE(TEXT("p100 in the overflow bucket should be the slowest sample."), Histogram.GetPercentileMs(100.0) == 12000.0);
+	CHECK_MESSAGE(TEXT("Max should be tracked exactly."), Histogram.MaxMs == 12000.0);
+	CHECK_MESSAGE(TEXT("Average should use the exact total."), FMath::IsNearlyEqual(Histogram.GetAverageMs(), (90 * 0.2 + 9 * 40.0 + 12000.0) / 100.0));
+
+	FUMCP_LatencyHistogram Single;
+	Single.Add(3.0);
+	CHECK_MESSAGE(TEXT("A percentile should never exceed the slowest sample."), Single.GetPercentileMs(99.0) == 3.0);
+
+	TSharedPtr<FJsonObject> Json = Histogram.ToJsonObject();
+	CHECK_MESSAGE(TEXT("JSON should carry one count per bucket."), Json->GetArrayField(TEXT("buckets")).Num() == FUMCP_LatencyHistogram::NumBuckets);
+	CHECK_MESSAGE(TEXT("JSON should carry the sample count."), Json->GetNumberField(TEXT("count")) == 100);
+}
+
+#endif //WITH_TESTS
@@ -0,0 +1,38 @@
+#include "UMCP_PackageLoader.h" // For FUMCP_PackageLoader
+#include "Tests/TestHarnessAdapter.h" // For TEST_CASE_NAMED and CHECK_MESSAGE
+#include "Engine/Blueprint.h"
+#include "UObject/Package.h"
+
+#if WITH_TESTS
+
+TEST_CASE_NAMED(FUMCP_PackageLoaderTests_InMemoryPackages, "Plugin.MCP.PackageLoader::InMemoryPackages", "[PackageLoader][SmokeFilter]")
+{
+	// An object that only exists in memory, so nothing is loaded from disk
+	UPackage* Package = CreatePackage(TEXT("/Temp/UMCP_PackageLoaderTest"));
+	UBlueprint* Blueprint = NewObject<UBlueprint>(Package, TEXT("BP_UMCP_PackageLoaderTest"), RF_Transient);
+	const FString ObjectPath = Blueprint->GetPathName();
+
+	FUMCP_PackageLoader Loader;
+	Loader.Initialize(0, 0);
+	CHECK_MESSAGE(TEXT("The window should hold at least one load."), Loader.GetMaxConcurrentLoads() == 1);
+
+	int32 RequestId = 0;
+	CHECK_MESSAGE(TEXT("A package in memory should need no load."), Loader.TryStartLoad(ObjectPath, RequestId) && RequestId == INDEX_NONE);
+	CHECK_MESSAGE(TEXT("Paths that aren't package paths should need no load."), Loader.TryStartLoad(TEXT("NotAPackagePath"), RequestId) && RequestId == INDEX_NONE);
+	CHECK_MESSAGE(TEXT("Empty paths should need no load."), Loader.TryStartLoad(FString(), RequestId) && RequestId == INDEX_NONE);
+	CHECK_MESSAGE(TEXT("No request should count as complete."), Loader.IsLoadComplete(INDEX_NONE));
+
+	CHECK_MESSAGE(TEXT("Objects in memory should resolve like LoadObject."), Loader.LoadObject(ObjectPath) == Blueprint);
+
+	// Releasing is disabled with a watermark of 0, and packages that were in memory are never held anyway
+	Loader.ReleaseIfOverWatermark();
+	const FUMCP_PackageLoaderStats Stats = Loader.GetStats();
+	CHECK_MESSAGE(TEXT("Nothing should have been loaded or held."), Stats.NumLoading == 0 && Stats.NumHeld == 0 && Stats.NumLoaded == 0 && Stats.NumCollections == 0);
+	CHECK_MESSAGE(TEXT("A disabled watermark should be reported as 0."), Stats.MemoryWatermarkBytes == 0);
+
+	Loader.Shutdown();
+	Blueprint->MarkAsGarbage();
+	Package->MarkAsGarbage();
+}
+
+#endif //WITH_TESTS
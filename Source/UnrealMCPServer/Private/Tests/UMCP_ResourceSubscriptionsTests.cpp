@@ -0,0 +1,91 @@
+#include "UMCP_ResourceSubscriptions.h" // For FUMCP_ResourceSubscriptions
+#include "Tests/TestHarnessAdapter.h" // For TEST_CASE_NAMED and CHECK_MESSAGE
+#include "HAL/PlatformTime.h"
+
+#if WITH_TESTS
+
+TEST_CASE_NAMED(FUMCP_ResourceSubscriptionsTests_UriPackageName, "Plugin.MCP.ResourceSubscriptions::UriPackageName", "[ResourceSubscriptions][SmokeFilter]")
+{
+	FName PackageName;
+	CHECK_MESSAGE(TEXT("An object path should give its package."), FUMCP_ResourceSubscriptions::GetUriPackageName(TEXT("unreal+t3d:///Game/BP_Door.BP_Door"), PackageName) && PackageName == FName(TEXT("/Game/BP_Door")));
+	CHECK_MESSAGE(TEXT("A package path should be taken as it is."), FUMCP_ResourceSubscriptions::GetUriPackageName(TEXT("unreal+md:///Game/Maps/BP_Door"), PackageName) && PackageName == FName(TEXT("/Game/Maps/BP_Door")));
+	CHECK_MESSAGE(TEXT("Percent-encoded paths should be decoded."), FUMCP_ResourceSubscriptions::GetUriPackageName(TEXT("unreal+t3d://%2FGame%2FBP_Door.BP_Door"), PackageName) && PackageName == FName(TEXT("/Game/BP_Door")));
+	CHECK_MESSAGE(TEXT("The query of a chunked read should be ignored."), FUMCP_ResourceSubscriptions::GetUriPackageName(TEXT("unreal+t3d:///Game/BP_Door.BP_Door?block=2&length=4096"), PackageName) && PackageName == FName(TEXT("/Game/BP_Door")));
+	CHECK_MESSAGE(TEXT("Resources that aren't assets should be rejected."), !FUMCP_ResourceSubscriptions::GetUriPackageName(TEXT("unreal+metrics://server"), PackageName));
+	CHECK_MESSAGE(TEXT("URIs without a scheme should be rejected."), !FUMCP_ResourceSubscriptions::GetUriPackageName(TEXT("/Game/BP_Door"), PackageName));
+}
+
+TEST_CASE_NAMED(FUMCP_ResourceSubscriptionsTests_CoalescedNotifications, "Plugin.MCP.ResourceSubscriptions::CoalescedNotifications", "[ResourceSubscriptions][SmokeFilter]")
+{
+	// Not hooked to the engine, so only the changes reported here count
+	FUMCP_ResourceSubscriptions Subscriptions;
+	Subscriptions.Initialize(0.25, 25.0, 600.0);
+	const FString DoorUri = TEXT("unreal+t3d:///Game/BP_Door.BP_Door");
+	const FString DoorMarkdownUri = TEXT("unreal+md:///Game/BP_Door.BP_Door");
+	const FName DoorPackage(TEXT("/Game/BP_Door"));
+
+	FString Error;
+	CHECK_MESSAGE(TEXT("Subscribing without a session should fail."), !Subscriptions.Subscribe(FString(), DoorUri, Error) && !Error.IsEmpty());
+	const FString SessionId = Subscriptions.CreateSession();
+	CHECK_MESSAGE(TEXT("Non-asset resources should not be subscribable."), !Subscriptions.Subscribe(SessionId, TEXT("unreal+metrics://server"), Error));
+	CHECK_MESSAGE(TEXT("Asset resources should be subscribable."), Subscriptions.Subscribe(SessionId, DoorUri, Error) && Subscriptions.Subscribe(SessionId, DoorMarkdownUri, Error));
+	CHECK_MESSAGE(TEXT("Subscribing twice should not add a second subscription."), Subscriptions.Subscribe(SessionId, DoorUri, Error) && Subscriptions.GetStats().NumSubscriptions == 2);
+
+	int32 NumAnswers = 0;
+	TArray<FString> Delivered;
+	auto PollInto = [&NumAnswers, &Delivered](TArray<FString>&& UpdatedUris)
+	{
+		++NumAnswers;
+		Delivered = MoveTemp(UpdatedUris);
+	};
+	CHECK_MESSAGE(TEXT("Polling a session should park the poll."), Subscriptions.Poll(SessionId, PollInto) && NumAnswers == 0 && Subscriptions.GetStats().NumParkedPolls == 1);
+	CHECK_MESSAGE(TEXT("Polling an unknown session should fail."), !Subscriptions.Poll(TEXT("NoSuchSession"), PollInto));
+
+	const double Now = FPlatformTime::Seconds();
+	Subscriptions.NotifyPackageChanged(FName(TEXT("/Game/Unrelated")), Now);
+	Subscriptions.NotifyPackageChanged(DoorPackage, Now);
+	Subscriptions.NotifyPackageChanged(DoorPackage, Now + 0.1);
+	Subscriptions.Tick(Now + 0.1);
+	CHECK_MESSAGE(TEXT("Nothing should be delivered inside the coalescing window."), NumAnswers == 0);
+	Subscriptions.Tick(Now + 0.3);
+	CHECK_MESSAGE(TEXT("A burst of changes should be one notification per subscribed URI."), NumAnswers == 1 && Delivered.Num() == 2 && Delivered.Contains(DoorUri) && Delivered.Contains(DoorMarkdownUri));
+	CHECK_MESSAGE(TEXT("Changes to unsubscribed packages should not be counted."), Subscriptions.GetStats().NumPackageChanges == 2 && Subscriptions.GetStats().NumNotificationsSent == 2);
+
+	// Changes while no poll is parked wait for the next one, which is answered right away
+	CHECK_MESSAGE(TEXT("Unsubscribing should succeed."), Subscriptions.Unsubscribe(SessionId, DoorMarkdownUri) && Subscriptions.GetStats().NumSubscriptions == 1);
+	Subscriptions.NotifyPackageChanged(DoorPackage, Now + 1.0);
+	Subscriptions.Tick(Now + 2.0);
+	Subscriptions.Poll(SessionId, PollInto);
+	CHECK_MESSAGE(TEXT("Pending URIs should be handed to the next poll."), NumAnswers == 2 && Delivered.Num() == 1 && Delivered[0] == DoorUri);
+
+	Subscriptions.Poll(SessionId, PollInto);
+	Subscriptions.Tick(FPlatformTime::Seconds() + 30.0);
+	CHECK_MESSAGE(TEXT("A poll should time out with nothing."), NumAnswers == 3 && Delivered.Num() == 0);
+
+	Subscriptions.Poll(SessionId, PollInto);
+	CHECK_MESSAGE(TEXT("Closing the session should answer its poll."), Subscriptions.CloseSession(SessionId) && NumAnswers == 4 && Subscriptions.GetStats().NumSubscriptions == 0);
+	CHECK_MESSAGE(TEXT("A closed session should be gone."), !Subscriptions.TouchSession(SessionId) && !Subscriptions.CloseSession(SessionId));
+	Subscriptions.Shutdown();
+}
+
+TEST_CASE_NAMED(FUMCP_ResourceSubscriptionsTests_SessionExpiry, "Plugin.MCP.ResourceSubscriptions::SessionExpiry", "[ResourceSubscriptions][SmokeFilter]")
+{
+	FUMCP_ResourceSubscriptions Subscriptions;
+	Subscriptions.Initialize(0.0, 25.0, 600.0);
+	const FString SessionId = Subscriptions.CreateSession();
+	FString Error;
+	Subscriptions.Subscribe(SessionId, TEXT("unreal+t3d:///Game/BP_Door.BP_Door"), Error);
+
+	Subscriptions.Tick(FPlatformTime::Seconds() + 60.0);
+	CHECK_MESSAGE(TEXT("A recently used session should be kept."), Subscriptions.TouchSession(SessionId));
+	Subscriptions.Tick(FPlatformTime::Seconds() + 700.0);
+	CHECK_MESSAGE(TEXT("An idle session should expire with its subscriptions."), !Subscriptions.TouchSession(SessionId) && Subscriptions.GetStats().NumSubscriptions == 0 && Subscriptions.GetStats().NumExpiredSessions == 1);
+
+	const FString PollingSessionId = Subscriptions.CreateSession();
+	bool bAnswered = false;
+	Subscriptions.Poll(PollingSessionId, [&bAnswered](TArray<FString>&&) { bAnswered = true; });
+	Subscriptions.Shutdown();
+	CHECK_MESSAGE(TEXT("Shutdown should answer parked polls."), bAnswered && Subscriptions.GetStats().NumSessions == 0);
+}
+
+#endif //WITH_TESTS
@@ -0,0 +1,201 @@
+#include "UMCP_StructSerializer.h" // For FUMCP_StructSerializer
+#include "UMCP_AssetTools.h" // For the asset tool result structs
+#include "Tests/TestHarnessAdapter.h" // For TEST_CASE_NAMED and CHECK_MESSAGE
+#include "JsonObjectConverter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "HAL/PlatformTime.h"
+
+#if WITH_TESTS
+
+namespace
+{
+	// Both sides are normalized through the same condensed writer, so the comparison ignores formatting only
+	FString ToCondensedString(const TSharedPtr<FJsonObject>& JsonObject)
+	{
+		FString Out;
+		if (JsonObject.IsValid())
+		{
+			FJsonSerializer::Serialize(JsonObject.ToSharedRef(), TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Out));
+		}
+		return Out;
+	}
+
+	FString ConverterJson(const UScriptStruct* Struct, const void* StructData)
+	{
+		TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+		FJsonObjectConverter::UStructToJsonObject(Struct, StructData, JsonObject);
+		return ToCondensedString(JsonObject);
+	}
+
+	FString NormalizeUtf8(const TArray<uint8>& Utf8Json)
+	{
+		TSharedPtr<FJsonValue> Parsed;
+		if (!UMCP_DeserializeJsonUtf8(Utf8Json, Parsed) || Parsed->Type != EJson::Object)
+		{
+			return FString();
+		}
+		return ToCondensedString(Parsed->AsObject());
+	}
+
+	FString PlanJson(const UScriptStruct* Struct, const void* StructData)
+	{
+		TArray<uint8> Utf8Json;
+		return FUMCP_StructSerializer::WriteJsonUtf8(Struct, StructData, Utf8Json) ? NormalizeUtf8(Utf8Json) : FString();
+	}
+
+	TArray<uint8> ToUtf8(const FString& Text)
+	{
+		FTCHARToUTF8 Convert(*Text, Text.Len());
+		return TArray<uint8>(reinterpret_cast<const uint8*>(Convert.Get()), Convert.Length());
+	}
+
+	FUMCP_GetAssetDependencyTreeResult MakeDependencyTree(int32 NumNodes, int32 DependenciesPerNode)
+	{
+		FUMCP_GetAssetDependencyTreeResult Result;
+		Result.bSuccess = true;
+		Result.assetPath = TEXT("/Game/Benchmark/BP_Root.BP_Root");
+		Result.tree.Reserve(NumNodes);
+		for (int32 Index = 0; Index < NumNodes; ++Index)
+		{
+			FUMCP_AssetDependencyNode& Node = Result.tree.AddDefaulted_GetRef();
+			Node.assetPath = FString::Printf(TEXT("/Game/Benchmark/Dependencies/M_Material_%05d.M_Material_%05d"), Index, Index);
+			Node.depth = Index % 7;
+			for (int32 Dependency = 0; Dependency < DependenciesPerNode; ++Dependency)
+			{
+				Node.dependencies.Add(FString::Printf(TEXT("/Game/Benchmark/Textures/T_Texture_%05d"), (Index * 31 + Dependency) % NumNodes));
+			}
+		}
+		Result.totalNodes = NumNodes;
+		Result.maxDepthReached = 6;
+		return Result;
+	}
+}
+
+TEST_CASE_NAMED(FUMCP_StructSerializerTests_MatchesConverter, "Plugin.MCP.StructSerializer::MatchesConverter", "[Json][StructSerializer][SmokeFilter]")
+{
+	// Nested structs
+	FUMCP_InitializeResult Initialize;
+	Initialize.protocolVersion = TEXT("2025-03-26");
+	Initialize.capabilities.tools.listChanged = true;
+	CHECK_MESSAGE(TEXT("Nested structs should be written like the converter writes them."),
+		PlanJson(FUMCP_InitializeResult::StaticStruct(), &Initialize) == ConverterJson(FUMCP_InitializeResult::StaticStruct(), &Initialize));
+
+	// Maps, escaping and non-ASCII text
+	FUMCP_QueryAssetResult Query;
+	Query.bExists = true;
+	Query.assetPath = TEXT("/Game/Caf\u00E9/\"Quoted\"\tAsset");
+	Query.tags.Add(TEXT("Description"), TEXT("line one\nline two \u65E5\u672C"));
+	Query.tags.Add(TEXT("Empty"), FString());
+	CHECK_MESSAGE(TEXT("String maps and escaped strings should be written like the converter writes them."),
+		PlanJson(FUMCP_QueryAssetResult::StaticStruct(), &Query) == ConverterJson(FUMCP_QueryAssetResult::StaticStruct(), &Query));
+
+	// Arrays of structs holding arrays
+	const FUMCP_GetAssetDependencyTreeResult Tree = MakeDependencyTree(16, 3);
+	CHECK_MESSAGE(TEXT("Arrays of structs should be written like the converter writes them."),
+		PlanJson(FUMCP_GetAssetDependencyTreeResult::StaticStruct(), &Tree) == ConverterJson(FUMCP_GetAssetDependencyTreeResult::StaticStruct(), &Tree));
+
+	// The DOM path of the templates
+	TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	CHECK_MESSAGE(TEXT("UMCP_ToJsonObject should succeed."), UMCP_ToJsonObject(Tree, JsonObject));
+	CHECK_MESSAGE(TEXT("UMCP_ToJsonObject should build the converter's DOM."), ToCondensedString(JsonObject) == ConverterJson(FUMCP_GetAssetDependencyTreeResult::StaticStruct(), &Tree));
+}
+
+TEST_CASE_NAMED(FUMCP_StructSerializerTests_Read, "Plugin.MCP.StructSerializer::Read", "[Json][StructSerializer][SmokeFilter]")
+{
+	// Unknown fields (with brackets inside strings), keys in another case, numbers as strings, null and escapes
+	const TArray<uint8> Utf8Json = ToUtf8(TEXT("{ \"unknown\": {\"nested\": [1, {\"x\": \"]}\"}], \"flag\": true},")
+		TEXT(" \"packagePaths\": [\"/Game/A\", \"/Game/Caf\\u00e9\"],")
+		TEXT(" \"BRECURSIVE\": false, \"maxResults\": \"25\", \"offset\": null,")
+		TEXT(" \"classPaths\": [\"\\ud83d\\ude00 \\\"q\\\"\\n\", \"\u65E5\u672C\"] }"));
+
+	FUMCP_SearchAssetsParams Params;
+	Params.offset = 7;
+	CHECK_MESSAGE(TEXT("Valid JSON should parse straight into the struct."), UMCP_CreateFromJsonUtf8(Utf8Json, Params));
+	CHECK_MESSAGE(TEXT("String arrays and \\u escapes should be read."), Params.packagePaths.Num() == 2 && Params.packagePaths[1] == TEXT("/Game/Caf\u00E9"));
+	CHECK_MESSAGE(TEXT("Keys should match case-insensitively."), !Params.bRecursive);
+	CHECK_MESSAGE(TEXT("Numbers given as strings should be accepted."), Params.maxResults == 25);
+	CHECK_MESSAGE(TEXT("null should keep the current value."), Params.offset == 7);
+	CHECK_MESSAGE(TEXT("Surrogate pairs, escapes and raw UTF-8 should be decoded."), Params.classPaths.Num() == 2
+		&& Params.classPaths[0] == TEXT("\U0001F600 \"q\"\n") && Params.classPaths[1] == TEXT("\u65E5\u672C"));
+
+	// The DOM path has to agree with the streaming one
+	TSharedPtr<FJsonValue> Parsed;
+	FUMCP_SearchAssetsParams FromDom;
+	FromDom.offset = 7;
+	CHECK_MESSAGE(TEXT("The same JSON should read through a DOM."), UMCP_DeserializeJsonUtf8(Utf8Json, Parsed) && UMCP_CreateFromJsonObject(Parsed->AsObject(), FromDom));
+	CHECK_MESSAGE(TEXT("DOM and streaming reads should produce the same struct."), FUMCP_SearchAssetsParams::StaticStruct()->CompareScriptStruct(&Params, &FromDom, PPF_None));
+
+	FUMCP_SearchAssetsParams Invalid;
+	CHECK_MESSAGE(TEXT("Truncated JSON should be rejected."), !UMCP_CreateFromJsonUtf8(ToUtf8(TEXT("{\"packagePaths\":[\"/Game/A\"")), Invalid));
+	CHECK_MESSAGE(TEXT("Trailing data should be rejected."), !UMCP_CreateFromJsonUtf8(ToUtf8(TEXT("{} {}")), Invalid));
+	CHECK_MESSAGE(TEXT("A mistyped field should be rejected."), !UMCP_CreateFromJsonUtf8(ToUtf8(TEXT("{\"packagePaths\":\"/Game/A\"}")), Invalid));
+	CHECK_MESSAGE(TEXT("Out of range integers should be rejected."), !UMCP_CreateFromJsonUtf8(ToUtf8(TEXT("{\"maxResults\":4294967296}")), Invalid));
+
+	// Round trip, including maps which are read through the converter
+	FUMCP_QueryAssetResult Query;
+	Query.bExists = true;
+	Query.assetPath = TEXT("/Game/Caf\u00E9");
+	Query.tags.Add(TEXT("Key \"1\""), TEXT("Value\n1"));
+	TArray<uint8> QueryUtf8;
+	FUMCP_QueryAssetResult QueryRead;
+	QueryRead.bExists = false;
+	CHECK_MESSAGE(TEXT("A written struct should read back."), UMCP_ToJsonUtf8(Query, QueryUtf8) && UMCP_CreateFromJsonUtf8(QueryUtf8, QueryRead));
+	CHECK_MESSAGE(TEXT("A written struct should read back unchanged."), FUMCP_QueryAssetResult::StaticStruct()->CompareScriptStruct(&Query, &QueryRead, PPF_None));
+}
+
+// --- Benchmark ---
+// Writes and reads a GetAssetDependencyTree result with thousands of nodes, once through FJsonObjectConverter plus
+// a DOM and once through the cached plan.
+
+TEST_CASE_NAMED(FUMCP_StructSerializerTests_Benchmark, "Plugin.MCP.StructSerializer::Benchmark", "[Json][StructSerializer][Benchmark]")
+{
+	const int32 NumNodes = 20000;
+	const FUMCP_GetAssetDependencyTreeResult Tree = MakeDependencyTree(NumNodes, 4);
+	const UScriptStruct* Struct = FUMCP_GetAssetDependencyTreeResult::StaticStruct();
+
+	// Builds the plan outside of the timed section
+	TArray<uint8> Warmup;
+	FUMCP_StructSerializer::WriteJsonUtf8(FUMCP_AssetDependencyNode::StaticStruct(), &Tree.tree[0], Warmup);
+
+	const double ConverterWriteStart = FPlatformTime::Seconds();
+	TArray<uint8> ConverterUtf8;
+	{
+		TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+		FJsonObjectConverter::UStructToJsonObject(Struct, &Tree, JsonObject);
+		UMCP_SerializeJsonUtf8(JsonObject, ConverterUtf8);
+	}
+	const double ConverterWriteMs = (FPlatformTime::Seconds() - ConverterWriteStart) * 1000.0;
+
+	const double PlanWriteStart = FPlatformTime::Seconds();
+	TArray<uint8> PlanUtf8;
+	const bool bPlanWritten = UMCP_ToJsonUtf8(Tree, PlanUtf8);
+	const double PlanWriteMs = (FPlatformTime::Seconds() - PlanWriteStart) * 1000.0;
+
+	const double ConverterReadStart = FPlatformTime::Seconds();
+	FUMCP_GetAssetDependencyTreeResult ConverterRead;
+	{
+		TSharedPtr<FJsonValue> Parsed;
+		if (UMCP_DeserializeJsonUtf8(ConverterUtf8, Parsed) && Parsed->Type == EJson::Object)
+		{
+			FJsonObjectConverter::JsonObjectToUStruct(Parsed->AsObject().ToSharedRef(), &ConverterRead, 0, 0);
+		}
+	}
+	const double ConverterReadMs = (FPlatformTime::Seconds() - ConverterReadStart) * 1000.0;
+
+	const double PlanReadStart = FPlatformTime::Seconds();
+	FUMCP_GetAssetDependencyTreeResult PlanRead;
+	const bool bPlanRead = UMCP_CreateFromJsonUtf8(PlanUtf8, PlanRead);
+	const double PlanReadMs = (FPlatformTime::Seconds() - PlanReadStart) * 1000.0;
+
+	UE_LOG(LogTemp, Display, TEXT("StructSerializerBenchmark: %d nodes, %d bytes of JSON"), NumNodes, PlanUtf8.Num());
+	UE_LOG(LogTemp, Display, TEXT("StructSerializerBenchmark: write converter+DOM %.2f ms, plan %.2f ms"), ConverterWriteMs, PlanWriteMs);
+	UE_LOG(LogTemp, Display, TEXT("StructSerializerBenchmark: read DOM+converter %.2f ms, plan %.2f ms"), ConverterReadMs, PlanReadMs);
+
+	CHECK_MESSAGE(TEXT("The plan should write the tree."), bPlanWritten);
+	CHECK_MESSAGE(TEXT("Both writers should produce the same JSON."), NormalizeUtf8(PlanUtf8) == NormalizeUtf8(ConverterUtf8));
+	CHECK_MESSAGE(TEXT("The plan should read the tree."), bPlanRead);
+	CHECK_MESSAGE(TEXT("Both readers should produce the same struct."), Struct->CompareScriptStruct(&PlanRead, &ConverterRead, PPF_None));
+	CHECK_MESSAGE(TEXT("The read tree should match the original."), Struct->CompareScriptStruct(&PlanRead, &Tree, PPF_None));
+}
+
+#endif //WITH_TESTS
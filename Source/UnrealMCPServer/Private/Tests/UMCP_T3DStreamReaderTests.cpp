@@ -0,0 +1,100 @@
+#include "UMCP_T3DStreamReader.h" // For FUMCP_T3DStreamReader
+#include "Tests/TestHarnessAdapter.h" // For TEST_CASE_NAMED and CHECK_MESSAGE
+
+#if WITH_TESTS
+
+namespace
+{
+	const TCHAR* UMCP_TestT3D =
+		TEXT("Begin Object Class=/Script/Engine.DataAsset Name=\"DA_Test\"\n")
+		TEXT("   Begin Object Class=/Script/Engine.Texture2D Name=\"Sub\"\n")
+		TEXT("      Value=1\n")
+		TEXT("   End Object\n")
+		TEXT("   Prop=(A={1,\n")
+		TEXT("2})\n")
+		TEXT("   Other=\"\u00E9t\u00E9\"\n")
+		TEXT("End Object\n");
+
+	TArray<uint8> UMCP_ToUtf8Bytes(const TCHAR* Text)
+	{
+		FTCHARToUTF8 Converter(Text);
+		return TArray<uint8>(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+	}
+
+	TArray<FString> UMCP_ReadAllChunks(FUMCP_T3DStreamReader& Reader)
+	{
+		TArray<FString> Chunks;
+		const TCHAR* Text = nullptr;
+		while (Reader.ReadChunk(Text))
+		{
+			Chunks.Add(Text);
+		}
+		return Chunks;
+	}
+}
+
+TEST_CASE_NAMED(FUMCP_T3DStreamReaderTests_SingleChunk, "Plugin.MCP.T3DStreamReader::SingleChunk", "[T3DStreamReader][SmokeFilter]")
+{
+	FUMCP_T3DStreamReader Reader;
+	CHECK_MESSAGE(TEXT("UTF-8 bytes should open."), Reader.OpenBytes(UMCP_ToUtf8Bytes(UMCP_TestT3D)));
+	TArray<FString> Chunks = UMCP_ReadAllChunks(Reader);
+	CHECK_MESSAGE(TEXT("A file under the chunk size should be one chunk with exactly its text."), Chunks.Num() == 1 && Chunks[0] == UMCP_TestT3D);
+
+	// UTF-16LE with a byte order mark, as FFileHelper::SaveStringToFile writes text that isn't ANSI
+	TArray<uint8> Utf16Bytes = { 0xFF, 0xFE };
+	for (const TCHAR* Char = UMCP_TestT3D; *Char; ++Char)
+	{
+		Utf16Bytes.Add(static_cast<uint8>(*Char & 0xFF));
+		Utf16Bytes.Add(static_cast<uint8>((*Char >> 8) & 0xFF));
+	}
+	CHECK_MESSAGE(TEXT("UTF-16LE bytes should open."), Reader.OpenBytes(MoveTemp(Utf16Bytes)));
+	Chunks = UMCP_ReadAllChunks(Reader);
+	CHECK_MESSAGE(TEXT("UTF-16LE text should read the same as UTF-8."), Chunks.Num() == 1 && Chunks[0] == UMCP_TestT3D);
+
+	CHECK_MESSAGE(TEXT("UTF-16 big endian is not supported."), !Reader.OpenBytes(TArray<uint8>({ 0xFE, 0xFF, 0x00, 0x41 })));
+	CHECK_MESSAGE(TEXT("An empty file should open and have no chunks."), Reader.OpenBytes(TArray<uint8>()) && UMCP_ReadAllChunks(Reader).Num() == 0);
+}
+
+TEST_CASE_NAMED(FUMCP_T3DStreamReaderTests_SplitsInsideTopLevelObject, "Plugin.MCP.T3DStreamReader::SplitsInsideTopLevelObject", "[T3DStreamReader][SmokeFilter]")
+{
+	// Small enough that every point where a split is allowed is used
+	FUMCP_T3DStreamReader Reader(8);
+	CHECK_MESSAGE(TEXT("UTF-8 bytes should open."), Reader.OpenBytes(UMCP_ToUtf8Bytes(UMCP_TestT3D)));
+	const TArray<FString> Chunks = UMCP_ReadAllChunks(Reader);
+	CHECK_MESSAGE(TEXT("The subobject block, the {} property and the last property should each be a chunk."), Chunks.Num() == 3);
+	if (Chunks.Num() != 3)
+	{
+		return;
+	}
+
+	const FString Header = TEXT("Begin Object Class=/Script/Engine.DataAsset Name=\"DA_Test\"\n");
+	for (const FString& Chunk : Chunks)
+	{
+		CHECK_MESSAGE(TEXT("Every chunk should open the top-level object."), Chunk.StartsWith(Header));
+		CHECK_MESSAGE(TEXT("Every chunk should close the top-level object."), Chunk.TrimEnd().EndsWith(TEXT("End Object")));
+	}
+	CHECK_MESSAGE(TEXT("The subobject block should stay whole."), Chunks[0].Contains(TEXT("      Value=1\n   End Object\n")));
+	CHECK_MESSAGE(TEXT("Lines inside {} should not be split."), Chunks[1].Contains(TEXT("   Prop=(A={1,\n2})\n")));
+	CHECK_MESSAGE(TEXT("Non-ASCII text should be converted."), Chunks[2].Contains(TEXT("   Other=\"\u00E9t\u00E9\"\n")));
+	CHECK_MESSAGE(TEXT("The last chunk should end with the file's own End Object."), Chunks[2].EndsWith(TEXT("\"\nEnd Object\n")));
+}
+
+TEST_CASE_NAMED(FUMCP_T3DStreamReaderTests_FindObjectBlocks, "Plugin.MCP.T3DStreamReader::FindObjectBlocks", "[T3DStreamReader][SmokeFilter]")
+{
+	const FString Text = UMCP_TestT3D;
+	TArray<int32> BlockStarts;
+	FUMCP_T3DStreamReader::FindObjectBlocks(Text, BlockStarts);
+	CHECK_MESSAGE(TEXT("The header, the subobject and the properties after it should each be a block."), BlockStarts.Num() == 3);
+	if (BlockStarts.Num() != 3)
+	{
+		return;
+	}
+	CHECK_MESSAGE(TEXT("The first block should start the text."), BlockStarts[0] == 0);
+	CHECK_MESSAGE(TEXT("The subobject block should be whole."), Text.Mid(BlockStarts[1], BlockStarts[2] - BlockStarts[1]) == TEXT("   Begin Object Class=/Script/Engine.Texture2D Name=\"Sub\"\n      Value=1\n   End Object\n"));
+	CHECK_MESSAGE(TEXT("The last block should run to the end of the text."), Text.RightChop(BlockStarts[2]).StartsWith(TEXT("   Prop=(A={1,\n2})\n")) && Text.EndsWith(TEXT("End Object\n")));
+
+	FUMCP_T3DStreamReader::FindObjectBlocks(FStringView(), BlockStarts);
+	CHECK_MESSAGE(TEXT("Empty text should have no blocks."), BlockStarts.Num() == 0);
+}
+
+#endif //WITH_TESTS
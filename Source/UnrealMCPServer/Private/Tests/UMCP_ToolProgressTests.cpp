@@ -0,0 +1,124 @@
+#include "UMCP_ToolProgress.h" // For FUMCP_ToolProgress, FUMCP_ToolProgressScope and FUMCP_JobContext
+#include "Tests/TestHarnessAdapter.h" // For TEST_CASE_NAMED and CHECK_MESSAGE
+
+#if WITH_TESTS
+
+namespace
+{
+	FUMCP_JsonRpcRequest MakeToolCallRequest(TSharedPtr<FJsonValue> ProgressToken, bool bAcceptsEventStream)
+	{
+		FUMCP_JsonRpcRequest Request;
+		Request.method = TEXT("tools/call");
+		Request.params = MakeShared<FJsonObject>();
+		if (ProgressToken.IsValid())
+		{
+			TSharedPtr<FJsonObject> Meta = MakeShared<FJsonObject>();
+			Meta->SetField(TEXT("progressToken"), ProgressToken);
+			Request.params->SetObjectField(TEXT("_meta"), Meta);
+		}
+		if (bAcceptsEventStream)
+		{
+			Request.EventStream = MakeShared<FUMCP_EventStream, ESPMode::ThreadSafe>();
+		}
+		return Request;
+	}
+
+	// Returns the JSON of every `data:` line in an SSE body
+	TArray<TSharedPtr<FJsonObject>> ParseEventMessages(const TArray<uint8>& Body)
+	{
+		TArray<FString> Lines;
+		UMCP_Utf8ToString(Body).ParseIntoArrayLines(Lines);
+
+		TArray<TSharedPtr<FJsonObject>> Messages;
+		for (const FString& Line : Lines)
+		{
+			FString Data;
+			if (!Line.Split(TEXT("data: "), nullptr, &Data))
+			{
+				continue;
+			}
+			TSharedPtr<FJsonObject> Message;
+			FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Data), Message);
+			Messages.Add(Message);
+		}
+		return Messages;
+	}
+}
+
+TEST_CASE_NAMED(FUMCP_ToolProgressTests_Inactive, "Plugin.MCP.ToolProgress::Inactive", "[ToolProgress][SmokeFilter]")
+{
+	CHECK_MESSAGE(TEXT("Progress should be inactive outside of a tool call."), !FUMCP_ToolProgress::IsActive());
+
+	FUMCP_JsonRpcRequest WithoutToken = MakeToolCallRequest(nullptr, true);
+	{
+		FUMCP_ToolProgressScope Scope(WithoutToken);
+		CHECK_MESSAGE(TEXT("Progress should be inactive without a progressToken."), !FUMCP_ToolProgress::IsActive());
+		FUMCP_ToolProgress::Report(1, 2);
+	}
+	CHECK_MESSAGE(TEXT("Nothing should be emitted without a progressToken."), !WithoutToken.EventStream->HasEvents());
+
+	FUMCP_JsonRpcRequest WithoutEventStream = MakeToolCallRequest(MakeShared<FJsonValueString>(TEXT("token")), false);
+	{
+		FUMCP_ToolProgressScope Scope(WithoutEventStream);
+		CHECK_MESSAGE(TEXT("Progress should be inactive when the client does not accept text/event-stream."), !FUMCP_ToolProgress::IsActive());
+	}
+}
+
+TEST_CASE_NAMED(FUMCP_ToolProgressTests_Notifications, "Plugin.MCP.ToolProgress::Notifications", "[ToolProgress][SmokeFilter]")
+{
+	FUMCP_JsonRpcRequest Request = MakeToolCallRequest(MakeShared<FJsonValueNumber>(42), true);
+	{
+		FUMCP_ToolProgressScope Scope(Request);
+		CHECK_MESSAGE(TEXT("Progress should be active with a progressToken and an event stream."), FUMCP_ToolProgress::IsActive());
+
+		FUMCP_ToolProgress::Report(1, 3, TEXT("/Game/Caf\u00E9.Caf\u00E9"));
+
+		FUMCP_CallToolResultContent Partial;
+		Partial.type = TEXT("text");
+		Partial.text = TEXT("line one\nline \"two\"");
+		FUMCP_ToolProgress::EmitPartialContent(Partial);
+	}
+	CHECK_MESSAGE(TEXT("Progress should be inactive once the scope ends."), !FUMCP_ToolProgress::IsActive());
+
+	const TArray<TSharedPtr<FJsonObject>> Messages = ParseEventMessages(Request.EventStream->TakeBody());
+	CHECK_MESSAGE(TEXT("Each emitted notification should be its own event."), Messages.Num() == 2);
+	if (Messages.Num() == 2 && Messages[0].IsValid() && Messages[1].IsValid())
+	{
+		const TSharedPtr<FJsonObject> Progress = Messages[0]->GetObjectField(TEXT("params"));
+		CHECK_MESSAGE(TEXT("First event should be notifications/progress."), Messages[0]->GetStringField(TEXT("method")) == TEXT("notifications/progress"));
+		CHECK_MESSAGE(TEXT("Progress token should be echoed back."), Progress->GetNumberField(TEXT("progressToken")) == 42);
+		CHECK_MESSAGE(TEXT("Progress and total should be reported."), Progress->GetNumberField(TEXT("progress")) == 1 && Progress->GetNumberField(TEXT("total")) == 3);
+		CHECK_MESSAGE(TEXT("Message should round trip."), Progress->GetStringField(TEXT("message")) == TEXT("/Game/Caf\u00E9.Caf\u00E9"));
+
+		const TSharedPtr<FJsonObject> PartialParams = Messages[1]->GetObjectField(TEXT("params"));
+		CHECK_MESSAGE(TEXT("Second event should carry partial content."), Messages[1]->GetStringField(TEXT("method")) == TEXT("notifications/unreal/partialContent"));
+		CHECK_MESSAGE(TEXT("Partial content text should round trip."), PartialParams->GetObjectField(TEXT("content"))->GetStringField(TEXT("text")) == TEXT("line one\nline \"two\""));
+	}
+}
+
+TEST_CASE_NAMED(FUMCP_ToolProgressTests_JobContext, "Plugin.MCP.ToolProgress::JobContext", "[ToolProgress][SmokeFilter]")
+{
+	// Outside of a tool call (a job stepped from the ticker) progress is only stored for get_job_status
+	FUMCP_JobContext Context;
+	Context.ReportProgress(2, 5, TEXT("/Game/A"));
+	double Progress = 0.0, Total = 0.0;
+	FString Message;
+	Context.GetProgress(Progress, Total, Message);
+	CHECK_MESSAGE(TEXT("Job progress should be stored."), Progress == 2 && Total == 5 && Message == TEXT("/Game/A"));
+
+	CHECK_MESSAGE(TEXT("A new job should not be cancelled."), !Context.IsCancelRequested());
+	Context.RequestCancel();
+	CHECK_MESSAGE(TEXT("Cancellation should be visible to the job."), Context.IsCancelRequested());
+
+	// Inside a streamed tools/call the same report also becomes notifications/progress
+	FUMCP_JsonRpcRequest Request = MakeToolCallRequest(MakeShared<FJsonValueString>(TEXT("token")), true);
+	{
+		FUMCP_ToolProgressScope Scope(Request);
+		Context.ReportProgress(3, 5);
+	}
+	const TArray<TSharedPtr<FJsonObject>> Messages = ParseEventMessages(Request.EventStream->TakeBody());
+	CHECK_MESSAGE(TEXT("Job progress inside a tool call should be forwarded as a notification."), Messages.Num() == 1 && Messages[0].IsValid()
+		&& Messages[0]->GetObjectField(TEXT("params"))->GetNumberField(TEXT("progress")) == 3);
+}
+
+#endif //WITH_TESTS
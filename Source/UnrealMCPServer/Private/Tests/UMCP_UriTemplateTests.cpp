@@ -1,6 +1,7 @@
 #include "UMCP_UriTemplate.h" // For FUMCP_UriTemplate
 #include "Tests/TestHarnessAdapter.h" // For TEST_CASE_NAMED and CHECK_MESSAGE
 #include "Containers/UnrealString.h" // For FString comparisons if needed
+#include "HAL/PlatformTime.h"
 
 #if WITH_TESTS
 
@@ -134,4 +135,190 @@ TEST_CASE_NAMED(FUMCP_UriTemplateMatchTests_Level2, "Plugin.MCP.UriTemplate.Matc
     }
 }
 
+TEST_CASE_NAMED(FUMCP_UriTemplateMatchTests_Query, "Plugin.MCP.UriTemplate.Match::Query", "[UriTemplate][Match][Level3][SmokeFilter]")
+{
+	DoUriTemplateMatchCheck(TEXT("unreal+t3d://{filepath}{?offset,length,block}"), TEXT("unreal+t3d:///Game/BP_A"), TMap<FString, TArray<FString>>{
+		{TEXT("filepath"), TArray<FString>{ TEXT("/Game/BP_A") }},
+	});
+	DoUriTemplateMatchCheck(TEXT("unreal+t3d://{filepath}{?offset,length,block}"), TEXT("unreal+t3d:///Game/BP_A?block=2"), TMap<FString, TArray<FString>>{
+		{TEXT("filepath"), TArray<FString>{ TEXT("/Game/BP_A") }},
+		{TEXT("block"), TArray<FString>{ TEXT("2") }},
+	});
+	DoUriTemplateMatchCheck(TEXT("unreal+t3d://{filepath}{?offset,length,block}"), TEXT("unreal+t3d:///Game/BP_A?length=100&offset=4096"), TMap<FString, TArray<FString>>{
+		{TEXT("filepath"), TArray<FString>{ TEXT("/Game/BP_A") }},
+		{TEXT("offset"), TArray<FString>{ TEXT("4096") }},
+		{TEXT("length"), TArray<FString>{ TEXT("100") }},
+	});
+	DoUriTemplateMatchCheck(TEXT("/search{?q}"), TEXT("/search?q=Hello%20World"), TMap<FString, TArray<FString>>{
+		{TEXT("q"), TArray<FString>{ TEXT("Hello World") }},
+	});
+	DoUriTemplateMatchFail(TEXT("unreal+t3d://{filepath}{?offset,length,block}"), TEXT("unreal+t3d:///Game/BP_A?chunk=2"));
+}
+
+TEST_CASE_NAMED(FUMCP_UriTemplateMatchTests_View, "Plugin.MCP.UriTemplate.Match::View", "[UriTemplate][Match][SmokeFilter]")
+{
+	FUMCP_UriTemplate UriTemplate(TEXT("unreal+t3d://{filepath}"));
+	const FString Uri = TEXT("unreal+t3d:///Game/My%20Folder/BP_A%21");
+
+	FUMCP_UriTemplateMatchView Match;
+	CHECK_MESSAGE(TEXT("URI should match."), UriTemplate.FindMatch(FStringView(Uri), Match));
+	CHECK_MESSAGE(TEXT("Match URI should view the caller's string."), Match.Uri.GetData() == *Uri);
+	CHECK_MESSAGE(TEXT("One variable should be captured."), Match.Captures.Num() == 1);
+
+	FStringView RawValue;
+	CHECK_MESSAGE(TEXT("Raw value should stay percent-encoded."), Match.GetRawValue(TEXT("filepath"), RawValue) && RawValue == TEXT("/Game/My%20Folder/BP_A%21"));
+	CHECK_MESSAGE(TEXT("Raw value should view into the URI."), RawValue.GetData() >= *Uri && RawValue.GetData() < *Uri + Uri.Len());
+
+	FString Value;
+	CHECK_MESSAGE(TEXT("Value should be decoded on request."), Match.GetValue(TEXT("filepath"), Value) && Value == TEXT("/Game/My Folder/BP_A!"));
+	CHECK_MESSAGE(TEXT("Unknown variables should not be found."), !Match.GetValue(TEXT("missing"), Value));
+
+	FUMCP_UriTemplateMatch Owning;
+	Match.ToMatch(Owning);
+	CHECK_MESSAGE(TEXT("Owning match should hold the decoded variable."), Owning.Uri == Uri && Owning.Variables.FindRef(TEXT("filepath")) == TArray<FString>{ Value });
+
+	CHECK_MESSAGE(TEXT("A reused match should be reset by a failed match."), !UriTemplate.FindMatch(FStringView(TEXT("unreal+md:///Game/BP_A")), Match) && Match.Captures.IsEmpty());
+}
+
+TEST_CASE_NAMED(FUMCP_UriTemplateExpandTests_Builder, "Plugin.MCP.UriTemplate.Expand::Builder", "[UriTemplate][Expand][SmokeFilter]")
+{
+	FUMCP_UriTemplate UriTemplate(TEXT("/simple/literal/path"));
+	TStringBuilder<64> Builder;
+	Builder.Append(TEXT("unreal+t3d:/"));
+	UriTemplate.Expand({}, Builder);
+	CHECK_MESSAGE(TEXT("Expand should append to what the builder already holds."), Builder.ToView() == TEXT("unreal+t3d://simple/literal/path"));
+	CHECK_MESSAGE(TEXT("FString Expand should produce the same text."), UriTemplate.Expand({}) == TEXT("/simple/literal/path"));
+}
+
+// --- URI Template Router Tests ---
+
+TEST_CASE_NAMED(FUMCP_UriTemplateRouterTests_Candidates, "Plugin.MCP.UriTemplate.Router::Candidates", "[UriTemplate][Router][SmokeFilter]")
+{
+	TArray<FUMCP_UriTemplate> Templates;
+	Templates.Emplace(TEXT("unreal+t3d://{filepath}"));
+	Templates.Emplace(TEXT("unreal+md://{filepath}"));
+	Templates.Emplace(TEXT("{+anything}"));
+	Templates.Emplace(TEXT("unreal+t3d:///Game/Special/{name}"));
+
+	FUMCP_UriTemplateRouter Router;
+	for (int32 Index = 0; Index < Templates.Num(); ++Index)
+	{
+		Router.Add(Templates[Index], Index);
+	}
+
+	auto CollectCandidates = [&Router](const TCHAR* Uri)
+	{
+		TArray<int32> Candidates;
+		Router.VisitCandidates(Uri, [&Candidates](int32 TemplateIndex) { Candidates.Add(TemplateIndex); return false; });
+		return Candidates;
+	};
+
+	CHECK_MESSAGE(TEXT("Longest leading literal should be offered first, expression-first templates last."), CollectCandidates(TEXT("unreal+t3d:///Game/Special/BP_A")) == TArray<int32>({ 3, 0, 2 }));
+	CHECK_MESSAGE(TEXT("A diverging URI should only get templates on its own path."), CollectCandidates(TEXT("unreal+md:///Game/BP_A")) == TArray<int32>({ 1, 2 }));
+	CHECK_MESSAGE(TEXT("A URI sharing no literal should only get expression-first templates."), CollectCandidates(TEXT("file:///tmp/x")) == TArray<int32>({ 2 }));
+
+	int32 Visited = INDEX_NONE;
+	const bool bFound = Router.VisitCandidates(TEXT("unreal+t3d:///Game/BP_A"), [&Templates, &Visited](int32 TemplateIndex)
+	{
+		FUMCP_UriTemplateMatch Match;
+		Visited = TemplateIndex;
+		return Templates[TemplateIndex].FindMatch(TEXT("unreal+t3d:///Game/BP_A"), Match);
+	});
+	CHECK_MESSAGE(TEXT("Visiting should stop at the first template that matches."), bFound && Visited == 0);
+
+	FUMCP_UriTemplateRouter EmptyRouter;
+	CHECK_MESSAGE(TEXT("An empty router should yield nothing."), !EmptyRouter.VisitCandidates(TEXT("unreal+t3d:///Game/BP_A"), [](int32) { return true; }));
+}
+
+// --- Benchmark ---
+// Routes resource URIs the way Rpc_ResourcesRead does, against a few hundred registered templates.
+// Before: FindMatch on every template in registration order until one matches.
+// After: FUMCP_UriTemplateRouter hands out only the templates whose leading literal the URI starts with.
+
+TEST_CASE_NAMED(FUMCP_UriTemplateRouterTests_Benchmark, "Plugin.MCP.UriTemplate.Router::Benchmark", "[UriTemplate][Router][Benchmark]")
+{
+	constexpr int32 NumProjectTemplates = 300;
+	constexpr int32 NumLookups = 20000;
+
+	TArray<FUMCP_UriTemplate> Templates;
+	for (int32 Index = 0; Index < NumProjectTemplates; ++Index)
+	{
+		Templates.Emplace(FString::Printf(TEXT("unreal+project%d://{filepath}"), Index));
+	}
+	Templates.Emplace(TEXT("unreal+t3d://{filepath}"));
+	Templates.Emplace(TEXT("unreal+md://{filepath}"));
+
+	FUMCP_UriTemplateRouter Router;
+	for (int32 Index = 0; Index < Templates.Num(); ++Index)
+	{
+		Router.Add(Templates[Index], Index);
+	}
+
+	// Mostly the built-in schemes, which are registered last and so are the worst case for the linear scan
+	TArray<FString> Uris;
+	for (int32 Index = 0; Index < 64; ++Index)
+	{
+		Uris.Add(FString::Printf(TEXT("unreal+t3d:///Game/Blueprints/BP_Actor_%d"), Index));
+		Uris.Add(FString::Printf(TEXT("unreal+md:///Game/Blueprints/BP_Actor_%d"), Index));
+		Uris.Add(FString::Printf(TEXT("unreal+project%d:///Game/Data/DT_%d"), (Index * 37) % NumProjectTemplates, Index));
+	}
+
+	uint64 LinearAttempts = 0;
+	TArray<int32> LinearMatches;
+	const double LinearStart = FPlatformTime::Seconds();
+	for (int32 Lookup = 0; Lookup < NumLookups; ++Lookup)
+	{
+		const FString& Uri = Uris[Lookup % Uris.Num()];
+		int32 Matched = INDEX_NONE;
+		for (int32 Index = 0; Index < Templates.Num(); ++Index)
+		{
+			FUMCP_UriTemplateMatch Match;
+			++LinearAttempts;
+			if (Templates[Index].FindMatch(Uri, Match))
+			{
+				Matched = Index;
+				break;
+			}
+		}
+		if (Lookup < Uris.Num())
+		{
+			LinearMatches.Add(Matched);
+		}
+	}
+	const double LinearMs = (FPlatformTime::Seconds() - LinearStart) * 1000.0;
+
+	uint64 RouterAttempts = 0;
+	TArray<int32> RouterMatches;
+	const double RouterStart = FPlatformTime::Seconds();
+	for (int32 Lookup = 0; Lookup < NumLookups; ++Lookup)
+	{
+		const FString& Uri = Uris[Lookup % Uris.Num()];
+		int32 Matched = INDEX_NONE;
+		Router.VisitCandidates(Uri, [&Templates, &Uri, &Matched, &RouterAttempts](int32 TemplateIndex)
+		{
+			FUMCP_UriTemplateMatch Match;
+			++RouterAttempts;
+			if (!Templates[TemplateIndex].FindMatch(Uri, Match))
+			{
+				return false;
+			}
+			Matched = TemplateIndex;
+			return true;
+		});
+		if (Lookup < Uris.Num())
+		{
+			RouterMatches.Add(Matched);
+		}
+	}
+	const double RouterMs = (FPlatformTime::Seconds() - RouterStart) * 1000.0;
+
+	UE_LOG(LogTemp, Display, TEXT("UriTemplateRouterBenchmark: %d lookups against %d templates"), NumLookups, Templates.Num());
+	UE_LOG(LogTemp, Display, TEXT("UriTemplateRouterBenchmark: linear scan ran FindMatch %llu times in %.2f ms"), LinearAttempts, LinearMs);
+	UE_LOG(LogTemp, Display, TEXT("UriTemplateRouterBenchmark: router ran FindMatch %llu times in %.2f ms"), RouterAttempts, RouterMs);
+
+	CHECK_MESSAGE(TEXT("Router should pick the same template as the linear scan."), RouterMatches == LinearMatches);
+	CHECK_MESSAGE(TEXT("Every benchmark URI should match a template."), !RouterMatches.Contains(INDEX_NONE));
+	CHECK_MESSAGE(TEXT("Router should run FindMatch once per lookup."), RouterAttempts == NumLookups);
+}
+
 #endif //WITH_TESTS
@@ -0,0 +1,394 @@
+#include "UMCP_AssetNameIndex.h"
+#include "UMCP_Trace.h"
+#include "UnrealMCPServerModule.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Algo/BinarySearch.h"
+#include "Async/Async.h"
+
+namespace
+{
+	// Three characters of 21 bits each, enough for any Unicode code point
+	uint64 MakeTrigram(const TCHAR* Chars)
+	{
+		return (static_cast<uint64>(Chars[0] & 0x1FFFFF) << 42) | (static_cast<uint64>(Chars[1] & 0x1FFFFF) << 21) | static_cast<uint64>(Chars[2] & 0x1FFFFF);
+	}
+
+	using FTrigramArray = TArray<uint64, TInlineAllocator<128>>;
+
+	void AddTrigrams(FStringView Text, FTrigramArray& OutTrigrams)
+	{
+		for (int32 Index = 0; Index + 3 <= Text.Len(); ++Index)
+		{
+			OutTrigrams.Add(MakeTrigram(Text.GetData() + Index));
+		}
+	}
+
+	void SortUniqueTrigrams(FTrigramArray& Trigrams)
+	{
+		Trigrams.Sort();
+		int32 NumUnique = 0;
+		for (int32 Index = 0; Index < Trigrams.Num(); ++Index)
+		{
+			if (NumUnique == 0 || Trigrams[NumUnique - 1] != Trigrams[Index])
+			{
+				Trigrams[NumUnique++] = Trigrams[Index];
+			}
+		}
+		Trigrams.RemoveAt(NumUnique, Trigrams.Num() - NumUnique);
+	}
+
+	bool IsWildcardPattern(const FString& Pattern)
+	{
+		return Pattern.Contains(TEXT("*")) || Pattern.Contains(TEXT("?"));
+	}
+}
+
+FUMCP_AssetNameIndex::~FUMCP_AssetNameIndex()
+{
+	Shutdown();
+}
+
+void FUMCP_AssetNameIndex::Initialize()
+{
+	Shutdown();
+
+	// Assets found by the initial scan would each be an AssetAdded event; they come from the build instead
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		UE_LOG(LogUnrealMCPServer, Log, TEXT("FUMCP_AssetNameIndex: Waiting for the AssetRegistry scan to finish"));
+		FilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddRaw(this, &FUMCP_AssetNameIndex::StartBuild);
+	}
+	else
+	{
+		StartBuild();
+	}
+}
+
+void FUMCP_AssetNameIndex::Shutdown()
+{
+	// The AssetRegistry may already be gone during editor shutdown
+	if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+	{
+		AssetRegistry->OnFilesLoaded().Remove(FilesLoadedHandle);
+		AssetRegistry->OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry->OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry->OnAssetRenamed().Remove(AssetRenamedHandle);
+		AssetRegistry->OnAssetUpdated().Remove(AssetUpdatedHandle);
+	}
+	FilesLoadedHandle.Reset();
+	AssetAddedHandle.Reset();
+	AssetRemovedHandle.Reset();
+	AssetRenamedHandle.Reset();
+	AssetUpdatedHandle.Reset();
+
+	bCancelBuild = true;
+	if (BuildFuture.IsValid())
+	{
+		BuildFuture.Wait();
+		BuildFuture.Reset();
+	}
+
+	FWriteScopeLock WriteLock(Lock);
+	Data = FIndexData();
+	PendingChanges.Empty();
+	bBuilding = false;
+	bReady = false;
+}
+
+void FUMCP_AssetNameIndex::StartBuild()
+{
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	AssetRegistry.OnFilesLoaded().Remove(FilesLoadedHandle);
+	FilesLoadedHandle.Reset();
+
+	// Changes from here on are queued until the build is swapped in, so none made while it reads the registry are lost
+	{
+		FWriteScopeLock WriteLock(Lock);
+		bBuilding = true;
+		PendingChanges.Empty();
+	}
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FUMCP_AssetNameIndex::OnAssetAdded);
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FUMCP_AssetNameIndex::OnAssetRemoved);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FUMCP_AssetNameIndex::OnAssetRenamed);
+	AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddRaw(this, &FUMCP_AssetNameIndex::OnAssetAdded);
+
+	bCancelBuild = false;
+	BuildFuture = Async(EAsyncExecution::ThreadPool, [this]()
+	{
+		UMCP_TRACE_SCOPE(UMCP_BuildAssetNameIndex);
+		const double StartTime = FPlatformTime::Seconds();
+
+		// Assets that only exist in memory are left to OnAssetAdded; listing them would need the game thread
+		TArray<FAssetData> Assets;
+		IAssetRegistry::GetChecked().GetAllAssets(Assets, true);
+
+		FIndexData NewData;
+		NewData.Entries.Reserve(Assets.Num());
+		for (const FAssetData& AssetData : Assets)
+		{
+			if (bCancelBuild)
+			{
+				return;
+			}
+			NewData.AddAsset(AssetData);
+		}
+		Assets.Empty();
+
+		FWriteScopeLock WriteLock(Lock);
+		if (bCancelBuild)
+		{
+			return;
+		}
+		Data = MoveTemp(NewData);
+		for (const FPendingChange& Change : PendingChanges)
+		{
+			ApplyChangeLocked(Change);
+		}
+		UE_LOG(LogUnrealMCPServer, Log, TEXT("FUMCP_AssetNameIndex: Indexed %d assets in %.2f s (%d changes replayed)"), Data.Entries.Num() - Data.NumRemoved, FPlatformTime::Seconds() - StartTime, PendingChanges.Num());
+		PendingChanges.Empty();
+		BuildSeconds = FPlatformTime::Seconds() - StartTime;
+		bBuilding = false;
+		bReady = true;
+	});
+}
+
+bool FUMCP_AssetNameIndex::FindPackages(EField Field, const FString& Pattern, TSet<FName>& OutPackageNames) const
+{
+	UMCP_TRACE_SCOPE(UMCP_AssetNameIndexFind);
+	const FString LowerPattern = Pattern.ToLower();
+	const bool bWildcard = IsWildcardPattern(LowerPattern);
+
+	// Every match contains the trigrams of each literal run of the pattern
+	FTrigramArray Trigrams;
+	if (bWildcard)
+	{
+		int32 RunStart = 0;
+		for (int32 Index = 0; Index <= LowerPattern.Len(); ++Index)
+		{
+			if (Index == LowerPattern.Len() || LowerPattern[Index] == TEXT('*') || LowerPattern[Index] == TEXT('?'))
+			{
+				AddTrigrams(FStringView(*LowerPattern + RunStart, Index - RunStart), Trigrams);
+				RunStart = Index + 1;
+			}
+		}
+	}
+	else
+	{
+		AddTrigrams(LowerPattern, Trigrams);
+	}
+	SortUniqueTrigrams(Trigrams);
+
+	FReadScopeLock ReadLock(Lock);
+	if (!bReady)
+	{
+		return false;
+	}
+
+	const int32 FieldIndex = static_cast<int32>(Field);
+	auto Matches = [this, FieldIndex, bWildcard, &LowerPattern](int32 EntryIndex)
+	{
+		const FEntry& Entry = Data.Entries[EntryIndex];
+		if (Entry.bRemoved)
+		{
+			return false;
+		}
+		const FString& Text = Entry.Text[FieldIndex];
+		return bWildcard ? Text.MatchesWildcard(LowerPattern, ESearchCase::CaseSensitive) : Text.Contains(LowerPattern, ESearchCase::CaseSensitive);
+	};
+
+	// Patterns without a literal run of three characters (e.g. "BP" or "*") check every entry
+	if (Trigrams.Num() == 0)
+	{
+		for (int32 EntryIndex = 0; EntryIndex < Data.Entries.Num(); ++EntryIndex)
+		{
+			if (Matches(EntryIndex))
+			{
+				OutPackageNames.Add(Data.Entries[EntryIndex].PackageName);
+			}
+		}
+		return true;
+	}
+
+	TArray<const TArray<int32>*, TInlineAllocator<128>> PostingLists;
+	for (uint64 Trigram : Trigrams)
+	{
+		const TArray<int32>* PostingList = Data.Postings[FieldIndex].Find(Trigram);
+		if (!PostingList)
+		{
+			return true;
+		}
+		PostingLists.Add(PostingList);
+	}
+
+	// Intersect starting from the rarest trigram, so the candidate list is as short as it gets from the start
+	PostingLists.Sort([](const TArray<int32>& A, const TArray<int32>& B) { return A.Num() < B.Num(); });
+	TArray<int32> Candidates = *PostingLists[0];
+	for (int32 ListIndex = 1; ListIndex < PostingLists.Num() && Candidates.Num() > 0; ++ListIndex)
+	{
+		const TArray<int32>& PostingList = *PostingLists[ListIndex];
+		Candidates.RemoveAll([&PostingList](int32 EntryIndex)
+		{
+			return Algo::BinarySearch(PostingList, EntryIndex) == INDEX_NONE;
+		});
+	}
+
+	for (int32 EntryIndex : Candidates)
+	{
+		if (Matches(EntryIndex))
+		{
+			OutPackageNames.Add(Data.Entries[EntryIndex].PackageName);
+		}
+	}
+	return true;
+}
+
+FUMCP_AssetNameIndexStats FUMCP_AssetNameIndex::GetStats() const
+{
+	FReadScopeLock ReadLock(Lock);
+	FUMCP_AssetNameIndexStats Stats;
+	Stats.bReady = bReady;
+	Stats.NumAssets = Data.Entries.Num() - Data.NumRemoved;
+	Stats.BuildSeconds = BuildSeconds;
+	Stats.MemoryBytes = Data.Entries.GetAllocatedSize() + Data.EntryIndexByObjectPath.GetAllocatedSize();
+	for (const FEntry& Entry : Data.Entries)
+	{
+		for (const FString& Text : Entry.Text)
+		{
+			Stats.MemoryBytes += Text.GetAllocatedSize();
+		}
+	}
+	for (const TMap<uint64, TArray<int32>>& Postings : Data.Postings)
+	{
+		Stats.NumTrigrams += Postings.Num();
+		Stats.MemoryBytes += Postings.GetAllocatedSize();
+		for (const TPair<uint64, TArray<int32>>& Pair : Postings)
+		{
+			Stats.MemoryBytes += Pair.Value.GetAllocatedSize();
+		}
+	}
+	return Stats;
+}
+
+void FUMCP_AssetNameIndex::OnAssetAdded(const FAssetData& AssetData)
+{
+	FPendingChange Change;
+	Change.AddedAsset = AssetData;
+	ApplyChange(MoveTemp(Change));
+}
+
+void FUMCP_AssetNameIndex::OnAssetRemoved(const FAssetData& AssetData)
+{
+	FPendingChange Change;
+	Change.RemovedObjectPath = AssetData.GetSoftObjectPath();
+	ApplyChange(MoveTemp(Change));
+}
+
+void FUMCP_AssetNameIndex::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	FPendingChange Change;
+	Change.RemovedObjectPath = FSoftObjectPath(OldObjectPath);
+	Change.AddedAsset = AssetData;
+	ApplyChange(MoveTemp(Change));
+}
+
+void FUMCP_AssetNameIndex::ApplyChange(FPendingChange&& Change)
+{
+	FWriteScopeLock WriteLock(Lock);
+	if (bBuilding)
+	{
+		PendingChanges.Add(MoveTemp(Change));
+	}
+	else if (bReady)
+	{
+		ApplyChangeLocked(Change);
+	}
+}
+
+void FUMCP_AssetNameIndex::ApplyChangeLocked(const FPendingChange& Change)
+{
+	if (Change.RemovedObjectPath.IsValid())
+	{
+		Data.RemoveAsset(Change.RemovedObjectPath);
+	}
+	if (Change.AddedAsset.IsSet())
+	{
+		Data.AddAsset(Change.AddedAsset.GetValue());
+	}
+	Data.Compact();
+}
+
+void FUMCP_AssetNameIndex::FIndexData::AddAsset(const FAssetData& AssetData)
+{
+	FEntry Entry;
+	Entry.ObjectPath = AssetData.GetSoftObjectPath();
+	Entry.PackageName = AssetData.PackageName;
+	Entry.Text[static_cast<int32>(EField::PackageName)] = AssetData.PackageName.ToString().ToLower();
+	Entry.Text[static_cast<int32>(EField::AssetName)] = AssetData.AssetName.ToString().ToLower();
+	FString ParentClassPath;
+	if (AssetData.GetTagValue(TEXT("ParentClass"), ParentClassPath))
+	{
+		Entry.Text[static_cast<int32>(EField::ParentClass)] = ParentClassPath.ToLower();
+	}
+	AddEntry(MoveTemp(Entry));
+}
+
+void FUMCP_AssetNameIndex::FIndexData::AddEntry(FEntry&& Entry)
+{
+	// Updates replace the entry, since the tags (and so the parent class) may have changed
+	RemoveAsset(Entry.ObjectPath);
+
+	const int32 EntryIndex = Entries.Add(MoveTemp(Entry));
+	EntryIndexByObjectPath.Add(Entries[EntryIndex].ObjectPath, EntryIndex);
+	for (int32 FieldIndex = 0; FieldIndex < static_cast<int32>(EField::Num); ++FieldIndex)
+	{
+		FTrigramArray Trigrams;
+		AddTrigrams(Entries[EntryIndex].Text[FieldIndex], Trigrams);
+		SortUniqueTrigrams(Trigrams);
+		for (uint64 Trigram : Trigrams)
+		{
+			// Entries are only ever appended, so every posting list stays sorted
+			Postings[FieldIndex].FindOrAdd(Trigram).Add(EntryIndex);
+		}
+	}
+}
+
+void FUMCP_AssetNameIndex::FIndexData::RemoveAsset(const FSoftObjectPath& ObjectPath)
+{
+	int32 EntryIndex = INDEX_NONE;
+	if (!EntryIndexByObjectPath.RemoveAndCopyValue(ObjectPath, EntryIndex))
+	{
+		return;
+	}
+
+	// Posting lists still point at the entry; queries skip it until the next compaction
+	FEntry& Entry = Entries[EntryIndex];
+	Entry.bRemoved = true;
+	for (FString& Text : Entry.Text)
+	{
+		Text.Empty();
+	}
+	NumRemoved++;
+}
+
+void FUMCP_AssetNameIndex::FIndexData::Compact()
+{
+	if (NumRemoved < 1024 || NumRemoved * 2 < Entries.Num())
+	{
+		return;
+	}
+
+	UMCP_TRACE_SCOPE(UMCP_CompactAssetNameIndex);
+	const int32 NumLiveEntries = Entries.Num() - NumRemoved;
+	TArray<FEntry> OldEntries = MoveTemp(Entries);
+	*this = FIndexData();
+	Entries.Reserve(NumLiveEntries);
+	for (FEntry& Entry : OldEntries)
+	{
+		if (!Entry.bRemoved)
+		{
+			AddEntry(MoveTemp(Entry));
+		}
+	}
+}
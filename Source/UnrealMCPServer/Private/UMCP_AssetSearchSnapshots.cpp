@@ -0,0 +1,150 @@
+#include "UMCP_AssetSearchSnapshots.h"
+#include "UnrealMCPServerModule.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/Base64.h"
+
+FUMCP_AssetSearchSnapshots::~FUMCP_AssetSearchSnapshots()
+{
+	Shutdown();
+}
+
+void FUMCP_AssetSearchSnapshots::Initialize(int64 InMemoryBudgetBytes, double InTimeToLiveSeconds)
+{
+	Shutdown();
+	{
+		FScopeLock ScopeLock(&Lock);
+		MemoryBudgetBytes = FMath::Max<int64>(InMemoryBudgetBytes, 0);
+		TimeToLiveSeconds = FMath::Max(InTimeToLiveSeconds, 0.0);
+	}
+	if (MemoryBudgetBytes == 0)
+	{
+		return;
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddLambda([this](const FAssetData&) { BumpRegistryGeneration(); });
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddLambda([this](const FAssetData&) { BumpRegistryGeneration(); });
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddLambda([this](const FAssetData&, const FString&) { BumpRegistryGeneration(); });
+	AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddLambda([this](const FAssetData&) { BumpRegistryGeneration(); });
+}
+
+void FUMCP_AssetSearchSnapshots::Shutdown()
+{
+	if (AssetAddedHandle.IsValid())
+	{
+		// The AssetRegistry may already be gone during editor shutdown
+		if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+		{
+			AssetRegistry->OnAssetAdded().Remove(AssetAddedHandle);
+			AssetRegistry->OnAssetRemoved().Remove(AssetRemovedHandle);
+			AssetRegistry->OnAssetRenamed().Remove(AssetRenamedHandle);
+			AssetRegistry->OnAssetUpdated().Remove(AssetUpdatedHandle);
+		}
+		AssetAddedHandle.Reset();
+		AssetRemovedHandle.Reset();
+		AssetRenamedHandle.Reset();
+		AssetUpdatedHandle.Reset();
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	Entries.Empty();
+	MemoryBytes = 0;
+	MemoryBudgetBytes = 0;
+}
+
+FString FUMCP_AssetSearchSnapshots::CreateSnapshot(const FString& ToolName, TSharedPtr<FJsonObject> Arguments, uint32 InRegistryGeneration, TArray<FAssetData>&& Assets, int32 Offset)
+{
+	// Tag maps are shared with the registry, so the FAssetData array itself is what a snapshot costs
+	const int64 NumBytes = Assets.GetAllocatedSize() + sizeof(FUMCP_AssetSearchSnapshot);
+	const double Now = FPlatformTime::Seconds();
+
+	FScopeLock ScopeLock(&Lock);
+	if (NumBytes > MemoryBudgetBytes || InRegistryGeneration != RegistryGeneration.load())
+	{
+		return FString();
+	}
+	RemoveExpiredLocked(Now);
+	while (MemoryBytes + NumBytes > MemoryBudgetBytes && Entries.Num() > 0)
+	{
+		uint32 OldestId = 0;
+		double OldestAccessTime = TNumericLimits<double>::Max();
+		for (const TPair<uint32, FEntry>& Pair : Entries)
+		{
+			if (Pair.Value.LastAccessTime < OldestAccessTime)
+			{
+				OldestId = Pair.Key;
+				OldestAccessTime = Pair.Value.LastAccessTime;
+			}
+		}
+		MemoryBytes -= Entries.FindAndRemoveChecked(OldestId).NumBytes;
+	}
+
+	TSharedPtr<FUMCP_AssetSearchSnapshot> Snapshot = MakeShared<FUMCP_AssetSearchSnapshot>();
+	Snapshot->Id = NextId++;
+	Snapshot->RegistryGeneration = InRegistryGeneration;
+	Snapshot->ToolName = ToolName;
+	Snapshot->Arguments = MoveTemp(Arguments);
+	Snapshot->Assets = MoveTemp(Assets);
+
+	FEntry& Entry = Entries.Add(Snapshot->Id);
+	Entry.Snapshot = Snapshot;
+	Entry.NumBytes = NumBytes;
+	Entry.LastAccessTime = Now;
+	MemoryBytes += NumBytes;
+	UE_LOG(LogUnrealMCPServer, Verbose, TEXT("FUMCP_AssetSearchSnapshots: Created snapshot %u of %d assets for %s (%lld bytes, %d snapshots)"), Snapshot->Id, Snapshot->Assets.Num(), *ToolName, NumBytes, Entries.Num());
+	return MakeCursor(*Snapshot, Offset);
+}
+
+TSharedPtr<const FUMCP_AssetSearchSnapshot> FUMCP_AssetSearchSnapshots::FindSnapshot(const FString& ToolName, const FString& Cursor, int32& OutOffset, FString& OutError)
+{
+	// Cursors are opaque to clients: base64 of "<snapshot id>:<registry generation>:<offset>"
+	FString DecodedCursor;
+	TArray<FString> Parts;
+	if (!FBase64::Decode(Cursor, DecodedCursor) || DecodedCursor.ParseIntoArray(Parts, TEXT(":")) != 3
+		|| !Parts[0].IsNumeric() || !Parts[1].IsNumeric() || !Parts[2].IsNumeric())
+	{
+		OutError = TEXT("Invalid cursor");
+		return nullptr;
+	}
+	const uint32 Id = static_cast<uint32>(FCString::Strtoui64(*Parts[0], nullptr, 10));
+	const uint32 Generation = static_cast<uint32>(FCString::Strtoui64(*Parts[1], nullptr, 10));
+
+	FScopeLock ScopeLock(&Lock);
+	const double Now = FPlatformTime::Seconds();
+	RemoveExpiredLocked(Now);
+	FEntry* Entry = Entries.Find(Id);
+	if (!Entry || Entry->Snapshot->RegistryGeneration != Generation || Entry->Snapshot->ToolName != ToolName)
+	{
+		OutError = TEXT("Invalid or expired cursor. Run the search again without a cursor.");
+		return nullptr;
+	}
+	if (Generation != RegistryGeneration.load())
+	{
+		MemoryBytes -= Entry->NumBytes;
+		Entries.Remove(Id);
+		OutError = TEXT("The asset registry changed since this search ran. Run the search again without a cursor.");
+		return nullptr;
+	}
+
+	Entry->LastAccessTime = Now;
+	OutOffset = FMath::Clamp(FCString::Atoi(*Parts[2]), 0, Entry->Snapshot->Assets.Num());
+	return Entry->Snapshot;
+}
+
+FString FUMCP_AssetSearchSnapshots::MakeCursor(const FUMCP_AssetSearchSnapshot& Snapshot, int32 Offset)
+{
+	return FBase64::Encode(FString::Printf(TEXT("%u:%u:%d"), Snapshot.Id, Snapshot.RegistryGeneration, Offset));
+}
+
+void FUMCP_AssetSearchSnapshots::RemoveExpiredLocked(double Now)
+{
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (Now - It.Value().LastAccessTime > TimeToLiveSeconds)
+		{
+			MemoryBytes -= It.Value().NumBytes;
+			It.RemoveCurrent();
+		}
+	}
+}
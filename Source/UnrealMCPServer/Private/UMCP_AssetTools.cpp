@@ -1,6 +1,8 @@
 #include "UMCP_AssetTools.h"
 #include "UMCP_Server.h"
 #include "UMCP_Types.h"
+#include "UMCP_Trace.h"
+#include "UMCP_ToolProgress.h"
 #include "UMCP_T3DFallbackFactory.h"
 #include "UnrealMCPServerModule.h"
 #include "UObject/UnrealType.h"
@@ -15,6 +17,10 @@
 #include "HAL/PlatformFilemanager.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
+#include "Misc/PackageName.h"
+#include "HAL/FileManager.h"
+#include "Async/Async.h"
+#include "Containers/Queue.h"
 #include "Factories/Factory.h"
 #include "AssetToolsModule.h"
 #include "IAssetTools.h"
@@ -22,6 +28,8 @@
 #include "Editor/UnrealEd/Public/AutomatedAssetImportData.h"
 #include "Engine/Engine.h"
 #include "Misc/ScopeExit.h"
+#include "ScopedTransaction.h"
+#include "UObject/SavePackage.h"
 #include "Internationalization/Text.h"
 #include "Interfaces/IPluginManager.h"
 
@@ -103,11 +111,436 @@ namespace
 		// Otherwise, use case-insensitive substring matching
 		return FullPackageName.Contains(Pattern, ESearchCase::IgnoreCase);
 	}
+
+	// Exported text is held in memory until its file is written, so only this many writes may be in flight
+	constexpr int32 BatchExportMaxPendingWrites = 8;
+	const TCHAR* BatchExportDefaultNdjsonFileName = TEXT("export.ndjson");
+
+	enum class EUMCP_BatchExportEntryState : uint8
+	{
+		Pending,
+		Writing,
+		Exported,
+		Failed,
+	};
+
+	struct FUMCP_BatchExportEntry
+	{
+		FString ObjectPath;
+		FString FilePath; // Assigned once for the whole batch before the first export
+		int32 LoadRequestId = INDEX_NONE; // Of FUMCP_PackageLoader
+		EUMCP_BatchExportEntryState State = EUMCP_BatchExportEntryState::Pending;
+	};
+
+	// Shared between the job steps on the game thread and the file writes on worker threads
+	struct FUMCP_BatchExportState
+	{
+		FUMCP_BatchExportAssetsParams Params;
+		FString AbsoluteOutputFolder;
+		FUMCP_BatchExportAssetsResult Result;
+		TArray<FUMCP_BatchExportEntry> Entries;
+		bool bFilePathsAssigned = false;
+		int32 NextExportIndex = 0;
+		int32 NextLoadIndex = 0;
+		int32 NumPendingWrites = 0; // Game thread only; decremented when a completion is drained
+
+		FCriticalSection CompletedWritesLock;
+		TArray<TPair<int32, bool>> CompletedWrites; // Entry index and whether the file was written
+
+		// outputMode "ndjson": every record goes to one file, appended by a single writer in request order
+		bool bNdjson = false;
+		FString NdjsonFilePath;
+		FString IndexFilePath;
+		TUniquePtr<FArchive> NdjsonWriter; // Only touched by the record writer until the last write has completed
+		TUniquePtr<FArchive> IndexWriter;
+		TArray<uint8> RecordBuffer; // Reused for every record, so memory doesn't grow with the batch
+		TQueue<TPair<int32, FString>, EQueueMode::Spsc> PendingRecords; // Entry index and exported text
+		std::atomic<bool> bRecordWriterRunning{ false };
+	};
+
+	// Extracts the object name from a path (e.g., "/Game/MyAsset.MyAsset" -> "MyAsset"), sanitized for use as a filename
+	FString GetBatchExportFileBaseName(const FString& ObjectPath)
+	{
+		FString ObjectName;
+		int32 LastDotIndex;
+		if (ObjectPath.FindLastChar(TEXT('.'), LastDotIndex))
+		{
+			FString PathBeforeDot = ObjectPath.Left(LastDotIndex);
+			int32 LastSlashIndex;
+			if (PathBeforeDot.FindLastChar(TEXT('/'), LastSlashIndex))
+			{
+				ObjectName = PathBeforeDot.Mid(LastSlashIndex + 1);
+			}
+			else
+			{
+				ObjectName = PathBeforeDot;
+			}
+		}
+		else
+		{
+			// Fallback: use last part of path
+			int32 LastSlashIndex;
+			if (ObjectPath.FindLastChar(TEXT('/'), LastSlashIndex))
+			{
+				ObjectName = ObjectPath.Mid(LastSlashIndex + 1);
+			}
+			else
+			{
+				ObjectName = ObjectPath;
+			}
+		}
+
+		// Sanitize filename (remove invalid characters)
+		ObjectName = ObjectName.Replace(TEXT(" "), TEXT("_"));
+		ObjectName = ObjectName.Replace(TEXT("."), TEXT("_"));
+		return ObjectName;
+	}
+
+	// Lists the output folder once and resolves name collisions in memory, appending a number like "Name_1.t3d".
+	// Existing files are never overwritten.
+	void AssignBatchExportFilePaths(FUMCP_BatchExportState& State)
+	{
+		UMCP_TRACE_SCOPE(UMCP_AssignExportFilePaths);
+		TArray<FString> ExistingFiles;
+		IFileManager::Get().FindFiles(ExistingFiles, *FPaths::Combine(State.AbsoluteOutputFolder, TEXT("*")), true, false);
+		TSet<FString> UsedFileNames(MoveTemp(ExistingFiles)); // FString comparison ignores case, like the file system on Windows
+
+		const FString Extension = TEXT(".") + State.Params.format.ToLower();
+		for (FUMCP_BatchExportEntry& Entry : State.Entries)
+		{
+			if (Entry.ObjectPath.IsEmpty())
+			{
+				continue;
+			}
+			const FString BaseName = GetBatchExportFileBaseName(Entry.ObjectPath);
+			FString FileName = BaseName + Extension;
+			for (int32 Counter = 1; UsedFileNames.Contains(FileName); ++Counter)
+			{
+				FileName = FString::Printf(TEXT("%s_%d%s"), *BaseName, Counter, *Extension);
+			}
+			UsedFileNames.Add(FileName);
+			Entry.FilePath = FPaths::Combine(State.AbsoluteOutputFolder, FileName);
+		}
+		State.bFilePathsAssigned = true;
+	}
+
+	// Picks "<name>.ndjson" and its "<name>.index.ndjson" in the output folder, appending a number like "export_1.ndjson"
+	// if either exists, and opens both for writing
+	bool OpenBatchExportNdjson(FUMCP_BatchExportState& State, FString& OutError)
+	{
+		const FString FileName = State.Params.outputFileName.IsEmpty() ? FString(BatchExportDefaultNdjsonFileName) : State.Params.outputFileName;
+		if (FPaths::GetCleanFilename(FileName) != FileName)
+		{
+			OutError = FString::Printf(TEXT("outputFileName must be a file name without a folder: %s"), *FileName);
+			return false;
+		}
+		const FString BaseName = FPaths::GetBaseFilename(FileName);
+		const FString Extension = FPaths::GetExtension(FileName, true).IsEmpty() ? FString(TEXT(".ndjson")) : FPaths::GetExtension(FileName, true);
+
+		IFileManager& FileManager = IFileManager::Get();
+		FString Name = BaseName;
+		for (int32 Counter = 1; ; ++Counter)
+		{
+			State.NdjsonFilePath = FPaths::Combine(State.AbsoluteOutputFolder, Name + Extension);
+			State.IndexFilePath = FPaths::Combine(State.AbsoluteOutputFolder, Name + TEXT(".index") + Extension);
+			if (!FileManager.FileExists(*State.NdjsonFilePath) && !FileManager.FileExists(*State.IndexFilePath))
+			{
+				break;
+			}
+			Name = FString::Printf(TEXT("%s_%d"), *BaseName, Counter);
+		}
+
+		State.NdjsonWriter.Reset(FileManager.CreateFileWriter(*State.NdjsonFilePath));
+		State.IndexWriter.Reset(FileManager.CreateFileWriter(*State.IndexFilePath));
+		if (!State.NdjsonWriter || !State.IndexWriter)
+		{
+			OutError = FString::Printf(TEXT("Failed to create output file: %s"), State.NdjsonWriter ? *State.IndexFilePath : *State.NdjsonFilePath);
+			return false;
+		}
+		return true;
+	}
+
+	// Appends the queued records to the NDJSON file and its index. Only one writer runs at a time; whoever queues a record
+	// while none is running starts one, so records land in the order they were queued without blocking a worker.
+	void WriteBatchExportRecords(const TSharedRef<FUMCP_BatchExportState>& State)
+	{
+		do
+		{
+			TPair<int32, FString> Record;
+			while (State->PendingRecords.Dequeue(Record))
+			{
+				UMCP_TRACE_SCOPE(UMCP_WriteExportRecord);
+				const FString& ObjectPath = State->Entries[Record.Key].ObjectPath;
+				TArray<uint8>& Buffer = State->RecordBuffer;
+
+				Buffer.Reset();
+				UMCP_AppendUtf8(Buffer, "{\"objectPath\":");
+				UMCP_AppendJsonString(Buffer, ObjectPath);
+				UMCP_AppendUtf8(Buffer, ",\"format\":");
+				UMCP_AppendJsonString(Buffer, State->Params.format);
+				UMCP_AppendUtf8(Buffer, ",\"text\":");
+				UMCP_AppendJsonString(Buffer, Record.Value);
+				UMCP_AppendUtf8(Buffer, "}");
+				Record.Value.Empty();
+				const int64 Offset = State->NdjsonWriter->Tell();
+				const int64 Length = Buffer.Num();
+				Buffer.Add('\n');
+				State->NdjsonWriter->Serialize(Buffer.GetData(), Buffer.Num());
+
+				// Offsets and lengths are in bytes and leave out the newline, so a reader can seek straight to one record
+				Buffer.Reset();
+				UMCP_AppendUtf8(Buffer, "{\"objectPath\":");
+				UMCP_AppendJsonString(Buffer, ObjectPath);
+				ANSICHAR Suffix[64];
+				const int32 SuffixLen = FCStringAnsi::Snprintf(Suffix, UE_ARRAY_COUNT(Suffix), ",\"offset\":%lld,\"length\":%lld}\n", static_cast<long long>(Offset), static_cast<long long>(Length));
+				UMCP_AppendUtf8(Buffer, FAnsiStringView(Suffix, SuffixLen));
+				State->IndexWriter->Serialize(Buffer.GetData(), Buffer.Num());
+
+				const bool bWritten = !State->NdjsonWriter->IsError() && !State->IndexWriter->IsError();
+				FScopeLock Lock(&State->CompletedWritesLock);
+				State->CompletedWrites.Emplace(Record.Key, bWritten);
+			}
+			State->bRecordWriterRunning = false;
+			// A record queued after the last Dequeue but before the flag was cleared found the writer still running
+		} while (!State->PendingRecords.IsEmpty() && !State->bRecordWriterRunning.exchange(true));
+	}
+
+	// Keeps up to the loader's window of package loads in flight past the asset being exported. Paths that aren't
+	// packages or are in memory already need no load; the export resolves (or fails to resolve) them itself.
+	void StartBatchExportLoads(FUMCP_BatchExportState& State, FUMCP_PackageLoader& Loader)
+	{
+		const int32 LoadEnd = FMath::Min(State.NextExportIndex + Loader.GetMaxConcurrentLoads(), State.Entries.Num());
+		for (; State.NextLoadIndex < LoadEnd; ++State.NextLoadIndex)
+		{
+			FUMCP_BatchExportEntry& Entry = State.Entries[State.NextLoadIndex];
+			if (!Loader.TryStartLoad(Entry.ObjectPath, Entry.LoadRequestId))
+			{
+				// The window is shared with other jobs; the rest is requested once some of their loads completed
+				return;
+			}
+		}
+	}
+
+	// Moves finished file writes into their entries. When bBlock is set, first waits until at most MaxPendingWrites remain.
+	void DrainBatchExportWrites(FUMCP_BatchExportState& State, bool bBlock, int32 MaxPendingWrites)
+	{
+		for (;;)
+		{
+			TArray<TPair<int32, bool>> CompletedWrites;
+			{
+				FScopeLock Lock(&State.CompletedWritesLock);
+				CompletedWrites = MoveTemp(State.CompletedWrites);
+			}
+			for (const TPair<int32, bool>& CompletedWrite : CompletedWrites)
+			{
+				FUMCP_BatchExportEntry& Entry = State.Entries[CompletedWrite.Key];
+				--State.NumPendingWrites;
+				const FString& FilePath = State.bNdjson ? State.NdjsonFilePath : Entry.FilePath;
+				if (!CompletedWrite.Value)
+				{
+					Entry.State = EUMCP_BatchExportEntryState::Failed;
+					UE_LOG(LogUnrealMCPServer, Warning, TEXT("BatchExportAssets: Failed to write file: %s for Object: %s"), *FilePath, *Entry.ObjectPath);
+					continue;
+				}
+
+				Entry.State = EUMCP_BatchExportEntryState::Exported;
+				UE_LOG(LogUnrealMCPServer, Log, TEXT("BatchExportAssets: Successfully exported Object '%s' to file: %s"), *Entry.ObjectPath, *FilePath);
+
+				// Clients streaming the call can pick up each file (or, in ndjson mode, each record) as soon as it is written
+				if (FUMCP_ToolProgress::IsActive())
+				{
+					FUMCP_CallToolResultContent ExportedFile;
+					ExportedFile.type = TEXT("text");
+					ExportedFile.text = State.bNdjson ? Entry.ObjectPath : Entry.FilePath;
+					FUMCP_ToolProgress::EmitPartialContent(ExportedFile);
+				}
+			}
+			if (!bBlock || State.NumPendingWrites <= MaxPendingWrites)
+			{
+				return;
+			}
+			FPlatformProcess::Sleep(0.001f);
+		}
+	}
+
+	// Saves every package with one UPackage::SaveConcurrent call. The engine still marks that path experimental, so
+	// packages it didn't save are retried with the regular UPackage::SavePackage.
+	void SaveImportedPackages(TArray<FPackageSaveInfo>& SaveInfos, TArray<bool>& OutSaved)
+	{
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		SaveArgs.SaveFlags = SAVE_NoError;
+		SaveArgs.Error = GWarn;
+
+		TArray<FSavePackageResultStruct> Results;
+		{
+			UMCP_TRACE_SCOPE(UMCP_SavePackagesConcurrent);
+			UPackage::SaveConcurrent(SaveInfos, SaveArgs, Results);
+		}
+		OutSaved.SetNumZeroed(SaveInfos.Num());
+		for (int32 Index = 0; Index < SaveInfos.Num(); ++Index)
+		{
+			const FPackageSaveInfo& SaveInfo = SaveInfos[Index];
+			OutSaved[Index] = Results.IsValidIndex(Index) && Results[Index].Result == ESavePackageResult::Success;
+			if (!OutSaved[Index])
+			{
+				UMCP_TRACE_SCOPE(UMCP_SavePackage);
+				OutSaved[Index] = UPackage::SavePackage(SaveInfo.Package, SaveInfo.Asset, *SaveInfo.Filename, SaveArgs);
+			}
+			if (OutSaved[Index])
+			{
+				SaveInfo.Package->SetDirtyFlag(false);
+			}
+		}
+	}
+
+	// Looks up every path of a batch with one AssetRegistry query instead of one GetAssetByObjectPath per path.
+	// OutAssets[i] is invalid if AssetPaths[i] doesn't exist.
+	void ResolveBatchAssetPaths(IAssetRegistry& AssetRegistry, const TArray<FString>& AssetPaths, TArray<FAssetData>& OutAssets)
+	{
+		OutAssets.Reset();
+		OutAssets.SetNum(AssetPaths.Num());
+
+		FARFilter Filter;
+		TMap<FSoftObjectPath, TArray<int32, TInlineAllocator<1>>> RowsByObjectPath;
+		for (int32 Row = 0; Row < AssetPaths.Num(); ++Row)
+		{
+			const FSoftObjectPath ObjectPath(AssetPaths[Row]);
+			if (ObjectPath.IsValid())
+			{
+				TArray<int32, TInlineAllocator<1>>& Rows = RowsByObjectPath.FindOrAdd(ObjectPath);
+				if (Rows.Num() == 0)
+				{
+					Filter.SoftObjectPaths.Add(ObjectPath);
+				}
+				Rows.Add(Row);
+			}
+		}
+		if (Filter.SoftObjectPaths.Num() == 0)
+		{
+			// An empty filter would match every asset
+			return;
+		}
+
+		TArray<FAssetData> FoundAssets;
+		{
+			UMCP_TRACE_SCOPE(UMCP_AssetRegistryGetAssets);
+			AssetRegistry.GetAssets(Filter, FoundAssets);
+		}
+		for (const FAssetData& AssetData : FoundAssets)
+		{
+			if (const TArray<int32, TInlineAllocator<1>>* Rows = RowsByObjectPath.Find(AssetData.GetSoftObjectPath()))
+			{
+				for (int32 Row : *Rows)
+				{
+					OutAssets[Row] = AssetData;
+				}
+			}
+		}
+
+		// GetAssetByObjectPath also resolves paths the filter doesn't match literally, so misses get the same answer
+		// query_asset would give them
+		for (int32 Row = 0; Row < AssetPaths.Num(); ++Row)
+		{
+			if (!OutAssets[Row].IsValid() && RowsByObjectPath.Contains(FSoftObjectPath(AssetPaths[Row])))
+			{
+				OutAssets[Row] = AssetRegistry.GetAssetByObjectPath(FSoftObjectPath(AssetPaths[Row]));
+			}
+		}
+	}
+
+	// Fills the columnar result of batch_get_asset_dependencies (bReferences false) or batch_get_asset_references.
+	// Each linked package is turned into an asset path once for the whole batch, with one AssetRegistry query.
+	void FillBatchAssetLinks(IAssetRegistry& AssetRegistry, const TArray<FString>& AssetPaths, bool bReferences, bool bIncludeHard, bool bIncludeSoft, FUMCP_BatchAssetLinksResult& OutResult)
+	{
+		TArray<FAssetData> Assets;
+		ResolveBatchAssetPaths(AssetRegistry, AssetPaths, Assets);
+
+		OutResult.assetPaths = AssetPaths;
+		OutResult.exists.SetNumZeroed(AssetPaths.Num());
+		OutResult.offsets.Reset(AssetPaths.Num() + 1);
+		OutResult.offsets.Add(0);
+
+		UE::AssetRegistry::EDependencyQuery DependencyQueryEnum = UE::AssetRegistry::EDependencyQuery::NoRequirements;
+		if (bIncludeHard)
+		{
+			DependencyQueryEnum |= UE::AssetRegistry::EDependencyQuery::Hard;
+		}
+		if (bIncludeSoft)
+		{
+			DependencyQueryEnum |= UE::AssetRegistry::EDependencyQuery::Soft;
+		}
+		const UE::AssetRegistry::FDependencyQuery DependencyQuery(DependencyQueryEnum);
+
+		// indices first point into LinkedPackages, which maps one to one onto paths
+		TArray<FName> LinkedPackages;
+		TMap<FName, int32> LinkedPackageIndices;
+		TArray<FAssetIdentifier> Links;
+		for (int32 Row = 0; Row < Assets.Num(); ++Row)
+		{
+			const FAssetData& AssetData = Assets[Row];
+			OutResult.exists[Row] = AssetData.IsValid();
+			if (AssetData.IsValid() && (bIncludeHard || bIncludeSoft))
+			{
+				Links.Reset();
+				if (bReferences)
+				{
+					UMCP_TRACE_SCOPE(UMCP_AssetRegistryGetReferencers);
+					AssetRegistry.GetReferencers(FAssetIdentifier(AssetData.PackageName), Links, UE::AssetRegistry::EDependencyCategory::Package, DependencyQuery);
+				}
+				else
+				{
+					UMCP_TRACE_SCOPE(UMCP_AssetRegistryGetDependencies);
+					AssetRegistry.GetDependencies(FAssetIdentifier(AssetData.PackageName), Links, UE::AssetRegistry::EDependencyCategory::Package, DependencyQuery);
+				}
+				for (const FAssetIdentifier& Link : Links)
+				{
+					int32& LinkedPackageIndex = LinkedPackageIndices.FindOrAdd(Link.PackageName, INDEX_NONE);
+					if (LinkedPackageIndex == INDEX_NONE)
+					{
+						LinkedPackageIndex = LinkedPackages.Add(Link.PackageName);
+					}
+					OutResult.indices.Add(LinkedPackageIndex);
+				}
+			}
+			OutResult.offsets.Add(OutResult.indices.Num());
+		}
+		OutResult.count = OutResult.indices.Num();
+
+		// Like the single-asset tools, a package is listed by its first asset, or by its name if it has none
+		OutResult.paths.SetNum(LinkedPackages.Num());
+		if (LinkedPackages.Num() > 0)
+		{
+			FARFilter Filter;
+			Filter.PackageNames = LinkedPackages;
+			TArray<FAssetData> LinkedAssets;
+			{
+				UMCP_TRACE_SCOPE(UMCP_AssetRegistryGetAssets);
+				AssetRegistry.GetAssets(Filter, LinkedAssets);
+			}
+			for (const FAssetData& LinkedAsset : LinkedAssets)
+			{
+				const int32* LinkedPackageIndex = LinkedPackageIndices.Find(LinkedAsset.PackageName);
+				if (LinkedPackageIndex && OutResult.paths[*LinkedPackageIndex].IsEmpty())
+				{
+					OutResult.paths[*LinkedPackageIndex] = LinkedAsset.GetSoftObjectPath().ToString();
+				}
+			}
+		}
+		for (int32 LinkedPackageIndex = 0; LinkedPackageIndex < LinkedPackages.Num(); ++LinkedPackageIndex)
+		{
+			if (OutResult.paths[LinkedPackageIndex].IsEmpty())
+			{
+				OutResult.paths[LinkedPackageIndex] = LinkedPackages[LinkedPackageIndex].ToString();
+			}
+		}
+	}
 }
 
 
-void FUMCP_AssetTools::Register(class FUMCP_Server* Server)
+void FUMCP_AssetTools::Register(class FUMCP_Server* InServer)
 {
+	Server = InServer;
 	{
 		FUMCP_ToolDefinition Tool;
 		Tool.name = TEXT("export_asset");
@@ -139,7 +572,7 @@ void FUMCP_AssetTools::Register(class FUMCP_Server* Server)
 		InputDescriptions.Add(TEXT("format"), FormatDescription);
 		TArray<FString> InputRequired;
 		InputRequired.Add(TEXT("objectPath"));
-		Tool.inputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_ExportAssetParams>(InputDescriptions, InputRequired);
+		Tool.InputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_ExportAssetParams>(InputDescriptions, InputRequired);
 		
 		// Generate output schema from USTRUCT with descriptions
 		TMap<FString, FString> OutputDescriptions;
@@ -157,15 +590,7 @@ void FUMCP_AssetTools::Register(class FUMCP_Server* Server)
 		TArray<FString> OutputRequired;
 		OutputRequired.Add(TEXT("bSuccess"));
 		OutputRequired.Add(TEXT("objectPath"));
-		TSharedPtr<FJsonObject> ExportOutputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_ExportAssetResult>(OutputDescriptions, OutputRequired);
-		if (ExportOutputSchema.IsValid())
-		{
-			Tool.outputSchema = ExportOutputSchema;
-		}
-		else
-		{
-			UE_LOG(LogUnrealMCPServer, Error, TEXT("Failed to generate outputSchema for export_asset tool"));
-		}
+		Tool.OutputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_ExportAssetResult>(OutputDescriptions, OutputRequired);
 		Server->RegisterTool(MoveTemp(Tool));
 	}
 	
@@ -178,10 +603,11 @@ void FUMCP_AssetTools::Register(class FUMCP_Server* Server)
 		bool bBP2AIAvailable = BP2AIPlugin.IsValid() && BP2AIPlugin->IsEnabled();
 		
 		// Build description based on plugin availability
-		FString Description = TEXT("Export multiple assets to files in a specified folder. Returns a list of the exported file paths. Required for Blueprint assets, as export_asset will fail for Blueprints due to response size limitations. Use this when exporting multiple assets of any type. Files are saved to disk at the specified output folder path. Format defaults to T3D. Each asset is exported to a separate file named after the asset. Returns array of successfully exported file paths. Failed exports are not included in the return value. ");
+		FString Description = TEXT("Export multiple assets to files in a specified folder. Returns a list of the exported file paths. Required for Blueprint assets, as export_asset will fail for Blueprints due to response size limitations. Use this when exporting multiple assets of any type. Files are saved to disk at the specified output folder path. Format defaults to T3D. Each asset is exported to a separate file named after the asset. Returns array of successfully exported file paths. Failed exports are not included in the return value. With outputMode 'ndjson' all assets go into one NDJSON file with a byte offset index instead, which is much faster for thousands of assets. ");
 		Description += TEXT("NOTE: For Blueprint graph inspection, use export_blueprint_markdown instead, which is specifically designed for that purpose and provides clearer workflow guidance.");
 		Tool.description = Description;
-		Tool.DoToolCall.BindRaw(this, &FUMCP_AssetTools::BatchExportAssets);
+		Tool.StartJob.BindRaw(this, &FUMCP_AssetTools::StartBatchExportAssets);
+		Tool.Priority = EUMCP_RequestPriority::Low;
 		
 		// Generate input schema from USTRUCT with descriptions
 		TMap<FString, FString> InputDescriptions;
@@ -194,32 +620,30 @@ void FUMCP_AssetTools::Register(class FUMCP_Server* Server)
 		}
 		FormatDescription += TEXT("Format must be supported by the exporter for each asset type. NOTE: For Blueprint markdown export, use export_blueprint_markdown instead.");
 		InputDescriptions.Add(TEXT("format"), FormatDescription);
+		InputDescriptions.Add(TEXT("outputMode"), TEXT("'files' (default) writes one file per asset. 'ndjson' streams every export into a single file in outputFolder, one {\"objectPath\", \"format\", \"text\"} JSON record per line, plus an index file with one {\"objectPath\", \"offset\", \"length\"} line per record (byte offset and length in the NDJSON file) so a single asset can be read without parsing the rest. Use 'ndjson' for large batches; exportedPaths is left empty and outputFile/indexFile are returned instead."));
+		InputDescriptions.Add(TEXT("outputFileName"), TEXT("Name of the NDJSON file in outputFolder for outputMode 'ndjson'. Defaults to 'export.ndjson'; the index is written next to it as '<name>.index.ndjson'. Existing files are never overwritten: a number is appended instead (e.g. 'export_1.ndjson')."));
 		TArray<FString> InputRequired;
 		InputRequired.Add(TEXT("objectPaths"));
 		InputRequired.Add(TEXT("outputFolder"));
-		Tool.inputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_BatchExportAssetsParams>(InputDescriptions, InputRequired);
+		TMap<FString, TArray<FString>> InputEnums;
+		InputEnums.Add(TEXT("outputMode"), { TEXT("files"), TEXT("ndjson") });
+		Tool.InputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_BatchExportAssetsParams>(InputDescriptions, InputRequired, InputEnums);
 		
 		// Generate output schema from USTRUCT with descriptions
 		TMap<FString, FString> OutputDescriptions;
 		OutputDescriptions.Add(TEXT("bSuccess"), TEXT("Whether the batch export operation was successful overall"));
 		OutputDescriptions.Add(TEXT("exportedCount"), TEXT("Number of assets successfully exported"));
 		OutputDescriptions.Add(TEXT("failedCount"), TEXT("Number of assets that failed to export"));
-		OutputDescriptions.Add(TEXT("exportedPaths"), TEXT("Array of file paths for successfully exported assets"));
+		OutputDescriptions.Add(TEXT("exportedPaths"), TEXT("Array of file paths for successfully exported assets (outputMode 'files' only)"));
 		OutputDescriptions.Add(TEXT("failedPaths"), TEXT("Array of object paths that failed to export"));
+		OutputDescriptions.Add(TEXT("outputFile"), TEXT("The NDJSON file holding every exported asset (outputMode 'ndjson' only)"));
+		OutputDescriptions.Add(TEXT("indexFile"), TEXT("The index of outputFile: one {objectPath, offset, length} line per record (outputMode 'ndjson' only)"));
 		OutputDescriptions.Add(TEXT("error"), TEXT("Error message if bSuccess is false"));
 		TArray<FString> OutputRequired;
 		OutputRequired.Add(TEXT("bSuccess"));
 		OutputRequired.Add(TEXT("exportedCount"));
 		OutputRequired.Add(TEXT("failedCount"));
-		TSharedPtr<FJsonObject> BatchExportOutputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_BatchExportAssetsResult>(OutputDescriptions, OutputRequired);
-		if (BatchExportOutputSchema.IsValid())
-		{
-			Tool.outputSchema = BatchExportOutputSchema;
-		}
-		else
-		{
-			UE_LOG(LogUnrealMCPServer, Error, TEXT("Failed to generate outputSchema for batch_export_assets tool"));
-		}
+		Tool.OutputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_BatchExportAssetsResult>(OutputDescriptions, OutputRequired);
 		Server->RegisterTool(MoveTemp(Tool));
 	}
 	
@@ -235,7 +659,7 @@ void FUMCP_AssetTools::Register(class FUMCP_Server* Server)
 		InputDescriptions.Add(TEXT("format"), TEXT("The export format. Defaults to 'T3D' if not specified. 'T3D' provides human-readable text showing all default property values. Other formats may be available depending on the class type."));
 		TArray<FString> InputRequired;
 		InputRequired.Add(TEXT("classPath"));
-		Tool.inputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_ExportClassDefaultParams>(InputDescriptions, InputRequired);
+		Tool.InputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_ExportClassDefaultParams>(InputDescriptions, InputRequired);
 		
 		// Generate output schema from USTRUCT with descriptions
 		TMap<FString, FString> OutputDescriptions;
@@ -247,15 +671,7 @@ void FUMCP_AssetTools::Register(class FUMCP_Server* Server)
 		TArray<FString> OutputRequired;
 		OutputRequired.Add(TEXT("bSuccess"));
 		OutputRequired.Add(TEXT("classPath"));
-		TSharedPtr<FJsonObject> ExportClassDefaultOutputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_ExportClassDefaultResult>(OutputDescriptions, OutputRequired);
-		if (ExportClassDefaultOutputSchema.IsValid())
-		{
-			Tool.outputSchema = ExportClassDefaultOutputSchema;
-		}
-		else
-		{
-			UE_LOG(LogUnrealMCPServer, Error, TEXT("Failed to generate outputSchema for export_class_default tool"));
-		}
+		Tool.OutputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_ExportClassDefaultResult>(OutputDescriptions, OutputRequired);
 		Server->RegisterTool(MoveTemp(Tool));
 	}
 	
@@ -263,7 +679,8 @@ void FUMCP_AssetTools::Register(class FUMCP_Server* Server)
 		FUMCP_ToolDefinition Tool;
 		Tool.name = TEXT("import_asset");
 		Tool.description = TEXT("Import a file to create or update a UObject. The file type is automatically detected based on available factories. Import binary files (textures, meshes, sounds) or T3D files to create/update Unreal assets. Supported binary formats: .fbx, .obj (meshes), .png, .jpg, .tga (textures), .wav, .mp3 (sounds). T3D files can be used to import from T3D format or to configure imported objects. If asset exists at packagePath, it will be updated. Otherwise, a new asset is created. At least one of filePath (binary) or t3dFilePath (T3D) must be provided.");
-		Tool.DoToolCall.BindRaw(this, &FUMCP_AssetTools::ImportAsset);
+		Tool.StartJob.BindRaw(this, &FUMCP_AssetTools::StartImportAsset);
+		Tool.Priority = EUMCP_RequestPriority::Low;
 		
 		// Generate input schema from USTRUCT with descriptions
 		TMap<FString, FString> InputDescriptions;
@@ -274,7 +691,7 @@ void FUMCP_AssetTools::Register(class FUMCP_Server* Server)
 		TArray<FString> InputRequired;
 		InputRequired.Add(TEXT("packagePath"));
 		InputRequired.Add(TEXT("classPath"));
-		Tool.inputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_ImportAssetParams>(InputDescriptions, InputRequired);
+		Tool.InputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_ImportAssetParams>(InputDescriptions, InputRequired);
 		
 		// Generate output schema from USTRUCT with descriptions
 		TMap<FString, FString> OutputDescriptions;
@@ -287,15 +704,40 @@ void FUMCP_AssetTools::Register(class FUMCP_Server* Server)
 		OutputDescriptions.Add(TEXT("error"), TEXT("Error message if bSuccess is false"));
 		TArray<FString> OutputRequired;
 		OutputRequired.Add(TEXT("bSuccess"));
-		TSharedPtr<FJsonObject> ImportOutputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_ImportAssetResult>(OutputDescriptions, OutputRequired);
-		if (ImportOutputSchema.IsValid())
-		{
-			Tool.outputSchema = ImportOutputSchema;
-		}
-		else
-		{
-			UE_LOG(LogUnrealMCPServer, Error, TEXT("Failed to generate outputSchema for import_asset tool"));
-		}
+		Tool.OutputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_ImportAssetResult>(OutputDescriptions, OutputRequired);
+		Server->RegisterTool(MoveTemp(Tool));
+	}
+
+	{
+		FUMCP_ToolDefinition Tool;
+		Tool.name = TEXT("batch_import_assets");
+		Tool.description = TEXT("Import many files in one call, each with the arguments of import_asset (filePath and/or t3dFilePath, packagePath, classPath). All imports form one undo transaction. T3D property changes notify the editor (PostEditChange) once per asset after the last import instead of once per property, new assets are announced to the asset registry at the end, and the modified packages are saved together in one pass. Returns a result per asset in request order. Use this instead of repeated import_asset calls when changing many assets; run it with runAsJob for large batches.");
+		Tool.StartJob.BindRaw(this, &FUMCP_AssetTools::StartBatchImportAssets);
+		Tool.Priority = EUMCP_RequestPriority::Low;
+
+		// Generate input schema from USTRUCT with descriptions
+		TMap<FString, FString> InputDescriptions;
+		InputDescriptions.Add(TEXT("assets"), TEXT("The imports to run, in order. Each is an object with the arguments of import_asset: 'packagePath' (full object path, e.g. '/Game/Data/DA_Item.DA_Item'), 'classPath' (e.g. '/Script/Engine.DataAsset'), and 'filePath' (binary file) and/or 't3dFilePath' (T3D file). The same path may appear more than once; later entries apply on top of earlier ones."));
+		InputDescriptions.Add(TEXT("bSave"), TEXT("Save the packages of the imported assets once every import is done. Defaults to true. Packages whose file is read-only (e.g. not checked out) are reported as not saved."));
+		TArray<FString> InputRequired;
+		InputRequired.Add(TEXT("assets"));
+		Tool.InputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_BatchImportAssetsParams>(InputDescriptions, InputRequired);
+
+		// Generate output schema from USTRUCT with descriptions
+		TMap<FString, FString> OutputDescriptions;
+		OutputDescriptions.Add(TEXT("bSuccess"), TEXT("Whether at least one asset was imported; check results for each asset"));
+		OutputDescriptions.Add(TEXT("importedCount"), TEXT("Number of assets imported"));
+		OutputDescriptions.Add(TEXT("failedCount"), TEXT("Number of assets that failed to import"));
+		OutputDescriptions.Add(TEXT("savedCount"), TEXT("Number of imported assets whose package was saved"));
+		OutputDescriptions.Add(TEXT("skippedCount"), TEXT("Number of assets not attempted because the job was cancelled before the batch started"));
+		OutputDescriptions.Add(TEXT("results"), TEXT("One entry per requested asset in request order: packagePath, bSuccess, bSaved, importedObject and error"));
+		OutputDescriptions.Add(TEXT("error"), TEXT("Summary of failures, empty if every asset was imported and saved"));
+		TArray<FString> OutputRequired;
+		OutputRequired.Add(TEXT("bSuccess"));
+		OutputRequired.Add(TEXT("importedCount"));
+		OutputRequired.Add(TEXT("failedCount"));
+		OutputRequired.Add(TEXT("results"));
+		Tool.OutputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_BatchImportAssetsResult>(OutputDescriptions, OutputRequired);
 		Server->RegisterTool(MoveTemp(Tool));
 	}
 	
@@ -304,6 +746,7 @@ void FUMCP_AssetTools::Register(class FUMCP_Server* Server)
 		Tool.name = TEXT("query_asset");
 		Tool.description = TEXT("Query a single asset to check if it exists and get its basic information from the asset registry. Use this before export_asset or import_asset to verify an asset exists. Faster than export_asset for simple existence checks. Returns asset path, name, class, package path, and optionally tags. Returns error if asset doesn't exist.");
 		Tool.DoToolCall.BindRaw(this, &FUMCP_AssetTools::QueryAsset);
+		Tool.ExecutionAffinity = EUMCP_ExecutionAffinity::TaskGraph;
 		
 		// Generate input schema from USTRUCT with descriptions
 		TMap<FString, FString> InputDescriptions;
@@ -311,7 +754,7 @@ void FUMCP_AssetTools::Register(class FUMCP_Server* Server)
 		InputDescriptions.Add(TEXT("bIncludeTags"), TEXT("Whether to include asset tags in the response. Defaults to false. Set to true to get additional metadata tags associated with the asset (e.g., 'ParentClass' for Blueprints, 'TextureGroup' for textures)."));
 		TArray<FString> InputRequired;
 		InputRequired.Add(TEXT("assetPath"));
-		Tool.inputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_QueryAssetParams>(InputDescriptions, InputRequired);
+		Tool.InputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_QueryAssetParams>(InputDescriptions, InputRequired);
 		
 		// Generate output schema from USTRUCT with descriptions
 		TMap<FString, FString> OutputDescriptions;
@@ -325,23 +768,16 @@ void FUMCP_AssetTools::Register(class FUMCP_Server* Server)
 		TArray<FString> OutputRequired;
 		OutputRequired.Add(TEXT("bExists"));
 		OutputRequired.Add(TEXT("assetPath"));
-		TSharedPtr<FJsonObject> QueryOutputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_QueryAssetResult>(OutputDescriptions, OutputRequired);
-		if (QueryOutputSchema.IsValid())
-		{
-			Tool.outputSchema = QueryOutputSchema;
-		}
-		else
-		{
-			UE_LOG(LogUnrealMCPServer, Error, TEXT("Failed to generate outputSchema for query_asset tool"));
-		}
+		Tool.OutputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_QueryAssetResult>(OutputDescriptions, OutputRequired);
 		Server->RegisterTool(MoveTemp(Tool));
 	}
 	
 	{
 		FUMCP_ToolDefinition Tool;
 		Tool.name = TEXT("search_assets");
-		Tool.description = TEXT("Search for assets by package paths or package names, optionally filtered by class. Returns an array of asset information from the asset registry. More flexible than search_blueprints as it works with all asset types. REQUIRED: At least one of 'packagePaths' or 'packageNames' must be provided (non-empty array). Use packagePaths to search directories (e.g., '/Game/Blueprints' searches all assets in that folder), packageNames for exact or partial package matches (supports wildcards * and ?, or substring matching), and classPaths to filter by asset type (e.g., textures only). Returns array of asset information. Use bIncludeTags=true to get additional metadata tags. Use maxResults and offset for paging through large result sets. For large searches, use maxResults to limit results and offset for paging.");
+		Tool.description = TEXT("Search for assets by package paths or package names, optionally filtered by class. Returns an array of asset information from the asset registry. More flexible than search_blueprints as it works with all asset types. REQUIRED: At least one of 'packagePaths' or 'packageNames' must be provided (non-empty array). Use packagePaths to search directories (e.g., '/Game/Blueprints' searches all assets in that folder), packageNames for exact or partial package matches (supports wildcards * and ?, or substring matching), and classPaths to filter by asset type (e.g., textures only). Returns array of asset information. Use bIncludeTags=true to get additional metadata tags. Use maxResults and offset for paging through large result sets. For large searches, use maxResults to limit results and pass each page's nextCursor as cursor to get the next page.");
 		Tool.DoToolCall.BindRaw(this, &FUMCP_AssetTools::SearchAssets);
+		Tool.ExecutionAffinity = EUMCP_ExecutionAffinity::TaskGraph;
 		
 		// Generate input schema from USTRUCT with descriptions
 		TMap<FString, FString> InputDescriptions;
@@ -351,10 +787,12 @@ void FUMCP_AssetTools::Register(class FUMCP_Server* Server)
 		InputDescriptions.Add(TEXT("bRecursive"), TEXT("Whether to search recursively in subdirectories. Defaults to true. Set to false to search only the specified packagePaths directories without subdirectories."));
 		InputDescriptions.Add(TEXT("bIncludeTags"), TEXT("Whether to include asset tags in the response. Defaults to false. Set to true to get additional metadata tags for each asset (e.g., 'ParentClass' for Blueprints, 'TextureGroup' for textures, 'AssetImportData' for imported assets)."));
 		InputDescriptions.Add(TEXT("maxResults"), TEXT("Maximum number of results to return. Defaults to 0 (no limit). Use with offset for paging through large result sets. Recommended for large searches to limit response size."));
-		InputDescriptions.Add(TEXT("offset"), TEXT("Number of results to skip before returning results. Defaults to 0. Use with maxResults for paging: first page uses offset=0, second page uses offset=maxResults, etc."));
-		TArray<FString> InputRequired;
-		// packagePaths is required only if packageNames is empty
-		Tool.inputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_SearchAssetsParams>(InputDescriptions, InputRequired);
+		InputDescriptions.Add(TEXT("offset"), TEXT("Number of results to skip before returning results. Defaults to 0. Use with maxResults for paging: first page uses offset=0, second page uses offset=maxResults, etc. Prefer cursor for paging through large result sets."));
+		InputDescriptions.Add(TEXT("cursor"), TEXT("The nextCursor returned by the previous page. Pages through a server-side snapshot of the first page's results, so later pages are cheap; the search filters and offset are ignored when it is set, maxResults and bIncludeTags still apply. Cursors expire when unused for a while or when the asset registry changes; run the search again without a cursor then."));
+		// packagePaths is required only if packageNames is empty, which the tool checks itself. Listing the fields keeps the
+		// paging fields and cursor optional; an empty list would mark every property required.
+		TArray<FString> InputRequired = { TEXT("packagePaths"), TEXT("packageNames"), TEXT("classPaths"), TEXT("bRecursive"), TEXT("bIncludeTags") };
+		Tool.InputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_SearchAssetsParams>(InputDescriptions, InputRequired);
 		
 		// Output schema has complex nested asset objects, so we'll keep it as manual JSON for now
 		// TODO: Could create USTRUCT for output and generate schema
@@ -370,19 +808,15 @@ void FUMCP_AssetTools::Register(class FUMCP_Server* Server)
 			TEXT("\"objectPath\":{\"type\":\"string\"},")
 			TEXT("\"tags\":{\"type\":\"object\",\"additionalProperties\":{\"type\":\"string\"}}")
 			TEXT("}}},")
-			TEXT("\"count\":{\"type\":\"number\",\"description\":\"Total number of assets found\"}")
+			TEXT("\"count\":{\"type\":\"number\",\"description\":\"Number of assets in this page\"},")
+			TEXT("\"totalCount\":{\"type\":\"number\",\"description\":\"Total number of assets found\"},")
+			TEXT("\"offset\":{\"type\":\"number\",\"description\":\"Offset of this page\"},")
+			TEXT("\"hasMore\":{\"type\":\"boolean\",\"description\":\"Whether there are more results available\"},")
+			TEXT("\"nextCursor\":{\"type\":\"string\",\"description\":\"Pass as cursor to get the next page; absent on the last page\"}")
 			TEXT("},")
 			TEXT("\"required\":[\"assets\",\"count\"]")
 			TEXT("}");
-		TSharedPtr<FJsonObject> ParsedSchema = UMCP_FromJsonStr(SearchAssetsOutputSchema);
-		if (ParsedSchema.IsValid())
-		{
-			Tool.outputSchema = ParsedSchema;
-		}
-		else
-		{
-			UE_LOG(LogUnrealMCPServer, Error, TEXT("Failed to parse outputSchema for search_assets tool"));
-		}
+		Tool.OutputSchemaBuilder = [SearchAssetsOutputSchema]() { return UMCP_FromJsonStr(SearchAssetsOutputSchema); };
 		Server->RegisterTool(MoveTemp(Tool));
 	}
 	
@@ -391,6 +825,7 @@ void FUMCP_AssetTools::Register(class FUMCP_Server* Server)
 		Tool.name = TEXT("get_asset_dependencies");
 		Tool.description = TEXT("Get all assets that a specified asset depends on. Returns an array of asset paths that the specified asset depends on. Use this to understand what assets an asset requires, which is useful for impact analysis, refactoring safety, and understanding asset relationships. Very useful when doing asset searches and queries with existing tools. Supports both hard dependencies (direct references) and soft dependencies (searchable references).");
 		Tool.DoToolCall.BindRaw(this, &FUMCP_AssetTools::GetAssetDependencies);
+		Tool.ExecutionAffinity = EUMCP_ExecutionAffinity::TaskGraph;
 		
 		// Generate input schema from USTRUCT with descriptions
 		TMap<FString, FString> InputDescriptions;
@@ -399,7 +834,7 @@ void FUMCP_AssetTools::Register(class FUMCP_Server* Server)
 		InputDescriptions.Add(TEXT("bIncludeSoftDependencies"), TEXT("Whether to include soft dependencies (searchable references). Defaults to false. Soft dependencies are assets that are referenced via searchable references (e.g., string-based asset references)."));
 		TArray<FString> InputRequired;
 		InputRequired.Add(TEXT("assetPath"));
-		Tool.inputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_GetAssetDependenciesParams>(InputDescriptions, InputRequired);
+		Tool.InputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_GetAssetDependenciesParams>(InputDescriptions, InputRequired);
 		
 		// Generate output schema from USTRUCT with descriptions
 		TMap<FString, FString> OutputDescriptions;
@@ -413,15 +848,7 @@ void FUMCP_AssetTools::Register(class FUMCP_Server* Server)
 		OutputRequired.Add(TEXT("assetPath"));
 		OutputRequired.Add(TEXT("dependencies"));
 		OutputRequired.Add(TEXT("count"));
-		TSharedPtr<FJsonObject> GetAssetDependenciesOutputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_GetAssetDependenciesResult>(OutputDescriptions, OutputRequired);
-		if (GetAssetDependenciesOutputSchema.IsValid())
-		{
-			Tool.outputSchema = GetAssetDependenciesOutputSchema;
-		}
-		else
-		{
-			UE_LOG(LogUnrealMCPServer, Error, TEXT("Failed to generate outputSchema for get_asset_dependencies tool"));
-		}
+		Tool.OutputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_GetAssetDependenciesResult>(OutputDescriptions, OutputRequired);
 		Server->RegisterTool(MoveTemp(Tool));
 	}
 	
@@ -430,6 +857,7 @@ void FUMCP_AssetTools::Register(class FUMCP_Server* Server)
 		Tool.name = TEXT("get_asset_references");
 		Tool.description = TEXT("Get all assets that reference a specified asset. Returns an array of asset paths that reference the specified asset. Use this to understand what assets depend on this asset, which is critical for impact analysis, refactoring safety, and unused asset detection. Very useful when doing asset searches and queries with existing tools. Supports both hard references (direct references) and soft references (searchable references).");
 		Tool.DoToolCall.BindRaw(this, &FUMCP_AssetTools::GetAssetReferences);
+		Tool.ExecutionAffinity = EUMCP_ExecutionAffinity::TaskGraph;
 		
 		// Generate input schema from USTRUCT with descriptions
 		TMap<FString, FString> InputDescriptions;
@@ -438,7 +866,7 @@ void FUMCP_AssetTools::Register(class FUMCP_Server* Server)
 		InputDescriptions.Add(TEXT("bIncludeSoftReferences"), TEXT("Whether to include soft references (searchable references). Defaults to false. Soft references are assets that reference this asset via searchable references (e.g., string-based asset references)."));
 		TArray<FString> InputRequired;
 		InputRequired.Add(TEXT("assetPath"));
-		Tool.inputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_GetAssetReferencesParams>(InputDescriptions, InputRequired);
+		Tool.InputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_GetAssetReferencesParams>(InputDescriptions, InputRequired);
 		
 		// Generate output schema from USTRUCT with descriptions
 		TMap<FString, FString> OutputDescriptions;
@@ -452,23 +880,16 @@ void FUMCP_AssetTools::Register(class FUMCP_Server* Server)
 		OutputRequired.Add(TEXT("assetPath"));
 		OutputRequired.Add(TEXT("references"));
 		OutputRequired.Add(TEXT("count"));
-		TSharedPtr<FJsonObject> GetAssetReferencesOutputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_GetAssetReferencesResult>(OutputDescriptions, OutputRequired);
-		if (GetAssetReferencesOutputSchema.IsValid())
-		{
-			Tool.outputSchema = GetAssetReferencesOutputSchema;
-		}
-		else
-		{
-			UE_LOG(LogUnrealMCPServer, Error, TEXT("Failed to generate outputSchema for get_asset_references tool"));
-		}
+		Tool.OutputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_GetAssetReferencesResult>(OutputDescriptions, OutputRequired);
 		Server->RegisterTool(MoveTemp(Tool));
 	}
 	
 	{
 		FUMCP_ToolDefinition Tool;
 		Tool.name = TEXT("get_asset_dependency_tree");
-		Tool.description = TEXT("Get the complete dependency tree for a specified asset. Returns a recursive tree structure showing all dependencies and their dependencies. Use this for complete dependency mapping and recursive analysis. The tree includes depth information for each node. Very useful when doing asset searches and queries with existing tools. Supports both hard dependencies (direct references) and soft dependencies (searchable references). Use maxDepth to limit recursion depth and prevent infinite loops.");
+		Tool.description = TEXT("Get the complete dependency tree for a specified asset. Returns a recursive tree structure showing all dependencies and their dependencies. Use this for complete dependency mapping and recursive analysis. The tree includes depth information for each node. Very useful when doing asset searches and queries with existing tools. Supports both hard dependencies (direct references) and soft dependencies (searchable references). Use maxDepth to limit recursion depth and prevent infinite loops. For assets with shared dependencies (material and Blueprint libraries), use outputMode 'dag' to get each package once with edges by node index, and maxNodes to bound the result.");
 		Tool.DoToolCall.BindRaw(this, &FUMCP_AssetTools::GetAssetDependencyTree);
+		Tool.ExecutionAffinity = EUMCP_ExecutionAffinity::TaskGraph;
 		
 		// Generate input schema from USTRUCT with descriptions
 		TMap<FString, FString> InputDescriptions;
@@ -476,17 +897,23 @@ void FUMCP_AssetTools::Register(class FUMCP_Server* Server)
 		InputDescriptions.Add(TEXT("maxDepth"), TEXT("Maximum recursion depth to prevent infinite loops. Defaults to 10. Must be at least 1. Increase for deeper dependency trees, but be aware that very deep trees can be expensive to compute."));
 		InputDescriptions.Add(TEXT("bIncludeHardDependencies"), TEXT("Whether to include hard dependencies (direct references). Defaults to true. Hard dependencies are assets that are directly referenced by the asset."));
 		InputDescriptions.Add(TEXT("bIncludeSoftDependencies"), TEXT("Whether to include soft dependencies (searchable references). Defaults to false. Soft dependencies are assets that are referenced via searchable references (e.g., string-based asset references)."));
+		InputDescriptions.Add(TEXT("outputMode"), TEXT("'tree' (default) returns the tree as a flat list of nodes, where a dependency shared by several assets appears once per path that reaches it. 'dag' walks the graph breadth-first and returns each package once in 'nodes', with its shortest depth from the root and its dependencies as indices into 'nodes'; much smaller and faster for heavily shared dependencies."));
+		InputDescriptions.Add(TEXT("maxNodes"), TEXT("Maximum number of nodes to return. Defaults to 0 (no limit). When reached, the traversal stops adding nodes and bTruncated is set; in 'dag' mode nodes whose dependencies are incomplete have bDependenciesOmitted set."));
 		TArray<FString> InputRequired;
 		InputRequired.Add(TEXT("assetPath"));
-		Tool.inputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_GetAssetDependencyTreeParams>(InputDescriptions, InputRequired);
+		TMap<FString, TArray<FString>> InputEnums;
+		InputEnums.Add(TEXT("outputMode"), { TEXT("tree"), TEXT("dag") });
+		Tool.InputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_GetAssetDependencyTreeParams>(InputDescriptions, InputRequired, InputEnums);
 		
 		// Generate output schema from USTRUCT with descriptions
 		TMap<FString, FString> OutputDescriptions;
 		OutputDescriptions.Add(TEXT("bSuccess"), TEXT("Whether the operation completed successfully"));
 		OutputDescriptions.Add(TEXT("assetPath"), TEXT("The asset path that was queried"));
-		OutputDescriptions.Add(TEXT("tree"), TEXT("Array of dependency tree nodes, each containing assetPath, depth, and dependencies"));
+		OutputDescriptions.Add(TEXT("tree"), TEXT("Array of dependency tree nodes, each containing assetPath, depth, and dependencies. Empty in 'dag' mode"));
+		OutputDescriptions.Add(TEXT("nodes"), TEXT("'dag' mode only: unique nodes in breadth-first order with the root first, each containing assetPath, depth (shortest from the root), dependencies (indices into nodes) and bDependenciesOmitted"));
 		OutputDescriptions.Add(TEXT("totalNodes"), TEXT("Total number of nodes in the dependency tree"));
 		OutputDescriptions.Add(TEXT("maxDepthReached"), TEXT("Maximum depth reached in the dependency tree"));
+		OutputDescriptions.Add(TEXT("bTruncated"), TEXT("Whether maxNodes was reached before the traversal finished"));
 		OutputDescriptions.Add(TEXT("error"), TEXT("Error message if bSuccess is false"));
 		TArray<FString> OutputRequired;
 		OutputRequired.Add(TEXT("bSuccess"));
@@ -494,15 +921,121 @@ void FUMCP_AssetTools::Register(class FUMCP_Server* Server)
 		OutputRequired.Add(TEXT("tree"));
 		OutputRequired.Add(TEXT("totalNodes"));
 		OutputRequired.Add(TEXT("maxDepthReached"));
-		TSharedPtr<FJsonObject> GetAssetDependencyTreeOutputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_GetAssetDependencyTreeResult>(OutputDescriptions, OutputRequired);
-		if (GetAssetDependencyTreeOutputSchema.IsValid())
-		{
-			Tool.outputSchema = GetAssetDependencyTreeOutputSchema;
-		}
-		else
-		{
-			UE_LOG(LogUnrealMCPServer, Error, TEXT("Failed to generate outputSchema for get_asset_dependency_tree tool"));
-		}
+		Tool.OutputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_GetAssetDependencyTreeResult>(OutputDescriptions, OutputRequired);
+		Server->RegisterTool(MoveTemp(Tool));
+	}
+	
+	{
+		FUMCP_ToolDefinition Tool;
+		Tool.name = TEXT("batch_query_assets");
+		Tool.description = TEXT("Query many assets at once: the batch form of query_asset. Looks up every path with a single asset registry query and returns one compact, columnar result keyed by input path: row i of every column (exists, assetName, packagePath, classPath, objectPath, tags) describes assetPaths[i]. Missing assets are reported with exists false instead of failing the call. Prefer this over calling query_asset repeatedly.");
+		Tool.DoToolCall.BindRaw(this, &FUMCP_AssetTools::BatchQueryAssets);
+		Tool.ExecutionAffinity = EUMCP_ExecutionAffinity::TaskGraph;
+		
+		// Generate input schema from USTRUCT with descriptions
+		TMap<FString, FString> InputDescriptions;
+		InputDescriptions.Add(TEXT("assetPaths"), TEXT("Array of asset paths to query, in the formats query_asset accepts. Examples: ['/Game/MyAsset', '/Game/Blueprints/BP_Player.BP_Player', '/Engine/EditorMaterials/GridMaterial']. Duplicates are allowed and get their own row."));
+		InputDescriptions.Add(TEXT("bIncludeTags"), TEXT("Whether to include asset tags in the response. Defaults to false. Set to true to fill the tags column with the metadata tags of each asset (e.g., 'ParentClass' for Blueprints, 'TextureGroup' for textures)."));
+		TArray<FString> InputRequired;
+		InputRequired.Add(TEXT("assetPaths"));
+		Tool.InputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_BatchQueryAssetsParams>(InputDescriptions, InputRequired);
+		
+		// Generate output schema from USTRUCT with descriptions
+		TMap<FString, FString> OutputDescriptions;
+		OutputDescriptions.Add(TEXT("assetPaths"), TEXT("The queried asset paths in request order; row i of every other column belongs to assetPaths[i]"));
+		OutputDescriptions.Add(TEXT("exists"), TEXT("Whether each asset exists"));
+		OutputDescriptions.Add(TEXT("assetName"), TEXT("Name of each asset (empty if it doesn't exist)"));
+		OutputDescriptions.Add(TEXT("packagePath"), TEXT("Package path of each asset (empty if it doesn't exist)"));
+		OutputDescriptions.Add(TEXT("classPath"), TEXT("Class path of each asset (empty if it doesn't exist)"));
+		OutputDescriptions.Add(TEXT("objectPath"), TEXT("Full object path of each asset (empty if it doesn't exist)"));
+		OutputDescriptions.Add(TEXT("tags"), TEXT("Asset tags of each asset as {values: {tag: value}} (only if bIncludeTags was true)"));
+		OutputDescriptions.Add(TEXT("count"), TEXT("Number of assets that exist"));
+		TArray<FString> OutputRequired;
+		OutputRequired.Add(TEXT("assetPaths"));
+		OutputRequired.Add(TEXT("exists"));
+		OutputRequired.Add(TEXT("count"));
+		Tool.OutputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_BatchQueryAssetsResult>(OutputDescriptions, OutputRequired);
+		Server->RegisterTool(MoveTemp(Tool));
+	}
+	
+	// batch_get_asset_dependencies and batch_get_asset_references share their output layout
+	TMap<FString, FString> BatchLinksOutputDescriptions;
+	BatchLinksOutputDescriptions.Add(TEXT("assetPaths"), TEXT("The queried asset paths in request order"));
+	BatchLinksOutputDescriptions.Add(TEXT("exists"), TEXT("Whether each queried asset exists; missing assets have no links"));
+	BatchLinksOutputDescriptions.Add(TEXT("offsets"), TEXT("assetPaths.length + 1 offsets into indices: the links of assetPaths[i] are indices[offsets[i]] up to, not including, indices[offsets[i + 1]]"));
+	BatchLinksOutputDescriptions.Add(TEXT("indices"), TEXT("Indices into paths of the linked assets, grouped by queried asset"));
+	BatchLinksOutputDescriptions.Add(TEXT("paths"), TEXT("Each distinct linked asset path once (the package name if the package has no assets)"));
+	BatchLinksOutputDescriptions.Add(TEXT("count"), TEXT("Number of links over all queried assets"));
+	TArray<FString> BatchLinksOutputRequired = { TEXT("assetPaths"), TEXT("exists"), TEXT("offsets"), TEXT("indices"), TEXT("paths"), TEXT("count") };
+	
+	{
+		FUMCP_ToolDefinition Tool;
+		Tool.name = TEXT("batch_get_asset_dependencies");
+		Tool.description = TEXT("Get the dependencies of many assets at once: the batch form of get_asset_dependencies. Resolves every path with a single asset registry query and turns each dependency package into an asset path once for the whole batch. Returns a compact, columnar result keyed by input path: every distinct dependency is listed once in 'paths', and the dependencies of assetPaths[i] are indices[offsets[i]] to indices[offsets[i + 1]] - 1, indices into 'paths'. Missing assets are reported with exists false instead of failing the call.");
+		Tool.DoToolCall.BindRaw(this, &FUMCP_AssetTools::BatchGetAssetDependencies);
+		Tool.ExecutionAffinity = EUMCP_ExecutionAffinity::TaskGraph;
+		
+		// Generate input schema from USTRUCT with descriptions
+		TMap<FString, FString> InputDescriptions;
+		InputDescriptions.Add(TEXT("assetPaths"), TEXT("Array of asset paths to get dependencies for, in the formats get_asset_dependencies accepts. Examples: ['/Game/MyAsset', '/Game/Blueprints/BP_Player']."));
+		InputDescriptions.Add(TEXT("bIncludeHardDependencies"), TEXT("Whether to include hard dependencies (direct references). Defaults to true."));
+		InputDescriptions.Add(TEXT("bIncludeSoftDependencies"), TEXT("Whether to include soft dependencies (searchable references). Defaults to false."));
+		TArray<FString> InputRequired;
+		InputRequired.Add(TEXT("assetPaths"));
+		Tool.InputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_BatchGetAssetDependenciesParams>(InputDescriptions, InputRequired);
+		Tool.OutputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_BatchAssetLinksResult>(BatchLinksOutputDescriptions, BatchLinksOutputRequired);
+		Server->RegisterTool(MoveTemp(Tool));
+	}
+	
+	{
+		FUMCP_ToolDefinition Tool;
+		Tool.name = TEXT("batch_get_asset_references");
+		Tool.description = TEXT("Get the referencers of many assets at once: the batch form of get_asset_references. Resolves every path with a single asset registry query and turns each referencing package into an asset path once for the whole batch. Returns a compact, columnar result keyed by input path: every distinct referencer is listed once in 'paths', and the referencers of assetPaths[i] are indices[offsets[i]] to indices[offsets[i + 1]] - 1, indices into 'paths'. Missing assets are reported with exists false instead of failing the call.");
+		Tool.DoToolCall.BindRaw(this, &FUMCP_AssetTools::BatchGetAssetReferences);
+		Tool.ExecutionAffinity = EUMCP_ExecutionAffinity::TaskGraph;
+		
+		// Generate input schema from USTRUCT with descriptions
+		TMap<FString, FString> InputDescriptions;
+		InputDescriptions.Add(TEXT("assetPaths"), TEXT("Array of asset paths to get references for, in the formats get_asset_references accepts. Examples: ['/Game/MyAsset', '/Game/Blueprints/BP_Player']."));
+		InputDescriptions.Add(TEXT("bIncludeHardReferences"), TEXT("Whether to include hard references (direct references). Defaults to true."));
+		InputDescriptions.Add(TEXT("bIncludeSoftReferences"), TEXT("Whether to include soft references (searchable references). Defaults to false."));
+		TArray<FString> InputRequired;
+		InputRequired.Add(TEXT("assetPaths"));
+		Tool.InputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_BatchGetAssetReferencesParams>(InputDescriptions, InputRequired);
+		Tool.OutputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_BatchAssetLinksResult>(BatchLinksOutputDescriptions, BatchLinksOutputRequired);
+		Server->RegisterTool(MoveTemp(Tool));
+	}
+	
+	{
+		FUMCP_ToolDefinition Tool;
+		Tool.name = TEXT("export_dependency_graph");
+		Tool.description = TEXT("Export the hard and soft package dependency graph of the whole project in one call, for build-impact analysis and cook-size audits. Writes a memory-mappable binary snapshot under the project's Saved/UnrealMCPServer/DependencyGraph folder: an interned table of package names plus compressed sparse row (CSR) adjacency arrays with hard/soft flags per edge. The file layout is documented in the tech spec. The first snapshot is built in the background once the asset registry has loaded; a call made before that build finishes waits for it (seconds on large projects). Returns the file path and the snapshot's generation. Pass that generation back as sinceGeneration to get only the packages whose dependencies changed since, as JSON, instead of a new file. Much faster than calling get_asset_dependencies for every asset.");
+		Tool.DoToolCall.BindRaw(this, &FUMCP_AssetTools::ExportDependencyGraph);
+		Tool.ExecutionAffinity = EUMCP_ExecutionAffinity::TaskGraph;
+		
+		// Generate input schema from USTRUCT with descriptions
+		TMap<FString, FString> InputDescriptions;
+		InputDescriptions.Add(TEXT("sinceGeneration"), TEXT("Generation of a snapshot you already have, or 0 for a full snapshot file. If the server still knows the changes since that generation, returns them as a delta (bDelta true) and writes no file; otherwise (for example after an editor restart) writes a full snapshot as if 0 was passed."));
+		TArray<FString> InputRequired;
+		InputRequired.Add(TEXT("sinceGeneration"));
+		Tool.InputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_ExportDependencyGraphParams>(InputDescriptions, InputRequired);
+		
+		// Generate output schema from USTRUCT with descriptions
+		TMap<FString, FString> OutputDescriptions;
+		OutputDescriptions.Add(TEXT("generation"), TEXT("Generation of the returned snapshot or delta; pass it as sinceGeneration next time"));
+		OutputDescriptions.Add(TEXT("bDelta"), TEXT("Whether the result is a delta since sinceGeneration (changedPackages, removedPackages) rather than a full snapshot file"));
+		OutputDescriptions.Add(TEXT("filePath"), TEXT("Absolute path of the binary snapshot file (full snapshots only)"));
+		OutputDescriptions.Add(TEXT("fileBytes"), TEXT("Size of the snapshot file in bytes (full snapshots only)"));
+		OutputDescriptions.Add(TEXT("packageCount"), TEXT("Number of packages (nodes) in the graph"));
+		OutputDescriptions.Add(TEXT("edgeCount"), TEXT("Number of dependencies (edges) in the graph"));
+		OutputDescriptions.Add(TEXT("changedPackages"), TEXT("Delta only: packages that were added or whose dependencies may have changed, each with packageName, dependencies (package names) and edgeFlags (1 hard, 2 soft, 3 both)"));
+		OutputDescriptions.Add(TEXT("removedPackages"), TEXT("Delta only: packages that no longer have assets. They stay in the graph as long as other packages depend on them"));
+		TArray<FString> OutputRequired;
+		OutputRequired.Add(TEXT("generation"));
+		OutputRequired.Add(TEXT("bDelta"));
+		OutputRequired.Add(TEXT("packageCount"));
+		OutputRequired.Add(TEXT("edgeCount"));
+		Tool.OutputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_ExportDependencyGraphResult>(OutputDescriptions, OutputRequired);
 		Server->RegisterTool(MoveTemp(Tool));
 	}
 }
@@ -518,38 +1051,49 @@ bool FUMCP_AssetTools::ExportAssetToText(const FString& ObjectPath, const FStrin
 		return false;
 	}
 
-	// Load the object
-	UObject* Object = LoadObject<UObject>(nullptr, *ObjectPath);
-	if (!Object)
+	// Exports are cached per package revision, so a hit skips both the load and the export
+	const bool bExported = Server->GetExportCache().GetOrExport(ObjectPath, Format, [this, &ObjectPath, &Format](FString& OutText, FString& OutExportError)
 	{
-		OutError = FString::Printf(TEXT("Failed to load Object: %s"), *ObjectPath);
-		return false;
-	}
+		// Load the object
+		UObject* Object = Server->GetPackageLoader().LoadObject(ObjectPath);
+		if (!Object)
+		{
+			OutExportError = FString::Printf(TEXT("Failed to load Object: %s"), *ObjectPath);
+			return false;
+		}
 
-	// Find exporter
-	UExporter* Exporter = UExporter::FindExporter(Object, *Format);
-	if (!Exporter)
-	{
-		OutError = FString::Printf(TEXT("Failed to find %s exporter for Object: %s"), *Format, *ObjectPath);
-		return false;
-	}
+		// Find exporter
+		UExporter* Exporter = UExporter::FindExporter(Object, *Format);
+		if (!Exporter)
+		{
+			OutExportError = FString::Printf(TEXT("Failed to find %s exporter for Object: %s"), *Format, *ObjectPath);
+			return false;
+		}
 
-	// Export to text
-	FStringOutputDevice OutputDevice;
-	const uint32 ExportFlags = PPF_Copy | PPF_ExportsNotFullyQualified;
-	UE_LOG(LogUnrealMCPServer, Verbose, TEXT("ExportAssetToText: Exporting Object '%s' to %s format using exporter: %s"), 
-		*ObjectPath, *Format, *Exporter->GetClass()->GetName());
-	Exporter->ExportText(nullptr, Object, *Format, OutputDevice, GWarn, ExportFlags);
-	
-	if (OutputDevice.IsEmpty())
-	{
-		OutError = FString::Printf(TEXT("ExportText did not produce any output for Object: %s. Using exporter: %s."), 
-			*ObjectPath, *Exporter->GetClass()->GetName());
-		return false;
-	}
+		// Export to text
+		FStringOutputDevice OutputDevice;
+		const uint32 ExportFlags = PPF_Copy | PPF_ExportsNotFullyQualified;
+		UE_LOG(LogUnrealMCPServer, Verbose, TEXT("ExportAssetToText: Exporting Object '%s' to %s format using exporter: %s"), 
+			*ObjectPath, *Format, *Exporter->GetClass()->GetName());
+		{
+			UMCP_TRACE_SCOPE(UMCP_ExportText);
+			Exporter->ExportText(nullptr, Object, *Format, OutputDevice, GWarn, ExportFlags);
+		}
+		
+		if (OutputDevice.IsEmpty())
+		{
+			OutExportError = FString::Printf(TEXT("ExportText did not produce any output for Object: %s. Using exporter: %s."), 
+				*ObjectPath, *Exporter->GetClass()->GetName());
+			return false;
+		}
 
-	OutExportedText = OutputDevice;
-	return true;
+		OutText = OutputDevice;
+		return true;
+	}, OutExportedText, OutError);
+
+	// Nothing refers to the exported object anymore, so what was loaded for it can go if memory runs high
+	Server->GetPackageLoader().ReleaseIfOverWatermark();
+	return bExported;
 }
 
 UObject* FUMCP_AssetTools::PerformImportPass(const FString& FilePath, UClass* ImportClass, const FString& PackagePath, const FString& ObjectName)
@@ -680,7 +1224,7 @@ bool FUMCP_AssetTools::ExportAsset(TSharedPtr<FJsonObject> arguments, TArray<FUM
 		ErrorResult.objectPath = TEXT("");
 		ErrorResult.format = TEXT("");
 		ErrorResult.error = TEXT("Invalid parameters");
-		if (!UMCP_ToJsonString(ErrorResult, Content.text))
+		if (!UMCP_SetStructuredContent(ErrorResult, Content))
 		{
 			Content.text = TEXT("Failed to serialize error result");
 		}
@@ -696,7 +1240,7 @@ bool FUMCP_AssetTools::ExportAsset(TSharedPtr<FJsonObject> arguments, TArray<FUM
 	{
 		Result.format = TEXT("");
 		Result.error = TEXT("Missing ObjectPath parameter.");
-		if (!UMCP_ToJsonString(Result, Content.text))
+		if (!UMCP_SetStructuredContent(Result, Content))
 		{
 			Content.text = TEXT("Failed to serialize error result");
 		}
@@ -710,12 +1254,14 @@ bool FUMCP_AssetTools::ExportAsset(TSharedPtr<FJsonObject> arguments, TArray<FUM
 	}
 	Result.format = Params.format;
 
-	// Check if the asset is a Blueprint - Blueprints must use batch export
-	UObject* Object = LoadObject<UObject>(nullptr, *Params.objectPath);
-	if (Object && Object->IsA<UBlueprint>())
+	// Check if the asset is a Blueprint - Blueprints must use batch export. The class comes from the AssetRegistry (or an
+	// object that is already loaded), so a cache hit below never loads the package.
+	const FAssetData AssetData = IAssetRegistry::GetChecked().GetAssetByObjectPath(FSoftObjectPath(Params.objectPath));
+	const UObject* LoadedObject = AssetData.IsValid() ? nullptr : StaticFindObject(UObject::StaticClass(), nullptr, *Params.objectPath);
+	if (AssetData.IsValid() ? AssetData.IsInstanceOf(UBlueprint::StaticClass()) : (LoadedObject && LoadedObject->IsA<UBlueprint>()))
 	{
 		Result.error = TEXT("Blueprint assets cannot be exported using export_asset. Use batch_export_assets instead, as Blueprint exports generate responses too large to be parsed.");
-		if (!UMCP_ToJsonString(Result, Content.text))
+		if (!UMCP_SetStructuredContent(Result, Content))
 		{
 			Content.text = TEXT("Failed to serialize error result");
 		}
@@ -728,7 +1274,7 @@ bool FUMCP_AssetTools::ExportAsset(TSharedPtr<FJsonObject> arguments, TArray<FUM
 	if (!ExportAssetToText(Params.objectPath, Params.format, ExportedText, ExportError))
 	{
 		Result.error = ExportError;
-		if (!UMCP_ToJsonString(Result, Content.text))
+		if (!UMCP_SetStructuredContent(Result, Content))
 		{
 			Content.text = TEXT("Failed to serialize error result");
 		}
@@ -741,7 +1287,7 @@ bool FUMCP_AssetTools::ExportAsset(TSharedPtr<FJsonObject> arguments, TArray<FUM
 	Result.error = TEXT(""); // Clear error on success
 
 	// Convert USTRUCT to JSON string at the end
-	if (!UMCP_ToJsonString(Result, Content.text))
+	if (!UMCP_SetStructuredContent(Result, Content))
 	{
 		Content.text = TEXT("Failed to serialize result");
 		return false;
@@ -751,10 +1297,18 @@ bool FUMCP_AssetTools::ExportAsset(TSharedPtr<FJsonObject> arguments, TArray<FUM
 	return true;
 }
 
-bool FUMCP_AssetTools::BatchExportAssets(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent)
+bool FUMCP_AssetTools::StartBatchExportAssets(TSharedPtr<FJsonObject> arguments, UMCP_ToolJobStep& OutStep, TArray<FUMCP_CallToolResultContent>& OutContent)
 {
-	auto& Content = OutContent.Add_GetRef(FUMCP_CallToolResultContent());
-	Content.type = TEXT("text");
+	auto SetErrorContent = [&OutContent](const FUMCP_BatchExportAssetsResult& ErrorResult)
+	{
+		auto& Content = OutContent.Add_GetRef(FUMCP_CallToolResultContent());
+		Content.type = TEXT("text");
+		if (!UMCP_SetStructuredContent(ErrorResult, Content))
+		{
+			Content.text = TEXT("Failed to serialize error result");
+		}
+		return false;
+	};
 
 	// Convert JSON to USTRUCT at the start
 	FUMCP_BatchExportAssetsParams Params;
@@ -765,11 +1319,7 @@ bool FUMCP_AssetTools::BatchExportAssets(TSharedPtr<FJsonObject> arguments, TArr
 		ErrorResult.exportedCount = 0;
 		ErrorResult.failedCount = 0;
 		ErrorResult.error = TEXT("Invalid parameters");
-		if (!UMCP_ToJsonString(ErrorResult, Content.text))
-		{
-			Content.text = TEXT("Failed to serialize error result");
-		}
-		return false;
+		return SetErrorContent(ErrorResult);
 	}
 
 	// Work with USTRUCT throughout
@@ -781,21 +1331,13 @@ bool FUMCP_AssetTools::BatchExportAssets(TSharedPtr<FJsonObject> arguments, TArr
 	if (Params.objectPaths.Num() == 0)
 	{
 		Result.error = TEXT("Missing or empty objectPaths parameter.");
-		if (!UMCP_ToJsonString(Result, Content.text))
-		{
-			Content.text = TEXT("Failed to serialize error result");
-		}
-		return false;
+		return SetErrorContent(Result);
 	}
 
 	if (Params.outputFolder.IsEmpty())
 	{
 		Result.error = TEXT("Missing outputFolder parameter.");
-		if (!UMCP_ToJsonString(Result, Content.text))
-		{
-			Content.text = TEXT("Failed to serialize error result");
-		}
-		return false;
+		return SetErrorContent(Result);
 	}
 
 	// Use default format if not specified
@@ -804,6 +1346,13 @@ bool FUMCP_AssetTools::BatchExportAssets(TSharedPtr<FJsonObject> arguments, TArr
 		Params.format = TEXT("T3D");
 	}
 
+	const bool bNdjson = Params.outputMode.Equals(TEXT("ndjson"), ESearchCase::IgnoreCase);
+	if (!bNdjson && !Params.outputMode.IsEmpty() && !Params.outputMode.Equals(TEXT("files"), ESearchCase::IgnoreCase))
+	{
+		Result.error = FString::Printf(TEXT("Unknown outputMode '%s'. Use 'files' or 'ndjson'."), *Params.outputMode);
+		return SetErrorContent(Result);
+	}
+
 	// Convert output folder to absolute path
 	FString AbsoluteOutputFolder = FPaths::ConvertRelativePathToFull(Params.outputFolder);
 	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
@@ -814,11 +1363,7 @@ bool FUMCP_AssetTools::BatchExportAssets(TSharedPtr<FJsonObject> arguments, TArr
 		if (!PlatformFile.CreateDirectoryTree(*AbsoluteOutputFolder))
 		{
 			Result.error = FString::Printf(TEXT("Failed to create output folder: %s"), *AbsoluteOutputFolder);
-			if (!UMCP_ToJsonString(Result, Content.text))
-			{
-				Content.text = TEXT("Failed to serialize error result");
-			}
-			return false;
+			return SetErrorContent(Result);
 		}
 		UE_LOG(LogUnrealMCPServer, Log, TEXT("Created output folder: %s"), *AbsoluteOutputFolder);
 	}
@@ -826,118 +1371,184 @@ bool FUMCP_AssetTools::BatchExportAssets(TSharedPtr<FJsonObject> arguments, TArr
 	UE_LOG(LogUnrealMCPServer, Log, TEXT("BatchExportAssets: Exporting %d assets to folder: %s, format: %s"), 
 		Params.objectPaths.Num(), *AbsoluteOutputFolder, *Params.format);
 
-	// Process each asset
+	// One export per step, so a job can be cancelled between assets and keeps what was already written.
+	// Packages are loaded asynchronously ahead of the export, and files are written on worker threads.
+	TSharedRef<FUMCP_BatchExportState> State = MakeShared<FUMCP_BatchExportState>();
+	State->Entries.Reserve(Params.objectPaths.Num());
 	for (const FString& ObjectPath : Params.objectPaths)
 	{
-		if (ObjectPath.IsEmpty())
+		State->Entries.AddDefaulted_GetRef().ObjectPath = ObjectPath;
+	}
+	State->Params = MoveTemp(Params);
+	State->AbsoluteOutputFolder = MoveTemp(AbsoluteOutputFolder);
+	State->bNdjson = bNdjson;
+	if (bNdjson)
+	{
+		// No per-asset files to name; the job writes records into the one file opened here
+		State->bFilePathsAssigned = true;
+		if (!OpenBatchExportNdjson(*State, Result.error))
 		{
-			Result.failedCount++;
-			Result.failedPaths.Add(TEXT(""));
-			UE_LOG(LogUnrealMCPServer, Warning, TEXT("BatchExportAssets: Skipping empty object path"));
-			continue;
+			return SetErrorContent(Result);
 		}
+		UE_LOG(LogUnrealMCPServer, Log, TEXT("BatchExportAssets: Writing records to %s, index: %s"), *State->NdjsonFilePath, *State->IndexFilePath);
+	}
+	State->Result = MoveTemp(Result);
 
-		// Use helper function to export asset to text
-		FString ExportedText;
-		FString ExportError;
-		if (!ExportAssetToText(ObjectPath, Params.format, ExportedText, ExportError))
+	OutStep = [this, State](FUMCP_JobContext& Context, FUMCP_CallToolResult& OutResult)
+	{
+		// A job gets a later tick to wait in; inline calls and the last step after a cancel have to block instead
+		const bool bCanWait = !Context.IsInline() && !Context.IsCancelRequested();
+		if (!State->bFilePathsAssigned)
 		{
-			Result.failedCount++;
-			Result.failedPaths.Add(ObjectPath);
-			UE_LOG(LogUnrealMCPServer, Warning, TEXT("BatchExportAssets: Failed to export Object '%s': %s"), *ObjectPath, *ExportError);
-			continue;
+			AssignBatchExportFilePaths(*State);
 		}
 
-		// Generate filename from object path
-		// Extract object name from path (e.g., "/Game/MyAsset.MyAsset" -> "MyAsset")
-		FString ObjectName;
-		int32 LastDotIndex;
-		if (ObjectPath.FindLastChar(TEXT('.'), LastDotIndex))
+		const int32 NumEntries = State->Entries.Num();
+		if (State->NextExportIndex < NumEntries && !Context.IsCancelRequested())
 		{
-			FString PathBeforeDot = ObjectPath.Left(LastDotIndex);
-			int32 LastSlashIndex;
-			if (PathBeforeDot.FindLastChar(TEXT('/'), LastSlashIndex))
+			FUMCP_PackageLoader& Loader = Server->GetPackageLoader();
+			StartBatchExportLoads(*State, Loader);
+			DrainBatchExportWrites(*State, !bCanWait, BatchExportMaxPendingWrites - 1);
+			if (State->NumPendingWrites >= BatchExportMaxPendingWrites)
 			{
-				ObjectName = PathBeforeDot.Mid(LastSlashIndex + 1);
+				return EUMCP_JobStepResult::Wait;
 			}
-			else
+
+			// Assets are exported in request order, each as soon as its package has completed
+			FUMCP_BatchExportEntry& Entry = State->Entries[State->NextExportIndex];
+			const bool bRequested = State->NextLoadIndex > State->NextExportIndex;
+			if (!bRequested || !Loader.IsLoadComplete(Entry.LoadRequestId))
 			{
-				ObjectName = PathBeforeDot;
+				if (bCanWait)
+				{
+					return EUMCP_JobStepResult::Wait;
+				}
+				// Not requested yet means the window is full; the export then loads the package itself
+				Loader.WaitForLoad(Entry.LoadRequestId);
 			}
-		}
-		else
-		{
-			// Fallback: use last part of path
-			int32 LastSlashIndex;
-			if (ObjectPath.FindLastChar(TEXT('/'), LastSlashIndex))
+
+			Context.ReportProgress(State->NextExportIndex, NumEntries, Entry.ObjectPath);
+			const int32 EntryIndex = State->NextExportIndex++;
+			FString ExportedText;
+			FString ExportError;
+			if (Entry.ObjectPath.IsEmpty())
 			{
-				ObjectName = ObjectPath.Mid(LastSlashIndex + 1);
+				Entry.State = EUMCP_BatchExportEntryState::Failed;
+				UE_LOG(LogUnrealMCPServer, Warning, TEXT("BatchExportAssets: Skipping empty object path"));
+			}
+			else if (!ExportAssetToText(Entry.ObjectPath, State->Params.format, ExportedText, ExportError))
+			{
+				Entry.State = EUMCP_BatchExportEntryState::Failed;
+				UE_LOG(LogUnrealMCPServer, Warning, TEXT("BatchExportAssets: Failed to export Object '%s': %s"), *Entry.ObjectPath, *ExportError);
+			}
+			else if (State->bNdjson)
+			{
+				// Escaping and appending the record don't touch UObjects either; records queue up behind one writer
+				Entry.State = EUMCP_BatchExportEntryState::Writing;
+				++State->NumPendingWrites;
+				State->PendingRecords.Enqueue(TPair<int32, FString>(EntryIndex, MoveTemp(ExportedText)));
+				if (!State->bRecordWriterRunning.exchange(true))
+				{
+					AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [State]()
+					{
+						WriteBatchExportRecords(State);
+					});
+				}
 			}
 			else
 			{
-				ObjectName = ObjectPath;
+				// Encoding and writing the file don't touch UObjects, so they run off the game thread
+				Entry.State = EUMCP_BatchExportEntryState::Writing;
+				++State->NumPendingWrites;
+				AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [State, EntryIndex, FilePath = Entry.FilePath, ExportedText = MoveTemp(ExportedText)]()
+				{
+					bool bWritten = false;
+					{
+						UMCP_TRACE_SCOPE(UMCP_WriteExportFile);
+						bWritten = FFileHelper::SaveStringToFile(ExportedText, *FilePath);
+					}
+					FScopeLock Lock(&State->CompletedWritesLock);
+					State->CompletedWrites.Emplace(EntryIndex, bWritten);
+				});
 			}
+			return EUMCP_JobStepResult::Continue;
 		}
 
-		// Sanitize filename (remove invalid characters)
-		ObjectName = ObjectName.Replace(TEXT(" "), TEXT("_"));
-		ObjectName = ObjectName.Replace(TEXT("."), TEXT("_"));
-		
-		// Build full file path
-		FString FileName = ObjectName + TEXT(".") + Params.format.ToLower();
-		FString FullFilePath = FPaths::Combine(AbsoluteOutputFolder, FileName);
-
-		// Handle filename collisions by appending a number
-		FString FinalFilePath = FullFilePath;
-		int32 Counter = 1;
-		while (PlatformFile.FileExists(*FinalFilePath))
+		// Every file that was handed to a worker is part of the result, including after a cancel
+		DrainBatchExportWrites(*State, !bCanWait, 0);
+		if (State->NumPendingWrites > 0)
 		{
-			FString BaseName = ObjectName;
-			FString Extension = TEXT(".") + Params.format.ToLower();
-			FinalFilePath = FPaths::Combine(AbsoluteOutputFolder, FString::Printf(TEXT("%s_%d%s"), *BaseName, Counter, *Extension));
-			Counter++;
+			return EUMCP_JobStepResult::Wait;
 		}
+		Context.ReportProgress(State->NextExportIndex, NumEntries);
 
-		// Write file
-		if (!FFileHelper::SaveStringToFile(ExportedText, *FinalFilePath))
+		// Paths are reported in request order, whatever order the writes finished in
+		FUMCP_BatchExportAssetsResult& ExportResult = State->Result;
+		bool bNdjsonClosed = true;
+		if (State->bNdjson)
 		{
-			Result.failedCount++;
-			Result.failedPaths.Add(ObjectPath);
-			UE_LOG(LogUnrealMCPServer, Warning, TEXT("BatchExportAssets: Failed to write file: %s for Object: %s"), *FinalFilePath, *ObjectPath);
-			continue;
+			// Every record has been written, so the writer is done with the files; the index lists what the file holds
+			bNdjsonClosed = State->NdjsonWriter->Close() && State->IndexWriter->Close();
+			State->NdjsonWriter.Reset();
+			State->IndexWriter.Reset();
+			ExportResult.outputFile = State->NdjsonFilePath;
+			ExportResult.indexFile = State->IndexFilePath;
+		}
+		for (const FUMCP_BatchExportEntry& Entry : State->Entries)
+		{
+			if (Entry.State == EUMCP_BatchExportEntryState::Exported)
+			{
+				ExportResult.exportedCount++;
+				if (!State->bNdjson)
+				{
+					ExportResult.exportedPaths.Add(Entry.FilePath);
+				}
+			}
+			else if (Entry.State == EUMCP_BatchExportEntryState::Failed)
+			{
+				ExportResult.failedCount++;
+				ExportResult.failedPaths.Add(Entry.ObjectPath);
+			}
 		}
 
-		// Success
-		Result.exportedCount++;
-		Result.exportedPaths.Add(FinalFilePath);
-		UE_LOG(LogUnrealMCPServer, Log, TEXT("BatchExportAssets: Successfully exported Object '%s' to file: %s"), *ObjectPath, *FinalFilePath);
-	}
-
-	// Overall success if at least one asset was exported
-	Result.bSuccess = (Result.exportedCount > 0);
-	if (!Result.bSuccess && Result.failedCount > 0)
-	{
-		Result.error = FString::Printf(TEXT("All %d assets failed to export"), Result.failedCount);
-	}
-	else if (Result.failedCount > 0)
-	{
-		Result.error = FString::Printf(TEXT("Partial success: %d exported, %d failed"), Result.exportedCount, Result.failedCount);
-	}
-	else
-	{
-		Result.error = TEXT("");
-	}
+		// Overall success if at least one asset was exported
+		ExportResult.bSuccess = (ExportResult.exportedCount > 0);
+		if (!bNdjsonClosed)
+		{
+			ExportResult.bSuccess = false;
+			ExportResult.error = FString::Printf(TEXT("Failed to finish writing %s"), *State->NdjsonFilePath);
+		}
+		else if (State->NextExportIndex < NumEntries)
+		{
+			ExportResult.error = FString::Printf(TEXT("Cancelled after %d of %d assets: %d exported, %d failed"), State->NextExportIndex, NumEntries, ExportResult.exportedCount, ExportResult.failedCount);
+		}
+		else if (!ExportResult.bSuccess && ExportResult.failedCount > 0)
+		{
+			ExportResult.error = FString::Printf(TEXT("All %d assets failed to export"), ExportResult.failedCount);
+		}
+		else if (ExportResult.failedCount > 0)
+		{
+			ExportResult.error = FString::Printf(TEXT("Partial success: %d exported, %d failed"), ExportResult.exportedCount, ExportResult.failedCount);
+		}
+		else
+		{
+			ExportResult.error = TEXT("");
+		}
 
-	// Convert USTRUCT to JSON string at the end
-	if (!UMCP_ToJsonString(Result, Content.text))
-	{
-		Content.text = TEXT("Failed to serialize result");
-		return false;
-	}
+		// Convert USTRUCT to JSON string at the end
+		auto& Content = OutResult.content.Add_GetRef(FUMCP_CallToolResultContent());
+		Content.type = TEXT("text");
+		if (!UMCP_SetStructuredContent(ExportResult, Content))
+		{
+			Content.text = TEXT("Failed to serialize result");
+			OutResult.isError = true;
+			return EUMCP_JobStepResult::Finished;
+		}
 
-	UE_LOG(LogUnrealMCPServer, Log, TEXT("BatchExportAssets: Completed batch export. Exported: %d, Failed: %d"), 
-		Result.exportedCount, Result.failedCount);
-	
+		UE_LOG(LogUnrealMCPServer, Log, TEXT("BatchExportAssets: Completed batch export. Exported: %d, Failed: %d"), 
+			ExportResult.exportedCount, ExportResult.failedCount);
+		return EUMCP_JobStepResult::Finished;
+	};
 	return true;
 }
 
@@ -955,7 +1566,7 @@ bool FUMCP_AssetTools::ExportClassDefault(TSharedPtr<FJsonObject> arguments, TAr
 		ErrorResult.classPath = TEXT("");
 		ErrorResult.format = TEXT("");
 		ErrorResult.error = TEXT("Invalid parameters");
-		if (!UMCP_ToJsonString(ErrorResult, Content.text))
+		if (!UMCP_SetStructuredContent(ErrorResult, Content))
 		{
 			Content.text = TEXT("Failed to serialize error result");
 		}
@@ -971,7 +1582,7 @@ bool FUMCP_AssetTools::ExportClassDefault(TSharedPtr<FJsonObject> arguments, TAr
 	{
 		Result.format = TEXT("");
 		Result.error = TEXT("Missing ClassPath parameter.");
-		if (!UMCP_ToJsonString(Result, Content.text))
+		if (!UMCP_SetStructuredContent(Result, Content))
 		{
 			Content.text = TEXT("Failed to serialize error result");
 		}
@@ -986,11 +1597,11 @@ bool FUMCP_AssetTools::ExportClassDefault(TSharedPtr<FJsonObject> arguments, TAr
 	Result.format = Params.format;
 
 	// Load the class from the class path
-	UClass* Class = LoadClass<UObject>(nullptr, *Params.classPath);
+	UClass* Class = Server->GetPackageLoader().LoadClass(Params.classPath);
 	if (!Class)
 	{
 		Result.error = FString::Printf(TEXT("Failed to load Class: %s"), *Params.classPath);
-		if (!UMCP_ToJsonString(Result, Content.text))
+		if (!UMCP_SetStructuredContent(Result, Content))
 		{
 			Content.text = TEXT("Failed to serialize error result");
 		}
@@ -1002,7 +1613,7 @@ bool FUMCP_AssetTools::ExportClassDefault(TSharedPtr<FJsonObject> arguments, TAr
 	if (!ClassDefaultObject)
 	{
 		Result.error = FString::Printf(TEXT("Failed to get class default object for Class: %s"), *Params.classPath);
-		if (!UMCP_ToJsonString(Result, Content.text))
+		if (!UMCP_SetStructuredContent(Result, Content))
 		{
 			Content.text = TEXT("Failed to serialize error result");
 		}
@@ -1013,7 +1624,7 @@ bool FUMCP_AssetTools::ExportClassDefault(TSharedPtr<FJsonObject> arguments, TAr
 	if (!Exporter)
 	{
 		Result.error = FString::Printf(TEXT("Failed to find %s exporter for Class Default Object: %s"), *Params.format, *Params.classPath);
-		if (!UMCP_ToJsonString(Result, Content.text))
+		if (!UMCP_SetStructuredContent(Result, Content))
 		{
 			Content.text = TEXT("Failed to serialize error result");
 		}
@@ -1023,12 +1634,16 @@ bool FUMCP_AssetTools::ExportClassDefault(TSharedPtr<FJsonObject> arguments, TAr
 	FStringOutputDevice OutputDevice;
 	const uint32 ExportFlags = PPF_Copy | PPF_ExportsNotFullyQualified;
 	UE_LOG(LogUnrealMCPServer, Log, TEXT("Attempting to export Class Default Object for '%s' to %s format using exporter: %s"), *Params.classPath, *Params.format, *Exporter->GetClass()->GetName());
-	Exporter->ExportText(nullptr, ClassDefaultObject, *Params.format, OutputDevice, GWarn, ExportFlags);
+	{
+		UMCP_TRACE_SCOPE(UMCP_ExportText);
+		Exporter->ExportText(nullptr, ClassDefaultObject, *Params.format, OutputDevice, GWarn, ExportFlags);
+	}
+	Server->GetPackageLoader().ReleaseIfOverWatermark();
 	if (OutputDevice.IsEmpty())
 	{
 		Result.error = FString::Printf(TEXT("ExportText did not produce any output for Class Default Object: %s. Using exporter: %s."), *Params.classPath, *Exporter->GetClass()->GetName());
 		UE_LOG(LogUnrealMCPServer, Warning, TEXT("%s"), *Result.error);
-		if (!UMCP_ToJsonString(Result, Content.text))
+		if (!UMCP_SetStructuredContent(Result, Content))
 		{
 			Content.text = TEXT("Failed to serialize error result");
 		}
@@ -1041,7 +1656,7 @@ bool FUMCP_AssetTools::ExportClassDefault(TSharedPtr<FJsonObject> arguments, TAr
 	Result.error = TEXT(""); // Clear error on success
 
 	// Convert USTRUCT to JSON string at the end
-	if (!UMCP_ToJsonString(Result, Content.text))
+	if (!UMCP_SetStructuredContent(Result, Content))
 	{
 		Content.text = TEXT("Failed to serialize result");
 		return false;
@@ -1051,332 +1666,475 @@ bool FUMCP_AssetTools::ExportClassDefault(TSharedPtr<FJsonObject> arguments, TAr
 	return true;
 }
 
-bool FUMCP_AssetTools::ImportAsset(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent)
+bool FUMCP_AssetTools::StartImportAsset(TSharedPtr<FJsonObject> arguments, UMCP_ToolJobStep& OutStep, TArray<FUMCP_CallToolResultContent>& OutContent)
 {
-	auto& Content = OutContent.Add_GetRef(FUMCP_CallToolResultContent());
-	Content.type = TEXT("text");
-
-	// Convert JSON to USTRUCT at the start
-	FUMCP_ImportAssetParams Params;
-	if (!arguments.IsValid() || !UMCP_CreateFromJsonObject(arguments, Params))
+	// An import cannot be interrupted once the factory runs, so it is a single step: as a job it only stops the call from blocking the client
+	OutStep = [this, arguments](FUMCP_JobContext& Context, FUMCP_CallToolResult& OutResult)
 	{
-		Content.text = TEXT("Invalid parameters");
-		return false;
-	}
+		if (Context.IsCancelRequested())
+		{
+			FUMCP_ImportAssetResult Result;
+			Result.bSuccess = false;
+			Result.error = TEXT("Cancelled before the import started");
+			auto& Content = OutResult.content.Add_GetRef(FUMCP_CallToolResultContent());
+			Content.type = TEXT("text");
+			if (!UMCP_SetStructuredContent(Result, Content))
+			{
+				Content.text = TEXT("Failed to serialize error result");
+			}
+			OutResult.isError = true;
+			return EUMCP_JobStepResult::Finished;
+		}
 
-	// Work with USTRUCT throughout
-	FUMCP_ImportAssetResult Result;
-	Result.bSuccess = false;
-	
+		Context.ReportProgress(0.0, 1.0, TEXT("Importing"));
+		OutResult.isError = !ImportAsset(arguments, OutResult.content);
+		Context.ReportProgress(1.0, 1.0);
+		return EUMCP_JobStepResult::Finished;
+	};
+	return true;
+}
+
+struct FUMCP_AssetTools::FPreparedImport
+{
+	FString AbsoluteFilePath;
+	FString AbsoluteT3DFilePath;
+	UClass* ImportClass = nullptr;
+	FString FullObjectPath; // /Game/MyFolder/MyAsset.MyAsset
+	FString PackagePath;
+	FString ObjectName;
+	UPackage* TargetPackage = nullptr; // Null if the asset is created by the import
+	bool bAssetExists = false;
+};
+
+bool FUMCP_AssetTools::PrepareImport(const FUMCP_ImportAssetParams& Params, FPreparedImport& OutImport, FUMCP_ImportAssetResult& Result)
+{
 	// Validate that at least one file path is provided
 	if (Params.filePath.IsEmpty() && Params.t3dFilePath.IsEmpty())
 	{
 		Result.error = TEXT("At least one of filePath or t3dFilePath must be specified.");
-		
-		// Convert USTRUCT to JSON string at the end
-		if (!UMCP_ToJsonString(Result, Content.text))
-		{
-			Content.text = TEXT("Failed to serialize result");
-		}
 		return false;
 	}
 	
 	if (Params.packagePath.IsEmpty())
 	{
 		Result.error = TEXT("Missing PackagePath parameter.");
-		
-		// Convert USTRUCT to JSON string at the end
-		if (!UMCP_ToJsonString(Result, Content.text))
-		{
-			Content.text = TEXT("Failed to serialize result");
-		}
 		return false;
 	}
 
 	if (Params.classPath.IsEmpty())
 	{
 		Result.error = TEXT("Missing ClassPath parameter.");
-		
-		// Convert USTRUCT to JSON string at the end
-		if (!UMCP_ToJsonString(Result, Content.text))
-		{
-			Content.text = TEXT("Failed to serialize result");
-		}
 		return false;
 	}
 
 	// Convert to absolute paths
-	FString AbsoluteFilePath;
-	FString AbsoluteT3DFilePath;
 	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
 	
 	if (!Params.filePath.IsEmpty())
 	{
-		AbsoluteFilePath = FPaths::ConvertRelativePathToFull(Params.filePath);
+		OutImport.AbsoluteFilePath = FPaths::ConvertRelativePathToFull(Params.filePath);
 		// Verify binary file exists
-		if (!PlatformFile.FileExists(*AbsoluteFilePath))
+		if (!PlatformFile.FileExists(*OutImport.AbsoluteFilePath))
 		{
-			Result.error = FString::Printf(TEXT("Binary file not found: %s"), *AbsoluteFilePath);
-			Result.filePath = AbsoluteFilePath;
-			
-			// Convert USTRUCT to JSON string at the end
-			if (!UMCP_ToJsonString(Result, Content.text))
-			{
-				Content.text = TEXT("Failed to serialize result");
-			}
+			Result.error = FString::Printf(TEXT("Binary file not found: %s"), *OutImport.AbsoluteFilePath);
+			Result.filePath = OutImport.AbsoluteFilePath;
 			return false;
 		}
 	}
 	
 	if (!Params.t3dFilePath.IsEmpty())
 	{
-		AbsoluteT3DFilePath = FPaths::ConvertRelativePathToFull(Params.t3dFilePath);
+		OutImport.AbsoluteT3DFilePath = FPaths::ConvertRelativePathToFull(Params.t3dFilePath);
 		// Verify T3D file exists
-		if (!PlatformFile.FileExists(*AbsoluteT3DFilePath))
+		if (!PlatformFile.FileExists(*OutImport.AbsoluteT3DFilePath))
 		{
-			Result.error = FString::Printf(TEXT("T3D file not found: %s"), *AbsoluteT3DFilePath);
-			Result.filePath = AbsoluteT3DFilePath;
-			
-			// Convert USTRUCT to JSON string at the end
-			if (!UMCP_ToJsonString(Result, Content.text))
-			{
-				Content.text = TEXT("Failed to serialize result");
-			}
+			Result.error = FString::Printf(TEXT("T3D file not found: %s"), *OutImport.AbsoluteT3DFilePath);
+			Result.filePath = OutImport.AbsoluteT3DFilePath;
 			return false;
 		}
 	}
 
 	// Load the class from the class path
-	UClass* ImportClass = LoadClass<UObject>(nullptr, *Params.classPath);
-	if (!ImportClass)
+	OutImport.ImportClass = LoadClass<UObject>(nullptr, *Params.classPath);
+	if (!OutImport.ImportClass)
 	{
 		Result.error = FString::Printf(TEXT("Failed to load class: %s"), *Params.classPath);
-		if (!AbsoluteFilePath.IsEmpty())
-		{
-			Result.filePath = AbsoluteFilePath;
-		}
-		else if (!AbsoluteT3DFilePath.IsEmpty())
-		{
-			Result.filePath = AbsoluteT3DFilePath;
-		}
-		
-		// Convert USTRUCT to JSON string at the end
-		if (!UMCP_ToJsonString(Result, Content.text))
-		{
-			Content.text = TEXT("Failed to serialize result");
-		}
+		Result.filePath = !OutImport.AbsoluteFilePath.IsEmpty() ? OutImport.AbsoluteFilePath : OutImport.AbsoluteT3DFilePath;
 		return false;
 	}
 
 	// Parse the full object path to extract package path and object name
 	// Expected format: /Game/MyFolder/MyAsset.MyAsset
-	FString FullObjectPath = Params.packagePath;
-	if (!FullObjectPath.StartsWith(TEXT("/")))
+	OutImport.FullObjectPath = Params.packagePath;
+	if (!OutImport.FullObjectPath.StartsWith(TEXT("/")))
 	{
-		FullObjectPath = TEXT("/Game/") + FullObjectPath;
+		OutImport.FullObjectPath = TEXT("/Game/") + OutImport.FullObjectPath;
 	}
 	
 	// Extract package path and object name from full object path in a single pass
-	// Expected format: /Game/MyFolder/MyAsset.MyAsset
-	FString PackagePath;
-	FString ObjectName;
 	int32 LastDotIndex;
-	if (FullObjectPath.FindLastChar(TEXT('.'), LastDotIndex))
+	if (OutImport.FullObjectPath.FindLastChar(TEXT('.'), LastDotIndex))
 	{
-		PackagePath = FullObjectPath.Left(LastDotIndex);
-		ObjectName = FullObjectPath.Mid(LastDotIndex + 1);
+		OutImport.PackagePath = OutImport.FullObjectPath.Left(LastDotIndex);
+		OutImport.ObjectName = OutImport.FullObjectPath.Mid(LastDotIndex + 1);
 	}
 	else
 	{
 		// If no dot found, treat the entire path as package path (backward compatibility)
-		PackagePath = FullObjectPath;
-		ObjectName = FPaths::GetBaseFilename(PackagePath);
+		OutImport.PackagePath = OutImport.FullObjectPath;
+		OutImport.ObjectName = FPaths::GetBaseFilename(OutImport.PackagePath);
 		// Append the object name to make it a full object path
-		FullObjectPath = PackagePath + TEXT(".") + ObjectName;
+		OutImport.FullObjectPath = OutImport.PackagePath + TEXT(".") + OutImport.ObjectName;
 	}
 
 	// Check if asset already exists and validate class
 	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
 	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-	FSoftObjectPath SoftPath(FullObjectPath);
+	FSoftObjectPath SoftPath(OutImport.FullObjectPath);
 	FAssetData ExistingAssetData = AssetRegistry.GetAssetByObjectPath(SoftPath);
+	OutImport.bAssetExists = ExistingAssetData.IsValid();
 	
 	if (ExistingAssetData.IsValid())
 	{
 		// Asset exists - validate that the class matches
 		FTopLevelAssetPath ExistingClassPath = ExistingAssetData.AssetClassPath;
-		FTopLevelAssetPath RequestedClassPath = ImportClass->GetClassPathName();
+		FTopLevelAssetPath RequestedClassPath = OutImport.ImportClass->GetClassPathName();
 		
 		if (ExistingClassPath != RequestedClassPath)
 		{
 			Result.error = FString::Printf(TEXT("Asset already exists at '%s' with class '%s', but requested class is '%s'. Cannot change asset class during import."), 
-				*FullObjectPath, *ExistingClassPath.ToString(), *RequestedClassPath.ToString());
-			if (!AbsoluteFilePath.IsEmpty())
-			{
-				Result.filePath = AbsoluteFilePath;
-			}
-			else if (!AbsoluteT3DFilePath.IsEmpty())
-			{
-				Result.filePath = AbsoluteT3DFilePath;
-			}
-			Result.packagePath = FullObjectPath;
-			
-			// Convert USTRUCT to JSON string at the end
-			if (!UMCP_ToJsonString(Result, Content.text))
-			{
-				Content.text = TEXT("Failed to serialize result");
-			}
+				*OutImport.FullObjectPath, *ExistingClassPath.ToString(), *RequestedClassPath.ToString());
+			Result.filePath = !OutImport.AbsoluteFilePath.IsEmpty() ? OutImport.AbsoluteFilePath : OutImport.AbsoluteT3DFilePath;
+			Result.packagePath = OutImport.FullObjectPath;
 			return false;
 		}
 	}
 
 	// Try to find the target package if it exists (for use as primary object in transaction)
-	UPackage* TargetPackage = FindPackage(nullptr, *PackagePath);
-	if (!TargetPackage)
+	OutImport.TargetPackage = FindPackage(nullptr, *OutImport.PackagePath);
+	if (!OutImport.TargetPackage)
 	{
 		// Package doesn't exist yet, try loading it
-		TargetPackage = LoadPackage(nullptr, *PackagePath, LOAD_None);
+		OutImport.TargetPackage = LoadPackage(nullptr, *OutImport.PackagePath, LOAD_None);
 	}
+	return true;
+}
 
-	// Begin editor transaction to make the import undoable
-	bool bTransactionStarted = false;
-	if (GEditor)
-	{
-		GEditor->BeginTransaction(TEXT("Import Asset"), FText::FromString(TEXT("Import Asset")), TargetPackage);
-		bTransactionStarted = true;
-	}
-	
-	// Ensure transaction is always closed when scope exits
-	ON_SCOPE_EXIT
-	{
-		if (bTransactionStarted && GEditor)
-		{
-			GEditor->EndTransaction();
-		}
-	};
-	
+UObject* FUMCP_AssetTools::RunImport(const FPreparedImport& Import, FUMCP_ImportAssetResult& Result)
+{
 	UObject* ImportedObject = nullptr;
-	FString FactoryClassName;
 	
 	// Step 1: Import binary file first (if provided)
-	if (!AbsoluteFilePath.IsEmpty())
+	if (!Import.AbsoluteFilePath.IsEmpty())
 	{
-		ImportedObject = PerformImportPass(AbsoluteFilePath, ImportClass, PackagePath, ObjectName);
+		ImportedObject = PerformImportPass(Import.AbsoluteFilePath, Import.ImportClass, Import.PackagePath, Import.ObjectName);
 		
 		if (!ImportedObject)
 		{
-			Result.error = FString::Printf(TEXT("Failed to import binary file: %s. Check the file format and content."), *AbsoluteFilePath);
-			Result.filePath = AbsoluteFilePath;
-			Result.packagePath = FullObjectPath;
-			
-			// Convert USTRUCT to JSON string at the end
-			if (!UMCP_ToJsonString(Result, Content.text))
-			{
-				Content.text = TEXT("Failed to serialize result");
-			}
-			return false;
+			Result.error = FString::Printf(TEXT("Failed to import binary file: %s. Check the file format and content."), *Import.AbsoluteFilePath);
+			Result.filePath = Import.AbsoluteFilePath;
+			Result.packagePath = Import.FullObjectPath;
+			return nullptr;
 		}
 		
-		UE_LOG(LogUnrealMCPServer, Log, TEXT("Successfully imported binary file: %s"), *AbsoluteFilePath);
+		UE_LOG(LogUnrealMCPServer, Log, TEXT("Successfully imported binary file: %s"), *Import.AbsoluteFilePath);
 	}
 	
 	// Step 2: Import T3D file to configure the imported object (if provided)
-	if (!AbsoluteT3DFilePath.IsEmpty())
+	if (!Import.AbsoluteT3DFilePath.IsEmpty())
 	{
 		// If we already imported a binary file, the object should exist
 		// Otherwise, we're importing from T3D only
 		if (ImportedObject == nullptr)
 		{
 			// Import from T3D file
-			ImportedObject = PerformImportPass(AbsoluteT3DFilePath, ImportClass, PackagePath, ObjectName);
+			ImportedObject = PerformImportPass(Import.AbsoluteT3DFilePath, Import.ImportClass, Import.PackagePath, Import.ObjectName);
 			
 			if (!ImportedObject)
 			{
-				Result.error = FString::Printf(TEXT("Failed to import T3D file: %s. Check the file format and content."), *AbsoluteT3DFilePath);
-				Result.filePath = AbsoluteT3DFilePath;
-				Result.packagePath = FullObjectPath;
-				
-				// Convert USTRUCT to JSON string at the end
-				if (!UMCP_ToJsonString(Result, Content.text))
-				{
-					Content.text = TEXT("Failed to serialize result");
-				}
-				return false;
+				Result.error = FString::Printf(TEXT("Failed to import T3D file: %s. Check the file format and content."), *Import.AbsoluteT3DFilePath);
+				Result.filePath = Import.AbsoluteT3DFilePath;
+				Result.packagePath = Import.FullObjectPath;
+				return nullptr;
 			}
 			
-			UE_LOG(LogUnrealMCPServer, Log, TEXT("Successfully imported T3D file: %s"), *AbsoluteT3DFilePath);
+			UE_LOG(LogUnrealMCPServer, Log, TEXT("Successfully imported T3D file: %s"), *Import.AbsoluteT3DFilePath);
 		}
 		else
 		{
 			// Object already exists from binary import, now apply T3D configuration
 			// Re-import using T3D to configure the existing object
-			UObject* T3DImportedObject = PerformImportPass(AbsoluteT3DFilePath, ImportClass, PackagePath, ObjectName);
+			UObject* T3DImportedObject = PerformImportPass(Import.AbsoluteT3DFilePath, Import.ImportClass, Import.PackagePath, Import.ObjectName);
 			
 			if (!T3DImportedObject)
 			{
-				Result.error = FString::Printf(TEXT("Failed to apply T3D configuration from file: %s. Binary import succeeded but T3D import failed."), *AbsoluteT3DFilePath);
-				Result.filePath = AbsoluteT3DFilePath;
-				Result.packagePath = FullObjectPath;
-				
-				// Convert USTRUCT to JSON string at the end
-				if (!UMCP_ToJsonString(Result, Content.text))
-				{
-					Content.text = TEXT("Failed to serialize result");
-				}
-				return false;
+				Result.error = FString::Printf(TEXT("Failed to apply T3D configuration from file: %s. Binary import succeeded but T3D import failed."), *Import.AbsoluteT3DFilePath);
+				Result.filePath = Import.AbsoluteT3DFilePath;
+				Result.packagePath = Import.FullObjectPath;
+				return nullptr;
 			}
 			
 			// Use the T3D imported object (which should be the same object, just reconfigured)
 			ImportedObject = T3DImportedObject;
-			UE_LOG(LogUnrealMCPServer, Log, TEXT("Successfully applied T3D configuration from file: %s"), *AbsoluteT3DFilePath);
+			UE_LOG(LogUnrealMCPServer, Log, TEXT("Successfully applied T3D configuration from file: %s"), *Import.AbsoluteT3DFilePath);
 		}
 	}
+	return ImportedObject;
+}
+
+bool FUMCP_AssetTools::ImportAsset(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent)
+{
+	auto& Content = OutContent.Add_GetRef(FUMCP_CallToolResultContent());
+	Content.type = TEXT("text");
+
+	// Convert JSON to USTRUCT at the start
+	FUMCP_ImportAssetParams Params;
+	if (!arguments.IsValid() || !UMCP_CreateFromJsonObject(arguments, Params))
+	{
+		Content.text = TEXT("Invalid parameters");
+		return false;
+	}
+
+	// Work with USTRUCT throughout
+	FUMCP_ImportAssetResult Result;
+	Result.bSuccess = false;
 	
-	// Build structured result in USTRUCT
-	Result.bSuccess = true;
-	Result.count = 1;
-	if (!AbsoluteFilePath.IsEmpty())
+	FPreparedImport Import;
+	UObject* ImportedObject = nullptr;
+	if (PrepareImport(Params, Import, Result))
 	{
-		Result.filePath = AbsoluteFilePath;
+		// Begin editor transaction to make the import undoable
+		bool bTransactionStarted = false;
+		if (GEditor)
+		{
+			GEditor->BeginTransaction(TEXT("Import Asset"), FText::FromString(TEXT("Import Asset")), Import.TargetPackage);
+			bTransactionStarted = true;
+		}
+		
+		// Ensure transaction is always closed when scope exits
+		ON_SCOPE_EXIT
+		{
+			if (bTransactionStarted && GEditor)
+			{
+				GEditor->EndTransaction();
+			}
+		};
+
+		ImportedObject = RunImport(Import, Result);
 	}
-	else if (!AbsoluteT3DFilePath.IsEmpty())
+	if (!ImportedObject)
 	{
-		Result.filePath = AbsoluteT3DFilePath;
+		// Convert USTRUCT to JSON string at the end
+		if (!UMCP_SetStructuredContent(Result, Content))
+		{
+			Content.text = TEXT("Failed to serialize result");
+		}
+		return false;
 	}
-	Result.packagePath = FullObjectPath;
-	Result.factoryClass = FactoryClassName;
 	
+	// Build structured result in USTRUCT
+	Result.bSuccess = true;
+	Result.count = 1;
+	Result.filePath = !Import.AbsoluteFilePath.IsEmpty() ? Import.AbsoluteFilePath : Import.AbsoluteT3DFilePath;
+	Result.packagePath = Import.FullObjectPath;
 	Result.importedObjects.Empty();
-	if (ImportedObject)
-	{
-		Result.importedObjects.Add(ImportedObject->GetPathName());
-	}
+	Result.importedObjects.Add(ImportedObject->GetPathName());
 	
 	// Convert USTRUCT to JSON string at the end
-	if (!UMCP_ToJsonString(Result, Content.text))
+	if (!UMCP_SetStructuredContent(Result, Content))
 	{
 		Content.text = TEXT("Failed to serialize result");
 		return false;
 	}
 	
-	FString ImportedFiles = TEXT("");
-	if (!AbsoluteFilePath.IsEmpty())
-	{
-		ImportedFiles = AbsoluteFilePath;
-	}
-	if (!AbsoluteT3DFilePath.IsEmpty())
+	FString ImportedFiles = Import.AbsoluteFilePath;
+	if (!Import.AbsoluteT3DFilePath.IsEmpty())
 	{
 		if (!ImportedFiles.IsEmpty())
 		{
 			ImportedFiles += TEXT(", ");
 		}
-		ImportedFiles += AbsoluteT3DFilePath;
+		ImportedFiles += Import.AbsoluteT3DFilePath;
 	}
 	UE_LOG(LogUnrealMCPServer, Log, TEXT("Successfully imported %d object(s) from file(s): %s"), Result.importedObjects.Num(), *ImportedFiles);
 	
 	return true;
 }
 
+bool FUMCP_AssetTools::StartBatchImportAssets(TSharedPtr<FJsonObject> arguments, UMCP_ToolJobStep& OutStep, TArray<FUMCP_CallToolResultContent>& OutContent)
+{
+	// Convert JSON to USTRUCT at the start
+	FUMCP_BatchImportAssetsParams Params;
+	FUMCP_BatchImportAssetsResult ErrorResult;
+	if (!arguments.IsValid() || !UMCP_CreateFromJsonObject(arguments, Params))
+	{
+		ErrorResult.error = TEXT("Invalid parameters");
+	}
+	else if (Params.assets.Num() == 0)
+	{
+		ErrorResult.error = TEXT("Missing or empty assets parameter.");
+	}
+	if (!ErrorResult.error.IsEmpty())
+	{
+		auto& Content = OutContent.Add_GetRef(FUMCP_CallToolResultContent());
+		Content.type = TEXT("text");
+		if (!UMCP_SetStructuredContent(ErrorResult, Content))
+		{
+			Content.text = TEXT("Failed to serialize error result");
+		}
+		return false;
+	}
+
+	// The whole batch is one step, so its transaction never stays open across editor frames. The game thread (and with it the
+	// HTTP listeners) is busy for the length of that step, so a cancel is only seen if it arrived before the batch began, and
+	// progress is only reported once it is done
+	OutStep = [this, Params = MoveTemp(Params)](FUMCP_JobContext& Context, FUMCP_CallToolResult& OutResult)
+	{
+		const int32 NumAssets = Params.assets.Num();
+		FUMCP_BatchImportAssetsResult Result;
+		Result.results.SetNum(NumAssets);
+		TArray<UObject*> ImportedObjects;
+		ImportedObjects.Init(nullptr, NumAssets);
+		{
+			FScopedTransaction Transaction(FText::FromString(TEXT("Batch Import Assets")));
+			UMCP_T3DFallbackFactory::SetCallEditChange(false);
+			ON_SCOPE_EXIT
+			{
+				UMCP_T3DFallbackFactory::SetCallEditChange(true);
+			};
+
+			TArray<UObject*> CreatedObjects;
+			const bool bCancelled = Context.IsCancelRequested();
+			for (int32 Index = 0; Index < NumAssets; ++Index)
+			{
+				FUMCP_BatchImportAssetEntry& Entry = Result.results[Index];
+				Entry.packagePath = Params.assets[Index].packagePath;
+				if (bCancelled)
+				{
+					Entry.error = TEXT("Cancelled before the import started");
+					Result.skippedCount++;
+					continue;
+				}
+
+				FPreparedImport Import;
+				FUMCP_ImportAssetResult ImportResult;
+				UObject* ImportedObject = PrepareImport(Params.assets[Index], Import, ImportResult) ? RunImport(Import, ImportResult) : nullptr;
+				if (!ImportedObject)
+				{
+					Entry.error = ImportResult.error;
+					Result.failedCount++;
+					UE_LOG(LogUnrealMCPServer, Warning, TEXT("BatchImportAssets: Failed to import '%s': %s"), *Entry.packagePath, *Entry.error);
+					continue;
+				}
+				Entry.packagePath = Import.FullObjectPath;
+				Entry.bSuccess = true;
+				Entry.importedObject = ImportedObject->GetPathName();
+				ImportedObjects[Index] = ImportedObject;
+				if (!Import.bAssetExists)
+				{
+					CreatedObjects.AddUnique(ImportedObject);
+				}
+				Result.importedCount++;
+			}
+
+			// The notifications the imports held back, once per asset however many entries touched it
+			TSet<UObject*> NotifiedObjects;
+			for (UObject* ImportedObject : ImportedObjects)
+			{
+				bool bAlreadyNotified = false;
+				NotifiedObjects.Add(ImportedObject, &bAlreadyNotified);
+				if (ImportedObject && !bAlreadyNotified)
+				{
+					ImportedObject->PostEditChange();
+				}
+			}
+			for (UObject* CreatedObject : CreatedObjects)
+			{
+				FAssetRegistryModule::AssetCreated(CreatedObject);
+			}
+		}
+
+		if (Params.bSave && Result.importedCount > 0)
+		{
+			TArray<FPackageSaveInfo> SaveInfos;
+			TMap<UPackage*, int32> SaveIndices;
+			TArray<int32> EntrySaveIndices;
+			EntrySaveIndices.Init(INDEX_NONE, NumAssets);
+			for (int32 Index = 0; Index < NumAssets; ++Index)
+			{
+				UObject* ImportedObject = ImportedObjects[Index];
+				if (!ImportedObject)
+				{
+					continue;
+				}
+				UPackage* Package = ImportedObject->GetOutermost();
+				if (const int32* SaveIndex = SaveIndices.Find(Package))
+				{
+					EntrySaveIndices[Index] = *SaveIndex;
+					continue;
+				}
+				const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), Package->ContainsMap() ? FPackageName::GetMapPackageExtension() : FPackageName::GetAssetPackageExtension());
+				if (IFileManager::Get().IsReadOnly(*Filename))
+				{
+					Result.results[Index].error = FString::Printf(TEXT("Imported, but %s is read-only and was not saved"), *Filename);
+					continue;
+				}
+				FPackageSaveInfo& SaveInfo = SaveInfos.AddDefaulted_GetRef();
+				SaveInfo.Package = Package;
+				SaveInfo.Asset = ImportedObject;
+				SaveInfo.Filename = Filename;
+				EntrySaveIndices[Index] = SaveIndices.Add(Package, SaveInfos.Num() - 1);
+			}
+
+			TArray<bool> Saved;
+			SaveImportedPackages(SaveInfos, Saved);
+			for (int32 Index = 0; Index < NumAssets; ++Index)
+			{
+				FUMCP_BatchImportAssetEntry& Entry = Result.results[Index];
+				if (EntrySaveIndices[Index] == INDEX_NONE)
+				{
+					continue;
+				}
+				Entry.bSaved = Saved[EntrySaveIndices[Index]];
+				if (Entry.bSaved)
+				{
+					Result.savedCount++;
+				}
+				else
+				{
+					Entry.error = FString::Printf(TEXT("Imported, but %s failed to save"), *SaveInfos[EntrySaveIndices[Index]].Filename);
+				}
+			}
+		}
+
+		// Overall success if at least one asset was imported
+		Result.bSuccess = Result.importedCount > 0;
+		const int32 NumUnsaved = Params.bSave ? Result.importedCount - Result.savedCount : 0;
+		if (Result.skippedCount > 0)
+		{
+			Result.error = FString::Printf(TEXT("Cancelled before the batch started: none of the %d assets were imported"), NumAssets);
+		}
+		else if (Result.failedCount > 0 || NumUnsaved > 0)
+		{
+			Result.error = FString::Printf(TEXT("%d imported, %d failed, %d imported but not saved"), Result.importedCount, Result.failedCount, NumUnsaved);
+		}
+		Context.ReportProgress(NumAssets, NumAssets);
+
+		auto& Content = OutResult.content.Add_GetRef(FUMCP_CallToolResultContent());
+		Content.type = TEXT("text");
+		if (!UMCP_SetStructuredContent(Result, Content))
+		{
+			Content.text = TEXT("Failed to serialize result");
+			OutResult.isError = true;
+			return EUMCP_JobStepResult::Finished;
+		}
+		OutResult.isError = !Result.bSuccess;
+		UE_LOG(LogUnrealMCPServer, Log, TEXT("BatchImportAssets: Imported %d of %d assets, %d failed, %d saved"), Result.importedCount, NumAssets, Result.failedCount, Result.savedCount);
+		return EUMCP_JobStepResult::Finished;
+	};
+	return true;
+}
+
 bool FUMCP_AssetTools::QueryAsset(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent)
 {
 	auto& Content = OutContent.Add_GetRef(FUMCP_CallToolResultContent());
@@ -1398,9 +2156,8 @@ bool FUMCP_AssetTools::QueryAsset(TSharedPtr<FJsonObject> arguments, TArray<FUMC
 
 	UE_LOG(LogUnrealMCPServer, Log, TEXT("QueryAsset: Path=%s, IncludeTags=%s"), *Params.assetPath, Params.bIncludeTags ? TEXT("true") : TEXT("false"));
 
-	// Get Asset Registry
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+	// Get Asset Registry (registry singleton rather than the module manager, since this tool runs off the game thread)
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
 
 	// Use FSoftObjectPath to get asset (non-deprecated API)
 	FSoftObjectPath SoftPath(Params.assetPath);
@@ -1435,7 +2192,7 @@ bool FUMCP_AssetTools::QueryAsset(TSharedPtr<FJsonObject> arguments, TArray<FUMC
 	}
 
 	// Convert USTRUCT to JSON string at the end
-	if (!UMCP_ToJsonString(Result, Content.text))
+	if (!UMCP_SetStructuredContent(Result, Content))
 	{
 		Content.text = TEXT("Failed to serialize result");
 		return false;
@@ -1460,170 +2217,218 @@ bool FUMCP_AssetTools::SearchAssets(TSharedPtr<FJsonObject> arguments, TArray<FU
 	}
 
 	// Work with USTRUCT throughout
-	// At least one of packagePaths or packageNames must be provided
-	if (Params.packagePaths.Num() == 0 && Params.packageNames.Num() == 0)
+	// Follow-up pages read the snapshot the first page left behind instead of querying the registry again
+	FUMCP_AssetSearchSnapshots& Snapshots = Server->GetAssetSearchSnapshots();
+	TSharedPtr<const FUMCP_AssetSearchSnapshot> Snapshot;
+	TArray<FAssetData> AssetDataList;
+	uint32 RegistryGeneration = 0;
+	int32 StartIndex = FMath::Max(0, Params.offset);
+	if (!Params.cursor.IsEmpty())
 	{
-		Content.text = TEXT("Missing required parameter: Either packagePaths or packageNames must be provided (at least one must be a non-empty array)");
-		return false;
+		FString CursorError;
+		Snapshot = Snapshots.FindSnapshot(TEXT("search_assets"), Params.cursor, StartIndex, CursorError);
+		if (!Snapshot)
+		{
+			Content.text = CursorError;
+			return false;
+		}
+		UE_LOG(LogUnrealMCPServer, Log, TEXT("SearchAssets: Reading snapshot %u at offset %d, maxResults=%d"), Snapshot->Id, StartIndex, Params.maxResults);
 	}
-
-	// Parse class paths (optional) - convert from string array to FTopLevelAssetPath
-	TArray<FTopLevelAssetPath> ClassPaths;
-	for (const FString& ClassPathStr : Params.classPaths)
+	else
 	{
-		FTopLevelAssetPath ResolvedPath = ResolveClassPath(ClassPathStr);
-		if (ResolvedPath.IsValid())
+		// At least one of packagePaths or packageNames must be provided
+		if (Params.packagePaths.Num() == 0 && Params.packageNames.Num() == 0)
 		{
-			ClassPaths.Add(ResolvedPath);
+			Content.text = TEXT("Missing required parameter: Either packagePaths or packageNames must be provided (at least one must be a non-empty array)");
+			return false;
 		}
-		else
+
+		// Parse class paths (optional) - convert from string array to FTopLevelAssetPath
+		TArray<FTopLevelAssetPath> ClassPaths;
+		for (const FString& ClassPathStr : Params.classPaths)
 		{
-			UE_LOG(LogUnrealMCPServer, Warning, TEXT("SearchAssets: Could not resolve class path: %s"), *ClassPathStr);
+			FTopLevelAssetPath ResolvedPath = ResolveClassPath(ClassPathStr);
+			if (ResolvedPath.IsValid())
+			{
+				ClassPaths.Add(ResolvedPath);
+			}
+			else
+			{
+				UE_LOG(LogUnrealMCPServer, Warning, TEXT("SearchAssets: Could not resolve class path: %s"), *ClassPathStr);
+			}
 		}
-	}
 
-	UE_LOG(LogUnrealMCPServer, Log, TEXT("SearchAssets: PackagePaths=%d, PackageNames=%d, ClassPaths=%d, Recursive=%s, IncludeTags=%s, MaxResults=%d, Offset=%d"), 
-		Params.packagePaths.Num(), Params.packageNames.Num(), ClassPaths.Num(), Params.bRecursive ? TEXT("true") : TEXT("false"), Params.bIncludeTags ? TEXT("true") : TEXT("false"), Params.maxResults, Params.offset);
+		UE_LOG(LogUnrealMCPServer, Log, TEXT("SearchAssets: PackagePaths=%d, PackageNames=%d, ClassPaths=%d, Recursive=%s, IncludeTags=%s, MaxResults=%d, Offset=%d"), 
+			Params.packagePaths.Num(), Params.packageNames.Num(), ClassPaths.Num(), Params.bRecursive ? TEXT("true") : TEXT("false"), Params.bIncludeTags ? TEXT("true") : TEXT("false"), Params.maxResults, Params.offset);
 
-	// Get Asset Registry
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+		// Get Asset Registry (registry singleton rather than the module manager, since this tool runs off the game thread)
+		IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+		// Separate package names into exact matches and partial matches
+		TArray<FString> ExactPackageNames;
+		TArray<FString> PartialPackageNamePatterns;
+		
+		for (const FString& PackageNameStr : Params.packageNames)
+		{
+			if (IsPartialPackageName(PackageNameStr))
+			{
+				PartialPackageNamePatterns.Add(PackageNameStr);
+				UE_LOG(LogUnrealMCPServer, Log, TEXT("SearchAssets: Detected partial package name pattern: %s"), *PackageNameStr);
+			}
+			else
+			{
+				ExactPackageNames.Add(PackageNameStr);
+			}
+		}
+
+		// Build filter
+		FARFilter Filter;
+		
+		// Add package paths from USTRUCT
+		for (const FString& PackagePathStr : Params.packagePaths)
+		{
+			Filter.PackagePaths.Add(FName(*PackagePathStr));
+		}
+		Filter.bRecursivePaths = Params.bRecursive;
+		
+		// Add only exact package names to filter (partial matches will be post-filtered)
+		for (const FString& PackageNameStr : ExactPackageNames)
+		{
+			Filter.PackageNames.Add(FName(*PackageNameStr));
+		}
+		
+		// Add class paths if specified
+		if (ClassPaths.Num() > 0)
+		{
+			Filter.ClassPaths = ClassPaths;
+			Filter.bRecursiveClasses = true;
+		}
+		
+		// Once the name index is built, partial patterns resolve to the packages that match them, so the registry query
+		// becomes a lookup of those packages and needs no scope. Exact package names still narrow the result.
+		RegistryGeneration = Snapshots.GetRegistryGeneration();
+		bool bResolvedPartialNames = false;
+		if (PartialPackageNamePatterns.Num() > 0)
+		{
+			const FUMCP_AssetNameIndex& NameIndex = Server->GetAssetNameIndex();
+			TSet<FName> MatchingPackageNames;
+			bResolvedPartialNames = true;
+			for (const FString& Pattern : PartialPackageNamePatterns)
+			{
+				if (!NameIndex.FindPackages(FUMCP_AssetNameIndex::EField::PackageName, Pattern, MatchingPackageNames))
+				{
+					bResolvedPartialNames = false;
+					break;
+				}
+			}
+			if (bResolvedPartialNames)
+			{
+				if (ExactPackageNames.Num() > 0)
+				{
+					MatchingPackageNames = MatchingPackageNames.Intersect(TSet<FName>(Filter.PackageNames));
+				}
+				Filter.PackageNames = MatchingPackageNames.Array();
+				UE_LOG(LogUnrealMCPServer, Log, TEXT("SearchAssets: Name index matched %d packages for %d partial patterns"), Filter.PackageNames.Num(), PartialPackageNamePatterns.Num());
+			}
+		}
 
-	// Separate package names into exact matches and partial matches
-	TArray<FString> ExactPackageNames;
-	TArray<FString> PartialPackageNamePatterns;
-	
-	for (const FString& PackageNameStr : Params.packageNames)
-	{
-		if (IsPartialPackageName(PackageNameStr))
+		// Until then, partial package name patterns are checked against every asset the query returns, which
+		// requires packagePaths or classPaths to avoid a full asset registry scan
+		if (PartialPackageNamePatterns.Num() > 0 && !bResolvedPartialNames && Filter.PackagePaths.Num() == 0 && ClassPaths.Num() == 0 && ExactPackageNames.Num() == 0)
 		{
-			PartialPackageNamePatterns.Add(PackageNameStr);
-			UE_LOG(LogUnrealMCPServer, Log, TEXT("SearchAssets: Detected partial package name pattern: %s"), *PackageNameStr);
+			Content.text = TEXT("Error: Partial package name searches require either packagePaths or classPaths to define the search scope while the asset name index is still being built. This prevents expensive full asset registry searches. Please provide at least one package path or class filter, or retry shortly.");
+			UE_LOG(LogUnrealMCPServer, Warning, TEXT("SearchAssets: Blocked partial package name search without package paths or class filters"));
+			return false;
 		}
-		else
+
+		// Perform asset search; an empty package list would match everything, so no match means no query
+		if (!bResolvedPartialNames || Filter.PackageNames.Num() > 0)
 		{
-			ExactPackageNames.Add(PackageNameStr);
+			UMCP_TRACE_SCOPE(UMCP_AssetRegistryGetAssets);
+			AssetRegistry.GetAssets(Filter, AssetDataList);
 		}
-	}
-
-	// Build filter
-	FARFilter Filter;
-	
-	// Add package paths from USTRUCT
-	for (const FString& PackagePathStr : Params.packagePaths)
-	{
-		Filter.PackagePaths.Add(FName(*PackagePathStr));
-	}
-	Filter.bRecursivePaths = Params.bRecursive;
-	
-	// Add only exact package names to filter (partial matches will be post-filtered)
-	for (const FString& PackageNameStr : ExactPackageNames)
-	{
-		Filter.PackageNames.Add(FName(*PackageNameStr));
-	}
-	
-	// Add class paths if specified
-	if (ClassPaths.Num() > 0)
-	{
-		Filter.ClassPaths = ClassPaths;
-		Filter.bRecursiveClasses = true;
-	}
-	
-	// If we have partial package name patterns but no package paths or class filters,
-	// we need to require at least one to avoid expensive full asset registry searches.
-	// Partial package name searches require a search scope to filter from.
-	if (PartialPackageNamePatterns.Num() > 0 && Filter.PackagePaths.Num() == 0 && ClassPaths.Num() == 0 && ExactPackageNames.Num() == 0)
-	{
-		Content.text = TEXT("Error: Partial package name searches require either packagePaths or classPaths to define the search scope. This prevents expensive full asset registry searches. Please provide at least one package path or class filter when using partial package name patterns.");
-		UE_LOG(LogUnrealMCPServer, Warning, TEXT("SearchAssets: Blocked partial package name search without package paths or class filters"));
-		return false;
-	}
-
-	// Perform asset search
-	TArray<FAssetData> AssetDataList;
-	AssetRegistry.GetAssets(Filter, AssetDataList);
 
-	UE_LOG(LogUnrealMCPServer, Log, TEXT("SearchAssets: Found %d assets before partial name filtering"), AssetDataList.Num());
-	
-	// Post-filter results for partial package name patterns
-	if (PartialPackageNamePatterns.Num() > 0)
-	{
-		TArray<FAssetData> FilteredAssetDataList;
+		UE_LOG(LogUnrealMCPServer, Log, TEXT("SearchAssets: Found %d assets before partial name filtering"), AssetDataList.Num());
 		
-		for (const FAssetData& AssetData : AssetDataList)
+		// Post-filter results for partial package name patterns the name index couldn't resolve
+		if (PartialPackageNamePatterns.Num() > 0 && !bResolvedPartialNames)
 		{
-			// Get the full package name (package path + asset name)
-			FString FullPackageName = AssetData.PackageName.ToString();
+			TArray<FAssetData> FilteredAssetDataList;
 			
-			// Check if this asset matches any of the partial patterns
-			bool bMatchesAnyPattern = false;
-			for (const FString& Pattern : PartialPackageNamePatterns)
+			for (const FAssetData& AssetData : AssetDataList)
 			{
-				if (MatchesPackageNamePattern(FullPackageName, Pattern))
+				// Get the full package name (package path + asset name)
+				FString FullPackageName = AssetData.PackageName.ToString();
+				
+				// Check if this asset matches any of the partial patterns
+				bool bMatchesAnyPattern = false;
+				for (const FString& Pattern : PartialPackageNamePatterns)
 				{
-					bMatchesAnyPattern = true;
-					break;
+					if (MatchesPackageNamePattern(FullPackageName, Pattern))
+					{
+						bMatchesAnyPattern = true;
+						break;
+					}
+				}
+				
+				if (bMatchesAnyPattern)
+				{
+					FilteredAssetDataList.Add(AssetData);
 				}
 			}
 			
-			if (bMatchesAnyPattern)
-			{
-				FilteredAssetDataList.Add(AssetData);
-			}
+			AssetDataList = MoveTemp(FilteredAssetDataList);
+			UE_LOG(LogUnrealMCPServer, Log, TEXT("SearchAssets: Found %d assets after partial name filtering"), AssetDataList.Num());
 		}
-		
-		AssetDataList = MoveTemp(FilteredAssetDataList);
-		UE_LOG(LogUnrealMCPServer, Log, TEXT("SearchAssets: Found %d assets after partial name filtering"), AssetDataList.Num());
 	}
+	const TArray<FAssetData>& Assets = Snapshot ? Snapshot->Assets : AssetDataList;
 
 	// Apply paging: calculate total count before limiting
-	int32 TotalCount = AssetDataList.Num();
-	int32 StartIndex = FMath::Max(0, Params.offset);
-	int32 EndIndex = AssetDataList.Num();
+	const int32 TotalCount = Assets.Num();
+	StartIndex = FMath::Min(StartIndex, TotalCount);
+	int32 EndIndex = TotalCount;
 	
 	// Apply maxResults limit if specified
 	if (Params.maxResults > 0)
 	{
-		EndIndex = FMath::Min(StartIndex + Params.maxResults, AssetDataList.Num());
-	}
-	
-	// Extract the page of results
-	TArray<FAssetData> PagedAssetDataList;
-	if (StartIndex < AssetDataList.Num())
-	{
-		for (int32 i = StartIndex; i < EndIndex; ++i)
-		{
-			PagedAssetDataList.Add(AssetDataList[i]);
-		}
+		EndIndex = FMath::Min(StartIndex + Params.maxResults, TotalCount);
 	}
 	
 	UE_LOG(LogUnrealMCPServer, Log, TEXT("SearchAssets: Returning %d assets (offset=%d, maxResults=%d, total=%d)"), 
-		PagedAssetDataList.Num(), Params.offset, Params.maxResults, TotalCount);
+		EndIndex - StartIndex, StartIndex, Params.maxResults, TotalCount);
 
 	// Build results - output has complex nested structure, so we build JSON manually
 	// but we've used USTRUCT for all input processing
 	TSharedPtr<FJsonObject> ResultsJson = MakeShareable(new FJsonObject);
 	TArray<TSharedPtr<FJsonValue>> AssetsArray;
+	AssetsArray.Reserve(EndIndex - StartIndex);
 
-	for (const FAssetData& AssetData : PagedAssetDataList)
+	for (int32 Index = StartIndex; Index < EndIndex; ++Index)
 	{
 		TSharedPtr<FJsonObject> AssetJson = MakeShareable(new FJsonObject);
-		AssetDataToJson(AssetData, AssetJson, Params.bIncludeTags);
+		AssetDataToJson(Assets[Index], AssetJson, Params.bIncludeTags);
 		AssetsArray.Add(MakeShareable(new FJsonValueObject(AssetJson)));
 	}
 
 	ResultsJson->SetArrayField(TEXT("assets"), AssetsArray);
 	ResultsJson->SetNumberField(TEXT("count"), AssetsArray.Num());
 	ResultsJson->SetNumberField(TEXT("totalCount"), TotalCount);
-	ResultsJson->SetNumberField(TEXT("offset"), Params.offset);
+	ResultsJson->SetNumberField(TEXT("offset"), StartIndex);
 	ResultsJson->SetBoolField(TEXT("hasMore"), EndIndex < TotalCount);
+	if (EndIndex < TotalCount)
+	{
+		// The first page hands its filtered results to a snapshot; offset paging keeps working without one
+		const FString NextCursor = Snapshot
+			? FUMCP_AssetSearchSnapshots::MakeCursor(*Snapshot, EndIndex)
+			: Snapshots.CreateSnapshot(TEXT("search_assets"), arguments, RegistryGeneration, MoveTemp(AssetDataList), EndIndex);
+		if (!NextCursor.IsEmpty())
+		{
+			ResultsJson->SetStringField(TEXT("nextCursor"), NextCursor);
+		}
+	}
 
-	// Convert to JSON string
-	FString ResultJsonString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJsonString);
-	FJsonSerializer::Serialize(ResultsJson.ToSharedRef(), Writer);
-
-	Content.text = ResultJsonString;
+	// The server serializes this once for both the text content and structuredContent
+	Content.structuredContent = ResultsJson;
 	
 	UE_LOG(LogUnrealMCPServer, Log, TEXT("SearchAssets: Completed search, found %d assets"), AssetsArray.Num());
 	
@@ -1653,9 +2458,8 @@ bool FUMCP_AssetTools::GetAssetDependencies(TSharedPtr<FJsonObject> arguments, T
 		*Params.assetPath, Params.bIncludeHardDependencies ? TEXT("true") : TEXT("false"), 
 		Params.bIncludeSoftDependencies ? TEXT("true") : TEXT("false"));
 
-	// Get Asset Registry
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+	// Get Asset Registry (registry singleton rather than the module manager, since this tool runs off the game thread)
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
 
 	// Use FSoftObjectPath to get asset
 	FSoftObjectPath SoftPath(Params.assetPath);
@@ -1670,7 +2474,7 @@ bool FUMCP_AssetTools::GetAssetDependencies(TSharedPtr<FJsonObject> arguments, T
 	if (!AssetData.IsValid())
 	{
 		Result.error = FString::Printf(TEXT("Asset not found: %s"), *Params.assetPath);
-		if (!UMCP_ToJsonString(Result, Content.text))
+		if (!UMCP_SetStructuredContent(Result, Content))
 		{
 			Content.text = TEXT("Failed to serialize error result");
 		}
@@ -1684,7 +2488,7 @@ bool FUMCP_AssetTools::GetAssetDependencies(TSharedPtr<FJsonObject> arguments, T
 		// Neither hard nor soft dependencies requested - return empty result
 		Result.count = 0;
 		Result.bSuccess = true;
-		if (!UMCP_ToJsonString(Result, Content.text))
+		if (!UMCP_SetStructuredContent(Result, Content))
 		{
 			Content.text = TEXT("Failed to serialize result");
 		}
@@ -1709,7 +2513,10 @@ bool FUMCP_AssetTools::GetAssetDependencies(TSharedPtr<FJsonObject> arguments, T
 	// Get dependencies
 	TArray<FAssetIdentifier> Dependencies;
 	UE::AssetRegistry::FDependencyQuery DependencyQuery(DependencyQueryEnum);
-	AssetRegistry.GetDependencies(FAssetIdentifier(AssetData.PackageName), Dependencies, UE::AssetRegistry::EDependencyCategory::Package, DependencyQuery);
+	{
+		UMCP_TRACE_SCOPE(UMCP_AssetRegistryGetDependencies);
+		AssetRegistry.GetDependencies(FAssetIdentifier(AssetData.PackageName), Dependencies, UE::AssetRegistry::EDependencyCategory::Package, DependencyQuery);
+	}
 
 	// Convert to string array
 	Result.dependencies.Empty();
@@ -1733,7 +2540,7 @@ bool FUMCP_AssetTools::GetAssetDependencies(TSharedPtr<FJsonObject> arguments, T
 	Result.bSuccess = true;
 
 	// Convert USTRUCT to JSON string at the end
-	if (!UMCP_ToJsonString(Result, Content.text))
+	if (!UMCP_SetStructuredContent(Result, Content))
 	{
 		Content.text = TEXT("Failed to serialize result");
 		return false;
@@ -1768,9 +2575,8 @@ bool FUMCP_AssetTools::GetAssetReferences(TSharedPtr<FJsonObject> arguments, TAr
 		*Params.assetPath, Params.bIncludeHardReferences ? TEXT("true") : TEXT("false"), 
 		Params.bIncludeSoftReferences ? TEXT("true") : TEXT("false"));
 
-	// Get Asset Registry
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+	// Get Asset Registry (registry singleton rather than the module manager, since this tool runs off the game thread)
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
 
 	// Use FSoftObjectPath to get asset
 	FSoftObjectPath SoftPath(Params.assetPath);
@@ -1785,7 +2591,7 @@ bool FUMCP_AssetTools::GetAssetReferences(TSharedPtr<FJsonObject> arguments, TAr
 	if (!AssetData.IsValid())
 	{
 		Result.error = FString::Printf(TEXT("Asset not found: %s"), *Params.assetPath);
-		if (!UMCP_ToJsonString(Result, Content.text))
+		if (!UMCP_SetStructuredContent(Result, Content))
 		{
 			Content.text = TEXT("Failed to serialize error result");
 		}
@@ -1799,7 +2605,7 @@ bool FUMCP_AssetTools::GetAssetReferences(TSharedPtr<FJsonObject> arguments, TAr
 		// Neither hard nor soft references requested - return empty result
 		Result.count = 0;
 		Result.bSuccess = true;
-		if (!UMCP_ToJsonString(Result, Content.text))
+		if (!UMCP_SetStructuredContent(Result, Content))
 		{
 			Content.text = TEXT("Failed to serialize result");
 		}
@@ -1824,7 +2630,10 @@ bool FUMCP_AssetTools::GetAssetReferences(TSharedPtr<FJsonObject> arguments, TAr
 	// Get referencers (assets that reference this asset)
 	TArray<FAssetIdentifier> Referencers;
 	UE::AssetRegistry::FDependencyQuery DependencyQuery(DependencyQueryEnum);
-	AssetRegistry.GetReferencers(FAssetIdentifier(AssetData.PackageName), Referencers, UE::AssetRegistry::EDependencyCategory::Package, DependencyQuery);
+	{
+		UMCP_TRACE_SCOPE(UMCP_AssetRegistryGetReferencers);
+		AssetRegistry.GetReferencers(FAssetIdentifier(AssetData.PackageName), Referencers, UE::AssetRegistry::EDependencyCategory::Package, DependencyQuery);
+	}
 
 	// Convert to string array
 	Result.references.Empty();
@@ -1848,7 +2657,7 @@ bool FUMCP_AssetTools::GetAssetReferences(TSharedPtr<FJsonObject> arguments, TAr
 	Result.bSuccess = true;
 
 	// Convert USTRUCT to JSON string at the end
-	if (!UMCP_ToJsonString(Result, Content.text))
+	if (!UMCP_SetStructuredContent(Result, Content))
 	{
 		Content.text = TEXT("Failed to serialize result");
 		return false;
@@ -1885,13 +2694,20 @@ bool FUMCP_AssetTools::GetAssetDependencyTree(TSharedPtr<FJsonObject> arguments,
 		return false;
 	}
 
-	UE_LOG(LogUnrealMCPServer, Log, TEXT("GetAssetDependencyTree: Path=%s, MaxDepth=%d, Hard=%s, Soft=%s"), 
+	const bool bDag = Params.outputMode.Equals(TEXT("dag"), ESearchCase::IgnoreCase);
+	if (!bDag && !Params.outputMode.IsEmpty() && !Params.outputMode.Equals(TEXT("tree"), ESearchCase::IgnoreCase))
+	{
+		Content.text = FString::Printf(TEXT("Unknown outputMode '%s'. Use 'tree' or 'dag'."), *Params.outputMode);
+		return false;
+	}
+	const int32 MaxNodes = Params.maxNodes > 0 ? Params.maxNodes : MAX_int32;
+
+	UE_LOG(LogUnrealMCPServer, Log, TEXT("GetAssetDependencyTree: Path=%s, MaxDepth=%d, Hard=%s, Soft=%s, Mode=%s, MaxNodes=%d"), 
 		*Params.assetPath, Params.maxDepth, Params.bIncludeHardDependencies ? TEXT("true") : TEXT("false"), 
-		Params.bIncludeSoftDependencies ? TEXT("true") : TEXT("false"));
+		Params.bIncludeSoftDependencies ? TEXT("true") : TEXT("false"), bDag ? TEXT("dag") : TEXT("tree"), Params.maxNodes);
 
-	// Get Asset Registry
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+	// Get Asset Registry (registry singleton rather than the module manager, since this tool runs off the game thread)
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
 
 	// Use FSoftObjectPath to get asset
 	FSoftObjectPath SoftPath(Params.assetPath);
@@ -1907,7 +2723,7 @@ bool FUMCP_AssetTools::GetAssetDependencyTree(TSharedPtr<FJsonObject> arguments,
 	if (!AssetData.IsValid())
 	{
 		Result.error = FString::Printf(TEXT("Asset not found: %s"), *Params.assetPath);
-		if (!UMCP_ToJsonString(Result, Content.text))
+		if (!UMCP_SetStructuredContent(Result, Content))
 		{
 			Content.text = TEXT("Failed to serialize error result");
 		}
@@ -1922,12 +2738,20 @@ bool FUMCP_AssetTools::GetAssetDependencyTree(TSharedPtr<FJsonObject> arguments,
 		Result.bSuccess = true;
 		Result.totalNodes = 1; // Just the root node
 		Result.maxDepthReached = 0;
-		FUMCP_AssetDependencyNode RootNode;
-		RootNode.assetPath = Params.assetPath;
-		RootNode.depth = 0;
-		RootNode.dependencies.Empty();
-		Result.tree.Add(RootNode);
-		if (!UMCP_ToJsonString(Result, Content.text))
+		if (bDag)
+		{
+			FUMCP_AssetDependencyDagNode& RootNode = Result.nodes.AddDefaulted_GetRef();
+			RootNode.assetPath = Params.assetPath;
+		}
+		else
+		{
+			FUMCP_AssetDependencyNode RootNode;
+			RootNode.assetPath = Params.assetPath;
+			RootNode.depth = 0;
+			RootNode.dependencies.Empty();
+			Result.tree.Add(RootNode);
+		}
+		if (!UMCP_SetStructuredContent(Result, Content))
 		{
 			Content.text = TEXT("Failed to serialize result");
 		}
@@ -1949,101 +2773,145 @@ bool FUMCP_AssetTools::GetAssetDependencyTree(TSharedPtr<FJsonObject> arguments,
 		DependencyQueryEnum = UE::AssetRegistry::EDependencyQuery::Soft;
 	}
 
-	// Recursive function to build dependency tree
-	TSet<FName> VisitedPackages; // Track visited packages to prevent cycles
+	// Each package's dependencies and asset path are looked up once, however many paths reach it
+	TMap<FName, TArray<FName>> PackageDependencies;
 	TMap<FName, FString> PackageToAssetPath; // Cache package name to asset path mapping
 	UE::AssetRegistry::FDependencyQuery DependencyQuery(DependencyQueryEnum);
 
-	// Use TFunction to allow recursive lambda
-	TFunction<void(const FAssetIdentifier&, int32, FUMCP_AssetDependencyNode&)> BuildDependencyTreeRecursive;
-	BuildDependencyTreeRecursive = [&](const FAssetIdentifier& AssetId, int32 CurrentDepth, FUMCP_AssetDependencyNode& OutNode) -> void
+	auto GetPackageDependencies = [&](FName PackageName) -> TArray<FName>
 	{
-		if (CurrentDepth > Params.maxDepth)
+		if (const TArray<FName>* CachedDependencies = PackageDependencies.Find(PackageName))
 		{
-			return;
+			return *CachedDependencies;
 		}
-
-		// Get asset path for this node
-		FString AssetPathStr;
-		if (PackageToAssetPath.Contains(AssetId.PackageName))
+		TArray<FAssetIdentifier> Dependencies;
 		{
-			AssetPathStr = PackageToAssetPath[AssetId.PackageName];
+			UMCP_TRACE_SCOPE(UMCP_AssetRegistryGetDependencies);
+			AssetRegistry.GetDependencies(FAssetIdentifier(PackageName), Dependencies, UE::AssetRegistry::EDependencyCategory::Package, DependencyQuery);
 		}
-		else
+		TArray<FName>& DependencyPackages = PackageDependencies.Add(PackageName);
+		DependencyPackages.Reserve(Dependencies.Num());
+		for (const FAssetIdentifier& Dep : Dependencies)
 		{
-			TArray<FAssetData> NodeAssetDataArray;
-			AssetRegistry.GetAssetsByPackageName(AssetId.PackageName, NodeAssetDataArray);
-			if (NodeAssetDataArray.Num() > 0 && NodeAssetDataArray[0].IsValid())
-			{
-				AssetPathStr = NodeAssetDataArray[0].GetSoftObjectPath().ToString();
-				PackageToAssetPath.Add(AssetId.PackageName, AssetPathStr);
-			}
-			else
-			{
-				AssetPathStr = AssetId.PackageName.ToString();
-			}
+			DependencyPackages.Add(Dep.PackageName);
 		}
+		return DependencyPackages;
+	};
 
-		OutNode.assetPath = AssetPathStr;
-		OutNode.depth = CurrentDepth;
-		OutNode.dependencies.Empty();
-
-		// Mark as visited to prevent cycles
-		VisitedPackages.Add(AssetId.PackageName);
-
-		// Get dependencies for this asset
-		TArray<FAssetIdentifier> Dependencies;
-		AssetRegistry.GetDependencies(AssetId, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, DependencyQuery);
+	auto GetAssetPath = [&](FName PackageName) -> FString
+	{
+		if (const FString* CachedAssetPath = PackageToAssetPath.Find(PackageName))
+		{
+			return *CachedAssetPath;
+		}
+		TArray<FAssetData> NodeAssetDataArray;
+		AssetRegistry.GetAssetsByPackageName(PackageName, NodeAssetDataArray);
+		// If we can't get asset data, use package name as fallback
+		const FString AssetPathStr = NodeAssetDataArray.Num() > 0 && NodeAssetDataArray[0].IsValid() ? NodeAssetDataArray[0].GetSoftObjectPath().ToString() : PackageName.ToString();
+		PackageToAssetPath.Add(PackageName, AssetPathStr);
+		return AssetPathStr;
+	};
 
-		// Process each dependency
-		for (const FAssetIdentifier& Dep : Dependencies)
+	if (bDag)
+	{
+		// Breadth-first, so a package is first reached at its shortest depth. Nodes doubles as the queue.
+		TMap<FName, int32> NodeIndexByPackage;
+		TArray<FName> NodePackages;
+		NodeIndexByPackage.Add(AssetData.PackageName, 0);
+		NodePackages.Add(AssetData.PackageName);
+		Result.nodes.AddDefaulted();
+		for (int32 NodeIndex = 0; NodeIndex < Result.nodes.Num(); ++NodeIndex)
 		{
-			// Get asset path for dependency
-			FString DepAssetPathStr;
-			if (PackageToAssetPath.Contains(Dep.PackageName))
+			Result.nodes[NodeIndex].assetPath = GetAssetPath(NodePackages[NodeIndex]);
+			const int32 NodeDepth = Result.nodes[NodeIndex].depth;
+			const TArray<FName> Dependencies = GetPackageDependencies(NodePackages[NodeIndex]);
+			if (NodeDepth >= Params.maxDepth)
 			{
-				DepAssetPathStr = PackageToAssetPath[Dep.PackageName];
+				Result.nodes[NodeIndex].bDependenciesOmitted = Dependencies.Num() > 0;
+				continue;
 			}
-			else
+
+			for (FName DependencyPackage : Dependencies)
 			{
-				TArray<FAssetData> DepAssetDataArray;
-				AssetRegistry.GetAssetsByPackageName(Dep.PackageName, DepAssetDataArray);
-				if (DepAssetDataArray.Num() > 0 && DepAssetDataArray[0].IsValid())
+				int32 DependencyIndex = INDEX_NONE;
+				if (const int32* ExistingIndex = NodeIndexByPackage.Find(DependencyPackage))
+				{
+					DependencyIndex = *ExistingIndex;
+				}
+				else if (Result.nodes.Num() < MaxNodes)
 				{
-					DepAssetPathStr = DepAssetDataArray[0].GetSoftObjectPath().ToString();
-					PackageToAssetPath.Add(Dep.PackageName, DepAssetPathStr);
+					DependencyIndex = Result.nodes.Num();
+					NodeIndexByPackage.Add(DependencyPackage, DependencyIndex);
+					NodePackages.Add(DependencyPackage);
+					Result.nodes.AddDefaulted_GetRef().depth = NodeDepth + 1;
 				}
 				else
 				{
-					DepAssetPathStr = Dep.PackageName.ToString();
+					Result.nodes[NodeIndex].bDependenciesOmitted = true;
+					Result.bTruncated = true;
+					continue;
 				}
+				Result.nodes[NodeIndex].dependencies.Add(DependencyIndex);
+			}
+		}
+	}
+	else
+	{
+		TSet<FName> VisitedPackages; // Packages on the current path, to prevent cycles
+		int32 NumTreeNodes = 1; // Nodes are added to the tree after their children, so they are counted when started
+
+		// Use TFunction to allow recursive lambda
+		TFunction<void(FName, int32, FUMCP_AssetDependencyNode&)> BuildDependencyTreeRecursive;
+		BuildDependencyTreeRecursive = [&](FName PackageName, int32 CurrentDepth, FUMCP_AssetDependencyNode& OutNode) -> void
+		{
+			if (CurrentDepth > Params.maxDepth)
+			{
+				return;
 			}
 
-			OutNode.dependencies.Add(DepAssetPathStr);
+			OutNode.assetPath = GetAssetPath(PackageName);
+			OutNode.depth = CurrentDepth;
+			OutNode.dependencies.Empty();
 
-			// Recursively process dependency if not visited and within depth limit
-			if (!VisitedPackages.Contains(Dep.PackageName) && CurrentDepth < Params.maxDepth)
+			// Mark as visited to prevent cycles
+			VisitedPackages.Add(PackageName);
+
+			// Process each dependency
+			const TArray<FName> Dependencies = GetPackageDependencies(PackageName);
+			for (FName DependencyPackage : Dependencies)
 			{
-				FUMCP_AssetDependencyNode ChildNode;
-				BuildDependencyTreeRecursive(Dep, CurrentDepth + 1, ChildNode);
-				if (!ChildNode.assetPath.IsEmpty())
+				OutNode.dependencies.Add(GetAssetPath(DependencyPackage));
+
+				// Recursively process dependency if not visited and within depth limit
+				if (!VisitedPackages.Contains(DependencyPackage) && CurrentDepth < Params.maxDepth)
 				{
-					Result.tree.Add(ChildNode);
+					if (NumTreeNodes >= MaxNodes)
+					{
+						Result.bTruncated = true;
+						continue;
+					}
+					NumTreeNodes++;
+					FUMCP_AssetDependencyNode ChildNode;
+					BuildDependencyTreeRecursive(DependencyPackage, CurrentDepth + 1, ChildNode);
+					if (!ChildNode.assetPath.IsEmpty())
+					{
+						Result.tree.Add(MoveTemp(ChildNode));
+					}
 				}
 			}
-		}
 
-		// Unmark as visited (allow it to appear in different branches)
-		VisitedPackages.Remove(AssetId.PackageName);
-	};
+			// Unmark as visited (allow it to appear in different branches)
+			VisitedPackages.Remove(PackageName);
+		};
 
-	// Build tree starting from root asset
-	FUMCP_AssetDependencyNode RootNode;
-	BuildDependencyTreeRecursive(FAssetIdentifier(AssetData.PackageName), 0, RootNode);
-	Result.tree.Insert(RootNode, 0); // Insert root at beginning
+		// Build tree starting from root asset
+		FUMCP_AssetDependencyNode RootNode;
+		BuildDependencyTreeRecursive(AssetData.PackageName, 0, RootNode);
+		Result.tree.Insert(MoveTemp(RootNode), 0); // Insert root at beginning
+	}
 
 	// Calculate statistics
-	Result.totalNodes = Result.tree.Num();
+	Result.totalNodes = bDag ? Result.nodes.Num() : Result.tree.Num();
 	for (const FUMCP_AssetDependencyNode& Node : Result.tree)
 	{
 		if (Node.depth > Result.maxDepthReached)
@@ -2051,11 +2919,16 @@ bool FUMCP_AssetTools::GetAssetDependencyTree(TSharedPtr<FJsonObject> arguments,
 			Result.maxDepthReached = Node.depth;
 		}
 	}
+	if (bDag && Result.nodes.Num() > 0)
+	{
+		// Breadth-first order puts the deepest node last
+		Result.maxDepthReached = Result.nodes.Last().depth;
+	}
 
 	Result.bSuccess = true;
 
 	// Convert USTRUCT to JSON string at the end
-	if (!UMCP_ToJsonString(Result, Content.text))
+	if (!UMCP_SetStructuredContent(Result, Content))
 	{
 		Content.text = TEXT("Failed to serialize result");
 		return false;
@@ -2067,3 +2940,242 @@ bool FUMCP_AssetTools::GetAssetDependencyTree(TSharedPtr<FJsonObject> arguments,
 	return true;
 }
 
+
+bool FUMCP_AssetTools::BatchQueryAssets(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent)
+{
+	auto& Content = OutContent.Add_GetRef(FUMCP_CallToolResultContent());
+	Content.type = TEXT("text");
+
+	// Convert JSON to USTRUCT at the start
+	FUMCP_BatchQueryAssetsParams Params;
+	if (!arguments.IsValid() || !UMCP_CreateFromJsonObject(arguments, Params))
+	{
+		Content.text = TEXT("Invalid parameters");
+		return false;
+	}
+
+	if (Params.assetPaths.Num() == 0)
+	{
+		Content.text = TEXT("Missing required parameter: assetPaths");
+		return false;
+	}
+
+	UE_LOG(LogUnrealMCPServer, Log, TEXT("BatchQueryAssets: Paths=%d, IncludeTags=%s"), Params.assetPaths.Num(), Params.bIncludeTags ? TEXT("true") : TEXT("false"));
+
+	// Get Asset Registry (registry singleton rather than the module manager, since this tool runs off the game thread)
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	TArray<FAssetData> Assets;
+	ResolveBatchAssetPaths(AssetRegistry, Params.assetPaths, Assets);
+
+	// Work with USTRUCT throughout
+	FUMCP_BatchQueryAssetsResult Result;
+	const int32 NumRows = Params.assetPaths.Num();
+	Result.assetPaths = MoveTemp(Params.assetPaths);
+	Result.exists.SetNumZeroed(NumRows);
+	Result.assetName.SetNum(NumRows);
+	Result.packagePath.SetNum(NumRows);
+	Result.classPath.SetNum(NumRows);
+	Result.objectPath.SetNum(NumRows);
+	if (Params.bIncludeTags)
+	{
+		Result.tags.SetNum(NumRows);
+	}
+
+	for (int32 Row = 0; Row < NumRows; ++Row)
+	{
+		const FAssetData& AssetData = Assets[Row];
+		if (!AssetData.IsValid())
+		{
+			continue;
+		}
+
+		Result.exists[Row] = true;
+		Result.assetName[Row] = AssetData.AssetName.ToString();
+		Result.packagePath[Row] = AssetData.PackagePath.ToString();
+		Result.classPath[Row] = AssetData.AssetClassPath.ToString();
+		Result.objectPath[Row] = AssetData.GetObjectPathString();
+		if (Params.bIncludeTags)
+		{
+			for (const auto& TagPair : AssetData.TagsAndValues)
+			{
+				Result.tags[Row].values.Add(TagPair.Key.ToString(), TagPair.Value.GetValue());
+			}
+		}
+		++Result.count;
+	}
+
+	// Convert USTRUCT to JSON string at the end
+	if (!UMCP_SetStructuredContent(Result, Content))
+	{
+		Content.text = TEXT("Failed to serialize result");
+		return false;
+	}
+
+	UE_LOG(LogUnrealMCPServer, Log, TEXT("BatchQueryAssets: Completed query for %d paths, %d exist"), NumRows, Result.count);
+
+	return true;
+}
+
+bool FUMCP_AssetTools::BatchGetAssetDependencies(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent)
+{
+	auto& Content = OutContent.Add_GetRef(FUMCP_CallToolResultContent());
+	Content.type = TEXT("text");
+
+	// Convert JSON to USTRUCT at the start
+	FUMCP_BatchGetAssetDependenciesParams Params;
+	if (!arguments.IsValid() || !UMCP_CreateFromJsonObject(arguments, Params))
+	{
+		Content.text = TEXT("Invalid parameters");
+		return false;
+	}
+
+	if (Params.assetPaths.Num() == 0)
+	{
+		Content.text = TEXT("Missing required parameter: assetPaths");
+		return false;
+	}
+
+	UE_LOG(LogUnrealMCPServer, Log, TEXT("BatchGetAssetDependencies: Paths=%d, Hard=%s, Soft=%s"),
+		Params.assetPaths.Num(), Params.bIncludeHardDependencies ? TEXT("true") : TEXT("false"),
+		Params.bIncludeSoftDependencies ? TEXT("true") : TEXT("false"));
+
+	// Get Asset Registry (registry singleton rather than the module manager, since this tool runs off the game thread)
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	FUMCP_BatchAssetLinksResult Result;
+	FillBatchAssetLinks(AssetRegistry, Params.assetPaths, false, Params.bIncludeHardDependencies, Params.bIncludeSoftDependencies, Result);
+
+	// Convert USTRUCT to JSON string at the end
+	if (!UMCP_SetStructuredContent(Result, Content))
+	{
+		Content.text = TEXT("Failed to serialize result");
+		return false;
+	}
+
+	UE_LOG(LogUnrealMCPServer, Log, TEXT("BatchGetAssetDependencies: Completed for %d paths, found %d dependencies on %d distinct assets"),
+		Result.assetPaths.Num(), Result.count, Result.paths.Num());
+
+	return true;
+}
+
+bool FUMCP_AssetTools::BatchGetAssetReferences(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent)
+{
+	auto& Content = OutContent.Add_GetRef(FUMCP_CallToolResultContent());
+	Content.type = TEXT("text");
+
+	// Convert JSON to USTRUCT at the start
+	FUMCP_BatchGetAssetReferencesParams Params;
+	if (!arguments.IsValid() || !UMCP_CreateFromJsonObject(arguments, Params))
+	{
+		Content.text = TEXT("Invalid parameters");
+		return false;
+	}
+
+	if (Params.assetPaths.Num() == 0)
+	{
+		Content.text = TEXT("Missing required parameter: assetPaths");
+		return false;
+	}
+
+	UE_LOG(LogUnrealMCPServer, Log, TEXT("BatchGetAssetReferences: Paths=%d, Hard=%s, Soft=%s"),
+		Params.assetPaths.Num(), Params.bIncludeHardReferences ? TEXT("true") : TEXT("false"),
+		Params.bIncludeSoftReferences ? TEXT("true") : TEXT("false"));
+
+	// Get Asset Registry (registry singleton rather than the module manager, since this tool runs off the game thread)
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	FUMCP_BatchAssetLinksResult Result;
+	FillBatchAssetLinks(AssetRegistry, Params.assetPaths, true, Params.bIncludeHardReferences, Params.bIncludeSoftReferences, Result);
+
+	// Convert USTRUCT to JSON string at the end
+	if (!UMCP_SetStructuredContent(Result, Content))
+	{
+		Content.text = TEXT("Failed to serialize result");
+		return false;
+	}
+
+	UE_LOG(LogUnrealMCPServer, Log, TEXT("BatchGetAssetReferences: Completed for %d paths, found %d references from %d distinct assets"),
+		Result.assetPaths.Num(), Result.count, Result.paths.Num());
+
+	return true;
+}
+
+bool FUMCP_AssetTools::ExportDependencyGraph(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent)
+{
+	auto& Content = OutContent.Add_GetRef(FUMCP_CallToolResultContent());
+	Content.type = TEXT("text");
+
+	// Convert JSON to USTRUCT at the start
+	FUMCP_ExportDependencyGraphParams Params;
+	if (!arguments.IsValid() || !UMCP_CreateFromJsonObject(arguments, Params))
+	{
+		Content.text = TEXT("Invalid parameters");
+		return false;
+	}
+
+	UE_LOG(LogUnrealMCPServer, Log, TEXT("ExportDependencyGraph: SinceGeneration=%lld"), Params.sinceGeneration);
+
+	FUMCP_DependencyGraph& DependencyGraph = Server->GetDependencyGraph();
+	FString Error;
+	TSharedPtr<const FUMCP_DependencyGraphSnapshot> Snapshot = DependencyGraph.GetSnapshot(Error);
+	if (!Snapshot.IsValid())
+	{
+		Content.text = Error;
+		return false;
+	}
+
+	// Work with USTRUCT throughout
+	FUMCP_ExportDependencyGraphResult Result;
+	Result.generation = Snapshot->Generation;
+	Result.packageCount = Snapshot->Packages.Num();
+	Result.edgeCount = Snapshot->Targets.Num();
+
+	TArray<FName> ChangedPackageNames;
+	if (Params.sinceGeneration > 0 && DependencyGraph.GetChangedPackages(Params.sinceGeneration, ChangedPackageNames))
+	{
+		Result.bDelta = true;
+		ChangedPackageNames.Sort(FNameLexicalLess());
+		for (const FName PackageName : ChangedPackageNames)
+		{
+			const int32* Node = Snapshot->PackageIndices.Find(PackageName);
+			if (!Node || (Snapshot->NodeFlags[*Node] & FUMCP_DependencyGraphSnapshot::Node_HasAssets) == 0)
+			{
+				Result.removedPackages.Add(PackageName.ToString());
+				continue;
+			}
+			FUMCP_DependencyGraphPackage& Package = Result.changedPackages.AddDefaulted_GetRef();
+			Package.packageName = PackageName.ToString();
+			for (int32 Edge = Snapshot->Offsets[*Node]; Edge < Snapshot->Offsets[*Node + 1]; ++Edge)
+			{
+				Package.dependencies.Add(Snapshot->Packages[Snapshot->Targets[Edge]].ToString());
+				Package.edgeFlags.Add(Snapshot->EdgeFlags[Edge]);
+			}
+		}
+	}
+	else if (!DependencyGraph.SaveSnapshot(*Snapshot, Result.filePath, Result.fileBytes, Error))
+	{
+		Content.text = Error;
+		return false;
+	}
+
+	// Convert USTRUCT to JSON string at the end
+	if (!UMCP_SetStructuredContent(Result, Content))
+	{
+		Content.text = TEXT("Failed to serialize result");
+		return false;
+	}
+
+	if (Result.bDelta)
+	{
+		UE_LOG(LogUnrealMCPServer, Log, TEXT("ExportDependencyGraph: Generation %lld, %d changed and %d removed packages since %lld"),
+			Result.generation, Result.changedPackages.Num(), Result.removedPackages.Num(), Params.sinceGeneration);
+	}
+	else
+	{
+		UE_LOG(LogUnrealMCPServer, Log, TEXT("ExportDependencyGraph: Generation %lld, %d packages and %d edges in %s (%lld bytes)"),
+			Result.generation, Result.packageCount, Result.edgeCount, *Result.filePath, Result.fileBytes);
+	}
+
+	return true;
+}
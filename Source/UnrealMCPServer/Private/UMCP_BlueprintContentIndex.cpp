@@ -0,0 +1,537 @@
+#include "UMCP_BlueprintContentIndex.h"
+#include "UMCP_Trace.h"
+#include "UnrealMCPServerModule.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/Async.h"
+#include "EdGraph/EdGraph.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_CustomEvent.h"
+#include "K2Node_Event.h"
+#include "K2Node_Variable.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+
+// Index file layout, written with FArchive:
+//   char[8]  Magic "UMCPBPCI"
+//   uint32   Version (1)
+//   int32    NumEntries
+//   Per entry: FString PackageName, FString SavedHash, int32 NumItems,
+//     then per item: uint8 Kind, uint8 bReference, FString Name, FString Graph
+namespace
+{
+	const ANSICHAR ContentIndexMagic[8] = { 'U', 'M', 'C', 'P', 'B', 'P', 'C', 'I' };
+	const uint32 ContentIndexVersion = 1;
+
+	using FContentItem = FUMCP_BlueprintContentIndex::FItem;
+	using EContentKind = FUMCP_BlueprintContentIndex::EKind;
+
+	// Empty if the AssetRegistry doesn't know the package's saved hash (yet), which always is the case before 5.1
+	FString GetPackageSavedHash(IAssetRegistry& AssetRegistry, FName PackageName)
+	{
+#if (ENGINE_MAJOR_VERSION >= (5) && ENGINE_MINOR_VERSION >= (1))
+		TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+		if (PackageData.IsSet() && !PackageData->GetPackageSavedHash().IsZero())
+		{
+			return LexToString(PackageData->GetPackageSavedHash());
+		}
+#endif
+		return FString();
+	}
+
+	void CollectBlueprintItems(UBlueprint& Blueprint, TArray<FContentItem>& OutItems)
+	{
+		TSet<FContentItem> Items;
+		auto AddItem = [&Items](EContentKind Kind, bool bReference, FString&& Name, const FString& Graph)
+		{
+			if (!Name.IsEmpty() && Name != TEXT("None"))
+			{
+				FContentItem Item;
+				Item.Kind = Kind;
+				Item.bReference = bReference;
+				Item.Name = MoveTemp(Name);
+				Item.Graph = Graph;
+				Items.Add(MoveTemp(Item));
+			}
+		};
+
+		for (const UEdGraph* FunctionGraph : Blueprint.FunctionGraphs)
+		{
+			if (FunctionGraph)
+			{
+				AddItem(EContentKind::Function, false, FunctionGraph->GetName(), FString());
+			}
+		}
+		for (const FBPVariableDescription& Variable : Blueprint.NewVariables)
+		{
+			AddItem(EContentKind::Variable, false, Variable.VarName.ToString(), FString());
+		}
+		for (const FBPInterfaceDescription& Interface : Blueprint.ImplementedInterfaces)
+		{
+			if (Interface.Interface)
+			{
+				AddItem(EContentKind::Interface, false, Interface.Interface->GetName(), FString());
+			}
+		}
+
+		TArray<UEdGraph*> Graphs;
+		Blueprint.GetAllGraphs(Graphs);
+		for (const UEdGraph* Graph : Graphs)
+		{
+			if (!Graph)
+			{
+				continue;
+			}
+			const FString GraphName = Graph->GetName();
+			for (const UEdGraphNode* Node : Graph->Nodes)
+			{
+				if (!Node)
+				{
+					continue;
+				}
+				AddItem(EContentKind::NodeClass, false, Node->GetClass()->GetName(), GraphName);
+				if (const UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node))
+				{
+					AddItem(EContentKind::Function, true, CallNode->FunctionReference.GetMemberName().ToString(), GraphName);
+				}
+				else if (const UK2Node_Variable* VariableNode = Cast<UK2Node_Variable>(Node))
+				{
+					AddItem(EContentKind::Variable, true, VariableNode->VariableReference.GetMemberName().ToString(), GraphName);
+				}
+				else if (const UK2Node_CustomEvent* CustomEventNode = Cast<UK2Node_CustomEvent>(Node))
+				{
+					AddItem(EContentKind::Event, false, CustomEventNode->CustomFunctionName.ToString(), GraphName);
+				}
+				else if (const UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
+				{
+					AddItem(EContentKind::Event, false, EventNode->EventReference.GetMemberName().ToString(), GraphName);
+				}
+			}
+		}
+		OutItems = Items.Array();
+	}
+}
+
+FUMCP_BlueprintContentIndex::~FUMCP_BlueprintContentIndex()
+{
+	Shutdown();
+}
+
+void FUMCP_BlueprintContentIndex::Initialize()
+{
+	Shutdown();
+	FilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealMCPServer"), TEXT("BlueprintContentIndex.bin"));
+
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(this, &FUMCP_BlueprintContentIndex::OnPackageSaved);
+	AssetLoadedHandle = FCoreUObjectDelegates::OnAssetLoaded.AddRaw(this, &FUMCP_BlueprintContentIndex::OnAssetLoaded);
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FUMCP_BlueprintContentIndex::OnAssetRemoved);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FUMCP_BlueprintContentIndex::OnAssetRenamed);
+	AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddRaw(this, &FUMCP_BlueprintContentIndex::OnAssetUpdated);
+
+	// The saved entries are checked against the package hashes, which are only complete once the scan is done
+	bCancelLoad = false;
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		FilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddRaw(this, &FUMCP_BlueprintContentIndex::Load);
+	}
+	else
+	{
+		Load();
+	}
+}
+
+void FUMCP_BlueprintContentIndex::Shutdown()
+{
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+	FCoreUObjectDelegates::OnAssetLoaded.Remove(AssetLoadedHandle);
+	PackageSavedHandle.Reset();
+	AssetLoadedHandle.Reset();
+	// The AssetRegistry may already be gone during editor shutdown
+	if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+	{
+		AssetRegistry->OnFilesLoaded().Remove(FilesLoadedHandle);
+		AssetRegistry->OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry->OnAssetRenamed().Remove(AssetRenamedHandle);
+		AssetRegistry->OnAssetUpdated().Remove(AssetUpdatedHandle);
+	}
+	FilesLoadedHandle.Reset();
+	AssetRemovedHandle.Reset();
+	AssetRenamedHandle.Reset();
+	AssetUpdatedHandle.Reset();
+
+	bCancelLoad = true;
+	if (LoadFuture.IsValid())
+	{
+		LoadFuture.Wait();
+		LoadFuture.Reset();
+	}
+	Save();
+
+	FWriteScopeLock WriteLock(Lock);
+	Entries.Empty();
+	for (TMap<FString, TSet<FName>>& Names : NamePackages)
+	{
+		Names.Empty();
+	}
+	NumItems = 0;
+	bDirty = false;
+	bLoaded = false;
+}
+
+void FUMCP_BlueprintContentIndex::AddBlueprint(UBlueprint* Blueprint)
+{
+	if (!Blueprint)
+	{
+		return;
+	}
+	// Unsaved edits aren't what the saved hash describes; the save that follows indexes them
+	UPackage* Package = Blueprint->GetOutermost();
+	if (Package->IsDirty())
+	{
+		return;
+	}
+	IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+	IndexBlueprint(Blueprint, AssetRegistry ? GetPackageSavedHash(*AssetRegistry, Package->GetFName()) : FString());
+}
+
+void FUMCP_BlueprintContentIndex::IndexBlueprint(UBlueprint* Blueprint, FString&& SavedHash)
+{
+	UMCP_TRACE_SCOPE(UMCP_IndexBlueprintContent);
+	FEntry Entry;
+	Entry.SavedHash = MoveTemp(SavedHash);
+	CollectBlueprintItems(*Blueprint, Entry.Items);
+
+	FWriteScopeLock WriteLock(Lock);
+	SetEntryLocked(Blueprint->GetOutermost()->GetFName(), MoveTemp(Entry));
+}
+
+bool FUMCP_BlueprintContentIndex::IsIndexed(FName PackageName) const
+{
+	FReadScopeLock ReadLock(Lock);
+	return Entries.Contains(PackageName);
+}
+
+void FUMCP_BlueprintContentIndex::FindPackages(EKind Kind, const FString& Term, TSet<FName>& OutPackageNames) const
+{
+	UMCP_TRACE_SCOPE(UMCP_BlueprintContentIndexFind);
+	const FString LowerTerm = Term.ToLower();
+
+	// Names repeat across Blueprints (every graph calls PrintString), so there are far fewer of them to check than items
+	FReadScopeLock ReadLock(Lock);
+	for (const TPair<FString, TSet<FName>>& Pair : NamePackages[static_cast<int32>(Kind)])
+	{
+		if (Pair.Key.Contains(LowerTerm, ESearchCase::CaseSensitive))
+		{
+			OutPackageNames.Append(Pair.Value);
+		}
+	}
+}
+
+void FUMCP_BlueprintContentIndex::GetItems(FName PackageName, EKind Kind, const FString& Term, TArray<FItem>& OutItems) const
+{
+	FReadScopeLock ReadLock(Lock);
+	if (const FEntry* Entry = Entries.Find(PackageName))
+	{
+		for (const FItem& Item : Entry->Items)
+		{
+			if (Item.Kind == Kind && Item.Name.Contains(Term))
+			{
+				OutItems.Add(Item);
+			}
+		}
+	}
+}
+
+bool FUMCP_BlueprintContentIndex::Save()
+{
+	UMCP_TRACE_SCOPE(UMCP_SaveBlueprintContentIndex);
+	TArray<uint8> Buffer;
+	int32 NumSavedEntries = 0;
+	{
+		FWriteScopeLock WriteLock(Lock);
+		// Writing before the last session's entries were read back would lose them
+		if (!bDirty || !bLoaded || FilePath.IsEmpty())
+		{
+			return true;
+		}
+
+		IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+		FMemoryWriter Writer(Buffer);
+		Writer.Serialize(const_cast<ANSICHAR*>(ContentIndexMagic), sizeof(ContentIndexMagic));
+		uint32 Version = ContentIndexVersion;
+		Writer << Version;
+		const int64 NumEntriesOffset = Writer.Tell();
+		Writer << NumSavedEntries;
+		for (TPair<FName, FEntry>& Pair : Entries)
+		{
+			// Entries made by a save get their hash once the AssetRegistry has rescanned the package
+			FEntry& Entry = Pair.Value;
+			if (Entry.SavedHash.IsEmpty() && AssetRegistry)
+			{
+				Entry.SavedHash = GetPackageSavedHash(*AssetRegistry, Pair.Key);
+			}
+			if (Entry.SavedHash.IsEmpty())
+			{
+				// Could never be checked against the package, so it is only kept for this session
+				continue;
+			}
+
+			FString PackageName = Pair.Key.ToString();
+			int32 NumEntryItems = Entry.Items.Num();
+			Writer << PackageName << Entry.SavedHash << NumEntryItems;
+			for (FItem& Item : Entry.Items)
+			{
+				uint8 Kind = static_cast<uint8>(Item.Kind);
+				uint8 bReference = Item.bReference ? 1 : 0;
+				Writer << Kind << bReference << Item.Name << Item.Graph;
+			}
+			++NumSavedEntries;
+		}
+		Writer.Seek(NumEntriesOffset);
+		Writer << NumSavedEntries;
+		bDirty = false;
+	}
+
+	// Written under a temporary name first so a crash halfway through leaves the previous index intact
+	const FString TempPath = FilePath + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(Buffer, *TempPath) || !IFileManager::Get().Move(*FilePath, *TempPath, true))
+	{
+		IFileManager::Get().Delete(*TempPath);
+		UE_LOG(LogUnrealMCPServer, Warning, TEXT("FUMCP_BlueprintContentIndex: Failed to write %s"), *FilePath);
+		FWriteScopeLock WriteLock(Lock);
+		bDirty = true;
+		return false;
+	}
+	UE_LOG(LogUnrealMCPServer, Log, TEXT("FUMCP_BlueprintContentIndex: Wrote %d Blueprints to %s"), NumSavedEntries, *FilePath);
+	return true;
+}
+
+void FUMCP_BlueprintContentIndex::Load()
+{
+	IAssetRegistry::GetChecked().OnFilesLoaded().Remove(FilesLoadedHandle);
+	FilesLoadedHandle.Reset();
+
+	LoadFuture = Async(EAsyncExecution::ThreadPool, [this]()
+	{
+		UMCP_TRACE_SCOPE(UMCP_LoadBlueprintContentIndex);
+		const double StartTime = FPlatformTime::Seconds();
+		TArray<TPair<FName, FEntry>> LoadedEntries;
+		int32 NumStaleEntries = 0;
+		TArray<uint8> FileData;
+		if (FFileHelper::LoadFileToArray(FileData, *FilePath, FILEREAD_Silent))
+		{
+			FMemoryReader Reader(FileData);
+			ANSICHAR Magic[8] = {};
+			uint32 Version = 0;
+			int32 NumEntries = 0;
+			Reader.Serialize(Magic, sizeof(Magic));
+			Reader << Version << NumEntries;
+			if (Reader.IsError() || FMemory::Memcmp(Magic, ContentIndexMagic, sizeof(Magic)) != 0 || Version != ContentIndexVersion)
+			{
+				UE_LOG(LogUnrealMCPServer, Warning, TEXT("FUMCP_BlueprintContentIndex: Ignoring %s, it was written by another version"), *FilePath);
+				NumEntries = 0;
+			}
+
+			IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+			for (int32 EntryIndex = 0; EntryIndex < NumEntries && !Reader.IsError(); ++EntryIndex)
+			{
+				if (bCancelLoad)
+				{
+					return;
+				}
+				FString PackageName;
+				FEntry Entry;
+				int32 NumEntryItems = 0;
+				Reader << PackageName << Entry.SavedHash << NumEntryItems;
+				for (int32 ItemIndex = 0; ItemIndex < NumEntryItems && !Reader.IsError(); ++ItemIndex)
+				{
+					FItem& Item = Entry.Items.AddDefaulted_GetRef();
+					uint8 Kind = 0;
+					uint8 bReference = 0;
+					Reader << Kind << bReference << Item.Name << Item.Graph;
+					if (Kind >= static_cast<uint8>(EKind::Num))
+					{
+						Reader.SetError();
+					}
+					Item.Kind = static_cast<EKind>(Kind);
+					Item.bReference = bReference != 0;
+				}
+
+				// Packages that were saved, changed by a sync or deleted since are left to be indexed again
+				const FName PackageFName(*PackageName);
+				if (GetPackageSavedHash(AssetRegistry, PackageFName) == Entry.SavedHash)
+				{
+					LoadedEntries.Emplace(PackageFName, MoveTemp(Entry));
+				}
+				else
+				{
+					++NumStaleEntries;
+				}
+			}
+			if (Reader.IsError())
+			{
+				UE_LOG(LogUnrealMCPServer, Warning, TEXT("FUMCP_BlueprintContentIndex: Ignoring %s, it is corrupt"), *FilePath);
+				LoadedEntries.Empty();
+				++NumStaleEntries;
+			}
+		}
+
+		FWriteScopeLock WriteLock(Lock);
+		if (bCancelLoad)
+		{
+			return;
+		}
+		// Blueprints indexed while the file was read are newer than what it holds
+		const bool bChangedSinceStart = bDirty;
+		for (TPair<FName, FEntry>& Pair : LoadedEntries)
+		{
+			if (!Entries.Contains(Pair.Key))
+			{
+				SetEntryLocked(Pair.Key, MoveTemp(Pair.Value));
+			}
+		}
+		bDirty = bChangedSinceStart || NumStaleEntries > 0;
+		bLoaded = true;
+		UE_LOG(LogUnrealMCPServer, Log, TEXT("FUMCP_BlueprintContentIndex: Read %d Blueprints in %.2f s (%d out of date)"), LoadedEntries.Num(), FPlatformTime::Seconds() - StartTime, NumStaleEntries);
+	});
+}
+
+FUMCP_BlueprintContentIndexStats FUMCP_BlueprintContentIndex::GetStats() const
+{
+	FReadScopeLock ReadLock(Lock);
+	FUMCP_BlueprintContentIndexStats Stats;
+	Stats.bLoaded = bLoaded;
+	Stats.NumBlueprints = Entries.Num();
+	Stats.NumItems = NumItems;
+	Stats.MemoryBytes = Entries.GetAllocatedSize();
+	for (const TPair<FName, FEntry>& Pair : Entries)
+	{
+		Stats.MemoryBytes += Pair.Value.SavedHash.GetAllocatedSize() + Pair.Value.Items.GetAllocatedSize();
+		for (const FItem& Item : Pair.Value.Items)
+		{
+			Stats.MemoryBytes += Item.Name.GetAllocatedSize() + Item.Graph.GetAllocatedSize();
+		}
+	}
+	for (const TMap<FString, TSet<FName>>& Names : NamePackages)
+	{
+		Stats.NumNames += Names.Num();
+		Stats.MemoryBytes += Names.GetAllocatedSize();
+		for (const TPair<FString, TSet<FName>>& Pair : Names)
+		{
+			Stats.MemoryBytes += Pair.Key.GetAllocatedSize() + Pair.Value.GetAllocatedSize();
+		}
+	}
+	return Stats;
+}
+
+void FUMCP_BlueprintContentIndex::SetEntryLocked(FName PackageName, FEntry&& Entry)
+{
+	RemoveEntryLocked(PackageName);
+	for (const FItem& Item : Entry.Items)
+	{
+		NamePackages[static_cast<int32>(Item.Kind)].FindOrAdd(Item.Name.ToLower()).Add(PackageName);
+	}
+	NumItems += Entry.Items.Num();
+	Entries.Add(PackageName, MoveTemp(Entry));
+	bDirty = true;
+}
+
+void FUMCP_BlueprintContentIndex::RemoveEntryLocked(FName PackageName)
+{
+	FEntry Entry;
+	if (!Entries.RemoveAndCopyValue(PackageName, Entry))
+	{
+		return;
+	}
+	for (const FItem& Item : Entry.Items)
+	{
+		TMap<FString, TSet<FName>>& Names = NamePackages[static_cast<int32>(Item.Kind)];
+		const FString LowerName = Item.Name.ToLower();
+		if (TSet<FName>* PackageNames = Names.Find(LowerName))
+		{
+			PackageNames->Remove(PackageName);
+			if (PackageNames->Num() == 0)
+			{
+				Names.Remove(LowerName);
+			}
+		}
+	}
+	NumItems -= Entry.Items.Num();
+	bDirty = true;
+}
+
+void FUMCP_BlueprintContentIndex::OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext SaveContext)
+{
+	// Cooks and autosaves write somewhere else and leave the package file as it was
+	if (!Package || SaveContext.IsProceduralSave() || !SaveContext.IsUpdatingLoadedPath())
+	{
+		return;
+	}
+	UBlueprint* Blueprint = nullptr;
+	ForEachObjectWithPackage(Package, [&Blueprint](UObject* Object)
+	{
+		Blueprint = Cast<UBlueprint>(Object);
+		return Blueprint == nullptr;
+	}, false);
+	if (Blueprint)
+	{
+		// The AssetRegistry hasn't necessarily seen the new file yet; OnAssetUpdated or Save fill the hash in
+		IndexBlueprint(Blueprint, FString());
+	}
+}
+
+void FUMCP_BlueprintContentIndex::OnAssetLoaded(UObject* Object)
+{
+	UBlueprint* Blueprint = Cast<UBlueprint>(Object);
+	if (Blueprint && !IsIndexed(Blueprint->GetOutermost()->GetFName()))
+	{
+		AddBlueprint(Blueprint);
+	}
+}
+
+void FUMCP_BlueprintContentIndex::OnAssetRemoved(const FAssetData& AssetData)
+{
+	FWriteScopeLock WriteLock(Lock);
+	RemoveEntryLocked(AssetData.PackageName);
+}
+
+void FUMCP_BlueprintContentIndex::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	// The new package is indexed when it is saved, which the rename is followed by
+	FWriteScopeLock WriteLock(Lock);
+	RemoveEntryLocked(FName(*FPackageName::ObjectPathToPackageName(OldObjectPath)));
+}
+
+void FUMCP_BlueprintContentIndex::OnAssetUpdated(const FAssetData& AssetData)
+{
+	IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+	if (!AssetRegistry || !IsIndexed(AssetData.PackageName))
+	{
+		return;
+	}
+	const FString SavedHash = GetPackageSavedHash(*AssetRegistry, AssetData.PackageName);
+	FWriteScopeLock WriteLock(Lock);
+	FEntry* Entry = Entries.Find(AssetData.PackageName);
+	if (!Entry || SavedHash.IsEmpty())
+	{
+		return;
+	}
+	if (Entry->SavedHash.IsEmpty())
+	{
+		// The rescan after a save that made the entry
+		Entry->SavedHash = SavedHash;
+		bDirty = true;
+	}
+	else if (Entry->SavedHash != SavedHash)
+	{
+		// Changed on disk without being saved by this editor
+		RemoveEntryLocked(AssetData.PackageName);
+	}
+}
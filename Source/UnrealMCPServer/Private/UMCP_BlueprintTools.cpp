@@ -1,8 +1,11 @@
 #include "UMCP_BlueprintTools.h"
 #include "UMCP_Server.h"
 #include "UMCP_Types.h"
+#include "UMCP_Trace.h"
+#include "UMCP_ToolProgress.h"
 #include "UnrealMCPServerModule.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
 #include "Engine/Blueprint.h"
 #include "K2Node.h"
 #include "UObject/UObjectGlobals.h"
@@ -14,28 +17,64 @@
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonSerializer.h"
 
-void FUMCP_BlueprintTools::Register(class FUMCP_Server* Server)
+namespace
 {
+	// Search types of search_blueprints answered by FUMCP_BlueprintContentIndex, and how their matches are described
+	struct FUMCP_ContentSearchType
+	{
+		const TCHAR* SearchType;
+		FUMCP_BlueprintContentIndex::EKind Kind;
+		const TCHAR* MatchType;
+		const TCHAR* ReferenceMatchType;
+		const TCHAR* Label;
+		const TCHAR* ReferenceLabel;
+	};
+
+	const FUMCP_ContentSearchType ContentSearchTypes[] = {
+		{ TEXT("function"), FUMCP_BlueprintContentIndex::EKind::Function, TEXT("function"), TEXT("function_call"), TEXT("Function"), TEXT("Function call") },
+		{ TEXT("variable"), FUMCP_BlueprintContentIndex::EKind::Variable, TEXT("variable"), TEXT("variable_reference"), TEXT("Variable"), TEXT("Variable reference") },
+		{ TEXT("event"), FUMCP_BlueprintContentIndex::EKind::Event, TEXT("event"), TEXT("event"), TEXT("Event"), TEXT("Event") },
+		{ TEXT("node_class"), FUMCP_BlueprintContentIndex::EKind::NodeClass, TEXT("node_class"), TEXT("node_class"), TEXT("Node class"), TEXT("Node class") },
+		{ TEXT("interface"), FUMCP_BlueprintContentIndex::EKind::Interface, TEXT("interface"), TEXT("interface"), TEXT("Interface"), TEXT("Interface") },
+	};
+
+	struct FUMCP_IndexBlueprintsState
+	{
+		FUMCP_IndexBlueprintsParams Params;
+		bool bListed = false;
+		TArray<FSoftObjectPath> ObjectPaths; // Blueprints in scope that aren't indexed yet
+		TArray<int32> LoadRequestIds; // Of FUMCP_PackageLoader
+		int32 NextIndex = 0;
+		int32 NextLoadIndex = 0;
+		FUMCP_IndexBlueprintsResult Result;
+	};
+}
+
+void FUMCP_BlueprintTools::Register(class FUMCP_Server* InServer)
+{
+	Server = InServer;
 	{
 		FUMCP_ToolDefinition Tool;
 		Tool.name = TEXT("search_blueprints");
-		Tool.description = TEXT("Search for Blueprint assets based on various criteria including name patterns, parent classes, and package paths. Returns array of Blueprint asset information including paths, names, parent classes, and match details. Use 'name' searchType to find Blueprints by name pattern (e.g., 'BP_Player*'), 'parent_class' to find Blueprints that inherit from a class (e.g., 'Actor', 'Pawn', 'Character'), or 'all' for comprehensive search across all criteria.");
+		Tool.description = TEXT("Search for Blueprint assets based on various criteria including name patterns, parent classes, and package paths. Returns array of Blueprint asset information including paths, names, parent classes, and match details. Use 'name' searchType to find Blueprints by name pattern (e.g., 'BP_Player*'), 'parent_class' to find Blueprints that inherit from a class (e.g., 'Actor', 'Pawn', 'Character'), 'function', 'variable', 'event', 'node_class' or 'interface' to find Blueprints by what their graphs contain, or 'all' for comprehensive search across all criteria. Graph content searches never load assets: they are answered from an index of Blueprints that were saved, loaded or indexed with index_blueprints, and report how many Blueprints in scope aren't indexed yet as unindexedCount. For large result sets, set maxResults and pass each page's nextCursor as cursor to get the next page.");
 		Tool.DoToolCall.BindRaw(this, &FUMCP_BlueprintTools::SearchBlueprints);
+		Tool.ExecutionAffinity = EUMCP_ExecutionAffinity::TaskGraph;
 		
 		// Generate input schema from USTRUCT with descriptions and enum
 		TMap<FString, FString> InputDescriptions;
-		InputDescriptions.Add(TEXT("searchType"), TEXT("Type of search to perform. 'name': Find Blueprints by name pattern (e.g., 'BP_Player*' finds all Blueprints starting with 'BP_Player'). 'parent_class': Find Blueprints that inherit from a class (e.g., 'Actor', 'Pawn', 'Character'). 'all': Comprehensive search across all criteria."));
-		InputDescriptions.Add(TEXT("searchTerm"), TEXT("Search term to match against. For 'name' type: Blueprint name pattern (e.g., 'BP_Player', 'Enemy'). For 'parent_class' type: Parent class name (e.g., 'Actor', 'Pawn', 'Character'). For 'all' type: Searches both name and parent class."));
+		InputDescriptions.Add(TEXT("searchType"), TEXT("Type of search to perform. 'name': Find Blueprints by name pattern (e.g., 'BP_Player*' finds all Blueprints starting with 'BP_Player'). 'parent_class': Find Blueprints that inherit from a class (e.g., 'Actor', 'Pawn', 'Character'). 'function': Find Blueprints that define or call a function (e.g., 'TakeDamage'). 'variable': Find Blueprints that declare or get/set a variable (e.g., 'Health'). 'event': Find Blueprints with an event or custom event node (e.g., 'ReceiveBeginPlay', 'OnDeath'). 'node_class': Find Blueprints using a graph node class (e.g., 'K2Node_Timeline'). 'interface': Find Blueprints implementing an interface (e.g., 'BPI_Interactable'). 'all': Comprehensive search across all criteria."));
+		InputDescriptions.Add(TEXT("searchTerm"), TEXT("Search term to match against. For 'name' type: Blueprint name pattern (e.g., 'BP_Player', 'Enemy'). For 'parent_class' type: Parent class name (e.g., 'Actor', 'Pawn', 'Character'). For the graph content types: part of the function, variable, event, node class or interface name, ignoring case. For 'all' type: Searches the name, parent class and graph content."));
 		InputDescriptions.Add(TEXT("packagePath"), TEXT("Optional package path to limit search scope. Examples: '/Game/Blueprints' searches in Blueprints folder, '/Game/Characters' searches in Characters folder. Uses Unreal's path format. If not specified, searches entire project."));
 		InputDescriptions.Add(TEXT("bRecursive"), TEXT("Whether to search recursively in subfolders. Defaults to true. Set to false to search only the specified packagePath directory without subdirectories."));
 		InputDescriptions.Add(TEXT("maxResults"), TEXT("Maximum number of results to return. Defaults to 0 (no limit). Use with offset for paging through large result sets. Recommended for large searches to limit response size."));
-		InputDescriptions.Add(TEXT("offset"), TEXT("Number of results to skip before returning results. Defaults to 0. Use with maxResults for paging: first page uses offset=0, second page uses offset=maxResults, etc."));
+		InputDescriptions.Add(TEXT("offset"), TEXT("Number of results to skip before returning results. Defaults to 0. Use with maxResults for paging: first page uses offset=0, second page uses offset=maxResults, etc. Prefer cursor for paging through large result sets."));
+		InputDescriptions.Add(TEXT("cursor"), TEXT("The nextCursor returned by the previous page. Pages through a server-side snapshot of the first page's matches, so later pages are cheap; the search criteria and offset of the first call are used when it is set, maxResults still applies. Cursors expire when unused for a while or when the asset registry changes; run the search again without a cursor then."));
 		TArray<FString> InputRequired;
 		InputRequired.Add(TEXT("searchType"));
 		InputRequired.Add(TEXT("searchTerm"));
 		TMap<FString, TArray<FString>> EnumValues;
-		EnumValues.Add(TEXT("searchType"), { TEXT("name"), TEXT("parent_class"), TEXT("all") });
-		Tool.inputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_SearchBlueprintsParams>(InputDescriptions, InputRequired, EnumValues);
+		EnumValues.Add(TEXT("searchType"), { TEXT("name"), TEXT("parent_class"), TEXT("function"), TEXT("variable"), TEXT("event"), TEXT("node_class"), TEXT("interface"), TEXT("all") });
+		Tool.InputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_SearchBlueprintsParams>(InputDescriptions, InputRequired, EnumValues);
 		
 		// Output schema is complex with nested objects, so we'll keep it as manual JSON for now
 		FString SearchOutputSchema = TEXT("{")
@@ -52,6 +91,8 @@ void FUMCP_BlueprintTools::Register(class FUMCP_Server* Server)
 			TEXT("\"totalCount\":{\"type\":\"number\",\"description\":\"Total number of matching results\"},")
 			TEXT("\"offset\":{\"type\":\"number\",\"description\":\"Offset used for this page\"},")
 			TEXT("\"hasMore\":{\"type\":\"boolean\",\"description\":\"Whether there are more results available\"},")
+			TEXT("\"nextCursor\":{\"type\":\"string\",\"description\":\"Pass as cursor to get the next page; absent on the last page\"},")
+			TEXT("\"unindexedCount\":{\"type\":\"number\",\"description\":\"Graph content searches only, first page only: Blueprints in scope whose content isn't indexed yet and so can't match; run index_blueprints to cover them\"},")
 			TEXT("\"searchCriteria\":{\"type\":\"object\",\"description\":\"The search criteria used\",\"properties\":{")
 			TEXT("\"searchType\":{\"type\":\"string\"},")
 			TEXT("\"searchTerm\":{\"type\":\"string\"},")
@@ -61,15 +102,38 @@ void FUMCP_BlueprintTools::Register(class FUMCP_Server* Server)
 			TEXT("}},")
 			TEXT("\"required\":[\"results\",\"totalResults\",\"totalCount\",\"offset\",\"hasMore\",\"searchCriteria\"]")
 			TEXT("}");
-		TSharedPtr<FJsonObject> ParsedSchema = UMCP_FromJsonStr(SearchOutputSchema);
-		if (ParsedSchema.IsValid())
-		{
-			Tool.outputSchema = ParsedSchema;
-		}
-		else
-		{
-			UE_LOG(LogUnrealMCPServer, Error, TEXT("Failed to parse outputSchema for search_blueprints tool"));
-		}
+		Tool.OutputSchemaBuilder = [SearchOutputSchema]() { return UMCP_FromJsonStr(SearchOutputSchema); };
+		Server->RegisterTool(MoveTemp(Tool));
+	}
+
+	{
+		FUMCP_ToolDefinition Tool;
+		Tool.name = TEXT("index_blueprints");
+		Tool.description = TEXT("Add the Blueprints that aren't indexed yet to the index behind the graph content searches of search_blueprints ('function', 'variable', 'event', 'node_class', 'interface'). Blueprints are indexed automatically when they are saved or loaded, and the index is kept across editor sessions, so this is only needed once per project (or after a large source control sync) to cover Blueprints nobody has opened. Loads each unindexed Blueprint in scope, one per editor tick; use runAsJob for large projects and poll get_job_status. Returns how many Blueprints were indexed.");
+		Tool.StartJob.BindRaw(this, &FUMCP_BlueprintTools::StartIndexBlueprints);
+		Tool.bSingleInstanceJob = true;
+		Tool.Priority = EUMCP_RequestPriority::Low;
+
+		TMap<FString, FString> InputDescriptions;
+		InputDescriptions.Add(TEXT("packagePath"), TEXT("Package path to limit indexing to, e.g. '/Game/Blueprints'. Use '/Game' for the whole project."));
+		InputDescriptions.Add(TEXT("bRecursive"), TEXT("Whether to include subfolders of packagePath. Defaults to true."));
+		InputDescriptions.Add(TEXT("maxBlueprints"), TEXT("Maximum number of Blueprints to load and index in this call. Defaults to 0 (no limit); the rest is reported as remainingCount."));
+		TArray<FString> InputRequired;
+		InputRequired.Add(TEXT("packagePath"));
+		Tool.InputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_IndexBlueprintsParams>(InputDescriptions, InputRequired);
+
+		TMap<FString, FString> OutputDescriptions;
+		OutputDescriptions.Add(TEXT("indexedCount"), TEXT("Number of Blueprints loaded and indexed"));
+		OutputDescriptions.Add(TEXT("failedCount"), TEXT("Number of Blueprints that failed to load, or have unsaved changes (those are indexed when they are saved)"));
+		OutputDescriptions.Add(TEXT("alreadyIndexedCount"), TEXT("Number of Blueprints in scope that were already indexed"));
+		OutputDescriptions.Add(TEXT("remainingCount"), TEXT("Number of unindexed Blueprints left because of maxBlueprints or a cancel"));
+		OutputDescriptions.Add(TEXT("failedPaths"), TEXT("Object paths of the Blueprints counted in failedCount"));
+		TArray<FString> OutputRequired;
+		OutputRequired.Add(TEXT("indexedCount"));
+		OutputRequired.Add(TEXT("failedCount"));
+		OutputRequired.Add(TEXT("alreadyIndexedCount"));
+		OutputRequired.Add(TEXT("remainingCount"));
+		Tool.OutputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_IndexBlueprintsResult>(OutputDescriptions, OutputRequired);
 		Server->RegisterTool(MoveTemp(Tool));
 	}
 	
@@ -90,6 +154,7 @@ void FUMCP_BlueprintTools::Register(class FUMCP_Server* Server)
 		Description += TEXT("After export, agents should read the markdown file using standard file system tools, then parse and optionally flatten the markdown to understand the graph structure. The MCP cannot perform the simplification/flattening step - this must be done by the agent.");
 		Tool.description = Description;
 		Tool.DoToolCall.BindRaw(this, &FUMCP_BlueprintTools::ExportBlueprintMarkdown);
+		Tool.Priority = EUMCP_RequestPriority::Low;
 		
 		// Generate input schema from USTRUCT with descriptions
 		TMap<FString, FString> InputDescriptions;
@@ -98,7 +163,7 @@ void FUMCP_BlueprintTools::Register(class FUMCP_Server* Server)
 		TArray<FString> InputRequired;
 		InputRequired.Add(TEXT("blueprintPaths"));
 		InputRequired.Add(TEXT("outputFolder"));
-		Tool.inputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_ExportBlueprintMarkdownParams>(InputDescriptions, InputRequired);
+		Tool.InputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_ExportBlueprintMarkdownParams>(InputDescriptions, InputRequired);
 		
 		// Generate output schema from USTRUCT with descriptions
 		TMap<FString, FString> OutputDescriptions;
@@ -112,15 +177,7 @@ void FUMCP_BlueprintTools::Register(class FUMCP_Server* Server)
 		OutputRequired.Add(TEXT("bSuccess"));
 		OutputRequired.Add(TEXT("exportedCount"));
 		OutputRequired.Add(TEXT("failedCount"));
-		TSharedPtr<FJsonObject> ExportOutputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_ExportBlueprintMarkdownResult>(OutputDescriptions, OutputRequired);
-		if (ExportOutputSchema.IsValid())
-		{
-			Tool.outputSchema = ExportOutputSchema;
-		}
-		else
-		{
-			UE_LOG(LogUnrealMCPServer, Error, TEXT("Failed to generate outputSchema for export_blueprint_markdown tool"));
-		}
+		Tool.OutputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_ExportBlueprintMarkdownResult>(OutputDescriptions, OutputRequired);
 		Server->RegisterTool(MoveTemp(Tool));
 	}
 }
@@ -138,6 +195,25 @@ bool FUMCP_BlueprintTools::SearchBlueprints(TSharedPtr<FJsonObject> arguments, T
 		return false;
 	}
 
+	// Follow-up pages read the snapshot of the first page, whose arguments hold the criteria to describe the matches with
+	FUMCP_AssetSearchSnapshots& Snapshots = Server->GetAssetSearchSnapshots();
+	TSharedPtr<const FUMCP_AssetSearchSnapshot> Snapshot;
+	int32 StartIndex = FMath::Max(0, Params.offset);
+	if (!Params.cursor.IsEmpty())
+	{
+		FString CursorError;
+		Snapshot = Snapshots.FindSnapshot(TEXT("search_blueprints"), Params.cursor, StartIndex, CursorError);
+		if (!Snapshot)
+		{
+			Content.text = CursorError;
+			return false;
+		}
+		const int32 MaxResults = Params.maxResults;
+		Params = FUMCP_SearchBlueprintsParams();
+		UMCP_CreateFromJsonObject(Snapshot->Arguments, Params);
+		Params.maxResults = MaxResults;
+	}
+
 	// Work with USTRUCT throughout
 	// Validate required parameters
 	if (Params.searchType.IsEmpty() || Params.searchTerm.IsEmpty())
@@ -146,39 +222,22 @@ bool FUMCP_BlueprintTools::SearchBlueprints(TSharedPtr<FJsonObject> arguments, T
 		return false;
 	}
 
-	UE_LOG(LogUnrealMCPServer, Log, TEXT("SearchBlueprints: Type=%s, Term=%s, Path=%s, Recursive=%s"), 
-		*Params.searchType, *Params.searchTerm, *Params.packagePath, Params.bRecursive ? TEXT("true") : TEXT("false"));
-
-	// Get Asset Registry
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-
-	// Prepare search filter
-	FARFilter Filter;
-	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
-	Filter.bRecursiveClasses = true;
-	
-	// Add package path filter if specified
-	if (!Params.packagePath.IsEmpty())
+	// Graph content is looked up in the content index, so no Blueprint is loaded for it
+	FUMCP_BlueprintContentIndex& ContentIndex = Server->GetBlueprintContentIndex();
+	TArray<const FUMCP_ContentSearchType*, TInlineAllocator<UE_ARRAY_COUNT(ContentSearchTypes)>> ContentTypes;
+	for (const FUMCP_ContentSearchType& ContentType : ContentSearchTypes)
 	{
-		Filter.PackagePaths.Add(FName(*Params.packagePath));
-		Filter.bRecursivePaths = Params.bRecursive;
+		if (Params.searchType == ContentType.SearchType || Params.searchType == TEXT("all"))
+		{
+			ContentTypes.Add(&ContentType);
+		}
 	}
+	const bool bContentSearchOnly = ContentTypes.Num() == 1;
 
-	// Perform asset search
-	TArray<FAssetData> AssetDataList;
-	AssetRegistry.GetAssets(Filter, AssetDataList);
-
-	UE_LOG(LogUnrealMCPServer, Log, TEXT("SearchBlueprints: Found %d Blueprint assets before filtering"), AssetDataList.Num());
-
-	// Build all matching results first (before paging)
-	TArray<TSharedPtr<FJsonValue>> AllResultsArray;
-	int32 TotalMatches = 0;
-
-	for (const FAssetData& AssetData : AssetDataList)
+	// Whether a Blueprint matches the search; the match details are only built for the Blueprints of the returned page
+	auto MatchBlueprint = [&Params, &ContentIndex, &ContentTypes](const FAssetData& AssetData, TArray<TSharedPtr<FJsonValue>>* OutMatches)
 	{
 		bool bMatches = false;
-		TArray<TSharedPtr<FJsonValue>> MatchesArray;
 
 		// Apply search type filters - using USTRUCT params
 		if (Params.searchType == TEXT("name") || Params.searchType == TEXT("all"))
@@ -188,12 +247,15 @@ bool FUMCP_BlueprintTools::SearchBlueprints(TSharedPtr<FJsonObject> arguments, T
 				bMatches = true;
 				
 				// Add match detail
-				TSharedPtr<FJsonObject> MatchJson = MakeShareable(new FJsonObject);
-				MatchJson->SetStringField(TEXT("type"), TEXT("asset_name"));
-				MatchJson->SetStringField(TEXT("location"), TEXT("Blueprint Asset"));
-				MatchJson->SetStringField(TEXT("context"), FString::Printf(TEXT("Blueprint name '%s' contains '%s'"), 
-					*AssetData.AssetName.ToString(), *Params.searchTerm));
-				MatchesArray.Add(MakeShareable(new FJsonValueObject(MatchJson)));
+				if (OutMatches)
+				{
+					TSharedPtr<FJsonObject> MatchJson = MakeShareable(new FJsonObject);
+					MatchJson->SetStringField(TEXT("type"), TEXT("asset_name"));
+					MatchJson->SetStringField(TEXT("location"), TEXT("Blueprint Asset"));
+					MatchJson->SetStringField(TEXT("context"), FString::Printf(TEXT("Blueprint name '%s' contains '%s'"), 
+						*AssetData.AssetName.ToString(), *Params.searchTerm));
+					OutMatches->Add(MakeShareable(new FJsonValueObject(MatchJson)));
+				}
 			}
 		}
 
@@ -208,60 +270,162 @@ bool FUMCP_BlueprintTools::SearchBlueprints(TSharedPtr<FJsonObject> arguments, T
 					bMatches = true;
 					
 					// Add match detail
+					if (OutMatches)
+					{
+						TSharedPtr<FJsonObject> MatchJson = MakeShareable(new FJsonObject);
+						MatchJson->SetStringField(TEXT("type"), TEXT("parent_class"));
+						MatchJson->SetStringField(TEXT("location"), TEXT("Blueprint Asset"));
+						MatchJson->SetStringField(TEXT("context"), FString::Printf(TEXT("Parent class '%s' contains '%s'"), 
+							*ParentClassPath, *Params.searchTerm));
+						OutMatches->Add(MakeShareable(new FJsonValueObject(MatchJson)));
+					}
+				}
+			}
+		}
+
+		for (const FUMCP_ContentSearchType* ContentType : ContentTypes)
+		{
+			TArray<FUMCP_BlueprintContentIndex::FItem> Items;
+			ContentIndex.GetItems(AssetData.PackageName, ContentType->Kind, Params.searchTerm, Items);
+			bMatches |= Items.Num() > 0;
+			if (OutMatches)
+			{
+				for (const FUMCP_BlueprintContentIndex::FItem& Item : Items)
+				{
 					TSharedPtr<FJsonObject> MatchJson = MakeShareable(new FJsonObject);
-					MatchJson->SetStringField(TEXT("type"), TEXT("parent_class"));
-					MatchJson->SetStringField(TEXT("location"), TEXT("Blueprint Asset"));
-					MatchJson->SetStringField(TEXT("context"), FString::Printf(TEXT("Parent class '%s' contains '%s'"), 
-						*ParentClassPath, *Params.searchTerm));
-					MatchesArray.Add(MakeShareable(new FJsonValueObject(MatchJson)));
+					MatchJson->SetStringField(TEXT("type"), Item.bReference ? ContentType->ReferenceMatchType : ContentType->MatchType);
+					MatchJson->SetStringField(TEXT("location"), Item.Graph.IsEmpty() ? TEXT("Blueprint Asset") : *Item.Graph);
+					MatchJson->SetStringField(TEXT("context"), FString::Printf(TEXT("%s '%s' contains '%s'"),
+						Item.bReference ? ContentType->ReferenceLabel : ContentType->Label, *Item.Name, *Params.searchTerm));
+					OutMatches->Add(MakeShareable(new FJsonValueObject(MatchJson)));
 				}
 			}
 		}
+		return bMatches;
+	};
 
-		// If this Blueprint matches, add it to results
-		if (bMatches)
+	TArray<FAssetData> AssetDataList;
+	uint32 RegistryGeneration = 0;
+	int32 UnindexedCount = INDEX_NONE;
+	if (!Snapshot)
+	{
+		UE_LOG(LogUnrealMCPServer, Log, TEXT("SearchBlueprints: Type=%s, Term=%s, Path=%s, Recursive=%s"), 
+			*Params.searchType, *Params.searchTerm, *Params.packagePath, Params.bRecursive ? TEXT("true") : TEXT("false"));
+
+		// Get Asset Registry (registry singleton rather than the module manager, since this tool runs off the game thread)
+		IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+		// Prepare search filter
+		FARFilter Filter;
+		Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+		Filter.bRecursiveClasses = true;
+		
+		// Add package path filter if specified
+		if (!Params.packagePath.IsEmpty())
 		{
-			TotalMatches++;
-			
-			TSharedPtr<FJsonObject> BlueprintResult = MakeShareable(new FJsonObject);
-			BlueprintResult->SetStringField(TEXT("assetPath"), AssetData.GetSoftObjectPath().ToString());
-			BlueprintResult->SetStringField(TEXT("assetName"), AssetData.AssetName.ToString());
-			BlueprintResult->SetStringField(TEXT("packagePath"), AssetData.PackagePath.ToString());
-			
-			// Get parent class for display
-			FString ParentClassPath;
-			AssetData.GetTagValue(TEXT("ParentClass"), ParentClassPath);
-			BlueprintResult->SetStringField(TEXT("parentClass"), ParentClassPath);
-			
-			BlueprintResult->SetArrayField(TEXT("matches"), MatchesArray);
-			
-			AllResultsArray.Add(MakeShareable(new FJsonValueObject(BlueprintResult)));
+			Filter.PackagePaths.Add(FName(*Params.packagePath));
+			Filter.bRecursivePaths = Params.bRecursive;
+		}
+
+		// Once the name index is built, only the packages whose asset names or parent classes contain the term are
+		// queried. The index treats * and ? as wildcards while the match below doesn't, so such terms scan instead.
+		// Graph content searches list every Blueprint in scope instead, to count the ones that aren't indexed yet.
+		RegistryGeneration = Snapshots.GetRegistryGeneration();
+		const FUMCP_AssetNameIndex& NameIndex = Server->GetAssetNameIndex();
+		bool bUsedNameIndex = !bContentSearchOnly && NameIndex.IsReady() && !Params.searchTerm.Contains(TEXT("*")) && !Params.searchTerm.Contains(TEXT("?"));
+		if (bUsedNameIndex)
+		{
+			TSet<FName> CandidatePackageNames;
+			if (Params.searchType == TEXT("name") || Params.searchType == TEXT("all"))
+			{
+				bUsedNameIndex &= NameIndex.FindPackages(FUMCP_AssetNameIndex::EField::AssetName, Params.searchTerm, CandidatePackageNames);
+			}
+			if (Params.searchType == TEXT("parent_class") || Params.searchType == TEXT("all"))
+			{
+				bUsedNameIndex &= NameIndex.FindPackages(FUMCP_AssetNameIndex::EField::ParentClass, Params.searchTerm, CandidatePackageNames);
+			}
+			for (const FUMCP_ContentSearchType* ContentType : ContentTypes)
+			{
+				ContentIndex.FindPackages(ContentType->Kind, Params.searchTerm, CandidatePackageNames);
+			}
+			if (bUsedNameIndex)
+			{
+				Filter.PackageNames = CandidatePackageNames.Array();
+			}
+		}
+
+		// Perform asset search; an empty package list would match everything, so no candidate means no query
+		if (!bUsedNameIndex || Filter.PackageNames.Num() > 0)
+		{
+			UMCP_TRACE_SCOPE(UMCP_AssetRegistryGetAssets);
+			AssetRegistry.GetAssets(Filter, AssetDataList);
+		}
+
+		UE_LOG(LogUnrealMCPServer, Log, TEXT("SearchBlueprints: Found %d Blueprint assets before filtering"), AssetDataList.Num());
+
+		// Keep only the matching Blueprints (before paging)
+		if (bContentSearchOnly)
+		{
+			TSet<FName> ContentPackageNames;
+			ContentIndex.FindPackages(ContentTypes[0]->Kind, Params.searchTerm, ContentPackageNames);
+			UnindexedCount = 0;
+			AssetDataList.RemoveAll([&ContentIndex, &ContentPackageNames, &UnindexedCount](const FAssetData& AssetData)
+			{
+				if (ContentPackageNames.Contains(AssetData.PackageName))
+				{
+					return false;
+				}
+				UnindexedCount += ContentIndex.IsIndexed(AssetData.PackageName) ? 0 : 1;
+				return true;
+			});
+		}
+		else
+		{
+			AssetDataList.RemoveAll([&MatchBlueprint](const FAssetData& AssetData)
+			{
+				return !MatchBlueprint(AssetData, nullptr);
+			});
 		}
 	}
+	const TArray<FAssetData>& MatchingAssets = Snapshot ? Snapshot->Assets : AssetDataList;
 
 	// Apply paging: calculate total count before limiting
-	int32 TotalCount = TotalMatches;
-	int32 StartIndex = FMath::Max(0, Params.offset);
-	int32 EndIndex = AllResultsArray.Num();
+	const int32 TotalCount = MatchingAssets.Num();
+	StartIndex = FMath::Min(StartIndex, TotalCount);
+	int32 EndIndex = TotalCount;
 	
 	// Apply maxResults limit if specified
 	if (Params.maxResults > 0)
 	{
-		EndIndex = FMath::Min(StartIndex + Params.maxResults, AllResultsArray.Num());
+		EndIndex = FMath::Min(StartIndex + Params.maxResults, TotalCount);
 	}
 	
-	// Extract the page of results
+	// Build the page of results
 	TArray<TSharedPtr<FJsonValue>> PagedResultsArray;
-	if (StartIndex < AllResultsArray.Num())
+	PagedResultsArray.Reserve(EndIndex - StartIndex);
+	for (int32 i = StartIndex; i < EndIndex; ++i)
 	{
-		for (int32 i = StartIndex; i < EndIndex; ++i)
-		{
-			PagedResultsArray.Add(AllResultsArray[i]);
-		}
+		const FAssetData& AssetData = MatchingAssets[i];
+		TArray<TSharedPtr<FJsonValue>> MatchesArray;
+		MatchBlueprint(AssetData, &MatchesArray);
+
+		TSharedPtr<FJsonObject> BlueprintResult = MakeShareable(new FJsonObject);
+		BlueprintResult->SetStringField(TEXT("assetPath"), AssetData.GetSoftObjectPath().ToString());
+		BlueprintResult->SetStringField(TEXT("assetName"), AssetData.AssetName.ToString());
+		BlueprintResult->SetStringField(TEXT("packagePath"), AssetData.PackagePath.ToString());
+		
+		// Get parent class for display
+		FString ParentClassPath;
+		AssetData.GetTagValue(TEXT("ParentClass"), ParentClassPath);
+		BlueprintResult->SetStringField(TEXT("parentClass"), ParentClassPath);
+		
+		BlueprintResult->SetArrayField(TEXT("matches"), MatchesArray);
+		
+		PagedResultsArray.Add(MakeShareable(new FJsonValueObject(BlueprintResult)));
 	}
 	
 	UE_LOG(LogUnrealMCPServer, Log, TEXT("SearchBlueprints: Returning %d results (offset=%d, maxResults=%d, total=%d)"), 
-		PagedResultsArray.Num(), Params.offset, Params.maxResults, TotalCount);
+		PagedResultsArray.Num(), StartIndex, Params.maxResults, TotalCount);
 
 	// Build final result JSON - output has complex nested structure, so we build JSON manually
 	// but we've used USTRUCT for all input processing
@@ -269,8 +433,23 @@ bool FUMCP_BlueprintTools::SearchBlueprints(TSharedPtr<FJsonObject> arguments, T
 	ResultsJson->SetArrayField(TEXT("results"), PagedResultsArray);
 	ResultsJson->SetNumberField(TEXT("totalResults"), PagedResultsArray.Num());
 	ResultsJson->SetNumberField(TEXT("totalCount"), TotalCount);
-	ResultsJson->SetNumberField(TEXT("offset"), Params.offset);
+	ResultsJson->SetNumberField(TEXT("offset"), StartIndex);
 	ResultsJson->SetBoolField(TEXT("hasMore"), EndIndex < TotalCount);
+	if (UnindexedCount != INDEX_NONE)
+	{
+		ResultsJson->SetNumberField(TEXT("unindexedCount"), UnindexedCount);
+	}
+	if (EndIndex < TotalCount)
+	{
+		// The first page hands its matches over to a snapshot; without one (over budget) offset paging still works
+		const FString NextCursor = Snapshot
+			? FUMCP_AssetSearchSnapshots::MakeCursor(*Snapshot, EndIndex)
+			: Snapshots.CreateSnapshot(TEXT("search_blueprints"), arguments, RegistryGeneration, MoveTemp(AssetDataList), EndIndex);
+		if (!NextCursor.IsEmpty())
+		{
+			ResultsJson->SetStringField(TEXT("nextCursor"), NextCursor);
+		}
+	}
 	
 	TSharedPtr<FJsonObject> SearchCriteriaJson = MakeShareable(new FJsonObject);
 	SearchCriteriaJson->SetStringField(TEXT("searchType"), Params.searchType);
@@ -282,18 +461,132 @@ bool FUMCP_BlueprintTools::SearchBlueprints(TSharedPtr<FJsonObject> arguments, T
 	SearchCriteriaJson->SetBoolField(TEXT("recursive"), Params.bRecursive);
 	ResultsJson->SetObjectField(TEXT("searchCriteria"), SearchCriteriaJson);
 
-	// Convert to JSON string
-	FString ResultJsonString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJsonString);
-	FJsonSerializer::Serialize(ResultsJson.ToSharedRef(), Writer);
-
-	Content.text = ResultJsonString;
+	// The server serializes this once for both the text content and structuredContent
+	Content.structuredContent = ResultsJson;
 	
 	UE_LOG(LogUnrealMCPServer, Log, TEXT("SearchBlueprints: Completed search, found %d matches (returning %d)"), TotalCount, PagedResultsArray.Num());
 	
 	return true;
 }
 
+bool FUMCP_BlueprintTools::StartIndexBlueprints(TSharedPtr<FJsonObject> arguments, UMCP_ToolJobStep& OutStep, TArray<FUMCP_CallToolResultContent>& OutContent)
+{
+	auto SetErrorContent = [&OutContent](const TCHAR* Error)
+	{
+		auto& Content = OutContent.Add_GetRef(FUMCP_CallToolResultContent());
+		Content.type = TEXT("text");
+		Content.text = Error;
+		return false;
+	};
+
+	FUMCP_IndexBlueprintsParams Params;
+	if (!arguments.IsValid() || !UMCP_CreateFromJsonObject(arguments, Params))
+	{
+		return SetErrorContent(TEXT("Invalid parameters"));
+	}
+	if (Params.packagePath.IsEmpty())
+	{
+		return SetErrorContent(TEXT("Missing required parameter: packagePath"));
+	}
+
+	// One Blueprint per step, loaded asynchronously ahead of time, so the editor keeps ticking while a project is indexed
+	TSharedRef<FUMCP_IndexBlueprintsState> State = MakeShared<FUMCP_IndexBlueprintsState>();
+	State->Params = MoveTemp(Params);
+	OutStep = [this, State](FUMCP_JobContext& Context, FUMCP_CallToolResult& OutResult)
+	{
+		FUMCP_BlueprintContentIndex& ContentIndex = Server->GetBlueprintContentIndex();
+		FUMCP_IndexBlueprintsResult& IndexResult = State->Result;
+		if (!State->bListed)
+		{
+			State->bListed = true;
+			FARFilter Filter;
+			Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+			Filter.bRecursiveClasses = true;
+			Filter.PackagePaths.Add(FName(*State->Params.packagePath));
+			Filter.bRecursivePaths = State->Params.bRecursive;
+			TArray<FAssetData> AssetDataList;
+			IAssetRegistry::GetChecked().GetAssets(Filter, AssetDataList);
+			for (const FAssetData& AssetData : AssetDataList)
+			{
+				if (ContentIndex.IsIndexed(AssetData.PackageName))
+				{
+					IndexResult.alreadyIndexedCount++;
+				}
+				else
+				{
+					State->ObjectPaths.Add(AssetData.GetSoftObjectPath());
+				}
+			}
+			if (State->Params.maxBlueprints > 0 && State->ObjectPaths.Num() > State->Params.maxBlueprints)
+			{
+				IndexResult.remainingCount = State->ObjectPaths.Num() - State->Params.maxBlueprints;
+				State->ObjectPaths.SetNum(State->Params.maxBlueprints);
+			}
+			State->LoadRequestIds.Init(INDEX_NONE, State->ObjectPaths.Num());
+			UE_LOG(LogUnrealMCPServer, Log, TEXT("IndexBlueprints: Indexing %d Blueprints in %s (%d already indexed)"), State->ObjectPaths.Num(), *State->Params.packagePath, IndexResult.alreadyIndexedCount);
+			return EUMCP_JobStepResult::Continue;
+		}
+
+		// A job gets a later tick to wait in; inline calls have to block instead
+		const bool bCanWait = !Context.IsInline() && !Context.IsCancelRequested();
+		const int32 NumBlueprints = State->ObjectPaths.Num();
+		if (State->NextIndex < NumBlueprints && !Context.IsCancelRequested())
+		{
+			FUMCP_PackageLoader& Loader = Server->GetPackageLoader();
+			const int32 LoadEnd = FMath::Min(State->NextIndex + Loader.GetMaxConcurrentLoads(), NumBlueprints);
+			while (State->NextLoadIndex < LoadEnd && Loader.TryStartLoad(State->ObjectPaths[State->NextLoadIndex].ToString(), State->LoadRequestIds[State->NextLoadIndex]))
+			{
+				++State->NextLoadIndex;
+			}
+
+			// Not requested yet means the window is full; the Blueprint is then loaded below
+			const int32 Index = State->NextIndex;
+			if (State->NextLoadIndex <= Index || !Loader.IsLoadComplete(State->LoadRequestIds[Index]))
+			{
+				if (bCanWait)
+				{
+					return EUMCP_JobStepResult::Wait;
+				}
+				Loader.WaitForLoad(State->LoadRequestIds[Index]);
+			}
+
+			const FSoftObjectPath& ObjectPath = State->ObjectPaths[Index];
+			Context.ReportProgress(Index, NumBlueprints, ObjectPath.ToString());
+			State->NextIndex++;
+			UBlueprint* Blueprint = Cast<UBlueprint>(Loader.LoadObject(ObjectPath.ToString()));
+			ContentIndex.AddBlueprint(Blueprint);
+			if (Blueprint && ContentIndex.IsIndexed(Blueprint->GetOutermost()->GetFName()))
+			{
+				IndexResult.indexedCount++;
+			}
+			else
+			{
+				IndexResult.failedCount++;
+				IndexResult.failedPaths.Add(ObjectPath.ToString());
+				UE_LOG(LogUnrealMCPServer, Warning, TEXT("IndexBlueprints: Could not index '%s'"), *ObjectPath.ToString());
+			}
+			// The index only keeps names, so the Blueprint can go again if memory runs high
+			Loader.ReleaseIfOverWatermark();
+			return EUMCP_JobStepResult::Continue;
+		}
+
+		IndexResult.remainingCount += NumBlueprints - State->NextIndex;
+		Context.ReportProgress(State->NextIndex, NumBlueprints);
+		ContentIndex.Save();
+
+		auto& Content = OutResult.content.Add_GetRef(FUMCP_CallToolResultContent());
+		Content.type = TEXT("text");
+		if (!UMCP_SetStructuredContent(IndexResult, Content))
+		{
+			Content.text = TEXT("Failed to serialize result");
+			OutResult.isError = true;
+		}
+		UE_LOG(LogUnrealMCPServer, Log, TEXT("IndexBlueprints: Indexed %d Blueprints, %d failed, %d remaining"), IndexResult.indexedCount, IndexResult.failedCount, IndexResult.remainingCount);
+		return EUMCP_JobStepResult::Finished;
+	};
+	return true;
+}
+
 bool FUMCP_BlueprintTools::ExportBlueprintMarkdown(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent)
 {
 	auto& Content = OutContent.Add_GetRef(FUMCP_CallToolResultContent());
@@ -308,7 +601,7 @@ bool FUMCP_BlueprintTools::ExportBlueprintMarkdown(TSharedPtr<FJsonObject> argum
 		ErrorResult.exportedCount = 0;
 		ErrorResult.failedCount = 0;
 		ErrorResult.error = TEXT("Invalid parameters");
-		if (!UMCP_ToJsonString(ErrorResult, Content.text))
+		if (!UMCP_SetStructuredContent(ErrorResult, Content))
 		{
 			Content.text = TEXT("Failed to serialize error result");
 		}
@@ -324,7 +617,7 @@ bool FUMCP_BlueprintTools::ExportBlueprintMarkdown(TSharedPtr<FJsonObject> argum
 	if (Params.blueprintPaths.Num() == 0)
 	{
 		Result.error = TEXT("Missing or empty blueprintPaths parameter.");
-		if (!UMCP_ToJsonString(Result, Content.text))
+		if (!UMCP_SetStructuredContent(Result, Content))
 		{
 			Content.text = TEXT("Failed to serialize error result");
 		}
@@ -334,7 +627,7 @@ bool FUMCP_BlueprintTools::ExportBlueprintMarkdown(TSharedPtr<FJsonObject> argum
 	if (Params.outputFolder.IsEmpty())
 	{
 		Result.error = TEXT("Missing outputFolder parameter.");
-		if (!UMCP_ToJsonString(Result, Content.text))
+		if (!UMCP_SetStructuredContent(Result, Content))
 		{
 			Content.text = TEXT("Failed to serialize error result");
 		}
@@ -351,7 +644,7 @@ bool FUMCP_BlueprintTools::ExportBlueprintMarkdown(TSharedPtr<FJsonObject> argum
 		if (!PlatformFile.CreateDirectoryTree(*AbsoluteOutputFolder))
 		{
 			Result.error = FString::Printf(TEXT("Failed to create output folder: %s"), *AbsoluteOutputFolder);
-			if (!UMCP_ToJsonString(Result, Content.text))
+			if (!UMCP_SetStructuredContent(Result, Content))
 			{
 				Content.text = TEXT("Failed to serialize error result");
 			}
@@ -363,9 +656,25 @@ bool FUMCP_BlueprintTools::ExportBlueprintMarkdown(TSharedPtr<FJsonObject> argum
 	UE_LOG(LogUnrealMCPServer, Log, TEXT("ExportBlueprintMarkdown: Exporting %d Blueprints to folder: %s"), 
 		Params.blueprintPaths.Num(), *AbsoluteOutputFolder);
 
+	// The packages of the next Blueprints are requested while the current one is exported
+	FUMCP_PackageLoader& Loader = Server->GetPackageLoader();
+	TArray<int32> LoadRequestIds;
+	LoadRequestIds.Init(INDEX_NONE, Params.blueprintPaths.Num());
+	int32 NextLoadIndex = 0;
+
 	// Process each Blueprint
-	for (const FString& BlueprintPath : Params.blueprintPaths)
+	for (int32 PathIndex = 0; PathIndex < Params.blueprintPaths.Num(); ++PathIndex)
 	{
+		const FString& BlueprintPath = Params.blueprintPaths[PathIndex];
+		FUMCP_ToolProgress::Report(PathIndex, Params.blueprintPaths.Num(), BlueprintPath);
+		const int32 LoadEnd = FMath::Min(PathIndex + Loader.GetMaxConcurrentLoads(), Params.blueprintPaths.Num());
+		NextLoadIndex = FMath::Max(NextLoadIndex, PathIndex);
+		while (NextLoadIndex < LoadEnd && Loader.TryStartLoad(Params.blueprintPaths[NextLoadIndex], LoadRequestIds[NextLoadIndex]))
+		{
+			++NextLoadIndex;
+		}
+		Loader.WaitForLoad(LoadRequestIds[PathIndex]);
+
 		if (BlueprintPath.IsEmpty())
 		{
 			Result.failedCount++;
@@ -375,7 +684,7 @@ bool FUMCP_BlueprintTools::ExportBlueprintMarkdown(TSharedPtr<FJsonObject> argum
 		}
 
 		// Verify this is a Blueprint
-		UObject* Object = LoadObject<UObject>(nullptr, *BlueprintPath);
+		UObject* Object = Loader.LoadObject(BlueprintPath);
 		if (!Object)
 		{
 			Result.failedCount++;
@@ -464,7 +773,17 @@ bool FUMCP_BlueprintTools::ExportBlueprintMarkdown(TSharedPtr<FJsonObject> argum
 		Result.exportedCount++;
 		Result.exportedPaths.Add(FinalFilePath);
 		UE_LOG(LogUnrealMCPServer, Log, TEXT("ExportBlueprintMarkdown: Successfully exported Blueprint '%s' to file: %s"), *BlueprintPath, *FinalFilePath);
+
+		// Clients streaming the call can pick up each file as soon as it is written
+		if (FUMCP_ToolProgress::IsActive())
+		{
+			FUMCP_CallToolResultContent ExportedFile;
+			ExportedFile.type = TEXT("text");
+			ExportedFile.text = FinalFilePath;
+			FUMCP_ToolProgress::EmitPartialContent(ExportedFile);
+		}
 	}
+	FUMCP_ToolProgress::Report(Params.blueprintPaths.Num(), Params.blueprintPaths.Num());
 
 	// Overall success if at least one Blueprint was exported
 	Result.bSuccess = (Result.exportedCount > 0);
@@ -482,7 +801,7 @@ bool FUMCP_BlueprintTools::ExportBlueprintMarkdown(TSharedPtr<FJsonObject> argum
 	}
 
 	// Convert USTRUCT to JSON string at the end
-	if (!UMCP_ToJsonString(Result, Content.text))
+	if (!UMCP_SetStructuredContent(Result, Content))
 	{
 		Content.text = TEXT("Failed to serialize result");
 		return false;
@@ -505,44 +824,55 @@ bool FUMCP_BlueprintTools::ExportBlueprintToMarkdown(const FString& ObjectPath,
 		return false;
 	}
 
-	// Load the Blueprint object
-	UObject* Object = LoadObject<UObject>(nullptr, *ObjectPath);
-	if (!Object)
+	// Shares the "md" cache entries with export_asset and the Blueprint markdown resource
+	const bool bExported = Server->GetExportCache().GetOrExport(ObjectPath, TEXT("md"), [this, &ObjectPath](FString& OutText, FString& OutExportError)
 	{
-		OutError = FString::Printf(TEXT("Failed to load Blueprint: %s"), *ObjectPath);
-		return false;
-	}
+		// Load the Blueprint object
+		UObject* Object = Server->GetPackageLoader().LoadObject(ObjectPath);
+		if (!Object)
+		{
+			OutExportError = FString::Printf(TEXT("Failed to load Blueprint: %s"), *ObjectPath);
+			return false;
+		}
 
-	// Verify it's a Blueprint
-	if (!Object->IsA<UBlueprint>())
-	{
-		OutError = FString::Printf(TEXT("Object is not a Blueprint: %s"), *ObjectPath);
-		return false;
-	}
+		// Verify it's a Blueprint
+		if (!Object->IsA<UBlueprint>())
+		{
+			OutExportError = FString::Printf(TEXT("Object is not a Blueprint: %s"), *ObjectPath);
+			return false;
+		}
 
-	// Find markdown exporter
-	UExporter* Exporter = UExporter::FindExporter(Object, TEXT("md"));
-	if (!Exporter)
-	{
-		OutError = FString::Printf(TEXT("Failed to find markdown exporter for Blueprint: %s. BP2AI plugin may not be available."), *ObjectPath);
-		return false;
-	}
+		// Find markdown exporter
+		UExporter* Exporter = UExporter::FindExporter(Object, TEXT("md"));
+		if (!Exporter)
+		{
+			OutExportError = FString::Printf(TEXT("Failed to find markdown exporter for Blueprint: %s. BP2AI plugin may not be available."), *ObjectPath);
+			return false;
+		}
 
-	// Export to markdown
-	FStringOutputDevice OutputDevice;
-	const uint32 ExportFlags = PPF_Copy | PPF_ExportsNotFullyQualified;
-	UE_LOG(LogUnrealMCPServer, Verbose, TEXT("ExportBlueprintToMarkdown: Exporting Blueprint '%s' to markdown format using exporter: %s"), 
-		*ObjectPath, *Exporter->GetClass()->GetName());
-	Exporter->ExportText(nullptr, Object, TEXT("md"), OutputDevice, GWarn, ExportFlags);
-	
-	if (OutputDevice.IsEmpty())
-	{
-		OutError = FString::Printf(TEXT("ExportText did not produce any output for Blueprint: %s. Using exporter: %s."), 
+		// Export to markdown
+		FStringOutputDevice OutputDevice;
+		const uint32 ExportFlags = PPF_Copy | PPF_ExportsNotFullyQualified;
+		UE_LOG(LogUnrealMCPServer, Verbose, TEXT("ExportBlueprintToMarkdown: Exporting Blueprint '%s' to markdown format using exporter: %s"), 
 			*ObjectPath, *Exporter->GetClass()->GetName());
-		return false;
-	}
+		{
+			UMCP_TRACE_SCOPE(UMCP_ExportText);
+			Exporter->ExportText(nullptr, Object, TEXT("md"), OutputDevice, GWarn, ExportFlags);
+		}
+		
+		if (OutputDevice.IsEmpty())
+		{
+			OutExportError = FString::Printf(TEXT("ExportText did not produce any output for Blueprint: %s. Using exporter: %s."), 
+				*ObjectPath, *Exporter->GetClass()->GetName());
+			return false;
+		}
 
-	OutExportedText = OutputDevice;
-	return true;
+		OutText = OutputDevice;
+		return true;
+	}, OutExportedText, OutError);
+
+	// Nothing refers to the exported Blueprint anymore, so what was loaded for it can go if memory runs high
+	Server->GetPackageLoader().ReleaseIfOverWatermark();
+	return bExported;
 }
 
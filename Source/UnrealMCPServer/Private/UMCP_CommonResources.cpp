@@ -1,17 +1,94 @@
 #include "UMCP_CommonResources.h"
 #include "UMCP_Server.h"
 #include "UMCP_Types.h"
+#include "UMCP_Trace.h"
+#include "UMCP_T3DStreamReader.h" // For FUMCP_T3DStreamReader::FindObjectBlocks
 #include "UMCP_UriTemplate.h" // For FUMCP_UriTemplate
 #include "UnrealMCPServerModule.h"
 #include "Engine/Blueprint.h" // Required for UBlueprint
 #include "Exporters/Exporter.h" // Required for UExporter
-#include "UObject/UObjectGlobals.h" // Required for LoadObject
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "Interfaces/IPluginManager.h"
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonSerializer.h"
 
+namespace
+{
+	// The optional offset, length and block variables of a resource URI; bOutRanged is set if any of them is there
+	bool GetExportRange(const FUMCP_UriTemplateMatchView& Match, FUMCP_ExportRange& OutRange, bool& bOutRanged, FString& OutError)
+	{
+		bOutRanged = false;
+		const TPair<const TCHAR*, int32*> Variables[] = {
+			{ TEXT("offset"), &OutRange.Offset },
+			{ TEXT("length"), &OutRange.Length },
+			{ TEXT("block"), &OutRange.Block },
+		};
+		for (const TPair<const TCHAR*, int32*>& Variable : Variables)
+		{
+			FString Value;
+			if (!Match.GetValue(Variable.Key, Value) || Value.IsEmpty())
+			{
+				continue;
+			}
+			if (!LexTryParseString(*Variable.Value, *Value))
+			{
+				OutError = FString::Printf(TEXT("'%s' must be a number, got '%s'"), Variable.Key, *Value);
+				return false;
+			}
+			bOutRanged = true;
+		}
+		// An empty chunk would make the next URI the same as this one, so a client following it would never finish
+		FString Length;
+		if (Match.GetValue(TEXT("length"), Length) && !Length.IsEmpty() && OutRange.Length <= 0)
+		{
+			OutError = FString::Printf(TEXT("'length' must be greater than 0, got %d"), OutRange.Length);
+			return false;
+		}
+		return true;
+	}
+
+	// Where a ranged read is in the export, and the URI that reads on from its end if there is more
+	TSharedPtr<FJsonObject> MakeSliceMeta(FStringView Uri, const FUMCP_ExportRange& Range, const FUMCP_ExportSlice& Slice)
+	{
+		TSharedPtr<FJsonObject> Meta = MakeShared<FJsonObject>();
+		Meta->SetNumberField(TEXT("offset"), Slice.Offset);
+		Meta->SetNumberField(TEXT("length"), Slice.Length);
+		Meta->SetNumberField(TEXT("totalLength"), Slice.TotalLength);
+		if (Range.Block != INDEX_NONE)
+		{
+			Meta->SetNumberField(TEXT("block"), Range.Block);
+			Meta->SetNumberField(TEXT("blockCount"), Slice.NumBlocks);
+		}
+
+		int32 QueryStart = INDEX_NONE;
+		TStringBuilder<512> NextUri;
+		NextUri << (Uri.FindChar(TEXT('?'), QueryStart) ? Uri.Left(QueryStart) : Uri);
+		if (Slice.Offset + Slice.Length < Slice.TotalLength)
+		{
+			NextUri << TEXT("?offset=") << (Slice.Offset + Slice.Length);
+			if (Range.Block != INDEX_NONE)
+			{
+				NextUri << TEXT("&block=") << Range.Block;
+			}
+		}
+		else if (Range.Block != INDEX_NONE && Range.Block + 1 < Slice.NumBlocks)
+		{
+			NextUri << TEXT("?block=") << (Range.Block + 1);
+		}
+		else
+		{
+			return Meta;
+		}
+		if (Range.Length >= 0)
+		{
+			NextUri << TEXT("&length=") << Range.Length;
+		}
+		Meta->SetStringField(TEXT("nextUri"), NextUri.ToString());
+		return Meta;
+	}
+}
+
 FString FUMCP_CommonResources::GetResourcesPath()
 {
 	// Get plugin directory
@@ -27,7 +104,7 @@ FString FUMCP_CommonResources::GetResourcesPath()
 	return ResourcesPath;
 }
 
-bool FUMCP_CommonResources::LoadResourcesFromJson(class FUMCP_Server* Server)
+bool FUMCP_CommonResources::LoadResourcesFromJson()
 {
 	FString ResourcesPath = GetResourcesPath();
 	if (ResourcesPath.IsEmpty())
@@ -87,11 +164,11 @@ bool FUMCP_CommonResources::LoadResourcesFromJson(class FUMCP_Server* Server)
 			(*TemplateObject)->TryGetStringField(TEXT("mimeType"), TemplateDef.mimeType);
 			
 			// Bind handler based on URI template
-			if (TemplateDef.uriTemplate == TEXT("unreal+t3d://{filepath}"))
+			if (TemplateDef.uriTemplate == TEXT("unreal+t3d://{filepath}{?offset,length,block}"))
 			{
 				TemplateDef.ReadResource.BindRaw(this, &FUMCP_CommonResources::HandleT3DResourceRequest);
 			}
-			else if (TemplateDef.uriTemplate == TEXT("unreal+md://{filepath}"))
+			else if (TemplateDef.uriTemplate == TEXT("unreal+md://{filepath}{?offset,length}"))
 			{
 				TemplateDef.ReadResource.BindRaw(this, &FUMCP_CommonResources::HandleMarkdownResourceRequest);
 			}
@@ -119,12 +196,13 @@ bool FUMCP_CommonResources::LoadResourcesFromJson(class FUMCP_Server* Server)
 	return false;
 }
 
-void FUMCP_CommonResources::Register(class FUMCP_Server* Server)
+void FUMCP_CommonResources::Register(class FUMCP_Server* InServer)
 {
+	Server = InServer;
 	UE_LOG(LogUnrealMCPServer, Log, TEXT("Registering common MCP resources."));
 
 	// Try to load from JSON first
-	if (LoadResourcesFromJson(Server))
+	if (LoadResourcesFromJson())
 	{
 		UE_LOG(LogUnrealMCPServer, Log, TEXT("Successfully loaded resources from JSON"));
 		return;
@@ -137,15 +215,15 @@ void FUMCP_CommonResources::Register(class FUMCP_Server* Server)
 	{
 		FUMCP_ResourceTemplateDefinition T3DTemplateDefinition;
 		T3DTemplateDefinition.name = TEXT("Blueprint T3D Exporter");
-		T3DTemplateDefinition.description = TEXT("Exports the T3D representation of an Unreal Engine Blueprint asset specified by its path using the unreal+t3d://{filepath} URI scheme.");
+		T3DTemplateDefinition.description = TEXT("Exports the T3D representation of an Unreal Engine Blueprint asset specified by its path using the unreal+t3d://{filepath} URI scheme. Large exports can be read in chunks: offset and length select characters, block selects one object block (a top-level block or a block directly inside one), and _meta.nextUri reads on.");
 		T3DTemplateDefinition.mimeType = TEXT("application/vnd.unreal.t3d");
-		T3DTemplateDefinition.uriTemplate = TEXT("unreal+t3d://{filepath}");
+		T3DTemplateDefinition.uriTemplate = TEXT("unreal+t3d://{filepath}{?offset,length,block}");
 		// Bind the actual handler for this templated resource
 		T3DTemplateDefinition.ReadResource.BindRaw(this, &FUMCP_CommonResources::HandleT3DResourceRequest);
 
 		if (Server->RegisterResourceTemplate(MoveTemp(T3DTemplateDefinition)))
 		{
-			UE_LOG(LogUnrealMCPServer, Log, TEXT("Registered T3D Blueprint Resource Template (unreal+t3d://{filepath}) for discovery and handling."));
+			UE_LOG(LogUnrealMCPServer, Log, TEXT("Registered T3D Blueprint Resource Template (unreal+t3d://{filepath}{?offset,length,block}) for discovery and handling."));
 		}
 		else
 		{
@@ -157,15 +235,15 @@ void FUMCP_CommonResources::Register(class FUMCP_Server* Server)
 	{
 		FUMCP_ResourceTemplateDefinition MarkdownTemplateDefinition;
 		MarkdownTemplateDefinition.name = TEXT("Blueprint Markdown Summary");
-		MarkdownTemplateDefinition.description = TEXT("Exports the markdown representation of an Unreal Engine Blueprint asset specified by its path using the unreal+md://{filepath} URI scheme. Provides a structured summary of the Blueprint's graph, variables, functions, and events.");
+		MarkdownTemplateDefinition.description = TEXT("Exports the markdown representation of an Unreal Engine Blueprint asset specified by its path using the unreal+md://{filepath} URI scheme. Provides a structured summary of the Blueprint's graph, variables, functions, and events. Large exports can be read in chunks with offset and length, in characters; _meta.nextUri reads on.");
 		MarkdownTemplateDefinition.mimeType = TEXT("text/markdown");
-		MarkdownTemplateDefinition.uriTemplate = TEXT("unreal+md://{filepath}");
+		MarkdownTemplateDefinition.uriTemplate = TEXT("unreal+md://{filepath}{?offset,length}");
 		// Bind the actual handler for this templated resource
 		MarkdownTemplateDefinition.ReadResource.BindRaw(this, &FUMCP_CommonResources::HandleMarkdownResourceRequest);
 
 		if (Server->RegisterResourceTemplate(MoveTemp(MarkdownTemplateDefinition)))
 		{
-			UE_LOG(LogUnrealMCPServer, Log, TEXT("Registered Markdown Blueprint Resource Template (unreal+md://{filepath}) for discovery and handling."));
+			UE_LOG(LogUnrealMCPServer, Log, TEXT("Registered Markdown Blueprint Resource Template (unreal+md://{filepath}{?offset,length}) for discovery and handling."));
 		}
 		else
 		{
@@ -174,116 +252,193 @@ void FUMCP_CommonResources::Register(class FUMCP_Server* Server)
 	}
 }
 
-bool FUMCP_CommonResources::HandleT3DResourceRequest(const FUMCP_UriTemplate& UriTemplate, const FUMCP_UriTemplateMatch& Match, TArray<FUMCP_ReadResourceResultContent>& OutContent)
+bool FUMCP_CommonResources::HandleT3DResourceRequest(const FUMCP_UriTemplate& UriTemplate, const FUMCP_UriTemplateMatchView& Match, TArray<FUMCP_ReadResourceResultContent>& OutContent)
 {
 	auto& Content = OutContent.AddDefaulted_GetRef();
-	Content.uri = Match.Uri;
+	Content.uri = FString(Match.Uri);
 	
-	const TArray<FString>* FilePathPtr = Match.Variables.Find(TEXT("filepath"));
-	if (!FilePathPtr || FilePathPtr->IsEmpty() || (*FilePathPtr)[0].IsEmpty())
+	// Only the variable we need is percent-decoded
+	FString BlueprintPath;
+	if (!Match.GetValue(TEXT("filepath"), BlueprintPath) || BlueprintPath.IsEmpty())
 	{
-		UE_LOG(LogUnrealMCPServer, Warning, TEXT("HandleT3DResourceRequest: 'filepath' not found in URI '%s' after matching template '%s'."), *Match.Uri, *UriTemplate.GetUriTemplateStr());
+		UE_LOG(LogUnrealMCPServer, Warning, TEXT("HandleT3DResourceRequest: 'filepath' not found in URI '%s' after matching template '%s'."), *Content.uri, *UriTemplate.GetUriTemplateStr());
         Content.mimeType = TEXT("text/plain");
         Content.text = TEXT("Error: Missing 'filepath' parameter in URI.");
 		return false; 
 	}
 	
-	const FString& BlueprintPath = (*FilePathPtr)[0];
-	UE_LOG(LogUnrealMCPServer, Log, TEXT("HandleT3DResourceRequest: Attempting to export Blueprint '%s' from URI '%s'."), *BlueprintPath, *Match.Uri);
+	UE_LOG(LogUnrealMCPServer, Log, TEXT("HandleT3DResourceRequest: Attempting to export Blueprint '%s' from URI '%s'."), *BlueprintPath, *Content.uri);
 
-	UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
-	if (!Blueprint)
+	FUMCP_ExportRange Range;
+	bool bRanged = false;
+	FString ExportError;
+	if (!GetExportRange(Match, Range, bRanged, ExportError))
 	{
-		UE_LOG(LogUnrealMCPServer, Warning, TEXT("Failed to load Blueprint: %s"), *BlueprintPath);
+		UE_LOG(LogUnrealMCPServer, Warning, TEXT("HandleT3DResourceRequest: %s"), *ExportError);
         Content.mimeType = TEXT("text/plain");
-        Content.text = FString::Printf(TEXT("Error: Failed to load Blueprint: %s"), *BlueprintPath);
+        Content.text = TEXT("Error: ") + ExportError;
 		return false;
 	}
 
-	UExporter* Exporter = UExporter::FindExporter(Blueprint, TEXT("T3D"));
-	if (!Exporter)
+	auto Export = [this, &BlueprintPath](FString& OutText, FString& OutExportError)
 	{
-		UE_LOG(LogUnrealMCPServer, Warning, TEXT("Failed to find T3D exporter for Blueprint: %s"), *BlueprintPath);
-        Content.mimeType = TEXT("text/plain");
-        Content.text = FString::Printf(TEXT("Error: Failed to find T3D exporter for Blueprint: %s"), *BlueprintPath);
-		return false;
-	}
+		UBlueprint* Blueprint = Cast<UBlueprint>(Server->GetPackageLoader().LoadObject(BlueprintPath));
+		if (!Blueprint)
+		{
+			OutExportError = FString::Printf(TEXT("Failed to load Blueprint: %s"), *BlueprintPath);
+			return false;
+		}
 
-	FStringOutputDevice OutputDevice;
-	const uint32 ExportFlags = PPF_Copy | PPF_ExportsNotFullyQualified;
-	Exporter->ExportText(nullptr, Blueprint, TEXT("T3D"), OutputDevice, GWarn, ExportFlags);
+		UExporter* Exporter = UExporter::FindExporter(Blueprint, TEXT("T3D"));
+		if (!Exporter)
+		{
+			OutExportError = FString::Printf(TEXT("Failed to find T3D exporter for Blueprint: %s"), *BlueprintPath);
+			return false;
+		}
 
-	if (OutputDevice.IsEmpty())
+		FStringOutputDevice OutputDevice;
+		const uint32 ExportFlags = PPF_Copy | PPF_ExportsNotFullyQualified;
+		{
+			UMCP_TRACE_SCOPE(UMCP_ExportText);
+			Exporter->ExportText(nullptr, Blueprint, TEXT("T3D"), OutputDevice, GWarn, ExportFlags);
+		}
+
+		if (OutputDevice.IsEmpty())
+		{
+			OutExportError = FString::Printf(TEXT("ExportText did not produce any output for Blueprint: %s. Using exporter: %s."), *BlueprintPath, *Exporter->GetClass()->GetName());
+			return false;
+		}
+
+		OutText = OutputDevice;
+		return true;
+	};
+
+	bool bExported = false;
+	if (bRanged)
 	{
-		UE_LOG(LogUnrealMCPServer, Warning, TEXT("ExportText did not produce any output for Blueprint: %s. Using exporter: %s."), *BlueprintPath, *Exporter->GetClass()->GetName());
+		FUMCP_ExportSlice Slice;
+		bExported = Server->GetExportCache().GetOrExportSlice(BlueprintPath, TEXT("T3D"), Export, Range, &FUMCP_T3DStreamReader::FindObjectBlocks, Slice, ExportError);
+		if (bExported)
+		{
+			Content.text = MoveTemp(Slice.Text);
+			Content.meta = MakeSliceMeta(Match.Uri, Range, Slice);
+		}
+	}
+	else
+	{
+		bExported = Server->GetExportCache().GetOrExport(BlueprintPath, TEXT("T3D"), Export, Content.text, ExportError);
+	}
+	Server->GetPackageLoader().ReleaseIfOverWatermark();
+
+	if (!bExported)
+	{
+		UE_LOG(LogUnrealMCPServer, Warning, TEXT("HandleT3DResourceRequest: %s"), *ExportError);
         Content.mimeType = TEXT("text/plain");
-        Content.text = FString::Printf(TEXT("Error: ExportText did not produce any output for Blueprint: %s."), *BlueprintPath);
+        Content.text = TEXT("Error: ") + ExportError;
 		return false;
 	}
 
 	Content.mimeType = TEXT("application/vnd.unreal.t3d");
-	Content.text = OutputDevice;
 	
-	UE_LOG(LogUnrealMCPServer, Log, TEXT("Successfully exported Blueprint '%s' to T3D via URI '%s'. Output size: %d"), *BlueprintPath, *Match.Uri, Content.text.Len());
+	UE_LOG(LogUnrealMCPServer, Log, TEXT("Successfully exported Blueprint '%s' to T3D via URI '%s'. Output size: %d"), *BlueprintPath, *Content.uri, Content.text.Len());
 	return true;
 }
 
-bool FUMCP_CommonResources::HandleMarkdownResourceRequest(const FUMCP_UriTemplate& UriTemplate, const FUMCP_UriTemplateMatch& Match, TArray<FUMCP_ReadResourceResultContent>& OutContent)
+bool FUMCP_CommonResources::HandleMarkdownResourceRequest(const FUMCP_UriTemplate& UriTemplate, const FUMCP_UriTemplateMatchView& Match, TArray<FUMCP_ReadResourceResultContent>& OutContent)
 {
 	auto& Content = OutContent.AddDefaulted_GetRef();
-	Content.uri = Match.Uri;
+	Content.uri = FString(Match.Uri);
 	
-	const TArray<FString>* FilePathPtr = Match.Variables.Find(TEXT("filepath"));
-	if (!FilePathPtr || FilePathPtr->IsEmpty() || (*FilePathPtr)[0].IsEmpty())
+	// Only the variable we need is percent-decoded
+	FString BlueprintPath;
+	if (!Match.GetValue(TEXT("filepath"), BlueprintPath) || BlueprintPath.IsEmpty())
 	{
-		UE_LOG(LogUnrealMCPServer, Warning, TEXT("HandleMarkdownResourceRequest: 'filepath' not found in URI '%s' after matching template '%s'."), *Match.Uri, *UriTemplate.GetUriTemplateStr());
+		UE_LOG(LogUnrealMCPServer, Warning, TEXT("HandleMarkdownResourceRequest: 'filepath' not found in URI '%s' after matching template '%s'."), *Content.uri, *UriTemplate.GetUriTemplateStr());
         Content.mimeType = TEXT("text/plain");
         Content.text = TEXT("Error: Missing 'filepath' parameter in URI.");
 		return false; 
 	}
 	
-	const FString& BlueprintPath = (*FilePathPtr)[0];
-	UE_LOG(LogUnrealMCPServer, Log, TEXT("HandleMarkdownResourceRequest: Attempting to export Blueprint '%s' to markdown from URI '%s'."), *BlueprintPath, *Match.Uri);
+	UE_LOG(LogUnrealMCPServer, Log, TEXT("HandleMarkdownResourceRequest: Attempting to export Blueprint '%s' to markdown from URI '%s'."), *BlueprintPath, *Content.uri);
 
-	// Load the Blueprint object
-	UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
-	if (!Blueprint)
+	FUMCP_ExportRange Range;
+	bool bRanged = false;
+	FString ExportError;
+	if (!GetExportRange(Match, Range, bRanged, ExportError))
 	{
-		UE_LOG(LogUnrealMCPServer, Warning, TEXT("Failed to load Blueprint: %s"), *BlueprintPath);
+		UE_LOG(LogUnrealMCPServer, Warning, TEXT("HandleMarkdownResourceRequest: %s"), *ExportError);
         Content.mimeType = TEXT("text/plain");
-        Content.text = FString::Printf(TEXT("Error: Failed to load Blueprint: %s"), *BlueprintPath);
+        Content.text = TEXT("Error: ") + ExportError;
 		return false;
 	}
 
-	// Find markdown exporter
-	UExporter* Exporter = UExporter::FindExporter(Blueprint, TEXT("md"));
-	if (!Exporter)
+	auto Export = [this, &BlueprintPath](FString& OutText, FString& OutExportError)
 	{
-		UE_LOG(LogUnrealMCPServer, Warning, TEXT("Failed to find markdown exporter for Blueprint: %s. BP2AI plugin may not be available."), *BlueprintPath);
-        Content.mimeType = TEXT("text/plain");
-        Content.text = FString::Printf(TEXT("Error: Failed to find markdown exporter for Blueprint: %s. BP2AI plugin may not be available."), *BlueprintPath);
-		return false;
+		// Load the Blueprint object
+		UBlueprint* Blueprint = Cast<UBlueprint>(Server->GetPackageLoader().LoadObject(BlueprintPath));
+		if (!Blueprint)
+		{
+			OutExportError = FString::Printf(TEXT("Failed to load Blueprint: %s"), *BlueprintPath);
+			return false;
+		}
+
+		// Find markdown exporter
+		UExporter* Exporter = UExporter::FindExporter(Blueprint, TEXT("md"));
+		if (!Exporter)
+		{
+			OutExportError = FString::Printf(TEXT("Failed to find markdown exporter for Blueprint: %s. BP2AI plugin may not be available."), *BlueprintPath);
+			return false;
+		}
+
+		// Export to markdown
+		FStringOutputDevice OutputDevice;
+		const uint32 ExportFlags = PPF_Copy | PPF_ExportsNotFullyQualified;
+		UE_LOG(LogUnrealMCPServer, Verbose, TEXT("HandleMarkdownResourceRequest: Exporting Blueprint '%s' to markdown format using exporter: %s"), 
+			*BlueprintPath, *Exporter->GetClass()->GetName());
+		{
+			UMCP_TRACE_SCOPE(UMCP_ExportText);
+			Exporter->ExportText(nullptr, Blueprint, TEXT("md"), OutputDevice, GWarn, ExportFlags);
+		}
+		
+		if (OutputDevice.IsEmpty())
+		{
+			OutExportError = FString::Printf(TEXT("ExportText did not produce any output for Blueprint: %s. Using exporter: %s."), 
+				*BlueprintPath, *Exporter->GetClass()->GetName());
+			return false;
+		}
+
+		OutText = OutputDevice;
+		return true;
+	};
+
+	bool bExported = false;
+	if (bRanged)
+	{
+		// Markdown has no object blocks, only character ranges
+		FUMCP_ExportSlice Slice;
+		bExported = Server->GetExportCache().GetOrExportSlice(BlueprintPath, TEXT("md"), Export, Range, nullptr, Slice, ExportError);
+		if (bExported)
+		{
+			Content.text = MoveTemp(Slice.Text);
+			Content.meta = MakeSliceMeta(Match.Uri, Range, Slice);
+		}
 	}
+	else
+	{
+		bExported = Server->GetExportCache().GetOrExport(BlueprintPath, TEXT("md"), Export, Content.text, ExportError);
+	}
+	Server->GetPackageLoader().ReleaseIfOverWatermark();
 
-	// Export to markdown
-	FStringOutputDevice OutputDevice;
-	const uint32 ExportFlags = PPF_Copy | PPF_ExportsNotFullyQualified;
-	UE_LOG(LogUnrealMCPServer, Verbose, TEXT("HandleMarkdownResourceRequest: Exporting Blueprint '%s' to markdown format using exporter: %s"), 
-		*BlueprintPath, *Exporter->GetClass()->GetName());
-	Exporter->ExportText(nullptr, Blueprint, TEXT("md"), OutputDevice, GWarn, ExportFlags);
-	
-	if (OutputDevice.IsEmpty())
+	if (!bExported)
 	{
-		UE_LOG(LogUnrealMCPServer, Warning, TEXT("ExportText did not produce any output for Blueprint: %s. Using exporter: %s."), 
-			*BlueprintPath, *Exporter->GetClass()->GetName());
+		UE_LOG(LogUnrealMCPServer, Warning, TEXT("HandleMarkdownResourceRequest: %s"), *ExportError);
         Content.mimeType = TEXT("text/plain");
-        Content.text = FString::Printf(TEXT("Error: ExportText did not produce any output for Blueprint: %s."), *BlueprintPath);
+        Content.text = TEXT("Error: ") + ExportError;
 		return false;
 	}
 
 	Content.mimeType = TEXT("text/markdown");
-	Content.text = OutputDevice;
 	
-	UE_LOG(LogUnrealMCPServer, Log, TEXT("Successfully exported Blueprint '%s' to markdown via URI '%s'. Output size: %d"), *BlueprintPath, *Match.Uri, Content.text.Len());
+	UE_LOG(LogUnrealMCPServer, Log, TEXT("Successfully exported Blueprint '%s' to markdown via URI '%s'. Output size: %d"), *BlueprintPath, *Content.uri, Content.text.Len());
 	return true;
 }
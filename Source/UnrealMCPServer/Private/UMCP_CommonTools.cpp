@@ -15,16 +15,19 @@
 #include "HAL/PlatformTime.h"
 #include "Misc/FileHelper.h"
 
-void FUMCP_CommonTools::Register(class FUMCP_Server* Server)
+void FUMCP_CommonTools::Register(class FUMCP_Server* InServer, bool bEditorTools)
 {
+	Server = InServer;
+
 	{
 		FUMCP_ToolDefinition Tool;
 		Tool.name = TEXT("get_project_config");
 		Tool.description = TEXT("Retrieve project and engine configuration information including engine version, directory paths (Engine, Project, Content, Log, Saved, Config, Plugins), and other essential project metadata. Use this tool first to understand the project structure before performing asset operations. Returns absolute paths that can be used in other tool calls.");
 		Tool.DoToolCall.BindRaw(this, &FUMCP_CommonTools::GetProjectConfig);
+		Tool.ExecutionAffinity = EUMCP_ExecutionAffinity::AnyThread;
 		
 		// Generate input schema from USTRUCT (empty params struct)
-		Tool.inputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_GetProjectConfigParams>();
+		Tool.InputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_GetProjectConfigParams>();
 		
 		// Generate output schema from USTRUCT with descriptions
 		TMap<FString, FString> OutputDescriptions;
@@ -49,15 +52,7 @@ void FUMCP_CommonTools::Register(class FUMCP_Server* Server)
 		OutputRequired.Add(TEXT("engineVersion"));
 		OutputRequired.Add(TEXT("paths"));
 		
-		TSharedPtr<FJsonObject> ProjectConfigOutputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_GetProjectConfigResult>(OutputDescriptions, OutputRequired);
-		if (ProjectConfigOutputSchema.IsValid())
-		{
-			Tool.outputSchema = ProjectConfigOutputSchema;
-		}
-		else
-		{
-			UE_LOG(LogUnrealMCPServer, Error, TEXT("Failed to generate outputSchema for get_project_config tool"));
-		}
+		Tool.OutputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_GetProjectConfigResult>(OutputDescriptions, OutputRequired);
 		Server->RegisterTool(MoveTemp(Tool));
 	}
 	
@@ -72,7 +67,7 @@ void FUMCP_CommonTools::Register(class FUMCP_Server* Server)
 		InputDescriptions.Add(TEXT("command"), TEXT("The console command to execute. Examples: 'stat fps' (performance), 'showdebug ai' (AI debugging), 'r.SetRes 1920x1080' (resolution), 'open /Game/Maps/MainLevel' (load level), 'stat unit' (frame timing), 'quit' (exit editor). Warning: Some commands can modify the editor state or project. Use with caution for commands that modify assets or project settings."));
 		TArray<FString> InputRequired;
 		InputRequired.Add(TEXT("command"));
-		Tool.inputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_ExecuteConsoleCommandParams>(InputDescriptions, InputRequired);
+		Tool.InputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_ExecuteConsoleCommandParams>(InputDescriptions, InputRequired);
 		
 		// Generate output schema from USTRUCT with descriptions
 		TMap<FString, FString> OutputDescriptions;
@@ -83,15 +78,7 @@ void FUMCP_CommonTools::Register(class FUMCP_Server* Server)
 		TArray<FString> OutputRequired;
 		OutputRequired.Add(TEXT("bSuccess"));
 		OutputRequired.Add(TEXT("command"));
-		TSharedPtr<FJsonObject> ExecuteConsoleCommandOutputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_ExecuteConsoleCommandResult>(OutputDescriptions, OutputRequired);
-		if (ExecuteConsoleCommandOutputSchema.IsValid())
-		{
-			Tool.outputSchema = ExecuteConsoleCommandOutputSchema;
-		}
-		else
-		{
-			UE_LOG(LogUnrealMCPServer, Error, TEXT("Failed to generate outputSchema for execute_console_command tool"));
-		}
+		Tool.OutputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_ExecuteConsoleCommandResult>(OutputDescriptions, OutputRequired);
 		Server->RegisterTool(MoveTemp(Tool));
 	}
 	
@@ -100,43 +87,73 @@ void FUMCP_CommonTools::Register(class FUMCP_Server* Server)
 		Tool.name = TEXT("get_log_file_path");
 		Tool.description = TEXT("Returns the absolute path of the Unreal Engine log file. Use this to locate log files for debugging. Log files are plain text and can be read with standard file reading tools. Note: The log file path changes when the editor restarts. Call this tool when you need the current log file location.");
 		Tool.DoToolCall.BindRaw(this, &FUMCP_CommonTools::GetLogFilePath);
+		Tool.ExecutionAffinity = EUMCP_ExecutionAffinity::AnyThread;
 		
 		// Generate input schema from USTRUCT (empty params struct)
-		Tool.inputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_GetLogFilePathParams>();
+		Tool.InputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_GetLogFilePathParams>();
 		
 		// Generate output schema from USTRUCT with descriptions
 		TMap<FString, FString> OutputDescriptions;
 		OutputDescriptions.Add(TEXT("logFilePath"), TEXT("The full path to the Unreal Engine log file"));
 		TArray<FString> OutputRequired;
 		OutputRequired.Add(TEXT("logFilePath"));
-		TSharedPtr<FJsonObject> GetLogFilePathOutputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_GetLogFilePathResult>(OutputDescriptions, OutputRequired);
-		if (GetLogFilePathOutputSchema.IsValid())
-		{
-			Tool.outputSchema = GetLogFilePathOutputSchema;
-		}
-		else
-		{
-			UE_LOG(LogUnrealMCPServer, Error, TEXT("Failed to generate outputSchema for get_log_file_path tool"));
-		}
+		Tool.OutputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_GetLogFilePathResult>(OutputDescriptions, OutputRequired);
 		Server->RegisterTool(MoveTemp(Tool));
 	}
 	
+	{
+		FUMCP_ToolDefinition Tool;
+		Tool.name = TEXT("get_log_lines");
+		Tool.description = TEXT("Returns recent editor log lines from an in-memory buffer, without reading the log file. Every line has a sequence number; pass the returned nextCursor as cursor on the next call to get only the lines logged since. Call with cursor -1 before execute_console_command, request_editor_compile or an import to get a cursor, then again afterwards to see exactly what it logged. Filter by categories (e.g. ['LogBlueprint']), minVerbosity (e.g. 'Warning' for warnings and errors) and contains. The buffer keeps the most recent LogBufferLines lines (default 8192); missedLines reports lines that were overwritten before they were read.");
+		Tool.DoToolCall.BindRaw(this, &FUMCP_CommonTools::GetLogLines);
+		Tool.ExecutionAffinity = EUMCP_ExecutionAffinity::AnyThread;
+		
+		// Generate input schema from USTRUCT with descriptions
+		TMap<FString, FString> InputDescriptions;
+		InputDescriptions.Add(TEXT("cursor"), TEXT("nextCursor from the previous call. 0 (default) starts at the oldest line kept; -1 returns no lines, only the cursor for lines logged from now on."));
+		InputDescriptions.Add(TEXT("categories"), TEXT("Log categories to return, e.g. ['LogBlueprint', 'LogLiveCoding']. Empty (default) returns all categories."));
+		InputDescriptions.Add(TEXT("minVerbosity"), TEXT("Least severe verbosity to return: 'Fatal', 'Error', 'Warning', 'Display', 'Log', 'Verbose' or 'VeryVerbose'. 'Warning' returns warnings and errors. Empty (default) returns all."));
+		InputDescriptions.Add(TEXT("contains"), TEXT("Only return lines containing this text, ignoring case."));
+		InputDescriptions.Add(TEXT("maxLines"), TEXT("Maximum number of lines to return (default 500, at most 5000). If more match, call again with nextCursor."));
+		Tool.InputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_GetLogLinesParams>(InputDescriptions);
+		
+		// Generate output schema from USTRUCT with descriptions
+		TMap<FString, FString> OutputDescriptions;
+		OutputDescriptions.Add(TEXT("lines"), TEXT("Matching lines in the order they were logged: sequence, time (seconds since the editor started), category, verbosity, text and bTruncated (text cut at 1024 characters)"));
+		OutputDescriptions.Add(TEXT("nextCursor"), TEXT("Pass as cursor to get the lines logged after these"));
+		OutputDescriptions.Add(TEXT("missedLines"), TEXT("Lines after cursor that were overwritten in the buffer before they could be read"));
+		OutputDescriptions.Add(TEXT("bufferCapacity"), TEXT("Number of lines the buffer keeps; 0 if it is disabled"));
+		OutputDescriptions.Add(TEXT("error"), TEXT("Error message if the parameters were invalid"));
+		TArray<FString> OutputRequired;
+		OutputRequired.Add(TEXT("lines"));
+		OutputRequired.Add(TEXT("nextCursor"));
+		Tool.OutputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_GetLogLinesResult>(OutputDescriptions, OutputRequired);
+		Server->RegisterTool(MoveTemp(Tool));
+	}
+
+	if (!bEditorTools)
+	{
+		return;
+	}
+	
 	{
 		FUMCP_ToolDefinition Tool;
 		Tool.name = TEXT("request_editor_compile");
 		Tool.description = TEXT("Requests an editor compilation, waits for completion, and returns whether it succeeded or failed along with any build log generated. Use this after modifying C++ source files to recompile code changes without restarting the editor. Only works if the project has C++ code and live coding is enabled in editor settings. Default timeout is 300 seconds (5 minutes). Compilation may take longer for large projects. Returns success status, build log, and extracted errors/warnings. Check the build log for compilation errors if compilation fails.");
-		Tool.DoToolCall.BindRaw(this, &FUMCP_CommonTools::RequestEditorCompile);
+		Tool.StartJob.BindRaw(this, &FUMCP_CommonTools::StartRequestEditorCompile);
+		Tool.bSingleInstanceJob = true; // Live Coding runs one compile at a time
+		Tool.Priority = EUMCP_RequestPriority::Low;
 		
 		// Generate input schema from USTRUCT with descriptions
 		TMap<FString, FString> InputDescriptions;
 		InputDescriptions.Add(TEXT("timeoutSeconds"), TEXT("Optional timeout in seconds for waiting for compilation to complete. Default: 300 seconds (5 minutes). For large projects, you may need to increase this value. Compilation will be cancelled if it exceeds this timeout."));
-		Tool.inputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_RequestEditorCompileParams>(InputDescriptions);
+		Tool.InputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_RequestEditorCompileParams>(InputDescriptions);
 		
 		// Generate output schema from USTRUCT with descriptions
 		TMap<FString, FString> OutputDescriptions;
 		OutputDescriptions.Add(TEXT("bSuccess"), TEXT("Whether the compilation completed successfully"));
 		OutputDescriptions.Add(TEXT("bCompileStarted"), TEXT("Whether compilation was successfully initiated"));
-		OutputDescriptions.Add(TEXT("status"), TEXT("Compilation status: 'completed', 'failed', 'timeout', 'not_available', or 'error'"));
+		OutputDescriptions.Add(TEXT("status"), TEXT("Compilation status: 'completed', 'failed', 'timeout', 'cancelled', 'not_available', or 'error'"));
 		OutputDescriptions.Add(TEXT("buildLog"), TEXT("Full build log output from the compilation"));
 		OutputDescriptions.Add(TEXT("errors"), TEXT("Array of extracted error messages from the build log"));
 		OutputDescriptions.Add(TEXT("warnings"), TEXT("Array of extracted warning messages from the build log"));
@@ -145,15 +162,7 @@ void FUMCP_CommonTools::Register(class FUMCP_Server* Server)
 		OutputRequired.Add(TEXT("bSuccess"));
 		OutputRequired.Add(TEXT("bCompileStarted"));
 		OutputRequired.Add(TEXT("status"));
-		TSharedPtr<FJsonObject> RequestEditorCompileOutputSchema = UMCP_GenerateJsonSchemaFromStruct<FUMCP_RequestEditorCompileResult>(OutputDescriptions, OutputRequired);
-		if (RequestEditorCompileOutputSchema.IsValid())
-		{
-			Tool.outputSchema = RequestEditorCompileOutputSchema;
-		}
-		else
-		{
-			UE_LOG(LogUnrealMCPServer, Error, TEXT("Failed to generate outputSchema for request_editor_compile tool"));
-		}
+		Tool.OutputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_RequestEditorCompileResult>(OutputDescriptions, OutputRequired);
 		Server->RegisterTool(MoveTemp(Tool));
 	}
 }
@@ -194,7 +203,7 @@ bool FUMCP_CommonTools::GetProjectConfig(TSharedPtr<FJsonObject> arguments, TArr
 	Result.paths.enginePluginsDir = FPaths::EnginePluginsDir();
 
 	// Convert USTRUCT to JSON string at the end
-	if (!UMCP_ToJsonString(Result, Content.text))
+	if (!UMCP_SetStructuredContent(Result, Content))
 	{
 		Content.text = TEXT("Failed to serialize result");
 		return false;
@@ -219,7 +228,7 @@ bool FUMCP_CommonTools::ExecuteConsoleCommand(TSharedPtr<FJsonObject> arguments,
 		ErrorResult.command = TEXT("");
 		ErrorResult.output = TEXT("");
 		ErrorResult.error = TEXT("Invalid parameters");
-		if (!UMCP_ToJsonString(ErrorResult, Content.text))
+		if (!UMCP_SetStructuredContent(ErrorResult, Content))
 		{
 			Content.text = TEXT("Failed to serialize error result");
 		}
@@ -235,7 +244,7 @@ bool FUMCP_CommonTools::ExecuteConsoleCommand(TSharedPtr<FJsonObject> arguments,
 	{
 		Result.output = TEXT("");
 		Result.error = TEXT("Missing required parameter: command");
-		if (!UMCP_ToJsonString(Result, Content.text))
+		if (!UMCP_SetStructuredContent(Result, Content))
 		{
 			Content.text = TEXT("Failed to serialize error result");
 		}
@@ -283,7 +292,7 @@ bool FUMCP_CommonTools::ExecuteConsoleCommand(TSharedPtr<FJsonObject> arguments,
 	}
 
 	// Convert USTRUCT to JSON string at the end
-	if (!UMCP_ToJsonString(Result, Content.text))
+	if (!UMCP_SetStructuredContent(Result, Content))
 	{
 		Content.text = TEXT("Failed to serialize result");
 		return false;
@@ -310,6 +319,12 @@ bool FUMCP_CommonTools::GetLogFilePath(TSharedPtr<FJsonObject> arguments, TArray
 	// Work with USTRUCT throughout
 	FUMCP_GetLogFilePathResult Result;
 	
+	// The caller is about to read the file, so make sure everything logged so far is on disk
+	if (GLog)
+	{
+		GLog->Flush();
+	}
+
 	// Get the log file path from the platform output devices
 	FString LogFilePath = FPlatformOutputDevices::GetAbsoluteLogFilename();
 	
@@ -333,7 +348,7 @@ bool FUMCP_CommonTools::GetLogFilePath(TSharedPtr<FJsonObject> arguments, TArray
 	Result.logFilePath = LogFilePath;
 
 	// Convert USTRUCT to JSON string at the end
-	if (!UMCP_ToJsonString(Result, Content.text))
+	if (!UMCP_SetStructuredContent(Result, Content))
 	{
 		Content.text = TEXT("Failed to serialize result");
 		return false;
@@ -344,212 +359,327 @@ bool FUMCP_CommonTools::GetLogFilePath(TSharedPtr<FJsonObject> arguments, TArray
 	return true;
 }
 
-bool FUMCP_CommonTools::RequestEditorCompile(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent)
+bool FUMCP_CommonTools::GetLogLines(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent)
 {
 	auto& Content = OutContent.Add_GetRef(FUMCP_CallToolResultContent());
 	Content.type = TEXT("text");
 
 	// Convert JSON to USTRUCT at the start
-	FUMCP_RequestEditorCompileParams Params;
-	if (!arguments.IsValid() || !UMCP_CreateFromJsonObject(arguments, Params))
+	FUMCP_GetLogLinesParams Params;
+	if (arguments.IsValid() && !UMCP_CreateFromJsonObject(arguments, Params, true))
 	{
-		FUMCP_RequestEditorCompileResult ErrorResult;
-		ErrorResult.bSuccess = false;
-		ErrorResult.bCompileStarted = false;
-		ErrorResult.status = TEXT("error");
-		ErrorResult.buildLog = TEXT("");
-		ErrorResult.error = TEXT("Invalid parameters");
-		if (!UMCP_ToJsonString(ErrorResult, Content.text))
-		{
-			Content.text = TEXT("Failed to serialize error result");
-		}
+		Content.text = TEXT("Invalid parameters");
 		return false;
 	}
 
 	// Work with USTRUCT throughout
-	FUMCP_RequestEditorCompileResult Result;
-	Result.bSuccess = false;
-	Result.bCompileStarted = false;
-	Result.status = TEXT("error");
-	Result.buildLog = TEXT("");
-	Result.error = TEXT("");
-
-	UE_LOG(LogUnrealMCPServer, Log, TEXT("RequestEditorCompile: Requesting editor compilation (timeout: %.1f seconds)"), Params.timeoutSeconds);
+	FUMCP_GetLogLinesResult Result;
+	const FUMCP_LogBuffer& LogBuffer = Server->GetLogBuffer();
+	Result.bufferCapacity = LogBuffer.GetStats().Capacity;
 
-	// Check if Live Coding is available
-	ILiveCodingModule* LiveCodingModule = FModuleManager::GetModulePtr<ILiveCodingModule>(TEXT("LiveCoding"));
-	if (!LiveCodingModule)
+	ELogVerbosity::Type MinVerbosity = ELogVerbosity::All;
+	if (!Params.minVerbosity.IsEmpty())
 	{
-		Result.status = TEXT("not_available");
-		Result.error = TEXT("Live Coding module is not available. Ensure Live Coding is enabled in the editor settings.");
-		if (!UMCP_ToJsonString(Result, Content.text))
+		MinVerbosity = ParseLogVerbosityFromString(Params.minVerbosity);
+		if (MinVerbosity == ELogVerbosity::NoLogging && !Params.minVerbosity.Equals(TEXT("NoLogging"), ESearchCase::IgnoreCase))
 		{
-			Content.text = TEXT("Failed to serialize result");
+			Result.error = FString::Printf(TEXT("Unknown minVerbosity '%s'. Use Fatal, Error, Warning, Display, Log, Verbose or VeryVerbose."), *Params.minVerbosity);
+			if (!UMCP_SetStructuredContent(Result, Content))
+			{
+				Content.text = TEXT("Failed to serialize result");
+			}
+			return false;
 		}
-		return false;
 	}
 
-	// Check if Live Coding is enabled for this session
-	if (!LiveCodingModule->IsEnabledForSession())
+	if (Params.cursor < 0)
 	{
-		Result.status = TEXT("not_available");
-		Result.error = TEXT("Live Coding is not enabled for this session. Enable Live Coding in the editor settings and restart the editor.");
-		if (!UMCP_ToJsonString(Result, Content.text))
-		{
-			Content.text = TEXT("Failed to serialize result");
-		}
-		return false;
+		Result.nextCursor = static_cast<int64>(LogBuffer.GetNextSequence());
 	}
-
-	// Check if compilation is already in progress
-	if (LiveCodingModule->IsCompiling())
+	else
 	{
-		Result.status = TEXT("error");
-		Result.error = TEXT("A compilation is already in progress. Please wait for it to complete before requesting another compilation.");
-		if (!UMCP_ToJsonString(Result, Content.text))
+		TSet<FName> Categories;
+		for (const FString& Category : Params.categories)
 		{
-			Content.text = TEXT("Failed to serialize result");
+			Categories.Add(FName(*Category));
+		}
+		const int32 MaxLines = FMath::Clamp(Params.maxLines, 1, 5000);
+		TArray<FUMCP_LogLine> Lines;
+		uint64 NumMissed = 0;
+		Result.nextCursor = static_cast<int64>(LogBuffer.ReadLines(static_cast<uint64>(Params.cursor), MaxLines, [&Params, &Categories, MinVerbosity](const FUMCP_LogLine& Line)
+		{
+			// Lower verbosity values are more severe
+			return Line.Verbosity <= MinVerbosity
+				&& (Categories.Num() == 0 || Categories.Contains(Line.Category))
+				&& (Params.contains.IsEmpty() || Line.Text.Contains(Params.contains, ESearchCase::IgnoreCase));
+		}, Lines, NumMissed));
+		Result.missedLines = static_cast<int64>(NumMissed);
+
+		Result.lines.Reserve(Lines.Num());
+		for (FUMCP_LogLine& Line : Lines)
+		{
+			FUMCP_LogLineInfo& LineInfo = Result.lines.AddDefaulted_GetRef();
+			LineInfo.sequence = static_cast<int64>(Line.Sequence);
+			LineInfo.time = Line.Time;
+			LineInfo.category = Line.Category.ToString();
+			LineInfo.verbosity = ToString(Line.Verbosity);
+			LineInfo.text = MoveTemp(Line.Text);
+			LineInfo.bTruncated = Line.bTruncated;
 		}
-		return false;
 	}
 
-	// Get the log file path to read build logs from
-	FString LogFilePath = FPlatformOutputDevices::GetAbsoluteLogFilename();
-	bool bIsRelative = !LogFilePath.StartsWith(TEXT("/")) && 
-	                   (LogFilePath.Len() < 2 || LogFilePath[1] != TEXT(':'));
-	
-	if (bIsRelative)
-	{
-		FString CombinedPath = FPaths::Combine(FPaths::ProjectDir(), LogFilePath);
-		LogFilePath = FPaths::ConvertRelativePathToFull(CombinedPath);
-	}
-	else
+	// Convert USTRUCT to JSON string at the end
+	if (!UMCP_SetStructuredContent(Result, Content))
 	{
-		LogFilePath = FPaths::ConvertRelativePathToFull(LogFilePath);
+		Content.text = TEXT("Failed to serialize result");
+		return false;
 	}
+	return true;
+}
 
-	// Request compilation using the Live Coding module API
-	ELiveCodingCompileResult InitialCompileResult = ELiveCodingCompileResult::NotStarted;
-	bool bCompileRequested = LiveCodingModule->Compile(ELiveCodingCompileFlags::None, &InitialCompileResult);
-	
-	// Check the initial result
-	if (!bCompileRequested || InitialCompileResult == ELiveCodingCompileResult::NotStarted)
+bool FUMCP_CommonTools::StartRequestEditorCompile(TSharedPtr<FJsonObject> arguments, UMCP_ToolJobStep& OutStep, TArray<FUMCP_CallToolResultContent>& OutContent)
+{
+	// Convert JSON to USTRUCT at the start
+	FUMCP_RequestEditorCompileParams Params;
+	if (!arguments.IsValid() || !UMCP_CreateFromJsonObject(arguments, Params))
 	{
-		Result.bCompileStarted = false;
-		Result.status = TEXT("error");
-		Result.error = TEXT("Failed to start compilation. Live Coding may not be properly configured.");
-		if (!UMCP_ToJsonString(Result, Content.text))
+		auto& Content = OutContent.Add_GetRef(FUMCP_CallToolResultContent());
+		Content.type = TEXT("text");
+		FUMCP_RequestEditorCompileResult ErrorResult;
+		ErrorResult.bSuccess = false;
+		ErrorResult.bCompileStarted = false;
+		ErrorResult.status = TEXT("error");
+		ErrorResult.buildLog = TEXT("");
+		ErrorResult.error = TEXT("Invalid parameters");
+		if (!UMCP_SetStructuredContent(ErrorResult, Content))
 		{
-			Content.text = TEXT("Failed to serialize result");
+			Content.text = TEXT("Failed to serialize error result");
 		}
 		return false;
 	}
 
-	if (InitialCompileResult == ELiveCodingCompileResult::CompileStillActive)
+	// The first step starts the compile; later steps poll it, so as a job the editor keeps ticking while Live Coding runs
+	struct FEditorCompileState
+	{
+		FUMCP_RequestEditorCompileParams Params;
+		FUMCP_RequestEditorCompileResult Result;
+		bool bCompileRequested = false;
+		bool bCompilationComplete = false;
+		FDelegateHandle PatchCompleteHandle;
+		double TimeoutTime = 0.0;
+		double NotCompilingSince = 0.0; // When IsCompiling() was first seen false without the delegate firing
+	};
+	TSharedRef<FEditorCompileState> State = MakeShared<FEditorCompileState>();
+	State->Params = Params;
+
+	OutStep = [this, State](FUMCP_JobContext& Context, FUMCP_CallToolResult& OutResult)
 	{
-		Result.bCompileStarted = false;
-		Result.status = TEXT("error");
-		Result.error = TEXT("A compilation is already in progress.");
-		if (!UMCP_ToJsonString(Result, Content.text))
+		ILiveCodingModule* LiveCodingModule = FModuleManager::GetModulePtr<ILiveCodingModule>(TEXT("LiveCoding"));
+		auto& Content = OutResult.content.Add_GetRef(FUMCP_CallToolResultContent());
+		Content.type = TEXT("text");
+
+		if (!State->bCompileRequested)
 		{
-			Content.text = TEXT("Failed to serialize result");
-		}
-		return false;
-	}
+			State->bCompileRequested = true;
+
+			// Work with USTRUCT throughout
+			State->Result.bSuccess = false;
+			State->Result.bCompileStarted = false;
+			State->Result.status = TEXT("error");
+			State->Result.buildLog = TEXT("");
+			State->Result.error = TEXT("");
+
+			UE_LOG(LogUnrealMCPServer, Log, TEXT("RequestEditorCompile: Requesting editor compilation (timeout: %.1f seconds)"), State->Params.timeoutSeconds);
+
+			// Check if Live Coding is available
+			if (!LiveCodingModule)
+			{
+				State->Result.status = TEXT("not_available");
+				State->Result.error = TEXT("Live Coding module is not available. Ensure Live Coding is enabled in the editor settings.");
+				if (!UMCP_SetStructuredContent(State->Result, Content))
+				{
+					Content.text = TEXT("Failed to serialize result");
+				}
+				OutResult.isError = true;
+				return EUMCP_JobStepResult::Finished;
+			}
 
-	// If we get here, compilation was started successfully
-	// InitialCompileResult will be InProgress if compilation started, or Success/NoChanges/Failure if it completed immediately
-	Result.bCompileStarted = true;
+			// Check if Live Coding is enabled for this session
+			if (!LiveCodingModule->IsEnabledForSession())
+			{
+				State->Result.status = TEXT("not_available");
+				State->Result.error = TEXT("Live Coding is not enabled for this session. Enable Live Coding in the editor settings and restart the editor.");
+				if (!UMCP_SetStructuredContent(State->Result, Content))
+				{
+					Content.text = TEXT("Failed to serialize result");
+				}
+				OutResult.isError = true;
+				return EUMCP_JobStepResult::Finished;
+			}
+
+			// Check if compilation is already in progress
+			if (LiveCodingModule->IsCompiling())
+			{
+				State->Result.status = TEXT("error");
+				State->Result.error = TEXT("A compilation is already in progress. Please wait for it to complete before requesting another compilation.");
+				if (!UMCP_SetStructuredContent(State->Result, Content))
+				{
+					Content.text = TEXT("Failed to serialize result");
+				}
+				OutResult.isError = true;
+				return EUMCP_JobStepResult::Finished;
+			}
+
+			// Get the log file path to read build logs from
+			FString LogFilePath = FPlatformOutputDevices::GetAbsoluteLogFilename();
+			bool bIsRelative = !LogFilePath.StartsWith(TEXT("/")) && 
+			                   (LogFilePath.Len() < 2 || LogFilePath[1] != TEXT(':'));
 	
-	// If compilation completed immediately, we can return early
-	if (InitialCompileResult == ELiveCodingCompileResult::Success || 
-	    InitialCompileResult == ELiveCodingCompileResult::NoChanges ||
-	    InitialCompileResult == ELiveCodingCompileResult::Failure ||
-	    InitialCompileResult == ELiveCodingCompileResult::Cancelled)
-	{
-		// Compilation completed immediately - get the UBT log and return
-		ELiveCodingCompileResult FinalCompileResult = InitialCompileResult;
-		return HandleCompilationComplete(LiveCodingModule, FinalCompileResult, Result, Content);
-	}
+			if (bIsRelative)
+			{
+				FString CombinedPath = FPaths::Combine(FPaths::ProjectDir(), LogFilePath);
+				LogFilePath = FPaths::ConvertRelativePathToFull(CombinedPath);
+			}
+			else
+			{
+				LogFilePath = FPaths::ConvertRelativePathToFull(LogFilePath);
+			}
 
-	// Set up completion tracking using the delegate
-	bool bCompilationComplete = false;
+			// Request compilation using the Live Coding module API
+			ELiveCodingCompileResult InitialCompileResult = ELiveCodingCompileResult::NotStarted;
+			bool bCompileRequested = LiveCodingModule->Compile(ELiveCodingCompileFlags::None, &InitialCompileResult);
 	
-	// Bind to the patch complete delegate
-	FDelegateHandle PatchCompleteHandle;
-	PatchCompleteHandle = LiveCodingModule->GetOnPatchCompleteDelegate().AddLambda([&bCompilationComplete]()
-	{
-		bCompilationComplete = true;
-	});
+			// Check the initial result
+			if (!bCompileRequested || InitialCompileResult == ELiveCodingCompileResult::NotStarted)
+			{
+				State->Result.bCompileStarted = false;
+				State->Result.status = TEXT("error");
+				State->Result.error = TEXT("Failed to start compilation. Live Coding may not be properly configured.");
+				if (!UMCP_SetStructuredContent(State->Result, Content))
+				{
+					Content.text = TEXT("Failed to serialize result");
+				}
+				OutResult.isError = true;
+				return EUMCP_JobStepResult::Finished;
+			}
 
-	// Wait for compilation to complete with timeout
-	double StartTime = FPlatformTime::Seconds();
-	double TimeoutTime = StartTime + Params.timeoutSeconds;
-	bool bCompilationSucceeded = false;
+			if (InitialCompileResult == ELiveCodingCompileResult::CompileStillActive)
+			{
+				State->Result.bCompileStarted = false;
+				State->Result.status = TEXT("error");
+				State->Result.error = TEXT("A compilation is already in progress.");
+				if (!UMCP_SetStructuredContent(State->Result, Content))
+				{
+					Content.text = TEXT("Failed to serialize result");
+				}
+				OutResult.isError = true;
+				return EUMCP_JobStepResult::Finished;
+			}
 
-	UE_LOG(LogUnrealMCPServer, Log, TEXT("RequestEditorCompile: Waiting for compilation to complete..."));
+			// If we get here, compilation was started successfully
+			// InitialCompileResult will be InProgress if compilation started, or Success/NoChanges/Failure if it completed immediately
+			State->Result.bCompileStarted = true;
+	
+			// If compilation completed immediately, we can return early
+			if (InitialCompileResult == ELiveCodingCompileResult::Success || 
+			    InitialCompileResult == ELiveCodingCompileResult::NoChanges ||
+			    InitialCompileResult == ELiveCodingCompileResult::Failure ||
+			    InitialCompileResult == ELiveCodingCompileResult::Cancelled)
+			{
+				// Compilation completed immediately - get the UBT log and return
+				ELiveCodingCompileResult FinalCompileResult = InitialCompileResult;
+				OutResult.isError = !HandleCompilationComplete(LiveCodingModule, FinalCompileResult, State->Result, Content);
+				return EUMCP_JobStepResult::Finished;
+			}
 
-	while (!bCompilationComplete && FPlatformTime::Seconds() < TimeoutTime)
-	{
-		// Check if compilation is still in progress
-		// The delegate will fire when complete, but we also check IsCompiling() as a fallback
-		if (!LiveCodingModule->IsCompiling())
+			// Bind to the patch complete delegate; the job can be dropped while compiling, so only hold a weak reference
+			TWeakPtr<FEditorCompileState> WeakState = State;
+			State->PatchCompleteHandle = LiveCodingModule->GetOnPatchCompleteDelegate().AddLambda([WeakState]()
+			{
+				if (TSharedPtr<FEditorCompileState> PinnedState = WeakState.Pin())
+				{
+					PinnedState->bCompilationComplete = true;
+				}
+			});
+
+			// Wait for compilation to complete with timeout
+			State->TimeoutTime = FPlatformTime::Seconds() + State->Params.timeoutSeconds;
+			Context.ReportProgress(0.0, 0.0, TEXT("Compiling"));
+			UE_LOG(LogUnrealMCPServer, Log, TEXT("RequestEditorCompile: Waiting for compilation to complete..."));
+			OutResult.content.Reset();
+			return EUMCP_JobStepResult::Wait;
+		}
+
+		const double Now = FPlatformTime::Seconds();
+		if (!State->bCompilationComplete && LiveCodingModule && !Context.IsCancelRequested())
 		{
-			// If not compiling and we haven't received the delegate callback yet, 
-			// give it a moment and then mark as complete
-			FPlatformProcess::Sleep(0.2f);
-			if (!LiveCodingModule->IsCompiling())
+			// The delegate fires when complete, but IsCompiling() is checked as a fallback:
+			// once it has been false for a moment without the callback, treat the compile as complete
+			if (LiveCodingModule->IsCompiling())
 			{
-				bCompilationComplete = true;
+				State->NotCompilingSince = 0.0;
+			}
+			else if (State->NotCompilingSince == 0.0)
+			{
+				State->NotCompilingSince = Now;
+			}
+			else if (Now - State->NotCompilingSince >= 0.2)
+			{
+				State->bCompilationComplete = true;
 			}
-		}
 
-		// Small sleep to avoid busy-waiting
-		FPlatformProcess::Sleep(0.1f);
-	}
+			if (!State->bCompilationComplete && Now < State->TimeoutTime)
+			{
+				OutResult.content.Reset();
+				return EUMCP_JobStepResult::Wait;
+			}
+		}
 
-	// Unbind the delegate
-	if (PatchCompleteHandle.IsValid())
-	{
-		LiveCodingModule->GetOnPatchCompleteDelegate().Remove(PatchCompleteHandle);
-	}
+		// Unbind the delegate
+		if (LiveCodingModule && State->PatchCompleteHandle.IsValid())
+		{
+			LiveCodingModule->GetOnPatchCompleteDelegate().Remove(State->PatchCompleteHandle);
+			State->PatchCompleteHandle.Reset();
+		}
 
-	// Check for timeout
-	if (!bCompilationComplete)
-	{
-		Result.status = TEXT("timeout");
-		Result.error = FString::Printf(TEXT("Compilation timed out after %.1f seconds"), Params.timeoutSeconds);
-		Result.bSuccess = false;
-		Result.buildLog = TEXT("Compilation timed out before completion.");
-		
-		// Serialize timeout result
-		if (!UMCP_ToJsonString(Result, Content.text))
+		FUMCP_RequestEditorCompileResult& Result = State->Result;
+		if (!State->bCompilationComplete)
 		{
-			Content.text = TEXT("Failed to serialize timeout result");
-			return false;
+			// Live Coding has no API to abort a compile, so cancelling and timing out both just stop waiting for it
+			const bool bCancelled = Context.IsCancelRequested();
+			Result.status = bCancelled ? TEXT("cancelled") : TEXT("timeout");
+			Result.error = bCancelled ? TEXT("Stopped waiting for the compilation; Live Coding may still be compiling")
+				: FString::Printf(TEXT("Compilation timed out after %.1f seconds"), State->Params.timeoutSeconds);
+			Result.bSuccess = false;
+			Result.buildLog = bCancelled ? TEXT("Cancelled before completion.") : TEXT("Compilation timed out before completion.");
+			
+			// Serialize timeout result
+			if (!UMCP_SetStructuredContent(Result, Content))
+			{
+				Content.text = TEXT("Failed to serialize timeout result");
+				OutResult.isError = true;
+				return EUMCP_JobStepResult::Finished;
+			}
+			
+			UE_LOG(LogUnrealMCPServer, Log, TEXT("RequestEditorCompile: %s"), *Result.error);
+			return EUMCP_JobStepResult::Finished;
 		}
-		
-		UE_LOG(LogUnrealMCPServer, Log, TEXT("RequestEditorCompile: Compilation timed out after %.1f seconds"), Params.timeoutSeconds);
-		return true;
-	}
-	else
-	{
+
 		// Compilation completed - get the final result from Live Coding
 		ELiveCodingCompileResult FinalCompileResult = ELiveCodingCompileResult::NotStarted;
 		// Call Compile again to get the final result (it will return the last result if not compiling)
 		LiveCodingModule->Compile(ELiveCodingCompileFlags::None, &FinalCompileResult);
 		
 		// Handle the completion - this will serialize the result
-		bool bHandleSuccess = HandleCompilationComplete(LiveCodingModule, FinalCompileResult, Result, Content);
+		// If it returns false, the result was already serialized with an error message
+		OutResult.isError = !HandleCompilationComplete(LiveCodingModule, FinalCompileResult, Result, Content);
 		
 		// Log the result
 		UE_LOG(LogUnrealMCPServer, Log, TEXT("RequestEditorCompile: Compilation %s (status: %s, errors: %d, warnings: %d)"), 
 			Result.bSuccess ? TEXT("succeeded") : TEXT("failed"), *Result.status, Result.errors.Num(), Result.warnings.Num());
-		
-		// Return the result from HandleCompilationComplete
-		// If it returned false, the result was already serialized with an error message
-		return bHandleSuccess;
-	}
+		return EUMCP_JobStepResult::Finished;
+	};
+	return true;
 }
 
 bool FUMCP_CommonTools::HandleCompilationComplete(ILiveCodingModule* LiveCodingModule, ELiveCodingCompileResult CompileResult, FUMCP_RequestEditorCompileResult& Result, FUMCP_CallToolResultContent& Content)
@@ -683,7 +813,7 @@ bool FUMCP_CommonTools::HandleCompilationComplete(ILiveCodingModule* LiveCodingM
 	}
 
 	// Convert USTRUCT to JSON string
-	if (!UMCP_ToJsonString(Result, Content.text))
+	if (!UMCP_SetStructuredContent(Result, Content))
 	{
 		Content.text = TEXT("Failed to serialize result");
 		UE_LOG(LogUnrealMCPServer, Error, TEXT("HandleCompilationComplete: Failed to serialize result"));
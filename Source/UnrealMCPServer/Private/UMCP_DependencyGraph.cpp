@@ -0,0 +1,457 @@
+#include "UMCP_DependencyGraph.h"
+#include "UMCP_PackageChangeNotifier.h"
+#include "UMCP_Trace.h"
+#include "UnrealMCPServerModule.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+
+// Binary snapshot layout. Little-endian, and every array starts 4-byte aligned, so the file can be memory-mapped and
+// read in place:
+//   char[8]  Magic "UMCPDEPG"
+//   uint32   Version (1)
+//   uint32   NumNodes
+//   uint32   NumEdges
+//   uint32   NumStringBytes
+//   int64    Generation
+//   uint32   StringOffsets[NumNodes + 1]  Byte offsets of each package name into StringData
+//   uint32   EdgeOffsets[NumNodes + 1]    The dependencies of node i are EdgeTargets[EdgeOffsets[i]] up to EdgeTargets[EdgeOffsets[i + 1]]
+//   uint32   EdgeTargets[NumEdges]        Node indices, ascending per node
+//   uint8    EdgeFlags[NumEdges]          1 hard, 2 soft, 3 both
+//   uint8    NodeFlags[NumNodes]          1 the package has assets in the AssetRegistry, 0 it is only depended on
+//   uint8    Padding to a multiple of 4 bytes
+//   uint8    StringData[NumStringBytes]   UTF-8 package names, not null-terminated, in node order (nodes are sorted by name)
+namespace
+{
+	const ANSICHAR DependencyGraphMagic[8] = { 'U', 'M', 'C', 'P', 'D', 'E', 'P', 'G' };
+	const uint32 DependencyGraphVersion = 1;
+
+	using FPackageEdges = TArray<TPair<FName, uint8>>;
+
+	void QueryPackageDependencies(IAssetRegistry& AssetRegistry, FName PackageName, FPackageEdges& OutEdges)
+	{
+		TArray<FAssetDependency> Dependencies;
+		AssetRegistry.GetDependencies(FAssetIdentifier(PackageName), Dependencies, UE::AssetRegistry::EDependencyCategory::Package);
+		OutEdges.Reserve(Dependencies.Num());
+		for (const FAssetDependency& Dependency : Dependencies)
+		{
+			if (!Dependency.AssetId.PackageName.IsNone() && Dependency.AssetId.PackageName != PackageName)
+			{
+				const bool bHard = EnumHasAnyFlags(Dependency.Properties, UE::AssetRegistry::EDependencyProperty::Hard);
+				OutEdges.Emplace(Dependency.AssetId.PackageName, bHard ? FUMCP_DependencyGraphSnapshot::Edge_Hard : FUMCP_DependencyGraphSnapshot::Edge_Soft);
+			}
+		}
+	}
+}
+
+int64 FUMCP_DependencyGraphSnapshot::GetAllocatedSize() const
+{
+	return sizeof(*this) + Packages.GetAllocatedSize() + PackageIndices.GetAllocatedSize() + NodeFlags.GetAllocatedSize()
+		+ Offsets.GetAllocatedSize() + Targets.GetAllocatedSize() + EdgeFlags.GetAllocatedSize();
+}
+
+FUMCP_DependencyGraph::~FUMCP_DependencyGraph()
+{
+	Shutdown();
+}
+
+void FUMCP_DependencyGraph::Initialize(FUMCP_PackageChangeNotifier* InPackageChanges, bool bWarmUp)
+{
+	Shutdown();
+	bShuttingDown = false;
+	{
+		const FDateTime Now = FDateTime::UtcNow();
+		FScopeLock ScopeLock(&Lock);
+		Generation = Now.ToUnixTimestamp() * 1000 + Now.GetMillisecond();
+		bGenerationObserved = false;
+		SavedFolder = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealMCPServer"), TEXT("DependencyGraph"));
+	}
+
+	if (InPackageChanges)
+	{
+		PackageChanges = InPackageChanges;
+		PackageChangedHandle = PackageChanges->OnPackageChanged().AddRaw(this, &FUMCP_DependencyGraph::OnPackageChanged);
+	}
+
+	if (bWarmUp)
+	{
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+		if (AssetRegistry.IsLoadingAssets())
+		{
+			FilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddRaw(this, &FUMCP_DependencyGraph::StartWarmUp);
+		}
+		else
+		{
+			StartWarmUp();
+		}
+	}
+}
+
+void FUMCP_DependencyGraph::StartWarmUp()
+{
+	IAssetRegistry::GetChecked().OnFilesLoaded().Remove(FilesLoadedHandle);
+	FilesLoadedHandle.Reset();
+	WarmUpFuture = Async(EAsyncExecution::ThreadPool, [this]()
+	{
+		FString Error;
+		if (!GetSnapshot(Error).IsValid() && !bShuttingDown)
+		{
+			UE_LOG(LogUnrealMCPServer, Warning, TEXT("FUMCP_DependencyGraph: Warm-up failed: %s"), *Error);
+		}
+	});
+}
+
+void FUMCP_DependencyGraph::Shutdown()
+{
+	if (PackageChanges)
+	{
+		PackageChanges->OnPackageChanged().Remove(PackageChangedHandle);
+		PackageChanges = nullptr;
+		PackageChangedHandle.Reset();
+	}
+	if (FilesLoadedHandle.IsValid())
+	{
+		// The AssetRegistry may already be gone during editor shutdown
+		if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+		{
+			AssetRegistry->OnFilesLoaded().Remove(FilesLoadedHandle);
+		}
+		FilesLoadedHandle.Reset();
+	}
+	bShuttingDown = true;
+	if (WarmUpFuture.IsValid())
+	{
+		WarmUpFuture.Wait();
+		WarmUpFuture.Reset();
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	Snapshot.Reset();
+	PackageChangeGenerations.Empty();
+	OldestDeltaGeneration = TNumericLimits<int64>::Max();
+	BuildSeconds = 0.0;
+	SavedFilePath.Empty();
+	SavedGeneration = 0;
+	SavedFileBytes = 0;
+}
+
+int64 FUMCP_DependencyGraph::GetGeneration() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Generation;
+}
+
+TSharedPtr<const FUMCP_DependencyGraphSnapshot> FUMCP_DependencyGraph::GetSnapshot(FString& OutError)
+{
+	FScopeLock BuildScopeLock(&BuildLock);
+
+	int64 BuildGeneration = 0;
+	TSharedPtr<const FUMCP_DependencyGraphSnapshot> PreviousSnapshot;
+	TArray<FName> ChangedPackageNames;
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (Snapshot.IsValid() && Snapshot->Generation == Generation)
+		{
+			return Snapshot;
+		}
+		if (IAssetRegistry::GetChecked().IsLoadingAssets())
+		{
+			OutError = TEXT("The asset registry is still scanning assets. Try again once the editor has finished loading.");
+			return nullptr;
+		}
+
+		// Changes from here on belong to the next generation
+		BuildGeneration = Generation;
+		bGenerationObserved = true;
+		OldestDeltaGeneration = FMath::Min(OldestDeltaGeneration, BuildGeneration);
+		PreviousSnapshot = Snapshot;
+		if (PreviousSnapshot.IsValid())
+		{
+			for (const TPair<FName, int64>& Pair : PackageChangeGenerations)
+			{
+				if (Pair.Value > PreviousSnapshot->Generation)
+				{
+					ChangedPackageNames.Add(Pair.Key);
+				}
+			}
+		}
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	TSharedRef<FUMCP_DependencyGraphSnapshot> NewSnapshot = BuildSnapshot(BuildGeneration, PreviousSnapshot.Get(), ChangedPackageNames);
+	const double NewBuildSeconds = FPlatformTime::Seconds() - StartTime;
+	if (bShuttingDown)
+	{
+		OutError = TEXT("The server is shutting down.");
+		return nullptr;
+	}
+	UE_LOG(LogUnrealMCPServer, Log, TEXT("FUMCP_DependencyGraph: Built generation %lld with %d packages and %d edges in %.2f s (%s)"),
+		BuildGeneration, NewSnapshot->Packages.Num(), NewSnapshot->Targets.Num(), NewBuildSeconds,
+		PreviousSnapshot.IsValid() ? *FString::Printf(TEXT("%d changed packages"), ChangedPackageNames.Num()) : TEXT("full build"));
+
+	FScopeLock ScopeLock(&Lock);
+	Snapshot = NewSnapshot;
+	BuildSeconds = NewBuildSeconds;
+	return Snapshot;
+}
+
+TSharedRef<FUMCP_DependencyGraphSnapshot> FUMCP_DependencyGraph::BuildSnapshot(int64 InGeneration, const FUMCP_DependencyGraphSnapshot* PreviousSnapshot, const TArray<FName>& ChangedPackageNames) const
+{
+	UMCP_TRACE_SCOPE(UMCP_BuildDependencyGraph);
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	// Edges by package, for every package that has assets
+	TMap<FName, FPackageEdges> SourceEdges;
+	if (!PreviousSnapshot)
+	{
+		// Assets that only exist in memory have no dependencies in the registry until they are saved
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAllAssets(Assets, true);
+		for (const FAssetData& AssetData : Assets)
+		{
+			SourceEdges.FindOrAdd(AssetData.PackageName);
+		}
+		Assets.Empty();
+		for (TPair<FName, FPackageEdges>& Pair : SourceEdges)
+		{
+			if (bShuttingDown)
+			{
+				break;
+			}
+			QueryPackageDependencies(AssetRegistry, Pair.Key, Pair.Value);
+		}
+	}
+	else
+	{
+		const TSet<FName> ChangedPackageSet(ChangedPackageNames);
+		SourceEdges.Reserve(PreviousSnapshot->Packages.Num());
+		for (int32 Node = 0; Node < PreviousSnapshot->Packages.Num(); ++Node)
+		{
+			const FName PackageName = PreviousSnapshot->Packages[Node];
+			if ((PreviousSnapshot->NodeFlags[Node] & FUMCP_DependencyGraphSnapshot::Node_HasAssets) == 0 || ChangedPackageSet.Contains(PackageName))
+			{
+				continue;
+			}
+			FPackageEdges& Edges = SourceEdges.Add(PackageName);
+			Edges.Reserve(PreviousSnapshot->Offsets[Node + 1] - PreviousSnapshot->Offsets[Node]);
+			for (int32 Edge = PreviousSnapshot->Offsets[Node]; Edge < PreviousSnapshot->Offsets[Node + 1]; ++Edge)
+			{
+				Edges.Emplace(PreviousSnapshot->Packages[PreviousSnapshot->Targets[Edge]], PreviousSnapshot->EdgeFlags[Edge]);
+			}
+		}
+
+		// Changed packages that still have assets on disk are queried again, the others are gone
+		if (ChangedPackageNames.Num() > 0)
+		{
+			FARFilter Filter;
+			Filter.PackageNames = ChangedPackageNames;
+			Filter.bIncludeOnlyOnDiskAssets = true;
+			TArray<FAssetData> Assets;
+			AssetRegistry.GetAssets(Filter, Assets);
+			for (const FAssetData& AssetData : Assets)
+			{
+				if (!SourceEdges.Contains(AssetData.PackageName))
+				{
+					QueryPackageDependencies(AssetRegistry, AssetData.PackageName, SourceEdges.Add(AssetData.PackageName));
+				}
+			}
+		}
+	}
+
+	TSharedRef<FUMCP_DependencyGraphSnapshot> NewSnapshot = MakeShared<FUMCP_DependencyGraphSnapshot>();
+	NewSnapshot->Generation = InGeneration;
+
+	// Nodes are the packages with assets plus everything they depend on, sorted so snapshots diff cleanly
+	TSet<FName> PackageSet;
+	PackageSet.Reserve(SourceEdges.Num());
+	for (const TPair<FName, FPackageEdges>& Pair : SourceEdges)
+	{
+		PackageSet.Add(Pair.Key);
+		for (const TPair<FName, uint8>& Edge : Pair.Value)
+		{
+			PackageSet.Add(Edge.Key);
+		}
+	}
+	NewSnapshot->Packages = PackageSet.Array();
+	PackageSet.Empty();
+	NewSnapshot->Packages.Sort(FNameLexicalLess());
+	NewSnapshot->PackageIndices.Reserve(NewSnapshot->Packages.Num());
+	for (int32 Node = 0; Node < NewSnapshot->Packages.Num(); ++Node)
+	{
+		NewSnapshot->PackageIndices.Add(NewSnapshot->Packages[Node], Node);
+	}
+
+	NewSnapshot->NodeFlags.SetNumZeroed(NewSnapshot->Packages.Num());
+	NewSnapshot->Offsets.Reserve(NewSnapshot->Packages.Num() + 1);
+	TArray<TPair<int32, uint8>> Row;
+	for (int32 Node = 0; Node < NewSnapshot->Packages.Num(); ++Node)
+	{
+		NewSnapshot->Offsets.Add(NewSnapshot->Targets.Num());
+		const FPackageEdges* Edges = SourceEdges.Find(NewSnapshot->Packages[Node]);
+		if (!Edges)
+		{
+			continue;
+		}
+		NewSnapshot->NodeFlags[Node] = FUMCP_DependencyGraphSnapshot::Node_HasAssets;
+
+		// A package can depend on another both hard and soft; those become one edge with both flags
+		Row.Reset();
+		for (const TPair<FName, uint8>& Edge : *Edges)
+		{
+			Row.Emplace(NewSnapshot->PackageIndices.FindChecked(Edge.Key), Edge.Value);
+		}
+		Row.Sort([](const TPair<int32, uint8>& A, const TPair<int32, uint8>& B) { return A.Key < B.Key; });
+		for (const TPair<int32, uint8>& Edge : Row)
+		{
+			if (NewSnapshot->Targets.Num() > NewSnapshot->Offsets.Last() && NewSnapshot->Targets.Last() == Edge.Key)
+			{
+				NewSnapshot->EdgeFlags.Last() |= Edge.Value;
+				continue;
+			}
+			NewSnapshot->Targets.Add(Edge.Key);
+			NewSnapshot->EdgeFlags.Add(Edge.Value);
+		}
+	}
+	NewSnapshot->Offsets.Add(NewSnapshot->Targets.Num());
+	return NewSnapshot;
+}
+
+bool FUMCP_DependencyGraph::GetChangedPackages(int64 SinceGeneration, TArray<FName>& OutPackageNames) const
+{
+	FScopeLock ScopeLock(&Lock);
+	if (SinceGeneration < OldestDeltaGeneration || SinceGeneration > Generation)
+	{
+		return false;
+	}
+	for (const TPair<FName, int64>& Pair : PackageChangeGenerations)
+	{
+		if (Pair.Value > SinceGeneration)
+		{
+			OutPackageNames.Add(Pair.Key);
+		}
+	}
+	return true;
+}
+
+bool FUMCP_DependencyGraph::SaveSnapshot(const FUMCP_DependencyGraphSnapshot& InSnapshot, FString& OutFilePath, int64& OutFileBytes, FString& OutError)
+{
+	UMCP_TRACE_SCOPE(UMCP_SaveDependencyGraph);
+	FScopeLock BuildScopeLock(&BuildLock);
+	const FString FileName = FString::Printf(TEXT("DependencyGraph_%lld.bin"), InSnapshot.Generation);
+	{
+		FScopeLock ScopeLock(&Lock);
+		OutFilePath = FPaths::ConvertRelativePathToFull(FPaths::Combine(SavedFolder, FileName));
+		if (SavedGeneration == InSnapshot.Generation && SavedFilePath == OutFilePath && IFileManager::Get().FileExists(*OutFilePath))
+		{
+			OutFileBytes = SavedFileBytes;
+			return true;
+		}
+	}
+
+	const int32 NumNodes = InSnapshot.Packages.Num();
+	const int32 NumEdges = InSnapshot.Targets.Num();
+	TArray<uint32> StringOffsets;
+	StringOffsets.Reserve(NumNodes + 1);
+	TArray<uint8> StringData;
+	for (const FName PackageName : InSnapshot.Packages)
+	{
+		StringOffsets.Add(StringData.Num());
+		FTCHARToUTF8 PackageNameUtf8(*PackageName.ToString());
+		StringData.Append(reinterpret_cast<const uint8*>(PackageNameUtf8.Get()), PackageNameUtf8.Length());
+	}
+	StringOffsets.Add(StringData.Num());
+
+	TArray<uint8> Buffer;
+	Buffer.Reserve(32 + (NumNodes + 1) * 8 + NumEdges * 5 + NumNodes + 3 + StringData.Num());
+	FMemoryWriter Writer(Buffer);
+	Writer.Serialize(const_cast<ANSICHAR*>(DependencyGraphMagic), sizeof(DependencyGraphMagic));
+	uint32 Version = DependencyGraphVersion;
+	uint32 NumNodesField = NumNodes;
+	uint32 NumEdgesField = NumEdges;
+	uint32 NumStringBytes = StringData.Num();
+	int64 GenerationField = InSnapshot.Generation;
+	Writer << Version << NumNodesField << NumEdgesField << NumStringBytes << GenerationField;
+	Writer.Serialize(StringOffsets.GetData(), StringOffsets.Num() * sizeof(uint32));
+	static_assert(sizeof(int32) == sizeof(uint32), "Offsets and targets are written as uint32");
+	Writer.Serialize(const_cast<int32*>(InSnapshot.Offsets.GetData()), InSnapshot.Offsets.Num() * sizeof(int32));
+	Writer.Serialize(const_cast<int32*>(InSnapshot.Targets.GetData()), NumEdges * sizeof(int32));
+	Writer.Serialize(const_cast<uint8*>(InSnapshot.EdgeFlags.GetData()), NumEdges);
+	Writer.Serialize(const_cast<uint8*>(InSnapshot.NodeFlags.GetData()), NumNodes);
+	uint8 Padding[3] = { 0, 0, 0 };
+	Writer.Serialize(Padding, Align(Buffer.Num(), 4) - Buffer.Num());
+	Writer.Serialize(StringData.GetData(), StringData.Num());
+
+	// Written under a temporary name first so a client mapping the file never sees a partial one
+	const FString TempPath = OutFilePath + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(Buffer, *TempPath) || !IFileManager::Get().Move(*OutFilePath, *TempPath, true))
+	{
+		IFileManager::Get().Delete(*TempPath);
+		OutError = FString::Printf(TEXT("Failed to write dependency graph file: %s"), *OutFilePath);
+		return false;
+	}
+	OutFileBytes = Buffer.Num();
+
+	// Older snapshots are only useful to clients that already have them mapped; deleting fails harmlessly for those
+	TArray<FString> OldFileNames;
+	IFileManager::Get().FindFiles(OldFileNames, *FPaths::Combine(SavedFolder, TEXT("DependencyGraph_*.bin")), true, false);
+	for (const FString& OldFileName : OldFileNames)
+	{
+		if (OldFileName != FileName)
+		{
+			IFileManager::Get().Delete(*FPaths::Combine(SavedFolder, OldFileName), false, false, true);
+		}
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	SavedFilePath = OutFilePath;
+	SavedGeneration = InSnapshot.Generation;
+	SavedFileBytes = OutFileBytes;
+	return true;
+}
+
+FUMCP_DependencyGraphStats FUMCP_DependencyGraph::GetStats() const
+{
+	FScopeLock ScopeLock(&Lock);
+	FUMCP_DependencyGraphStats Stats;
+	Stats.Generation = Generation;
+	Stats.BuildSeconds = BuildSeconds;
+	if (Snapshot.IsValid())
+	{
+		Stats.NumPackages = Snapshot->Packages.Num();
+		Stats.NumEdges = Snapshot->Targets.Num();
+		Stats.MemoryBytes = Snapshot->GetAllocatedSize();
+	}
+	Stats.MemoryBytes += PackageChangeGenerations.GetAllocatedSize();
+	return Stats;
+}
+
+void FUMCP_DependencyGraph::MarkChanged(FName PackageName)
+{
+	if (PackageName.IsNone())
+	{
+		return;
+	}
+	FScopeLock ScopeLock(&Lock);
+	if (bGenerationObserved)
+	{
+		++Generation;
+		bGenerationObserved = false;
+	}
+	if (OldestDeltaGeneration != TNumericLimits<int64>::Max())
+	{
+		PackageChangeGenerations.Add(PackageName, Generation);
+	}
+}
+
+void FUMCP_DependencyGraph::OnPackageChanged(FName PackageName, EUMCP_PackageChangeKind Kind)
+{
+	// Dependencies are what the registry has for the file on disk, and only saving rewrites that
+	if (Kind != EUMCP_PackageChangeKind::Edited)
+	{
+		MarkChanged(PackageName);
+	}
+}
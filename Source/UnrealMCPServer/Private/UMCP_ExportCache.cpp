@@ -0,0 +1,428 @@
+#include "UMCP_ExportCache.h"
+#include "UMCP_PackageChangeNotifier.h"
+#include "UMCP_Trace.h"
+#include "UnrealMCPServerModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+	FString MakeEntryKey(const FString& ObjectPath, const FString& Format)
+	{
+		return Format.ToLower() + TEXT("|") + ObjectPath;
+	}
+
+	// Deletes abandoned temporary files and then, least recently used first, the files over the budget. Files of older
+	// saved hashes are never read again, so they age out this way. Background thread only.
+	void PruneDiskTier(const FString& Folder, int64 BudgetBytes)
+	{
+		UMCP_TRACE_SCOPE(UMCP_PruneExportCache);
+		struct FDiskFile
+		{
+			FString Path;
+			FDateTime Time;
+			int64 NumBytes = 0;
+		};
+		TArray<FDiskFile> Files;
+		TArray<FString> AbandonedTempFiles;
+		int64 TotalBytes = 0;
+		// A temporary file this old is not being written anymore
+		const FDateTime AbandonedTime = FDateTime::UtcNow() - FTimespan::FromMinutes(10.0);
+		IFileManager::Get().IterateDirectoryStat(*Folder, [&](const TCHAR* Path, const FFileStatData& StatData)
+		{
+			if (StatData.bIsDirectory)
+			{
+				return true;
+			}
+			if (FPaths::GetExtension(Path) == TEXT("tmp"))
+			{
+				if (StatData.ModificationTime < AbandonedTime)
+				{
+					AbandonedTempFiles.Add(Path);
+				}
+				return true;
+			}
+			Files.Add({ Path, StatData.ModificationTime, StatData.FileSize });
+			TotalBytes += StatData.FileSize;
+			return true;
+		});
+
+		int32 NumDeleted = 0;
+		for (const FString& Path : AbandonedTempFiles)
+		{
+			NumDeleted += IFileManager::Get().Delete(*Path, false, false, true) ? 1 : 0;
+		}
+		if (TotalBytes > BudgetBytes)
+		{
+			// Disk hits touch their file, so the modification time is the time of last use
+			Files.Sort([](const FDiskFile& A, const FDiskFile& B) { return A.Time < B.Time; });
+			for (const FDiskFile& File : Files)
+			{
+				if (TotalBytes <= BudgetBytes)
+				{
+					break;
+				}
+				if (IFileManager::Get().Delete(*File.Path, false, false, true))
+				{
+					TotalBytes -= File.NumBytes;
+					NumDeleted++;
+				}
+			}
+		}
+		if (NumDeleted > 0)
+		{
+			UE_LOG(LogUnrealMCPServer, Log, TEXT("FUMCP_ExportCache: Pruned %d files from the disk tier, %lld bytes left"), NumDeleted, TotalBytes);
+		}
+	}
+
+	bool MakeSlice(const FString& Text, const TArray<int32>& BlockStarts, const FUMCP_ExportRange& Range, FUMCP_ExportSlice& OutSlice, FString& OutError)
+	{
+		int32 Start = 0;
+		int32 End = Text.Len();
+		if (Range.Block != INDEX_NONE)
+		{
+			if (!BlockStarts.IsValidIndex(Range.Block))
+			{
+				OutError = FString::Printf(TEXT("Block %d is out of range, the export has %d blocks"), Range.Block, BlockStarts.Num());
+				return false;
+			}
+			Start = BlockStarts[Range.Block];
+			End = BlockStarts.IsValidIndex(Range.Block + 1) ? BlockStarts[Range.Block + 1] : Text.Len();
+		}
+
+		OutSlice.TotalLength = End - Start;
+		OutSlice.NumBlocks = BlockStarts.Num();
+		if (Range.Offset < 0 || Range.Offset > OutSlice.TotalLength)
+		{
+			OutError = FString::Printf(TEXT("Offset %d is out of range, the %s has %d characters"), Range.Offset, Range.Block != INDEX_NONE ? TEXT("block") : TEXT("export"), OutSlice.TotalLength);
+			return false;
+		}
+		if (Range.Length == 0)
+		{
+			OutError = TEXT("Length must be greater than 0, or negative for the rest of the export");
+			return false;
+		}
+		OutSlice.Offset = Range.Offset;
+		OutSlice.Length = Range.Length < 0 ? OutSlice.TotalLength - Range.Offset : FMath::Min(Range.Length, OutSlice.TotalLength - Range.Offset);
+		OutSlice.Text = Text.Mid(Start + OutSlice.Offset, OutSlice.Length);
+		return true;
+	}
+}
+
+FUMCP_ExportCache::~FUMCP_ExportCache()
+{
+	Shutdown();
+}
+
+void FUMCP_ExportCache::Initialize(int64 InMemoryBudgetBytes, int64 InDiskBudgetBytes, FUMCP_PackageChangeNotifier* InPackageChanges)
+{
+	Shutdown();
+	MemoryBudgetBytes = FMath::Max<int64>(InMemoryBudgetBytes, 0);
+	DiskBudgetBytes = MemoryBudgetBytes > 0 ? FMath::Max<int64>(InDiskBudgetBytes, 0) : 0;
+	bUseDiskTier = DiskBudgetBytes > 0;
+	DiskBytesSincePrune = 0;
+	DiskTierFolder = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealMCPServer"), TEXT("ExportCache"));
+	if (MemoryBudgetBytes == 0)
+	{
+		UE_LOG(LogUnrealMCPServer, Log, TEXT("FUMCP_ExportCache: Disabled"));
+		return;
+	}
+
+	if (InPackageChanges)
+	{
+		PackageChanges = InPackageChanges;
+		PackageChangedHandle = PackageChanges->OnPackageChanged().AddRaw(this, &FUMCP_ExportCache::OnPackageChanged);
+	}
+
+	if (bUseDiskTier)
+	{
+		// Files of previous sessions count against the budget too
+		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Folder = DiskTierFolder, Budget = DiskBudgetBytes]()
+		{
+			PruneDiskTier(Folder, Budget);
+		});
+	}
+
+	UE_LOG(LogUnrealMCPServer, Log, TEXT("FUMCP_ExportCache: Memory budget %lld bytes, disk tier %s (%lld bytes)"), MemoryBudgetBytes, bUseDiskTier ? *DiskTierFolder : TEXT("off"), DiskBudgetBytes);
+}
+
+void FUMCP_ExportCache::Shutdown()
+{
+	if (PackageChanges)
+	{
+		PackageChanges->OnPackageChanged().Remove(PackageChangedHandle);
+		PackageChanges = nullptr;
+		PackageChangedHandle.Reset();
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	Entries.Empty();
+	LruList.Empty();
+	PackageRevisions.Empty();
+	Stats.MemoryBytes = 0;
+	Stats.NumEntries = 0;
+	MemoryBudgetBytes = 0;
+}
+
+bool FUMCP_ExportCache::GetOrExport(const FString& ObjectPath, const FString& Format, TFunctionRef<bool(FString& OutText, FString& OutError)> Export, FString& OutText, FString& OutError)
+{
+	if (MemoryBudgetBytes == 0 || ObjectPath.IsEmpty())
+	{
+		return Export(OutText, OutError);
+	}
+
+	const FString Key = MakeEntryKey(ObjectPath, Format);
+	const FName PackageName(*FPackageName::ObjectPathToPackageName(ObjectPath));
+	uint32 Revision = 0;
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (const FEntry* Entry = FindCurrentEntryLocked(Key, PackageName, Revision))
+		{
+			OutText = Entry->Text;
+			return true;
+		}
+	}
+
+	// Only packages that are unchanged since they were last saved have a saved hash to address the disk tier with
+	const FString DiskPath = Revision == 0 ? GetDiskPath(ObjectPath, Format, PackageName) : FString();
+	if (!DiskPath.IsEmpty())
+	{
+		UMCP_TRACE_SCOPE(UMCP_ReadExportCache);
+		if (FFileHelper::LoadFileToString(OutText, *DiskPath))
+		{
+			FScopeLock ScopeLock(&Lock);
+			Stats.Hits++;
+			Stats.DiskHits++;
+			AddEntryLocked(Key, PackageName, Revision, OutText);
+			AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [DiskPath]()
+			{
+				// Marks the file as recently used for PruneDiskTier
+				IFileManager::Get().SetTimeStamp(*DiskPath, FDateTime::UtcNow());
+			});
+			return true;
+		}
+	}
+
+	if (!Export(OutText, OutError))
+	{
+		FScopeLock ScopeLock(&Lock);
+		Stats.Misses++;
+		return false;
+	}
+
+	{
+		FScopeLock ScopeLock(&Lock);
+		Stats.Misses++;
+		// Export may have modified the package (e.g. by loading it); an export made across a change isn't cached
+		if (PackageRevisions.FindRef(PackageName) != Revision)
+		{
+			return true;
+		}
+		AddEntryLocked(Key, PackageName, Revision, OutText);
+	}
+
+	if (!DiskPath.IsEmpty())
+	{
+		// Prunes once the files written since the last prune could have taken the folder a quarter over the budget
+		DiskBytesSincePrune += OutText.Len();
+		bool bPrune = false;
+		if (DiskBytesSincePrune > DiskBudgetBytes / 4)
+		{
+			DiskBytesSincePrune = 0;
+			bPrune = true;
+		}
+		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [DiskPath, Text = OutText, bPrune, Folder = DiskTierFolder, Budget = DiskBudgetBytes]()
+		{
+			UMCP_TRACE_SCOPE(UMCP_WriteExportCache);
+			// Written under a temporary name first so a reader never sees a partial file
+			const FString TempPath = DiskPath + TEXT(".tmp");
+			if (FFileHelper::SaveStringToFile(Text, *TempPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM)
+				&& !IFileManager::Get().Move(*DiskPath, *TempPath, true))
+			{
+				IFileManager::Get().Delete(*TempPath);
+			}
+			if (bPrune)
+			{
+				PruneDiskTier(Folder, Budget);
+			}
+		});
+	}
+	return true;
+}
+
+bool FUMCP_ExportCache::GetOrExportSlice(const FString& ObjectPath, const FString& Format, TFunctionRef<bool(FString& OutText, FString& OutError)> Export, const FUMCP_ExportRange& Range, const FBlockFinder& FindBlocks, FUMCP_ExportSlice& OutSlice, FString& OutError)
+{
+	if (Range.Block != INDEX_NONE && !FindBlocks)
+	{
+		OutError = FString::Printf(TEXT("%s exports have no blocks"), *Format);
+		return false;
+	}
+
+	const bool bCached = MemoryBudgetBytes > 0 && !ObjectPath.IsEmpty();
+	const FString Key = bCached ? MakeEntryKey(ObjectPath, Format) : FString();
+	const FName PackageName = bCached ? FName(*FPackageName::ObjectPathToPackageName(ObjectPath)) : NAME_None;
+	if (bCached)
+	{
+		FScopeLock ScopeLock(&Lock);
+		uint32 Revision = 0;
+		if (FEntry* Entry = FindCurrentEntryLocked(Key, PackageName, Revision))
+		{
+			return SliceEntryLocked(*Entry, Range, FindBlocks, OutSlice, OutError);
+		}
+	}
+
+	FString Text;
+	if (!GetOrExport(ObjectPath, Format, Export, Text, OutError))
+	{
+		return false;
+	}
+
+	if (bCached)
+	{
+		// GetOrExport cached the export unless it was over budget or its package changed while it was made
+		FScopeLock ScopeLock(&Lock);
+		FEntry* Entry = Entries.Find(Key);
+		if (Entry && Entry->Revision == PackageRevisions.FindRef(PackageName))
+		{
+			return SliceEntryLocked(*Entry, Range, FindBlocks, OutSlice, OutError);
+		}
+	}
+
+	TArray<int32> BlockStarts;
+	if (Range.Block != INDEX_NONE)
+	{
+		FindBlocks(Text, BlockStarts);
+	}
+	return MakeSlice(Text, BlockStarts, Range, OutSlice, OutError);
+}
+
+FUMCP_ExportCacheStats FUMCP_ExportCache::GetStats() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Stats;
+}
+
+FUMCP_ExportCache::FEntry* FUMCP_ExportCache::FindCurrentEntryLocked(const FString& Key, FName PackageName, uint32& OutRevision)
+{
+	OutRevision = PackageRevisions.FindRef(PackageName);
+	FEntry* Entry = Entries.Find(Key);
+	if (!Entry)
+	{
+		return nullptr;
+	}
+	if (Entry->Revision != OutRevision)
+	{
+		Stats.Invalidations++;
+		RemoveEntryLocked(Key);
+		return nullptr;
+	}
+	Stats.Hits++;
+	LruList.RemoveNode(Entry->LruNode, false);
+	LruList.AddHead(Entry->LruNode);
+	return Entry;
+}
+
+bool FUMCP_ExportCache::SliceEntryLocked(FEntry& Entry, const FUMCP_ExportRange& Range, const FBlockFinder& FindBlocks, FUMCP_ExportSlice& OutSlice, FString& OutError)
+{
+	if (Range.Block != INDEX_NONE && !Entry.bFoundBlocks)
+	{
+		UMCP_TRACE_SCOPE(UMCP_FindExportBlocks);
+		FindBlocks(Entry.Text, Entry.BlockStarts);
+		Entry.bFoundBlocks = true;
+		// Kept with the entry, so it counts against the budget too
+		const int64 BlockBytes = Entry.BlockStarts.Num() * sizeof(int32);
+		Entry.NumBytes += BlockBytes;
+		Stats.MemoryBytes += BlockBytes;
+	}
+	return MakeSlice(Entry.Text, Entry.BlockStarts, Range, OutSlice, OutError);
+}
+
+void FUMCP_ExportCache::AddEntryLocked(const FString& Key, FName PackageName, uint32 Revision, const FString& Text)
+{
+	const int64 NumBytes = (Text.Len() + Key.Len()) * sizeof(TCHAR);
+	if (NumBytes > MemoryBudgetBytes)
+	{
+		return;
+	}
+	RemoveEntryLocked(Key);
+	while (Stats.MemoryBytes + NumBytes > MemoryBudgetBytes && LruList.GetTail())
+	{
+		const FString EvictedKey = LruList.GetTail()->GetValue();
+		RemoveEntryLocked(EvictedKey);
+		Stats.Evictions++;
+	}
+
+	LruList.AddHead(Key);
+	FEntry& Entry = Entries.Add(Key);
+	Entry.PackageName = PackageName;
+	Entry.Revision = Revision;
+	Entry.Text = Text;
+	Entry.NumBytes = NumBytes;
+	Entry.LruNode = LruList.GetHead();
+	Stats.MemoryBytes += NumBytes;
+	Stats.NumEntries = Entries.Num();
+}
+
+void FUMCP_ExportCache::RemoveEntryLocked(const FString& Key)
+{
+	FEntry Entry;
+	if (Entries.RemoveAndCopyValue(Key, Entry))
+	{
+		LruList.RemoveNode(Entry.LruNode);
+		Stats.MemoryBytes -= Entry.NumBytes;
+		Stats.NumEntries = Entries.Num();
+	}
+}
+
+FString FUMCP_ExportCache::GetDiskPath(const FString& ObjectPath, const FString& Format, FName PackageName) const
+{
+	if (!bUseDiskTier)
+	{
+		return FString();
+	}
+	UPackage* Package = FindPackage(nullptr, *PackageName.ToString());
+	if (Package && Package->IsDirty())
+	{
+		return FString();
+	}
+
+#if (ENGINE_MAJOR_VERSION >= (5) && ENGINE_MINOR_VERSION >= (1))
+	IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+	TOptional<FAssetPackageData> PackageData = AssetRegistry ? AssetRegistry->GetAssetPackageDataCopy(PackageName) : TOptional<FAssetPackageData>();
+	if (!PackageData.IsSet() || PackageData->GetPackageSavedHash().IsZero())
+	{
+		return FString();
+	}
+
+	const FString HashInput = MakeEntryKey(ObjectPath, Format) + TEXT("|") + LexToString(PackageData->GetPackageSavedHash());
+	FTCHARToUTF8 HashInputUtf8(*HashInput);
+	FSHAHash Hash;
+	FSHA1::HashBuffer(HashInputUtf8.Get(), HashInputUtf8.Length(), Hash.Hash);
+	return FPaths::Combine(DiskTierFolder, Hash.ToString() + TEXT(".") + Format.ToLower());
+#else
+	// The saved package hash is only exposed by the AssetRegistry from 5.1 on
+	return FString();
+#endif
+}
+
+void FUMCP_ExportCache::OnPackageChanged(FName PackageName, EUMCP_PackageChangeKind Kind)
+{
+	BumpRevision(PackageName);
+}
+
+void FUMCP_ExportCache::BumpRevision(FName PackageName)
+{
+	if (PackageName.IsNone())
+	{
+		return;
+	}
+	FScopeLock ScopeLock(&Lock);
+	PackageRevisions.FindOrAdd(PackageName)++;
+}
@@ -0,0 +1,120 @@
+#include "UMCP_JobTools.h"
+#include "UMCP_Server.h"
+#include "UMCP_Types.h"
+#include "UnrealMCPServerModule.h"
+
+void FUMCP_JobTools::Register(class FUMCP_Server* InServer)
+{
+	Server = InServer;
+
+	// Job status lives in the server and is guarded by a lock, so neither tool has to wait for the game thread
+	TMap<FString, FString> InputDescriptions;
+	InputDescriptions.Add(TEXT("jobId"), TEXT("The job id returned by a tool called with runAsJob: true."));
+	TArray<FString> InputRequired;
+	InputRequired.Add(TEXT("jobId"));
+
+	TMap<FString, FString> OutputDescriptions;
+	OutputDescriptions.Add(TEXT("jobId"), TEXT("The job id"));
+	OutputDescriptions.Add(TEXT("toolName"), TEXT("The tool the job is running"));
+	OutputDescriptions.Add(TEXT("status"), TEXT("Job status: 'running', 'completed', 'failed' or 'cancelled'"));
+	OutputDescriptions.Add(TEXT("progress"), TEXT("Progress reported by the tool so far"));
+	OutputDescriptions.Add(TEXT("total"), TEXT("Value progress counts up to, or 0 if unknown"));
+	OutputDescriptions.Add(TEXT("message"), TEXT("Latest progress message"));
+	OutputDescriptions.Add(TEXT("elapsedSeconds"), TEXT("Seconds since the job started, up to when it finished"));
+	TArray<FString> OutputRequired;
+	OutputRequired.Add(TEXT("jobId"));
+	OutputRequired.Add(TEXT("status"));
+	UMCP_JsonSchemaBuilder JobStatusOutputSchema = [GenerateSchema = UMCP_DeferJsonSchemaFromStruct<FUMCP_JobStatusResult>(OutputDescriptions, OutputRequired)]()
+	{
+		TSharedPtr<FJsonObject> Schema = GenerateSchema();
+		// `result` is not a UPROPERTY, it holds whatever the job's tool returned
+		const TSharedPtr<FJsonObject>* Properties = nullptr;
+		if (Schema.IsValid() && Schema->TryGetObjectField(TEXT("properties"), Properties))
+		{
+			TSharedPtr<FJsonObject> ResultSchema = MakeShared<FJsonObject>();
+			ResultSchema->SetStringField(TEXT("type"), TEXT("object"));
+			ResultSchema->SetStringField(TEXT("description"), TEXT("Once the job is no longer running: the tools/call result of the job (content, isError and, for tools with an output schema, structuredContent)"));
+			(*Properties)->SetObjectField(TEXT("result"), ResultSchema);
+		}
+		return Schema;
+	};
+
+	{
+		FUMCP_ToolDefinition Tool;
+		Tool.name = TEXT("get_job_status");
+		Tool.description = TEXT("Get the status of a job started by calling a tool with runAsJob: true. Returns the status ('running', 'completed', 'failed' or 'cancelled'), the latest progress and, once the job is no longer running, the tool's result in 'result'. Poll this until the status is no longer 'running'. Finished jobs are kept for a limited time (10 minutes by default).");
+		Tool.DoToolCall.BindRaw(this, &FUMCP_JobTools::GetJobStatus);
+		Tool.ExecutionAffinity = EUMCP_ExecutionAffinity::AnyThread;
+		Tool.Priority = EUMCP_RequestPriority::High;
+		Tool.InputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_JobIdParams>(InputDescriptions, InputRequired);
+		Tool.OutputSchemaBuilder = JobStatusOutputSchema;
+		Server->RegisterTool(MoveTemp(Tool));
+	}
+
+	{
+		FUMCP_ToolDefinition Tool;
+		Tool.name = TEXT("cancel_job");
+		Tool.description = TEXT("Request cancellation of a running job started with runAsJob: true. The job stops at its next step and keeps the work it already finished (for example files already exported); poll get_job_status until the status is 'cancelled' to get the partial result. Cancelling a job that already finished has no effect. Returns the job status at the time of the request.");
+		Tool.DoToolCall.BindRaw(this, &FUMCP_JobTools::CancelJob);
+		Tool.ExecutionAffinity = EUMCP_ExecutionAffinity::AnyThread;
+		Tool.Priority = EUMCP_RequestPriority::High;
+		Tool.InputSchemaBuilder = UMCP_DeferJsonSchemaFromStruct<FUMCP_JobIdParams>(InputDescriptions, InputRequired);
+		Tool.OutputSchemaBuilder = JobStatusOutputSchema;
+		Server->RegisterTool(MoveTemp(Tool));
+	}
+}
+
+bool FUMCP_JobTools::GetJobStatus(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent)
+{
+	auto& Content = OutContent.Add_GetRef(FUMCP_CallToolResultContent());
+	Content.type = TEXT("text");
+
+	FUMCP_JobIdParams Params;
+	if (!arguments.IsValid() || !UMCP_CreateFromJsonObject(arguments, Params) || Params.jobId.IsEmpty())
+	{
+		Content.text = TEXT("Invalid parameters: 'jobId' is required");
+		return false;
+	}
+	return SetJobStatusContent(Params.jobId, Content);
+}
+
+bool FUMCP_JobTools::CancelJob(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent)
+{
+	auto& Content = OutContent.Add_GetRef(FUMCP_CallToolResultContent());
+	Content.type = TEXT("text");
+
+	FUMCP_JobIdParams Params;
+	if (!arguments.IsValid() || !UMCP_CreateFromJsonObject(arguments, Params) || Params.jobId.IsEmpty())
+	{
+		Content.text = TEXT("Invalid parameters: 'jobId' is required");
+		return false;
+	}
+
+	// False for unknown and already finished jobs alike; SetJobStatusContent tells them apart
+	Server->CancelJob(Params.jobId);
+	return SetJobStatusContent(Params.jobId, Content);
+}
+
+bool FUMCP_JobTools::SetJobStatusContent(const FString& JobId, FUMCP_CallToolResultContent& Content)
+{
+	FUMCP_JobStatusResult Status;
+	if (!Server->GetJobStatus(JobId, Status))
+	{
+		Content.text = FString::Printf(TEXT("Unknown job id '%s'. Finished jobs are discarded after FinishedJobRetentionSeconds."), *JobId);
+		return false;
+	}
+
+	// Built as a DOM because the job's own result object is attached to it
+	Content.structuredContent = MakeShared<FJsonObject>();
+	if (!UMCP_ToJsonObject(Status, Content.structuredContent))
+	{
+		Content.structuredContent.Reset();
+		Content.text = TEXT("Failed to serialize result");
+		return false;
+	}
+	if (Status.result.IsValid())
+	{
+		Content.structuredContent->SetObjectField(TEXT("result"), Status.result);
+	}
+	return true;
+}
@@ -0,0 +1,145 @@
+#include "UMCP_LogBuffer.h"
+#include "UMCP_Trace.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/OutputDeviceRedirector.h"
+
+FUMCP_LogBuffer::~FUMCP_LogBuffer()
+{
+	Shutdown();
+}
+
+void FUMCP_LogBuffer::Initialize(int32 InCapacity, bool bAttachToLog)
+{
+	Shutdown();
+	Capacity = FMath::Max(InCapacity, 0);
+	Slots = Capacity > 0 ? MakeUnique<FSlot[]>(Capacity) : nullptr;
+	NextSequence.store(1, std::memory_order_release);
+	NumDropped.store(0, std::memory_order_relaxed);
+	if (Capacity > 0 && bAttachToLog && GLog)
+	{
+		GLog->AddOutputDevice(this);
+		bAttached = true;
+	}
+}
+
+void FUMCP_LogBuffer::Shutdown()
+{
+	if (bAttached && GLog)
+	{
+		GLog->RemoveOutputDevice(this);
+	}
+	bAttached = false;
+}
+
+void FUMCP_LogBuffer::Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const FName& Category)
+{
+	Serialize(V, Verbosity, Category, -1.0);
+}
+
+void FUMCP_LogBuffer::Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const FName& Category, const double Time)
+{
+	if (Capacity == 0 || !V || (Verbosity & ELogVerbosity::VerbosityMask) == ELogVerbosity::SetColor)
+	{
+		return;
+	}
+
+	const uint64 Sequence = NextSequence.fetch_add(1, std::memory_order_acq_rel);
+	FSlot& Slot = Slots[Sequence % Capacity];
+	uint64 Version = Slot.Version.load(std::memory_order_acquire);
+	for (;;)
+	{
+		if (Version / 2 > Sequence)
+		{
+			// A line a lap later got here first; it is the one readers should see
+			NumDropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		if (Version & 1)
+		{
+			// The line a lap earlier is still being copied in
+			FPlatformProcess::Yield();
+			Version = Slot.Version.load(std::memory_order_acquire);
+			continue;
+		}
+		if (Slot.Version.compare_exchange_weak(Version, Sequence * 2 + 1, std::memory_order_acquire, std::memory_order_acquire))
+		{
+			break;
+		}
+	}
+
+	const int32 Len = FCString::Strlen(V);
+	Slot.NumChars = FMath::Min(Len, MaxLineChars);
+	Slot.bTruncated = Len > MaxLineChars;
+	FMemory::Memcpy(Slot.Text, V, Slot.NumChars * sizeof(TCHAR));
+	// The engine passes the time already relative to GStartTime; -1 means the caller did not supply one
+	Slot.Time = Time >= 0.0 ? Time : FPlatformTime::Seconds() - GStartTime;
+	Slot.Category = Category;
+	Slot.Verbosity = static_cast<ELogVerbosity::Type>(Verbosity & ELogVerbosity::VerbosityMask);
+	Slot.Version.store(Sequence * 2, std::memory_order_release);
+}
+
+uint64 FUMCP_LogBuffer::ReadLines(uint64 Cursor, int32 MaxLines, TFunctionRef<bool(const FUMCP_LogLine&)> Filter, TArray<FUMCP_LogLine>& OutLines, uint64& OutNumMissed) const
+{
+	UMCP_TRACE_SCOPE(UMCP_ReadLogLines);
+	OutNumMissed = 0;
+	const uint64 Next = NextSequence.load(std::memory_order_acquire);
+	if (Capacity == 0)
+	{
+		return FMath::Max<uint64>(Cursor, Next);
+	}
+
+	const uint64 Oldest = Next > static_cast<uint64>(Capacity) ? Next - Capacity : 1;
+	if (Cursor != 0 && Cursor < Oldest)
+	{
+		OutNumMissed = Oldest - Cursor;
+	}
+	uint64 Sequence = FMath::Max(Cursor, Oldest);
+	int32 NumRead = 0;
+	for (; Sequence < Next && NumRead < MaxLines; ++Sequence)
+	{
+		const FSlot& Slot = Slots[Sequence % Capacity];
+		const uint64 Version = Slot.Version.load(std::memory_order_acquire);
+		if (Version < Sequence * 2 + 2 && Version != Sequence * 2)
+		{
+			// Not written yet; the next read starts here
+			break;
+		}
+		if (Version != Sequence * 2)
+		{
+			++OutNumMissed;
+			continue;
+		}
+
+		FUMCP_LogLine Line;
+		Line.Sequence = Sequence;
+		Line.Time = Slot.Time;
+		Line.Category = Slot.Category;
+		Line.Verbosity = Slot.Verbosity;
+		Line.bTruncated = Slot.bTruncated;
+		Line.Text = FString(FMath::Clamp(Slot.NumChars, 0, MaxLineChars), Slot.Text);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (Slot.Version.load(std::memory_order_relaxed) != Version)
+		{
+			// Overwritten while it was copied
+			++OutNumMissed;
+			continue;
+		}
+		if (Filter(Line))
+		{
+			OutLines.Add(MoveTemp(Line));
+			++NumRead;
+		}
+	}
+	return Sequence;
+}
+
+FUMCP_LogBufferStats FUMCP_LogBuffer::GetStats() const
+{
+	FUMCP_LogBufferStats Stats;
+	Stats.Capacity = Capacity;
+	Stats.NextSequence = NextSequence.load(std::memory_order_acquire);
+	Stats.NumDropped = NumDropped.load(std::memory_order_relaxed);
+	Stats.MemoryBytes = static_cast<int64>(Capacity) * sizeof(FSlot);
+	return Stats;
+}
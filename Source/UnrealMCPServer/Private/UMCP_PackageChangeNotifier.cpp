@@ -0,0 +1,113 @@
+#include "UMCP_PackageChangeNotifier.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+FUMCP_PackageChangeNotifier::~FUMCP_PackageChangeNotifier()
+{
+	Shutdown();
+}
+
+void FUMCP_PackageChangeNotifier::Initialize(bool bHookEngineEvents)
+{
+	Shutdown();
+	if (!bHookEngineEvents)
+	{
+		return;
+	}
+
+	ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FUMCP_PackageChangeNotifier::OnObjectModified);
+	PackageMarkedDirtyHandle = UPackage::PackageMarkedDirtyEvent.AddRaw(this, &FUMCP_PackageChangeNotifier::OnPackageMarkedDirty);
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(this, &FUMCP_PackageChangeNotifier::OnPackageSaved);
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FUMCP_PackageChangeNotifier::OnAssetAdded);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FUMCP_PackageChangeNotifier::OnAssetRenamed);
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FUMCP_PackageChangeNotifier::OnAssetRemoved);
+	AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddRaw(this, &FUMCP_PackageChangeNotifier::OnAssetUpdated);
+}
+
+void FUMCP_PackageChangeNotifier::Shutdown()
+{
+	FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+	UPackage::PackageMarkedDirtyEvent.Remove(PackageMarkedDirtyHandle);
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+	if (AssetAddedHandle.IsValid() || AssetRenamedHandle.IsValid() || AssetRemovedHandle.IsValid() || AssetUpdatedHandle.IsValid())
+	{
+		// The AssetRegistry may already be gone during editor shutdown
+		if (IAssetRegistry* AssetRegistry = IAssetRegistry::Get())
+		{
+			AssetRegistry->OnAssetAdded().Remove(AssetAddedHandle);
+			AssetRegistry->OnAssetRenamed().Remove(AssetRenamedHandle);
+			AssetRegistry->OnAssetRemoved().Remove(AssetRemovedHandle);
+			AssetRegistry->OnAssetUpdated().Remove(AssetUpdatedHandle);
+		}
+	}
+	ObjectModifiedHandle.Reset();
+	PackageMarkedDirtyHandle.Reset();
+	PackageSavedHandle.Reset();
+	AssetAddedHandle.Reset();
+	AssetRenamedHandle.Reset();
+	AssetRemovedHandle.Reset();
+	AssetUpdatedHandle.Reset();
+}
+
+void FUMCP_PackageChangeNotifier::NotifyPackageChanged(FName PackageName, EUMCP_PackageChangeKind Kind)
+{
+	if (!PackageName.IsNone())
+	{
+		PackageChangedEvent.Broadcast(PackageName, Kind);
+	}
+}
+
+void FUMCP_PackageChangeNotifier::OnObjectModified(UObject* Object)
+{
+	if (Object)
+	{
+		NotifyPackageChanged(Object->GetOutermost()->GetFName(), EUMCP_PackageChangeKind::Edited);
+	}
+}
+
+void FUMCP_PackageChangeNotifier::OnPackageMarkedDirty(UPackage* Package, bool bWasDirty)
+{
+	if (Package)
+	{
+		NotifyPackageChanged(Package->GetFName(), EUMCP_PackageChangeKind::Edited);
+	}
+}
+
+void FUMCP_PackageChangeNotifier::OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext SaveContext)
+{
+	// Cooks write somewhere else and leave the asset as it was
+	if (Package && !SaveContext.IsProceduralSave())
+	{
+		NotifyPackageChanged(Package->GetFName(), EUMCP_PackageChangeKind::Saved);
+	}
+}
+
+void FUMCP_PackageChangeNotifier::OnAssetAdded(const FAssetData& AssetData)
+{
+	// The initial scan adds every asset of the project; none of them is a change
+	if (!IAssetRegistry::GetChecked().IsLoadingAssets())
+	{
+		NotifyPackageChanged(AssetData.PackageName, EUMCP_PackageChangeKind::Added);
+	}
+}
+
+void FUMCP_PackageChangeNotifier::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	NotifyPackageChanged(AssetData.PackageName, EUMCP_PackageChangeKind::Renamed);
+	NotifyPackageChanged(FName(*FPackageName::ObjectPathToPackageName(OldObjectPath)), EUMCP_PackageChangeKind::Renamed);
+}
+
+void FUMCP_PackageChangeNotifier::OnAssetRemoved(const FAssetData& AssetData)
+{
+	NotifyPackageChanged(AssetData.PackageName, EUMCP_PackageChangeKind::Removed);
+}
+
+void FUMCP_PackageChangeNotifier::OnAssetUpdated(const FAssetData& AssetData)
+{
+	// Rescans of files changed on disk, e.g. by a source control sync
+	NotifyPackageChanged(AssetData.PackageName, EUMCP_PackageChangeKind::Updated);
+}
@@ -0,0 +1,246 @@
+#include "UMCP_PackageLoader.h"
+#include "UMCP_Trace.h"
+#include "UnrealMCPServerModule.h"
+#include "Editor.h"
+#include "Engine/World.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/PackageName.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectHash.h"
+
+namespace
+{
+	// A release collects garbage, so it waits until this many packages are held. An editor that stays above the
+	// watermark without them then still only collects every so many loads.
+	constexpr int32 MinHeldPackagesPerRelease = 16;
+
+	// The package ObjectPath is in, if it has to be loaded first
+	bool GetPackageToLoad(const FString& ObjectPath, FString& OutPackageName)
+	{
+		OutPackageName = FPackageName::ObjectPathToPackageName(ObjectPath);
+		return !ObjectPath.IsEmpty() && FPackageName::IsValidLongPackageName(OutPackageName) && !FindPackage(nullptr, *OutPackageName);
+	}
+
+	struct FUMCP_PackageLoadRequest
+	{
+		int32 RequestId = INDEX_NONE;
+		bool bComplete = false;
+	};
+}
+
+FUMCP_PackageLoader::~FUMCP_PackageLoader()
+{
+	Shutdown();
+}
+
+void FUMCP_PackageLoader::Initialize(int32 InMaxConcurrentLoads, int64 InMemoryWatermarkBytes)
+{
+	Shutdown();
+	MaxConcurrentLoads = FMath::Max(InMaxConcurrentLoads, 1);
+	MemoryWatermarkBytes = FMath::Max<int64>(InMemoryWatermarkBytes, 0);
+	UpdateStats();
+	UE_LOG(LogUnrealMCPServer, Log, TEXT("FUMCP_PackageLoader: %d concurrent loads, memory watermark %lld MB"), MaxConcurrentLoads, MemoryWatermarkBytes / (1024 * 1024));
+}
+
+void FUMCP_PackageLoader::Shutdown()
+{
+	// Whatever is still loading completes without us; what was loaded stays loaded like any other package
+	CallbackGuard = MakeShared<bool>(true);
+	PendingLoads.Empty();
+	HeldPackages.Empty();
+	UpdateStats();
+}
+
+bool FUMCP_PackageLoader::TryStartLoad(const FString& ObjectPath, int32& OutRequestId)
+{
+	OutRequestId = INDEX_NONE;
+	FString PackageName;
+	if (!GetPackageToLoad(ObjectPath, PackageName))
+	{
+		return true;
+	}
+	if (PendingLoads.Num() >= MaxConcurrentLoads)
+	{
+		return false;
+	}
+	OutRequestId = StartLoad(PackageName);
+	return true;
+}
+
+bool FUMCP_PackageLoader::IsLoadComplete(int32 RequestId) const
+{
+	return RequestId == INDEX_NONE || !PendingLoads.Contains(RequestId);
+}
+
+void FUMCP_PackageLoader::WaitForLoad(int32 RequestId)
+{
+	if (!IsLoadComplete(RequestId))
+	{
+		UMCP_TRACE_SCOPE(UMCP_FlushAsyncLoading);
+		FlushAsyncLoading(RequestId);
+		// The completion callback has run by now unless the request failed before it was queued
+		PendingLoads.Remove(RequestId);
+		UpdateStats();
+	}
+}
+
+UObject* FUMCP_PackageLoader::LoadObject(const FString& ObjectPath)
+{
+	FString PackageName;
+	if (GetPackageToLoad(ObjectPath, PackageName))
+	{
+		WaitForLoad(StartLoad(PackageName));
+	}
+	// The package is in memory now, so this only resolves the path, redirectors included
+	UMCP_TRACE_SCOPE(UMCP_LoadObject);
+	return ::LoadObject<UObject>(nullptr, *ObjectPath);
+}
+
+UClass* FUMCP_PackageLoader::LoadClass(const FString& ClassPath)
+{
+	FString PackageName;
+	if (GetPackageToLoad(ClassPath, PackageName))
+	{
+		WaitForLoad(StartLoad(PackageName));
+	}
+	UMCP_TRACE_SCOPE(UMCP_LoadObject);
+	return ::LoadClass<UObject>(nullptr, *ClassPath);
+}
+
+int32 FUMCP_PackageLoader::StartLoad(const FString& PackageName)
+{
+	// The callback can run before LoadPackageAsync returns the id, e.g. for a package that doesn't exist
+	TSharedRef<FUMCP_PackageLoadRequest> Request = MakeShared<FUMCP_PackageLoadRequest>();
+	TWeakPtr<bool> WeakGuard = CallbackGuard;
+	Request->RequestId = LoadPackageAsync(PackageName, FLoadPackageAsyncDelegate::CreateLambda([this, WeakGuard, Request](const FName&, UPackage* Package, EAsyncLoadingResult::Type Result)
+	{
+		Request->bComplete = true;
+		if (WeakGuard.IsValid())
+		{
+			OnLoadComplete(Request->RequestId, Result == EAsyncLoadingResult::Succeeded ? Package : nullptr);
+		}
+	}));
+	if (Request->bComplete)
+	{
+		return INDEX_NONE;
+	}
+	PendingLoads.Add(Request->RequestId);
+	UpdateStats();
+	return Request->RequestId;
+}
+
+void FUMCP_PackageLoader::OnLoadComplete(int32 RequestId, UPackage* Package)
+{
+	PendingLoads.Remove(RequestId);
+	if (Package)
+	{
+		HeldPackages.Add(Package);
+	}
+	{
+		FScopeLock Lock(&StatsLock);
+		Stats.NumLoaded += Package ? 1 : 0;
+	}
+	UpdateStats();
+}
+
+bool FUMCP_PackageLoader::CanRelease(UPackage* Package) const
+{
+	if (Package->IsDirty() || UWorld::FindWorldInPackage(Package))
+	{
+		return false;
+	}
+
+	UAssetEditorSubsystem* AssetEditorSubsystem = GEditor ? GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() : nullptr;
+	if (!AssetEditorSubsystem)
+	{
+		return true;
+	}
+	bool bOpenInEditor = false;
+	ForEachObjectWithPackage(Package, [AssetEditorSubsystem, &bOpenInEditor](UObject* Object)
+	{
+		bOpenInEditor = AssetEditorSubsystem->FindEditorsForAsset(Object).Num() > 0;
+		return !bOpenInEditor;
+	}, false);
+	return !bOpenInEditor;
+}
+
+void FUMCP_PackageLoader::ReleaseIfOverWatermark()
+{
+	if (MemoryWatermarkBytes == 0 || HeldPackages.Num() < MinHeldPackagesPerRelease || IsGarbageCollecting())
+	{
+		return;
+	}
+	const uint64 UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+	if (UsedPhysical < static_cast<uint64>(MemoryWatermarkBytes))
+	{
+		return;
+	}
+
+	UMCP_TRACE_SCOPE(UMCP_ReleasePackages);
+	// Packages the user started working with since they were loaded are theirs now and are never held again
+	TArray<TWeakObjectPtr<UPackage>> ReleasedPackages;
+	TArray<TWeakObjectPtr<UObject>> StandaloneObjects;
+	for (const TWeakObjectPtr<UPackage>& WeakPackage : HeldPackages)
+	{
+		UPackage* Package = WeakPackage.Get();
+		if (!Package || !CanRelease(Package))
+		{
+			continue;
+		}
+		ReleasedPackages.Add(Package);
+		ForEachObjectWithPackage(Package, [&StandaloneObjects](UObject* Object)
+		{
+			if (Object->HasAnyFlags(RF_Standalone))
+			{
+				Object->ClearFlags(RF_Standalone);
+				StandaloneObjects.Add(Object);
+			}
+			return true;
+		});
+	}
+	HeldPackages.Empty();
+	UpdateStats();
+	if (ReleasedPackages.Num() == 0)
+	{
+		return;
+	}
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	// Objects something else still references survived and keep the flag they were loaded with
+	for (const TWeakObjectPtr<UObject>& WeakObject : StandaloneObjects)
+	{
+		if (UObject* Object = WeakObject.Get())
+		{
+			Object->SetFlags(RF_Standalone);
+		}
+	}
+	int32 NumCollected = 0;
+	for (const TWeakObjectPtr<UPackage>& WeakPackage : ReleasedPackages)
+	{
+		NumCollected += WeakPackage.IsValid() ? 0 : 1;
+	}
+	{
+		FScopeLock Lock(&StatsLock);
+		Stats.NumReleased += NumCollected;
+		Stats.NumCollections++;
+	}
+	UE_LOG(LogUnrealMCPServer, Log, TEXT("FUMCP_PackageLoader: Used physical memory %llu MB is over the watermark of %lld MB, released %d of %d packages loaded for exports"),
+		UsedPhysical / (1024 * 1024), MemoryWatermarkBytes / (1024 * 1024), NumCollected, ReleasedPackages.Num());
+}
+
+void FUMCP_PackageLoader::UpdateStats()
+{
+	FScopeLock Lock(&StatsLock);
+	Stats.NumLoading = PendingLoads.Num();
+	Stats.NumHeld = HeldPackages.Num();
+	Stats.MemoryWatermarkBytes = MemoryWatermarkBytes;
+}
+
+FUMCP_PackageLoaderStats FUMCP_PackageLoader::GetStats() const
+{
+	FScopeLock Lock(&StatsLock);
+	return Stats;
+}
@@ -0,0 +1,352 @@
+#include "UMCP_ResourceSubscriptions.h"
+#include "UMCP_PackageChangeNotifier.h"
+#include "UMCP_Trace.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Guid.h"
+#include "Misc/PackageName.h"
+#include "PlatformHttp.h"
+
+FUMCP_ResourceSubscriptions::~FUMCP_ResourceSubscriptions()
+{
+	Shutdown();
+}
+
+void FUMCP_ResourceSubscriptions::Initialize(double InCoalesceSeconds, double InPollTimeoutSeconds, double InSessionTimeoutSeconds, FUMCP_PackageChangeNotifier* InPackageChanges)
+{
+	Shutdown();
+	CoalesceSeconds = FMath::Max(InCoalesceSeconds, 0.0);
+	PollTimeoutSeconds = FMath::Max(InPollTimeoutSeconds, 0.0);
+	SessionTimeoutSeconds = FMath::Max(InSessionTimeoutSeconds, 0.0);
+	if (!InPackageChanges)
+	{
+		return;
+	}
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FUMCP_ResourceSubscriptions::TickFromTicker), 0.05f);
+	PackageChanges = InPackageChanges;
+	PackageChangedHandle = PackageChanges->OnPackageChanged().AddRaw(this, &FUMCP_ResourceSubscriptions::OnPackageChanged);
+}
+
+void FUMCP_ResourceSubscriptions::Shutdown()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+	if (PackageChanges)
+	{
+		PackageChanges->OnPackageChanged().Remove(PackageChangedHandle);
+		PackageChanges = nullptr;
+		PackageChangedHandle.Reset();
+	}
+
+	TArray<FPollCallback> ParkedPolls;
+	{
+		FScopeLock ScopeLock(&Lock);
+		for (TPair<FString, FSession>& Pair : Sessions)
+		{
+			if (Pair.Value.ParkedPoll)
+			{
+				ParkedPolls.Add(MoveTemp(Pair.Value.ParkedPoll));
+			}
+		}
+		Sessions.Empty();
+		PackageSubscribers.Empty();
+		ChangedPackages.Empty();
+		NumSubscriptions = 0;
+	}
+	for (FPollCallback& ParkedPoll : ParkedPolls)
+	{
+		ParkedPoll(TArray<FString>());
+	}
+}
+
+FString FUMCP_ResourceSubscriptions::CreateSession()
+{
+	const FString SessionId = FGuid::NewGuid().ToString(EGuidFormats::Digits);
+	FScopeLock ScopeLock(&Lock);
+	Sessions.Add(SessionId).LastUsedTime = FPlatformTime::Seconds();
+	return SessionId;
+}
+
+bool FUMCP_ResourceSubscriptions::TouchSession(const FString& SessionId)
+{
+	FScopeLock ScopeLock(&Lock);
+	FSession* Session = Sessions.Find(SessionId);
+	if (!Session)
+	{
+		return false;
+	}
+	Session->LastUsedTime = FPlatformTime::Seconds();
+	return true;
+}
+
+bool FUMCP_ResourceSubscriptions::CloseSession(const FString& SessionId)
+{
+	FPollCallback ParkedPoll;
+	{
+		FScopeLock ScopeLock(&Lock);
+		FSession* Session = Sessions.Find(SessionId);
+		if (!Session)
+		{
+			return false;
+		}
+		for (const FString& Uri : Session->Uris)
+		{
+			FName PackageName;
+			if (GetUriPackageName(Uri, PackageName))
+			{
+				RemoveSubscriberLocked(PackageName, SessionId, Uri);
+			}
+		}
+		ParkedPoll = MoveTemp(Session->ParkedPoll);
+		Sessions.Remove(SessionId);
+	}
+	if (ParkedPoll)
+	{
+		ParkedPoll(TArray<FString>());
+	}
+	return true;
+}
+
+bool FUMCP_ResourceSubscriptions::Subscribe(const FString& SessionId, const FString& Uri, FString& OutError)
+{
+	FName PackageName;
+	if (!GetUriPackageName(Uri, PackageName))
+	{
+		OutError = FString::Printf(TEXT("Only asset resources can be subscribed to; '%s' names no package"), *Uri);
+		return false;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	FSession* Session = Sessions.Find(SessionId);
+	if (!Session)
+	{
+		OutError = SessionId.IsEmpty()
+			? FString(TEXT("resources/subscribe needs the Mcp-Session-Id header returned by initialize"))
+			: FString::Printf(TEXT("Unknown or expired session '%s'; initialize again"), *SessionId);
+		return false;
+	}
+	Session->LastUsedTime = FPlatformTime::Seconds();
+	bool bAlreadySubscribed = false;
+	Session->Uris.Add(Uri, &bAlreadySubscribed);
+	if (!bAlreadySubscribed)
+	{
+		PackageSubscribers.FindOrAdd(PackageName).Add({ SessionId, Uri });
+		++NumSubscriptions;
+	}
+	return true;
+}
+
+bool FUMCP_ResourceSubscriptions::Unsubscribe(const FString& SessionId, const FString& Uri)
+{
+	FScopeLock ScopeLock(&Lock);
+	FSession* Session = Sessions.Find(SessionId);
+	if (!Session)
+	{
+		return false;
+	}
+	Session->LastUsedTime = FPlatformTime::Seconds();
+	FName PackageName;
+	if (Session->Uris.Remove(Uri) > 0 && GetUriPackageName(Uri, PackageName))
+	{
+		RemoveSubscriberLocked(PackageName, SessionId, Uri);
+	}
+	Session->PendingUris.Remove(Uri);
+	return true;
+}
+
+void FUMCP_ResourceSubscriptions::RemoveSubscriberLocked(FName PackageName, const FString& SessionId, const FString& Uri)
+{
+	TArray<FSubscriber>* Subscribers = PackageSubscribers.Find(PackageName);
+	if (!Subscribers)
+	{
+		return;
+	}
+	NumSubscriptions -= Subscribers->RemoveAll([&SessionId, &Uri](const FSubscriber& Subscriber)
+	{
+		return Subscriber.SessionId == SessionId && Subscriber.Uri == Uri;
+	});
+	if (Subscribers->Num() == 0)
+	{
+		PackageSubscribers.Remove(PackageName);
+	}
+}
+
+bool FUMCP_ResourceSubscriptions::Poll(const FString& SessionId, FPollCallback&& Callback)
+{
+	FPollCallback ReplacedPoll;
+	TArray<FString> UpdatedUris;
+	bool bAnswerNow = false;
+	{
+		FScopeLock ScopeLock(&Lock);
+		FSession* Session = Sessions.Find(SessionId);
+		if (!Session)
+		{
+			return false;
+		}
+		const double Now = FPlatformTime::Seconds();
+		Session->LastUsedTime = Now;
+		ReplacedPoll = MoveTemp(Session->ParkedPoll);
+		Session->ParkedPoll = nullptr;
+		if (Session->PendingUris.Num() == 0)
+		{
+			Session->ParkedPoll = MoveTemp(Callback);
+			Session->PollTime = Now;
+		}
+		else
+		{
+			UpdatedUris = MoveTemp(Session->PendingUris);
+			Session->PendingUris.Reset();
+			Stats.NumNotificationsSent += UpdatedUris.Num();
+			bAnswerNow = true;
+		}
+	}
+	if (ReplacedPoll)
+	{
+		ReplacedPoll(TArray<FString>());
+	}
+	if (bAnswerNow)
+	{
+		Callback(MoveTemp(UpdatedUris));
+	}
+	return true;
+}
+
+void FUMCP_ResourceSubscriptions::NotifyPackageChanged(FName PackageName, double Now)
+{
+	// Engine events fire constantly while editing, so nothing here may cost anything while nobody is subscribed
+	if (NumSubscriptions.load(std::memory_order_relaxed) == 0 || PackageName.IsNone())
+	{
+		return;
+	}
+	FScopeLock ScopeLock(&Lock);
+	if (!PackageSubscribers.Contains(PackageName))
+	{
+		return;
+	}
+	if (ChangedPackages.Num() == 0)
+	{
+		FirstChangeTime = Now;
+	}
+	ChangedPackages.Add(PackageName);
+	++Stats.NumPackageChanges;
+}
+
+void FUMCP_ResourceSubscriptions::Tick(double Now)
+{
+	TArray<TPair<FPollCallback, TArray<FString>>> Answers;
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (Sessions.Num() == 0)
+		{
+			return;
+		}
+		UMCP_TRACE_SCOPE(UMCP_TickResourceSubscriptions);
+
+		if (ChangedPackages.Num() > 0 && Now - FirstChangeTime >= CoalesceSeconds)
+		{
+			for (FName PackageName : ChangedPackages)
+			{
+				if (const TArray<FSubscriber>* Subscribers = PackageSubscribers.Find(PackageName))
+				{
+					for (const FSubscriber& Subscriber : *Subscribers)
+					{
+						if (FSession* Session = Sessions.Find(Subscriber.SessionId))
+						{
+							Session->PendingUris.AddUnique(Subscriber.Uri);
+						}
+					}
+				}
+			}
+			ChangedPackages.Reset();
+		}
+
+		for (auto It = Sessions.CreateIterator(); It; ++It)
+		{
+			FSession& Session = It.Value();
+			if (Session.ParkedPoll)
+			{
+				if (Session.PendingUris.Num() > 0)
+				{
+					Stats.NumNotificationsSent += Session.PendingUris.Num();
+					Answers.Emplace(MoveTemp(Session.ParkedPoll), MoveTemp(Session.PendingUris));
+				}
+				else if (Now - Session.PollTime >= PollTimeoutSeconds)
+				{
+					// The client polls again right away, so an empty answer only keeps proxies from timing the request out
+					Answers.Emplace(MoveTemp(Session.ParkedPoll), TArray<FString>());
+				}
+				else
+				{
+					continue;
+				}
+				Session.ParkedPoll = nullptr;
+				Session.PendingUris.Reset();
+				Session.LastUsedTime = Now;
+			}
+			else if (Now - Session.LastUsedTime >= SessionTimeoutSeconds)
+			{
+				for (const FString& Uri : Session.Uris)
+				{
+					FName PackageName;
+					if (GetUriPackageName(Uri, PackageName))
+					{
+						RemoveSubscriberLocked(PackageName, It.Key(), Uri);
+					}
+				}
+				It.RemoveCurrent();
+				++Stats.NumExpiredSessions;
+			}
+		}
+	}
+	for (TPair<FPollCallback, TArray<FString>>& Answer : Answers)
+	{
+		Answer.Key(MoveTemp(Answer.Value));
+	}
+}
+
+bool FUMCP_ResourceSubscriptions::TickFromTicker(float DeltaTime)
+{
+	Tick(FPlatformTime::Seconds());
+	return true;
+}
+
+bool FUMCP_ResourceSubscriptions::GetUriPackageName(const FString& Uri, FName& OutPackageName)
+{
+	const int32 SchemeEnd = Uri.Find(TEXT("://"), ESearchCase::CaseSensitive);
+	if (SchemeEnd == INDEX_NONE)
+	{
+		return false;
+	}
+	// A query (e.g. the range of a chunked read) names the same asset
+	const int32 QueryStart = Uri.Find(TEXT("?"), ESearchCase::CaseSensitive, ESearchDir::FromStart, SchemeEnd + 3);
+	const int32 PathEnd = QueryStart != INDEX_NONE ? QueryStart : Uri.Len();
+	const FString ObjectPath = FPlatformHttp::UrlDecode(Uri.Mid(SchemeEnd + 3, PathEnd - SchemeEnd - 3));
+	const FString PackageName = FPackageName::ObjectPathToPackageName(ObjectPath);
+	if (!FPackageName::IsValidLongPackageName(PackageName))
+	{
+		return false;
+	}
+	OutPackageName = FName(*PackageName);
+	return true;
+}
+
+FUMCP_ResourceSubscriptionsStats FUMCP_ResourceSubscriptions::GetStats() const
+{
+	FScopeLock ScopeLock(&Lock);
+	FUMCP_ResourceSubscriptionsStats Result = Stats;
+	Result.NumSessions = Sessions.Num();
+	Result.NumSubscriptions = NumSubscriptions.load(std::memory_order_relaxed);
+	for (const TPair<FString, FSession>& Pair : Sessions)
+	{
+		Result.NumParkedPolls += Pair.Value.ParkedPoll ? 1 : 0;
+	}
+	return Result;
+}
+
+void FUMCP_ResourceSubscriptions::OnPackageChanged(FName PackageName, EUMCP_PackageChangeKind Kind)
+{
+	NotifyPackageChanged(PackageName, FPlatformTime::Seconds());
+}
@@ -2,6 +2,8 @@
 #include "UMCP_Types.h"
 #include "UMCP_CommonTools.h"
 #include "UMCP_CommonResources.h"
+#include "UMCP_ToolProgress.h"
+#include "UMCP_Trace.h"
 #include "UnrealMCPServerModule.h"
 
 #include "HttpServerModule.h"
@@ -14,30 +16,54 @@
 #include "Serialization/JsonSerializer.h"
 #include "Engine/Engine.h"
 #include "Async/Async.h"
+#include "Misc/Base64.h"
+#include "Misc/Compression.h"
+#include "Misc/ScopeExit.h"
 
 
+UE_TRACE_CHANNEL_DEFINE(UnrealMCPChannel);
+
 const FString FUMCP_Server::MCP_PROTOCOL_VERSION = TEXT("2024-11-05");//TEXT("2025-03-26");
 const FString FUMCP_Server::PLUGIN_VERSION = TEXT("0.1.0");
 
-void FUMCP_Server::StartServer()
+bool FUMCP_Server::StartServer(uint32 InHttpServerPort)
 {
+	HttpServerPort = InHttpServerPort;
+	Settings.LoadFromConfig();
+	LogBuffer.Initialize(Settings.LogBufferLines);
+	PackageChangeNotifier.Initialize();
+	ResourceSubscriptions.Initialize(Settings.ResourceNotifyCoalesceMs / 1000.0, Settings.ResourcePollTimeoutSeconds, Settings.SessionIdleTimeoutSeconds, &PackageChangeNotifier);
+	ExportCache.Initialize(static_cast<int64>(Settings.ExportCacheBudgetMB) * 1024 * 1024, Settings.bExportCacheDiskTier ? static_cast<int64>(Settings.ExportCacheDiskBudgetMB) * 1024 * 1024 : 0, &PackageChangeNotifier);
+	AssetSearchSnapshots.Initialize(static_cast<int64>(Settings.SearchSnapshotBudgetMB) * 1024 * 1024, Settings.SearchSnapshotTtlSeconds);
+	if (Settings.bAssetNameIndex)
+	{
+		AssetNameIndex.Initialize();
+	}
+	DependencyGraph.Initialize(&PackageChangeNotifier, true);
+	BlueprintContentIndex.Initialize();
+	PackageLoader.Initialize(Settings.ExportLoadConcurrency, static_cast<int64>(Settings.ExportMemoryWatermarkMB) * 1024 * 1024);
+
 	FHttpServerModule& HttpServerModule = FHttpServerModule::Get();
 	HttpRouter = HttpServerModule.GetHttpRouter(HttpServerPort);
 	if (!HttpRouter.IsValid())
 	{
 		UE_LOG(LogUnrealMCPServer, Error, TEXT("Failed to get HttpRouter on port %d. Another server might be running or port is in use."), HttpServerPort);
-		return;
+		return false;
 	}
 
-	RouteHandle_MCPStreamableHTTP = HttpRouter->BindRoute(FHttpPath(TEXT("/mcp")), EHttpServerRequestVerbs::VERB_POST,
+	RouteHandle_MCPStreamableHTTP = HttpRouter->BindRoute(FHttpPath(TEXT("/mcp")), EHttpServerRequestVerbs::VERB_POST | EHttpServerRequestVerbs::VERB_GET | EHttpServerRequestVerbs::VERB_DELETE,
 #if (ENGINE_MAJOR_VERSION >= (5) && ENGINE_MINOR_VERSION >= (4))
 		FHttpRequestHandler::CreateLambda(
 #endif
 			[this](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) -> bool
 			{
-				AsyncTask(ENamedThreads::GameThread, [this, Request, OnComplete]() {
-					this->HandleStreamableHTTPMCPRequest(Request, OnComplete);
-				});
+				if (Request.Verb != EHttpServerRequestVerbs::VERB_POST)
+				{
+					this->HandleSessionRequest(Request, OnComplete);
+					return true;
+				}
+				// Parsing and dispatch happen right here; only handlers with game thread affinity are deferred
+				this->HandleStreamableHTTPMCPRequest(Request, OnComplete);
 				return true;
 			}
 #if (ENGINE_MAJOR_VERSION == (5) && ENGINE_MINOR_VERSION >= (5))
@@ -45,12 +71,16 @@ void FUMCP_Server::StartServer()
 #endif
 		);
 	RegisterInternalRpcMethodHandlers();
+	RegisterMetricsResource();
+
+	GameThreadQueueTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FUMCP_Server::TickGameThreadQueue));
 
 	UE_LOG(LogUnrealMCPServer, Log, TEXT("Bound /mcp to handler."));
 
     // Start listening for requests
     HttpServerModule.StartAllListeners();
 	UE_LOG(LogUnrealMCPServer, Log, TEXT("HTTP Server started on port %d"), HttpServerPort);
+	return true;
 }
 
 void FUMCP_Server::StopServer()
@@ -67,19 +97,60 @@ void FUMCP_Server::StopServer()
 		UE_LOG(LogUnrealMCPServer, Log, TEXT("All routes unbound."));
 		HttpRouter.Reset();
 	}
+	// Answers the parked GET /mcp polls
+	ResourceSubscriptions.Shutdown();
+
+	if (GameThreadQueueTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(GameThreadQueueTickerHandle);
+		GameThreadQueueTickerHandle.Reset();
+	}
+	FlushGameThreadQueue();
+	{
+		// Running jobs are only stepped from the ticker, so they cannot finish anymore
+		FScopeLock Lock(&JobsLock);
+		Jobs.Empty();
+	}
+
+	// Background requests reference the handler tables, so let them drain before tearing those down
+	while (PendingTaskGraphRequests.GetValue() > 0)
+	{
+		FPlatformProcess::Sleep(0.001f);
+	}
 	JsonRpcMethodHandlers.Empty();
+	ExportCache.Shutdown();
+	AssetSearchSnapshots.Shutdown();
+	AssetNameIndex.Shutdown();
+	DependencyGraph.Shutdown();
+	PackageChangeNotifier.Shutdown();
+	BlueprintContentIndex.Shutdown();
+	PackageLoader.Shutdown();
+	LogBuffer.Shutdown();
 
 	// let the HttpServerModule clean itself up whenever it goes away.  Nothing to do here
 }
 
-void FUMCP_Server::RegisterRpcMethodHandler(const FString& MethodName, UMCP_JsonRpcHandler&& Handler)
+void FUMCP_Server::RegisterRpcMethodHandler(const FString& MethodName, UMCP_JsonRpcHandler&& Handler, EUMCP_ExecutionAffinity ExecutionAffinity, EUMCP_RequestPriority Priority)
+{
+	FUMCP_JsonRpcMethodHandler MethodHandler;
+	MethodHandler.Handler = MoveTemp(Handler);
+	MethodHandler.ExecutionAffinity = ExecutionAffinity;
+	MethodHandler.Priority = Priority;
+	JsonRpcMethodHandlers.Add(MethodName, MoveTemp(MethodHandler));
+}
+
+void FUMCP_Server::RegisterRawRpcMethodHandler(const FString& MethodName, UMCP_JsonRpcRawHandler&& Handler, EUMCP_ExecutionAffinity ExecutionAffinity, EUMCP_RequestPriority Priority)
 {
-	JsonRpcMethodHandlers.Add(MethodName, Handler);
+	FUMCP_JsonRpcMethodHandler MethodHandler;
+	MethodHandler.RawHandler = MoveTemp(Handler);
+	MethodHandler.ExecutionAffinity = ExecutionAffinity;
+	MethodHandler.Priority = Priority;
+	JsonRpcMethodHandlers.Add(MethodName, MoveTemp(MethodHandler));
 }
 
 bool FUMCP_Server::RegisterTool(FUMCP_ToolDefinition Tool)
 {
-	if (!Tool.DoToolCall.IsBound())
+	if (!Tool.DoToolCall.IsBound() && !Tool.StartJob.IsBound())
 	{
 		return false;
 	}
@@ -88,6 +159,60 @@ bool FUMCP_Server::RegisterTool(FUMCP_ToolDefinition Tool)
 		return false;
 	}
 	Tools.Add(Tool.name, Tool);
+	InvalidateListing(ToolsListing);
+	return true;
+}
+
+bool FUMCP_Server::ResolveToolSchemas(FUMCP_ToolDefinition& Tool)
+{
+	// Tools are listed and called from any thread, so the first one to need the schemas generates them
+	FScopeLock Lock(&ToolSchemasLock);
+	if (Tool.bSchemasResolved)
+	{
+		return false;
+	}
+	if (Tool.InputSchemaBuilder)
+	{
+		TSharedPtr<FJsonObject> InputSchema = Tool.InputSchemaBuilder();
+		if (InputSchema.IsValid())
+		{
+			Tool.inputSchema = InputSchema;
+		}
+		else
+		{
+			UE_LOG(LogUnrealMCPServer, Error, TEXT("ResolveToolSchemas: Failed to generate inputSchema for tool '%s'"), *Tool.name);
+		}
+		Tool.InputSchemaBuilder.Reset();
+	}
+	if (Tool.OutputSchemaBuilder)
+	{
+		Tool.outputSchema = Tool.OutputSchemaBuilder();
+		if (!Tool.outputSchema.IsValid())
+		{
+			UE_LOG(LogUnrealMCPServer, Error, TEXT("ResolveToolSchemas: Failed to generate outputSchema for tool '%s'"), *Tool.name);
+		}
+		Tool.OutputSchemaBuilder.Reset();
+	}
+	if (Tool.StartJob.IsBound())
+	{
+		// Every job tool accepts runAsJob, so it is added here rather than in each tool's params struct
+		TSharedPtr<FJsonObject> Properties;
+		const TSharedPtr<FJsonObject>* ExistingProperties = nullptr;
+		if (Tool.inputSchema->TryGetObjectField(TEXT("properties"), ExistingProperties))
+		{
+			Properties = *ExistingProperties;
+		}
+		else
+		{
+			Properties = MakeShared<FJsonObject>();
+			Tool.inputSchema->SetObjectField(TEXT("properties"), Properties);
+		}
+		TSharedPtr<FJsonObject> RunAsJob = MakeShared<FJsonObject>();
+		RunAsJob->SetStringField(TEXT("type"), TEXT("boolean"));
+		RunAsJob->SetStringField(TEXT("description"), TEXT("Return a job id immediately instead of waiting for the result. Poll it with get_job_status and stop it with cancel_job."));
+		Properties->SetObjectField(TEXT("runAsJob"), RunAsJob);
+	}
+	Tool.bSchemasResolved = true;
 	return true;
 }
 
@@ -117,7 +242,9 @@ bool FUMCP_Server::RegisterResourceTemplate(FUMCP_ResourceTemplateDefinition Res
 		return false;
 	}
 	
+	ResourceTemplateRouter.Add(UriTemplate, ResourceTemplates.Num());
 	ResourceTemplates.Emplace(MoveTemp(UriTemplate), MoveTemp(ResourceTemplate));
+	InvalidateListing(ResourceTemplatesListing);
 	return true;
 }
 
@@ -132,328 +259,1485 @@ bool FUMCP_Server::RegisterPrompt(FUMCP_PromptDefinitionInternal Prompt)
 		return false;
 	}
 	Prompts.Add(Prompt.name, Prompt);
+	InvalidateListing(PromptsListing);
 	return true;
 }
 
-// Helper to send a JSON response
-void FUMCP_Server::SendJsonRpcResponse(const FHttpResultCallback& OnComplete, const FUMCP_JsonRpcResponse& RpcResponse)
+namespace
 {
-	FString JsonPayload;
-	if (!RpcResponse.ToJsonString(JsonPayload))
+	const ANSICHAR* SerializeFailedPayload = "{\"jsonrpc\":\"2.0\",\"id\":null,\"error\":{\"code\":-32603,\"message\":\"Internal error - Failed to serialize response\"}}";
+
+	void SerializeJsonRpcResponse(const FUMCP_JsonRpcResponse& RpcResponse, TArray<uint8>& OutJsonPayload)
+	{
+		OutJsonPayload.Reserve(RpcResponse.rawResult.Num() + 128);
+		if (!RpcResponse.ToJsonUtf8(OutJsonPayload))
+		{
+			UE_LOG(LogUnrealMCPServer, Error, TEXT("Failed to serialize response."));
+			OutJsonPayload.Reset();
+			UMCP_AppendUtf8(OutJsonPayload, SerializeFailedPayload);
+		}
+	}
+
+	const TCHAR* JobStatusToString(EUMCP_JobStatus Status)
 	{
-		UE_LOG(LogUnrealMCPServer, Error, TEXT("Failed to serialize response."));
-		JsonPayload = TEXT("{\"jsonrpc\": \"2.0\", \"id\": null, \"error\": {\"code\": -32603, \"message\": \"Internal error - Failed to serialize response\"}}");
+		switch (Status)
+		{
+		case EUMCP_JobStatus::Running: return TEXT("running");
+		case EUMCP_JobStatus::Completed: return TEXT("completed");
+		case EUMCP_JobStatus::Failed: return TEXT("failed");
+		case EUMCP_JobStatus::Cancelled: return TEXT("cancelled");
+		}
+		return TEXT("unknown");
 	}
 
-	if (JsonPayload.Len() > 1000)
+	// ToString() formats numbers with %g, which is not exact for large ids, so compare the values themselves
+	bool JsonRpcIdsMatch(const FUMCP_JsonRpcId& A, const FUMCP_JsonRpcId& B)
 	{
-		UE_LOG(LogUnrealMCPServer, Verbose, TEXT("SendJsonResponse: Payload received (truncated): %s"), *JsonPayload.Left(1000));
+		if (A.IsString() && B.IsString())
+		{
+			return A.GetJsonValue()->AsString() == B.GetJsonValue()->AsString();
+		}
+		return A.IsNumber() && B.IsNumber() && A.GetJsonValue()->AsNumber() == B.GetJsonValue()->AsNumber();
 	}
-	else
+
+	// Picks the FCompression format for an Accept-Encoding header, preferring gzip. Codings with q=0 are refused.
+	FName ChooseContentEncoding(const FHttpServerRequest& Request)
+	{
+		const TArray<FString>* AcceptEncodingHeaders = Request.Headers.Find(TEXT("Accept-Encoding"));
+		if (!AcceptEncodingHeaders)
+		{
+			return NAME_None;
+		}
+
+		bool bAcceptsGzip = false;
+		bool bAcceptsDeflate = false;
+		for (const FString& AcceptEncodingHeader : *AcceptEncodingHeaders)
+		{
+			TArray<FString> Codings;
+			AcceptEncodingHeader.ParseIntoArray(Codings, TEXT(","));
+			for (const FString& Coding : Codings)
+			{
+				FString Name = Coding, Parameters;
+				Coding.Split(TEXT(";"), &Name, &Parameters);
+				Name.TrimStartAndEndInline();
+				Parameters.TrimStartAndEndInline();
+				if (Parameters.StartsWith(TEXT("q=")) && FCString::Atod(*Parameters.RightChop(2)) <= 0.0)
+				{
+					continue;
+				}
+				bAcceptsGzip |= Name.Equals(TEXT("gzip"), ESearchCase::IgnoreCase) || Name == TEXT("*");
+				bAcceptsDeflate |= Name.Equals(TEXT("deflate"), ESearchCase::IgnoreCase);
+			}
+		}
+
+		// HTTP "deflate" is the zlib format (RFC 1950), which is exactly what NAME_Zlib produces
+		return bAcceptsGzip ? NAME_Gzip : (bAcceptsDeflate ? NAME_Zlib : NAME_None);
+	}
+
+	FString GetSessionIdHeader(const FHttpServerRequest& Request)
+	{
+		const TArray<FString>* SessionIdHeaders = Request.Headers.Find(TEXT("Mcp-Session-Id"));
+		return SessionIdHeaders && SessionIdHeaders->Num() > 0 ? (*SessionIdHeaders)[0].TrimStartAndEnd() : FString();
+	}
+}
+
+// Helper to send a JSON response
+void FUMCP_Server::SendJsonRpcResponse(const FHttpResultCallback& OnComplete, const FUMCP_JsonRpcResponse& RpcResponse, EHttpServerResponseCodes ResponseCode, FName ContentEncoding)
+{
+	TArray<uint8> JsonPayload;
+	SerializeJsonRpcResponse(RpcResponse, JsonPayload);
+	SendJsonPayload(OnComplete, MoveTemp(JsonPayload), ResponseCode, TEXT("application/json"), ContentEncoding);
+}
+
+void FUMCP_Server::SendJsonPayload(const FHttpResultCallback& OnComplete, TArray<uint8>&& JsonPayload, EHttpServerResponseCodes ResponseCode, const TCHAR* ContentType, FName ContentEncoding, const FString& SessionId)
+{
+	const bool bShouldCompress = !ContentEncoding.IsNone() && Settings.CompressionThresholdBytes > 0 && JsonPayload.Num() >= Settings.CompressionThresholdBytes;
+	if (bShouldCompress && IsInGameThread())
+	{
+		// Multi-megabyte exports take a while to compress, so do it off the game thread like the rest of the serialization
+		PendingTaskGraphRequests.Increment();
+		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this, OnComplete, JsonPayload = MoveTemp(JsonPayload), ResponseCode, ContentType, ContentEncoding, SessionId]() mutable {
+			SendJsonPayload(OnComplete, MoveTemp(JsonPayload), ResponseCode, ContentType, ContentEncoding, SessionId);
+			PendingTaskGraphRequests.Decrement();
+		});
+		return;
+	}
+
+	if (UE_LOG_ACTIVE(LogUnrealMCPServer, Verbose))
 	{
-		UE_LOG(LogUnrealMCPServer, Verbose, TEXT("SendJsonResponse: Payload received: %s"), *JsonPayload);
+		const int32 LoggedBytes = FMath::Min(JsonPayload.Num(), 1000);
+		UE_LOG(LogUnrealMCPServer, Verbose, TEXT("SendJsonResponse: Payload received%s: %s"), JsonPayload.Num() > LoggedBytes ? TEXT(" (truncated)") : TEXT(""),
+			*UMCP_Utf8ToString(TConstArrayView<uint8>(JsonPayload.GetData(), LoggedBytes)));
 	}
-    TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(JsonPayload, TEXT("application/json"));
-    Response->Code = EHttpServerResponseCodes::Ok; 
 
+	const bool bCompressed = bShouldCompress && CompressPayload(JsonPayload, ContentEncoding);
+
+	// The UTF-8 body is moved into the response, so this is the last place the payload bytes are touched
+    TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(MoveTemp(JsonPayload), ContentType);
     if (!Response.IsValid())
     {
         UE_LOG(LogUnrealMCPServer, Error, TEXT("SendJsonResponse: FHttpServerResponse::Create failed to create a valid response object!"));
         return; 
     }
+
+    Response->Code = ResponseCode;
+    if (ResponseCode == EHttpServerResponseCodes::ServiceUnavail)
+    {
+        // Tell well-behaved clients when to come back instead of letting them pile up timeouts
+        Response->Headers.Add(TEXT("Retry-After"), { TEXT("1") });
+    }
+    if (bCompressed)
+    {
+        Response->Headers.Add(TEXT("Content-Encoding"), { ContentEncoding == NAME_Gzip ? TEXT("gzip") : TEXT("deflate") });
+    }
+    if (!SessionId.IsEmpty())
+    {
+        Response->Headers.Add(TEXT("Mcp-Session-Id"), { SessionId });
+    }
     
     UE_LOG(LogUnrealMCPServer, Verbose, TEXT("SendJsonResponse: Calling OnComplete. Response Code: %d"), Response->Code);
+	if (!IsInGameThread())
+	{
+		// The HTTP listeners are pumped from the game thread, so hand the finished response back there.
+		// All of the expensive work (handler + serialization) has already happened on this thread.
+		AsyncTask(ENamedThreads::GameThread, [OnComplete, Response = MoveTemp(Response)]() mutable {
+			OnComplete(MoveTemp(Response));
+		});
+		return;
+	}
     OnComplete(MoveTemp(Response));
 }
 
-// Main handler for MCP requests, runs on an HTTP thread
-void FUMCP_Server::HandleStreamableHTTPMCPRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+void FUMCP_Server::SendRequestSetResponse(const FUMCP_JsonRpcRequestSet& RequestSet)
 {
-	FUTF8ToTCHAR Convert((ANSICHAR*)Request.Body.GetData(), Request.Body.Num());
-	FString RequestBody(Convert.Length(), Convert.Get());
-    UE_LOG(LogUnrealMCPServer, Verbose, TEXT("Received MCP request: %s"), *RequestBody);
-	
-	FUMCP_JsonRpcResponse Response;
+	UMCP_TRACE_SCOPE(UMCP_SerializeResponse);
+	const double StartTime = FPlatformTime::Seconds();
 
-    FUMCP_JsonRpcRequest RpcRequest;
-    if (!FUMCP_JsonRpcRequest::CreateFromJsonString(RequestBody, RpcRequest))
-    {
-        UE_LOG(LogUnrealMCPServer, Error, TEXT("Failed to parse MCP request JSON: %s"), *RequestBody);
-    	Response.error = MakeShared<FUMCP_JsonRpcError>(EUMCP_JsonRpcErrorCode::ParseError, TEXT("Failed to parse MCP request JSON"));
-        SendJsonRpcResponse(OnComplete, Response);
-        return;
-    }
-	Response.id = RpcRequest.id;
-
-    if (RpcRequest.jsonrpc != TEXT("2.0"))
-    {
-        UE_LOG(LogUnrealMCPServer, Error, TEXT("Invalid JSON-RPC version: %s"), *RpcRequest.jsonrpc);
-		Response.error = MakeShared<FUMCP_JsonRpcError>(EUMCP_JsonRpcErrorCode::InvalidRequest, TEXT("Invalid Request - JSON-RPC version must be 2.0"));
-        SendJsonRpcResponse(OnComplete, Response);
-        return;
-    }
+	// Compression may still run on another thread inside SendJsonPayload; its cost is tracked by CompressionStats
+	auto Send = [this, &RequestSet, StartTime](TArray<uint8>&& JsonPayload, EHttpServerResponseCodes ResponseCode, const TCHAR* ContentType)
+	{
+		const FString MetricsKey = RequestSet.bIsBatch ? FString(TEXT("batch")) : GetMetricsKey(RequestSet.Requests[0]);
+		RecordSerialization(MetricsKey, (FPlatformTime::Seconds() - StartTime) * 1000.0, JsonPayload.Num());
+		SendJsonPayload(RequestSet.OnComplete, MoveTemp(JsonPayload), ResponseCode, ContentType, RequestSet.ContentEncoding, RequestSet.NewSessionId);
+	};
 
-	UMCP_JsonRpcHandler* Handler = JsonRpcMethodHandlers.Find(RpcRequest.method);
-	if (!Handler)
+	if (RequestSet.EventStream.IsValid() && RequestSet.EventStream->HasEvents())
 	{
-        UE_LOG(LogUnrealMCPServer, Warning, TEXT("Unknown MCP method received: %s"), *RpcRequest.method);
-		Response.error = MakeShared<FUMCP_JsonRpcError>(EUMCP_JsonRpcErrorCode::MethodNotFound, TEXT("Method not found"));
-		SendJsonRpcResponse(OnComplete, Response);
+		Send(BuildEventStreamBody(RequestSet), EHttpServerResponseCodes::Ok, TEXT("text/event-stream"));
 		return;
 	}
 
-	auto SuccessObject = MakeShared<FJsonObject>();
-	auto ErrorObject = MakeShared<FUMCP_JsonRpcError>();
-	if (!(*Handler)(RpcRequest, SuccessObject, *ErrorObject))
+	if (!RequestSet.bIsBatch)
 	{
-		UE_LOG(LogUnrealMCPServer, Warning, TEXT("Error handling '%s': (%d) %s"), *RpcRequest.method, ErrorObject->code, *ErrorObject->message);
-		Response.error = MoveTemp(ErrorObject);
-		SendJsonRpcResponse(OnComplete, Response);
+		TArray<uint8> JsonPayload;
+		SerializeJsonRpcResponse(RequestSet.Responses[0], JsonPayload);
+		Send(MoveTemp(JsonPayload), RequestSet.ResponseCode, TEXT("application/json"));
 		return;
 	}
-	Response.result = MakeShared<FJsonValueObject>(MoveTemp(SuccessObject));
-	SendJsonRpcResponse(OnComplete, Response);
-}
-
-void FUMCP_Server::RegisterInternalRpcMethodHandlers()
-{
-	// General 
-	RegisterRpcMethodHandler(TEXT("initialize"), [this](const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
-	{
-		return Rpc_Initialize(Request, OutSuccess, OutError);
-	});
-	RegisterRpcMethodHandler(TEXT("ping"), [this](const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
-	{
-		return Rpc_Ping(Request, OutSuccess, OutError);
-	});
-	RegisterRpcMethodHandler(TEXT("notifications/initialized"), [this](const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
-	{
-		return Rpc_ClientNotifyInitialized(Request, OutSuccess, OutError);
-	});
 
-	// Tools
-	RegisterRpcMethodHandler(TEXT("tools/list"), [this](const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
-	{
-		return Rpc_ToolsList(Request, OutSuccess, OutError);
-	});
-	RegisterRpcMethodHandler(TEXT("tools/call"), [this](const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+	// Per JSON-RPC 2.0, notifications get no entry in the batch response
+	TArray<const FUMCP_JsonRpcResponse*> BatchResponses;
+	for (int32 Index = 0; Index < RequestSet.Requests.Num(); ++Index)
 	{
-		return Rpc_ToolsCall(Request, OutSuccess, OutError);
-	});
+		if (!RequestSet.Requests[Index].bIsNotification)
+		{
+			BatchResponses.Add(&RequestSet.Responses[Index]);
+		}
+	}
 
-	// Resources
-	RegisterRpcMethodHandler(TEXT("resources/list"), [this](const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
-	{
-		return Rpc_ResourcesList(Request, OutSuccess, OutError);
-	});
-	RegisterRpcMethodHandler(TEXT("resources/templates/list"), [this](const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
-	{
-		return Rpc_ResourcesTemplatesList(Request, OutSuccess, OutError);
-	});
-	RegisterRpcMethodHandler(TEXT("resources/read"), [this](const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+	if (BatchResponses.Num() == 0)
 	{
-		return Rpc_ResourcesRead(Request, OutSuccess, OutError);
-	});
+		SendJsonPayload(RequestSet.OnComplete, TArray<uint8>(), EHttpServerResponseCodes::Accepted, TEXT("application/json"), NAME_None, RequestSet.NewSessionId);
+		return;
+	}
 
-	// Prompts
-	RegisterRpcMethodHandler(TEXT("prompts/list"), [this](const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
-	{
-		return Rpc_PromptsList(Request, OutSuccess, OutError);
-	});
-	RegisterRpcMethodHandler(TEXT("prompts/get"), [this](const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+	TArray<uint8> JsonPayload;
+	if (!FUMCP_JsonRpcResponse::BatchToJsonUtf8(BatchResponses, JsonPayload))
 	{
-		return Rpc_PromptsGet(Request, OutSuccess, OutError);
-	});
+		UE_LOG(LogUnrealMCPServer, Error, TEXT("Failed to serialize batch response."));
+		JsonPayload.Reset();
+		UMCP_AppendUtf8(JsonPayload, SerializeFailedPayload);
+	}
+	Send(MoveTemp(JsonPayload), EHttpServerResponseCodes::Ok, TEXT("application/json"));
 }
 
-bool FUMCP_Server::Rpc_Initialize(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+TArray<uint8> FUMCP_Server::BuildEventStreamBody(const FUMCP_JsonRpcRequestSet& RequestSet)
 {
-	FUMCP_InitializeParams Params;
-	if (!UMCP_CreateFromJsonObject(Request.params, Params))
+	// Notifications emitted while the requests ran come first, followed by one `message` event per response
+	TArray<uint8> JsonMessage;
+	for (int32 Index = 0; Index < RequestSet.Requests.Num(); ++Index)
 	{
-		OutError.SetError(EUMCP_JsonRpcErrorCode::InvalidParams);
-		OutError.message = TEXT("Failed to parse 'initialize' params");
-        return false;
-	}
+		if (RequestSet.bIsBatch && RequestSet.Requests[Index].bIsNotification)
+		{
+			continue;
+		}
 
-	// TODO proper capabilities negotiation
-	
-	FUMCP_InitializeResult Result;
-	Result.protocolVersion = MCP_PROTOCOL_VERSION; // Server's supported version
-	Result.serverInfo.name = TEXT("UnrealMCPServer");
-	Result.serverInfo.version = PLUGIN_VERSION + TEXT(" (") + FEngineVersion::Current().ToString(EVersionComponent::Patch) + TEXT(")");
+		JsonMessage.Reset();
+		if (!RequestSet.Responses[Index].ToJsonUtf8(JsonMessage))
+		{
+			UE_LOG(LogUnrealMCPServer, Error, TEXT("Failed to serialize response %d of event stream."), Index);
+			JsonMessage.Reset();
+			UMCP_AppendUtf8(JsonMessage, SerializeFailedPayload);
+		}
+		RequestSet.EventStream->AppendMessage(JsonMessage);
+	}
+	return RequestSet.EventStream->TakeBody();
+}
 
-	// Populate ServerCapabilities (defaults are fine for now as defined in MCPTypes.h constructors)
-	// FServerCapabilities members are default-initialized. Example: Result.serverCapabilities.tools.inputSchema = true;
+bool FUMCP_Server::CompressPayload(TArray<uint8>& InOutPayload, FName ContentEncoding)
+{
+	UMCP_TRACE_SCOPE(UMCP_CompressPayload);
+	const double StartTime = FPlatformTime::Seconds();
 
-	if (!UMCP_ToJsonObject(Result, OutSuccess))
+	int32 CompressedSize = FCompression::CompressMemoryBound(ContentEncoding, InOutPayload.Num());
+	TArray<uint8> CompressedPayload;
+	CompressedPayload.SetNumUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(ContentEncoding, CompressedPayload.GetData(), CompressedSize, InOutPayload.GetData(), InOutPayload.Num()))
+	{
+		UE_LOG(LogUnrealMCPServer, Warning, TEXT("CompressPayload: %s compression of %d bytes failed, sending uncompressed"), *ContentEncoding.ToString(), InOutPayload.Num());
+		return false;
+	}
+	if (CompressedSize >= InOutPayload.Num())
 	{
-		OutError.SetError(EUMCP_JsonRpcErrorCode::InternalError);
-		OutError.message = TEXT("Failed to serialize initialize result");
 		return false;
 	}
+	CompressedPayload.SetNum(CompressedSize);
 
-	return true;
-}
+	const double CompressMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	const double Ratio = static_cast<double>(CompressedSize) / static_cast<double>(InOutPayload.Num());
+	UE_LOG(LogUnrealMCPServer, Verbose, TEXT("CompressPayload: %s %d -> %d bytes (ratio %.3f) in %.2f ms"), *ContentEncoding.ToString(), InOutPayload.Num(), CompressedSize, Ratio, CompressMs);
+	{
+		FScopeLock Lock(&CompressionStatsLock);
+		CompressionStats.CompressedResponses++;
+		CompressionStats.UncompressedBytes += InOutPayload.Num();
+		CompressionStats.CompressedBytes += CompressedSize;
+		CompressionStats.TotalCompressMs += CompressMs;
+		CompressionStats.LastRatio = Ratio;
+		CompressionStats.LastCompressMs = CompressMs;
+	}
 
-bool FUMCP_Server::Rpc_Ping(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
-{
-	UE_LOG(LogUnrealMCPServer, Verbose, TEXT("Handling ping method."));
+	InOutPayload = MoveTemp(CompressedPayload);
 	return true;
 }
 
-bool FUMCP_Server::Rpc_ClientNotifyInitialized(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+void FUMCP_LatencyHistogram::Add(double Ms)
 {
-	UE_LOG(LogUnrealMCPServer, Verbose, TEXT("Handling ClientNotifyInitialized method."));
-	return true;
+	int32 Bucket = 0;
+	while (Bucket < NumBuckets - 1 && Ms > BucketUpperBoundsMs[Bucket])
+	{
+		++Bucket;
+	}
+	BucketCounts[Bucket]++;
+	Count++;
+	TotalMs += Ms;
+	MaxMs = FMath::Max(MaxMs, Ms);
 }
 
-bool FUMCP_Server::Rpc_ToolsList(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+double FUMCP_LatencyHistogram::GetPercentileMs(double Percentile) const
 {
-	FUMCP_ListToolsParams Params;
-	if (!UMCP_CreateFromJsonObject(Request.params, Params, true))
+	if (Count == 0)
 	{
-		OutError.SetError(EUMCP_JsonRpcErrorCode::InvalidParams);
-		OutError.message = TEXT("Failed to parse list tools params");
-        return false;
+		return 0.0;
 	}
-
-	// Unfortunately, unreal doesn't have a good json serialization override and the json tools have
-	// a schema that was too complicated to deal with the complexity in the middle.
-	// So for now we manually add them to the response array here.
-	TArray<TSharedPtr<FJsonValue>> ResultTools;
-	for (auto Itr = Tools.CreateConstIterator(); Itr; ++Itr)
+	const uint64 Target = FMath::Max<uint64>(1, static_cast<uint64>(FMath::CeilToDouble(FMath::Clamp(Percentile, 0.0, 100.0) / 100.0 * static_cast<double>(Count))));
+	uint64 Seen = 0;
+	for (int32 Bucket = 0; Bucket < NumBuckets - 1; ++Bucket)
 	{
-		auto ToolDef = MakeShared<FJsonObject>();
-		ToolDef->SetStringField(TEXT("name"), Itr->Key);
-		ToolDef->SetStringField(TEXT("description"), Itr->Value.description);
-		ToolDef->SetObjectField(TEXT("inputSchema"), Itr->Value.inputSchema);
-		if (Itr->Value.outputSchema.IsValid())
+		Seen += BucketCounts[Bucket];
+		if (Seen >= Target)
 		{
-			ToolDef->SetObjectField(TEXT("outputSchema"), Itr->Value.outputSchema);
+			// The slowest sample may be well below the bucket's bound
+			return FMath::Min(BucketUpperBoundsMs[Bucket], MaxMs);
 		}
-		ResultTools.Add(MakeShared<FJsonValueObject>(MoveTemp(ToolDef)));
 	}
-	OutSuccess->SetArrayField(TEXT("tools"), MoveTemp(ResultTools));
-	// `nextCursor` is blank, since we return them all
-	return true;
+	return MaxMs;
 }
 
-bool FUMCP_Server::Rpc_ToolsCall(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+TSharedPtr<FJsonObject> FUMCP_LatencyHistogram::ToJsonObject() const
 {
-	FUMCP_CallToolParams Params;
-	UMCP_CreateFromJsonObject(Request.params, Params);
-	auto* Tool = Tools.Find(Params.name);
-	if (!Tool)
+	TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+	Json->SetNumberField(TEXT("count"), Count);
+	Json->SetNumberField(TEXT("averageMs"), GetAverageMs());
+	Json->SetNumberField(TEXT("p50Ms"), GetPercentileMs(50.0));
+	Json->SetNumberField(TEXT("p95Ms"), GetPercentileMs(95.0));
+	Json->SetNumberField(TEXT("p99Ms"), GetPercentileMs(99.0));
+	Json->SetNumberField(TEXT("maxMs"), MaxMs);
+	TArray<TSharedPtr<FJsonValue>> Buckets;
+	for (uint64 BucketCount : BucketCounts)
 	{
-		OutError.SetError(EUMCP_JsonRpcErrorCode::InvalidParams);
-		OutError.message = TEXT("Unknown tool name");
-		return false;
+		Buckets.Add(MakeShared<FJsonValueNumber>(static_cast<double>(BucketCount)));
 	}
+	Json->SetArrayField(TEXT("buckets"), Buckets);
+	return Json;
+}
+
+FUMCP_CompressionStats FUMCP_Server::GetCompressionStats() const
+{
+	FScopeLock Lock(&CompressionStatsLock);
+	return CompressionStats;
+}
 
-	if (!Tool->DoToolCall.IsBound())
+void FUMCP_Server::CompleteRequestSetEntry(const FUMCP_JsonRpcRequestSetPtr& RequestSet)
+{
+	if (RequestSet->PendingEntries.Decrement() == 0)
 	{
-		OutError.SetError(EUMCP_JsonRpcErrorCode::InternalError);
-		OutError.message = TEXT("Tool has no bound delegate");
-		return false;
+		SendRequestSetResponse(*RequestSet);
 	}
+}
 
-	FUMCP_CallToolResult Result;
-	Result.isError = !Tool->DoToolCall.Execute(Params.arguments, Result.content);
-	
-	// Flush the log file after tool execution to ensure all log entries are written before returning the response
-	if (GLog)
+// Main handler for MCP requests, runs on the thread that pumps the HTTP listeners
+void FUMCP_Server::HandleStreamableHTTPMCPRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	UMCP_TRACE_SCOPE(UMCP_DispatchRequest);
+
+	// The body is parsed straight from its UTF-8 bytes; it is only widened to an FString for logging
+    UE_LOG(LogUnrealMCPServer, Verbose, TEXT("Received MCP request: %s"), *UMCP_Utf8ToString(Request.Body));
+
+	TSharedPtr<FJsonValue> RootValue;
+	if (!UMCP_DeserializeJsonUtf8(Request.Body, RootValue))
 	{
-		GLog->Flush();
+        UE_LOG(LogUnrealMCPServer, Error, TEXT("Failed to parse MCP request JSON: %s"), *UMCP_Utf8ToString(Request.Body));
+		FUMCP_JsonRpcResponse Response;
+		Response.error = MakeShared<FUMCP_JsonRpcError>(EUMCP_JsonRpcErrorCode::ParseError, TEXT("Failed to parse MCP request JSON"));
+        SendJsonRpcResponse(OnComplete, Response);
+        return;
 	}
-	
-	if (!UMCP_ToJsonObject(Result, OutSuccess))
+
+	FUMCP_JsonRpcRequestSetPtr RequestSet = MakeShared<FUMCP_JsonRpcRequestSet, ESPMode::ThreadSafe>();
+	RequestSet->OnComplete = OnComplete;
+
+	RequestSet->ContentEncoding = ChooseContentEncoding(Request);
+
+	// Sessions only matter for resource subscriptions, so requests without one (or with an expired one) are still served
+	const FString SessionId = GetSessionIdHeader(Request);
+	if (!SessionId.IsEmpty())
 	{
-		OutError.SetError(EUMCP_JsonRpcErrorCode::InternalError);
-		OutError.message = TEXT("Failed to serialize result");
-		return false;
+		ResourceSubscriptions.TouchSession(SessionId);
 	}
-	
-	// If tool has an outputSchema and the result is not an error, extract structured content
-	if (Tool->outputSchema.IsValid() && !Result.isError && Result.content.Num() > 0)
+
+	// Streamable HTTP: clients listing text/event-stream in Accept may get progress notifications ahead of the result.
+	// Header names are looked up case-insensitively by the FString keyed map.
+	if (const TArray<FString>* AcceptHeaders = Request.Headers.Find(TEXT("Accept")))
 	{
-		// Try to parse the first text content as JSON to extract structured content
-		const FUMCP_CallToolResultContent& FirstContent = Result.content[0];
-		if (FirstContent.type == TEXT("text") && !FirstContent.text.IsEmpty())
+		for (const FString& AcceptHeader : *AcceptHeaders)
 		{
-			TSharedPtr<FJsonObject> StructuredContent;
-			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FirstContent.text);
-			if (FJsonSerializer::Deserialize(Reader, StructuredContent) && StructuredContent.IsValid())
-			{
-				// Validate that the structured content has the required properties from the outputSchema
-				const TSharedPtr<FJsonObject>& Schema = Tool->outputSchema;
-				if (Schema.IsValid())
-				{
-					// Check if schema has a "required" array
-					const TArray<TSharedPtr<FJsonValue>>* RequiredArray = nullptr;
-					if (Schema->TryGetArrayField(TEXT("required"), RequiredArray) && RequiredArray)
-					{
-						bool bAllRequiredPresent = true;
-						for (const TSharedPtr<FJsonValue>& RequiredValue : *RequiredArray)
-						{
-							FString RequiredField;
-							if (RequiredValue->TryGetString(RequiredField))
-							{
-								if (!StructuredContent->HasField(RequiredField))
-								{
-									UE_LOG(LogUnrealMCPServer, Warning, TEXT("Tool '%s' structuredContent missing required field '%s'"), *Params.name, *RequiredField);
-									bAllRequiredPresent = false;
-								}
-							}
-						}
-						
-						if (!bAllRequiredPresent)
-						{
-							// Log the actual structure for debugging
-							FString StructuredContentStr;
-							TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&StructuredContentStr);
-							FJsonSerializer::Serialize(StructuredContent.ToSharedRef(), Writer);
-							UE_LOG(LogUnrealMCPServer, Warning, TEXT("Tool '%s' structuredContent structure: %s"), *Params.name, *StructuredContentStr);
-						}
-					}
-				}
-				
-				// Log the structured content for debugging (truncated if too long)
-				FString StructuredContentStr;
-				TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&StructuredContentStr);
-				FJsonSerializer::Serialize(StructuredContent.ToSharedRef(), Writer);
-				if (StructuredContentStr.Len() > 500)
-				{
-					UE_LOG(LogUnrealMCPServer, Verbose, TEXT("Tool '%s' structuredContent (truncated): %s"), *Params.name, *StructuredContentStr.Left(500));
-				}
-				else
-				{
-					UE_LOG(LogUnrealMCPServer, Verbose, TEXT("Tool '%s' structuredContent: %s"), *Params.name, *StructuredContentStr);
-				}
-				
-				// Add structuredContent field to the result
-				OutSuccess->SetObjectField(TEXT("structuredContent"), StructuredContent);
-			}
-			else
+			if (AcceptHeader.Contains(TEXT("text/event-stream")))
 			{
-				UE_LOG(LogUnrealMCPServer, Warning, TEXT("Failed to parse structured content from tool '%s' result text. Text length: %d"), *Params.name, FirstContent.text.Len());
-				if (FirstContent.text.Len() < 500)
-				{
-					UE_LOG(LogUnrealMCPServer, Warning, TEXT("Failed to parse text content: %s"), *FirstContent.text);
-				}
+				RequestSet->EventStream = MakeShared<FUMCP_EventStream, ESPMode::ThreadSafe>();
+				break;
 			}
 		}
 	}
-	
-	return true;
-}
 
-bool FUMCP_Server::Rpc_ResourcesList(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
-{
-	FUMCP_ListResourcesParams Params;
-	if (!UMCP_CreateFromJsonObject(Request.params, Params, true))
+	TArray<TSharedPtr<FJsonValue>> Elements;
+	if (RootValue->Type == EJson::Array)
 	{
-		OutError.SetError(EUMCP_JsonRpcErrorCode::InvalidParams);
+		RequestSet->bIsBatch = true;
+		Elements = RootValue->AsArray();
+		if (Elements.Num() == 0)
+		{
+			FUMCP_JsonRpcResponse Response;
+			Response.error = MakeShared<FUMCP_JsonRpcError>(EUMCP_JsonRpcErrorCode::InvalidRequest, TEXT("Invalid Request - empty batch"));
+			SendJsonRpcResponse(OnComplete, Response);
+			return;
+		}
+	}
+	else
+	{
+		Elements.Add(RootValue);
+	}
+
+	const int32 NumEntries = Elements.Num();
+	RequestSet->Requests.SetNum(NumEntries);
+	RequestSet->Responses.SetNum(NumEntries);
+	// One extra reference is held by this function so nothing is sent before every entry has been dispatched
+	RequestSet->PendingEntries.Set(NumEntries + 1);
+
+	FUMCP_QueuedRequest GameThreadWork;
+	GameThreadWork.RequestSet = RequestSet;
+	EUMCP_RequestPriority GameThreadPriority = EUMCP_RequestPriority::High;
+
+	for (int32 Index = 0; Index < NumEntries; ++Index)
+	{
+		FUMCP_JsonRpcRequest& RpcRequest = RequestSet->Requests[Index];
+		FUMCP_JsonRpcResponse& Response = RequestSet->Responses[Index];
+
+		const TSharedPtr<FJsonObject>* RequestObject = nullptr;
+		if (!Elements[Index]->TryGetObject(RequestObject) || !FUMCP_JsonRpcRequest::CreateFromJsonObject(*RequestObject, RpcRequest))
+		{
+			UE_LOG(LogUnrealMCPServer, Error, TEXT("Invalid MCP request at index %d"), Index);
+			// An invalid entry must still be answered, even inside a batch
+			RpcRequest.bIsNotification = false;
+			Response.error = MakeShared<FUMCP_JsonRpcError>(EUMCP_JsonRpcErrorCode::InvalidRequest, TEXT("Invalid Request - missing 'jsonrpc' or 'method'"));
+			CompleteRequestSetEntry(RequestSet);
+			continue;
+		}
+		Response.id = RpcRequest.id;
+		RpcRequest.EventStream = RequestSet->EventStream;
+		RpcRequest.SessionId = SessionId;
+		if (RpcRequest.method == TEXT("initialize"))
+		{
+			if (RequestSet->NewSessionId.IsEmpty())
+			{
+				RequestSet->NewSessionId = ResourceSubscriptions.CreateSession();
+			}
+			RpcRequest.SessionId = RequestSet->NewSessionId;
+		}
+
+		if (RpcRequest.jsonrpc != TEXT("2.0"))
+		{
+			UE_LOG(LogUnrealMCPServer, Error, TEXT("Invalid JSON-RPC version: %s"), *RpcRequest.jsonrpc);
+			Response.error = MakeShared<FUMCP_JsonRpcError>(EUMCP_JsonRpcErrorCode::InvalidRequest, TEXT("Invalid Request - JSON-RPC version must be 2.0"));
+			CompleteRequestSetEntry(RequestSet);
+			continue;
+		}
+
+		const FUMCP_JsonRpcMethodHandler* MethodHandler = JsonRpcMethodHandlers.Find(RpcRequest.method);
+		if (!MethodHandler)
+		{
+			UE_LOG(LogUnrealMCPServer, Warning, TEXT("Unknown MCP method received: %s"), *RpcRequest.method);
+			Response.error = MakeShared<FUMCP_JsonRpcError>(EUMCP_JsonRpcErrorCode::MethodNotFound, TEXT("Method not found"));
+			CompleteRequestSetEntry(RequestSet);
+			continue;
+		}
+
+		const EUMCP_ExecutionAffinity ExecutionAffinity = ResolveExecutionAffinity(RpcRequest, *MethodHandler);
+		switch (ExecutionAffinity)
+		{
+		case EUMCP_ExecutionAffinity::AnyThread:
+		case EUMCP_ExecutionAffinity::TaskGraph:
+			// The HTTP listeners are ticked on the game thread, so even cheap handlers run on a task to stay out of the
+			// frame; AnyThread ones on a high priority thread so they aren't stuck behind registry queries. Each entry
+			// gets its own task, so independent entries of a batch run in parallel.
+			PendingTaskGraphRequests.Increment();
+			AsyncTask(ExecutionAffinity == EUMCP_ExecutionAffinity::AnyThread ? ENamedThreads::AnyHiPriThreadNormalTask : ENamedThreads::AnyBackgroundThreadNormalTask, [this, RequestSet, Index, Handler = *MethodHandler]() {
+				ExecuteJsonRpcRequest(RequestSet->Requests[Index], Handler, RequestSet->Responses[Index]);
+				CompleteRequestSetEntry(RequestSet);
+				PendingTaskGraphRequests.Decrement();
+			});
+			break;
+		case EUMCP_ExecutionAffinity::GameThread:
+		default:
+			{
+				// The whole group runs in one slot, so it is queued as heavy as its heaviest member
+				const EUMCP_RequestPriority Priority = ResolveRequestPriority(RpcRequest, *MethodHandler);
+				GameThreadPriority = FMath::Max(GameThreadPriority, Priority);
+				GameThreadWork.Entries.Emplace(Index, *MethodHandler);
+			}
+			break;
+		}
+	}
+
+	if (GameThreadWork.Entries.Num() > 0)
+	{
+		const int32 NumGameThreadEntries = GameThreadWork.Entries.Num();
+		TArray<int32> GameThreadIndices;
+		for (const TPair<int32, FUMCP_JsonRpcMethodHandler>& Entry : GameThreadWork.Entries)
+		{
+			GameThreadIndices.Add(Entry.Key);
+		}
+
+		if (!EnqueueGameThreadRequest(MoveTemp(GameThreadWork), GameThreadPriority))
+		{
+			UE_LOG(LogUnrealMCPServer, Warning, TEXT("Game thread queue is full (%d requests), rejecting %d request(s)"), Settings.MaxQueuedGameThreadRequests, NumGameThreadEntries);
+			for (int32 Index : GameThreadIndices)
+			{
+				RequestSet->Responses[Index].error = MakeShared<FUMCP_JsonRpcError>(EUMCP_JsonRpcErrorCode::ServerBusy, TEXT("Server busy - too many queued requests, retry later"));
+				CompleteRequestSetEntry(RequestSet);
+			}
+			if (!RequestSet->bIsBatch)
+			{
+				RequestSet->ResponseCode = EHttpServerResponseCodes::ServiceUnavail;
+			}
+		}
+	}
+
+	// Release the dispatch reference; sends the response now if everything already completed inline
+	CompleteRequestSetEntry(RequestSet);
+}
+
+// Streamable HTTP: UE's HTTP server sends a response only once it is complete, so the GET stream of server to client
+// messages is a long poll that is answered (and then reopened by the client) whenever there is something to send
+void FUMCP_Server::HandleSessionRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	const FString SessionId = GetSessionIdHeader(Request);
+	if (SessionId.IsEmpty())
+	{
+		SendJsonPayload(OnComplete, TArray<uint8>(), EHttpServerResponseCodes::BadRequest);
+		return;
+	}
+
+	if (Request.Verb == EHttpServerRequestVerbs::VERB_DELETE)
+	{
+		const bool bClosed = ResourceSubscriptions.CloseSession(SessionId);
+		SendJsonPayload(OnComplete, TArray<uint8>(), bClosed ? EHttpServerResponseCodes::Ok : EHttpServerResponseCodes::NotFound);
+		return;
+	}
+
+	const bool bPolling = ResourceSubscriptions.Poll(SessionId, [this, OnComplete](TArray<FString>&& UpdatedUris)
+	{
+		FUMCP_EventStream EventStream;
+		TArray<uint8> Message;
+		for (const FString& Uri : UpdatedUris)
+		{
+			Message.Reset();
+			UMCP_AppendUtf8(Message, "{\"jsonrpc\":\"2.0\",\"method\":\"notifications/resources/updated\",\"params\":{\"uri\":");
+			UMCP_AppendJsonString(Message, Uri);
+			UMCP_AppendUtf8(Message, "}}");
+			EventStream.AppendMessage(Message);
+		}
+		SendJsonPayload(OnComplete, EventStream.TakeBody(), EHttpServerResponseCodes::Ok, TEXT("text/event-stream"));
+	});
+	if (!bPolling)
+	{
+		// Expired or never created; the client has to initialize again
+		SendJsonPayload(OnComplete, TArray<uint8>(), EHttpServerResponseCodes::NotFound);
+	}
+}
+
+const FUMCP_ToolDefinition* FUMCP_Server::FindCalledTool(const FUMCP_JsonRpcRequest& RpcRequest) const
+{
+	if (RpcRequest.method != TEXT("tools/call") || !RpcRequest.params.IsValid())
+	{
+		return nullptr;
+	}
+	FString ToolName;
+	if (!RpcRequest.params->TryGetStringField(TEXT("name"), ToolName))
+	{
+		return nullptr;
+	}
+	return Tools.Find(ToolName);
+}
+
+EUMCP_ExecutionAffinity FUMCP_Server::ResolveExecutionAffinity(const FUMCP_JsonRpcRequest& RpcRequest, const FUMCP_JsonRpcMethodHandler& MethodHandler) const
+{
+	// tools/call inherits the affinity of the tool it targets. Unknown tools fall back to the
+	// handler's own affinity and get reported by Rpc_ToolsCall as before.
+	if (const FUMCP_ToolDefinition* Tool = FindCalledTool(RpcRequest))
+	{
+		return Tool->ExecutionAffinity;
+	}
+	return MethodHandler.ExecutionAffinity;
+}
+
+EUMCP_RequestPriority FUMCP_Server::ResolveRequestPriority(const FUMCP_JsonRpcRequest& RpcRequest, const FUMCP_JsonRpcMethodHandler& MethodHandler) const
+{
+	if (const FUMCP_ToolDefinition* Tool = FindCalledTool(RpcRequest))
+	{
+		return Tool->Priority;
+	}
+	return MethodHandler.Priority;
+}
+
+bool FUMCP_Server::EnqueueGameThreadRequest(FUMCP_QueuedRequest&& QueuedRequest, EUMCP_RequestPriority Priority)
+{
+	// Reserve a slot first so concurrent producers can't overshoot the limit
+	const int32 NewDepth = GameThreadQueueDepth.Increment();
+	if (NewDepth > Settings.MaxQueuedGameThreadRequests)
+	{
+		GameThreadQueueDepth.Decrement();
+		FScopeLock Lock(&QueueStatsLock);
+		QueueStats.RejectedRequests++;
+		return false;
+	}
+
+	{
+		FScopeLock Lock(&QueueStatsLock);
+		QueueStats.PeakQueueDepth = FMath::Max(QueueStats.PeakQueueDepth, NewDepth);
+	}
+
+	QueuedRequest.EnqueueTime = FPlatformTime::Seconds();
+	GameThreadQueues[static_cast<int32>(Priority)].Enqueue(MoveTemp(QueuedRequest));
+	return true;
+}
+
+bool FUMCP_Server::DequeueGameThreadRequest(FUMCP_QueuedRequest& OutQueuedRequest)
+{
+	for (TQueue<FUMCP_QueuedRequest, EQueueMode::Mpsc>& Queue : GameThreadQueues)
+	{
+		if (Queue.Dequeue(OutQueuedRequest))
+		{
+			GameThreadQueueDepth.Decrement();
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FUMCP_Server::TickGameThreadQueue(float DeltaTime)
+{
+	const double BudgetSeconds = Settings.GameThreadBudgetMs / 1000.0;
+	const double TickStartTime = FPlatformTime::Seconds();
+
+	// Requests waiting on an open connection go first; running jobs get whatever budget is left
+	ON_SCOPE_EXIT
+	{
+		TickToolJobs(TickStartTime + BudgetSeconds);
+	};
+
+	if (GameThreadQueueDepth.GetValue() <= 0)
+	{
+		return true;
+	}
+
+	double Now = TickStartTime;
+
+	// At least one request runs per tick, so a request that alone exceeds the budget still makes progress
+	FUMCP_QueuedRequest QueuedRequest;
+	while (DequeueGameThreadRequest(QueuedRequest))
+	{
+		const double WaitMs = (Now - QueuedRequest.EnqueueTime) * 1000.0;
+		{
+			FScopeLock Lock(&QueueStatsLock);
+			QueueStats.ExecutedRequests++;
+			QueueStats.LastWaitMs = WaitMs;
+			QueueStats.MaxWaitMs = FMath::Max(QueueStats.MaxWaitMs, WaitMs);
+			QueueStats.AverageWaitMs += (WaitMs - QueueStats.AverageWaitMs) / static_cast<double>(QueueStats.ExecutedRequests);
+		}
+		UE_LOG(LogUnrealMCPServer, Verbose, TEXT("TickGameThreadQueue: Running %d request(s) after waiting %.2f ms"), QueuedRequest.Entries.Num(), WaitMs);
+
+		const FUMCP_JsonRpcRequestSetPtr RequestSet = MoveTemp(QueuedRequest.RequestSet);
+		for (const TPair<int32, FUMCP_JsonRpcMethodHandler>& Entry : QueuedRequest.Entries)
+		{
+			ExecuteJsonRpcRequest(RequestSet->Requests[Entry.Key], Entry.Value, RequestSet->Responses[Entry.Key], WaitMs);
+			CompleteRequestSetEntry(RequestSet);
+		}
+
+		Now = FPlatformTime::Seconds();
+		if (Now - TickStartTime >= BudgetSeconds)
+		{
+			break;
+		}
+	}
+
+	FScopeLock Lock(&QueueStatsLock);
+	QueueStats.LastTickWorkMs = (Now - TickStartTime) * 1000.0;
+	return true;
+}
+
+void FUMCP_Server::FlushGameThreadQueue()
+{
+	// Clients are waiting on these connections, so answer rather than silently dropping them
+	FUMCP_QueuedRequest QueuedRequest;
+	while (DequeueGameThreadRequest(QueuedRequest))
+	{
+		const FUMCP_JsonRpcRequestSetPtr RequestSet = MoveTemp(QueuedRequest.RequestSet);
+		if (!RequestSet->bIsBatch)
+		{
+			RequestSet->ResponseCode = EHttpServerResponseCodes::ServiceUnavail;
+		}
+		for (const TPair<int32, FUMCP_JsonRpcMethodHandler>& Entry : QueuedRequest.Entries)
+		{
+			RequestSet->Responses[Entry.Key].error = MakeShared<FUMCP_JsonRpcError>(EUMCP_JsonRpcErrorCode::ServerBusy, TEXT("Server shutting down"));
+			CompleteRequestSetEntry(RequestSet);
+		}
+	}
+}
+
+FUMCP_GameThreadQueueStats FUMCP_Server::GetGameThreadQueueStats() const
+{
+	FScopeLock Lock(&QueueStatsLock);
+	FUMCP_GameThreadQueueStats Stats = QueueStats;
+	Stats.QueueDepth = GameThreadQueueDepth.GetValue();
+	return Stats;
+}
+
+void FUMCP_Server::ExecuteJsonRpcRequest(const FUMCP_JsonRpcRequest& RpcRequest, const FUMCP_JsonRpcMethodHandler& MethodHandler, FUMCP_JsonRpcResponse& OutResponse, double QueueWaitMs)
+{
+	UMCP_TRACE_SCOPE_TEXT(*RpcRequest.method);
+	const double StartTime = FPlatformTime::Seconds();
+	ON_SCOPE_EXIT
+	{
+		RecordExecution(GetMetricsKey(RpcRequest), QueueWaitMs, (FPlatformTime::Seconds() - StartTime) * 1000.0, OutResponse.error.IsValid());
+	};
+
+	OutResponse.id = RpcRequest.id;
+
+	if (MethodHandler.RawHandler)
+	{
+		FUMCP_JsonRpcError Error;
+		if (!MethodHandler.RawHandler(RpcRequest, OutResponse.rawResult, Error))
+		{
+			UE_LOG(LogUnrealMCPServer, Warning, TEXT("Error handling '%s': (%d) %s"), *RpcRequest.method, Error.code, *Error.message);
+			OutResponse.rawResult.Reset();
+			OutResponse.error = MakeShared<FUMCP_JsonRpcError>(MoveTemp(Error));
+		}
+		return;
+	}
+
+	auto SuccessObject = MakeShared<FJsonObject>();
+	auto ErrorObject = MakeShared<FUMCP_JsonRpcError>();
+	if (!MethodHandler.Handler(RpcRequest, SuccessObject, *ErrorObject))
+	{
+		UE_LOG(LogUnrealMCPServer, Warning, TEXT("Error handling '%s': (%d) %s"), *RpcRequest.method, ErrorObject->code, *ErrorObject->message);
+		OutResponse.error = MoveTemp(ErrorObject);
+		return;
+	}
+	OutResponse.result = MakeShared<FJsonValueObject>(MoveTemp(SuccessObject));
+}
+
+FString FUMCP_Server::GetMetricsKey(const FUMCP_JsonRpcRequest& RpcRequest) const
+{
+	if (const FUMCP_ToolDefinition* Tool = FindCalledTool(RpcRequest))
+	{
+		return TEXT("tools/call:") + Tool->name;
+	}
+	return JsonRpcMethodHandlers.Contains(RpcRequest.method) ? RpcRequest.method : FString(TEXT("(unknown)"));
+}
+
+void FUMCP_Server::RecordExecution(const FString& MetricsKey, double QueueWaitMs, double ExecuteMs, bool bIsError)
+{
+	FScopeLock Lock(&MetricsLock);
+	FUMCP_MethodMetrics& Metrics = MethodMetrics.FindOrAdd(MetricsKey);
+	Metrics.Calls++;
+	Metrics.Errors += bIsError ? 1 : 0;
+	if (QueueWaitMs >= 0.0)
+	{
+		Metrics.QueueWait.Add(QueueWaitMs);
+	}
+	Metrics.Execute.Add(ExecuteMs);
+}
+
+void FUMCP_Server::RecordSerialization(const FString& MetricsKey, double SerializeMs, int32 NumBytes)
+{
+	FScopeLock Lock(&MetricsLock);
+	FUMCP_MethodMetrics& Metrics = MethodMetrics.FindOrAdd(MetricsKey);
+	Metrics.BytesOut += NumBytes;
+	Metrics.Serialize.Add(SerializeMs);
+}
+
+TMap<FString, FUMCP_MethodMetrics> FUMCP_Server::GetMethodMetrics() const
+{
+	FScopeLock Lock(&MetricsLock);
+	return MethodMetrics;
+}
+
+TSharedPtr<FJsonObject> FUMCP_Server::GetMetricsJson() const
+{
+	TSharedPtr<FJsonObject> Json = MakeShared<FJsonObject>();
+
+	TArray<TSharedPtr<FJsonValue>> BucketBounds;
+	for (double UpperBoundMs : FUMCP_LatencyHistogram::BucketUpperBoundsMs)
+	{
+		BucketBounds.Add(MakeShared<FJsonValueNumber>(UpperBoundMs));
+	}
+	Json->SetArrayField(TEXT("bucketUpperBoundsMs"), BucketBounds);
+
+	TMap<FString, FUMCP_MethodMetrics> Snapshot = GetMethodMetrics();
+	Snapshot.KeySort(TLess<FString>());
+	TSharedPtr<FJsonObject> Methods = MakeShared<FJsonObject>();
+	for (const TPair<FString, FUMCP_MethodMetrics>& Pair : Snapshot)
+	{
+		TSharedPtr<FJsonObject> MethodJson = MakeShared<FJsonObject>();
+		MethodJson->SetNumberField(TEXT("calls"), Pair.Value.Calls);
+		MethodJson->SetNumberField(TEXT("errors"), Pair.Value.Errors);
+		MethodJson->SetNumberField(TEXT("toolErrors"), Pair.Value.ToolErrors);
+		MethodJson->SetNumberField(TEXT("bytesOut"), Pair.Value.BytesOut);
+		MethodJson->SetObjectField(TEXT("queueWaitMs"), Pair.Value.QueueWait.ToJsonObject());
+		MethodJson->SetObjectField(TEXT("executeMs"), Pair.Value.Execute.ToJsonObject());
+		MethodJson->SetObjectField(TEXT("serializeMs"), Pair.Value.Serialize.ToJsonObject());
+		Methods->SetObjectField(Pair.Key, MethodJson);
+	}
+	Json->SetObjectField(TEXT("methods"), Methods);
+
+	const FUMCP_GameThreadQueueStats Queue = GetGameThreadQueueStats();
+	TSharedPtr<FJsonObject> QueueJson = MakeShared<FJsonObject>();
+	QueueJson->SetNumberField(TEXT("queueDepth"), Queue.QueueDepth);
+	QueueJson->SetNumberField(TEXT("peakQueueDepth"), Queue.PeakQueueDepth);
+	QueueJson->SetNumberField(TEXT("executedRequests"), Queue.ExecutedRequests);
+	QueueJson->SetNumberField(TEXT("rejectedRequests"), Queue.RejectedRequests);
+	QueueJson->SetNumberField(TEXT("averageWaitMs"), Queue.AverageWaitMs);
+	QueueJson->SetNumberField(TEXT("maxWaitMs"), Queue.MaxWaitMs);
+	QueueJson->SetNumberField(TEXT("lastTickWorkMs"), Queue.LastTickWorkMs);
+	Json->SetObjectField(TEXT("gameThreadQueue"), QueueJson);
+
+	const FUMCP_CompressionStats Compression = GetCompressionStats();
+	TSharedPtr<FJsonObject> CompressionJson = MakeShared<FJsonObject>();
+	CompressionJson->SetNumberField(TEXT("compressedResponses"), Compression.CompressedResponses);
+	CompressionJson->SetNumberField(TEXT("uncompressedBytes"), Compression.UncompressedBytes);
+	CompressionJson->SetNumberField(TEXT("compressedBytes"), Compression.CompressedBytes);
+	CompressionJson->SetNumberField(TEXT("totalCompressMs"), Compression.TotalCompressMs);
+	Json->SetObjectField(TEXT("compression"), CompressionJson);
+
+	const FUMCP_ExportCacheStats ExportCacheStats = ExportCache.GetStats();
+	TSharedPtr<FJsonObject> ExportCacheJson = MakeShared<FJsonObject>();
+	ExportCacheJson->SetNumberField(TEXT("hits"), ExportCacheStats.Hits);
+	ExportCacheJson->SetNumberField(TEXT("diskHits"), ExportCacheStats.DiskHits);
+	ExportCacheJson->SetNumberField(TEXT("misses"), ExportCacheStats.Misses);
+	ExportCacheJson->SetNumberField(TEXT("evictions"), ExportCacheStats.Evictions);
+	ExportCacheJson->SetNumberField(TEXT("invalidations"), ExportCacheStats.Invalidations);
+	ExportCacheJson->SetNumberField(TEXT("memoryBytes"), ExportCacheStats.MemoryBytes);
+	ExportCacheJson->SetNumberField(TEXT("entries"), ExportCacheStats.NumEntries);
+	Json->SetObjectField(TEXT("exportCache"), ExportCacheJson);
+
+	const FUMCP_AssetNameIndexStats AssetNameIndexStats = AssetNameIndex.GetStats();
+	TSharedPtr<FJsonObject> AssetNameIndexJson = MakeShared<FJsonObject>();
+	AssetNameIndexJson->SetBoolField(TEXT("ready"), AssetNameIndexStats.bReady);
+	AssetNameIndexJson->SetNumberField(TEXT("assets"), AssetNameIndexStats.NumAssets);
+	AssetNameIndexJson->SetNumberField(TEXT("trigrams"), AssetNameIndexStats.NumTrigrams);
+	AssetNameIndexJson->SetNumberField(TEXT("memoryBytes"), AssetNameIndexStats.MemoryBytes);
+	AssetNameIndexJson->SetNumberField(TEXT("buildSeconds"), AssetNameIndexStats.BuildSeconds);
+	Json->SetObjectField(TEXT("assetNameIndex"), AssetNameIndexJson);
+
+	const FUMCP_DependencyGraphStats DependencyGraphStats = DependencyGraph.GetStats();
+	TSharedPtr<FJsonObject> DependencyGraphJson = MakeShared<FJsonObject>();
+	DependencyGraphJson->SetNumberField(TEXT("generation"), DependencyGraphStats.Generation);
+	DependencyGraphJson->SetNumberField(TEXT("packages"), DependencyGraphStats.NumPackages);
+	DependencyGraphJson->SetNumberField(TEXT("edges"), DependencyGraphStats.NumEdges);
+	DependencyGraphJson->SetNumberField(TEXT("memoryBytes"), DependencyGraphStats.MemoryBytes);
+	DependencyGraphJson->SetNumberField(TEXT("buildSeconds"), DependencyGraphStats.BuildSeconds);
+	Json->SetObjectField(TEXT("dependencyGraph"), DependencyGraphJson);
+
+	const FUMCP_BlueprintContentIndexStats BlueprintContentIndexStats = BlueprintContentIndex.GetStats();
+	TSharedPtr<FJsonObject> BlueprintContentIndexJson = MakeShared<FJsonObject>();
+	BlueprintContentIndexJson->SetBoolField(TEXT("loaded"), BlueprintContentIndexStats.bLoaded);
+	BlueprintContentIndexJson->SetNumberField(TEXT("blueprints"), BlueprintContentIndexStats.NumBlueprints);
+	BlueprintContentIndexJson->SetNumberField(TEXT("items"), BlueprintContentIndexStats.NumItems);
+	BlueprintContentIndexJson->SetNumberField(TEXT("names"), BlueprintContentIndexStats.NumNames);
+	BlueprintContentIndexJson->SetNumberField(TEXT("memoryBytes"), BlueprintContentIndexStats.MemoryBytes);
+	Json->SetObjectField(TEXT("blueprintContentIndex"), BlueprintContentIndexJson);
+
+	const FUMCP_PackageLoaderStats PackageLoaderStats = PackageLoader.GetStats();
+	TSharedPtr<FJsonObject> PackageLoaderJson = MakeShared<FJsonObject>();
+	PackageLoaderJson->SetNumberField(TEXT("loading"), PackageLoaderStats.NumLoading);
+	PackageLoaderJson->SetNumberField(TEXT("held"), PackageLoaderStats.NumHeld);
+	PackageLoaderJson->SetNumberField(TEXT("loaded"), PackageLoaderStats.NumLoaded);
+	PackageLoaderJson->SetNumberField(TEXT("released"), PackageLoaderStats.NumReleased);
+	PackageLoaderJson->SetNumberField(TEXT("collections"), PackageLoaderStats.NumCollections);
+	PackageLoaderJson->SetNumberField(TEXT("memoryWatermarkBytes"), PackageLoaderStats.MemoryWatermarkBytes);
+	Json->SetObjectField(TEXT("packageLoader"), PackageLoaderJson);
+
+	const FUMCP_LogBufferStats LogBufferStats = LogBuffer.GetStats();
+	TSharedPtr<FJsonObject> LogBufferJson = MakeShared<FJsonObject>();
+	LogBufferJson->SetNumberField(TEXT("capacity"), LogBufferStats.Capacity);
+	LogBufferJson->SetNumberField(TEXT("nextSequence"), static_cast<double>(LogBufferStats.NextSequence));
+	LogBufferJson->SetNumberField(TEXT("dropped"), static_cast<double>(LogBufferStats.NumDropped));
+	LogBufferJson->SetNumberField(TEXT("memoryBytes"), LogBufferStats.MemoryBytes);
+	Json->SetObjectField(TEXT("logBuffer"), LogBufferJson);
+
+	const FUMCP_ResourceSubscriptionsStats SubscriptionsStats = ResourceSubscriptions.GetStats();
+	TSharedPtr<FJsonObject> SubscriptionsJson = MakeShared<FJsonObject>();
+	SubscriptionsJson->SetNumberField(TEXT("sessions"), SubscriptionsStats.NumSessions);
+	SubscriptionsJson->SetNumberField(TEXT("subscriptions"), SubscriptionsStats.NumSubscriptions);
+	SubscriptionsJson->SetNumberField(TEXT("parkedPolls"), SubscriptionsStats.NumParkedPolls);
+	SubscriptionsJson->SetNumberField(TEXT("packageChanges"), static_cast<double>(SubscriptionsStats.NumPackageChanges));
+	SubscriptionsJson->SetNumberField(TEXT("notificationsSent"), static_cast<double>(SubscriptionsStats.NumNotificationsSent));
+	SubscriptionsJson->SetNumberField(TEXT("expiredSessions"), static_cast<double>(SubscriptionsStats.NumExpiredSessions));
+	Json->SetObjectField(TEXT("resourceSubscriptions"), SubscriptionsJson);
+
+	return Json;
+}
+
+void FUMCP_Server::RegisterMetricsResource()
+{
+	FUMCP_ResourceDefinition Resource;
+	Resource.name = TEXT("Server Metrics");
+	Resource.description = TEXT("Per-method and per-tool call counts and latency histograms (queue wait, execution, serialization) plus bytes out, game thread queue, compression, export cache and asset name index totals.");
+	Resource.mimeType = TEXT("application/json");
+	Resource.uri = TEXT("unreal+metrics://server");
+	Resource.ReadResource.BindLambda([this](const FString& Uri, TArray<FUMCP_ReadResourceResultContent>& OutContent)
+	{
+		FUMCP_ReadResourceResultContent& Content = OutContent.AddDefaulted_GetRef();
+		Content.uri = Uri;
+		Content.mimeType = TEXT("application/json");
+		return FJsonSerializer::Serialize(GetMetricsJson().ToSharedRef(), TJsonWriterFactory<>::Create(&Content.text));
+	});
+	RegisterResource(MoveTemp(Resource));
+}
+
+void FUMCP_Server::RegisterInternalRpcMethodHandlers()
+{
+	// General 
+	RegisterRpcMethodHandler(TEXT("initialize"), [this](const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+	{
+		return Rpc_Initialize(Request, OutSuccess, OutError);
+	}, EUMCP_ExecutionAffinity::AnyThread, EUMCP_RequestPriority::High);
+	RegisterRpcMethodHandler(TEXT("ping"), [this](const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+	{
+		return Rpc_Ping(Request, OutSuccess, OutError);
+	}, EUMCP_ExecutionAffinity::AnyThread, EUMCP_RequestPriority::High);
+	RegisterRpcMethodHandler(TEXT("notifications/initialized"), [this](const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+	{
+		return Rpc_ClientNotifyInitialized(Request, OutSuccess, OutError);
+	}, EUMCP_ExecutionAffinity::AnyThread, EUMCP_RequestPriority::High);
+	RegisterRpcMethodHandler(TEXT("notifications/cancelled"), [this](const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+	{
+		return Rpc_ClientNotifyCancelled(Request, OutSuccess, OutError);
+	}, EUMCP_ExecutionAffinity::AnyThread, EUMCP_RequestPriority::High);
+
+	// Tools (tools/call is dispatched with the affinity of the tool being called, see ResolveExecutionAffinity)
+	RegisterRawRpcMethodHandler(TEXT("tools/list"), [this](const FUMCP_JsonRpcRequest& Request, TArray<uint8>& OutRawResult, FUMCP_JsonRpcError& OutError)
+	{
+		return Rpc_ToolsList(Request, OutRawResult, OutError);
+	}, EUMCP_ExecutionAffinity::AnyThread, EUMCP_RequestPriority::High);
+	RegisterRawRpcMethodHandler(TEXT("tools/call"), [this](const FUMCP_JsonRpcRequest& Request, TArray<uint8>& OutRawResult, FUMCP_JsonRpcError& OutError)
+	{
+		return Rpc_ToolsCall(Request, OutRawResult, OutError);
+	}, EUMCP_ExecutionAffinity::AnyThread);
+
+	// Resources
+	RegisterRpcMethodHandler(TEXT("resources/list"), [this](const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+	{
+		return Rpc_ResourcesList(Request, OutSuccess, OutError);
+	}, EUMCP_ExecutionAffinity::AnyThread, EUMCP_RequestPriority::High);
+	RegisterRawRpcMethodHandler(TEXT("resources/templates/list"), [this](const FUMCP_JsonRpcRequest& Request, TArray<uint8>& OutRawResult, FUMCP_JsonRpcError& OutError)
+	{
+		return Rpc_ResourcesTemplatesList(Request, OutRawResult, OutError);
+	}, EUMCP_ExecutionAffinity::AnyThread, EUMCP_RequestPriority::High);
+	RegisterRawRpcMethodHandler(TEXT("resources/read"), [this](const FUMCP_JsonRpcRequest& Request, TArray<uint8>& OutRawResult, FUMCP_JsonRpcError& OutError)
+	{
+		return Rpc_ResourcesRead(Request, OutRawResult, OutError);
+	});
+	RegisterRpcMethodHandler(TEXT("resources/subscribe"), [this](const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+	{
+		return Rpc_ResourcesSubscribe(Request, OutSuccess, OutError);
+	}, EUMCP_ExecutionAffinity::AnyThread, EUMCP_RequestPriority::High);
+	RegisterRpcMethodHandler(TEXT("resources/unsubscribe"), [this](const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+	{
+		return Rpc_ResourcesUnsubscribe(Request, OutSuccess, OutError);
+	}, EUMCP_ExecutionAffinity::AnyThread, EUMCP_RequestPriority::High);
+
+	// Prompts
+	RegisterRawRpcMethodHandler(TEXT("prompts/list"), [this](const FUMCP_JsonRpcRequest& Request, TArray<uint8>& OutRawResult, FUMCP_JsonRpcError& OutError)
+	{
+		return Rpc_PromptsList(Request, OutRawResult, OutError);
+	}, EUMCP_ExecutionAffinity::AnyThread, EUMCP_RequestPriority::High);
+	RegisterRpcMethodHandler(TEXT("prompts/get"), [this](const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+	{
+		return Rpc_PromptsGet(Request, OutSuccess, OutError);
+	}, EUMCP_ExecutionAffinity::GameThread, EUMCP_RequestPriority::High);
+}
+
+bool FUMCP_Server::Rpc_Initialize(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+{
+	FUMCP_InitializeParams Params;
+	if (!UMCP_CreateFromJsonObject(Request.params, Params))
+	{
+		OutError.SetError(EUMCP_JsonRpcErrorCode::InvalidParams);
+		OutError.message = TEXT("Failed to parse 'initialize' params");
+        return false;
+	}
+
+	// TODO proper capabilities negotiation
+	
+	FUMCP_InitializeResult Result;
+	Result.protocolVersion = MCP_PROTOCOL_VERSION; // Server's supported version
+	Result.serverInfo.name = TEXT("UnrealMCPServer");
+	Result.serverInfo.version = PLUGIN_VERSION + TEXT(" (") + FEngineVersion::Current().ToString(EVersionComponent::Patch) + TEXT(")");
+
+	// Populate ServerCapabilities (defaults are fine for now as defined in MCPTypes.h constructors)
+	// FServerCapabilities members are default-initialized. Example: Result.serverCapabilities.tools.inputSchema = true;
+
+	if (!UMCP_ToJsonObject(Result, OutSuccess))
+	{
+		OutError.SetError(EUMCP_JsonRpcErrorCode::InternalError);
+		OutError.message = TEXT("Failed to serialize initialize result");
+		return false;
+	}
+
+	return true;
+}
+
+bool FUMCP_Server::Rpc_Ping(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+{
+	UE_LOG(LogUnrealMCPServer, Verbose, TEXT("Handling ping method."));
+	return true;
+}
+
+bool FUMCP_Server::Rpc_ClientNotifyInitialized(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+{
+	UE_LOG(LogUnrealMCPServer, Verbose, TEXT("Handling ClientNotifyInitialized method."));
+	return true;
+}
+
+bool FUMCP_Server::Rpc_ClientNotifyCancelled(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+{
+	// A plain tools/call holds the thread that would receive this, so only calls started with runAsJob can be cancelled
+	const TSharedPtr<FJsonValue> RequestIdValue = Request.params.IsValid() ? Request.params->TryGetField(TEXT("requestId")) : nullptr;
+	if (!RequestIdValue.IsValid())
+	{
+		OutError.SetError(EUMCP_JsonRpcErrorCode::InvalidParams);
+		OutError.message = TEXT("Missing 'requestId'");
+		return false;
+	}
+	const FUMCP_JsonRpcId RequestId = FUMCP_JsonRpcId::CreateFromJsonValue(RequestIdValue);
+
+	FString Reason;
+	Request.params->TryGetStringField(TEXT("reason"), Reason);
+
+	FScopeLock Lock(&JobsLock);
+	for (const TPair<FString, FUMCP_ToolJobPtr>& Job : Jobs)
+	{
+		if (Job.Value->Status == EUMCP_JobStatus::Running && JsonRpcIdsMatch(Job.Value->RequestId, RequestId))
+		{
+			UE_LOG(LogUnrealMCPServer, Log, TEXT("Rpc_ClientNotifyCancelled: Cancelling job %s (%s): %s"), *Job.Key, *Job.Value->ToolName, *Reason);
+			Job.Value->Context.RequestCancel();
+		}
+	}
+	return true;
+}
+
+void FUMCP_Server::InvalidateListing(FUMCP_ListingCache& Cache)
+{
+	FScopeLock Lock(&ListingCacheLock);
+	Cache.Items.Reset();
+	Cache.FullPage.Reset();
+	Cache.Generation++;
+	Cache.bValid = false;
+}
+
+bool FUMCP_Server::ServeListing(FUMCP_ListingCache& Cache, const TCHAR* FieldName, TFunctionRef<void(TArray<TSharedPtr<FJsonObject>>&)> BuildItems, const FString& Cursor, TArray<uint8>& OutRawResult, FUMCP_JsonRpcError& OutError)
+{
+	FScopeLock Lock(&ListingCacheLock);
+	if (!Cache.bValid)
+	{
+		TArray<TSharedPtr<FJsonObject>> ItemObjects;
+		BuildItems(ItemObjects);
+
+		Cache.Items.Reset(ItemObjects.Num());
+		for (const TSharedPtr<FJsonObject>& ItemObject : ItemObjects)
+		{
+			UMCP_SerializeJsonUtf8(ItemObject.ToSharedRef(), Cache.Items.AddDefaulted_GetRef());
+		}
+		Cache.FullPage.Reset();
+		AppendListingPage(Cache, FieldName, 0, Cache.Items.Num(), Cache.FullPage);
+		Cache.bValid = true;
+		UE_LOG(LogUnrealMCPServer, Verbose, TEXT("ServeListing: Rebuilt '%s' listing (%d entries, generation %u)"), FieldName, Cache.Items.Num(), Cache.Generation);
+	}
+
+	// Cursors are opaque to clients: base64 of "<generation>:<offset>"
+	int32 Offset = 0;
+	if (!Cursor.IsEmpty())
+	{
+		FString DecodedCursor;
+		FString GenerationString, OffsetString;
+		if (!FBase64::Decode(Cursor, DecodedCursor) || !DecodedCursor.Split(TEXT(":"), &GenerationString, &OffsetString)
+			|| !GenerationString.IsNumeric() || !OffsetString.IsNumeric()
+			|| FCString::Strtoui64(*GenerationString, nullptr, 10) != Cache.Generation)
+		{
+			OutError.SetError(EUMCP_JsonRpcErrorCode::InvalidParams);
+			OutError.message = TEXT("Invalid or expired cursor");
+			return false;
+		}
+		Offset = FMath::Clamp(FCString::Atoi(*OffsetString), 0, Cache.Items.Num());
+	}
+
+	const int32 PageSize = Settings.ListPageSize > 0 ? Settings.ListPageSize : Cache.Items.Num();
+	const int32 End = FMath::Min(Offset + PageSize, Cache.Items.Num());
+	if (Offset == 0 && End == Cache.Items.Num())
+	{
+		OutRawResult = Cache.FullPage;
+		return true;
+	}
+
+	AppendListingPage(Cache, FieldName, Offset, End, OutRawResult);
+	return true;
+}
+
+void FUMCP_Server::AppendListingPage(const FUMCP_ListingCache& Cache, const TCHAR* FieldName, int32 Begin, int32 End, TArray<uint8>& InOutUtf8)
+{
+	UMCP_AppendUtf8(InOutUtf8, "{");
+	UMCP_AppendJsonString(InOutUtf8, FieldName);
+	UMCP_AppendUtf8(InOutUtf8, ":[");
+	for (int32 Index = Begin; Index < End; ++Index)
+	{
+		if (Index > Begin)
+		{
+			UMCP_AppendUtf8(InOutUtf8, ",");
+		}
+		InOutUtf8.Append(Cache.Items[Index]);
+	}
+	UMCP_AppendUtf8(InOutUtf8, "]");
+	if (End < Cache.Items.Num())
+	{
+		UMCP_AppendUtf8(InOutUtf8, ",\"nextCursor\":");
+		UMCP_AppendJsonString(InOutUtf8, FBase64::Encode(FString::Printf(TEXT("%u:%d"), Cache.Generation, End)));
+	}
+	UMCP_AppendUtf8(InOutUtf8, "}");
+}
+
+bool FUMCP_Server::Rpc_ToolsList(const FUMCP_JsonRpcRequest& Request, TArray<uint8>& OutRawResult, FUMCP_JsonRpcError& OutError)
+{
+	FUMCP_ListToolsParams Params;
+	if (!UMCP_CreateFromJsonObject(Request.params, Params, true))
+	{
+		OutError.SetError(EUMCP_JsonRpcErrorCode::InvalidParams);
+		OutError.message = TEXT("Failed to parse list tools params");
+        return false;
+	}
+
+	return ServeListing(ToolsListing, TEXT("tools"), [this](TArray<TSharedPtr<FJsonObject>>& OutItems)
+	{
+		// Unfortunately, unreal doesn't have a good json serialization override and the json tools have
+		// a schema that was too complicated to deal with the complexity in the middle.
+		// So for now we manually build each entry here.
+		const double StartTime = FPlatformTime::Seconds();
+		int32 NumResolved = 0;
+		for (auto Itr = Tools.CreateIterator(); Itr; ++Itr)
+		{
+			NumResolved += ResolveToolSchemas(Itr->Value) ? 1 : 0;
+			auto ToolDef = MakeShared<FJsonObject>();
+			ToolDef->SetStringField(TEXT("name"), Itr->Key);
+			ToolDef->SetStringField(TEXT("description"), Itr->Value.description);
+			ToolDef->SetObjectField(TEXT("inputSchema"), Itr->Value.inputSchema);
+			if (Itr->Value.outputSchema.IsValid())
+			{
+				ToolDef->SetObjectField(TEXT("outputSchema"), Itr->Value.outputSchema);
+			}
+			OutItems.Add(MoveTemp(ToolDef));
+		}
+		if (NumResolved > 0)
+		{
+			UE_LOG(LogUnrealMCPServer, Log, TEXT("Rpc_ToolsList: Generated schemas for %d tools in %.2f ms"), NumResolved, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+		}
+	}, Params.cursor, OutRawResult, OutError);
+}
+
+void FUMCP_Server::ValidateStructuredContent(const FUMCP_ToolDefinition& Tool, const FJsonObject* StructuredContent, TConstArrayView<uint8> StructuredContentUtf8) const
+{
+	// Check that the structured content has the required properties from the outputSchema.
+	// Content written from a USTRUCT has no DOM to check, but it always carries every property of the struct.
+	const TArray<TSharedPtr<FJsonValue>>* RequiredArray = nullptr;
+	if (StructuredContent && Tool.outputSchema->TryGetArrayField(TEXT("required"), RequiredArray) && RequiredArray)
+	{
+		bool bAllRequiredPresent = true;
+		for (const TSharedPtr<FJsonValue>& RequiredValue : *RequiredArray)
+		{
+			FString RequiredField;
+			if (RequiredValue->TryGetString(RequiredField) && !StructuredContent->HasField(RequiredField))
+			{
+				UE_LOG(LogUnrealMCPServer, Warning, TEXT("Tool '%s' structuredContent missing required field '%s'"), *Tool.name, *RequiredField);
+				bAllRequiredPresent = false;
+			}
+		}
+
+		if (!bAllRequiredPresent)
+		{
+			// Log the actual structure for debugging
+			UE_LOG(LogUnrealMCPServer, Warning, TEXT("Tool '%s' structuredContent structure: %s"), *Tool.name, *UMCP_Utf8ToString(StructuredContentUtf8));
+		}
+	}
+
+	UE_LOG(LogUnrealMCPServer, Verbose, TEXT("Tool '%s' structuredContent%s: %s"), *Tool.name, StructuredContentUtf8.Num() > 500 ? TEXT(" (truncated)") : TEXT(""),
+		*UMCP_Utf8ToString(StructuredContentUtf8.Slice(0, FMath::Min(StructuredContentUtf8.Num(), 500))));
+}
+
+bool FUMCP_Server::Rpc_ToolsCall(const FUMCP_JsonRpcRequest& Request, TArray<uint8>& OutRawResult, FUMCP_JsonRpcError& OutError)
+{
+	FUMCP_CallToolParams Params;
+	UMCP_CreateFromJsonObject(Request.params, Params);
+	auto* Tool = Tools.Find(Params.name);
+	if (!Tool)
+	{
+		OutError.SetError(EUMCP_JsonRpcErrorCode::InvalidParams);
+		OutError.message = TEXT("Unknown tool name");
+		return false;
+	}
+
+	if (!Tool->DoToolCall.IsBound() && !Tool->StartJob.IsBound())
+	{
+		OutError.SetError(EUMCP_JsonRpcErrorCode::InternalError);
+		OutError.message = TEXT("Tool has no bound delegate");
+		return false;
+	}
+
+	ensureMsgf(Tool->ExecutionAffinity != EUMCP_ExecutionAffinity::GameThread || IsInGameThread(), TEXT("Tool '%s' requires the game thread"), *Params.name);
+	// The output schema is checked against the result, so it has to exist even if the client never listed the tools
+	ResolveToolSchemas(*Tool);
+
+	FUMCP_CallToolResult Result;
+	bool bMatchesOutputSchema = true;
+	{
+		UMCP_TRACE_SCOPE_TEXT(*Tool->name);
+		// Lets the tool emit notifications/progress while it runs, if the client asked for them
+		FUMCP_ToolProgressScope ProgressScope(Request);
+		if (Tool->StartJob.IsBound())
+		{
+			bool bRunAsJob = false;
+			if (Params.arguments.IsValid())
+			{
+				Params.arguments->TryGetBoolField(TEXT("runAsJob"), bRunAsJob);
+			}
+
+			UMCP_ToolJobStep Step;
+			if (!Tool->StartJob.Execute(Params.arguments, Step, Result.content))
+			{
+				Result.isError = true;
+			}
+			else if (bRunAsJob)
+			{
+				// The result is the job handle, not the tool's own output
+				FUMCP_JobStatusResult JobStatus;
+				GetJobStatus(StartToolJob(*Tool, Request, MoveTemp(Step)), JobStatus);
+				FUMCP_CallToolResultContent& Content = Result.content.AddDefaulted_GetRef();
+				Content.type = TEXT("text");
+				UMCP_ToJsonString(JobStatus, Content.text);
+				bMatchesOutputSchema = false;
+			}
+			else
+			{
+				RunToolJobInline(Step, Result);
+			}
+		}
+		else
+		{
+			Result.isError = !Tool->DoToolCall.Execute(Params.arguments, Result.content);
+		}
+	}
+
+	if (Result.isError)
+	{
+		FScopeLock Lock(&MetricsLock);
+		MethodMetrics.FindOrAdd(TEXT("tools/call:") + Tool->name).ToolErrors++;
+	}
+
+	// Flushing blocks on file I/O, so it is opt-in for when the log file has to be complete before the client reads it
+	if (Settings.bFlushLogAfterToolCall && GLog)
+	{
+		UMCP_TRACE_SCOPE(UMCP_FlushLog);
+		GLog->Flush();
+	}
+
+	WriteToolCallResult(*Tool, Result, bMatchesOutputSchema, OutRawResult);
+	return true;
+}
+
+void FUMCP_Server::WriteToolCallResult(const FUMCP_ToolDefinition& Tool, const FUMCP_CallToolResult& Result, bool bMatchesOutputSchema, TArray<uint8>& OutRawResult) const
+{
+	// Structured content is serialized exactly once, straight to UTF-8; the same bytes become `content[].text` and `structuredContent`
+	TArray<TArray<uint8>> ContentUtf8;
+	ContentUtf8.SetNum(Result.content.Num());
+	for (int32 Index = 0; Index < Result.content.Num(); ++Index)
+	{
+		Result.content[Index].AppendTextUtf8(ContentUtf8[Index]);
+	}
+
+	// Only the first text entry is reported as structuredContent, and only for tools that declare an outputSchema
+	bool bHasStructuredContent = false;
+	if (bMatchesOutputSchema && Tool.outputSchema.IsValid() && !Result.isError && Result.content.Num() > 0
+		&& Result.content[0].type == TEXT("text") && ContentUtf8[0].Num() > 0)
+	{
+		const FUMCP_CallToolResultContent& FirstContent = Result.content[0];
+		if (FirstContent.HasStructuredContent())
+		{
+			ValidateStructuredContent(Tool, FirstContent.structuredContent.Get(), ContentUtf8[0]);
+			bHasStructuredContent = true;
+		}
+		else
+		{
+			// Tools that still serialize into `text` themselves: parse it back to validate it
+			TSharedPtr<FJsonValue> ParsedContent;
+			if (UMCP_DeserializeJsonUtf8(ContentUtf8[0], ParsedContent) && ParsedContent->Type == EJson::Object)
+			{
+				ValidateStructuredContent(Tool, ParsedContent->AsObject().Get(), ContentUtf8[0]);
+				bHasStructuredContent = true;
+			}
+			else
+			{
+				UE_LOG(LogUnrealMCPServer, Warning, TEXT("Failed to parse structured content from tool '%s' result text. Text length: %d"), *Tool.name, FirstContent.text.Len());
+				if (FirstContent.text.Len() < 500)
+				{
+					UE_LOG(LogUnrealMCPServer, Warning, TEXT("Failed to parse text content: %s"), *FirstContent.text);
+				}
+			}
+		}
+	}
+
+	// Written directly into the UTF-8 result so large text fields are escaped once and never copied through a DOM
+	UMCP_AppendUtf8(OutRawResult, "{\"content\":[");
+	for (int32 Index = 0; Index < Result.content.Num(); ++Index)
+	{
+		if (Index > 0)
+		{
+			UMCP_AppendUtf8(OutRawResult, ",");
+		}
+		Result.content[Index].AppendJsonUtf8(OutRawResult, ContentUtf8[Index]);
+	}
+	UMCP_AppendUtf8(OutRawResult, Result.isError ? "],\"isError\":true" : "],\"isError\":false");
+	if (bHasStructuredContent)
+	{
+		// The first text entry holds a serialized JSON object, so it is spliced in verbatim as `structuredContent`
+		UMCP_AppendUtf8(OutRawResult, ",\"structuredContent\":");
+		OutRawResult.Append(ContentUtf8[0]);
+	}
+	UMCP_AppendUtf8(OutRawResult, "}");
+}
+
+FString FUMCP_Server::StartToolJob(const FUMCP_ToolDefinition& Tool, const FUMCP_JsonRpcRequest& Request, UMCP_ToolJobStep&& Step)
+{
+	FScopeLock Lock(&JobsLock);
+	if (Tool.bSingleInstanceJob)
+	{
+		for (const TPair<FString, FUMCP_ToolJobPtr>& Job : Jobs)
+		{
+			if (Job.Value->Status == EUMCP_JobStatus::Running && Job.Value->ToolName == Tool.name)
+			{
+				UE_LOG(LogUnrealMCPServer, Log, TEXT("StartToolJob: '%s' is already running as job %s"), *Tool.name, *Job.Key);
+				return Job.Key;
+			}
+		}
+	}
+
+	FUMCP_ToolJobPtr Job = MakeShared<FUMCP_ToolJob, ESPMode::ThreadSafe>();
+	Job->JobId = FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphens);
+	Job->ToolName = Tool.name;
+	Job->RequestId = Request.id;
+	Job->Step = MoveTemp(Step);
+	Job->StartTime = FPlatformTime::Seconds();
+	Jobs.Add(Job->JobId, Job);
+	UE_LOG(LogUnrealMCPServer, Log, TEXT("StartToolJob: Started job %s (%s)"), *Job->JobId, *Tool.name);
+	return Job->JobId;
+}
+
+void FUMCP_Server::RunToolJobInline(const UMCP_ToolJobStep& Step, FUMCP_CallToolResult& OutResult)
+{
+	FUMCP_JobContext Context(true);
+	EUMCP_JobStepResult StepResult;
+	while ((StepResult = Step(Context, OutResult)) != EUMCP_JobStepResult::Finished)
+	{
+		if (StepResult == EUMCP_JobStepResult::Wait)
+		{
+			// Nothing else gets to run on this thread until the call returns, so there is no frame to wait for
+			FPlatformProcess::Sleep(0.1f);
+		}
+	}
+}
+
+void FUMCP_Server::TickToolJobs(double DeadlineTime)
+{
+	TArray<FUMCP_ToolJobPtr> RunningJobs;
+	{
+		FScopeLock Lock(&JobsLock);
+		const double Now = FPlatformTime::Seconds();
+		for (auto It = Jobs.CreateIterator(); It; ++It)
+		{
+			const FUMCP_ToolJob& Job = *It.Value();
+			if (Job.Status == EUMCP_JobStatus::Running)
+			{
+				RunningJobs.Add(It.Value());
+			}
+			else if (Now - Job.FinishTime > Settings.FinishedJobRetentionSeconds)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+	if (RunningJobs.IsEmpty())
+	{
+		return;
+	}
+
+	// Round robin, starting one job further each tick, so a job with many quick steps cannot starve the others.
+	// Like queued requests, at least one step runs per tick even when the budget is already spent.
+	const int32 FirstIndex = static_cast<int32>(JobRoundRobinOffset++ % static_cast<uint32>(RunningJobs.Num()));
+	TBitArray<> IdleJobs(false, RunningJobs.Num());
+	int32 NumIdleJobs = 0;
+	for (int32 Offset = 0; NumIdleJobs < RunningJobs.Num(); ++Offset)
+	{
+		const int32 Index = (FirstIndex + Offset) % RunningJobs.Num();
+		if (IdleJobs[Index])
+		{
+			continue;
+		}
+		if (!StepToolJob(*RunningJobs[Index]))
+		{
+			IdleJobs[Index] = true;
+			++NumIdleJobs;
+		}
+		if (FPlatformTime::Seconds() >= DeadlineTime)
+		{
+			break;
+		}
+	}
+}
+
+bool FUMCP_Server::StepToolJob(FUMCP_ToolJob& Job)
+{
+	UMCP_TRACE_SCOPE_TEXT(*Job.ToolName);
+	// The step gets one chance to wind down after a cancel request; after that the job is finished regardless
+	const bool bCancelRequested = Job.Context.IsCancelRequested();
+	FUMCP_CallToolResult Result;
+	EUMCP_JobStepResult StepResult = Job.Step(Job.Context, Result);
+	if (StepResult != EUMCP_JobStepResult::Finished && bCancelRequested)
+	{
+		Result = FUMCP_CallToolResult();
+		Result.isError = true;
+		FUMCP_CallToolResultContent& Content = Result.content.AddDefaulted_GetRef();
+		Content.type = TEXT("text");
+		Content.text = TEXT("Job cancelled");
+		StepResult = EUMCP_JobStepResult::Finished;
+	}
+	if (StepResult != EUMCP_JobStepResult::Finished)
+	{
+		return StepResult == EUMCP_JobStepResult::Continue;
+	}
+
+	TArray<uint8> ResultUtf8;
+	if (const FUMCP_ToolDefinition* Tool = Tools.Find(Job.ToolName))
+	{
+		WriteToolCallResult(*Tool, Result, true, ResultUtf8);
+	}
+	Job.Step.Reset();
+
+	const EUMCP_JobStatus Status = Job.Context.IsCancelRequested() ? EUMCP_JobStatus::Cancelled
+		: Result.isError ? EUMCP_JobStatus::Failed : EUMCP_JobStatus::Completed;
+	FScopeLock Lock(&JobsLock);
+	Job.ResultUtf8 = MoveTemp(ResultUtf8);
+	Job.Status = Status;
+	Job.FinishTime = FPlatformTime::Seconds();
+	UE_LOG(LogUnrealMCPServer, Log, TEXT("StepToolJob: Job %s (%s) finished as %s after %.2f s"), *Job.JobId, *Job.ToolName, JobStatusToString(Status), Job.FinishTime - Job.StartTime);
+	return false;
+}
+
+bool FUMCP_Server::GetJobStatus(const FString& JobId, FUMCP_JobStatusResult& OutStatus) const
+{
+	FUMCP_ToolJobPtr Job;
+	EUMCP_JobStatus Status = EUMCP_JobStatus::Running;
+	{
+		FScopeLock Lock(&JobsLock);
+		Job = Jobs.FindRef(JobId);
+		if (!Job.IsValid())
+		{
+			return false;
+		}
+		Status = Job->Status;
+		OutStatus.elapsedSeconds = (Status == EUMCP_JobStatus::Running ? FPlatformTime::Seconds() : Job->FinishTime) - Job->StartTime;
+	}
+	OutStatus.jobId = Job->JobId;
+	OutStatus.toolName = Job->ToolName;
+	OutStatus.status = JobStatusToString(Status);
+	Job->Context.GetProgress(OutStatus.progress, OutStatus.total, OutStatus.message);
+	if (Status != EUMCP_JobStatus::Running)
+	{
+		// A finished job never changes again, so its result can be read without the lock
+		TSharedPtr<FJsonValue> ResultValue;
+		if (UMCP_DeserializeJsonUtf8(Job->ResultUtf8, ResultValue) && ResultValue->Type == EJson::Object)
+		{
+			OutStatus.result = ResultValue->AsObject();
+		}
+	}
+	return true;
+}
+
+bool FUMCP_Server::CancelJob(const FString& JobId)
+{
+	FScopeLock Lock(&JobsLock);
+	const FUMCP_ToolJobPtr Job = Jobs.FindRef(JobId);
+	if (!Job.IsValid() || Job->Status != EUMCP_JobStatus::Running)
+	{
+		return false;
+	}
+	UE_LOG(LogUnrealMCPServer, Log, TEXT("CancelJob: Cancelling job %s (%s)"), *JobId, *Job->ToolName);
+	Job->Context.RequestCancel();
+	return true;
+}
+
+bool FUMCP_Server::Rpc_ResourcesList(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+{
+	FUMCP_ListResourcesParams Params;
+	if (!UMCP_CreateFromJsonObject(Request.params, Params, true))
+	{
+		OutError.SetError(EUMCP_JsonRpcErrorCode::InvalidParams);
 		OutError.message = TEXT("Failed to parse list resources params");
         return false;
 	}
@@ -473,7 +1757,7 @@ bool FUMCP_Server::Rpc_ResourcesList(const FUMCP_JsonRpcRequest& Request, TShare
 	return true;
 }
 
-bool FUMCP_Server::Rpc_ResourcesTemplatesList(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+bool FUMCP_Server::Rpc_ResourcesTemplatesList(const FUMCP_JsonRpcRequest& Request, TArray<uint8>& OutRawResult, FUMCP_JsonRpcError& OutError)
 {
 	FUMCP_ListResourceTemplatesParams Params;
 	if (!UMCP_CreateFromJsonObject(Request.params, Params, true))
@@ -483,21 +1767,24 @@ bool FUMCP_Server::Rpc_ResourcesTemplatesList(const FUMCP_JsonRpcRequest& Reques
         return false;
 	}
 
-	FUMCP_ListResourceTemplatesResult Result;
-	for (auto Itr = ResourceTemplates.CreateConstIterator(); Itr; Itr++)
-	{
-		Result.resourceTemplates.Emplace(Itr->Value);
-	}
-	if (!UMCP_ToJsonObject(Result, OutSuccess))
+	return ServeListing(ResourceTemplatesListing, TEXT("resourceTemplates"), [this](TArray<TSharedPtr<FJsonObject>>& OutItems)
 	{
-		OutError.SetError(EUMCP_JsonRpcErrorCode::InternalError);
-		OutError.message = TEXT("Failed to serialize result");
-		return false;
-	}
-	return true;
+		for (auto Itr = ResourceTemplates.CreateConstIterator(); Itr; Itr++)
+		{
+			TSharedPtr<FJsonObject> TemplateJson = MakeShared<FJsonObject>();
+			if (UMCP_ToJsonObject(Itr->Value, TemplateJson))
+			{
+				OutItems.Add(MoveTemp(TemplateJson));
+			}
+			else
+			{
+				UE_LOG(LogUnrealMCPServer, Error, TEXT("Rpc_ResourcesTemplatesList: Failed to serialize template '%s'"), *Itr->Value.uriTemplate);
+			}
+		}
+	}, Params.cursor, OutRawResult, OutError);
 }
 
-bool FUMCP_Server::Rpc_ResourcesRead(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+bool FUMCP_Server::Rpc_ResourcesRead(const FUMCP_JsonRpcRequest& Request, TArray<uint8>& OutRawResult, FUMCP_JsonRpcError& OutError)
 {
 	FUMCP_ReadResourceParams Params;
 	if (!UMCP_CreateFromJsonObject(Request.params, Params))
@@ -520,44 +1807,35 @@ bool FUMCP_Server::Rpc_ResourcesRead(const FUMCP_JsonRpcRequest& Request, TShare
 			return false;
 		}
 		
-		if (!UMCP_ToJsonObject(Result, OutSuccess))
-		{
-			OutError.SetError(EUMCP_JsonRpcErrorCode::InternalError);
-			OutError.message = TEXT("Failed to serialize result");
-			return false;
-		}
+		Result.AppendJsonUtf8(OutRawResult);
 		return true;
 	}
 
-	// Check resouce templates
-	for (auto Itr = ResourceTemplates.CreateConstIterator(); Itr; ++Itr)
+	// Check resource templates. Only those whose leading literal the URI starts with are tried.
+	bool bReadFailed = false;
+	const bool bMatched = ResourceTemplateRouter.VisitCandidates(Params.uri, [this, &Params, &Result, &bReadFailed](int32 TemplateIndex)
 	{
-		auto& ResourceTemplate = Itr->Value;
-		if (!ResourceTemplate.ReadResource.IsBound())
-		{
-			continue;
-		}
-		
-		auto& UriTemplate = Itr->Key;
-		FUMCP_UriTemplateMatch Match;
-		if (!UriTemplate.FindMatch(Params.uri, Match))
+		const TPair<FUMCP_UriTemplate, FUMCP_ResourceTemplateDefinition>& Entry = ResourceTemplates[TemplateIndex];
+		const FUMCP_UriTemplate& UriTemplate = Entry.Key;
+		const FUMCP_ResourceTemplateDefinition& ResourceTemplate = Entry.Value;
+		FUMCP_UriTemplateMatchView Match;
+		if (!ResourceTemplate.ReadResource.IsBound() || !UriTemplate.FindMatch(FStringView(Params.uri), Match))
 		{
-			continue;
-		}
-
-		if (!ResourceTemplate.ReadResource.Execute(UriTemplate, Match, Result.contents))
-		{
-			OutError.SetError(EUMCP_JsonRpcErrorCode::InternalError);
-			OutError.message = TEXT("Failed to load resource contents");
 			return false;
 		}
-		
-		if (!UMCP_ToJsonObject(Result, OutSuccess))
+		bReadFailed = !ResourceTemplate.ReadResource.Execute(UriTemplate, Match, Result.contents);
+		return true;
+	});
+	if (bMatched)
+	{
+		if (bReadFailed)
 		{
 			OutError.SetError(EUMCP_JsonRpcErrorCode::InternalError);
-			OutError.message = TEXT("Failed to serialize result");
+			OutError.message = TEXT("Failed to load resource contents");
 			return false;
 		}
+
+		Result.AppendJsonUtf8(OutRawResult);
 		return true;
 	}
 	
@@ -566,7 +1844,46 @@ bool FUMCP_Server::Rpc_ResourcesRead(const FUMCP_JsonRpcRequest& Request, TShare
 	return false;
 }
 
-bool FUMCP_Server::Rpc_PromptsList(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+bool FUMCP_Server::Rpc_ResourcesSubscribe(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+{
+	FUMCP_SubscribeResourceParams Params;
+	if (!UMCP_CreateFromJsonObject(Request.params, Params) || Params.uri.IsEmpty())
+	{
+		OutError.SetError(EUMCP_JsonRpcErrorCode::InvalidParams);
+		OutError.message = TEXT("Failed to parse subscribe resource params");
+		return false;
+	}
+
+	FString SubscribeError;
+	if (!ResourceSubscriptions.Subscribe(Request.SessionId, Params.uri, SubscribeError))
+	{
+		OutError.SetError(EUMCP_JsonRpcErrorCode::InvalidParams);
+		OutError.message = SubscribeError;
+		return false;
+	}
+	return true;
+}
+
+bool FUMCP_Server::Rpc_ResourcesUnsubscribe(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
+{
+	FUMCP_SubscribeResourceParams Params;
+	if (!UMCP_CreateFromJsonObject(Request.params, Params) || Params.uri.IsEmpty())
+	{
+		OutError.SetError(EUMCP_JsonRpcErrorCode::InvalidParams);
+		OutError.message = TEXT("Failed to parse unsubscribe resource params");
+		return false;
+	}
+
+	if (!ResourceSubscriptions.Unsubscribe(Request.SessionId, Params.uri))
+	{
+		OutError.SetError(EUMCP_JsonRpcErrorCode::InvalidParams);
+		OutError.message = TEXT("Unknown or expired session; resources/unsubscribe needs the Mcp-Session-Id header returned by initialize");
+		return false;
+	}
+	return true;
+}
+
+bool FUMCP_Server::Rpc_PromptsList(const FUMCP_JsonRpcRequest& Request, TArray<uint8>& OutRawResult, FUMCP_JsonRpcError& OutError)
 {
 	FUMCP_ListPromptsParams Params;
 	if (!UMCP_CreateFromJsonObject(Request.params, Params, true))
@@ -576,48 +1893,44 @@ bool FUMCP_Server::Rpc_PromptsList(const FUMCP_JsonRpcRequest& Request, TSharedP
 		return false;
 	}
 
-	// Build prompts array manually (similar to tools)
-	TArray<TSharedPtr<FJsonValue>> ResultPrompts;
-	for (auto Itr = Prompts.CreateConstIterator(); Itr; ++Itr)
+	return ServeListing(PromptsListing, TEXT("prompts"), [this](TArray<TSharedPtr<FJsonObject>>& OutItems)
 	{
-		const FUMCP_PromptDefinitionInternal& PromptDef = Itr->Value;
-		auto PromptJson = MakeShared<FJsonObject>();
-		PromptJson->SetStringField(TEXT("name"), PromptDef.name);
-		if (!PromptDef.title.IsEmpty())
-		{
-			PromptJson->SetStringField(TEXT("title"), PromptDef.title);
-		}
-		if (!PromptDef.description.IsEmpty())
+		// Build prompt entries manually (similar to tools)
+		for (auto Itr = Prompts.CreateConstIterator(); Itr; ++Itr)
 		{
-			PromptJson->SetStringField(TEXT("description"), PromptDef.description);
-		}
-		
-		// Add arguments array if present
-		if (PromptDef.arguments.Num() > 0)
-		{
-			TArray<TSharedPtr<FJsonValue>> ArgumentsArray;
-			for (const FUMCP_PromptArgument& Arg : PromptDef.arguments)
+			const FUMCP_PromptDefinitionInternal& PromptDef = Itr->Value;
+			auto PromptJson = MakeShared<FJsonObject>();
+			PromptJson->SetStringField(TEXT("name"), PromptDef.name);
+			if (!PromptDef.title.IsEmpty())
+			{
+				PromptJson->SetStringField(TEXT("title"), PromptDef.title);
+			}
+			if (!PromptDef.description.IsEmpty())
+			{
+				PromptJson->SetStringField(TEXT("description"), PromptDef.description);
+			}
+
+			// Add arguments array if present
+			if (PromptDef.arguments.Num() > 0)
 			{
-				auto ArgJson = MakeShared<FJsonObject>();
-				ArgJson->SetStringField(TEXT("name"), Arg.name);
-				if (!Arg.description.IsEmpty())
+				TArray<TSharedPtr<FJsonValue>> ArgumentsArray;
+				for (const FUMCP_PromptArgument& Arg : PromptDef.arguments)
 				{
-					ArgJson->SetStringField(TEXT("description"), Arg.description);
+					auto ArgJson = MakeShared<FJsonObject>();
+					ArgJson->SetStringField(TEXT("name"), Arg.name);
+					if (!Arg.description.IsEmpty())
+					{
+						ArgJson->SetStringField(TEXT("description"), Arg.description);
+					}
+					ArgJson->SetBoolField(TEXT("required"), Arg.required);
+					ArgumentsArray.Add(MakeShared<FJsonValueObject>(ArgJson));
 				}
-				ArgJson->SetBoolField(TEXT("required"), Arg.required);
-				ArgumentsArray.Add(MakeShared<FJsonValueObject>(ArgJson));
+				PromptJson->SetArrayField(TEXT("arguments"), ArgumentsArray);
 			}
-			PromptJson->SetArrayField(TEXT("arguments"), ArgumentsArray);
+
+			OutItems.Add(MoveTemp(PromptJson));
 		}
-		
-		ResultPrompts.Add(MakeShared<FJsonValueObject>(MoveTemp(PromptJson)));
-	}
-	
-	OutSuccess->SetArrayField(TEXT("prompts"), MoveTemp(ResultPrompts));
-	// `nextCursor` is blank, since we return them all
-	OutSuccess->SetStringField(TEXT("nextCursor"), TEXT(""));
-	
-	return true;
+	}, Params.cursor, OutRawResult, OutError);
 }
 
 bool FUMCP_Server::Rpc_PromptsGet(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)
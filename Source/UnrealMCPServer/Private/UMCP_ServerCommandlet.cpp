@@ -0,0 +1,85 @@
+#include "UMCP_ServerCommandlet.h"
+#include "UMCP_Server.h"
+#include "UMCP_Trace.h"
+#include "UnrealMCPServerModule.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/Parse.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+	// The editor ticks the queue once per frame; this keeps a request's wait for the game thread about the same
+	constexpr double CommandletTickSeconds = 1.0 / 60.0;
+	// Of each tick, for the async loads FUMCP_PackageLoader starts; the editor's engine loop gives them a similar slice
+	constexpr double CommandletAsyncLoadingSeconds = 0.005;
+}
+
+UUnrealMCPServerCommandlet::UUnrealMCPServerCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = false;
+}
+
+int32 UUnrealMCPServerCommandlet::Main(const FString& Params)
+{
+	int32 Port = FUMCP_Server::DefaultHttpServerPort;
+	FParse::Value(*Params, TEXT("port="), Port);
+	if (Port <= 0 || Port > 65535)
+	{
+		UE_LOG(LogUnrealMCPServer, Error, TEXT("UnrealMCPServer commandlet: -port=%d is not a port"), Port);
+		return 1;
+	}
+	if (FApp::CanEverRender())
+	{
+		UE_LOG(LogUnrealMCPServer, Display, TEXT("UnrealMCPServer commandlet: Pass -nullrhi to skip RHI and shader startup"));
+	}
+
+	// Commandlets don't gather assets in the background, and the search tools and indexes need all of them
+	{
+		UMCP_TRACE_SCOPE(UMCP_CommandletSearchAllAssets);
+		const double SearchStartTime = FPlatformTime::Seconds();
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+		AssetRegistry.SearchAllAssets(true);
+		UE_LOG(LogUnrealMCPServer, Display, TEXT("UnrealMCPServer commandlet: Asset registry searched in %.2f s"), FPlatformTime::Seconds() - SearchStartTime);
+	}
+
+	FUnrealMCPServerModule& Module = FUnrealMCPServerModule::Get();
+	if (!Module.StartServer(static_cast<uint32>(Port), true))
+	{
+		Module.StopServer();
+		return 1;
+	}
+	UE_LOG(LogUnrealMCPServer, Display, TEXT("UnrealMCPServer commandlet: Serving http://localhost:%d/mcp until exit is requested"), Port);
+
+	double LastTickTime = FPlatformTime::Seconds();
+	while (!IsEngineExitRequested())
+	{
+		const double TickStartTime = FPlatformTime::Seconds();
+		// AsyncTask(ENamedThreads::GameThread, ...) work, async package loading (without it a batch_export_assets job
+		// would wait for its loads forever), then the HTTP listeners, the request queue, jobs and the server's other tickers
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		ProcessAsyncLoading(true, false, CommandletAsyncLoadingSeconds);
+		FTSTicker::GetCoreTicker().Tick(static_cast<float>(TickStartTime - LastTickTime));
+		LastTickTime = TickStartTime;
+		GFrameCounter++;
+
+		const double SleepSeconds = CommandletTickSeconds - (FPlatformTime::Seconds() - TickStartTime);
+		if (SleepSeconds > 0.0)
+		{
+			FPlatformProcess::Sleep(static_cast<float>(SleepSeconds));
+		}
+	}
+
+	UE_LOG(LogUnrealMCPServer, Display, TEXT("UnrealMCPServer commandlet: Exit requested, stopping"));
+	Module.StopServer();
+	return 0;
+}
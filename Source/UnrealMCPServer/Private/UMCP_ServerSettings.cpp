@@ -0,0 +1,64 @@
+#include "UMCP_ServerSettings.h"
+#include "UnrealMCPServerModule.h"
+#include "Misc/ConfigCacheIni.h"
+
+namespace
+{
+	const TCHAR* ServerSettingsSection = TEXT("UnrealMCPServer.Server");
+	// Every slot of the log buffer is allocated up front at about 2 KB, so this keeps a mistyped value to ~200 MB
+	const int32 MaxLogBufferLines = 100000;
+}
+
+void FUMCP_ServerSettings::LoadFromConfig()
+{
+	if (!GConfig)
+	{
+		return;
+	}
+
+	// Base<PluginName>.ini is loaded by the plugin manager into its own config branch
+	const FString& ConfigFile = GConfig->GetConfigFilename(TEXT("UnrealMCPServer"));
+
+	GConfig->GetFloat(ServerSettingsSection, TEXT("GameThreadBudgetMs"), GameThreadBudgetMs, ConfigFile);
+	GConfig->GetInt(ServerSettingsSection, TEXT("MaxQueuedGameThreadRequests"), MaxQueuedGameThreadRequests, ConfigFile);
+	GConfig->GetInt(ServerSettingsSection, TEXT("ListPageSize"), ListPageSize, ConfigFile);
+	GConfig->GetInt(ServerSettingsSection, TEXT("CompressionThresholdBytes"), CompressionThresholdBytes, ConfigFile);
+	GConfig->GetFloat(ServerSettingsSection, TEXT("FinishedJobRetentionSeconds"), FinishedJobRetentionSeconds, ConfigFile);
+	GConfig->GetBool(ServerSettingsSection, TEXT("bFlushLogAfterToolCall"), bFlushLogAfterToolCall, ConfigFile);
+	GConfig->GetInt(ServerSettingsSection, TEXT("ExportCacheBudgetMB"), ExportCacheBudgetMB, ConfigFile);
+	GConfig->GetBool(ServerSettingsSection, TEXT("bExportCacheDiskTier"), bExportCacheDiskTier, ConfigFile);
+	GConfig->GetInt(ServerSettingsSection, TEXT("ExportCacheDiskBudgetMB"), ExportCacheDiskBudgetMB, ConfigFile);
+	GConfig->GetInt(ServerSettingsSection, TEXT("SearchSnapshotBudgetMB"), SearchSnapshotBudgetMB, ConfigFile);
+	GConfig->GetFloat(ServerSettingsSection, TEXT("SearchSnapshotTtlSeconds"), SearchSnapshotTtlSeconds, ConfigFile);
+	GConfig->GetBool(ServerSettingsSection, TEXT("bAssetNameIndex"), bAssetNameIndex, ConfigFile);
+	GConfig->GetInt(ServerSettingsSection, TEXT("ExportLoadConcurrency"), ExportLoadConcurrency, ConfigFile);
+	GConfig->GetInt(ServerSettingsSection, TEXT("ExportMemoryWatermarkMB"), ExportMemoryWatermarkMB, ConfigFile);
+	GConfig->GetInt(ServerSettingsSection, TEXT("LogBufferLines"), LogBufferLines, ConfigFile);
+	GConfig->GetInt(ServerSettingsSection, TEXT("ResourceNotifyCoalesceMs"), ResourceNotifyCoalesceMs, ConfigFile);
+	GConfig->GetFloat(ServerSettingsSection, TEXT("ResourcePollTimeoutSeconds"), ResourcePollTimeoutSeconds, ConfigFile);
+	GConfig->GetFloat(ServerSettingsSection, TEXT("SessionIdleTimeoutSeconds"), SessionIdleTimeoutSeconds, ConfigFile);
+
+	GameThreadBudgetMs = FMath::Max(GameThreadBudgetMs, 0.1f);
+	MaxQueuedGameThreadRequests = FMath::Max(MaxQueuedGameThreadRequests, 1);
+	ListPageSize = FMath::Max(ListPageSize, 0);
+	CompressionThresholdBytes = FMath::Max(CompressionThresholdBytes, 0);
+	FinishedJobRetentionSeconds = FMath::Max(FinishedJobRetentionSeconds, 0.0f);
+	ExportCacheBudgetMB = FMath::Max(ExportCacheBudgetMB, 0);
+	ExportCacheDiskBudgetMB = FMath::Max(ExportCacheDiskBudgetMB, 1);
+	SearchSnapshotBudgetMB = FMath::Max(SearchSnapshotBudgetMB, 0);
+	SearchSnapshotTtlSeconds = FMath::Max(SearchSnapshotTtlSeconds, 1.0f);
+	ExportLoadConcurrency = FMath::Clamp(ExportLoadConcurrency, 1, 64);
+	ExportMemoryWatermarkMB = FMath::Max(ExportMemoryWatermarkMB, 0);
+	if (LogBufferLines > MaxLogBufferLines)
+	{
+		UE_LOG(LogUnrealMCPServer, Warning, TEXT("FUMCP_ServerSettings: LogBufferLines=%d is over the maximum, using %d"), LogBufferLines, MaxLogBufferLines);
+	}
+	LogBufferLines = FMath::Clamp(LogBufferLines, 0, MaxLogBufferLines);
+	ResourceNotifyCoalesceMs = FMath::Clamp(ResourceNotifyCoalesceMs, 0, 10000);
+	ResourcePollTimeoutSeconds = FMath::Clamp(ResourcePollTimeoutSeconds, 1.0f, 300.0f);
+	// Longer than a poll, so a client that keeps polling never loses its session
+	SessionIdleTimeoutSeconds = FMath::Max(SessionIdleTimeoutSeconds, ResourcePollTimeoutSeconds * 2.0f);
+
+	UE_LOG(LogUnrealMCPServer, Log, TEXT("FUMCP_ServerSettings: GameThreadBudgetMs=%.2f, MaxQueuedGameThreadRequests=%d, ListPageSize=%d, CompressionThresholdBytes=%d, FinishedJobRetentionSeconds=%.0f, bFlushLogAfterToolCall=%d, ExportCacheBudgetMB=%d, bExportCacheDiskTier=%d, ExportCacheDiskBudgetMB=%d, SearchSnapshotBudgetMB=%d, SearchSnapshotTtlSeconds=%.0f, bAssetNameIndex=%d, ExportLoadConcurrency=%d, ExportMemoryWatermarkMB=%d, LogBufferLines=%d, ResourceNotifyCoalesceMs=%d, ResourcePollTimeoutSeconds=%.0f, SessionIdleTimeoutSeconds=%.0f"),
+		GameThreadBudgetMs, MaxQueuedGameThreadRequests, ListPageSize, CompressionThresholdBytes, FinishedJobRetentionSeconds, bFlushLogAfterToolCall ? 1 : 0, ExportCacheBudgetMB, bExportCacheDiskTier ? 1 : 0, ExportCacheDiskBudgetMB, SearchSnapshotBudgetMB, SearchSnapshotTtlSeconds, bAssetNameIndex ? 1 : 0, ExportLoadConcurrency, ExportMemoryWatermarkMB, LogBufferLines, ResourceNotifyCoalesceMs, ResourcePollTimeoutSeconds, SessionIdleTimeoutSeconds);
+}
@@ -0,0 +1,1100 @@
+#include "UMCP_StructSerializer.h"
+#include "UMCP_Types.h"
+#include "UMCP_Trace.h"
+#include "UnrealMCPServerModule.h"
+#include "JsonObjectConverter.h"
+#include "UObject/UnrealType.h"
+#include "Misc/ScopeRWLock.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/MemoryWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+namespace
+{
+	// How a value is read and written. Everything that is not listed goes through FJsonObjectConverter.
+	enum class EUMCP_PlanKind : uint8
+	{
+		Bool,
+		Int32,
+		Int64,
+		Integer, // Other integer widths, through FNumericProperty
+		Float,
+		Double,
+		String,
+		Name,
+		Struct,
+		Array,
+		StringMap, // TMap with FString keys, written as an object. Read through the converter.
+		Fallback,
+	};
+
+	struct FUMCP_StructPlan;
+
+	struct FUMCP_ValuePlan
+	{
+		EUMCP_PlanKind Kind = EUMCP_PlanKind::Fallback;
+		FProperty* Property = nullptr;
+		const FUMCP_StructPlan* Struct = nullptr; // Struct
+		TUniquePtr<FUMCP_ValuePlan> Element;      // Array element or StringMap value
+	};
+
+	struct FUMCP_FieldPlan
+	{
+		FUMCP_ValuePlan Value;
+		int32 Offset = 0;
+		FString Key;
+		TArray<uint8> KeyUtf8; // `"key":`, quoted and escaped
+	};
+
+	struct FUMCP_StructPlan
+	{
+		const UScriptStruct* Struct = nullptr;
+		TArray<FUMCP_FieldPlan> Fields;
+	};
+
+	// Nested structs deeper than this are rejected when parsing, so hostile input cannot exhaust the stack
+	constexpr int32 MaxReadDepth = 64;
+
+	// Plans live until shutdown: there is one per USTRUCT that is ever serialized, and nested plans point at each other
+	FRWLock GPlansLock;
+	TMap<const UScriptStruct*, TUniquePtr<FUMCP_StructPlan>> GPlans;
+
+	int32 GetStaticArrayDim(const FProperty* Property)
+	{
+#if (ENGINE_MAJOR_VERSION >= (5) && ENGINE_MINOR_VERSION >= (5))
+		return Property->GetArrayDim();
+#else
+		return Property->ArrayDim;
+#endif
+	}
+
+	bool HasDedicatedStructWriter(const UScriptStruct* Struct)
+	{
+		// FJsonObjectConverter writes structs with ExportTextItem as their text form, and FJsonObjectWrapper as its object
+		const UScriptStruct::ICppStructOps* CppStructOps = Struct->GetCppStructOps();
+		return Struct != FJsonObjectWrapper::StaticStruct() && !(CppStructOps && CppStructOps->HasExportTextItem());
+	}
+
+	const FUMCP_StructPlan& BuildPlanLocked(const UScriptStruct* Struct);
+
+	void BuildValuePlan(FProperty* Property, FUMCP_ValuePlan& OutPlan)
+	{
+		OutPlan.Property = Property;
+		OutPlan.Kind = EUMCP_PlanKind::Fallback;
+		if (GetStaticArrayDim(Property) != 1)
+		{
+			return;
+		}
+
+		const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property);
+		const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+		const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property);
+		const FMapProperty* MapProperty = CastField<FMapProperty>(Property);
+		if (Property->IsA<FBoolProperty>())
+		{
+			OutPlan.Kind = EUMCP_PlanKind::Bool;
+		}
+		else if (Property->IsA<FIntProperty>())
+		{
+			OutPlan.Kind = EUMCP_PlanKind::Int32;
+		}
+		else if (Property->IsA<FInt64Property>())
+		{
+			OutPlan.Kind = EUMCP_PlanKind::Int64;
+		}
+		else if (Property->IsA<FFloatProperty>())
+		{
+			OutPlan.Kind = EUMCP_PlanKind::Float;
+		}
+		else if (Property->IsA<FDoubleProperty>())
+		{
+			OutPlan.Kind = EUMCP_PlanKind::Double;
+		}
+		else if (NumericProperty && NumericProperty->IsInteger() && !NumericProperty->IsEnum() && !Property->IsA<FUInt64Property>())
+		{
+			OutPlan.Kind = EUMCP_PlanKind::Integer;
+		}
+		else if (Property->IsA<FStrProperty>())
+		{
+			OutPlan.Kind = EUMCP_PlanKind::String;
+		}
+		else if (Property->IsA<FNameProperty>())
+		{
+			OutPlan.Kind = EUMCP_PlanKind::Name;
+		}
+		else if (StructProperty && HasDedicatedStructWriter(StructProperty->Struct))
+		{
+			OutPlan.Kind = EUMCP_PlanKind::Struct;
+			OutPlan.Struct = &BuildPlanLocked(StructProperty->Struct);
+		}
+		else if (ArrayProperty)
+		{
+			OutPlan.Kind = EUMCP_PlanKind::Array;
+			OutPlan.Element = MakeUnique<FUMCP_ValuePlan>();
+			BuildValuePlan(ArrayProperty->Inner, *OutPlan.Element);
+		}
+		else if (MapProperty && MapProperty->KeyProp->IsA<FStrProperty>())
+		{
+			OutPlan.Kind = EUMCP_PlanKind::StringMap;
+			OutPlan.Element = MakeUnique<FUMCP_ValuePlan>();
+			BuildValuePlan(MapProperty->ValueProp, *OutPlan.Element);
+		}
+	}
+
+	const FUMCP_StructPlan& BuildPlanLocked(const UScriptStruct* Struct)
+	{
+		if (const TUniquePtr<FUMCP_StructPlan>* Existing = GPlans.Find(Struct))
+		{
+			return **Existing;
+		}
+
+		// Registered before its fields are filled in, so a struct holding an array of itself resolves to this plan
+		FUMCP_StructPlan& Plan = *GPlans.Add(Struct, MakeUnique<FUMCP_StructPlan>());
+		Plan.Struct = Struct;
+		for (TFieldIterator<FProperty> It(Struct); It; ++It)
+		{
+			FUMCP_FieldPlan& Field = Plan.Fields.AddDefaulted_GetRef();
+			Field.Offset = It->GetOffset_ForInternal();
+			Field.Key = FJsonObjectConverter::StandardizeCase(It->GetAuthoredName());
+			UMCP_AppendJsonString(Field.KeyUtf8, Field.Key);
+			UMCP_AppendUtf8(Field.KeyUtf8, ":");
+			BuildValuePlan(*It, Field.Value);
+		}
+		UE_LOG(LogUnrealMCPServer, Verbose, TEXT("FUMCP_StructSerializer: Built plan for %s with %d fields"), *Struct->GetName(), Plan.Fields.Num());
+		return Plan;
+	}
+
+	const FUMCP_StructPlan& GetPlan(const UScriptStruct* Struct)
+	{
+		{
+			FReadScopeLock ReadLock(GPlansLock);
+			if (const TUniquePtr<FUMCP_StructPlan>* Existing = GPlans.Find(Struct))
+			{
+				return **Existing;
+			}
+		}
+		FWriteScopeLock WriteLock(GPlansLock);
+		UMCP_TRACE_SCOPE(UMCP_BuildStructPlan);
+		return BuildPlanLocked(Struct);
+	}
+
+	// --- Writing ---
+
+	void AppendInteger(TArray<uint8>& InOutUtf8, int64 Value)
+	{
+		ANSICHAR Buffer[24];
+		const int32 Len = FCStringAnsi::Snprintf(Buffer, UE_ARRAY_COUNT(Buffer), "%lld", static_cast<long long>(Value));
+		UMCP_AppendUtf8(InOutUtf8, FAnsiStringView(Buffer, Len));
+	}
+
+	// Precision is the number of significant digits that round trips the source type (9 for float, 17 for double)
+	void AppendFloatingPoint(TArray<uint8>& InOutUtf8, double Value, int32 Precision)
+	{
+		if (!FMath::IsFinite(Value))
+		{
+			// JSON has no NaN or infinity
+			UMCP_AppendUtf8(InOutUtf8, "null");
+			return;
+		}
+		ANSICHAR Buffer[40];
+		const int32 Len = FCStringAnsi::Snprintf(Buffer, UE_ARRAY_COUNT(Buffer), "%.*g", Precision, Value);
+		UMCP_AppendUtf8(InOutUtf8, FAnsiStringView(Buffer, Len));
+	}
+
+	bool AppendJsonValue(TArray<uint8>& InOutUtf8, const TSharedPtr<FJsonValue>& JsonValue)
+	{
+		// The JSON writer only takes an object or an array at the top level, so the value is written as a one element array
+		TArray<uint8> Scratch;
+		FMemoryWriter Archive(Scratch);
+		TSharedRef<TJsonWriter<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>>> Writer = TJsonWriterFactory<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>>::Create(&Archive);
+		if (!FJsonSerializer::Serialize(TArray<TSharedPtr<FJsonValue>>{ JsonValue }, Writer) || Scratch.Num() < 2)
+		{
+			return false;
+		}
+		InOutUtf8.Append(Scratch.GetData() + 1, Scratch.Num() - 2);
+		return true;
+	}
+
+	TSharedPtr<FJsonValue> ConvertWithConverter(const FUMCP_ValuePlan& Plan, const void* Value)
+	{
+		const int32 ArrayDim = GetStaticArrayDim(Plan.Property);
+		if (ArrayDim == 1)
+		{
+			return FJsonObjectConverter::UPropertyToJsonValue(Plan.Property, Value, 0, 0);
+		}
+
+		// Like the converter, C-style arrays become JSON arrays
+		const int32 ElementSize = Plan.Property->GetSize() / ArrayDim;
+		TArray<TSharedPtr<FJsonValue>> Items;
+		for (int32 Index = 0; Index < ArrayDim; ++Index)
+		{
+			TSharedPtr<FJsonValue> Item = FJsonObjectConverter::UPropertyToJsonValue(Plan.Property, static_cast<const uint8*>(Value) + Index * ElementSize, 0, 0);
+			if (!Item.IsValid())
+			{
+				return nullptr;
+			}
+			Items.Add(MoveTemp(Item));
+		}
+		return MakeShared<FJsonValueArray>(MoveTemp(Items));
+	}
+
+	bool WriteStruct(const FUMCP_StructPlan& Plan, const void* StructData, TArray<uint8>& InOutUtf8);
+
+	bool WriteValue(const FUMCP_ValuePlan& Plan, const void* Value, TArray<uint8>& InOutUtf8)
+	{
+		switch (Plan.Kind)
+		{
+		case EUMCP_PlanKind::Bool:
+			UMCP_AppendUtf8(InOutUtf8, static_cast<const FBoolProperty*>(Plan.Property)->GetPropertyValue(Value) ? "true" : "false");
+			return true;
+		case EUMCP_PlanKind::Int32:
+			AppendInteger(InOutUtf8, *static_cast<const int32*>(Value));
+			return true;
+		case EUMCP_PlanKind::Int64:
+			AppendInteger(InOutUtf8, *static_cast<const int64*>(Value));
+			return true;
+		case EUMCP_PlanKind::Integer:
+			AppendInteger(InOutUtf8, static_cast<const FNumericProperty*>(Plan.Property)->GetSignedIntPropertyValue(Value));
+			return true;
+		case EUMCP_PlanKind::Float:
+			AppendFloatingPoint(InOutUtf8, *static_cast<const float*>(Value), 9);
+			return true;
+		case EUMCP_PlanKind::Double:
+			AppendFloatingPoint(InOutUtf8, *static_cast<const double*>(Value), 17);
+			return true;
+		case EUMCP_PlanKind::String:
+			UMCP_AppendJsonString(InOutUtf8, *static_cast<const FString*>(Value));
+			return true;
+		case EUMCP_PlanKind::Name:
+			UMCP_AppendJsonString(InOutUtf8, static_cast<const FName*>(Value)->ToString());
+			return true;
+		case EUMCP_PlanKind::Struct:
+			return WriteStruct(*Plan.Struct, Value, InOutUtf8);
+		case EUMCP_PlanKind::Array:
+			{
+				FScriptArrayHelper Helper(static_cast<const FArrayProperty*>(Plan.Property), Value);
+				InOutUtf8.Add('[');
+				for (int32 Index = 0; Index < Helper.Num(); ++Index)
+				{
+					if (Index > 0)
+					{
+						InOutUtf8.Add(',');
+					}
+					if (!WriteValue(*Plan.Element, Helper.GetRawPtr(Index), InOutUtf8))
+					{
+						return false;
+					}
+				}
+				InOutUtf8.Add(']');
+				return true;
+			}
+		case EUMCP_PlanKind::StringMap:
+			{
+				FScriptMapHelper Helper(static_cast<const FMapProperty*>(Plan.Property), Value);
+				InOutUtf8.Add('{');
+				bool bFirst = true;
+				for (FScriptMapHelper::FIterator It(Helper); It; ++It)
+				{
+					if (!bFirst)
+					{
+						InOutUtf8.Add(',');
+					}
+					bFirst = false;
+					UMCP_AppendJsonString(InOutUtf8, *reinterpret_cast<const FString*>(Helper.GetKeyPtr(It)));
+					InOutUtf8.Add(':');
+					if (!WriteValue(*Plan.Element, Helper.GetValuePtr(It), InOutUtf8))
+					{
+						return false;
+					}
+				}
+				InOutUtf8.Add('}');
+				return true;
+			}
+		case EUMCP_PlanKind::Fallback:
+		default:
+			{
+				const TSharedPtr<FJsonValue> JsonValue = ConvertWithConverter(Plan, Value);
+				return JsonValue.IsValid() && AppendJsonValue(InOutUtf8, JsonValue);
+			}
+		}
+	}
+
+	bool WriteStruct(const FUMCP_StructPlan& Plan, const void* StructData, TArray<uint8>& InOutUtf8)
+	{
+		InOutUtf8.Add('{');
+		for (int32 Index = 0; Index < Plan.Fields.Num(); ++Index)
+		{
+			const FUMCP_FieldPlan& Field = Plan.Fields[Index];
+			if (Index > 0)
+			{
+				InOutUtf8.Add(',');
+			}
+			InOutUtf8.Append(Field.KeyUtf8);
+			if (!WriteValue(Field.Value, static_cast<const uint8*>(StructData) + Field.Offset, InOutUtf8))
+			{
+				UE_LOG(LogUnrealMCPServer, Warning, TEXT("FUMCP_StructSerializer: Unable to write '%s' of %s"), *Field.Key, *Plan.Struct->GetName());
+				return false;
+			}
+		}
+		InOutUtf8.Add('}');
+		return true;
+	}
+
+	bool WriteStructObject(const FUMCP_StructPlan& Plan, const void* StructData, FJsonObject& OutJsonObject);
+
+	TSharedPtr<FJsonValue> MakeJsonValue(const FUMCP_ValuePlan& Plan, const void* Value)
+	{
+		switch (Plan.Kind)
+		{
+		case EUMCP_PlanKind::Bool:
+			return MakeShared<FJsonValueBoolean>(static_cast<const FBoolProperty*>(Plan.Property)->GetPropertyValue(Value));
+		case EUMCP_PlanKind::Int32:
+			return MakeShared<FJsonValueNumber>(*static_cast<const int32*>(Value));
+		case EUMCP_PlanKind::Int64:
+			return MakeShared<FJsonValueNumber>(static_cast<double>(*static_cast<const int64*>(Value)));
+		case EUMCP_PlanKind::Integer:
+			return MakeShared<FJsonValueNumber>(static_cast<double>(static_cast<const FNumericProperty*>(Plan.Property)->GetSignedIntPropertyValue(Value)));
+		case EUMCP_PlanKind::Float:
+			return MakeShared<FJsonValueNumber>(*static_cast<const float*>(Value));
+		case EUMCP_PlanKind::Double:
+			return MakeShared<FJsonValueNumber>(*static_cast<const double*>(Value));
+		case EUMCP_PlanKind::String:
+			return MakeShared<FJsonValueString>(*static_cast<const FString*>(Value));
+		case EUMCP_PlanKind::Name:
+			return MakeShared<FJsonValueString>(static_cast<const FName*>(Value)->ToString());
+		case EUMCP_PlanKind::Struct:
+			{
+				TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+				if (!WriteStructObject(*Plan.Struct, Value, *JsonObject))
+				{
+					return nullptr;
+				}
+				return MakeShared<FJsonValueObject>(JsonObject);
+			}
+		case EUMCP_PlanKind::Array:
+			{
+				FScriptArrayHelper Helper(static_cast<const FArrayProperty*>(Plan.Property), Value);
+				TArray<TSharedPtr<FJsonValue>> Items;
+				Items.Reserve(Helper.Num());
+				for (int32 Index = 0; Index < Helper.Num(); ++Index)
+				{
+					TSharedPtr<FJsonValue> Item = MakeJsonValue(*Plan.Element, Helper.GetRawPtr(Index));
+					if (!Item.IsValid())
+					{
+						return nullptr;
+					}
+					Items.Add(MoveTemp(Item));
+				}
+				return MakeShared<FJsonValueArray>(MoveTemp(Items));
+			}
+		case EUMCP_PlanKind::StringMap:
+			{
+				FScriptMapHelper Helper(static_cast<const FMapProperty*>(Plan.Property), Value);
+				TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+				for (FScriptMapHelper::FIterator It(Helper); It; ++It)
+				{
+					TSharedPtr<FJsonValue> Item = MakeJsonValue(*Plan.Element, Helper.GetValuePtr(It));
+					if (!Item.IsValid())
+					{
+						return nullptr;
+					}
+					JsonObject->SetField(*reinterpret_cast<const FString*>(Helper.GetKeyPtr(It)), Item);
+				}
+				return MakeShared<FJsonValueObject>(JsonObject);
+			}
+		case EUMCP_PlanKind::Fallback:
+		default:
+			return ConvertWithConverter(Plan, Value);
+		}
+	}
+
+	bool WriteStructObject(const FUMCP_StructPlan& Plan, const void* StructData, FJsonObject& OutJsonObject)
+	{
+		for (const FUMCP_FieldPlan& Field : Plan.Fields)
+		{
+			TSharedPtr<FJsonValue> JsonValue = MakeJsonValue(Field.Value, static_cast<const uint8*>(StructData) + Field.Offset);
+			if (!JsonValue.IsValid())
+			{
+				UE_LOG(LogUnrealMCPServer, Warning, TEXT("FUMCP_StructSerializer: Unable to write '%s' of %s"), *Field.Key, *Plan.Struct->GetName());
+				return false;
+			}
+			OutJsonObject.SetField(Field.Key, JsonValue);
+		}
+		return true;
+	}
+
+	// --- Reading from a DOM ---
+
+	bool ReadWithConverter(const FUMCP_ValuePlan& Plan, const TSharedPtr<FJsonValue>& JsonValue, void* OutValue)
+	{
+		return FJsonObjectConverter::JsonValueToUProperty(JsonValue, Plan.Property, OutValue, 0, 0);
+	}
+
+	bool ReadStructObject(const FUMCP_StructPlan& Plan, const FJsonObject& JsonObject, void* OutStructData);
+
+	// Scalars are as lenient as FJsonValue's TryGet*: numbers and booleans are accepted as strings and vice versa
+	bool ReadValue(const FUMCP_ValuePlan& Plan, const TSharedPtr<FJsonValue>& JsonValue, void* OutValue)
+	{
+		if (!JsonValue.IsValid())
+		{
+			return false;
+		}
+		switch (Plan.Kind)
+		{
+		case EUMCP_PlanKind::Bool:
+			{
+				bool bValue = false;
+				if (!JsonValue->TryGetBool(bValue))
+				{
+					return false;
+				}
+				static_cast<const FBoolProperty*>(Plan.Property)->SetPropertyValue(OutValue, bValue);
+				return true;
+			}
+		case EUMCP_PlanKind::Int32:
+			return JsonValue->TryGetNumber(*static_cast<int32*>(OutValue));
+		case EUMCP_PlanKind::Int64:
+			return JsonValue->TryGetNumber(*static_cast<int64*>(OutValue));
+		case EUMCP_PlanKind::Integer:
+			{
+				int64 Number = 0;
+				if (!JsonValue->TryGetNumber(Number))
+				{
+					return false;
+				}
+				static_cast<const FNumericProperty*>(Plan.Property)->SetIntPropertyValue(OutValue, Number);
+				return true;
+			}
+		case EUMCP_PlanKind::Float:
+			{
+				double Number = 0.0;
+				if (!JsonValue->TryGetNumber(Number))
+				{
+					return false;
+				}
+				*static_cast<float*>(OutValue) = static_cast<float>(Number);
+				return true;
+			}
+		case EUMCP_PlanKind::Double:
+			return JsonValue->TryGetNumber(*static_cast<double*>(OutValue));
+		case EUMCP_PlanKind::String:
+			return JsonValue->TryGetString(*static_cast<FString*>(OutValue));
+		case EUMCP_PlanKind::Name:
+			{
+				FString Text;
+				if (!JsonValue->TryGetString(Text))
+				{
+					return false;
+				}
+				*static_cast<FName*>(OutValue) = FName(*Text);
+				return true;
+			}
+		case EUMCP_PlanKind::Struct:
+			{
+				const TSharedPtr<FJsonObject>* JsonObject = nullptr;
+				return JsonValue->TryGetObject(JsonObject) && JsonObject->IsValid() && ReadStructObject(*Plan.Struct, **JsonObject, OutValue);
+			}
+		case EUMCP_PlanKind::Array:
+			{
+				const TArray<TSharedPtr<FJsonValue>>* Items = nullptr;
+				if (!JsonValue->TryGetArray(Items))
+				{
+					return false;
+				}
+				FScriptArrayHelper Helper(static_cast<const FArrayProperty*>(Plan.Property), OutValue);
+				Helper.EmptyAndAddValues(Items->Num());
+				for (int32 Index = 0; Index < Items->Num(); ++Index)
+				{
+					if (!ReadValue(*Plan.Element, (*Items)[Index], Helper.GetRawPtr(Index)))
+					{
+						return false;
+					}
+				}
+				return true;
+			}
+		case EUMCP_PlanKind::StringMap:
+		case EUMCP_PlanKind::Fallback:
+		default:
+			return ReadWithConverter(Plan, JsonValue, OutValue);
+		}
+	}
+
+	bool ReadStructObject(const FUMCP_StructPlan& Plan, const FJsonObject& JsonObject, void* OutStructData)
+	{
+		for (const FUMCP_FieldPlan& Field : Plan.Fields)
+		{
+			// FJsonObject's map compares keys case-insensitively
+			const TSharedPtr<FJsonValue>* JsonValue = JsonObject.Values.Find(Field.Key);
+			if (!JsonValue || !JsonValue->IsValid() || (*JsonValue)->IsNull())
+			{
+				continue;
+			}
+			if (!ReadValue(Field.Value, *JsonValue, static_cast<uint8*>(OutStructData) + Field.Offset))
+			{
+				UE_LOG(LogUnrealMCPServer, Warning, TEXT("FUMCP_StructSerializer: Unable to read '%s' of %s"), *Field.Key, *Plan.Struct->GetName());
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// --- Reading from UTF-8 ---
+
+	// Pull parser that reads UTF-8 JSON straight into struct memory.
+	// Values the plan does not need (unknown fields) are skipped by matching brackets only.
+	class FUMCP_Utf8JsonParser
+	{
+	public:
+		explicit FUMCP_Utf8JsonParser(TConstArrayView<uint8> Utf8Json)
+			: Begin(Utf8Json.GetData())
+			, Pos(Utf8Json.GetData())
+			, End(Utf8Json.GetData() + Utf8Json.Num())
+		{
+		}
+
+		int32 GetOffset() const { return static_cast<int32>(Pos - Begin); }
+
+		bool IsAtEnd()
+		{
+			SkipWhitespace();
+			return Pos == End;
+		}
+
+		bool ReadStruct(const FUMCP_StructPlan& Plan, void* OutStructData, int32 Depth)
+		{
+			if (Depth > MaxReadDepth || !Consume('{'))
+			{
+				return false;
+			}
+			if (Consume('}'))
+			{
+				return true;
+			}
+
+			int32 NextField = 0;
+			do
+			{
+				if (Peek() != '"' || !ReadStringUtf8(Scratch) || !Consume(':'))
+				{
+					return false;
+				}
+				const int32 FieldIndex = FindField(Plan, Scratch, NextField);
+				if (FieldIndex == INDEX_NONE)
+				{
+					if (!SkipValue())
+					{
+						return false;
+					}
+					continue;
+				}
+
+				NextField = FieldIndex + 1;
+				const FUMCP_FieldPlan& Field = Plan.Fields[FieldIndex];
+				if (Peek() == 'n')
+				{
+					// null keeps the current value, as a missing field does
+					if (!ConsumeLiteral("null"))
+					{
+						return false;
+					}
+					continue;
+				}
+				if (!ReadValue(Field.Value, static_cast<uint8*>(OutStructData) + Field.Offset, Depth + 1))
+				{
+					UE_LOG(LogUnrealMCPServer, Warning, TEXT("FUMCP_StructSerializer: Unable to read '%s' of %s"), *Field.Key, *Plan.Struct->GetName());
+					return false;
+				}
+			}
+			while (Consume(','));
+			return Consume('}');
+		}
+
+	private:
+		bool ReadValue(const FUMCP_ValuePlan& Plan, void* OutValue, int32 Depth)
+		{
+			switch (Plan.Kind)
+			{
+			case EUMCP_PlanKind::Bool:
+				{
+					bool bValue = false;
+					if (ConsumeLiteral("true"))
+					{
+						bValue = true;
+					}
+					else if (!ConsumeLiteral("false"))
+					{
+						return false;
+					}
+					static_cast<const FBoolProperty*>(Plan.Property)->SetPropertyValue(OutValue, bValue);
+					return true;
+				}
+			case EUMCP_PlanKind::Int32:
+				{
+					int64 Number = 0;
+					if (!ReadInteger(Number) || Number < MIN_int32 || Number > MAX_int32)
+					{
+						return false;
+					}
+					*static_cast<int32*>(OutValue) = static_cast<int32>(Number);
+					return true;
+				}
+			case EUMCP_PlanKind::Int64:
+				return ReadInteger(*static_cast<int64*>(OutValue));
+			case EUMCP_PlanKind::Integer:
+				{
+					int64 Number = 0;
+					if (!ReadInteger(Number))
+					{
+						return false;
+					}
+					static_cast<const FNumericProperty*>(Plan.Property)->SetIntPropertyValue(OutValue, Number);
+					return true;
+				}
+			case EUMCP_PlanKind::Float:
+				{
+					double Number = 0.0;
+					if (!ReadDouble(Number))
+					{
+						return false;
+					}
+					*static_cast<float*>(OutValue) = static_cast<float>(Number);
+					return true;
+				}
+			case EUMCP_PlanKind::Double:
+				return ReadDouble(*static_cast<double*>(OutValue));
+			case EUMCP_PlanKind::String:
+				if (!ReadScalarUtf8(Scratch))
+				{
+					return false;
+				}
+				*static_cast<FString*>(OutValue) = UMCP_Utf8ToString(Scratch);
+				return true;
+			case EUMCP_PlanKind::Name:
+				if (!ReadScalarUtf8(Scratch))
+				{
+					return false;
+				}
+				*static_cast<FName*>(OutValue) = FName(*UMCP_Utf8ToString(Scratch));
+				return true;
+			case EUMCP_PlanKind::Struct:
+				return ReadStruct(*Plan.Struct, OutValue, Depth);
+			case EUMCP_PlanKind::Array:
+				{
+					if (Depth > MaxReadDepth || !Consume('['))
+					{
+						return false;
+					}
+					FScriptArrayHelper Helper(static_cast<const FArrayProperty*>(Plan.Property), OutValue);
+					Helper.EmptyValues();
+					if (Consume(']'))
+					{
+						return true;
+					}
+					do
+					{
+						const int32 Index = Helper.AddValue();
+						if (!ReadValue(*Plan.Element, Helper.GetRawPtr(Index), Depth + 1))
+						{
+							return false;
+						}
+					}
+					while (Consume(','));
+					return Consume(']');
+				}
+			case EUMCP_PlanKind::StringMap:
+			case EUMCP_PlanKind::Fallback:
+			default:
+				{
+					// Only this value is parsed into a DOM, wrapped in an array because FJsonSerializer wants an object or array
+					SkipWhitespace();
+					const uint8* ValueStart = Pos;
+					if (!SkipValue())
+					{
+						return false;
+					}
+					TArray<uint8> Wrapped;
+					Wrapped.Reserve(static_cast<int32>(Pos - ValueStart) + 2);
+					Wrapped.Add('[');
+					Wrapped.Append(ValueStart, static_cast<int32>(Pos - ValueStart));
+					Wrapped.Add(']');
+					TSharedPtr<FJsonValue> JsonValue;
+					const TArray<TSharedPtr<FJsonValue>>* Items = nullptr;
+					return UMCP_DeserializeJsonUtf8(Wrapped, JsonValue) && JsonValue->TryGetArray(Items) && Items->Num() == 1
+						&& ReadWithConverter(Plan, (*Items)[0], OutValue);
+				}
+			}
+		}
+
+		static int32 FindField(const FUMCP_StructPlan& Plan, TConstArrayView<uint8> Key, int32 Hint)
+		{
+			// Objects are usually written in declaration order, so the field after the previous one is tried first.
+			// Property names are ASCII, so comparing bytes case-insensitively matches FJsonObject's key lookup.
+			const int32 NumFields = Plan.Fields.Num();
+			for (int32 Attempt = 0; Attempt < NumFields; ++Attempt)
+			{
+				const int32 Index = (Hint + Attempt) % NumFields;
+				const FString& FieldKey = Plan.Fields[Index].Key;
+				if (FieldKey.Len() != Key.Num())
+				{
+					continue;
+				}
+				int32 CharIndex = 0;
+				while (CharIndex < Key.Num() && FChar::ToLower(static_cast<TCHAR>(Key[CharIndex])) == FChar::ToLower(FieldKey[CharIndex]))
+				{
+					++CharIndex;
+				}
+				if (CharIndex == Key.Num())
+				{
+					return Index;
+				}
+			}
+			return INDEX_NONE;
+		}
+
+		static bool IsScalarChar(uint8 Char)
+		{
+			return FChar::IsAlnum(static_cast<TCHAR>(Char)) || Char == '-' || Char == '+' || Char == '.';
+		}
+
+		void SkipWhitespace()
+		{
+			while (Pos < End && (*Pos == ' ' || *Pos == '\t' || *Pos == '\n' || *Pos == '\r'))
+			{
+				++Pos;
+			}
+		}
+
+		uint8 Peek()
+		{
+			SkipWhitespace();
+			return Pos < End ? *Pos : 0;
+		}
+
+		bool Consume(uint8 Char)
+		{
+			if (Peek() != Char)
+			{
+				return false;
+			}
+			++Pos;
+			return true;
+		}
+
+		bool ConsumeLiteral(FAnsiStringView Literal)
+		{
+			SkipWhitespace();
+			if (End - Pos < Literal.Len() || FMemory::Memcmp(Pos, Literal.GetData(), Literal.Len()) != 0
+				|| (End - Pos > Literal.Len() && IsScalarChar(Pos[Literal.Len()])))
+			{
+				return false;
+			}
+			Pos += Literal.Len();
+			return true;
+		}
+
+		static void AppendCodepoint(TArray<uint8>& InOutUtf8, uint32 Codepoint)
+		{
+			if (Codepoint < 0x80)
+			{
+				InOutUtf8.Add(static_cast<uint8>(Codepoint));
+			}
+			else if (Codepoint < 0x800)
+			{
+				InOutUtf8.Add(static_cast<uint8>(0xC0 | (Codepoint >> 6)));
+				InOutUtf8.Add(static_cast<uint8>(0x80 | (Codepoint & 0x3F)));
+			}
+			else if (Codepoint < 0x10000)
+			{
+				InOutUtf8.Add(static_cast<uint8>(0xE0 | (Codepoint >> 12)));
+				InOutUtf8.Add(static_cast<uint8>(0x80 | ((Codepoint >> 6) & 0x3F)));
+				InOutUtf8.Add(static_cast<uint8>(0x80 | (Codepoint & 0x3F)));
+			}
+			else
+			{
+				InOutUtf8.Add(static_cast<uint8>(0xF0 | (Codepoint >> 18)));
+				InOutUtf8.Add(static_cast<uint8>(0x80 | ((Codepoint >> 12) & 0x3F)));
+				InOutUtf8.Add(static_cast<uint8>(0x80 | ((Codepoint >> 6) & 0x3F)));
+				InOutUtf8.Add(static_cast<uint8>(0x80 | (Codepoint & 0x3F)));
+			}
+		}
+
+		bool ReadHex4(uint32& OutValue)
+		{
+			if (End - Pos < 4)
+			{
+				return false;
+			}
+			OutValue = 0;
+			for (int32 Index = 0; Index < 4; ++Index)
+			{
+				const TCHAR Char = static_cast<TCHAR>(*Pos++);
+				if (!FChar::IsHexDigit(Char))
+				{
+					return false;
+				}
+				OutValue = (OutValue << 4) | FParse::HexDigit(Char);
+			}
+			return true;
+		}
+
+		// Reads a quoted string into unescaped UTF-8. Runs without escapes are copied in one go.
+		bool ReadStringUtf8(TArray<uint8>& OutUtf8)
+		{
+			OutUtf8.Reset();
+			if (!Consume('"'))
+			{
+				return false;
+			}
+			while (Pos < End)
+			{
+				const uint8* RunStart = Pos;
+				while (Pos < End && *Pos != '"' && *Pos != '\\' && *Pos >= 0x20)
+				{
+					++Pos;
+				}
+				OutUtf8.Append(RunStart, static_cast<int32>(Pos - RunStart));
+				if (Pos == End || *Pos < 0x20)
+				{
+					return false;
+				}
+				if (*Pos++ == '"')
+				{
+					return true;
+				}
+				if (Pos == End)
+				{
+					return false;
+				}
+				switch (*Pos++)
+				{
+				case '"':  OutUtf8.Add('"'); break;
+				case '\\': OutUtf8.Add('\\'); break;
+				case '/':  OutUtf8.Add('/'); break;
+				case 'b':  OutUtf8.Add('\b'); break;
+				case 'f':  OutUtf8.Add('\f'); break;
+				case 'n':  OutUtf8.Add('\n'); break;
+				case 'r':  OutUtf8.Add('\r'); break;
+				case 't':  OutUtf8.Add('\t'); break;
+				case 'u':
+					{
+						uint32 Codepoint = 0;
+						if (!ReadHex4(Codepoint))
+						{
+							return false;
+						}
+						if (Codepoint >= 0xD800 && Codepoint <= 0xDBFF)
+						{
+							uint32 Low = 0;
+							if (End - Pos >= 6 && Pos[0] == '\\' && Pos[1] == 'u')
+							{
+								Pos += 2;
+								if (!ReadHex4(Low))
+								{
+									return false;
+								}
+							}
+							Codepoint = (Low >= 0xDC00 && Low <= 0xDFFF) ? 0x10000 + ((Codepoint - 0xD800) << 10) + (Low - 0xDC00) : 0xFFFD;
+						}
+						else if (Codepoint >= 0xDC00 && Codepoint <= 0xDFFF)
+						{
+							Codepoint = 0xFFFD;
+						}
+						AppendCodepoint(OutUtf8, Codepoint);
+					}
+					break;
+				default:
+					return false;
+				}
+			}
+			return false;
+		}
+
+		// A string, or the text of a number or boolean (FJsonValue is just as lenient when reading strings)
+		bool ReadScalarUtf8(TArray<uint8>& OutUtf8)
+		{
+			if (Peek() == '"')
+			{
+				return ReadStringUtf8(OutUtf8);
+			}
+			const uint8* Start = Pos;
+			while (Pos < End && IsScalarChar(*Pos))
+			{
+				++Pos;
+			}
+			if (Pos == Start || (Pos - Start == 4 && FMemory::Memcmp(Start, "null", 4) == 0))
+			{
+				return false;
+			}
+			OutUtf8.Reset();
+			OutUtf8.Append(Start, static_cast<int32>(Pos - Start));
+			return true;
+		}
+
+		// Copies a number (or a string holding one) into a null terminated buffer for the C parsers
+		bool ReadNumberText(ANSICHAR (&OutBuffer)[64], bool& bOutIsInteger)
+		{
+			if (!ReadScalarUtf8(Scratch) || Scratch.Num() >= UE_ARRAY_COUNT(OutBuffer))
+			{
+				return false;
+			}
+			bOutIsInteger = true;
+			for (int32 Index = 0; Index < Scratch.Num(); ++Index)
+			{
+				const uint8 Char = Scratch[Index];
+				if (Char == '.' || Char == 'e' || Char == 'E')
+				{
+					bOutIsInteger = false;
+				}
+				else if (!FChar::IsDigit(static_cast<TCHAR>(Char)) && !((Char == '-' || Char == '+') && (Index == 0 || Scratch[Index - 1] == 'e' || Scratch[Index - 1] == 'E')))
+				{
+					return false;
+				}
+				OutBuffer[Index] = static_cast<ANSICHAR>(Char);
+			}
+			OutBuffer[Scratch.Num()] = '\0';
+			return Scratch.Num() > 0;
+		}
+
+		bool ReadInteger(int64& OutNumber)
+		{
+			ANSICHAR Buffer[64];
+			bool bIsInteger = false;
+			if (!ReadNumberText(Buffer, bIsInteger))
+			{
+				return false;
+			}
+			// Integers are parsed exactly; anything else is rounded like FJsonValue::TryGetNumber does
+			OutNumber = bIsInteger ? FCStringAnsi::Strtoi64(Buffer, nullptr, 10) : FMath::RoundToInt64(FCStringAnsi::Atod(Buffer));
+			return true;
+		}
+
+		bool ReadDouble(double& OutNumber)
+		{
+			ANSICHAR Buffer[64];
+			bool bIsInteger = false;
+			if (!ReadNumberText(Buffer, bIsInteger))
+			{
+				return false;
+			}
+			OutNumber = FCStringAnsi::Atod(Buffer);
+			return true;
+		}
+
+		bool SkipString()
+		{
+			++Pos; // Opening quote
+			while (Pos < End)
+			{
+				const uint8 Char = *Pos++;
+				if (Char == '"')
+				{
+					return true;
+				}
+				if (Char == '\\')
+				{
+					++Pos;
+				}
+			}
+			return false;
+		}
+
+		// Skips one value without recursing, only checking that brackets balance
+		bool SkipValue()
+		{
+			int32 Nesting = 0;
+			do
+			{
+				const uint8 Char = Peek();
+				if (Char == '"')
+				{
+					if (!SkipString())
+					{
+						return false;
+					}
+				}
+				else if (Char == '{' || Char == '[')
+				{
+					++Nesting;
+					++Pos;
+				}
+				else if (Char == '}' || Char == ']')
+				{
+					if (Nesting == 0)
+					{
+						return false;
+					}
+					--Nesting;
+					++Pos;
+				}
+				else if (Char == ',' || Char == ':')
+				{
+					if (Nesting == 0)
+					{
+						return false;
+					}
+					++Pos;
+				}
+				else
+				{
+					const uint8* Start = Pos;
+					while (Pos < End && IsScalarChar(*Pos))
+					{
+						++Pos;
+					}
+					if (Pos == Start)
+					{
+						return false;
+					}
+				}
+			}
+			while (Nesting > 0);
+			return true;
+		}
+
+		const uint8* Begin;
+		const uint8* Pos;
+		const uint8* End;
+		TArray<uint8> Scratch; // Reused for keys and scalar values
+	};
+}
+
+bool FUMCP_StructSerializer::WriteJsonUtf8(const UScriptStruct* Struct, const void* StructData, TArray<uint8>& InOutUtf8)
+{
+	UMCP_TRACE_SCOPE(UMCP_WriteStructJson);
+	const int32 StartNum = InOutUtf8.Num();
+	if (!Struct || !WriteStruct(GetPlan(Struct), StructData, InOutUtf8))
+	{
+		// Never leave half an object behind in the caller's buffer
+		InOutUtf8.SetNum(StartNum);
+		return false;
+	}
+	return true;
+}
+
+bool FUMCP_StructSerializer::WriteJsonObject(const UScriptStruct* Struct, const void* StructData, FJsonObject& OutJsonObject)
+{
+	UMCP_TRACE_SCOPE(UMCP_WriteStructJsonObject);
+	return Struct && WriteStructObject(GetPlan(Struct), StructData, OutJsonObject);
+}
+
+bool FUMCP_StructSerializer::ReadJsonObject(const UScriptStruct* Struct, const FJsonObject& JsonObject, void* OutStructData)
+{
+	UMCP_TRACE_SCOPE(UMCP_ReadStructJsonObject);
+	return Struct && ReadStructObject(GetPlan(Struct), JsonObject, OutStructData);
+}
+
+bool FUMCP_StructSerializer::ReadJsonUtf8(const UScriptStruct* Struct, TConstArrayView<uint8> Utf8Json, void* OutStructData)
+{
+	UMCP_TRACE_SCOPE(UMCP_ReadStructJson);
+	if (!Struct)
+	{
+		return false;
+	}
+	FUMCP_Utf8JsonParser Parser(Utf8Json);
+	if (!Parser.ReadStruct(GetPlan(Struct), OutStructData, 0) || !Parser.IsAtEnd())
+	{
+		UE_LOG(LogUnrealMCPServer, Warning, TEXT("FUMCP_StructSerializer: Invalid JSON for %s near byte %d"), *Struct->GetName(), Parser.GetOffset());
+		return false;
+	}
+	return true;
+}
@@ -1,4 +1,5 @@
 #include "UMCP_T3DFallbackFactory.h"
+#include "UMCP_T3DStreamReader.h"
 #include "UObject/UnrealType.h"
 #include "Factories/Factory.h"
 #include "Editor/UnrealEd/Public/UnrealEd.h"
@@ -6,6 +7,7 @@
 #include "Misc/FileHelper.h"
 #include "UObject/UObjectGlobals.h"
 #include "UObject/Package.h"
+#include "UObject/ObjectInstancingGraph.h"
 #include "UnrealMCPServerModule.h"
 
 UMCP_T3DFallbackFactory::UMCP_T3DFallbackFactory(const FObjectInitializer& ObjectInitializer)
@@ -45,11 +47,19 @@ void UMCP_T3DFallbackFactory::SetSupportedClass(UClass* InSupportedClass)
 	}
 }
 
+void UMCP_T3DFallbackFactory::SetCallEditChange(bool bInCallEditChange)
+{
+	if (UMCP_T3DFallbackFactory* DefaultFactory = StaticClass()->GetDefaultObject<UMCP_T3DFallbackFactory>())
+	{
+		DefaultFactory->bCallEditChange = bInCallEditChange;
+	}
+}
+
 UObject* UMCP_T3DFallbackFactory::FactoryCreateFile(UClass* InClass, UObject* InParent, FName InName, EObjectFlags Flags, const FString& Filename, const TCHAR* Parms, FFeedbackContext* Warn, bool& bOutOperationCanceled)
 {
-	// Read the T3D file content
-	FString T3DContent;
-	if (!FFileHelper::LoadFileToString(T3DContent, *Filename))
+	// Map the file and import it a chunk at a time, so memory stays flat however large the file is
+	FUMCP_T3DStreamReader Reader;
+	if (!Reader.Open(Filename))
 	{
 		if (Warn)
 		{
@@ -58,26 +68,35 @@ UObject* UMCP_T3DFallbackFactory::FactoryCreateFile(UClass* InClass, UObject* In
 		return nullptr;
 	}
 	
+	// Shared by all chunks so subobjects instanced by one chunk are reused by the next
+	FObjectInstancingGraph InstanceGraph;
+
 	// Import the T3D properties into the object
-	const TCHAR* T3DBuffer = *T3DContent;
 	FImportObjectParams ImportParams;
-	ImportParams.SourceText = T3DBuffer;
 	ImportParams.DestData = (uint8*)InParent;
 	ImportParams.ObjectStruct = InClass; // UClass inherits from UStruct
 	ImportParams.SubobjectRoot = InParent;
 	ImportParams.SubobjectOuter = InParent;
 	ImportParams.Warn = Warn;
+	ImportParams.InInstanceGraph = &InstanceGraph;
 	// Depth defaults to 0 (appropriate for top-level import)
 	// LineNumber defaults to INDEX_NONE (appropriate when not tracking line numbers)
-	// InInstanceGraph defaults to nullptr (appropriate for simple imports)
 	// ObjectRemapper defaults to nullptr (appropriate when no remapping needed)
-	// bShouldCallEditChange defaults to true (appropriate for editor imports)
+	// bShouldCallEditChange is true for editor imports, unless a batch import sends the notifications itself
+	ImportParams.bShouldCallEditChange = bCallEditChange;
 	
 	// Import the object properties from the T3D file
-	ImportObjectProperties(ImportParams);
+	const TCHAR* T3DBuffer = nullptr;
+	int32 NumChunks = 0;
+	while (Reader.ReadChunk(T3DBuffer))
+	{
+		ImportParams.SourceText = T3DBuffer;
+		ImportObjectProperties(ImportParams);
+		++NumChunks;
+	}
+	UE_LOG(LogUnrealMCPServer, Verbose, TEXT("UMCP_T3DFallbackFactory: Imported %s in %d chunk(s)%s"), *Filename, NumChunks, Reader.IsMapped() ? TEXT(" from a mapped file") : TEXT(""));
 
 	auto pCreatedObject = FindObject<UObject>(InParent, *InName.ToString());
 	
 	return pCreatedObject;
 }
-
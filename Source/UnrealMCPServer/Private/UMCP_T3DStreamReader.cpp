@@ -0,0 +1,317 @@
+#include "UMCP_T3DStreamReader.h"
+#include "UMCP_Trace.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+
+namespace
+{
+	template <typename CharType>
+	bool IsLineSpace(CharType Char)
+	{
+		return Char == ' ' || Char == '\t';
+	}
+
+	// Whether Text starts with the lowercase Keyword followed by whitespace or the end of the line, ignoring case
+	template <typename CharType>
+	bool StartsWithKeyword(const CharType* Text, int64 NumChars, const ANSICHAR* Keyword, int64& OutKeywordEnd)
+	{
+		int64 Index = 0;
+		for (; Keyword[Index] != '\0'; ++Index)
+		{
+			if (Index >= NumChars)
+			{
+				return false;
+			}
+			const CharType Char = Text[Index];
+			const CharType LowerChar = (Char >= 'A' && Char <= 'Z') ? static_cast<CharType>(Char + ('a' - 'A')) : Char;
+			if (LowerChar != static_cast<CharType>(Keyword[Index]))
+			{
+				return false;
+			}
+		}
+		OutKeywordEnd = Index;
+		return Index == NumChars || IsLineSpace(Text[Index]) || Text[Index] == '\r' || Text[Index] == '\n';
+	}
+
+	// The line starting at Position, without its leading whitespace
+	template <typename CharType>
+	const CharType* GetLineText(const CharType* Chars, int64 Position, int64 LineEnd, int64& OutNumChars)
+	{
+		while (Position < LineEnd && IsLineSpace(Chars[Position]))
+		{
+			++Position;
+		}
+		OutNumChars = LineEnd - Position;
+		return Chars + Position;
+	}
+
+	template <typename CharType>
+	int64 FindLineEnd(const CharType* Chars, int64 Position, int64 NumChars)
+	{
+		while (Position < NumChars && Chars[Position] != '\n')
+		{
+			++Position;
+		}
+		return Position < NumChars ? Position + 1 : Position;
+	}
+
+	// Tracks {} nesting and quotes over a line the way FParse::LineExtended does
+	template <typename CharType>
+	void UpdateBraceDepth(const CharType* Chars, int64 LineStart, int64 LineEnd, int32& InOutBraceDepth, bool& bInOutQuoted)
+	{
+		bool bEscaped = false;
+		for (int64 Index = LineStart; Index < LineEnd; ++Index)
+		{
+			const CharType Char = Chars[Index];
+			if (Char == '"' && !bEscaped)
+			{
+				bInOutQuoted = !bInOutQuoted;
+			}
+			bEscaped = Char == '\\';
+			if (!bInOutQuoted)
+			{
+				if (Char == '{')
+				{
+					++InOutBraceDepth;
+				}
+				else if (Char == '}' && InOutBraceDepth > 0)
+				{
+					--InOutBraceDepth;
+				}
+			}
+		}
+		if (InOutBraceDepth == 0)
+		{
+			// FParse::LineExtended only carries quotes over into the next line inside a {} block
+			bInOutQuoted = false;
+		}
+	}
+}
+
+FUMCP_T3DStreamReader::FUMCP_T3DStreamReader(int32 InTargetChunkChars)
+	: TargetChunkChars(FMath::Max(InTargetChunkChars, 1))
+{
+}
+
+FUMCP_T3DStreamReader::~FUMCP_T3DStreamReader()
+{
+	// The region has to go before the file it maps
+	MappedRegion.Reset();
+	MappedFile.Reset();
+}
+
+bool FUMCP_T3DStreamReader::Open(const FString& Filename)
+{
+	UMCP_TRACE_SCOPE(UMCP_T3DOpen);
+	MappedRegion.Reset();
+	MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename));
+	if (MappedFile.IsValid())
+	{
+		if (MappedFile->GetFileSize() == 0)
+		{
+			return OpenData(nullptr, 0);
+		}
+		MappedRegion.Reset(MappedFile->MapRegion());
+		if (MappedRegion.IsValid())
+		{
+			return OpenData(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize());
+		}
+		MappedFile.Reset();
+	}
+
+	// Platform files that can't map (e.g. pak files) still save the UTF-16 copy of the whole file
+	TArray<uint8> FileBytes;
+	if (!FFileHelper::LoadFileToArray(FileBytes, *Filename, FILEREAD_Silent))
+	{
+		return false;
+	}
+	return OpenBytes(MoveTemp(FileBytes));
+}
+
+bool FUMCP_T3DStreamReader::OpenBytes(TArray<uint8>&& InBytes)
+{
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	Bytes = MoveTemp(InBytes);
+	return OpenData(Bytes.GetData(), Bytes.Num());
+}
+
+bool FUMCP_T3DStreamReader::OpenData(const uint8* InData, int64 InSize)
+{
+	Position = 0;
+	BlockDepth = 0;
+	BraceDepth = 0;
+	bQuoted = false;
+	TopLevelObjectHeader.Reset();
+	bResumeTopLevelObject = false;
+	Buffer.Reset();
+
+	// The byte order marks FFileHelper writes; files without one are read as UTF-8 like LoadFileToString does
+	Encoding = EEncoding::UTF8;
+	if (InSize >= 3 && InData[0] == 0xEF && InData[1] == 0xBB && InData[2] == 0xBF)
+	{
+		InData += 3;
+		InSize -= 3;
+	}
+	else if (InSize >= 2 && InData[0] == 0xFF && InData[1] == 0xFE)
+	{
+		Encoding = EEncoding::UTF16LE;
+		InData += 2;
+		InSize -= 2;
+	}
+	else if (InSize >= 2 && InData[0] == 0xFE && InData[1] == 0xFF)
+	{
+		Data = nullptr;
+		Size = 0;
+		return false;
+	}
+	Data = InData;
+	Size = InSize;
+	return true;
+}
+
+bool FUMCP_T3DStreamReader::ReadChunk(const TCHAR*& OutText)
+{
+	UMCP_TRACE_SCOPE(UMCP_T3DReadChunk);
+	const bool bRead = Encoding == EEncoding::UTF16LE
+		? ReadChunkFrom(reinterpret_cast<const UTF16CHAR*>(Data), Size / static_cast<int64>(sizeof(UTF16CHAR)))
+		: ReadChunkFrom(reinterpret_cast<const UTF8CHAR*>(Data), Size);
+	OutText = Buffer.GetData();
+	return bRead;
+}
+
+template <typename CharType>
+bool FUMCP_T3DStreamReader::ReadChunkFrom(const CharType* Chars, int64 NumChars)
+{
+	Buffer.Reset();
+	if (Position >= NumChars)
+	{
+		return false;
+	}
+	if (bResumeTopLevelObject)
+	{
+		Buffer.Append(TopLevelObjectHeader);
+	}
+	bResumeTopLevelObject = false;
+
+	while (Position < NumChars)
+	{
+		const int64 LineStart = Position;
+		const int64 LineEnd = FindLineEnd(Chars, LineStart, NumChars);
+		Position = LineEnd;
+
+		bool bOpensTopLevelObject = false;
+		if (BraceDepth == 0)
+		{
+			int64 TextChars = 0;
+			int64 KeywordEnd = 0;
+			const CharType* Text = GetLineText(Chars, LineStart, LineEnd, TextChars);
+			if (StartsWithKeyword(Text, TextChars, "begin", KeywordEnd))
+			{
+				if (BlockDepth == 0)
+				{
+					TopLevelObjectHeader.Reset();
+					int64 ObjectChars = 0;
+					const CharType* ObjectText = GetLineText(Text, KeywordEnd, TextChars, ObjectChars);
+					bOpensTopLevelObject = StartsWithKeyword(ObjectText, ObjectChars, "object", KeywordEnd);
+				}
+				++BlockDepth;
+			}
+			else if (StartsWithKeyword(Text, TextChars, "end", KeywordEnd) && BlockDepth > 0)
+			{
+				--BlockDepth;
+			}
+		}
+
+		UpdateBraceDepth(Chars, LineStart, LineEnd, BraceDepth, bQuoted);
+
+		const int32 LineBufferStart = Buffer.Num();
+		AppendConverted(Chars + LineStart, LineEnd - LineStart);
+		if (bOpensTopLevelObject)
+		{
+			TopLevelObjectHeader.Append(Buffer.GetData() + LineBufferStart, Buffer.Num() - LineBufferStart);
+		}
+		if (BlockDepth == 0)
+		{
+			TopLevelObjectHeader.Reset();
+		}
+
+		if (Buffer.Num() < TargetChunkChars || BraceDepth != 0 || bOpensTopLevelObject || Position >= NumChars)
+		{
+			continue;
+		}
+		if (BlockDepth == 0)
+		{
+			break;
+		}
+		if (BlockDepth == 1 && TopLevelObjectHeader.Num() > 0)
+		{
+			// A chunk of only the header and the object's own End Object would import nothing
+			int64 NextChars = 0;
+			int64 KeywordEnd = 0;
+			const CharType* NextText = GetLineText(Chars, Position, FindLineEnd(Chars, Position, NumChars), NextChars);
+			if (StartsWithKeyword(NextText, NextChars, "end", KeywordEnd))
+			{
+				continue;
+			}
+			Buffer.Append(TEXT("End Object") LINE_TERMINATOR, FCString::Strlen(TEXT("End Object") LINE_TERMINATOR));
+			bResumeTopLevelObject = true;
+			break;
+		}
+	}
+
+	Buffer.Add(TEXT('\0'));
+	return true;
+}
+
+template <typename CharType>
+void FUMCP_T3DStreamReader::AppendConverted(const CharType* Chars, int64 NumChars)
+{
+	const int32 NumSourceChars = static_cast<int32>(NumChars);
+	const int32 NumConvertedChars = FPlatformString::ConvertedLength<TCHAR>(Chars, NumSourceChars);
+	const int32 Start = Buffer.AddUninitialized(NumConvertedChars);
+	FPlatformString::Convert(Buffer.GetData() + Start, NumConvertedChars, Chars, NumSourceChars);
+}
+
+void FUMCP_T3DStreamReader::FindObjectBlocks(FStringView Text, TArray<int32>& OutBlockStarts)
+{
+	UMCP_TRACE_SCOPE(UMCP_T3DFindObjectBlocks);
+	OutBlockStarts.Reset();
+	const TCHAR* Chars = Text.GetData();
+	const int64 NumChars = Text.Len();
+	int32 Depth = 0;
+	int32 Braces = 0;
+	bool bQuotedLine = false;
+	bool bStartsBlock = true;
+	for (int64 Position = 0; Position < NumChars;)
+	{
+		const int64 LineStart = Position;
+		const int64 LineEnd = FindLineEnd(Chars, LineStart, NumChars);
+		Position = LineEnd;
+
+		bool bEndsBlock = false;
+		if (Braces == 0)
+		{
+			int64 LineChars = 0;
+			int64 KeywordEnd = 0;
+			const TCHAR* LineText = GetLineText(Chars, LineStart, LineEnd, LineChars);
+			if (StartsWithKeyword(LineText, LineChars, "begin", KeywordEnd))
+			{
+				bStartsBlock |= Depth <= 1;
+				++Depth;
+			}
+			else if (StartsWithKeyword(LineText, LineChars, "end", KeywordEnd) && Depth > 0)
+			{
+				--Depth;
+				bEndsBlock = Depth <= 1;
+			}
+		}
+		if (bStartsBlock)
+		{
+			OutBlockStarts.Add(static_cast<int32>(LineStart));
+		}
+		UpdateBraceDepth(Chars, LineStart, LineEnd, Braces, bQuotedLine);
+		bStartsBlock = bEndsBlock;
+	}
+}
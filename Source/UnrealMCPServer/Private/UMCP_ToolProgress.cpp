@@ -0,0 +1,109 @@
+#include "UMCP_ToolProgress.h"
+#include "UnrealMCPServerModule.h"
+
+namespace
+{
+	// Tools run synchronously inside Rpc_ToolsCall, so the scope of the running call is per thread
+	thread_local FUMCP_ToolProgressScope* GCurrentToolProgressScope = nullptr;
+
+	void AppendJsonNumber(TArray<uint8>& InOutUtf8, double Value)
+	{
+		const FString Number = FString::Printf(TEXT("%.15g"), Value);
+		const auto Convert = StringCast<ANSICHAR>(*Number, Number.Len());
+		UMCP_AppendUtf8(InOutUtf8, FAnsiStringView(Convert.Get(), Convert.Length()));
+	}
+}
+
+FUMCP_ToolProgressScope::FUMCP_ToolProgressScope(const FUMCP_JsonRpcRequest& Request)
+	: PreviousScope(GCurrentToolProgressScope)
+{
+	GCurrentToolProgressScope = this;
+
+	const TSharedPtr<FJsonObject>* Meta = nullptr;
+	if (!Request.EventStream.IsValid() || !Request.params.IsValid() || !Request.params->TryGetObjectField(TEXT("_meta"), Meta))
+	{
+		return;
+	}
+
+	const TSharedPtr<FJsonValue> ProgressToken = (*Meta)->TryGetField(TEXT("progressToken"));
+	if (!ProgressToken.IsValid())
+	{
+		return;
+	}
+	if (ProgressToken->Type == EJson::String)
+	{
+		UMCP_AppendJsonString(ProgressTokenUtf8, ProgressToken->AsString());
+	}
+	else if (ProgressToken->Type == EJson::Number)
+	{
+		AppendJsonNumber(ProgressTokenUtf8, FMath::RoundToDouble(ProgressToken->AsNumber()));
+	}
+	else
+	{
+		UE_LOG(LogUnrealMCPServer, Warning, TEXT("FUMCP_ToolProgressScope: Ignoring progressToken that is neither a string nor an integer"));
+		return;
+	}
+	EventStream = Request.EventStream;
+}
+
+FUMCP_ToolProgressScope::~FUMCP_ToolProgressScope()
+{
+	GCurrentToolProgressScope = PreviousScope;
+}
+
+void FUMCP_ToolProgressScope::AppendNotification(FAnsiStringView Method, TFunctionRef<void(TArray<uint8>&)> AppendParams) const
+{
+	TArray<uint8> Message;
+	UMCP_AppendUtf8(Message, "{\"jsonrpc\":\"2.0\",\"method\":\"");
+	UMCP_AppendUtf8(Message, Method);
+	UMCP_AppendUtf8(Message, "\",\"params\":{\"progressToken\":");
+	Message.Append(ProgressTokenUtf8);
+	AppendParams(Message);
+	UMCP_AppendUtf8(Message, "}}");
+	EventStream->AppendMessage(Message);
+}
+
+bool FUMCP_ToolProgress::IsActive()
+{
+	return GCurrentToolProgressScope && GCurrentToolProgressScope->EventStream.IsValid();
+}
+
+void FUMCP_ToolProgress::Report(double Progress, double Total, const FString& Message)
+{
+	if (!IsActive())
+	{
+		return;
+	}
+
+	GCurrentToolProgressScope->AppendNotification("notifications/progress", [Progress, Total, &Message](TArray<uint8>& InOutUtf8)
+	{
+		UMCP_AppendUtf8(InOutUtf8, ",\"progress\":");
+		AppendJsonNumber(InOutUtf8, Progress);
+		if (Total > 0.0)
+		{
+			UMCP_AppendUtf8(InOutUtf8, ",\"total\":");
+			AppendJsonNumber(InOutUtf8, Total);
+		}
+		if (!Message.IsEmpty())
+		{
+			UMCP_AppendUtf8(InOutUtf8, ",\"message\":");
+			UMCP_AppendJsonString(InOutUtf8, Message);
+		}
+	});
+}
+
+void FUMCP_ToolProgress::EmitPartialContent(const FUMCP_CallToolResultContent& Content)
+{
+	if (!IsActive())
+	{
+		return;
+	}
+
+	GCurrentToolProgressScope->AppendNotification("notifications/unreal/partialContent", [&Content](TArray<uint8>& InOutUtf8)
+	{
+		TArray<uint8> TextUtf8;
+		Content.AppendTextUtf8(TextUtf8);
+		UMCP_AppendUtf8(InOutUtf8, ",\"content\":");
+		Content.AppendJsonUtf8(InOutUtf8, TextUtf8);
+	});
+}
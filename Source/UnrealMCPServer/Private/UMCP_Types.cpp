@@ -1,9 +1,15 @@
 
 #include "UMCP_Types.h"
+#include "UMCP_ToolProgress.h"
+#include "UMCP_Trace.h"
 #include "UObject/UnrealType.h"
 #include "UObject/Class.h"
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonSerializer.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/StructOnScope.h"
+#include "Misc/ScopeRWLock.h"
 
 
 FUMCP_JsonRpcId FUMCP_JsonRpcId::CreateNullId()
@@ -79,10 +85,24 @@ bool FUMCP_JsonRpcRequest::CreateFromJsonString(const FString& JsonString, FUMCP
 		return false;
 	}
 
+	if (!CreateFromJsonObject(RootJsonObject, OutRequest))
+	{
+		UE_LOG(LogTemp, Error, TEXT("FJsonRpcRequest::CreateFromJsonString: Missing 'jsonrpc' or 'method'. String: %s"), *JsonString);
+		return false;
+	}
+	return true;
+}
+
+bool FUMCP_JsonRpcRequest::CreateFromJsonObject(const TSharedPtr<FJsonObject>& RootJsonObject, FUMCP_JsonRpcRequest& OutRequest)
+{
+	if (!RootJsonObject.IsValid())
+	{
+		return false;
+	}
+
 	if (!RootJsonObject->TryGetStringField(TEXT("jsonrpc"), OutRequest.jsonrpc) ||
 		!RootJsonObject->TryGetStringField(TEXT("method"), OutRequest.method))
 	{
-		UE_LOG(LogTemp, Error, TEXT("FJsonRpcRequest::CreateFromJsonString: Missing 'jsonrpc' or 'method'. String: %s"), *JsonString);
 		return false;
 	}
 
@@ -92,10 +112,12 @@ bool FUMCP_JsonRpcRequest::CreateFromJsonString(const FString& JsonString, FUMCP
 	if (RootJsonObject->HasField(TEXT("id")))
 	{
 		OutRequest.id = FUMCP_JsonRpcId::CreateFromJsonValue(RootJsonObject->GetField<EJson::None>(TEXT("id")));
+		OutRequest.bIsNotification = false;
 	}
 	else
 	{
 		OutRequest.id = FUMCP_JsonRpcId::CreateNullId();
+		OutRequest.bIsNotification = true;
 	}
 	
 	if (RootJsonObject->HasTypedField<EJson::Object>(TEXT("params")))
@@ -146,8 +168,68 @@ bool FUMCP_JsonRpcError::CreateFromJsonObject(const TSharedPtr<FJsonObject>& Jso
 }
 
 bool FUMCP_JsonRpcResponse::ToJsonString(FString& OutJsonString) const
+{
+	TArray<uint8> Utf8Json;
+	if (!ToJsonUtf8(Utf8Json))
+	{
+		return false;
+	}
+	OutJsonString = UMCP_Utf8ToString(Utf8Json);
+	return true;
+}
+
+bool FUMCP_JsonRpcResponse::ToJsonUtf8(TArray<uint8>& InOutUtf8) const
 {
 	TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	if (!ToJsonObject(JsonObject))
+	{
+		return false;
+	}
+
+	if (error.IsValid() || rawResult.Num() == 0)
+	{
+		return UMCP_SerializeJsonUtf8(JsonObject.ToSharedRef(), InOutUtf8);
+	}
+
+	// Serialize the small envelope, then splice the pre-serialized result in before its closing brace
+	TArray<uint8> Envelope;
+	if (!UMCP_SerializeJsonUtf8(JsonObject.ToSharedRef(), Envelope) || Envelope.Num() == 0 || Envelope.Last() != '}')
+	{
+		return false;
+	}
+	InOutUtf8.Reserve(InOutUtf8.Num() + Envelope.Num() + rawResult.Num() + 16);
+	InOutUtf8.Append(Envelope.GetData(), Envelope.Num() - 1);
+	UMCP_AppendUtf8(InOutUtf8, ",\"result\":");
+	InOutUtf8.Append(rawResult);
+	UMCP_AppendUtf8(InOutUtf8, "}");
+	return true;
+}
+
+bool FUMCP_JsonRpcResponse::BatchToJsonUtf8(const TArray<const FUMCP_JsonRpcResponse*>& Responses, TArray<uint8>& InOutUtf8)
+{
+	// Joined as bytes so responses carrying a rawResult don't have to be parsed back into a DOM
+	UMCP_AppendUtf8(InOutUtf8, "[");
+	for (int32 Index = 0; Index < Responses.Num(); ++Index)
+	{
+		if (Index > 0)
+		{
+			UMCP_AppendUtf8(InOutUtf8, ",");
+		}
+		if (!Responses[Index] || !Responses[Index]->ToJsonUtf8(InOutUtf8))
+		{
+			return false;
+		}
+	}
+	UMCP_AppendUtf8(InOutUtf8, "]");
+	return true;
+}
+
+bool FUMCP_JsonRpcResponse::ToJsonObject(TSharedPtr<FJsonObject>& JsonObject) const
+{
+	if (!JsonObject.IsValid())
+	{
+		return false;
+	}
 	JsonObject->SetStringField(TEXT("jsonrpc"), jsonrpc);
 
 	// Use id.GetJsonValue() which can be nullptr if ID is absent
@@ -185,7 +267,7 @@ bool FUMCP_JsonRpcResponse::ToJsonString(FString& OutJsonString) const
 	// then neither field is added, which is fine. For responses to requests with an ID,
 	// either 'result' or 'error' MUST be present.
 
-	return FJsonSerializer::Serialize(JsonObject.ToSharedRef(), TJsonWriterFactory<>::Create(&OutJsonString));
+	return true;
 }
 
 bool FUMCP_JsonRpcResponse::CreateFromJsonString(const FString& JsonString, FUMCP_JsonRpcResponse& OutResponse)
@@ -236,6 +318,174 @@ bool FUMCP_JsonRpcResponse::CreateFromJsonString(const FString& JsonString, FUMC
 	return true;
 }
 
+bool UMCP_DeserializeJsonUtf8(TConstArrayView<uint8> Utf8Json, TSharedPtr<FJsonValue>& OutValue)
+{
+#if (ENGINE_MAJOR_VERSION >= (5) && ENGINE_MINOR_VERSION >= (4))
+	// Parse the bytes in place instead of widening the whole body into an FString first
+	TSharedRef<TJsonReader<UTF8CHAR>> Reader = TJsonReaderFactory<UTF8CHAR>::CreateFromView(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Utf8Json.GetData()), Utf8Json.Num()));
+#else
+	FUTF8ToTCHAR Convert(reinterpret_cast<const ANSICHAR*>(Utf8Json.GetData()), Utf8Json.Num());
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FString(Convert.Length(), Convert.Get()));
+#endif
+	return FJsonSerializer::Deserialize(Reader, OutValue) && OutValue.IsValid();
+}
+
+bool UMCP_SerializeJsonUtf8(const TSharedRef<FJsonObject>& JsonObject, TArray<uint8>& InOutUtf8)
+{
+	FMemoryWriter Archive(InOutUtf8, false, true /* append */);
+	TSharedRef<TJsonWriter<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>>> Writer = TJsonWriterFactory<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>>::Create(&Archive);
+	return FJsonSerializer::Serialize(JsonObject, Writer);
+}
+
+void UMCP_AppendUtf8(TArray<uint8>& InOutUtf8, FAnsiStringView Literal)
+{
+	InOutUtf8.Append(reinterpret_cast<const uint8*>(Literal.GetData()), Literal.Len());
+}
+
+void UMCP_AppendJsonString(TArray<uint8>& InOutUtf8, FStringView Text)
+{
+	FTCHARToUTF8 Convert(Text.GetData(), Text.Len());
+	UMCP_AppendJsonStringUtf8(InOutUtf8, TConstArrayView<uint8>(reinterpret_cast<const uint8*>(Convert.Get()), Convert.Length()));
+}
+
+void UMCP_AppendJsonStringUtf8(TArray<uint8>& InOutUtf8, TConstArrayView<uint8> Utf8Text)
+{
+	// Multi-byte UTF-8 sequences are valid inside JSON strings as-is; only quotes, backslashes and control characters need escaping
+	InOutUtf8.Reserve(InOutUtf8.Num() + Utf8Text.Num() + Utf8Text.Num() / 16 + 2);
+	InOutUtf8.Add('"');
+	int32 RunStart = 0;
+	for (int32 Index = 0; Index < Utf8Text.Num(); ++Index)
+	{
+		const uint8 Char = Utf8Text[Index];
+		if (Char >= 0x20 && Char != '"' && Char != '\\')
+		{
+			continue;
+		}
+
+		InOutUtf8.Append(Utf8Text.GetData() + RunStart, Index - RunStart);
+		RunStart = Index + 1;
+		switch (Char)
+		{
+		case '"':  UMCP_AppendUtf8(InOutUtf8, "\\\""); break;
+		case '\\': UMCP_AppendUtf8(InOutUtf8, "\\\\"); break;
+		case '\n': UMCP_AppendUtf8(InOutUtf8, "\\n"); break;
+		case '\r': UMCP_AppendUtf8(InOutUtf8, "\\r"); break;
+		case '\t': UMCP_AppendUtf8(InOutUtf8, "\\t"); break;
+		case '\b': UMCP_AppendUtf8(InOutUtf8, "\\b"); break;
+		case '\f': UMCP_AppendUtf8(InOutUtf8, "\\f"); break;
+		default:
+			{
+				ANSICHAR Escaped[8];
+				FCStringAnsi::Snprintf(Escaped, UE_ARRAY_COUNT(Escaped), "\\u%04x", Char);
+				UMCP_AppendUtf8(InOutUtf8, Escaped);
+			}
+			break;
+		}
+	}
+	InOutUtf8.Append(Utf8Text.GetData() + RunStart, Utf8Text.Num() - RunStart);
+	InOutUtf8.Add('"');
+}
+
+FString UMCP_Utf8ToString(TConstArrayView<uint8> Utf8)
+{
+	FUTF8ToTCHAR Convert(reinterpret_cast<const ANSICHAR*>(Utf8.GetData()), Utf8.Num());
+	return FString(Convert.Length(), Convert.Get());
+}
+
+void FUMCP_ReadResourceResult::AppendJsonUtf8(TArray<uint8>& InOutUtf8) const
+{
+	UMCP_AppendUtf8(InOutUtf8, "{\"contents\":[");
+	for (int32 Index = 0; Index < contents.Num(); ++Index)
+	{
+		const FUMCP_ReadResourceResultContent& Content = contents[Index];
+		UMCP_AppendUtf8(InOutUtf8, Index > 0 ? ",{\"uri\":" : "{\"uri\":");
+		UMCP_AppendJsonString(InOutUtf8, Content.uri);
+		UMCP_AppendUtf8(InOutUtf8, ",\"text\":");
+		UMCP_AppendJsonString(InOutUtf8, Content.text);
+		UMCP_AppendUtf8(InOutUtf8, ",\"blob\":");
+		UMCP_AppendJsonString(InOutUtf8, Content.blob);
+		UMCP_AppendUtf8(InOutUtf8, ",\"mimeType\":");
+		UMCP_AppendJsonString(InOutUtf8, Content.mimeType);
+		if (Content.meta.IsValid())
+		{
+			UMCP_AppendUtf8(InOutUtf8, ",\"_meta\":");
+			UMCP_SerializeJsonUtf8(Content.meta.ToSharedRef(), InOutUtf8);
+		}
+		UMCP_AppendUtf8(InOutUtf8, "}");
+	}
+	UMCP_AppendUtf8(InOutUtf8, "]}");
+}
+
+void FUMCP_CallToolResultContent::AppendTextUtf8(TArray<uint8>& InOutUtf8) const
+{
+	if (structuredContent.IsValid())
+	{
+		UMCP_SerializeJsonUtf8(structuredContent.ToSharedRef(), InOutUtf8);
+	}
+	else if (structuredContentUtf8.Num() > 0)
+	{
+		InOutUtf8.Append(structuredContentUtf8);
+	}
+	else if (!text.IsEmpty())
+	{
+		FTCHARToUTF8 Convert(*text, text.Len());
+		InOutUtf8.Append(reinterpret_cast<const uint8*>(Convert.Get()), Convert.Length());
+	}
+}
+
+void FUMCP_CallToolResultContent::AppendJsonUtf8(TArray<uint8>& InOutUtf8, TConstArrayView<uint8> TextUtf8) const
+{
+	UMCP_AppendUtf8(InOutUtf8, "{\"data\":");
+	UMCP_AppendJsonString(InOutUtf8, data);
+	UMCP_AppendUtf8(InOutUtf8, ",\"text\":");
+	UMCP_AppendJsonStringUtf8(InOutUtf8, TextUtf8);
+	UMCP_AppendUtf8(InOutUtf8, ",\"mimetype\":");
+	UMCP_AppendJsonString(InOutUtf8, mimetype);
+	UMCP_AppendUtf8(InOutUtf8, ",\"type\":");
+	UMCP_AppendJsonString(InOutUtf8, type);
+	UMCP_AppendUtf8(InOutUtf8, "}");
+}
+
+void FUMCP_JobContext::ReportProgress(double InProgress, double InTotal, const FString& InMessage)
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+		Progress = InProgress;
+		Total = InTotal;
+		Message = InMessage;
+	}
+	FUMCP_ToolProgress::Report(InProgress, InTotal, InMessage);
+}
+
+void FUMCP_JobContext::GetProgress(double& OutProgress, double& OutTotal, FString& OutMessage) const
+{
+	FScopeLock ScopeLock(&Lock);
+	OutProgress = Progress;
+	OutTotal = Total;
+	OutMessage = Message;
+}
+
+void FUMCP_EventStream::AppendMessage(TConstArrayView<uint8> Utf8JsonMessage)
+{
+	// Condensed JSON never contains a raw newline, so every message fits in a single `data:` line
+	FScopeLock ScopeLock(&Lock);
+	UMCP_AppendUtf8(Body, "event: message\ndata: ");
+	Body.Append(Utf8JsonMessage.GetData(), Utf8JsonMessage.Num());
+	UMCP_AppendUtf8(Body, "\n\n");
+}
+
+bool FUMCP_EventStream::HasEvents() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Body.Num() > 0;
+}
+
+TArray<uint8> FUMCP_EventStream::TakeBody()
+{
+	FScopeLock ScopeLock(&Lock);
+	return MoveTemp(Body);
+}
+
 // Helper function to convert PascalCase to camelCase (for schema generation)
 // Note: USTRUCT properties are already in camelCase, but this is kept for consistency
 // and in case any property names need conversion during schema generation
@@ -305,3 +555,234 @@ TSharedPtr<FJsonValue> UMCP_ExtractDefaultValueFromJson(FProperty* Property, con
 	return DefaultValue;
 }
 
+
+namespace
+{
+	// Everything about a property's schema that doesn't depend on the arguments of UMCP_GenerateJsonSchema
+	struct FUMCP_CachedPropertySchema
+	{
+		FString PropertyName;
+		FString JsonPropertyName;
+		FString MetaDataDescription;
+		TSharedPtr<FJsonObject> Schema; // type, items, additionalProperties and default
+		bool bIsString = false;
+	};
+
+	struct FUMCP_CachedStructSchema
+	{
+		TArray<FUMCP_CachedPropertySchema> Properties;
+	};
+
+	FRWLock GStructSchemasLock;
+	TMap<const UScriptStruct*, TSharedRef<const FUMCP_CachedStructSchema>> GStructSchemas;
+
+	TSharedPtr<FJsonObject> MakePropertyTypeSchema(FProperty* Property, const FString& JsonPropertyName, const TSharedPtr<FJsonObject>& DefaultInstanceJson)
+	{
+		TSharedPtr<FJsonObject> PropertySchema = MakeShared<FJsonObject>();
+
+		// Determine JSON Schema type from Unreal property type
+		if (CastField<FStrProperty>(Property))
+		{
+			PropertySchema->SetStringField(TEXT("type"), TEXT("string"));
+		}
+		else if (CastField<FBoolProperty>(Property))
+		{
+			PropertySchema->SetStringField(TEXT("type"), TEXT("boolean"));
+		}
+		else if (CastField<FIntProperty>(Property) || CastField<FInt64Property>(Property) ||
+		         CastField<FFloatProperty>(Property) || CastField<FDoubleProperty>(Property))
+		{
+			PropertySchema->SetStringField(TEXT("type"), TEXT("number"));
+		}
+		else if (FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property))
+		{
+			PropertySchema->SetStringField(TEXT("type"), TEXT("array"));
+			TSharedPtr<FJsonObject> ItemsSchema = MakeShared<FJsonObject>();
+
+			// Determine item type
+			FProperty* InnerProp = ArrayProp->Inner;
+			if (CastField<FStrProperty>(InnerProp))
+			{
+				ItemsSchema->SetStringField(TEXT("type"), TEXT("string"));
+			}
+			else if (CastField<FIntProperty>(InnerProp) || CastField<FInt64Property>(InnerProp) ||
+			         CastField<FFloatProperty>(InnerProp) || CastField<FDoubleProperty>(InnerProp))
+			{
+				ItemsSchema->SetStringField(TEXT("type"), TEXT("number"));
+			}
+			else if (CastField<FBoolProperty>(InnerProp))
+			{
+				ItemsSchema->SetStringField(TEXT("type"), TEXT("boolean"));
+			}
+			else
+			{
+				// For complex types, default to object
+				ItemsSchema->SetStringField(TEXT("type"), TEXT("object"));
+			}
+
+			PropertySchema->SetObjectField(TEXT("items"), ItemsSchema);
+		}
+		else if (CastField<FMapProperty>(Property))
+		{
+			PropertySchema->SetStringField(TEXT("type"), TEXT("object"));
+			// For maps, we assume string values (common case)
+			TSharedPtr<FJsonObject> AdditionalProps = MakeShared<FJsonObject>();
+			AdditionalProps->SetStringField(TEXT("type"), TEXT("string"));
+			PropertySchema->SetObjectField(TEXT("additionalProperties"), AdditionalProps);
+		}
+		else if (CastField<FStructProperty>(Property))
+		{
+			// Nested structs are only marked as objects; their default value carries the shape
+			PropertySchema->SetStringField(TEXT("type"), TEXT("object"));
+
+			if (DefaultInstanceJson.IsValid() && DefaultInstanceJson->HasTypedField<EJson::Object>(JsonPropertyName))
+			{
+				TSharedPtr<FJsonObject> NestedDefaultJson = DefaultInstanceJson->GetObjectField(JsonPropertyName);
+				if (NestedDefaultJson.IsValid() && NestedDefaultJson->Values.Num() > 0)
+				{
+					// This is valid JSON Schema - the default can be an object
+					PropertySchema->SetField(TEXT("default"), MakeShared<FJsonValueObject>(NestedDefaultJson));
+				}
+			}
+		}
+		else
+		{
+			// Default to object for unknown types
+			PropertySchema->SetStringField(TEXT("type"), TEXT("object"));
+		}
+
+		// Extract and add default value from JSON if available
+		if (DefaultInstanceJson.IsValid())
+		{
+			TSharedPtr<FJsonValue> DefaultValue = UMCP_ExtractDefaultValueFromJson(Property, DefaultInstanceJson);
+			if (DefaultValue.IsValid())
+			{
+				PropertySchema->SetField(TEXT("default"), DefaultValue);
+			}
+		}
+		return PropertySchema;
+	}
+
+	TSharedRef<const FUMCP_CachedStructSchema> BuildStructSchema(const UScriptStruct* Struct)
+	{
+		UMCP_TRACE_SCOPE(UMCP_BuildStructSchema);
+
+		// A default-constructed instance, converted to JSON for default value extraction
+		FStructOnScope DefaultInstance(Struct);
+		TSharedPtr<FJsonObject> DefaultInstanceJson = MakeShared<FJsonObject>();
+		if (!FUMCP_StructSerializer::WriteJsonObject(Struct, DefaultInstance.GetStructMemory(), *DefaultInstanceJson))
+		{
+			DefaultInstanceJson = nullptr; // If serialization fails, just skip defaults
+		}
+
+		TSharedRef<FUMCP_CachedStructSchema> StructSchema = MakeShared<FUMCP_CachedStructSchema>();
+		for (TFieldIterator<FProperty> It(Struct); It; ++It)
+		{
+			FProperty* Property = *It;
+			if (!Property)
+			{
+				continue;
+			}
+
+			FUMCP_CachedPropertySchema& PropertySchema = StructSchema->Properties.AddDefaulted_GetRef();
+			PropertySchema.PropertyName = Property->GetName();
+			// Convert to camelCase to match JSON output (Unreal's JSON converter standardizes case to camelCase)
+			PropertySchema.JsonPropertyName = UMCP_PropertyNameToJsonName(PropertySchema.PropertyName);
+			PropertySchema.bIsString = CastField<FStrProperty>(Property) != nullptr;
+			PropertySchema.MetaDataDescription = Property->GetMetaData(TEXT("ToolTip"));
+			if (PropertySchema.MetaDataDescription.IsEmpty())
+			{
+				PropertySchema.MetaDataDescription = Property->GetMetaData(TEXT("Description"));
+			}
+			PropertySchema.Schema = MakePropertyTypeSchema(Property, PropertySchema.JsonPropertyName, DefaultInstanceJson);
+		}
+		return StructSchema;
+	}
+
+	TSharedRef<const FUMCP_CachedStructSchema> GetStructSchema(const UScriptStruct* Struct)
+	{
+		{
+			FReadScopeLock ReadLock(GStructSchemasLock);
+			if (const TSharedRef<const FUMCP_CachedStructSchema>* Found = GStructSchemas.Find(Struct))
+			{
+				return *Found;
+			}
+		}
+
+		FWriteScopeLock WriteLock(GStructSchemasLock);
+		if (const TSharedRef<const FUMCP_CachedStructSchema>* Found = GStructSchemas.Find(Struct))
+		{
+			return *Found;
+		}
+		return GStructSchemas.Add(Struct, BuildStructSchema(Struct));
+	}
+}
+
+TSharedPtr<FJsonObject> UMCP_GenerateJsonSchema(const UScriptStruct* Struct, const TMap<FString, FString>& PropertyDescriptions, const TArray<FString>& RequiredFields, const TMap<FString, TArray<FString>>& EnumValues)
+{
+	if (!Struct)
+	{
+		return nullptr;
+	}
+
+	const TSharedRef<const FUMCP_CachedStructSchema> StructSchema = GetStructSchema(Struct);
+
+	TSharedPtr<FJsonObject> Schema = MakeShared<FJsonObject>();
+	Schema->SetStringField(TEXT("type"), TEXT("object"));
+
+	TSharedPtr<FJsonObject> Properties = MakeShared<FJsonObject>();
+	for (const FUMCP_CachedPropertySchema& CachedProperty : StructSchema->Properties)
+	{
+		// Shallow copy: nested values are shared with the cache, only this level gets the per-tool fields
+		TSharedPtr<FJsonObject> PropertySchema = MakeShared<FJsonObject>();
+		PropertySchema->Values = CachedProperty.Schema->Values;
+
+		// Check if this property has enum values (use original PropertyName for lookup)
+		const TArray<FString>* PropertyEnumValues = CachedProperty.bIsString ? EnumValues.Find(CachedProperty.PropertyName) : nullptr;
+		if (PropertyEnumValues)
+		{
+			TArray<TSharedPtr<FJsonValue>> EnumArray;
+			for (const FString& EnumValue : *PropertyEnumValues)
+			{
+				EnumArray.Add(MakeShared<FJsonValueString>(EnumValue));
+			}
+			PropertySchema->SetArrayField(TEXT("enum"), EnumArray);
+		}
+
+		// Add description - prefer provided description, then metadata, then empty
+		const FString* ProvidedDescription = PropertyDescriptions.Find(CachedProperty.PropertyName);
+		const FString& Description = ProvidedDescription ? *ProvidedDescription : CachedProperty.MetaDataDescription;
+		if (!Description.IsEmpty())
+		{
+			PropertySchema->SetStringField(TEXT("description"), Description);
+		}
+
+		// Use camelCase property name in schema to match JSON output
+		Properties->SetObjectField(CachedProperty.JsonPropertyName, PropertySchema);
+	}
+	Schema->SetObjectField(TEXT("properties"), Properties);
+
+	// Use provided required fields, or treat all fields as required
+	TArray<TSharedPtr<FJsonValue>> RequiredFieldsJson;
+	if (RequiredFields.Num() > 0)
+	{
+		for (const FString& RequiredField : RequiredFields)
+		{
+			// Convert required field names to camelCase to match JSON output
+			RequiredFieldsJson.Add(MakeShared<FJsonValueString>(UMCP_PropertyNameToJsonName(RequiredField)));
+		}
+	}
+	else
+	{
+		for (const FUMCP_CachedPropertySchema& CachedProperty : StructSchema->Properties)
+		{
+			RequiredFieldsJson.Add(MakeShared<FJsonValueString>(CachedProperty.JsonPropertyName));
+		}
+	}
+	if (RequiredFieldsJson.Num() > 0)
+	{
+		Schema->SetArrayField(TEXT("required"), RequiredFieldsJson);
+	}
+
+	return Schema;
+}
@@ -132,14 +132,21 @@ void FUMCP_UriTemplateComponent::FromVarList(FString VarList, FUMCP_UriTemplateC
 
 
 FString FUMCP_UriTemplateComponent::Expand(const TMap<FString, TArray<FString>>& Values) const
+{
+	TStringBuilder<256> Builder;
+	Expand(Values, Builder);
+	return FString(Builder.ToView());
+}
+
+void FUMCP_UriTemplateComponent::Expand(const TMap<FString, TArray<FString>>& Values, FStringBuilderBase& OutBuilder) const
 {
 	if (Type == EUMCP_UriTemplateComponentType::Literal)
 	{
-		return Literal;
+		OutBuilder.Append(Literal);
+		return;
 	}
 
 	// TODO
-	return FString();
 }
 
 FUMCP_UriTemplate::FUMCP_UriTemplate(FString InUriTemplateStr)
@@ -194,9 +201,10 @@ void FUMCP_UriTemplate::TryParseTemplate()
 	}
 }
 
-bool FUMCP_UriTemplate::FindMatch(const FString& Uri, FUMCP_UriTemplateMatch& OutMatch) const
+bool FUMCP_UriTemplate::FindMatch(FStringView Uri, FUMCP_UriTemplateMatchView& OutMatch) const
 {
-    OutMatch.Uri = Uri; // Store the original URI in the match result
+    OutMatch.Reset();
+    OutMatch.Uri = Uri;
     FStringView UriRemaining = Uri;
 
     for (auto Itr = Components.CreateConstIterator(); Itr; ++Itr)
@@ -287,37 +295,60 @@ bool FUMCP_UriTemplate::FindMatch(const FString& Uri, FUMCP_UriTemplateMatch& Ou
 
         ExpressionToMatchThisComponent = ExpressionToMatchThisComponent.Left(CurrentMatchEndPosition);
 
-    	TArray<FString> MatchedVars;
+		// Captures are recorded as views; nothing is copied or decoded until a handler asks for a value
+		bool bVarsMatched = true;
+		int32 TokenIndex = 0;
 		UE::String::ParseTokens(ExpressionToMatchThisComponent, CurrentComponent.GetSeparatorChar(),
-			[&MatchedVars](FStringView Token) { MatchedVars.Emplace(Token); });
-
-    	for (auto VarItr = MatchedVars.CreateConstIterator(); VarItr; ++VarItr)
-    	{
-    		FString VarName, VarValue;
-    		const bool bIsNamed = (*VarItr).Split(TEXT("="), &VarName, &VarValue, ESearchCase::Type::CaseSensitive);
-    		if (bIsNamed)
-    		{
-    			const FUMCP_UriTemplateComponentVarSpec* VarSpec = CurrentComponent.VarSpecs.FindByPredicate([&VarName](const FUMCP_UriTemplateComponentVarSpec& VarSpec)
-    			{
-    				return VarSpec.Val == VarName;
-    			});
-    			if (!VarSpec)
-    			{
-    				return false;
-    			}
-
-    			// TODO
-    			return false;
-    		}
-
-    		if (!CurrentComponent.VarSpecs.IsValidIndex(VarItr.GetIndex()))
-    		{
-    			return false;
-    		}
-
-    		const auto& VarSpec = CurrentComponent.VarSpecs[VarItr.GetIndex()];
-    		OutMatch.Variables.FindOrAdd(VarSpec.Val).Add(FPlatformHttp::UrlDecode(*VarItr));
-    	}
+			[&CurrentComponent, &OutMatch, &bVarsMatched, &TokenIndex](FStringView Token)
+			{
+				if (!bVarsMatched)
+				{
+					return;
+				}
+
+				if (CurrentComponent.AllowsNamedVars())
+				{
+					// name=value pairs may come in any order and any of them may be left out, but every name must be declared
+					if (Token.IsEmpty())
+					{
+						return;
+					}
+					int32 EqualsIndex = INDEX_NONE;
+					const FStringView Name = Token.FindChar(TEXT('='), EqualsIndex) ? Token.Left(EqualsIndex) : Token;
+					const FStringView Value = EqualsIndex != INDEX_NONE ? Token.RightChop(EqualsIndex + 1) : FStringView();
+					const FUMCP_UriTemplateComponentVarSpec* VarSpec = CurrentComponent.VarSpecs.FindByPredicate([Name](const FUMCP_UriTemplateComponentVarSpec& Spec)
+					{
+						return Name.Equals(Spec.Val, ESearchCase::CaseSensitive);
+					});
+					if (!VarSpec)
+					{
+						bVarsMatched = false;
+						return;
+					}
+					OutMatch.Captures.Add({ VarSpec->Val, Value });
+					return;
+				}
+
+				int32 EqualsIndex;
+				if (Token.FindChar(TEXT('='), EqualsIndex))
+				{
+					bVarsMatched = false;
+					return;
+				}
+
+				if (!CurrentComponent.VarSpecs.IsValidIndex(TokenIndex))
+				{
+					bVarsMatched = false;
+					return;
+				}
+
+				OutMatch.Captures.Add({ CurrentComponent.VarSpecs[TokenIndex].Val, Token });
+				++TokenIndex;
+			});
+		if (!bVarsMatched)
+		{
+			return false;
+		}
 
         UriRemaining.RightChopInline(CurrentMatchEndPosition); 
     } 
@@ -325,12 +356,151 @@ bool FUMCP_UriTemplate::FindMatch(const FString& Uri, FUMCP_UriTemplateMatch& Ou
     return UriRemaining.IsEmpty();
 }
 
+bool FUMCP_UriTemplate::FindMatch(const FString& Uri, FUMCP_UriTemplateMatch& OutMatch) const
+{
+	FUMCP_UriTemplateMatchView MatchView;
+	if (!FindMatch(FStringView(Uri), MatchView))
+	{
+		return false;
+	}
+	MatchView.ToMatch(OutMatch);
+	return true;
+}
+
+FStringView FUMCP_UriTemplate::GetLiteralPrefix() const
+{
+	if (Components.IsEmpty() || Components[0].Type != EUMCP_UriTemplateComponentType::Literal)
+	{
+		return FStringView();
+	}
+	return Components[0].Literal;
+}
+
 FString FUMCP_UriTemplate::Expand(const TMap<FString, TArray<FString>>& Values) const
 {
-	FString Result;
+	TStringBuilder<256> Builder;
+	Expand(Values, Builder);
+	return FString(Builder.ToView());
+}
+
+void FUMCP_UriTemplate::Expand(const TMap<FString, TArray<FString>>& Values, FStringBuilderBase& OutBuilder) const
+{
 	for (const auto& Component : Components)
 	{
-		Result += Component.Expand(Values);
+		Component.Expand(Values, OutBuilder);
+	}
+}
+
+void FUMCP_UriTemplateMatchView::Reset()
+{
+	Uri.Reset();
+	Captures.Reset();
+}
+
+bool FUMCP_UriTemplateMatchView::GetRawValue(FStringView Name, FStringView& OutRawValue) const
+{
+	for (const FCapture& Capture : Captures)
+	{
+		if (Capture.Name.Equals(Name, ESearchCase::CaseSensitive))
+		{
+			OutRawValue = Capture.RawValue;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FUMCP_UriTemplateMatchView::GetValue(FStringView Name, FString& OutValue) const
+{
+	FStringView RawValue;
+	if (!GetRawValue(Name, RawValue))
+	{
+		return false;
+	}
+	OutValue = FPlatformHttp::UrlDecode(FString(RawValue));
+	return true;
+}
+
+TArray<FString> FUMCP_UriTemplateMatchView::GetValues(FStringView Name) const
+{
+	TArray<FString> Values;
+	for (const FCapture& Capture : Captures)
+	{
+		if (Capture.Name.Equals(Name, ESearchCase::CaseSensitive))
+		{
+			Values.Add(FPlatformHttp::UrlDecode(FString(Capture.RawValue)));
+		}
+	}
+	return Values;
+}
+
+void FUMCP_UriTemplateMatchView::ToMatch(FUMCP_UriTemplateMatch& OutMatch) const
+{
+	OutMatch.Uri = FString(Uri);
+	for (const FCapture& Capture : Captures)
+	{
+		OutMatch.Variables.FindOrAdd(FString(Capture.Name)).Add(FPlatformHttp::UrlDecode(FString(Capture.RawValue)));
+	}
+}
+
+void FUMCP_UriTemplateRouter::Add(const FUMCP_UriTemplate& UriTemplate, int32 TemplateIndex)
+{
+	if (Nodes.IsEmpty())
+	{
+		Nodes.AddDefaulted();
+	}
+
+	// Nodes may reallocate while the path is extended, so walk by index
+	int32 NodeIndex = 0;
+	for (TCHAR Char : UriTemplate.GetLiteralPrefix())
+	{
+		const TPair<TCHAR, int32>* Child = Nodes[NodeIndex].Children.FindByPredicate([Char](const TPair<TCHAR, int32>& Pair) { return Pair.Key == Char; });
+		if (Child)
+		{
+			NodeIndex = Child->Value;
+			continue;
+		}
+		const int32 NewNodeIndex = Nodes.AddDefaulted();
+		Nodes[NodeIndex].Children.Emplace(Char, NewNodeIndex);
+		NodeIndex = NewNodeIndex;
+	}
+	Nodes[NodeIndex].TemplateIndices.Add(TemplateIndex);
+}
+
+void FUMCP_UriTemplateRouter::Reset()
+{
+	Nodes.Reset();
+}
+
+bool FUMCP_UriTemplateRouter::VisitCandidates(FStringView Uri, TFunctionRef<bool(int32 TemplateIndex)> Visitor) const
+{
+	if (Nodes.IsEmpty())
+	{
+		return false;
+	}
+
+	// Every node on the path is a literal prefix of the URI; the deepest ones are the most specific templates
+	TArray<int32, TInlineAllocator<64>> Path;
+	Path.Add(0);
+	for (TCHAR Char : Uri)
+	{
+		const TPair<TCHAR, int32>* Child = Nodes[Path.Last()].Children.FindByPredicate([Char](const TPair<TCHAR, int32>& Pair) { return Pair.Key == Char; });
+		if (!Child)
+		{
+			break;
+		}
+		Path.Add(Child->Value);
+	}
+
+	for (int32 PathIndex = Path.Num() - 1; PathIndex >= 0; --PathIndex)
+	{
+		for (int32 TemplateIndex : Nodes[Path[PathIndex]].TemplateIndices)
+		{
+			if (Visitor(TemplateIndex))
+			{
+				return true;
+			}
+		}
 	}
-	return Result;
+	return false;
 }
@@ -6,6 +6,7 @@
 #include "UMCP_CommonTools.h"
 #include "UMCP_AssetTools.h"
 #include "UMCP_BlueprintTools.h"
+#include "UMCP_JobTools.h"
 
 // Define the log category
 DEFINE_LOG_CATEGORY(LogUnrealMCPServer);
@@ -13,24 +14,55 @@ DEFINE_LOG_CATEGORY(LogUnrealMCPServer);
 void FUnrealMCPServerModule::StartupModule()
 {
 	UE_LOG(LogUnrealMCPServer, Warning, TEXT("FUnrealMCPServerModule has started"));
+	if (IsRunningCommandlet())
+	{
+		// Commandlets don't tick the editor, so nothing would answer; -run=UnrealMCPServer starts a server of its own
+		UE_LOG(LogUnrealMCPServer, Log, TEXT("FUnrealMCPServerModule: Not starting the server in a commandlet"));
+		return;
+	}
+	StartServer(FUMCP_Server::DefaultHttpServerPort, false);
+}
+
+void FUnrealMCPServerModule::ShutdownModule()
+{
+	StopServer();
+	UE_LOG(LogUnrealMCPServer, Warning, TEXT("FUnrealMCPServerModule has shut down"));
+}
+
+FUnrealMCPServerModule& FUnrealMCPServerModule::Get()
+{
+	return FModuleManager::LoadModuleChecked<FUnrealMCPServerModule>(TEXT("UnrealMCPServer"));
+}
+
+bool FUnrealMCPServerModule::StartServer(uint32 Port, bool bHeadless)
+{
+	StopServer();
+	const double StartTime = FPlatformTime::Seconds();
 	CommonTools = MakeUnique<FUMCP_CommonTools>();
 	AssetTools = MakeUnique<FUMCP_AssetTools>();
 	BlueprintTools = MakeUnique<FUMCP_BlueprintTools>();
+	JobTools = MakeUnique<FUMCP_JobTools>();
 	CommonResources = MakeUnique<FUMCP_CommonResources>();
 	CommonPrompts = MakeUnique<FUMCP_CommonPrompts>();
 	Server = MakeUnique<FUMCP_Server>();
-	if (Server)
-	{
-		CommonTools->Register(Server.Get());
-		AssetTools->Register(Server.Get());
-		BlueprintTools->Register(Server.Get());
-		CommonResources->Register(Server.Get());
-		CommonPrompts->Register(Server.Get());
-		Server->StartServer();
-	}
+
+	// Tool schemas are generated on the first tools/list, so registering tools should stay cheap
+	CommonTools->Register(Server.Get(), !bHeadless);
+	AssetTools->Register(Server.Get());
+	BlueprintTools->Register(Server.Get());
+	JobTools->Register(Server.Get());
+	const double ToolsTime = FPlatformTime::Seconds();
+	CommonResources->Register(Server.Get());
+	CommonPrompts->Register(Server.Get());
+	const double ResourcesTime = FPlatformTime::Seconds();
+	const bool bStarted = Server->StartServer(Port);
+	const double EndTime = FPlatformTime::Seconds();
+	UE_LOG(LogUnrealMCPServer, Log, TEXT("FUnrealMCPServerModule started%s in %.2f ms (tools %.2f ms, resources and prompts %.2f ms, server %.2f ms)"),
+		bHeadless ? TEXT(" headless") : TEXT(""), (EndTime - StartTime) * 1000.0, (ToolsTime - StartTime) * 1000.0, (ResourcesTime - ToolsTime) * 1000.0, (EndTime - ResourcesTime) * 1000.0);
+	return bStarted;
 }
 
-void FUnrealMCPServerModule::ShutdownModule()
+void FUnrealMCPServerModule::StopServer()
 {
 	if (Server)
 	{
@@ -45,6 +77,10 @@ void FUnrealMCPServerModule::ShutdownModule()
 	{
 		CommonPrompts.Reset();
 	}
+	if (JobTools)
+	{
+		JobTools.Reset();
+	}
 	if (BlueprintTools)
 	{
 		BlueprintTools.Reset();
@@ -57,7 +93,6 @@ void FUnrealMCPServerModule::ShutdownModule()
 	{
 		CommonTools.Reset();
 	}
-	UE_LOG(LogUnrealMCPServer, Warning, TEXT("FUnrealMCPServerModule has shut down"));
 }
 
 IMPLEMENT_MODULE(FUnrealMCPServerModule, UnrealMCPServer)
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Async/Future.h"
+#include <atomic>
+
+// Snapshot of FUMCP_AssetNameIndex for monitoring
+struct FUMCP_AssetNameIndexStats
+{
+	bool bReady = false;
+	int32 NumAssets = 0;
+	int32 NumTrigrams = 0; // Distinct trigrams over all fields
+	int64 MemoryBytes = 0;
+	double BuildSeconds = 0.0;
+};
+
+// Case-insensitive trigram index over the package name, asset name and ParentClass tag of every asset in the
+// AssetRegistry, so substring and glob searches over the whole project only check the assets that contain every
+// trigram of the pattern's literal runs instead of converting each FAssetData name to an FString.
+// Built on a background thread once the AssetRegistry has finished its initial scan (OnFilesLoaded), then kept up to
+// date by OnAssetAdded/OnAssetRemoved/OnAssetRenamed/OnAssetUpdated. Changes made while the build runs are replayed
+// onto it when it finishes. Thread-safe; queries come from tools running on the task graph.
+class UNREALMCPSERVER_API FUMCP_AssetNameIndex
+{
+public:
+	enum class EField : uint8
+	{
+		PackageName,
+		AssetName,
+		ParentClass,
+		Num
+	};
+
+	~FUMCP_AssetNameIndex();
+
+	// Game thread only
+	void Initialize();
+	void Shutdown();
+
+	// False until the first build has finished; callers fall back to scanning AssetRegistry results
+	bool IsReady() const { return bReady.load(); }
+
+	// Adds the package names of the assets whose Field matches Pattern, ignoring case: a wildcard match if Pattern
+	// contains * or ?, a substring match otherwise. Matches are exact, not just candidates. False if not ready.
+	bool FindPackages(EField Field, const FString& Pattern, TSet<FName>& OutPackageNames) const;
+
+	FUMCP_AssetNameIndexStats GetStats() const;
+
+private:
+	struct FEntry
+	{
+		FSoftObjectPath ObjectPath;
+		FName PackageName;
+		FString Text[(int32)EField::Num]; // Lowercase; empty once the asset is removed
+		bool bRemoved = false;
+	};
+
+	// Everything a build produces, so it can be made off the lock and swapped in
+	struct FIndexData
+	{
+		TArray<FEntry> Entries;
+		TMap<FSoftObjectPath, int32> EntryIndexByObjectPath;
+		TMap<uint64, TArray<int32>> Postings[(int32)EField::Num]; // Trigram to ascending entry indices
+		int32 NumRemoved = 0;
+
+		void AddAsset(const FAssetData& AssetData);
+		void AddEntry(FEntry&& Entry);
+		void RemoveAsset(const FSoftObjectPath& ObjectPath);
+		void Compact(); // Drops removed entries once they make up half of the index
+	};
+
+	struct FPendingChange
+	{
+		FSoftObjectPath RemovedObjectPath; // Set for removals and the old path of renames
+		TOptional<FAssetData> AddedAsset; // Set for additions, updates and the new path of renames
+	};
+
+	void StartBuild();
+	void OnAssetAdded(const FAssetData& AssetData);
+	void OnAssetRemoved(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void ApplyChange(FPendingChange&& Change);
+	void ApplyChangeLocked(const FPendingChange& Change);
+
+	mutable FRWLock Lock;
+	FIndexData Data;
+	TArray<FPendingChange> PendingChanges; // Changes made while a build runs
+	bool bBuilding = false;
+	std::atomic<bool> bReady{ false };
+	std::atomic<bool> bCancelBuild{ false };
+	TFuture<void> BuildFuture;
+	double BuildSeconds = 0.0;
+
+	FDelegateHandle FilesLoadedHandle;
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle AssetUpdatedHandle;
+};
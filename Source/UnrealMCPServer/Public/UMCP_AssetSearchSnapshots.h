@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Dom/JsonObject.h"
+#include <atomic>
+
+// Filtered AssetRegistry results of one search, shared by every page read through its cursor
+struct FUMCP_AssetSearchSnapshot
+{
+	uint32 Id = 0;
+	uint32 RegistryGeneration = 0;
+	FString ToolName;
+	TSharedPtr<FJsonObject> Arguments; // Arguments of the call that ran the search, for tools that need them to build a page
+	TArray<FAssetData> Assets;
+};
+
+// Server side snapshots behind the nextCursor of search_assets and search_blueprints, so a follow-up page costs
+// O(page size) instead of running the AssetRegistry query and post-filters again.
+// Snapshots expire after a TTL, are evicted least recently used first beyond a memory budget, and are rejected once the
+// registry generation (bumped by AssetRegistry add/remove/rename/update events) has moved on since the search ran.
+// Thread-safe; the searches run on the task graph.
+class UNREALMCPSERVER_API FUMCP_AssetSearchSnapshots
+{
+public:
+	~FUMCP_AssetSearchSnapshots();
+
+	// Game thread only. A budget of 0 disables snapshots; searches then return no nextCursor.
+	void Initialize(int64 InMemoryBudgetBytes, double InTimeToLiveSeconds);
+	void Shutdown();
+
+	// Read before running the query the snapshot is made from, so a change during the query invalidates it
+	uint32 GetRegistryGeneration() const { return RegistryGeneration.load(); }
+
+	// Keeps the results and returns the cursor of the page starting at Offset. Empty if the snapshot doesn't fit the budget.
+	FString CreateSnapshot(const FString& ToolName, TSharedPtr<FJsonObject> Arguments, uint32 InRegistryGeneration, TArray<FAssetData>&& Assets, int32 Offset);
+
+	// Null (with OutError set) if the cursor is malformed, expired, from another tool or older than the registry
+	TSharedPtr<const FUMCP_AssetSearchSnapshot> FindSnapshot(const FString& ToolName, const FString& Cursor, int32& OutOffset, FString& OutError);
+
+	static FString MakeCursor(const FUMCP_AssetSearchSnapshot& Snapshot, int32 Offset);
+
+private:
+	struct FEntry
+	{
+		TSharedPtr<const FUMCP_AssetSearchSnapshot> Snapshot;
+		int64 NumBytes = 0;
+		double LastAccessTime = 0.0;
+	};
+
+	void BumpRegistryGeneration() { ++RegistryGeneration; }
+	void RemoveExpiredLocked(double Now);
+
+	mutable FCriticalSection Lock;
+	TMap<uint32, FEntry> Entries;
+	uint32 NextId = 1;
+	int64 MemoryBytes = 0;
+	int64 MemoryBudgetBytes = 0;
+	double TimeToLiveSeconds = 0.0;
+	std::atomic<uint32> RegistryGeneration{ 0 };
+
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle AssetUpdatedHandle;
+};
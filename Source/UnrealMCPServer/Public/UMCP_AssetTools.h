@@ -56,6 +56,12 @@ struct UNREALMCPSERVER_API FUMCP_BatchExportAssetsParams
 
 	UPROPERTY()
 	FString format = TEXT("T3D");
+
+	UPROPERTY()
+	FString outputMode = TEXT("files"); // "files" (one file per asset) or "ndjson" (one record per asset in a single file)
+
+	UPROPERTY()
+	FString outputFileName; // ndjson mode only; defaults to "export.ndjson"
 };
 
 // BatchExportAssets output
@@ -79,6 +85,12 @@ struct UNREALMCPSERVER_API FUMCP_BatchExportAssetsResult
 	UPROPERTY()
 	TArray<FString> failedPaths; // List of asset paths that failed to export
 
+	UPROPERTY()
+	FString outputFile; // ndjson mode: the file holding every record
+
+	UPROPERTY()
+	FString indexFile; // ndjson mode: one {objectPath, offset, length} line per record of outputFile
+
 	UPROPERTY()
 	FString error; // Error message if bSuccess is false
 };
@@ -165,6 +177,69 @@ struct UNREALMCPSERVER_API FUMCP_ImportAssetResult
 	FString error;
 };
 
+// BatchImportAssets tool parameters
+USTRUCT()
+struct UNREALMCPSERVER_API FUMCP_BatchImportAssetsParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FUMCP_ImportAssetParams> assets; // Each takes the arguments of import_asset
+
+	UPROPERTY()
+	bool bSave = true; // Save the packages of the imported assets once every import is done
+};
+
+// Outcome of one entry of BatchImportAssets, in request order
+USTRUCT()
+struct UNREALMCPSERVER_API FUMCP_BatchImportAssetEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString packagePath; // Full object path of the asset
+
+	UPROPERTY()
+	bool bSuccess = false;
+
+	UPROPERTY()
+	bool bSaved = false;
+
+	UPROPERTY()
+	FString importedObject;
+
+	UPROPERTY()
+	FString error;
+};
+
+// BatchImportAssets output
+USTRUCT()
+struct UNREALMCPSERVER_API FUMCP_BatchImportAssetsResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	bool bSuccess = false; // At least one asset was imported; see results for each one
+
+	UPROPERTY()
+	int32 importedCount = 0;
+
+	UPROPERTY()
+	int32 failedCount = 0;
+
+	UPROPERTY()
+	int32 savedCount = 0;
+
+	UPROPERTY()
+	int32 skippedCount = 0; // Not attempted because the job was cancelled before the batch started
+
+	UPROPERTY()
+	TArray<FUMCP_BatchImportAssetEntry> results;
+
+	UPROPERTY()
+	FString error;
+};
+
 // QueryAsset tool parameters
 USTRUCT()
 struct UNREALMCPSERVER_API FUMCP_QueryAssetParams
@@ -232,6 +307,9 @@ struct UNREALMCPSERVER_API FUMCP_SearchAssetsParams
 
 	UPROPERTY()
 	int32 offset = 0;  // Offset for paging
+
+	UPROPERTY()
+	FString cursor; // nextCursor of a previous page; replaces offset and the search filters
 };
 
 // GetAssetDependencies tool parameters
@@ -310,6 +388,175 @@ struct UNREALMCPSERVER_API FUMCP_GetAssetReferencesResult
 	FString error; // Error message if bSuccess is false
 };
 
+// BatchQueryAssets tool parameters
+USTRUCT()
+struct UNREALMCPSERVER_API FUMCP_BatchQueryAssetsParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FString> assetPaths;
+
+	UPROPERTY()
+	bool bIncludeTags = false;
+};
+
+// Tags of one asset in FUMCP_BatchQueryAssetsResult
+USTRUCT()
+struct UNREALMCPSERVER_API FUMCP_AssetTagValues
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TMap<FString, FString> values;
+};
+
+// BatchQueryAssets output: one column per field, row i describes assetPaths[i]
+USTRUCT()
+struct UNREALMCPSERVER_API FUMCP_BatchQueryAssetsResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FString> assetPaths; // The queried paths, in request order
+
+	UPROPERTY()
+	TArray<bool> exists;
+
+	UPROPERTY()
+	TArray<FString> assetName; // Empty where the asset doesn't exist
+
+	UPROPERTY()
+	TArray<FString> packagePath;
+
+	UPROPERTY()
+	TArray<FString> classPath;
+
+	UPROPERTY()
+	TArray<FString> objectPath;
+
+	UPROPERTY()
+	TArray<FUMCP_AssetTagValues> tags; // Only filled if bIncludeTags is true
+
+	UPROPERTY()
+	int32 count = 0; // Number of assets that exist
+};
+
+// BatchGetAssetDependencies tool parameters
+USTRUCT()
+struct UNREALMCPSERVER_API FUMCP_BatchGetAssetDependenciesParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FString> assetPaths;
+
+	UPROPERTY()
+	bool bIncludeHardDependencies = true;
+
+	UPROPERTY()
+	bool bIncludeSoftDependencies = false;
+};
+
+// BatchGetAssetReferences tool parameters
+USTRUCT()
+struct UNREALMCPSERVER_API FUMCP_BatchGetAssetReferencesParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FString> assetPaths;
+
+	UPROPERTY()
+	bool bIncludeHardReferences = true;
+
+	UPROPERTY()
+	bool bIncludeSoftReferences = false;
+};
+
+// BatchGetAssetDependencies and BatchGetAssetReferences output. Linked asset paths are stored once in paths; the links
+// of assetPaths[i] are indices[offsets[i]] up to indices[offsets[i + 1]], indices into paths.
+USTRUCT()
+struct UNREALMCPSERVER_API FUMCP_BatchAssetLinksResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FString> assetPaths; // The queried paths, in request order
+
+	UPROPERTY()
+	TArray<bool> exists;
+
+	UPROPERTY()
+	TArray<int32> offsets; // assetPaths.Num() + 1 entries
+
+	UPROPERTY()
+	TArray<int32> indices;
+
+	UPROPERTY()
+	TArray<FString> paths; // Distinct linked asset paths
+
+	UPROPERTY()
+	int32 count = 0; // Number of links over all assets
+};
+
+// ExportDependencyGraph tool parameters
+USTRUCT()
+struct UNREALMCPSERVER_API FUMCP_ExportDependencyGraphParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int64 sinceGeneration = 0; // Generation of a snapshot the client has; 0 asks for a full snapshot
+};
+
+// A package whose dependencies changed, in FUMCP_ExportDependencyGraphResult
+USTRUCT()
+struct UNREALMCPSERVER_API FUMCP_DependencyGraphPackage
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString packageName;
+
+	UPROPERTY()
+	TArray<FString> dependencies; // Package names
+
+	UPROPERTY()
+	TArray<int32> edgeFlags; // Per dependency: 1 hard, 2 soft, 3 both
+};
+
+// ExportDependencyGraph output
+USTRUCT()
+struct UNREALMCPSERVER_API FUMCP_ExportDependencyGraphResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int64 generation = 0;
+
+	UPROPERTY()
+	bool bDelta = false; // Whether this is a delta since sinceGeneration rather than a full snapshot file
+
+	UPROPERTY()
+	FString filePath; // Full snapshot only
+
+	UPROPERTY()
+	int64 fileBytes = 0;
+
+	UPROPERTY()
+	int32 packageCount = 0;
+
+	UPROPERTY()
+	int32 edgeCount = 0;
+
+	UPROPERTY()
+	TArray<FUMCP_DependencyGraphPackage> changedPackages; // Delta only: packages added or changed since sinceGeneration
+
+	UPROPERTY()
+	TArray<FString> removedPackages; // Delta only: packages that no longer have assets
+};
+
 // GetAssetDependencyTree tool parameters
 USTRUCT()
 struct UNREALMCPSERVER_API FUMCP_GetAssetDependencyTreeParams
@@ -327,6 +574,12 @@ struct UNREALMCPSERVER_API FUMCP_GetAssetDependencyTreeParams
 
 	UPROPERTY()
 	bool bIncludeSoftDependencies = false;
+
+	UPROPERTY()
+	FString outputMode = TEXT("tree"); // "tree" (one node per path, shared dependencies repeated) or "dag" (one node per package)
+
+	UPROPERTY()
+	int32 maxNodes = 0; // Stop adding nodes beyond this many; 0 means no limit
 };
 
 // Dependency tree node structure
@@ -345,6 +598,25 @@ struct UNREALMCPSERVER_API FUMCP_AssetDependencyNode
 	TArray<FString> dependencies; // Direct dependencies (asset paths)
 };
 
+// Dependency graph node for outputMode "dag"
+USTRUCT()
+struct UNREALMCPSERVER_API FUMCP_AssetDependencyDagNode
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString assetPath;
+
+	UPROPERTY()
+	int32 depth = 0; // Shortest distance from the root
+
+	UPROPERTY()
+	TArray<int32> dependencies; // Indices into nodes of the direct dependencies
+
+	UPROPERTY()
+	bool bDependenciesOmitted = false; // The dependencies weren't (all) listed because of maxDepth or maxNodes
+};
+
 // GetAssetDependencyTree output
 USTRUCT()
 struct UNREALMCPSERVER_API FUMCP_GetAssetDependencyTreeResult
@@ -360,12 +632,18 @@ struct UNREALMCPSERVER_API FUMCP_GetAssetDependencyTreeResult
 	UPROPERTY()
 	TArray<FUMCP_AssetDependencyNode> tree; // Flat list of nodes with depth information
 
+	UPROPERTY()
+	TArray<FUMCP_AssetDependencyDagNode> nodes; // outputMode "dag": unique nodes in breadth-first order, the root first
+
 	UPROPERTY()
 	int32 totalNodes = 0;
 
 	UPROPERTY()
 	int32 maxDepthReached = 0;
 
+	UPROPERTY()
+	bool bTruncated = false; // maxNodes was reached before the traversal finished
+
 	UPROPERTY()
 	FString error; // Error message if bSuccess is false
 };
@@ -373,18 +651,24 @@ struct UNREALMCPSERVER_API FUMCP_GetAssetDependencyTreeResult
 class FUMCP_AssetTools
 {
 public:
-	void Register(class FUMCP_Server* Server);
+	void Register(class FUMCP_Server* InServer);
 
 private:
 	bool ExportAsset(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent);
-	bool BatchExportAssets(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent);
+	bool StartBatchExportAssets(TSharedPtr<FJsonObject> arguments, UMCP_ToolJobStep& OutStep, TArray<FUMCP_CallToolResultContent>& OutContent);
 	bool ExportClassDefault(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent);
+	bool StartImportAsset(TSharedPtr<FJsonObject> arguments, UMCP_ToolJobStep& OutStep, TArray<FUMCP_CallToolResultContent>& OutContent);
 	bool ImportAsset(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent);
+	bool StartBatchImportAssets(TSharedPtr<FJsonObject> arguments, UMCP_ToolJobStep& OutStep, TArray<FUMCP_CallToolResultContent>& OutContent);
 	bool QueryAsset(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent);
 	bool SearchAssets(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent);
 	bool GetAssetDependencies(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent);
 	bool GetAssetReferences(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent);
 	bool GetAssetDependencyTree(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent);
+	bool BatchQueryAssets(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent);
+	bool BatchGetAssetDependencies(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent);
+	bool BatchGetAssetReferences(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent);
+	bool ExportDependencyGraph(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent);
 
 	// Helper function to export a single asset to text
 	// Returns true on success, false on failure
@@ -396,5 +680,18 @@ private:
 	// Returns the imported object on success, nullptr on failure
 	// The UFactory system will automatically determine the appropriate factory based on file type
 	UObject* PerformImportPass(const FString& FilePath, UClass* ImportClass, const FString& PackagePath, const FString& ObjectName);
+
+	// What import_asset and batch_import_assets resolve from FUMCP_ImportAssetParams before importing
+	struct FPreparedImport;
+
+	// Validates Params, loads the class and the target package. Returns false with Result.error (and filePath,
+	// packagePath) set if the import can't go ahead.
+	bool PrepareImport(const FUMCP_ImportAssetParams& Params, FPreparedImport& OutImport, FUMCP_ImportAssetResult& Result);
+
+	// Runs the binary and then the T3D import pass of a prepared import, inside whatever transaction the caller has open.
+	// Returns the imported object, or nullptr with Result.error set.
+	UObject* RunImport(const FPreparedImport& Import, FUMCP_ImportAssetResult& Result);
+
+	class FUMCP_Server* Server = nullptr;
 };
 
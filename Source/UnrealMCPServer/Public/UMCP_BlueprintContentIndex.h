@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "UObject/ObjectSaveContext.h"
+#include <atomic>
+
+struct FAssetData;
+class UBlueprint;
+
+// Snapshot of FUMCP_BlueprintContentIndex for monitoring
+struct FUMCP_BlueprintContentIndexStats
+{
+	bool bLoaded = false; // The index file of the last session has been read
+	int32 NumBlueprints = 0;
+	int32 NumItems = 0;
+	int32 NumNames = 0; // Distinct names over all kinds
+	int64 MemoryBytes = 0;
+};
+
+// What the Blueprints of the project contain (functions, variables, events, node classes and interfaces), so
+// search_blueprints can search graph content without loading a single asset.
+// Entries are taken from Blueprints that are in memory anyway: when one is saved (UPackage::PackageSavedWithContextEvent)
+// or loaded (FCoreUObjectDelegates::OnAssetLoaded), and by the index_blueprints tool for the ones never touched. Each
+// entry remembers the AssetRegistry's saved hash of its package; entries whose package changed on disk behind the
+// editor's back (e.g. a source control sync) are dropped, as are removed and renamed packages.
+// The index is written to Saved/UnrealMCPServer/BlueprintContentIndex.bin on shutdown and read back on a background
+// thread once the AssetRegistry has finished its initial scan, keeping only the entries whose package is unchanged.
+// Thread-safe; queries come from tools running on the task graph.
+class UNREALMCPSERVER_API FUMCP_BlueprintContentIndex
+{
+public:
+	enum class EKind : uint8
+	{
+		Function,  // Function graphs, and function call nodes as references
+		Variable,  // Member variables, and variable get/set nodes as references
+		Event,     // Event and custom event nodes
+		NodeClass, // Class of every graph node (e.g. K2Node_CallFunction)
+		Interface, // Implemented interfaces
+		Num
+	};
+
+	struct FItem
+	{
+		EKind Kind = EKind::Function;
+		bool bReference = false; // A function call or variable get/set in Graph rather than something the Blueprint defines
+		FString Name;
+		FString Graph; // Empty for items that aren't in a graph (member variables, interfaces)
+
+		bool operator==(const FItem& Other) const
+		{
+			return Kind == Other.Kind && bReference == Other.bReference && Name == Other.Name && Graph == Other.Graph;
+		}
+		friend uint32 GetTypeHash(const FItem& Item)
+		{
+			return HashCombine(HashCombine(GetTypeHash(static_cast<uint8>(Item.Kind) * 2 + (Item.bReference ? 1 : 0)), GetTypeHash(Item.Name)), GetTypeHash(Item.Graph));
+		}
+	};
+
+	~FUMCP_BlueprintContentIndex();
+
+	// Game thread only
+	void Initialize();
+	void Shutdown();
+
+	// Indexes a loaded Blueprint as of its last save. Game thread only.
+	void AddBlueprint(UBlueprint* Blueprint);
+
+	bool IsIndexed(FName PackageName) const;
+
+	// Adds the packages that have an item of Kind whose name contains Term, ignoring case
+	void FindPackages(EKind Kind, const FString& Term, TSet<FName>& OutPackageNames) const;
+
+	// The items of Kind in PackageName whose name contains Term, ignoring case, in the order they were found
+	void GetItems(FName PackageName, EKind Kind, const FString& Term, TArray<FItem>& OutItems) const;
+
+	// Writes the index to disk if it changed since it was read or last written
+	bool Save();
+
+	FUMCP_BlueprintContentIndexStats GetStats() const;
+
+private:
+	struct FEntry
+	{
+		FString SavedHash; // Of the package when the entry was made; empty until the AssetRegistry has seen the save
+		TArray<FItem> Items;
+	};
+
+	void IndexBlueprint(UBlueprint* Blueprint, FString&& SavedHash);
+	void SetEntryLocked(FName PackageName, FEntry&& Entry);
+	void RemoveEntryLocked(FName PackageName);
+	void Load();
+	void OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext SaveContext);
+	void OnAssetLoaded(UObject* Object);
+	void OnAssetRemoved(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void OnAssetUpdated(const FAssetData& AssetData);
+
+	mutable FRWLock Lock;
+	TMap<FName, FEntry> Entries;
+	TMap<FString, TSet<FName>> NamePackages[static_cast<int32>(EKind::Num)]; // Lowercase name to the packages that have it
+	int32 NumItems = 0;
+	bool bDirty = false;
+	std::atomic<bool> bLoaded{ false };
+	std::atomic<bool> bCancelLoad{ false };
+	TFuture<void> LoadFuture;
+	FString FilePath;
+
+	FDelegateHandle FilesLoadedHandle;
+	FDelegateHandle PackageSavedHandle;
+	FDelegateHandle AssetLoadedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle AssetUpdatedHandle;
+};
@@ -28,6 +28,47 @@ struct UNREALMCPSERVER_API FUMCP_SearchBlueprintsParams
 
 	UPROPERTY()
 	int32 offset = 0;
+
+	UPROPERTY()
+	FString cursor; // nextCursor of a previous page; replaces offset and the search criteria
+};
+
+// IndexBlueprints tool parameters
+USTRUCT()
+struct UNREALMCPSERVER_API FUMCP_IndexBlueprintsParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString packagePath; // Empty indexes every Blueprint of the project
+
+	UPROPERTY()
+	bool bRecursive = true;
+
+	UPROPERTY()
+	int32 maxBlueprints = 0; // 0 for no limit
+};
+
+// IndexBlueprints output
+USTRUCT()
+struct UNREALMCPSERVER_API FUMCP_IndexBlueprintsResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 indexedCount = 0;
+
+	UPROPERTY()
+	int32 failedCount = 0;
+
+	UPROPERTY()
+	int32 alreadyIndexedCount = 0;
+
+	UPROPERTY()
+	int32 remainingCount = 0; // Not indexed because of maxBlueprints or a cancel
+
+	UPROPERTY()
+	TArray<FString> failedPaths;
 };
 
 // ExportBlueprintMarkdown tool parameters
@@ -71,10 +112,11 @@ struct UNREALMCPSERVER_API FUMCP_ExportBlueprintMarkdownResult
 class FUMCP_BlueprintTools
 {
 public:
-	void Register(class FUMCP_Server* Server);
+	void Register(class FUMCP_Server* InServer);
 
 private:
 	bool SearchBlueprints(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent);
+	bool StartIndexBlueprints(TSharedPtr<FJsonObject> arguments, UMCP_ToolJobStep& OutStep, TArray<FUMCP_CallToolResultContent>& OutContent);
 	bool ExportBlueprintMarkdown(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent);
 
 	// Helper function to export a Blueprint asset to markdown text
@@ -82,5 +124,7 @@ private:
 	// On success, OutExportedText contains the exported markdown content
 	// On failure, OutError contains an error message
 	bool ExportBlueprintToMarkdown(const FString& ObjectPath, FString& OutExportedText, FString& OutError);
+
+	class FUMCP_Server* Server = nullptr;
 };
 
@@ -12,7 +12,7 @@ struct FUMCP_ReadResourceResultContent; // Forward declare for the delegate para
 class FUMCP_CommonResources
 {
 public:
-	void Register(class FUMCP_Server* Server);
+	void Register(class FUMCP_Server* InServer);
 
 private:
 	/**
@@ -24,18 +24,20 @@ private:
 	 * Load resource templates from resources.json file.
 	 * Returns true if successful, false otherwise.
 	 */
-	bool LoadResourcesFromJson(class FUMCP_Server* Server);
+	bool LoadResourcesFromJson();
 	/**
 	 * Handles requests for T3D representation of Unreal Engine Blueprints via a templated URI.
 	 * This is bound to FUMCP_ResourceTemplateDefinition::ReadResource.
-	 * URI scheme: unreal+t3d://{filepath}
+	 * URI scheme: unreal+t3d://{filepath}{?offset,length,block}
 	 */
-	bool HandleT3DResourceRequest(const FUMCP_UriTemplate& UriTemplate, const FUMCP_UriTemplateMatch& Match, TArray<FUMCP_ReadResourceResultContent>& OutContent);
+	bool HandleT3DResourceRequest(const FUMCP_UriTemplate& UriTemplate, const FUMCP_UriTemplateMatchView& Match, TArray<FUMCP_ReadResourceResultContent>& OutContent);
 
 	/**
 	 * Handles requests for Markdown representation of Unreal Engine Blueprints via a templated URI.
 	 * This is bound to FUMCP_ResourceTemplateDefinition::ReadResource.
-	 * URI scheme: unreal+md://{filepath}
+	 * URI scheme: unreal+md://{filepath}{?offset,length}
 	 */
-	bool HandleMarkdownResourceRequest(const FUMCP_UriTemplate& UriTemplate, const FUMCP_UriTemplateMatch& Match, TArray<FUMCP_ReadResourceResultContent>& OutContent);
+	bool HandleMarkdownResourceRequest(const FUMCP_UriTemplate& UriTemplate, const FUMCP_UriTemplateMatchView& Match, TArray<FUMCP_ReadResourceResultContent>& OutContent);
+
+	class FUMCP_Server* Server = nullptr;
 };
@@ -126,6 +126,74 @@ struct UNREALMCPSERVER_API FUMCP_GetLogFilePathResult
 	FString logFilePath;
 };
 
+// GetLogLines tool parameters
+USTRUCT()
+struct UNREALMCPSERVER_API FUMCP_GetLogLinesParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int64 cursor = 0; // nextCursor of the previous call; 0 for the oldest line kept, -1 for only lines logged from now on
+
+	UPROPERTY()
+	TArray<FString> categories; // Log categories to return (e.g. LogBlueprint); empty for all
+
+	UPROPERTY()
+	FString minVerbosity; // Least severe verbosity to return (e.g. Warning returns Fatal, Error and Warning); empty for all
+
+	UPROPERTY()
+	FString contains; // Only lines containing this text, ignoring case
+
+	UPROPERTY()
+	int32 maxLines = 500;
+};
+
+USTRUCT()
+struct UNREALMCPSERVER_API FUMCP_LogLineInfo
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int64 sequence = 0;
+
+	UPROPERTY()
+	double time = 0.0; // Seconds since the editor started
+
+	UPROPERTY()
+	FString category;
+
+	UPROPERTY()
+	FString verbosity;
+
+	UPROPERTY()
+	FString text;
+
+	UPROPERTY()
+	bool bTruncated = false;
+};
+
+// GetLogLines output
+USTRUCT()
+struct UNREALMCPSERVER_API FUMCP_GetLogLinesResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FUMCP_LogLineInfo> lines;
+
+	UPROPERTY()
+	int64 nextCursor = 0; // Pass as cursor to get the lines logged after these
+
+	UPROPERTY()
+	int64 missedLines = 0; // Lines after cursor that were overwritten before this call
+
+	UPROPERTY()
+	int32 bufferCapacity = 0; // Lines the server keeps; 0 when LogBufferLines is 0
+
+	UPROPERTY()
+	FString error;
+};
+
 // RequestEditorCompile tool parameters
 USTRUCT()
 struct UNREALMCPSERVER_API FUMCP_RequestEditorCompileParams
@@ -150,7 +218,7 @@ struct UNREALMCPSERVER_API FUMCP_RequestEditorCompileResult
 	bool bCompileStarted; // Whether compilation was successfully initiated
 
 	UPROPERTY()
-	FString status; // "completed", "failed", "timeout", "not_available", "error"
+	FString status; // "completed", "failed", "timeout", "cancelled", "not_available", "error"
 
 	UPROPERTY()
 	FString buildLog; // Full build log output
@@ -168,12 +236,16 @@ struct UNREALMCPSERVER_API FUMCP_RequestEditorCompileResult
 class FUMCP_CommonTools
 {
 public:
-	void Register(class FUMCP_Server* Server);
+	// bEditorTools false leaves out the tools that need a full editor session (request_editor_compile and Live Coding)
+	void Register(class FUMCP_Server* InServer, bool bEditorTools = true);
 
 private:
 	bool GetProjectConfig(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent);
 	bool ExecuteConsoleCommand(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent);
 	bool GetLogFilePath(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent);
-	bool RequestEditorCompile(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent);
+	bool GetLogLines(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent);
+	bool StartRequestEditorCompile(TSharedPtr<FJsonObject> arguments, UMCP_ToolJobStep& OutStep, TArray<FUMCP_CallToolResultContent>& OutContent);
 	bool HandleCompilationComplete(ILiveCodingModule* LiveCodingModule, ELiveCodingCompileResult CompileResult, FUMCP_RequestEditorCompileResult& Result, FUMCP_CallToolResultContent& Content);
+
+	class FUMCP_Server* Server = nullptr;
 };
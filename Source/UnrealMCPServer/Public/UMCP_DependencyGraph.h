@@ -0,0 +1,106 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include <atomic>
+
+class FUMCP_PackageChangeNotifier;
+enum class EUMCP_PackageChangeKind : uint8;
+
+// Package dependency graph of the whole project in compressed sparse row form: the dependencies of Packages[i] are
+// Targets[Offsets[i]] up to Targets[Offsets[i + 1]], indices into Packages. Immutable once built, so readers share it.
+struct FUMCP_DependencyGraphSnapshot
+{
+	enum EEdgeFlags : uint8
+	{
+		Edge_Hard = 1,
+		Edge_Soft = 2
+	};
+
+	enum ENodeFlags : uint8
+	{
+		Node_HasAssets = 1 // Otherwise the package is only depended on (e.g. /Script packages)
+	};
+
+	int64 Generation = 0;
+	TArray<FName> Packages; // Sorted by name
+	TMap<FName, int32> PackageIndices;
+	TArray<uint8> NodeFlags;
+	TArray<int32> Offsets; // Packages.Num() + 1 entries
+	TArray<int32> Targets; // Ascending per package
+	TArray<uint8> EdgeFlags;
+
+	int64 GetAllocatedSize() const;
+};
+
+// Snapshot of FUMCP_DependencyGraph for monitoring
+struct FUMCP_DependencyGraphStats
+{
+	int64 Generation = 0;
+	int32 NumPackages = 0; // Of the last snapshot
+	int32 NumEdges = 0;
+	int64 MemoryBytes = 0;
+	double BuildSeconds = 0.0; // Of the last snapshot, full or incremental
+};
+
+// Builds FUMCP_DependencyGraphSnapshots on demand and tracks which packages changed since, so the next snapshot only
+// re-queries those and clients can ask what changed after the generation of a snapshot they already have.
+// The first snapshot walks every on-disk package in the AssetRegistry, which takes seconds on a large project, so the
+// server warms it on a thread pool thread once the AssetRegistry has finished loading. Every change
+// FUMCP_PackageChangeNotifier reports except edits (AssetRegistry additions, removals, renames and updates, and saves
+// other than cooks) marks its package changed in the generation after the last snapshot's.
+// Generations start at the server start time in milliseconds and only go up once per snapshot, so one from an
+// earlier editor session is older than any this one can answer deltas for. Thread-safe; snapshots are built by tools
+// running on the task graph.
+class UNREALMCPSERVER_API FUMCP_DependencyGraph
+{
+public:
+	~FUMCP_DependencyGraph();
+
+	// Game thread only. Without PackageChanges no change is tracked, which only tests want. With bWarmUp the first snapshot
+	// is built in the background as soon as the AssetRegistry has loaded.
+	void Initialize(FUMCP_PackageChangeNotifier* InPackageChanges = nullptr, bool bWarmUp = false);
+	void Shutdown();
+
+	int64 GetGeneration() const;
+
+	// Snapshot of the current generation, built or updated first if needed, or waited for if the warm-up is building it.
+	// Null with OutError while the AssetRegistry is still scanning.
+	TSharedPtr<const FUMCP_DependencyGraphSnapshot> GetSnapshot(FString& OutError);
+
+	// Adds the packages that changed after SinceGeneration. False if changes that far back aren't known, in which case
+	// the client needs a full snapshot.
+	bool GetChangedPackages(int64 SinceGeneration, TArray<FName>& OutPackageNames) const;
+
+	// Writes Snapshot to Saved/UnrealMCPServer/DependencyGraph in the binary layout described in
+	// UMCP_DependencyGraph.cpp and deletes the files of older snapshots. Reuses the file if it was already written.
+	bool SaveSnapshot(const FUMCP_DependencyGraphSnapshot& Snapshot, FString& OutFilePath, int64& OutFileBytes, FString& OutError);
+
+	FUMCP_DependencyGraphStats GetStats() const;
+
+private:
+	TSharedRef<FUMCP_DependencyGraphSnapshot> BuildSnapshot(int64 InGeneration, const FUMCP_DependencyGraphSnapshot* PreviousSnapshot, const TArray<FName>& ChangedPackageNames) const;
+	void MarkChanged(FName PackageName);
+	void OnPackageChanged(FName PackageName, EUMCP_PackageChangeKind Kind);
+	void StartWarmUp();
+
+	mutable FCriticalSection Lock;
+	FCriticalSection BuildLock; // Held while a snapshot is built, so concurrent callers wait for it instead of building their own
+	int64 Generation = 0;
+	bool bGenerationObserved = false; // A snapshot was built at Generation, so the next change starts a new one
+	int64 OldestDeltaGeneration = TNumericLimits<int64>::Max(); // Changes are tracked from the first snapshot on
+	TMap<FName, int64> PackageChangeGenerations;
+	TSharedPtr<const FUMCP_DependencyGraphSnapshot> Snapshot;
+	double BuildSeconds = 0.0;
+	FString SavedFolder;
+	FString SavedFilePath; // File of the last saved snapshot
+	int64 SavedGeneration = 0;
+	int64 SavedFileBytes = 0;
+
+	std::atomic<bool> bShuttingDown{ false }; // Stops a build in progress; its snapshot is thrown away
+	TFuture<void> WarmUpFuture;
+
+	FUMCP_PackageChangeNotifier* PackageChanges = nullptr;
+	FDelegateHandle PackageChangedHandle;
+	FDelegateHandle FilesLoadedHandle;
+};
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/List.h"
+
+class FUMCP_PackageChangeNotifier;
+enum class EUMCP_PackageChangeKind : uint8;
+
+// Snapshot of FUMCP_ExportCache for monitoring
+struct FUMCP_ExportCacheStats
+{
+	uint64 Hits = 0;
+	uint64 DiskHits = 0; // Misses in memory that were served from the disk tier; also counted in Hits
+	uint64 Misses = 0;
+	uint64 Evictions = 0;
+	uint64 Invalidations = 0; // Cached exports dropped because their package changed
+	int64 MemoryBytes = 0;
+	int32 NumEntries = 0;
+};
+
+// Part of an export to return. Offset and Length are in characters; with a Block they are relative to that block.
+struct FUMCP_ExportRange
+{
+	int32 Offset = 0;
+	int32 Length = -1; // To the end
+	int32 Block = INDEX_NONE; // The whole export
+};
+
+struct FUMCP_ExportSlice
+{
+	FString Text;
+	int32 Offset = 0;
+	int32 Length = 0;
+	int32 TotalLength = 0; // Of the block, or of the whole export
+	int32 NumBlocks = 0; // 0 until a block of the export was asked for
+};
+
+// Text exports (T3D, md, ...) of assets, keyed by object path, format and the revision of the object's package.
+// The revision is a per-package counter bumped by every change FUMCP_PackageChangeNotifier reports (object modification,
+// package dirty/save events and AssetRegistry rename/remove/update events), so a lookup never returns an export older
+// than the last change of its package.
+// Entries are kept in memory under a byte budget with LRU eviction. The optional disk tier under
+// Saved/UnrealMCPServer/ExportCache is content-addressed: files are named by a hash of the object path, format and
+// the package's saved hash from the AssetRegistry, so an export written in one editor session is reused by the next
+// as long as the package on disk is the same. Packages changed in this session only use the memory tier. The disk tier
+// is kept under its own byte budget: least recently used files (and with them the files of superseded saved hashes) are
+// deleted on a background thread at Initialize and whenever a quarter of the budget has been written since.
+class UNREALMCPSERVER_API FUMCP_ExportCache
+{
+public:
+	~FUMCP_ExportCache();
+
+	// A memory budget of 0 disables the cache; GetOrExport then always runs Export. A disk budget of 0 disables the disk
+	// tier. Without PackageChanges nothing invalidates the cached exports, which only tests want.
+	void Initialize(int64 InMemoryBudgetBytes, int64 InDiskBudgetBytes, FUMCP_PackageChangeNotifier* InPackageChanges = nullptr);
+	void Shutdown();
+
+	// Returns the cached export, or runs Export (which should load the object and export it) and caches its result.
+	// Failed exports are not cached. Game thread only, like the exporters themselves.
+	bool GetOrExport(const FString& ObjectPath, const FString& Format, TFunctionRef<bool(FString& OutText, FString& OutError)> Export, FString& OutText, FString& OutError);
+
+	// Finds where the blocks of an export start; the first block starts at 0
+	using FBlockFinder = TFunction<void(FStringView Text, TArray<int32>& OutBlockStarts)>;
+
+	// Like GetOrExport, but only copies Range out of the cached export, so reading an export chunk by chunk costs
+	// O(chunk) per chunk after the first. Block starts are found by FindBlocks once per cached export; without FindBlocks
+	// a Range with a Block fails. Fails with OutError set if Range lies outside the export.
+	bool GetOrExportSlice(const FString& ObjectPath, const FString& Format, TFunctionRef<bool(FString& OutText, FString& OutError)> Export, const FUMCP_ExportRange& Range, const FBlockFinder& FindBlocks, FUMCP_ExportSlice& OutSlice, FString& OutError);
+
+	FUMCP_ExportCacheStats GetStats() const;
+
+private:
+	struct FEntry
+	{
+		FName PackageName;
+		uint32 Revision = 0;
+		FString Text;
+		TArray<int32> BlockStarts; // Found on the first ranged read that asks for a block
+		bool bFoundBlocks = false;
+		int64 NumBytes = 0;
+		TDoubleLinkedList<FString>::TDoubleLinkedListNode* LruNode = nullptr;
+	};
+
+	void BumpRevision(FName PackageName);
+	void OnPackageChanged(FName PackageName, EUMCP_PackageChangeKind Kind);
+
+	// The entry for Key if it is of the package's current revision; stale entries are dropped. Counts the hit.
+	FEntry* FindCurrentEntryLocked(const FString& Key, FName PackageName, uint32& OutRevision);
+	bool SliceEntryLocked(FEntry& Entry, const FUMCP_ExportRange& Range, const FBlockFinder& FindBlocks, FUMCP_ExportSlice& OutSlice, FString& OutError);
+	void AddEntryLocked(const FString& Key, FName PackageName, uint32 Revision, const FString& Text);
+	void RemoveEntryLocked(const FString& Key);
+	FString GetDiskPath(const FString& ObjectPath, const FString& Format, FName PackageName) const; // Empty if the disk tier can't be used
+
+	mutable FCriticalSection Lock;
+	TMap<FString, FEntry> Entries; // Keyed by "<format>|<object path>"
+	TDoubleLinkedList<FString> LruList; // Most recently used first
+	TMap<FName, uint32> PackageRevisions; // Only packages that changed in this session
+	int64 MemoryBudgetBytes = 0;
+	bool bUseDiskTier = false;
+	int64 DiskBudgetBytes = 0;
+	int64 DiskBytesSincePrune = 0; // Game thread only, like the writes it counts
+	FString DiskTierFolder;
+	FUMCP_ExportCacheStats Stats;
+
+	FUMCP_PackageChangeNotifier* PackageChanges = nullptr;
+	FDelegateHandle PackageChangedHandle;
+};
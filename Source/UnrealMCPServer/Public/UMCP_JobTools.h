@@ -0,0 +1,32 @@
+#pragma once
+
+#include "UMCP_Types.h"
+#include "UMCP_JobTools.generated.h"
+
+// Job Tools Parameter Types. Both tools answer with FUMCP_JobStatusResult.
+
+// GetJobStatus and CancelJob tool parameters
+USTRUCT()
+struct UNREALMCPSERVER_API FUMCP_JobIdParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString jobId;
+};
+
+// Status polling and cancellation for tools called with `runAsJob`
+class FUMCP_JobTools
+{
+public:
+	void Register(class FUMCP_Server* InServer);
+
+private:
+	bool GetJobStatus(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent);
+	bool CancelJob(TSharedPtr<FJsonObject> arguments, TArray<FUMCP_CallToolResultContent>& OutContent);
+
+	// Writes the job's status as structured content, with the finished job's tools/call result as `result`
+	bool SetJobStatusContent(const FString& JobId, FUMCP_CallToolResultContent& Content);
+
+	class FUMCP_Server* Server = nullptr;
+};
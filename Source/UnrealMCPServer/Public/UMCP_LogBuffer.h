@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/OutputDevice.h"
+#include <atomic>
+
+// Snapshot of FUMCP_LogBuffer for monitoring
+struct FUMCP_LogBufferStats
+{
+	int32 Capacity = 0; // Lines kept; 0 when the buffer is disabled
+	uint64 NextSequence = 1; // Sequence number the next line will get
+	uint64 NumDropped = 0; // Lines whose slot a line a lap later had already taken by the time they were written
+	int64 MemoryBytes = 0;
+};
+
+// One line read back from FUMCP_LogBuffer
+struct FUMCP_LogLine
+{
+	uint64 Sequence = 0;
+	double Time = 0.0; // Seconds since the editor started, as in the log file's timestamps
+	FName Category;
+	ELogVerbosity::Type Verbosity = ELogVerbosity::Log;
+	FString Text;
+	bool bTruncated = false; // Text was cut at MaxLineChars
+};
+
+// Output device on GLog that keeps the most recent log lines in a fixed ring of slots, so clients can ask for the
+// lines logged after a cursor instead of reading the log file. Every line gets a sequence number, starting at 1;
+// line N lives in slot N % Capacity until line N + Capacity overwrites it.
+// Each slot has a version (seqlock) that a writer claims with a compare-exchange before copying the line in, and
+// readers copy the slot and check the version didn't change meanwhile, so neither side takes a lock. A writer only
+// waits if the line a whole lap before it is still being copied into the same slot. Lines are cut at MaxLineChars.
+// Safe to use from any thread.
+class UNREALMCPSERVER_API FUMCP_LogBuffer : public FOutputDevice
+{
+public:
+	static constexpr int32 MaxLineChars = 1024;
+
+	virtual ~FUMCP_LogBuffer();
+
+	// A capacity of 0 keeps nothing and doesn't attach to GLog. Tests pass bAttachToLog false and call Serialize themselves.
+	void Initialize(int32 InCapacity, bool bAttachToLog = true);
+	// Detaches from GLog; the lines kept stay readable until the next Initialize
+	void Shutdown();
+
+	// Appends the lines from Cursor on (0 for the oldest line still kept) that match Filter, up to MaxLines, and
+	// returns the cursor to pass next time. Reading stops at a line that is still being written, so no line is
+	// skipped because a later one finished first. OutNumMissed counts lines after Cursor already overwritten.
+	uint64 ReadLines(uint64 Cursor, int32 MaxLines, TFunctionRef<bool(const FUMCP_LogLine&)> Filter, TArray<FUMCP_LogLine>& OutLines, uint64& OutNumMissed) const;
+
+	// Sequence number the next line will get; a cursor that only returns lines logged from now on
+	uint64 GetNextSequence() const { return NextSequence.load(std::memory_order_acquire); }
+
+	FUMCP_LogBufferStats GetStats() const;
+
+	// FOutputDevice interface
+	virtual void Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const FName& Category) override;
+	virtual void Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const FName& Category, const double Time) override;
+	virtual bool CanBeUsedOnAnyThread() const override { return true; }
+	virtual bool CanBeUsedOnMultipleThreads() const override { return true; }
+
+private:
+	struct FSlot
+	{
+		// Sequence * 2 once the line is complete, Sequence * 2 + 1 while it is written, 0 before the first line
+		std::atomic<uint64> Version{ 0 };
+		double Time = 0.0;
+		FName Category;
+		ELogVerbosity::Type Verbosity = ELogVerbosity::Log;
+		int32 NumChars = 0;
+		bool bTruncated = false;
+		TCHAR Text[MaxLineChars];
+	};
+
+	TUniquePtr<FSlot[]> Slots;
+	int32 Capacity = 0;
+	bool bAttached = false;
+	std::atomic<uint64> NextSequence{ 1 };
+	std::atomic<uint64> NumDropped{ 0 };
+};
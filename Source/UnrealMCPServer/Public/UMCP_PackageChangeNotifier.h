@@ -0,0 +1,60 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectSaveContext.h"
+
+struct FAssetData;
+class UPackage;
+
+// What happened to the package. Listeners that only care about what is on disk (e.g. dependencies) skip Edited.
+enum class EUMCP_PackageChangeKind : uint8
+{
+	Edited, // An object was modified or the package was dirtied; nothing is on disk yet
+	Saved, // Not for cooks and other procedural saves, which leave the asset as it was
+	Added,
+	Removed,
+	Renamed, // Reported for both the new and the old package
+	Updated, // The AssetRegistry rescanned the file, e.g. after a source control sync
+};
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FUMCP_OnPackageChanged, FName /* PackageName */, EUMCP_PackageChangeKind /* Kind */);
+
+// The one set of engine hooks for "this package may have changed": modified or dirtied objects, saves, and AssetRegistry
+// additions, renames, removals and updates. Additions are only reported once the initial AssetRegistry scan is done, since
+// the scan adds every asset. Everything that keys state by package (FUMCP_ExportCache, FUMCP_ResourceSubscriptions,
+// FUMCP_DependencyGraph) listens to OnPackageChanged instead of hooking the engine itself, so they all see the same
+// changes. Game thread only.
+class UNREALMCPSERVER_API FUMCP_PackageChangeNotifier
+{
+public:
+	~FUMCP_PackageChangeNotifier();
+
+	// Tests pass bHookEngineEvents false and call NotifyPackageChanged themselves
+	void Initialize(bool bHookEngineEvents = true);
+	// Unhooks the engine; listeners should have removed themselves by now
+	void Shutdown();
+
+	FUMCP_OnPackageChanged& OnPackageChanged() { return PackageChangedEvent; }
+
+	// Called for every engine event; None is ignored
+	void NotifyPackageChanged(FName PackageName, EUMCP_PackageChangeKind Kind);
+
+private:
+	void OnObjectModified(UObject* Object);
+	void OnPackageMarkedDirty(UPackage* Package, bool bWasDirty);
+	void OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext SaveContext);
+	void OnAssetAdded(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void OnAssetRemoved(const FAssetData& AssetData);
+	void OnAssetUpdated(const FAssetData& AssetData);
+
+	FUMCP_OnPackageChanged PackageChangedEvent;
+
+	FDelegateHandle ObjectModifiedHandle;
+	FDelegateHandle PackageMarkedDirtyHandle;
+	FDelegateHandle PackageSavedHandle;
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetUpdatedHandle;
+};
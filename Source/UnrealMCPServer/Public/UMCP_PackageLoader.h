@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UPackage;
+
+// Snapshot of FUMCP_PackageLoader for monitoring
+struct FUMCP_PackageLoaderStats
+{
+	int32 NumLoading = 0; // Async loads in flight
+	int32 NumHeld = 0; // Packages loaded for an export that haven't been released yet
+	int64 NumLoaded = 0;
+	int64 NumReleased = 0; // Packages that were actually collected after a release
+	int32 NumCollections = 0;
+	int64 MemoryWatermarkBytes = 0; // 0 when releasing is disabled
+};
+
+// Loads the packages behind the export tools and resources through LoadPackageAsync instead of a synchronous
+// LoadObject, so batches keep a window of loads in flight while the game thread exports the asset whose package
+// completed, and releases what it loaded once the editor's memory use goes over a watermark.
+// Only packages that weren't in memory when a load was requested are held; when used physical memory is above the
+// watermark their objects lose RF_Standalone and garbage is collected. Packages that are dirty, contain a world or have an
+// asset open in an editor are left alone, as is anything else still referenced, which gets its flags back after the
+// collection. Game thread only, except for GetStats.
+class UNREALMCPSERVER_API FUMCP_PackageLoader
+{
+public:
+	~FUMCP_PackageLoader();
+
+	// MaxConcurrentLoads is the window shared by every caller of TryStartLoad. A MemoryWatermarkBytes of 0 never releases.
+	void Initialize(int32 InMaxConcurrentLoads, int64 InMemoryWatermarkBytes);
+	void Shutdown();
+
+	int32 GetMaxConcurrentLoads() const { return MaxConcurrentLoads; }
+
+	// Starts loading the package of ObjectPath unless it is in memory already (or not a package path), in which case
+	// OutRequestId is INDEX_NONE. False if the window is full; try again once one of the loads in flight completed.
+	bool TryStartLoad(const FString& ObjectPath, int32& OutRequestId);
+
+	// INDEX_NONE counts as complete
+	bool IsLoadComplete(int32 RequestId) const;
+
+	// Blocks until RequestId has completed
+	void WaitForLoad(int32 RequestId);
+
+	// Same lookup as ::LoadObject/::LoadClass, but a package that isn't in memory is loaded asynchronously (outside the
+	// window) and waited for, and held for release.
+	UObject* LoadObject(const FString& ObjectPath);
+	UClass* LoadClass(const FString& ClassPath);
+
+	// Releases the held packages and collects garbage if used physical memory is above the watermark. Only call this
+	// where nothing up the stack holds on to an exported object.
+	void ReleaseIfOverWatermark();
+
+	FUMCP_PackageLoaderStats GetStats() const;
+
+private:
+	int32 StartLoad(const FString& PackageName);
+	void OnLoadComplete(int32 RequestId, UPackage* Package);
+	bool CanRelease(UPackage* Package) const;
+	void UpdateStats();
+
+	int32 MaxConcurrentLoads = 8;
+	int64 MemoryWatermarkBytes = 0;
+	TSet<int32> PendingLoads;
+	TArray<TWeakObjectPtr<UPackage>> HeldPackages;
+	mutable FCriticalSection StatsLock;
+	FUMCP_PackageLoaderStats Stats;
+	TSharedRef<bool> CallbackGuard = MakeShared<bool>(true); // Load callbacks hold a weak pointer; Shutdown replaces it
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include <atomic>
+
+class FUMCP_PackageChangeNotifier;
+enum class EUMCP_PackageChangeKind : uint8;
+
+// Snapshot of FUMCP_ResourceSubscriptions for monitoring
+struct FUMCP_ResourceSubscriptionsStats
+{
+	int32 NumSessions = 0;
+	int32 NumSubscriptions = 0;
+	int32 NumParkedPolls = 0; // GET /mcp requests waiting for a notification
+	uint64 NumPackageChanges = 0; // Changes to subscribed packages, before coalescing
+	uint64 NumNotificationsSent = 0; // notifications/resources/updated messages handed to a poll
+	uint64 NumExpiredSessions = 0;
+};
+
+// Sessions handed out by initialize (Mcp-Session-Id) and the resources each one subscribed to with resources/subscribe.
+// Only resources backed by an asset are subscribable: the part of the URI after "://" and before any query is an object
+// path (as in unreal+t3d://{filepath} and unreal+md://{filepath}) and changes to its package, as reported by
+// FUMCP_PackageChangeNotifier, are what triggers notifications/resources/updated.
+// Changes are collected for CoalesceSeconds after the first one and then added to the pending URIs of every session
+// subscribed to them, so a burst of edits is a single notification per URI. Pending URIs are delivered to the session's
+// poll: a GET /mcp that is parked until there is something to deliver or PollTimeoutSeconds have passed.
+// Sessions unused for SessionTimeoutSeconds are dropped. Nothing is done for engine events while nobody is subscribed.
+// Thread-safe; poll callbacks run on the thread calling Tick, Poll or CloseSession, without any lock held.
+class UNREALMCPSERVER_API FUMCP_ResourceSubscriptions
+{
+public:
+	// Receives the URIs that changed, or nothing if the poll timed out or was replaced by a newer one
+	using FPollCallback = TFunction<void(TArray<FString>&& UpdatedUris)>;
+
+	~FUMCP_ResourceSubscriptions();
+
+	// Game thread only. Tests pass no PackageChanges and call NotifyPackageChanged and Tick themselves.
+	void Initialize(double InCoalesceSeconds, double InPollTimeoutSeconds, double InSessionTimeoutSeconds, FUMCP_PackageChangeNotifier* InPackageChanges = nullptr);
+	// Answers the parked polls and drops every session
+	void Shutdown();
+
+	FString CreateSession();
+	// Keeps the session from expiring; false if it doesn't exist (anymore)
+	bool TouchSession(const FString& SessionId);
+	// Answers the session's parked poll. False if there is no such session.
+	bool CloseSession(const FString& SessionId);
+
+	// False with OutError set if the session doesn't exist or the URI names no package
+	bool Subscribe(const FString& SessionId, const FString& Uri, FString& OutError);
+	// False only if the session doesn't exist; URIs that weren't subscribed are fine
+	bool Unsubscribe(const FString& SessionId, const FString& Uri);
+
+	// Parks Callback until the session has updated URIs to deliver, which may be right away. A poll that was already
+	// parked for the session is answered with nothing. False (and Callback is dropped) if there is no such session.
+	bool Poll(const FString& SessionId, FPollCallback&& Callback);
+
+	// Called for every engine event; cheap when the package has no subscribers. Now is FPlatformTime::Seconds().
+	void NotifyPackageChanged(FName PackageName, double Now);
+
+	// Delivers coalesced changes, times out polls and expires sessions. Called from the core ticker.
+	void Tick(double Now);
+
+	// The package of an asset resource URI, e.g. /Game/BP_Door for unreal+t3d:///Game/BP_Door.BP_Door
+	static bool GetUriPackageName(const FString& Uri, FName& OutPackageName);
+
+	FUMCP_ResourceSubscriptionsStats GetStats() const;
+
+private:
+	struct FSession
+	{
+		TSet<FString> Uris;
+		TArray<FString> PendingUris; // In the order their packages changed
+		FPollCallback ParkedPoll;
+		double PollTime = 0.0;
+		double LastUsedTime = 0.0;
+	};
+
+	struct FSubscriber
+	{
+		FString SessionId;
+		FString Uri;
+	};
+
+	void RemoveSubscriberLocked(FName PackageName, const FString& SessionId, const FString& Uri);
+	bool TickFromTicker(float DeltaTime);
+	void OnPackageChanged(FName PackageName, EUMCP_PackageChangeKind Kind);
+
+	mutable FCriticalSection Lock;
+	TMap<FString, FSession> Sessions;
+	TMap<FName, TArray<FSubscriber>> PackageSubscribers;
+	TSet<FName> ChangedPackages; // Since FirstChangeTime, not yet handed to the sessions
+	double FirstChangeTime = 0.0;
+	std::atomic<int32> NumSubscriptions{ 0 };
+	FUMCP_ResourceSubscriptionsStats Stats;
+	double CoalesceSeconds = 0.25;
+	double PollTimeoutSeconds = 25.0;
+	double SessionTimeoutSeconds = 600.0;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+	FUMCP_PackageChangeNotifier* PackageChanges = nullptr;
+	FDelegateHandle PackageChangedHandle;
+};
@@ -2,57 +2,299 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
 #include "HttpServerRequest.h"
 #include "HttpServerResponse.h"
 #include "IHttpRouter.h"
 #include "UMCP_Types.h"
 #include "UMCP_UriTemplate.h"
+#include "UMCP_ServerSettings.h"
+#include "UMCP_PackageChangeNotifier.h"
+#include "UMCP_ExportCache.h"
+#include "UMCP_AssetSearchSnapshots.h"
+#include "UMCP_AssetNameIndex.h"
+#include "UMCP_DependencyGraph.h"
+#include "UMCP_BlueprintContentIndex.h"
+#include "UMCP_PackageLoader.h"
+#include "UMCP_LogBuffer.h"
+#include "UMCP_ResourceSubscriptions.h"
 
 // Forward declarations for JSON types (used in helpers)
 struct FUMCP_JsonRpcResponse;
 struct FUMCP_JsonRpcError;
 struct FUMCP_JsonRpcId;
 using UMCP_JsonRpcHandler = TFunction<bool(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError)>;
+// Same contract, but the result is written as already serialized JSON so no DOM is built
+using UMCP_JsonRpcRawHandler = TFunction<bool(const FUMCP_JsonRpcRequest& Request, TArray<uint8>& OutRawResult, FUMCP_JsonRpcError& OutError)>;
+
+struct FUMCP_JsonRpcMethodHandler
+{
+	UMCP_JsonRpcHandler Handler;
+	UMCP_JsonRpcRawHandler RawHandler; // Used instead of Handler when bound
+	EUMCP_ExecutionAffinity ExecutionAffinity = EUMCP_ExecutionAffinity::GameThread;
+	EUMCP_RequestPriority Priority = EUMCP_RequestPriority::Normal;
+};
+
+// Everything received in one HTTP POST: a single JSON-RPC request or a JSON-RPC batch.
+// Entries may complete on different threads; whichever completes the last one sends the HTTP response.
+struct FUMCP_JsonRpcRequestSet
+{
+	TArray<FUMCP_JsonRpcRequest> Requests;
+	TArray<FUMCP_JsonRpcResponse> Responses; // Same indices as Requests, each written by exactly one thread
+	bool bIsBatch = false;
+	EHttpServerResponseCodes ResponseCode = EHttpServerResponseCodes::Ok; // Only used for non-batch requests
+	FUMCP_EventStreamPtr EventStream; // Set when the client accepts `text/event-stream`; used only if something was emitted into it
+	FName ContentEncoding = NAME_None; // NAME_Gzip or NAME_Zlib when the client's Accept-Encoding allows compressing the response
+	FString NewSessionId; // Created by an initialize in this POST and returned in the Mcp-Session-Id header
+	FThreadSafeCounter PendingEntries;
+	FHttpResultCallback OnComplete;
+};
+using FUMCP_JsonRpcRequestSetPtr = TSharedPtr<FUMCP_JsonRpcRequestSet, ESPMode::ThreadSafe>;
+
+// Game thread work waiting for its turn. All game thread entries of one batch share a single queue slot.
+struct FUMCP_QueuedRequest
+{
+	FUMCP_JsonRpcRequestSetPtr RequestSet;
+	TArray<TPair<int32, FUMCP_JsonRpcMethodHandler>> Entries; // Index into RequestSet->Requests + its handler
+	double EnqueueTime = 0.0;
+};
+
+enum class EUMCP_JobStatus : uint8
+{
+	Running,
+	Completed,
+	Failed,
+	Cancelled,
+};
+
+// A tool started with `runAsJob`: stepped from the game thread ticker until it finishes, then kept for status polling
+struct FUMCP_ToolJob
+{
+	FString JobId;
+	FString ToolName;
+	FUMCP_JsonRpcId RequestId; // Id of the tools/call that started it, matched by notifications/cancelled
+	UMCP_ToolJobStep Step; // Only touched on the game thread; released once the job finishes
+	FUMCP_JobContext Context;
+	EUMCP_JobStatus Status = EUMCP_JobStatus::Running; // Guarded by FUMCP_Server::JobsLock, like the members below
+	TArray<uint8> ResultUtf8; // tools/call result once the job is no longer running
+	double StartTime = 0.0;
+	double FinishTime = 0.0;
+};
+using FUMCP_ToolJobPtr = TSharedPtr<FUMCP_ToolJob, ESPMode::ThreadSafe>;
+
+// Serialized form of one of the list endpoints. Register* calls invalidate it and the next list request rebuilds it.
+struct FUMCP_ListingCache
+{
+	TArray<TArray<uint8>> Items; // One condensed UTF-8 JSON object per listed entry, in listing order
+	TArray<uint8> FullPage; // Complete unpaginated result object
+	uint32 Generation = 0; // Bumped on every invalidation so cursors into an older listing are rejected
+	bool bValid = false;
+};
+
+// Snapshot of the game thread request queue for monitoring
+struct FUMCP_GameThreadQueueStats
+{
+	int32 QueueDepth = 0;
+	int32 PeakQueueDepth = 0;
+	uint64 ExecutedRequests = 0;
+	uint64 RejectedRequests = 0;
+	double LastWaitMs = 0.0;
+	double AverageWaitMs = 0.0;
+	double MaxWaitMs = 0.0;
+	double LastTickWorkMs = 0.0;
+};
+
+// Totals for responses compressed because of Accept-Encoding, for monitoring
+struct FUMCP_CompressionStats
+{
+	uint64 CompressedResponses = 0;
+	uint64 UncompressedBytes = 0; // Sum of the payload sizes before compression
+	uint64 CompressedBytes = 0; // Sum of the bodies actually sent
+	double TotalCompressMs = 0.0;
+	double LastRatio = 0.0; // Compressed / uncompressed size of the last compressed response
+	double LastCompressMs = 0.0;
+};
+
+// Fixed bucket latency histogram, cheap enough to update on every request
+struct UNREALMCPSERVER_API FUMCP_LatencyHistogram
+{
+	// Inclusive upper bounds in milliseconds; one extra bucket past the end catches everything slower
+	static constexpr double BucketUpperBoundsMs[] = { 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 25.0, 50.0, 100.0, 250.0, 500.0, 1000.0, 2500.0, 5000.0 };
+	static constexpr int32 NumBuckets = UE_ARRAY_COUNT(BucketUpperBoundsMs) + 1;
+
+	uint64 BucketCounts[NumBuckets] = {};
+	uint64 Count = 0;
+	double TotalMs = 0.0;
+	double MaxMs = 0.0;
+
+	void Add(double Ms);
+	// Upper bound of the bucket holding the given percentile (0-100), or MaxMs if that is the overflow bucket
+	double GetPercentileMs(double Percentile) const;
+	double GetAverageMs() const { return Count > 0 ? TotalMs / static_cast<double>(Count) : 0.0; }
+	TSharedPtr<FJsonObject> ToJsonObject() const;
+};
+
+// Counters for one JSON-RPC method, or one tool for tools/call (keyed "tools/call:<tool name>")
+struct FUMCP_MethodMetrics
+{
+	uint64 Calls = 0;
+	uint64 Errors = 0; // Requests answered with a JSON-RPC error
+	uint64 ToolErrors = 0; // tools/call results with isError set
+	uint64 BytesOut = 0; // Response body bytes before compression; batches are counted under "batch"
+	FUMCP_LatencyHistogram QueueWait; // Only recorded for requests that waited for the game thread
+	FUMCP_LatencyHistogram Execute;
+	FUMCP_LatencyHistogram Serialize;
+};
 
 class UNREALMCPSERVER_API FUMCP_Server
 {
 public:
-	void StartServer();
+	static constexpr uint32 DefaultHttpServerPort = 30069;
+
+	// False if the port's HTTP router can't be had, e.g. because another server is listening on it
+	bool StartServer(uint32 InHttpServerPort = DefaultHttpServerPort);
 	void StopServer();
+	uint32 GetHttpServerPort() const { return HttpServerPort; }
 
 	// Method handlers should return true for success/error (indicating which object to use in the JSON RPC response)
-	void RegisterRpcMethodHandler(const FString& MethodName, UMCP_JsonRpcHandler&& Handler);
+	// Handlers default to the game thread; only pass another affinity if the handler is thread-safe.
+	void RegisterRpcMethodHandler(const FString& MethodName, UMCP_JsonRpcHandler&& Handler, EUMCP_ExecutionAffinity ExecutionAffinity = EUMCP_ExecutionAffinity::GameThread, EUMCP_RequestPriority Priority = EUMCP_RequestPriority::Normal);
+	void RegisterRawRpcMethodHandler(const FString& MethodName, UMCP_JsonRpcRawHandler&& Handler, EUMCP_ExecutionAffinity ExecutionAffinity = EUMCP_ExecutionAffinity::GameThread, EUMCP_RequestPriority Priority = EUMCP_RequestPriority::Normal);
 	bool RegisterTool(FUMCP_ToolDefinition Tool);
 	bool RegisterResource(FUMCP_ResourceDefinition Resource);
 	bool RegisterResourceTemplate(FUMCP_ResourceTemplateDefinition ResourceTemplate);
 	bool RegisterPrompt(FUMCP_PromptDefinitionInternal Prompt);
+
+	const FUMCP_ServerSettings& GetSettings() const { return Settings; }
+	FUMCP_GameThreadQueueStats GetGameThreadQueueStats() const;
+	FUMCP_CompressionStats GetCompressionStats() const;
+	// Shared by every tool and resource that exports assets to text
+	FUMCP_ExportCache& GetExportCache() { return ExportCache; }
+	// Results behind the cursors of the asset search tools
+	FUMCP_AssetSearchSnapshots& GetAssetSearchSnapshots() { return AssetSearchSnapshots; }
+	// Partial name lookups for the asset search tools
+	const FUMCP_AssetNameIndex& GetAssetNameIndex() const { return AssetNameIndex; }
+	// Whole-project dependency graph snapshots for export_dependency_graph
+	FUMCP_DependencyGraph& GetDependencyGraph() { return DependencyGraph; }
+	// Graph content of Blueprints for the content searches of search_blueprints
+	FUMCP_BlueprintContentIndex& GetBlueprintContentIndex() { return BlueprintContentIndex; }
+	// Loads (and releases) the packages of the assets the export tools and resources work on
+	FUMCP_PackageLoader& GetPackageLoader() { return PackageLoader; }
+	// Recent log lines for get_log_lines; safe to read from any thread
+	const FUMCP_LogBuffer& GetLogBuffer() const { return LogBuffer; }
+	// Sessions and their resources/subscribe subscriptions
+	FUMCP_ResourceSubscriptions& GetResourceSubscriptions() { return ResourceSubscriptions; }
+	TMap<FString, FUMCP_MethodMetrics> GetMethodMetrics() const;
+	// Everything above as one JSON document, served as the unreal+metrics://server resource
+	TSharedPtr<FJsonObject> GetMetricsJson() const;
+
+	// Tool jobs, see FUMCP_ToolDefinition::StartJob. Safe to call from any thread.
+	bool GetJobStatus(const FString& JobId, FUMCP_JobStatusResult& OutStatus) const;
+	bool CancelJob(const FString& JobId);
+
 private:
     void HandleStreamableHTTPMCPRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+	// GET /mcp waits for notifications/resources/updated of the session, DELETE /mcp ends it
+	void HandleSessionRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+	const FUMCP_ToolDefinition* FindCalledTool(const FUMCP_JsonRpcRequest& RpcRequest) const;
+	// Runs the tool's schema builders and adds runAsJob to job tools. Returns false if that was already done.
+	bool ResolveToolSchemas(FUMCP_ToolDefinition& Tool);
+	EUMCP_ExecutionAffinity ResolveExecutionAffinity(const FUMCP_JsonRpcRequest& RpcRequest, const FUMCP_JsonRpcMethodHandler& MethodHandler) const;
+	EUMCP_RequestPriority ResolveRequestPriority(const FUMCP_JsonRpcRequest& RpcRequest, const FUMCP_JsonRpcMethodHandler& MethodHandler) const;
+	// QueueWaitMs is negative for requests that did not go through the game thread queue
+	void ExecuteJsonRpcRequest(const FUMCP_JsonRpcRequest& RpcRequest, const FUMCP_JsonRpcMethodHandler& MethodHandler, FUMCP_JsonRpcResponse& OutResponse, double QueueWaitMs = -1.0);
+	void CompleteRequestSetEntry(const FUMCP_JsonRpcRequestSetPtr& RequestSet);
+	void SendRequestSetResponse(const FUMCP_JsonRpcRequestSet& RequestSet);
+
+	// Per-method metrics. Keys are limited to registered methods and tools so bad requests can't grow the map.
+	FString GetMetricsKey(const FUMCP_JsonRpcRequest& RpcRequest) const;
+	void RecordExecution(const FString& MetricsKey, double QueueWaitMs, double ExecuteMs, bool bIsError);
+	void RecordSerialization(const FString& MetricsKey, double SerializeMs, int32 NumBytes);
+	void RegisterMetricsResource();
 
     static const FString MCP_PROTOCOL_VERSION;
     static const FString PLUGIN_VERSION;
 	
     // Helper methods for sending responses
-    static void SendJsonRpcResponse(const FHttpResultCallback& OnComplete, const FUMCP_JsonRpcResponse& Response);
+    void SendJsonRpcResponse(const FHttpResultCallback& OnComplete, const FUMCP_JsonRpcResponse& Response, EHttpServerResponseCodes ResponseCode = EHttpServerResponseCodes::Ok, FName ContentEncoding = NAME_None);
+    void SendJsonPayload(const FHttpResultCallback& OnComplete, TArray<uint8>&& JsonPayload, EHttpServerResponseCodes ResponseCode, const TCHAR* ContentType = TEXT("application/json"), FName ContentEncoding = NAME_None, const FString& SessionId = FString());
+    static TArray<uint8> BuildEventStreamBody(const FUMCP_JsonRpcRequestSet& RequestSet);
+    // Compresses in place with FCompression. Returns false (leaving the payload untouched) if it did not get smaller.
+    bool CompressPayload(TArray<uint8>& InOutPayload, FName ContentEncoding);
+
+	// Game thread request queue, drained from a core ticker under Settings.GameThreadBudgetMs
+	bool EnqueueGameThreadRequest(FUMCP_QueuedRequest&& QueuedRequest, EUMCP_RequestPriority Priority);
+	bool DequeueGameThreadRequest(FUMCP_QueuedRequest& OutQueuedRequest);
+	bool TickGameThreadQueue(float DeltaTime);
+	void FlushGameThreadQueue();
+
+	// Tool jobs, stepped after the game thread queue with whatever budget it left
+	FString StartToolJob(const FUMCP_ToolDefinition& Tool, const FUMCP_JsonRpcRequest& Request, UMCP_ToolJobStep&& Step);
+	static void RunToolJobInline(const UMCP_ToolJobStep& Step, FUMCP_CallToolResult& OutResult);
+	void TickToolJobs(double DeadlineTime);
+	bool StepToolJob(FUMCP_ToolJob& Job); // Returns true if the job has more work ready right away
+
+	// Cached listings, built on first use with BuildItems and paginated by Settings.ListPageSize
+	void InvalidateListing(FUMCP_ListingCache& Cache);
+	bool ServeListing(FUMCP_ListingCache& Cache, const TCHAR* FieldName, TFunctionRef<void(TArray<TSharedPtr<FJsonObject>>&)> BuildItems, const FString& Cursor, TArray<uint8>& OutRawResult, FUMCP_JsonRpcError& OutError);
+	static void AppendListingPage(const FUMCP_ListingCache& Cache, const TCHAR* FieldName, int32 Begin, int32 End, TArray<uint8>& InOutUtf8);
 
 	void RegisterInternalRpcMethodHandlers();
 	bool Rpc_Initialize(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError);
 	bool Rpc_Ping(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError);
 	bool Rpc_ClientNotifyInitialized(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError);
-	bool Rpc_ToolsList(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError);
-	bool Rpc_ToolsCall(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError);
+	bool Rpc_ClientNotifyCancelled(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError);
+	bool Rpc_ToolsList(const FUMCP_JsonRpcRequest& Request, TArray<uint8>& OutRawResult, FUMCP_JsonRpcError& OutError);
+	bool Rpc_ToolsCall(const FUMCP_JsonRpcRequest& Request, TArray<uint8>& OutRawResult, FUMCP_JsonRpcError& OutError);
+	void WriteToolCallResult(const FUMCP_ToolDefinition& Tool, const FUMCP_CallToolResult& Result, bool bMatchesOutputSchema, TArray<uint8>& OutRawResult) const;
+	void ValidateStructuredContent(const FUMCP_ToolDefinition& Tool, const FJsonObject* StructuredContent, TConstArrayView<uint8> StructuredContentUtf8) const;
 	bool Rpc_ResourcesList(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError);
-	bool Rpc_ResourcesTemplatesList(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError);
-	bool Rpc_ResourcesRead(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError);
-	bool Rpc_PromptsList(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError);
+	bool Rpc_ResourcesTemplatesList(const FUMCP_JsonRpcRequest& Request, TArray<uint8>& OutRawResult, FUMCP_JsonRpcError& OutError);
+	bool Rpc_ResourcesRead(const FUMCP_JsonRpcRequest& Request, TArray<uint8>& OutRawResult, FUMCP_JsonRpcError& OutError);
+	bool Rpc_ResourcesSubscribe(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError);
+	bool Rpc_ResourcesUnsubscribe(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError);
+	bool Rpc_PromptsList(const FUMCP_JsonRpcRequest& Request, TArray<uint8>& OutRawResult, FUMCP_JsonRpcError& OutError);
 	bool Rpc_PromptsGet(const FUMCP_JsonRpcRequest& Request, TSharedPtr<FJsonObject> OutSuccess, FUMCP_JsonRpcError& OutError);
 
     TSharedPtr<IHttpRouter> HttpRouter;
-    uint32 HttpServerPort = 30069;
-	TMap<FString, UMCP_JsonRpcHandler> JsonRpcMethodHandlers;
+    uint32 HttpServerPort = DefaultHttpServerPort;
+	TMap<FString, FUMCP_JsonRpcMethodHandler> JsonRpcMethodHandlers;
+	FThreadSafeCounter PendingTaskGraphRequests;
+	FUMCP_ServerSettings Settings;
+
+	TQueue<FUMCP_QueuedRequest, EQueueMode::Mpsc> GameThreadQueues[static_cast<int32>(EUMCP_RequestPriority::Count)];
+	FThreadSafeCounter GameThreadQueueDepth;
+	FTSTicker::FDelegateHandle GameThreadQueueTickerHandle;
+	mutable FCriticalSection QueueStatsLock;
+	FUMCP_GameThreadQueueStats QueueStats;
+	mutable FCriticalSection CompressionStatsLock;
+	FUMCP_CompressionStats CompressionStats;
+	FUMCP_PackageChangeNotifier PackageChangeNotifier; // Declared before its listeners so it is destroyed after them
+	FUMCP_ExportCache ExportCache;
+	FUMCP_AssetSearchSnapshots AssetSearchSnapshots;
+	FUMCP_AssetNameIndex AssetNameIndex;
+	FUMCP_DependencyGraph DependencyGraph;
+	FUMCP_BlueprintContentIndex BlueprintContentIndex;
+	FUMCP_PackageLoader PackageLoader;
+	FUMCP_LogBuffer LogBuffer;
+	FUMCP_ResourceSubscriptions ResourceSubscriptions;
+	mutable FCriticalSection MetricsLock;
+	TMap<FString, FUMCP_MethodMetrics> MethodMetrics;
+	mutable FCriticalSection JobsLock;
+	TMap<FString, FUMCP_ToolJobPtr> Jobs;
+	uint32 JobRoundRobinOffset = 0;
     FHttpRouteHandle RouteHandle_MCPStreamableHTTP;
 	TMap<FString, FUMCP_ToolDefinition> Tools;
+	FCriticalSection ToolSchemasLock;
 	TMap<FString, FUMCP_ResourceDefinition> Resources;
 	TArray<TPair<FUMCP_UriTemplate, FUMCP_ResourceTemplateDefinition>> ResourceTemplates;
+	FUMCP_UriTemplateRouter ResourceTemplateRouter; // Indices into ResourceTemplates, keyed by each template's leading literal
 	TMap<FString, FUMCP_PromptDefinitionInternal> Prompts;
+
+	FCriticalSection ListingCacheLock;
+	FUMCP_ListingCache ToolsListing;
+	FUMCP_ListingCache ResourceTemplatesListing;
+	FUMCP_ListingCache PromptsListing;
 };
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "UMCP_ServerCommandlet.generated.h"
+
+/**
+ * Runs the MCP server without the editor UI, e.g. on build machines:
+ *   UnrealEditor-Cmd <Project>.uproject -run=UnrealMCPServer -port=30070 -nullrhi -unattended -nosplash
+ * The asset registry is searched synchronously first, then the server is started headless (without
+ * request_editor_compile and Live Coding) and the commandlet pumps the game thread tasks, async package loading and the
+ * core ticker, which drives the HTTP listeners and the request queue, until the engine is asked to exit (Ctrl+C or the
+ * quit command).
+ * -port defaults to 30069, so instances on one machine need a port each.
+ */
+UCLASS()
+class UNREALMCPSERVER_API UUnrealMCPServerCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UUnrealMCPServerCommandlet();
+
+	// UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+};
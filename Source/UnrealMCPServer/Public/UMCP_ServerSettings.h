@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Runtime settings for FUMCP_Server.
+ * Defaults live here; overrides are read from the [UnrealMCPServer.Server] section of BaseUnrealMCPServer.ini
+ * (or the project's DefaultUnrealMCPServer.ini).
+ */
+struct UNREALMCPSERVER_API FUMCP_ServerSettings
+{
+	/** Game thread time (in milliseconds) the request queue may consume per frame before yielding back to the editor. */
+	float GameThreadBudgetMs = 5.0f;
+
+	/** Maximum number of requests waiting for the game thread. Further requests are rejected with HTTP 503 / "Server busy". */
+	int32 MaxQueuedGameThreadRequests = 256;
+
+	/** Entries per page for tools/list, prompts/list and resources/templates/list. 0 returns everything in one page. */
+	int32 ListPageSize = 0;
+
+	/** Responses at least this many bytes are gzip/deflate compressed when the client's Accept-Encoding allows it. 0 disables compression. */
+	int32 CompressionThresholdBytes = 8192;
+
+	/** How long (in seconds) a finished tool job stays available to get_job_status before it is discarded. */
+	float FinishedJobRetentionSeconds = 600.0f;
+
+	/** Flush GLog after every tools/call so the log file is complete before the response is sent. Off by default because it blocks on file I/O. */
+	bool bFlushLogAfterToolCall = false;
+
+	/** Memory budget (in megabytes) of the export cache shared by the T3D/Markdown tools and resources. 0 disables the cache. */
+	int32 ExportCacheBudgetMB = 256;
+
+	/** Also keep exports of unmodified packages under Saved/UnrealMCPServer/ExportCache so they survive editor restarts. */
+	bool bExportCacheDiskTier = false;
+
+	/** Disk budget (in megabytes) of the export cache's disk tier. The least recently used files over it are deleted. */
+	int32 ExportCacheDiskBudgetMB = 1024;
+
+	/** Memory budget (in megabytes) for the result snapshots behind search_assets/search_blueprints cursors. 0 disables cursors. */
+	int32 SearchSnapshotBudgetMB = 64;
+
+	/** How long (in seconds) an unused search snapshot is kept before its cursor expires. */
+	float SearchSnapshotTtlSeconds = 300.0f;
+
+	/** Keep a trigram index of asset, package and parent class names so partial name searches need no path or class scope. */
+	bool bAssetNameIndex = true;
+
+	/** Package loads the export tools keep in flight ahead of the asset being exported (batch exports, index_blueprints). */
+	int32 ExportLoadConcurrency = 8;
+
+	/** Used physical memory (in megabytes) above which packages the server loaded only for exports are released and garbage collected. 0 never releases them. */
+	int32 ExportMemoryWatermarkMB = 16384;
+
+	/** Recent log lines kept in memory for get_log_lines (about 2 KB each, at most 100000). 0 disables the buffer. */
+	int32 LogBufferLines = 8192;
+
+	/** How long (in milliseconds) changes to subscribed resources are collected before notifications/resources/updated is sent. */
+	int32 ResourceNotifyCoalesceMs = 250;
+
+	/** How long (in seconds) a GET /mcp waits for a resource notification before it is answered with nothing. */
+	float ResourcePollTimeoutSeconds = 25.0f;
+
+	/** How long (in seconds) an Mcp-Session-Id that sends no requests is kept, along with its subscriptions. */
+	float SessionIdleTimeoutSeconds = 600.0f;
+
+	/** Load overrides from the plugin config, clamping values to sane ranges. */
+	void LoadFromConfig();
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+// JSON serialization of USTRUCTs through a plan cached per UScriptStruct.
+// The first use of a struct walks its FProperty chain once and records each property's offset, JSON key (the same
+// key FJsonObjectConverter would use) and a type-specific reader/writer. Later calls only run the plan: results are
+// written straight to condensed UTF-8 and parsed straight into the struct, without an intermediate FJsonObject.
+// Properties the plan has no dedicated writer for (objects, enums, text, sets, structs with ExportTextItem, ...)
+// go through FJsonObjectConverter for that one property, so the output matches the converter's.
+// UMCP_ToJsonObject, UMCP_ToJsonString, UMCP_CreateFromJsonObject and UMCP_SetStructuredContent are built on this.
+class UNREALMCPSERVER_API FUMCP_StructSerializer
+{
+public:
+	// Appends the struct as a condensed JSON object
+	static bool WriteJsonUtf8(const UScriptStruct* Struct, const void* StructData, TArray<uint8>& InOutUtf8);
+
+	// Adds the struct's fields to an existing JSON object, for callers that need a DOM
+	static bool WriteJsonObject(const UScriptStruct* Struct, const void* StructData, FJsonObject& OutJsonObject);
+
+	// Fields missing from the JSON keep their current value, and unknown JSON fields are ignored.
+	// Keys match case-insensitively, like FJsonObjectConverter.
+	static bool ReadJsonObject(const UScriptStruct* Struct, const FJsonObject& JsonObject, void* OutStructData);
+	static bool ReadJsonUtf8(const UScriptStruct* Struct, TConstArrayView<uint8> Utf8Json, void* OutStructData);
+};
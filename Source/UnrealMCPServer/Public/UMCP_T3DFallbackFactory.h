@@ -28,5 +28,15 @@ public:
 	 * @param SupportedClass The class to temporarily support, or nullptr to disable
 	 */
 	static void SetSupportedClass(UClass* SupportedClass);
+
+	/**
+	 * Set whether imports call PreEditChange/PostEditChange on the properties they set. Batch imports turn this off
+	 * and call PostEditChange once per asset when the batch is done.
+	 * @param bCallEditChange Whether to send the notifications, true by default
+	 */
+	static void SetCallEditChange(bool bCallEditChange);
+
+private:
+	bool bCallEditChange = true;
 };
 
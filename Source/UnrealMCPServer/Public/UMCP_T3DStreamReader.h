@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+// Reads a T3D file in chunks that ImportObjectProperties can import one after another, so importing a file of
+// hundreds of MB never holds it as one UTF-16 string. The file is memory-mapped (or, where the platform can't map
+// it, read as bytes) and each chunk is converted from UTF-8 or UTF-16LE into one reused buffer.
+// Chunks end on a line boundary once they hold TargetChunkChars, but only between top-level blocks or between the
+// blocks and property lines directly inside a top-level "Begin Object". A chunk that ends inside that object is
+// closed with "End Object" and the next one starts with the object's own "Begin Object" line again, so each chunk
+// is complete T3D for the same object. Lines inside {} are never split. A file smaller than TargetChunkChars is one
+// chunk with exactly the file's text.
+class UNREALMCPSERVER_API FUMCP_T3DStreamReader
+{
+public:
+	static constexpr int32 DefaultTargetChunkChars = 1024 * 1024;
+
+	explicit FUMCP_T3DStreamReader(int32 InTargetChunkChars = DefaultTargetChunkChars);
+	~FUMCP_T3DStreamReader();
+
+	// False if the file can't be opened or is UTF-16 big endian
+	bool Open(const FString& Filename);
+
+	// Reads from Bytes instead of a file, as Open does where mapping isn't supported
+	bool OpenBytes(TArray<uint8>&& InBytes);
+
+	// The next chunk as null-terminated text, valid until the next call. False once the file is done.
+	bool ReadChunk(const TCHAR*& OutText);
+
+	bool IsMapped() const { return MappedRegion.IsValid(); }
+
+	// Where the object blocks of exported T3D text start, for reading an export block by block: every top-level
+	// "Begin" block and every block directly inside one, with the lines between them (such as the properties of a
+	// top-level object) as blocks of their own. The first block starts at 0; OutBlockStarts is empty for empty text.
+	static void FindObjectBlocks(FStringView Text, TArray<int32>& OutBlockStarts);
+
+private:
+	enum class EEncoding : uint8
+	{
+		UTF8,
+		UTF16LE
+	};
+
+	bool OpenData(const uint8* InData, int64 InSize);
+
+	template <typename CharType>
+	bool ReadChunkFrom(const CharType* Chars, int64 NumChars);
+
+	template <typename CharType>
+	void AppendConverted(const CharType* Chars, int64 NumChars);
+
+	int32 TargetChunkChars;
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray<uint8> Bytes;
+	const uint8* Data = nullptr; // Text after the byte order mark
+	int64 Size = 0;
+	EEncoding Encoding = EEncoding::UTF8;
+	int64 Position = 0; // In characters of Encoding
+	int32 BlockDepth = 0; // Begin/End nesting
+	int32 BraceDepth = 0; // {} nesting, which continues a line the way FParse::LineExtended does
+	bool bQuoted = false;
+	TArray<TCHAR> TopLevelObjectHeader; // The line that opened the current top-level "Begin Object", if any
+	bool bResumeTopLevelObject = false; // The previous chunk ended inside that object
+	TArray<TCHAR> Buffer;
+};
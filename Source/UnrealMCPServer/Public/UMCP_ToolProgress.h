@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UMCP_Types.h"
+
+// Progress reporting for long running tools.
+// FUMCP_Server installs a scope on the executing thread for the duration of a tools/call when the client sent
+// `params._meta.progressToken` and accepts `text/event-stream`. Tools call the statics below from that same thread;
+// without a scope every call is a cheap no-op, so tools can report unconditionally.
+class UNREALMCPSERVER_API FUMCP_ToolProgress
+{
+public:
+	static bool IsActive();
+
+	// Sends `notifications/progress`. A Total of zero or less means the total is unknown.
+	static void Report(double Progress, double Total = 0.0, const FString& Message = FString());
+
+	// Sends one content entry ahead of the final result as `notifications/unreal/partialContent`
+	static void EmitPartialContent(const FUMCP_CallToolResultContent& Content);
+};
+
+// Installed by FUMCP_Server around a single tool call
+class UNREALMCPSERVER_API FUMCP_ToolProgressScope
+{
+public:
+	explicit FUMCP_ToolProgressScope(const FUMCP_JsonRpcRequest& Request);
+	~FUMCP_ToolProgressScope();
+	UE_NONCOPYABLE(FUMCP_ToolProgressScope);
+
+private:
+	friend class FUMCP_ToolProgress;
+
+	// Appends `{"jsonrpc":"2.0","method":<Method>,"params":{"progressToken":<token>,<AppendParams>}}` to the event stream
+	void AppendNotification(FAnsiStringView Method, TFunctionRef<void(TArray<uint8>&)> AppendParams) const;
+
+	FUMCP_EventStreamPtr EventStream;
+	TArray<uint8> ProgressTokenUtf8; // Already serialized; a progress token is either a string or an integer
+	FUMCP_ToolProgressScope* PreviousScope = nullptr;
+};
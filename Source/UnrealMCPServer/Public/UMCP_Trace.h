@@ -0,0 +1,16 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+// Unreal Insights channel for MCP work. Enable it together with the CPU channel, e.g. `-trace=cpu,frame,UnrealMCP`,
+// and request dispatch, tool execution, ExportText, LoadObject and AssetRegistry queries show up next to the frame timeline.
+UE_TRACE_CHANNEL_EXTERN(UnrealMCPChannel, UNREALMCPSERVER_API);
+
+// Timing scope with a static name. Costs a channel check when the channel is off.
+#define UMCP_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, UnrealMCPChannel)
+
+// Timing scope with a runtime name (e.g. the JSON-RPC method). The argument is evaluated even with the channel off,
+// so pass an existing string rather than formatting one.
+#define UMCP_TRACE_SCOPE_TEXT(Text) TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(Text, UnrealMCPChannel)
@@ -17,7 +17,10 @@
 #include "JsonUtilities.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonReader.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
 #include "UMCP_UriTemplate.h"
+#include "UMCP_StructSerializer.h"
 #include "UMCP_Types.generated.h"
 
 // Standard JSON-RPC 2.0 Error Codes & MCP Specific Codes
@@ -31,6 +34,7 @@ enum class EUMCP_JsonRpcErrorCode : int32
     InvalidParams = -32602,
     InternalError = -32603,
     ServerError = -32000, // Generic server error base
+    ServerBusy = -32001, // Game thread request queue is full, client should back off and retry
 
     // -32000 to -32099 are reserved for implementation-defined server-errors.
     // We can add more specific server errors in this range if needed.
@@ -72,6 +76,23 @@ public:
 // Forward declaration
 struct FUMCP_JsonRpcError;
 
+// Server-sent events for one HTTP response that is answered as `text/event-stream`.
+// Shared by every request of the POST; tools append to it from whichever thread they run on.
+class UNREALMCPSERVER_API FUMCP_EventStream
+{
+public:
+	// Frames one condensed JSON-RPC message as an SSE `message` event
+	void AppendMessage(TConstArrayView<uint8> Utf8JsonMessage);
+	bool HasEvents() const;
+	// Moves the framed events out, leaving the stream empty
+	TArray<uint8> TakeBody();
+
+private:
+	mutable FCriticalSection Lock;
+	TArray<uint8> Body;
+};
+using FUMCP_EventStreamPtr = TSharedPtr<FUMCP_EventStream, ESPMode::ThreadSafe>;
+
 USTRUCT()
 struct FUMCP_JsonRpcRequest
 {
@@ -85,10 +106,14 @@ struct FUMCP_JsonRpcRequest
 
     TSharedPtr<FJsonObject> params; // Using TSharedPtr<FJsonObject> for params
     FUMCP_JsonRpcId id;
+    bool bIsNotification = false; // No "id" member was sent, so JSON-RPC batches omit the response
+    FUMCP_EventStreamPtr EventStream; // Set when the client accepts `text/event-stream`, see FUMCP_ToolProgress
+    FString SessionId; // Mcp-Session-Id header of the POST, or the session an initialize in it created; empty without one
 
     FUMCP_JsonRpcRequest() : jsonrpc(TEXT("2.0")) {}
     bool ToJsonString(FString& OutJsonString) const;
     static bool CreateFromJsonString(const FString& JsonString, FUMCP_JsonRpcRequest& OutRequest);
+    static bool CreateFromJsonObject(const TSharedPtr<FJsonObject>& JsonObject, FUMCP_JsonRpcRequest& OutRequest);
 };
 
 USTRUCT()
@@ -127,21 +152,45 @@ struct FUMCP_JsonRpcResponse
 
     // Result can be any valid JSON value (object, array, string, number, boolean, null)
     TSharedPtr<FJsonValue> result; 
+
+    // Already serialized UTF-8 JSON for the result, written out verbatim instead of `result` (cached listings, tool calls)
+    TArray<uint8> rawResult;
     
     TSharedPtr<FUMCP_JsonRpcError> error; // Error object if an error occurred
 
     FUMCP_JsonRpcResponse() : jsonrpc(TEXT("2.0")) {}
 
+    bool ToJsonObject(TSharedPtr<FJsonObject>& OutJsonObject) const;
     bool ToJsonString(FString& OutJsonString) const;
+    // Appends the condensed UTF-8 JSON of the response, which is what goes over the wire
+    bool ToJsonUtf8(TArray<uint8>& InOutUtf8) const;
+    static bool BatchToJsonUtf8(const TArray<const FUMCP_JsonRpcResponse*>& Responses, TArray<uint8>& InOutUtf8);
     static bool CreateFromJsonString(const FString& JsonString, FUMCP_JsonRpcResponse& OutResponse);
 };
 
+// UTF-8 JSON helpers for the HTTP transport, so request and response bodies never round trip through FString.
+// All Append/Serialize helpers append to the buffer instead of replacing it.
+UNREALMCPSERVER_API bool UMCP_DeserializeJsonUtf8(TConstArrayView<uint8> Utf8Json, TSharedPtr<FJsonValue>& OutValue);
+UNREALMCPSERVER_API bool UMCP_SerializeJsonUtf8(const TSharedRef<FJsonObject>& JsonObject, TArray<uint8>& InOutUtf8);
+UNREALMCPSERVER_API void UMCP_AppendUtf8(TArray<uint8>& InOutUtf8, FAnsiStringView Literal);
+UNREALMCPSERVER_API void UMCP_AppendJsonString(TArray<uint8>& InOutUtf8, FStringView Text); // Quoted and escaped
+UNREALMCPSERVER_API void UMCP_AppendJsonStringUtf8(TArray<uint8>& InOutUtf8, TConstArrayView<uint8> Utf8Text); // Quoted and escaped
+UNREALMCPSERVER_API FString UMCP_Utf8ToString(TConstArrayView<uint8> Utf8);
+
 // MCP Specific Structures
+// USTRUCT <-> JSON conversions run the cached per-struct plans of FUMCP_StructSerializer (same keys as FJsonObjectConverter)
 template<typename T>
 UNREALMCPSERVER_API bool UMCP_ToJsonObject(const T& InStruct, TSharedPtr<FJsonObject>& OutJsonObject)
 {
 	if (!OutJsonObject.IsValid()) return false;
-	return FJsonObjectConverter::UStructToJsonObject(InStruct.StaticStruct(), &InStruct, OutJsonObject.ToSharedRef());
+	return FUMCP_StructSerializer::WriteJsonObject(InStruct.StaticStruct(), &InStruct, *OutJsonObject);
+}
+
+// Appends the USTRUCT as condensed UTF-8 JSON without building a DOM
+template<typename T>
+UNREALMCPSERVER_API bool UMCP_ToJsonUtf8(const T& InStruct, TArray<uint8>& InOutUtf8)
+{
+	return FUMCP_StructSerializer::WriteJsonUtf8(InStruct.StaticStruct(), &InStruct, InOutUtf8);
 }
 
 // Helper function to convert USTRUCT directly to JSON string
@@ -149,21 +198,27 @@ UNREALMCPSERVER_API bool UMCP_ToJsonObject(const T& InStruct, TSharedPtr<FJsonOb
 template<typename T>
 UNREALMCPSERVER_API bool UMCP_ToJsonString(const T& InStruct, FString& OutJsonString)
 {
-	TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
-	if (!UMCP_ToJsonObject(InStruct, JsonObject))
+	TArray<uint8> Utf8Json;
+	if (!UMCP_ToJsonUtf8(InStruct, Utf8Json))
 	{
 		return false;
 	}
-	
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutJsonString);
-	return FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+	OutJsonString = UMCP_Utf8ToString(Utf8Json);
+	return true;
 }
 
 template<typename T>
 UNREALMCPSERVER_API bool UMCP_CreateFromJsonObject(const TSharedPtr<FJsonObject>& JsonObject, T& OutStruct, bool bAllowMissingObject = false)
 {
 	if (!JsonObject.IsValid()) return bAllowMissingObject;
-	return FJsonObjectConverter::JsonObjectToUStruct(JsonObject.ToSharedRef(), &OutStruct, 0, 0);
+	return FUMCP_StructSerializer::ReadJsonObject(OutStruct.StaticStruct(), *JsonObject, &OutStruct);
+}
+
+// Parses UTF-8 JSON straight into the USTRUCT without building a DOM
+template<typename T>
+UNREALMCPSERVER_API bool UMCP_CreateFromJsonUtf8(TConstArrayView<uint8> Utf8Json, T& OutStruct)
+{
+	return FUMCP_StructSerializer::ReadJsonUtf8(OutStruct.StaticStruct(), Utf8Json, &OutStruct);
 }
 
 USTRUCT()
@@ -204,7 +259,7 @@ struct FUMCP_ServerCapabilitiesResources
     bool listChanged = false; // Deferred as SSE is deferred
 
     UPROPERTY()
-    bool subscribe = false; // Deferred as SSE is deferred
+    bool subscribe = true; // Per Mcp-Session-Id, delivered to GET /mcp, see FUMCP_ResourceSubscriptions
 };
 
 USTRUCT()
@@ -303,9 +358,34 @@ struct UNREALMCPSERVER_API FUMCP_CallToolResultContent
 	UPROPERTY()
 	FString type;
 
+	// Structured result of a `text` entry. When set, the server serializes it once and uses the output both as `text`
+	// and as the call's `structuredContent`, so tools never need to serialize their result themselves.
+	TSharedPtr<FJsonObject> structuredContent;
+
+	// Structured result already serialized to UTF-8 JSON; what UMCP_SetStructuredContent fills, so no DOM is built.
+	// Used like structuredContent, which takes precedence when both are set.
+	TArray<uint8> structuredContentUtf8;
+
+	bool HasStructuredContent() const { return structuredContent.IsValid() || structuredContentUtf8.Num() > 0; }
+
+	// Appends the UTF-8 `text` of the entry: the structured content if set, otherwise `text` transcoded
+	void AppendTextUtf8(TArray<uint8>& InOutUtf8) const;
+	// Appends the entry as a JSON object, using TextUtf8 (from AppendTextUtf8) for its `text` field
+	void AppendJsonUtf8(TArray<uint8>& InOutUtf8, TConstArrayView<uint8> TextUtf8) const;
+
 	//TODO add embedded resource
 };
 
+// Helper for tool results: store a result USTRUCT as the structured content of a `text` entry.
+// The struct is written straight to UTF-8; build `structuredContent` with UMCP_ToJsonObject instead if it needs editing.
+template<typename T>
+bool UMCP_SetStructuredContent(const T& InStruct, FUMCP_CallToolResultContent& OutContent)
+{
+	OutContent.structuredContent.Reset();
+	OutContent.structuredContentUtf8.Reset();
+	return UMCP_ToJsonUtf8(InStruct, OutContent.structuredContentUtf8);
+}
+
 USTRUCT()
 struct FUMCP_CallToolResult
 {
@@ -327,8 +407,69 @@ struct FUMCP_ListToolsParams
 	FString cursor;
 };
 
+// Which thread a tool or RPC method handler is allowed to execute on.
+// Anything that touches UObjects, the editor or the transaction system must stay on the game thread.
+enum class EUMCP_ExecutionAffinity : uint8
+{
+	GameThread, // Marshalled onto the game thread (default)
+	AnyThread,  // Cheap and thread-safe; executed on a high priority background task, never waiting for the game thread
+	TaskGraph,  // Thread-safe but potentially expensive (e.g. asset registry queries); executed on a background task
+};
+
+// Ordering of requests waiting in the game thread queue. Higher priorities are always drained first.
+enum class EUMCP_RequestPriority : uint8
+{
+	High,   // Cheap, latency sensitive calls (ping, listings)
+	Normal, // Default
+	Low,    // Heavy work such as batch exports, imports and compiles
+	Count
+};
+
 DECLARE_DELEGATE_RetVal_TwoParams(bool, FUMCP_ToolCall, TSharedPtr<FJsonObject> /* arguments */, TArray<FUMCP_CallToolResultContent>& /* OutContent */);
 
+// What a tool job wants to happen after one of its steps
+enum class EUMCP_JobStepResult : uint8
+{
+	Continue, // More work is ready; call again as soon as the game thread budget allows
+	Wait,     // Waiting on something external (e.g. a Live Coding compile); call again on a later tick
+	Finished, // The result passed to the step holds the final tool result
+};
+
+// Progress and cancellation of a running tool job, handed to every step. Safe to read from any thread.
+class UNREALMCPSERVER_API FUMCP_JobContext
+{
+public:
+	explicit FUMCP_JobContext(bool bInInline = false) : bInline(bInInline) {}
+
+	// Inline steps run back to back inside the tools/call, so there is no later tick to wait for (e.g. async loads)
+	bool IsInline() const { return bInline; }
+	bool IsCancelRequested() const { return bCancelRequested; }
+	void RequestCancel() { bCancelRequested = true; }
+
+	// Stored for job status polling, and forwarded to FUMCP_ToolProgress when the tool runs as a plain tools/call
+	void ReportProgress(double InProgress, double InTotal = 0.0, const FString& InMessage = FString());
+	void GetProgress(double& OutProgress, double& OutTotal, FString& OutMessage) const;
+
+private:
+	const bool bInline;
+	std::atomic<bool> bCancelRequested{ false };
+	mutable FCriticalSection Lock;
+	double Progress = 0.0;
+	double Total = 0.0;
+	FString Message;
+};
+
+// One unit of work of a tool job (e.g. one asset). Steps run on the game thread between frames.
+// Once cancellation is requested the step is called one last time and should finish with whatever it has done so far.
+using UMCP_ToolJobStep = TFunction<EUMCP_JobStepResult(FUMCP_JobContext& Context, FUMCP_CallToolResult& OutResult)>;
+
+// Validates the arguments and returns the step function; failures fill OutContent like a failed FUMCP_ToolCall.
+// No work should start here, the first step does that.
+DECLARE_DELEGATE_RetVal_ThreeParams(bool, FUMCP_ToolJobStart, TSharedPtr<FJsonObject> /* arguments */, UMCP_ToolJobStep& /* OutStep */, TArray<FUMCP_CallToolResultContent>& /* OutContent */);
+
+// Generates a tool schema on demand, see UMCP_DeferJsonSchemaFromStruct
+using UMCP_JsonSchemaBuilder = TFunction<TSharedPtr<FJsonObject>()>;
+
 USTRUCT()
 struct UNREALMCPSERVER_API FUMCP_ToolDefinition
 {
@@ -342,9 +483,20 @@ struct UNREALMCPSERVER_API FUMCP_ToolDefinition
 
 	TSharedPtr<FJsonObject> inputSchema;
 	TSharedPtr<FJsonObject> outputSchema; // Optional output schema for tools with well-known output formats
+	// When bound, these replace inputSchema/outputSchema the first time the tool is listed or called,
+	// so registering a tool doesn't pay for schema generation during editor startup
+	UMCP_JsonSchemaBuilder InputSchemaBuilder;
+	UMCP_JsonSchemaBuilder OutputSchemaBuilder;
+	bool bSchemasResolved = false;
 	FUMCP_ToolCall DoToolCall;
-
-	FUMCP_ToolDefinition(): name{}, description{}, inputSchema{ MakeShared<FJsonObject>() }, outputSchema{ nullptr }, DoToolCall()
+	// Alternative to DoToolCall for long running tools. Clients pass `runAsJob: true` to get a job id back right away;
+	// otherwise the steps run to completion inside the tools/call.
+	FUMCP_ToolJobStart StartJob;
+	bool bSingleInstanceJob = false; // Starting a job while one of this tool is running returns the running job instead
+	EUMCP_ExecutionAffinity ExecutionAffinity; // Tools that only read thread-safe state can opt out of the game thread hop
+	EUMCP_RequestPriority Priority; // Position in the game thread queue relative to other waiting requests
+
+	FUMCP_ToolDefinition(): name{}, description{}, inputSchema{ MakeShared<FJsonObject>() }, outputSchema{ nullptr }, DoToolCall(), ExecutionAffinity{ EUMCP_ExecutionAffinity::GameThread }, Priority{ EUMCP_RequestPriority::Normal }
 	{
 		inputSchema->SetStringField(TEXT("type"), TEXT("object"));
 	}
@@ -362,6 +514,37 @@ struct FUMCP_ListToolsResult
 	TArray<FUMCP_ToolDefinition> tools;
 };
 
+// Status of a tool job, returned when the job is started and by get_job_status
+USTRUCT()
+struct UNREALMCPSERVER_API FUMCP_JobStatusResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString jobId;
+
+	UPROPERTY()
+	FString toolName;
+
+	UPROPERTY()
+	FString status; // "running", "completed", "failed" or "cancelled"
+
+	UPROPERTY()
+	double progress = 0.0;
+
+	UPROPERTY()
+	double total = 0.0; // 0 when unknown
+
+	UPROPERTY()
+	FString message; // Latest progress message
+
+	UPROPERTY()
+	double elapsedSeconds = 0.0;
+
+	// The tools/call result of the job (content, isError, structuredContent) once it is no longer running
+	TSharedPtr<FJsonObject> result;
+};
+
 USTRUCT()
 struct FUMCP_ReadResourceParams
 {
@@ -371,6 +554,15 @@ struct FUMCP_ReadResourceParams
 	FString uri;
 };
 
+USTRUCT()
+struct FUMCP_SubscribeResourceParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString uri;
+};
+
 USTRUCT()
 struct FUMCP_ReadResourceResultContent
 {
@@ -387,6 +579,9 @@ struct FUMCP_ReadResourceResultContent
 	
 	UPROPERTY()
 	FString mimeType;
+
+	// Written as "_meta" when set, e.g. where a ranged read is in the whole export and the URI of the next chunk
+	TSharedPtr<FJsonObject> meta;
 };
 
 USTRUCT()
@@ -396,6 +591,9 @@ struct FUMCP_ReadResourceResult
 	
 	UPROPERTY()
 	TArray<FUMCP_ReadResourceResultContent> contents;
+
+	// Writes the result as UTF-8 JSON without building a DOM, so large resource text is transcoded and escaped only once
+	void AppendJsonUtf8(TArray<uint8>& InOutUtf8) const;
 };
 
 USTRUCT()
@@ -454,7 +652,7 @@ struct FUMCP_ListResourceTemplatesParams
 	FString cursor;
 };
 
-DECLARE_DELEGATE_RetVal_ThreeParams(bool, FUMCP_ResourceTemplateRead, const FUMCP_UriTemplate& /* Template */, const FUMCP_UriTemplateMatch& /* UriMatch */, TArray<FUMCP_ReadResourceResultContent>& /* OutContent */);
+DECLARE_DELEGATE_RetVal_ThreeParams(bool, FUMCP_ResourceTemplateRead, const FUMCP_UriTemplate& /* Template */, const FUMCP_UriTemplateMatchView& /* UriMatch */, TArray<FUMCP_ReadResourceResultContent>& /* OutContent */);
 
 USTRUCT()
 struct FUMCP_ResourceTemplateDefinition
@@ -661,10 +859,19 @@ inline TSharedPtr<FJsonObject> UMCP_FromJsonStr(const FString& Str)
 	return RootJsonObject;
 }
 
-// Template function to generate JSON Schema from USTRUCT
+// Generates a JSON Schema from a USTRUCT
 // PropertyDescriptions: Map of property names to their descriptions
-// RequiredFields: Array of property names that are required
+// RequiredFields: Array of property names that are required (all properties if empty)
 // EnumValues: Map of property names to their enum values (for string enums)
+// The parts that only depend on the struct (property types, defaults, metadata descriptions) are built once per
+// UScriptStruct and cached, so generating the same struct for several tools only applies the per-tool arguments.
+UNREALMCPSERVER_API TSharedPtr<FJsonObject> UMCP_GenerateJsonSchema(
+	const UScriptStruct* Struct,
+	const TMap<FString, FString>& PropertyDescriptions = TMap<FString, FString>(),
+	const TArray<FString>& RequiredFields = TArray<FString>(),
+	const TMap<FString, TArray<FString>>& EnumValues = TMap<FString, TArray<FString>>()
+);
+
 // This is the primary interface - use this for all struct types
 template<typename T>
 TSharedPtr<FJsonObject> UMCP_GenerateJsonSchemaFromStruct(
@@ -673,207 +880,20 @@ TSharedPtr<FJsonObject> UMCP_GenerateJsonSchemaFromStruct(
 	const TMap<FString, TArray<FString>>& EnumValues = TMap<FString, TArray<FString>>()
 )
 {
-	const UScriptStruct* Struct = T::StaticStruct();
-	if (!Struct)
-	{
-		return nullptr;
-	}
-
-	// Create a default-constructed instance and convert it to JSON for default value extraction
-	static const T DefaultInstance{};
-	TSharedPtr<FJsonObject> DefaultInstanceJson = MakeShared<FJsonObject>();
-	if (!UMCP_ToJsonObject(DefaultInstance, DefaultInstanceJson))
-	{
-		DefaultInstanceJson = nullptr; // If serialization fails, just skip defaults
-	}
-
-	TSharedPtr<FJsonObject> Schema = MakeShared<FJsonObject>();
-	Schema->SetStringField(TEXT("type"), TEXT("object"));
-
-	TSharedPtr<FJsonObject> Properties = MakeShared<FJsonObject>();
-	TArray<TSharedPtr<FJsonValue>> RequiredFieldsArray;
-
-	// Iterate through all properties in the struct
-	for (TFieldIterator<FProperty> It(Struct); It; ++It)
-	{
-		FProperty* Property = *It;
-		if (!Property)
-		{
-			continue;
-		}
-
-		FString PropertyName = Property->GetName();
-		// Convert to camelCase to match JSON output (Unreal's JSON converter standardizes case to camelCase)
-		FString JsonPropertyName = UMCP_PropertyNameToJsonName(PropertyName);
-		TSharedPtr<FJsonObject> PropertySchema = MakeShared<FJsonObject>();
-
-		// Determine JSON Schema type from Unreal property type
-		if (FStrProperty* StrProp = CastField<FStrProperty>(Property))
-		{
-			PropertySchema->SetStringField(TEXT("type"), TEXT("string"));
-			
-			// Check if this property has enum values (use original PropertyName for lookup)
-			if (EnumValues.Contains(PropertyName))
-			{
-				TArray<TSharedPtr<FJsonValue>> EnumArray;
-				for (const FString& EnumValue : EnumValues[PropertyName])
-				{
-					EnumArray.Add(MakeShared<FJsonValueString>(EnumValue));
-				}
-				PropertySchema->SetArrayField(TEXT("enum"), EnumArray);
-			}
-		}
-		else if (FBoolProperty* BoolProp = CastField<FBoolProperty>(Property))
-		{
-			PropertySchema->SetStringField(TEXT("type"), TEXT("boolean"));
-		}
-		else if (FIntProperty* IntProp = CastField<FIntProperty>(Property))
-		{
-			PropertySchema->SetStringField(TEXT("type"), TEXT("number"));
-		}
-		else if (FInt64Property* Int64Prop = CastField<FInt64Property>(Property))
-		{
-			PropertySchema->SetStringField(TEXT("type"), TEXT("number"));
-		}
-		else if (FFloatProperty* FloatProp = CastField<FFloatProperty>(Property))
-		{
-			PropertySchema->SetStringField(TEXT("type"), TEXT("number"));
-		}
-		else if (FDoubleProperty* DoubleProp = CastField<FDoubleProperty>(Property))
-		{
-			PropertySchema->SetStringField(TEXT("type"), TEXT("number"));
-		}
-		else if (FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property))
-		{
-			PropertySchema->SetStringField(TEXT("type"), TEXT("array"));
-			TSharedPtr<FJsonObject> ItemsSchema = MakeShared<FJsonObject>();
-			
-			// Determine item type
-			FProperty* InnerProp = ArrayProp->Inner;
-			if (CastField<FStrProperty>(InnerProp))
-			{
-				ItemsSchema->SetStringField(TEXT("type"), TEXT("string"));
-			}
-			else if (CastField<FIntProperty>(InnerProp) || CastField<FInt64Property>(InnerProp) || 
-			         CastField<FFloatProperty>(InnerProp) || CastField<FDoubleProperty>(InnerProp))
-			{
-				ItemsSchema->SetStringField(TEXT("type"), TEXT("number"));
-			}
-			else if (CastField<FBoolProperty>(InnerProp))
-			{
-				ItemsSchema->SetStringField(TEXT("type"), TEXT("boolean"));
-			}
-			else
-			{
-				// For complex types, default to object
-				ItemsSchema->SetStringField(TEXT("type"), TEXT("object"));
-			}
-			
-			PropertySchema->SetObjectField(TEXT("items"), ItemsSchema);
-		}
-		else if (FMapProperty* MapProp = CastField<FMapProperty>(Property))
-		{
-			PropertySchema->SetStringField(TEXT("type"), TEXT("object"));
-			// For maps, we assume string values (common case)
-			TSharedPtr<FJsonObject> AdditionalProps = MakeShared<FJsonObject>();
-			AdditionalProps->SetStringField(TEXT("type"), TEXT("string"));
-			PropertySchema->SetObjectField(TEXT("additionalProperties"), AdditionalProps);
-		}
-		else if (FStructProperty* StructProp = CastField<FStructProperty>(Property))
-		{
-			// For nested structs, we can extract the default from JSON if available
-			// But we can't recursively call the templated version without knowing the type
-			// So we'll just mark it as an object type and let the JSON default value handle it
-			PropertySchema->SetStringField(TEXT("type"), TEXT("object"));
-			
-			// If we have JSON defaults, try to extract the nested struct's default value
-			if (DefaultInstanceJson.IsValid())
-			{
-				// JsonPropertyName is already declared above, reuse it
-				if (DefaultInstanceJson->HasTypedField<EJson::Object>(JsonPropertyName))
-				{
-					TSharedPtr<FJsonObject> NestedDefaultJson = DefaultInstanceJson->GetObjectField(JsonPropertyName);
-					if (NestedDefaultJson.IsValid() && NestedDefaultJson->Values.Num() > 0)
-					{
-						// For nested structs, we set the entire object as the default
-						// This is valid JSON Schema - the default can be an object
-						PropertySchema->SetField(TEXT("default"), MakeShared<FJsonValueObject>(NestedDefaultJson));
-					}
-				}
-			}
-		}
-		else
-		{
-			// Default to object for unknown types
-			PropertySchema->SetStringField(TEXT("type"), TEXT("object"));
-		}
-
-		// Add description - prefer provided description, then metadata, then empty
-		// Use original PropertyName for lookup
-		FString Description;
-		if (PropertyDescriptions.Contains(PropertyName))
-		{
-			Description = PropertyDescriptions[PropertyName];
-		}
-		else
-		{
-			Description = Property->GetMetaData(TEXT("ToolTip"));
-			if (Description.IsEmpty())
-			{
-				Description = Property->GetMetaData(TEXT("Description"));
-			}
-		}
-		if (!Description.IsEmpty())
-		{
-			PropertySchema->SetStringField(TEXT("description"), Description);
-		}
-
-		// Extract and add default value from JSON if available
-		if (DefaultInstanceJson.IsValid())
-		{
-			TSharedPtr<FJsonValue> DefaultValue = UMCP_ExtractDefaultValueFromJson(Property, DefaultInstanceJson);
-			if (DefaultValue.IsValid())
-			{
-				PropertySchema->SetField(TEXT("default"), DefaultValue);
-			}
-		}
-
-		// Use camelCase property name in schema to match JSON output
-		Properties->SetObjectField(JsonPropertyName, PropertySchema);
-	}
+	return UMCP_GenerateJsonSchema(T::StaticStruct(), PropertyDescriptions, RequiredFields, EnumValues);
+}
 
-	Schema->SetObjectField(TEXT("properties"), Properties);
-	
-	// Use provided required fields, or auto-detect from property flags
-	if (RequiredFields.Num() > 0)
-	{
-		TArray<TSharedPtr<FJsonValue>> RequiredFieldsJson;
-		for (const FString& RequiredField : RequiredFields)
-		{
-			// Convert required field names to camelCase to match JSON output
-			FString JsonRequiredField = UMCP_PropertyNameToJsonName(RequiredField);
-			RequiredFieldsJson.Add(MakeShared<FJsonValueString>(JsonRequiredField));
-		}
-		Schema->SetArrayField(TEXT("required"), RequiredFieldsJson);
-	}
-	else
+// Same as UMCP_GenerateJsonSchemaFromStruct, but returns a builder for FUMCP_ToolDefinition::InputSchemaBuilder or
+// OutputSchemaBuilder so the schema is only generated once a client lists or calls the tool
+template<typename T>
+UMCP_JsonSchemaBuilder UMCP_DeferJsonSchemaFromStruct(
+	TMap<FString, FString> PropertyDescriptions = TMap<FString, FString>(),
+	TArray<FString> RequiredFields = TArray<FString>(),
+	TMap<FString, TArray<FString>> EnumValues = TMap<FString, TArray<FString>>()
+)
+{
+	return [PropertyDescriptions = MoveTemp(PropertyDescriptions), RequiredFields = MoveTemp(RequiredFields), EnumValues = MoveTemp(EnumValues)]()
 	{
-		// If an explicit list is not provided, treat all fields as required
-		for (TFieldIterator<FProperty> It(Struct); It; ++It)
-		{
-			FProperty* Property = *It;
-			if (Property)
-			{
-				// Convert property names to camelCase to match JSON output
-				FString JsonPropertyName = UMCP_PropertyNameToJsonName(Property->GetName());
-				RequiredFieldsArray.Add(MakeShared<FJsonValueString>(JsonPropertyName));
-			}
-		}
-		if (RequiredFieldsArray.Num() > 0)
-		{
-			Schema->SetArrayField(TEXT("required"), RequiredFieldsArray);
-		}
-	}
-
-	return Schema;
+		return UMCP_GenerateJsonSchema(T::StaticStruct(), PropertyDescriptions, RequiredFields, EnumValues);
+	};
 }
@@ -1,11 +1,44 @@
 ﻿#pragma once
 
+#include "CoreMinimal.h"
+#include "Misc/StringBuilder.h"
+
+// Owning match result with every variable already percent-decoded. Convenient, but allocates per variable.
 struct FUMCP_UriTemplateMatch
 {
 	FString Uri;
 	TMap<FString, TArray<FString>> Variables;
 };
 
+// Match result that only holds views: Uri and each capture's value view into the matched URI, capture names view
+// into the template. Both must outlive the match. Values stay percent-encoded until a handler asks for them.
+struct FUMCP_UriTemplateMatchView
+{
+	// Enough for any template we register; templates with more variables spill to the heap
+	static constexpr int32 NumInlineCaptures = 8;
+
+	struct FCapture
+	{
+		FStringView Name;
+		FStringView RawValue;
+	};
+
+	FStringView Uri;
+	TArray<FCapture, TInlineAllocator<NumInlineCaptures>> Captures;
+
+	void Reset();
+
+	// Value of the first capture of Name, still percent-encoded
+	bool GetRawValue(FStringView Name, FStringView& OutRawValue) const;
+	// Percent-decoded value of the first capture of Name
+	bool GetValue(FStringView Name, FString& OutValue) const;
+	// Percent-decoded values of every capture of Name, e.g. for exploded variables
+	TArray<FString> GetValues(FStringView Name) const;
+
+	// Decodes every capture into the owning form
+	void ToMatch(FUMCP_UriTemplateMatch& OutMatch) const;
+};
+
 enum class EUMCP_UriTemplateComponentType
 {
 	Literal,
@@ -41,6 +74,7 @@ struct FUMCP_UriTemplateComponent
 	static void FromVarList(FString VarList, FUMCP_UriTemplateComponent& OutComp, FString& OutError);
 
 	FString Expand(const TMap<FString, TArray<FString>>& Values) const;
+	void Expand(const TMap<FString, TArray<FString>>& Values, FStringBuilderBase& OutBuilder) const;
 };
 
 struct FUMCP_UriTemplate
@@ -53,8 +87,14 @@ public:
 	const FString& ParseError() const { return Error; }
 	const FString& GetUriTemplateStr() const { return UriTemplateStr; }
 
+	// Does not allocate unless the template has more than NumInlineCaptures captures
+	bool FindMatch(FStringView Uri, FUMCP_UriTemplateMatchView& OutMatch) const;
 	bool FindMatch(const FString& Uri, FUMCP_UriTemplateMatch& OutMatch) const;
 	FString Expand(const TMap<FString, TArray<FString>>& Values) const;
+	void Expand(const TMap<FString, TArray<FString>>& Values, FStringBuilderBase& OutBuilder) const;
+
+	// Literal text before the first expression, e.g. "unreal+t3d://" for "unreal+t3d://{filepath}"
+	FStringView GetLiteralPrefix() const;
 
 private:
 	void TryParseTemplate();
@@ -63,3 +103,25 @@ private:
 	FString UriTemplateStr{};
 	FString Error{};
 };
+
+// Prefix trie over the leading literal of each registered template, built as templates are added.
+// A lookup walks the URI once and only yields templates whose leading literal the URI starts with, so FindMatch
+// runs on a single candidate in the common case instead of on every registered template.
+class FUMCP_UriTemplateRouter
+{
+public:
+	void Add(const FUMCP_UriTemplate& UriTemplate, int32 TemplateIndex);
+	void Reset();
+
+	// Calls Visitor with candidate template indices until it returns true. Longer leading literals are visited first;
+	// templates with the same literal are visited in the order they were added. Returns whether a visit returned true.
+	bool VisitCandidates(FStringView Uri, TFunctionRef<bool(int32 TemplateIndex)> Visitor) const;
+
+private:
+	struct FNode
+	{
+		TArray<TPair<TCHAR, int32>> Children; // Next character -> node index. Fan-out is small, so a linear scan is enough.
+		TArray<int32> TemplateIndices; // Templates whose leading literal ends at this node
+	};
+	TArray<FNode> Nodes; // Nodes[0] is the root, which holds templates that start with an expression
+};
@@ -5,6 +5,7 @@
 #include "UMCP_CommonTools.h"
 #include "UMCP_AssetTools.h"
 #include "UMCP_BlueprintTools.h"
+#include "UMCP_JobTools.h"
 #include "UMCP_CommonResources.h"
 #include "UMCP_CommonPrompts.h"
 #include "Modules/ModuleManager.h"
@@ -18,11 +19,21 @@ public:
     /** IModuleInterface implementation */
     virtual void StartupModule() override;
     virtual void ShutdownModule() override;
+
+	static FUnrealMCPServerModule& Get();
+
+	// Registers the tools, resources and prompts and starts listening on Port. StartupModule does this in the editor;
+	// UUnrealMCPServerCommandlet does it with bHeadless, which leaves out the tools that need a full editor session.
+	// A running server is stopped first. False if the port couldn't be listened on.
+	bool StartServer(uint32 Port, bool bHeadless);
+	void StopServer();
+
 private:
 	TUniquePtr<FUMCP_Server> Server;
 	TUniquePtr<FUMCP_CommonTools> CommonTools;
 	TUniquePtr<FUMCP_AssetTools> AssetTools;
 	TUniquePtr<FUMCP_BlueprintTools> BlueprintTools;
+	TUniquePtr<FUMCP_JobTools> JobTools;
 	TUniquePtr<FUMCP_CommonResources> CommonResources;
 	TUniquePtr<FUMCP_CommonPrompts> CommonPrompts;
 };
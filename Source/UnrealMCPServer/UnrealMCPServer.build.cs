@@ -24,6 +24,7 @@ public class UnrealMCPServer : ModuleRules
 			new string[]
 			{
 				"Core",
+				"TraceLog", // For the UnrealMCP Insights trace channel in UMCP_Trace.h
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
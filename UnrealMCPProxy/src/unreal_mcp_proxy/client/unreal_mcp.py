@@ -9,7 +9,11 @@ import httpx
 from pydantic import field_validator
 from pydantic_settings import BaseSettings, SettingsConfigDict
 
-from ..constants import DEFAULT_BACKEND_PORT, DEFAULT_BACKEND_TIMEOUT, DEFAULT_HEALTH_CHECK_INTERVAL
+from ..constants import (
+    DEFAULT_BACKEND_PORT, DEFAULT_BACKEND_TIMEOUT, DEFAULT_HEALTH_CHECK_INTERVAL,
+    DEFAULT_RETRY_MAX_ATTEMPTS, DEFAULT_RETRY_INITIAL_DELAY, DEFAULT_RETRY_MAX_DELAY,
+    DEFAULT_RETRY_BACKOFF_FACTOR
+)
 
 logger = logging.getLogger(__name__)
 
@@ -34,6 +38,10 @@ class UnrealMCPSettings(BaseSettings):
     port: int = DEFAULT_BACKEND_PORT
     timeout: int = DEFAULT_BACKEND_TIMEOUT
     health_check_interval: int = DEFAULT_HEALTH_CHECK_INTERVAL
+    retry_max_attempts: int = DEFAULT_RETRY_MAX_ATTEMPTS  # Retries when the backend reports busy (HTTP 503)
+    retry_initial_delay: float = DEFAULT_RETRY_INITIAL_DELAY
+    retry_max_delay: float = DEFAULT_RETRY_MAX_DELAY
+    retry_backoff_factor: float = DEFAULT_RETRY_BACKOFF_FACTOR
     
     @field_validator('port')
     @classmethod
@@ -224,6 +232,31 @@ class UnrealMCPClient:
         
         try:
             response = await self.client.post("", json=request)
+            
+            # 503 means the backend's game thread queue is full. The request was rejected before it ran,
+            # so it is always safe to retry after backing off.
+            attempt = 0
+            delay = self.settings.retry_initial_delay
+            while response.status_code == 503 and attempt < self.settings.retry_max_attempts:
+                attempt += 1
+                wait = delay
+                retry_after = response.headers.get("Retry-After")
+                if retry_after is not None:
+                    try:
+                        wait = max(wait, float(retry_after))
+                    except ValueError:
+                        pass
+                wait = min(wait, self.settings.retry_max_delay)
+                logger.warning(f"Backend busy for method '{method}', retrying in {wait:.2f}s (attempt {attempt}/{self.settings.retry_max_attempts})")
+                await asyncio.sleep(wait)
+                delay = min(delay * self.settings.retry_backoff_factor, self.settings.retry_max_delay)
+                response = await self.client.post("", json=request)
+            
+            if response.status_code == 503:
+                # Still busy: surface the JSON-RPC "Server busy" error without marking the backend offline
+                logger.warning(f"Backend still busy for method '{method}' after {attempt} retries")
+                return response.json()
+            
             response.raise_for_status()
             
             result = response.json()
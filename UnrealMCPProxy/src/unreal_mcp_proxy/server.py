@@ -71,6 +71,10 @@ mcp = FastMCP("unreal-mcp-proxy")
 # Initialize backend client with health check interval from settings
 client_settings = UnrealMCPSettings()
 client_settings.health_check_interval = settings.health_check_interval
+client_settings.retry_max_attempts = settings.retry_max_attempts
+client_settings.retry_initial_delay = settings.retry_initial_delay
+client_settings.retry_max_delay = settings.retry_max_delay
+client_settings.retry_backoff_factor = settings.retry_backoff_factor
 unreal_client = UnrealMCPClient(settings=client_settings)
 
 # Proxy tool definitions loaded from tool_definitions.py
@@ -174,6 +178,24 @@ async def get_log_file_path() -> Dict[str, Any]:
     result = await _call_tool_wrapper("get_log_file_path", {})
     return await _handle_tool_result_wrapper("get_log_file_path", result)
 
+@mcp.tool(
+    annotations={
+        "title": "Get Log Lines",
+        "readOnlyHint": True,
+        "destructiveHint": False,
+        "idempotentHint": False
+    }
+)
+@read_only
+async def get_log_lines(cursor: int = 0, categories: List[str] = None, minVerbosity: str = "", contains: str = "", maxLines: int = 500) -> Dict[str, Any]:
+    """Returns recent editor log lines from an in-memory buffer, without reading the log file. Every line has a sequence number; pass the returned nextCursor as cursor on the next call to get only the lines logged since. Call with cursor -1 before execute_console_command, request_editor_compile or an import to get a cursor, then again afterwards to see exactly what it logged. Filter by categories (e.g. ['LogBlueprint']), minVerbosity (e.g. 'Warning' for warnings and errors) and contains. The buffer keeps the most recent LogBufferLines lines (default 8192); missedLines reports lines that were overwritten before they were read."""
+    # Apply default for optional categories
+    if categories is None:
+        categories = []
+    arguments = {"cursor": cursor, "categories": categories, "minVerbosity": minVerbosity, "contains": contains, "maxLines": maxLines}
+    result = await _call_tool_wrapper("get_log_lines", arguments)
+    return await _handle_tool_result_wrapper("get_log_lines", result)
+
 @mcp.tool(
     annotations={
         "title": "Request Editor Compilation",
@@ -183,11 +205,39 @@ async def get_log_file_path() -> Dict[str, Any]:
     }
 )
 @write_operation
-async def request_editor_compile(timeoutSeconds: float = DEFAULT_COMPILATION_TIMEOUT) -> Dict[str, Any]:
-    """Requests an editor compilation, waits for completion, and returns whether it succeeded or failed along with any build log generated. Use this after modifying C++ source files to recompile code changes without restarting the editor. Only works if the project has C++ code and live coding is enabled in editor settings. Default timeout is 300 seconds (5 minutes). Compilation may take longer for large projects. Returns success status, build log, and extracted errors/warnings. Check the build log for compilation errors if compilation fails."""
-    result = await _call_tool_wrapper("request_editor_compile", {"timeoutSeconds": timeoutSeconds})
+async def request_editor_compile(timeoutSeconds: float = DEFAULT_COMPILATION_TIMEOUT, runAsJob: bool = False) -> Dict[str, Any]:
+    """Requests an editor compilation, waits for completion, and returns whether it succeeded or failed along with any build log generated. Use this after modifying C++ source files to recompile code changes without restarting the editor. Only works if the project has C++ code and live coding is enabled in editor settings. Default timeout is 300 seconds (5 minutes). Compilation may take longer for large projects. Returns success status, build log, and extracted errors/warnings. Check the build log for compilation errors if compilation fails. Pass runAsJob=true to get a job id back immediately and poll it with get_job_status."""
+    result = await _call_tool_wrapper("request_editor_compile", {"timeoutSeconds": timeoutSeconds, "runAsJob": runAsJob})
     return await _handle_tool_result_wrapper("request_editor_compile", result)
 
+@mcp.tool(
+    annotations={
+        "title": "Get Job Status",
+        "readOnlyHint": True,
+        "destructiveHint": False,
+        "idempotentHint": True
+    }
+)
+@read_only
+async def get_job_status(jobId: str) -> Dict[str, Any]:
+    """Get the status of a job started by calling a tool with runAsJob: true. Returns the status ('running', 'completed', 'failed' or 'cancelled'), the latest progress and, once the job is no longer running, the tool's result in 'result'. Poll this until the status is no longer 'running'. Finished jobs are kept for a limited time (10 minutes by default)."""
+    result = await _call_tool_wrapper("get_job_status", {"jobId": jobId})
+    return await _handle_tool_result_wrapper("get_job_status", result)
+
+@mcp.tool(
+    annotations={
+        "title": "Cancel Job",
+        "readOnlyHint": False,
+        "destructiveHint": False,
+        "idempotentHint": True
+    }
+)
+@write_operation
+async def cancel_job(jobId: str) -> Dict[str, Any]:
+    """Request cancellation of a running job started with runAsJob: true. The job stops at its next step and keeps the work it already finished (for example files already exported); poll get_job_status until the status is 'cancelled' to get the partial result. Cancelling a job that already finished has no effect. Returns the job status at the time of the request."""
+    result = await _call_tool_wrapper("cancel_job", {"jobId": jobId})
+    return await _handle_tool_result_wrapper("cancel_job", result)
+
 @mcp.tool(
     annotations={
         "title": "Query Asset",
@@ -211,14 +261,31 @@ async def query_asset(assetPath: str, bIncludeTags: bool = False) -> Dict[str, A
     }
 )
 @read_only
-async def search_blueprints(searchType: str, searchTerm: str, packagePath: Optional[str] = None, bRecursive: bool = True, maxResults: int = 0, offset: int = 0) -> Dict[str, Any]:
-    """Search for Blueprint assets based on various criteria including name patterns, parent classes, and package paths. Returns array of Blueprint asset information including paths, names, parent classes, and match details. Use 'name' searchType to find Blueprints by name pattern (e.g., 'BP_Player*'), 'parent_class' to find Blueprints that inherit from a class (e.g., 'Actor', 'Pawn', 'Character'), or 'all' for comprehensive search across all criteria. Use maxResults and offset for paging through large result sets."""
+async def search_blueprints(searchType: str, searchTerm: str, packagePath: Optional[str] = None, bRecursive: bool = True, maxResults: int = 0, offset: int = 0, cursor: Optional[str] = None) -> Dict[str, Any]:
+    """Search for Blueprint assets based on various criteria including name patterns, parent classes, and package paths. Returns array of Blueprint asset information including paths, names, parent classes, and match details. Use 'name' searchType to find Blueprints by name pattern (e.g., 'BP_Player*'), 'parent_class' to find Blueprints that inherit from a class (e.g., 'Actor', 'Pawn', 'Character'), 'function', 'variable', 'event', 'node_class' or 'interface' to find Blueprints by what their graphs contain (answered from an index without loading assets; unindexedCount reports Blueprints not covered yet, see index_blueprints), or 'all' for comprehensive search across all criteria. Use maxResults and offset for paging through large result sets, or pass each page's nextCursor as cursor to get the next page cheaply."""
     kwargs = {"searchType": searchType, "searchTerm": searchTerm, "bRecursive": bRecursive, "maxResults": maxResults, "offset": offset}
     if packagePath is not None:
         kwargs["packagePath"] = packagePath
+    if cursor:
+        kwargs["cursor"] = cursor
     result = await _call_tool_wrapper("search_blueprints", kwargs)
     return await _handle_tool_result_wrapper("search_blueprints", result)
 
+@mcp.tool(
+    annotations={
+        "title": "Index Blueprints",
+        "readOnlyHint": True,
+        "destructiveHint": False,
+        "idempotentHint": True
+    }
+)
+@read_only
+async def index_blueprints(packagePath: str, bRecursive: bool = True, maxBlueprints: int = 0, runAsJob: bool = False) -> Dict[str, Any]:
+    """Add the Blueprints that aren't indexed yet to the index behind the graph content searches of search_blueprints ('function', 'variable', 'event', 'node_class', 'interface'). Blueprints are indexed automatically when they are saved or loaded, and the index is kept across editor sessions, so this is only needed once per project (or after a large source control sync) to cover Blueprints nobody has opened. Loads each unindexed Blueprint in scope, one per editor tick. Pass runAsJob=true to get a job id back immediately and poll it with get_job_status."""
+    arguments = {"packagePath": packagePath, "bRecursive": bRecursive, "maxBlueprints": maxBlueprints, "runAsJob": runAsJob}
+    result = await _call_tool_wrapper("index_blueprints", arguments)
+    return await _handle_tool_result_wrapper("index_blueprints", result)
+
 @mcp.tool(
     annotations={
         "title": "Batch Export Assets",
@@ -228,10 +295,13 @@ async def search_blueprints(searchType: str, searchTerm: str, packagePath: Optio
     }
 )
 @read_only
-async def batch_export_assets(objectPaths: List[str], outputFolder: str, format: str = DEFAULT_EXPORT_FORMAT) -> Dict[str, Any]:
-    """Export multiple assets to files in a specified folder. Returns a list of the exported file paths. Required for Blueprint assets, as export_asset will fail for Blueprints due to response size limitations. Use this when exporting multiple assets of any type. Files are saved to disk at the specified output folder path. Format defaults to T3D. Each asset is exported to a separate file named after the asset. Returns array of successfully exported file paths. Failed exports are not included in the return value. NOTE: For Blueprint graph inspection, use export_blueprint_markdown instead, which is specifically designed for that purpose and provides clearer workflow guidance."""
+async def batch_export_assets(objectPaths: List[str], outputFolder: str, format: str = DEFAULT_EXPORT_FORMAT, outputMode: str = "files", outputFileName: Optional[str] = None, runAsJob: bool = False) -> Dict[str, Any]:
+    """Export multiple assets to files in a specified folder. Returns a list of the exported file paths. Required for Blueprint assets, as export_asset will fail for Blueprints due to response size limitations. Use this when exporting multiple assets of any type. Files are saved to disk at the specified output folder path. Format defaults to T3D. Each asset is exported to a separate file named after the asset. Returns array of successfully exported file paths. Failed exports are not included in the return value. With outputMode='ndjson' all assets go into one NDJSON file (optionally named by outputFileName) with a byte offset index instead, which is much faster for thousands of assets. NOTE: For Blueprint graph inspection, use export_blueprint_markdown instead, which is specifically designed for that purpose and provides clearer workflow guidance. Pass runAsJob=true to get a job id back immediately and poll it with get_job_status."""
     # objectPaths defaults to empty array in backend, but we require it to be provided
-    result = await _call_tool_wrapper("batch_export_assets", {"objectPaths": objectPaths, "outputFolder": outputFolder, "format": format})
+    arguments = {"objectPaths": objectPaths, "outputFolder": outputFolder, "format": format, "outputMode": outputMode, "runAsJob": runAsJob}
+    if outputFileName:
+        arguments["outputFileName"] = outputFileName
+    result = await _call_tool_wrapper("batch_export_assets", arguments)
     return await _handle_tool_result_wrapper("batch_export_assets", result)
 
 @mcp.tool(
@@ -257,9 +327,9 @@ async def export_class_default(classPath: str, format: str = DEFAULT_EXPORT_FORM
     }
 )
 @write_operation
-async def import_asset(packagePath: str, classPath: str, filePath: Optional[str] = None, t3dFilePath: Optional[str] = None) -> Dict[str, Any]:
-    """Import a file to create or update a UObject. The file type is automatically detected based on available factories. Import binary files (textures, meshes, sounds) or T3D files to create/update Unreal assets. Supported binary formats: .fbx, .obj (meshes), .png, .jpg, .tga (textures), .wav, .mp3 (sounds). T3D files can be used to import from T3D format or to configure imported objects. If asset exists at packagePath, it will be updated. Otherwise, a new asset is created. At least one of filePath (binary) or t3dFilePath (T3D) must be provided."""
-    kwargs = {"packagePath": packagePath, "classPath": classPath}
+async def import_asset(packagePath: str, classPath: str, filePath: Optional[str] = None, t3dFilePath: Optional[str] = None, runAsJob: bool = False) -> Dict[str, Any]:
+    """Import a file to create or update a UObject. The file type is automatically detected based on available factories. Import binary files (textures, meshes, sounds) or T3D files to create/update Unreal assets. Supported binary formats: .fbx, .obj (meshes), .png, .jpg, .tga (textures), .wav, .mp3 (sounds). T3D files can be used to import from T3D format or to configure imported objects. If asset exists at packagePath, it will be updated. Otherwise, a new asset is created. At least one of filePath (binary) or t3dFilePath (T3D) must be provided. Pass runAsJob=true to get a job id back immediately and poll it with get_job_status."""
+    kwargs = {"packagePath": packagePath, "classPath": classPath, "runAsJob": runAsJob}
     if filePath is not None:
         kwargs["filePath"] = filePath
     if t3dFilePath is not None:
@@ -267,6 +337,20 @@ async def import_asset(packagePath: str, classPath: str, filePath: Optional[str]
     result = await _call_tool_wrapper("import_asset", kwargs)
     return await _handle_tool_result_wrapper("import_asset", result)
 
+@mcp.tool(
+    annotations={
+        "title": "Batch Import Assets",
+        "readOnlyHint": False,
+        "destructiveHint": True,
+        "idempotentHint": False
+    }
+)
+@write_operation
+async def batch_import_assets(assets: List[Dict[str, Any]], bSave: bool = True, runAsJob: bool = False) -> Dict[str, Any]:
+    """Import many files in one call, each with the arguments of import_asset (filePath and/or t3dFilePath, packagePath, classPath). All imports form one undo transaction. T3D property changes notify the editor (PostEditChange) once per asset after the last import instead of once per property, new assets are announced to the asset registry at the end, and the modified packages are saved together in one pass (bSave, defaults to true). Returns a result per asset in request order. Use this instead of repeated import_asset calls when changing many assets. Pass runAsJob=true to get a job id back immediately and poll it with get_job_status."""
+    result = await _call_tool_wrapper("batch_import_assets", {"assets": assets, "bSave": bSave, "runAsJob": runAsJob})
+    return await _handle_tool_result_wrapper("batch_import_assets", result)
+
 @mcp.tool(
     annotations={
         "title": "Search Assets",
@@ -276,13 +360,16 @@ async def import_asset(packagePath: str, classPath: str, filePath: Optional[str]
     }
 )
 @read_only
-async def search_assets(packagePaths: List[str], packageNames: List[str], classPaths: List[str] = None, bRecursive: bool = True, bIncludeTags: bool = False, maxResults: int = 0, offset: int = 0) -> Dict[str, Any]:
-    """Search for assets by package paths or package names, optionally filtered by class. Returns an array of asset information from the asset registry. More flexible than search_blueprints as it works with all asset types. REQUIRED: At least one of 'packagePaths' or 'packageNames' must be a non-empty array. Use packagePaths to search directories (e.g., '/Game/Blueprints' searches all assets in that folder), packageNames for exact or partial package matches (supports wildcards * and ?, or substring matching), and classPaths to filter by asset type (e.g., textures only). Returns array of asset information. Use bIncludeTags=true to get additional metadata tags. Use maxResults and offset for paging through large result sets. For large searches, use maxResults to limit results and offset for paging."""
+async def search_assets(packagePaths: List[str], packageNames: List[str], classPaths: List[str] = None, bRecursive: bool = True, bIncludeTags: bool = False, maxResults: int = 0, offset: int = 0, cursor: Optional[str] = None) -> Dict[str, Any]:
+    """Search for assets by package paths or package names, optionally filtered by class. Returns an array of asset information from the asset registry. More flexible than search_blueprints as it works with all asset types. REQUIRED: At least one of 'packagePaths' or 'packageNames' must be a non-empty array. Use packagePaths to search directories (e.g., '/Game/Blueprints' searches all assets in that folder), packageNames for exact or partial package matches (supports wildcards * and ?, or substring matching), and classPaths to filter by asset type (e.g., textures only). Returns array of asset information. Use bIncludeTags=true to get additional metadata tags. Use maxResults and offset for paging through large result sets. For large searches, use maxResults to limit results and pass each page's nextCursor as cursor to get the next page."""
     # Apply default for optional classPaths
     if classPaths is None:
         classPaths = []
     # Backend validates that at least one of packagePaths or packageNames is non-empty
-    result = await _call_tool_wrapper("search_assets", {"packagePaths": packagePaths, "packageNames": packageNames, "classPaths": classPaths, "bRecursive": bRecursive, "bIncludeTags": bIncludeTags, "maxResults": maxResults, "offset": offset})
+    arguments = {"packagePaths": packagePaths, "packageNames": packageNames, "classPaths": classPaths, "bRecursive": bRecursive, "bIncludeTags": bIncludeTags, "maxResults": maxResults, "offset": offset}
+    if cursor:
+        arguments["cursor"] = cursor
+    result = await _call_tool_wrapper("search_assets", arguments)
     return await _handle_tool_result_wrapper("search_assets", result)
 
 @mcp.tool(
@@ -322,11 +409,67 @@ async def get_asset_references(assetPath: str, bIncludeHardReferences: bool = Tr
     }
 )
 @read_only
-async def get_asset_dependency_tree(assetPath: str, maxDepth: int = 10, bIncludeHardDependencies: bool = True, bIncludeSoftDependencies: bool = False) -> Dict[str, Any]:
-    """Get the complete dependency tree for a specified asset. Returns a recursive tree structure showing all dependencies and their dependencies. Use this for complete dependency mapping and recursive analysis. The tree includes depth information for each node. Very useful when doing asset searches and queries with existing tools. Supports both hard dependencies (direct references) and soft dependencies (searchable references). Use maxDepth to limit recursion depth and prevent infinite loops."""
-    result = await _call_tool_wrapper("get_asset_dependency_tree", {"assetPath": assetPath, "maxDepth": maxDepth, "bIncludeHardDependencies": bIncludeHardDependencies, "bIncludeSoftDependencies": bIncludeSoftDependencies})
+async def get_asset_dependency_tree(assetPath: str, maxDepth: int = 10, bIncludeHardDependencies: bool = True, bIncludeSoftDependencies: bool = False, outputMode: str = "tree", maxNodes: int = 0) -> Dict[str, Any]:
+    """Get the complete dependency tree for a specified asset. Returns a recursive tree structure showing all dependencies and their dependencies. Use this for complete dependency mapping and recursive analysis. The tree includes depth information for each node. Very useful when doing asset searches and queries with existing tools. Supports both hard dependencies (direct references) and soft dependencies (searchable references). Use maxDepth to limit recursion depth and prevent infinite loops. For assets with shared dependencies (material and Blueprint libraries), use outputMode 'dag' to get each package once with edges by node index, and maxNodes to bound the result."""
+    result = await _call_tool_wrapper("get_asset_dependency_tree", {"assetPath": assetPath, "maxDepth": maxDepth, "bIncludeHardDependencies": bIncludeHardDependencies, "bIncludeSoftDependencies": bIncludeSoftDependencies, "outputMode": outputMode, "maxNodes": maxNodes})
     return await _handle_tool_result_wrapper("get_asset_dependency_tree", result)
 
+@mcp.tool(
+    annotations={
+        "title": "Batch Query Assets",
+        "readOnlyHint": True,
+        "destructiveHint": False,
+        "idempotentHint": True
+    }
+)
+@read_only
+async def batch_query_assets(assetPaths: List[str], bIncludeTags: bool = False) -> Dict[str, Any]:
+    """Query many assets at once: the batch form of query_asset. Looks up every path with a single asset registry query and returns one compact, columnar result keyed by input path: row i of every column (exists, assetName, packagePath, classPath, objectPath, tags) describes assetPaths[i]. Missing assets are reported with exists false instead of failing the call. Prefer this over calling query_asset repeatedly."""
+    result = await _call_tool_wrapper("batch_query_assets", {"assetPaths": assetPaths, "bIncludeTags": bIncludeTags})
+    return await _handle_tool_result_wrapper("batch_query_assets", result)
+
+@mcp.tool(
+    annotations={
+        "title": "Batch Get Asset Dependencies",
+        "readOnlyHint": True,
+        "destructiveHint": False,
+        "idempotentHint": True
+    }
+)
+@read_only
+async def batch_get_asset_dependencies(assetPaths: List[str], bIncludeHardDependencies: bool = True, bIncludeSoftDependencies: bool = False) -> Dict[str, Any]:
+    """Get the dependencies of many assets at once: the batch form of get_asset_dependencies. Resolves every path with a single asset registry query and turns each dependency package into an asset path once for the whole batch. Returns a compact, columnar result keyed by input path: every distinct dependency is listed once in 'paths', and the dependencies of assetPaths[i] are indices[offsets[i]] to indices[offsets[i + 1]] - 1, indices into 'paths'. Missing assets are reported with exists false instead of failing the call."""
+    result = await _call_tool_wrapper("batch_get_asset_dependencies", {"assetPaths": assetPaths, "bIncludeHardDependencies": bIncludeHardDependencies, "bIncludeSoftDependencies": bIncludeSoftDependencies})
+    return await _handle_tool_result_wrapper("batch_get_asset_dependencies", result)
+
+@mcp.tool(
+    annotations={
+        "title": "Batch Get Asset References",
+        "readOnlyHint": True,
+        "destructiveHint": False,
+        "idempotentHint": True
+    }
+)
+@read_only
+async def batch_get_asset_references(assetPaths: List[str], bIncludeHardReferences: bool = True, bIncludeSoftReferences: bool = False) -> Dict[str, Any]:
+    """Get the referencers of many assets at once: the batch form of get_asset_references. Resolves every path with a single asset registry query and turns each referencing package into an asset path once for the whole batch. Returns a compact, columnar result keyed by input path: every distinct referencer is listed once in 'paths', and the referencers of assetPaths[i] are indices[offsets[i]] to indices[offsets[i + 1]] - 1, indices into 'paths'. Missing assets are reported with exists false instead of failing the call."""
+    result = await _call_tool_wrapper("batch_get_asset_references", {"assetPaths": assetPaths, "bIncludeHardReferences": bIncludeHardReferences, "bIncludeSoftReferences": bIncludeSoftReferences})
+    return await _handle_tool_result_wrapper("batch_get_asset_references", result)
+
+@mcp.tool(
+    annotations={
+        "title": "Export Dependency Graph",
+        "readOnlyHint": True,
+        "destructiveHint": False,
+        "idempotentHint": True
+    }
+)
+@read_only
+async def export_dependency_graph(sinceGeneration: int = 0) -> Dict[str, Any]:
+    """Export the hard and soft package dependency graph of the whole project in one call, for build-impact analysis and cook-size audits. Writes a memory-mappable binary snapshot under the project's Saved/UnrealMCPServer/DependencyGraph folder: an interned table of package names plus compressed sparse row (CSR) adjacency arrays with hard/soft flags per edge. The file layout is documented in the tech spec. Returns the file path and the snapshot's generation. Pass that generation back as sinceGeneration to get only the packages whose dependencies changed since, as JSON, instead of a new file. Much faster than calling get_asset_dependencies for every asset."""
+    result = await _call_tool_wrapper("export_dependency_graph", {"sinceGeneration": sinceGeneration})
+    return await _handle_tool_result_wrapper("export_dependency_graph", result)
+
 @mcp.tool(
     annotations={
         "title": "Export Blueprint Markdown",
@@ -377,6 +520,34 @@ async def read_t3d_resource(filepath: str) -> str:
         logger.error(f"Error reading resource {uri}: {str(e)}", exc_info=True)
         return f"Error reading resource: {str(e)}"
 
+@mcp.resource("unreal+metrics://server")
+async def read_metrics_resource() -> str:
+    """Read server metrics from backend.
+    
+    Returns:
+        JSON with per-method and per-tool call counts, latency histograms and bytes out
+    """
+    uri = "unreal+metrics://server"
+    if unreal_client.state == ConnectionState.OFFLINE:
+        logger.warning(f"Backend unavailable for resource: {uri}")
+        return "Unreal MCP server is not available. Please ensure Unreal Editor is running and the UnrealMCPServer plugin is enabled."
+    
+    try:
+        response = await unreal_client.read_resource(uri)
+        if "error" in response:
+            error = response["error"]
+            logger.error(f"Backend returned error for resource {uri}: {error}")
+            return f"Error: {error.get('message', 'Unknown error')}"
+        
+        result = response.get("result", {})
+        contents = result.get("contents", [])
+        if contents and len(contents) > 0:
+            return contents[0].get("text", "")
+        return "Resource content not available"
+    except Exception as e:
+        logger.error(f"Error reading resource {uri}: {str(e)}", exc_info=True)
+        return f"Error reading resource: {str(e)}"
+
 # Conditionally register markdown resource handler based on enable_markdown_export setting
 if settings.enable_markdown_export:
     @mcp.resource("unreal+md://{filepath}")
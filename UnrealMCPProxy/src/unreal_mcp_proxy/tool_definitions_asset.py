@@ -113,6 +113,7 @@ def get_asset_tools(enable_markdown_export: bool = True) -> Dict[str, Dict[str,
         "Use this when exporting multiple assets of any type. Files are saved to disk at the specified output folder path. "
         "Format defaults to T3D. Each asset is exported to a separate file named after the asset. "
         "Returns array of successfully exported file paths. Failed exports are not included in the return value. "
+        "With outputMode 'ndjson' all assets go into one NDJSON file with a byte offset index instead, which is much faster for thousands of assets. "
         "NOTE: For Blueprint graph inspection, use export_blueprint_markdown instead, which is specifically designed for that purpose and provides clearer workflow guidance."
     )
     
@@ -141,6 +142,21 @@ def get_asset_tools(enable_markdown_export: bool = True) -> Dict[str, Dict[str,
                     "type": "string",
                     "description": batch_format_desc,
                     "default": "T3D"
+                },
+                "outputMode": {
+                    "type": "string",
+                    "description": "'files' (default) writes one file per asset. 'ndjson' streams every export into a single file in outputFolder, one {\"objectPath\", \"format\", \"text\"} JSON record per line, plus an index file with one {\"objectPath\", \"offset\", \"length\"} line per record (byte offset and length in the NDJSON file) so a single asset can be read without parsing the rest. Use 'ndjson' for large batches; exportedPaths is left empty and outputFile/indexFile are returned instead.",
+                    "enum": ["files", "ndjson"],
+                    "default": "files"
+                },
+                "outputFileName": {
+                    "type": "string",
+                    "description": "Name of the NDJSON file in outputFolder for outputMode 'ndjson'. Defaults to 'export.ndjson'; the index is written next to it as '<name>.index.ndjson'. Existing files are never overwritten: a number is appended instead (e.g. 'export_1.ndjson')."
+                },
+                "runAsJob": {
+                    "type": "boolean",
+                    "description": "Return a job id immediately instead of waiting for the result. Poll it with get_job_status and stop it with cancel_job.",
+                    "default": False
                 }
             },
             "required": ["objectPaths", "outputFolder"]
@@ -151,8 +167,10 @@ def get_asset_tools(enable_markdown_export: bool = True) -> Dict[str, Dict[str,
                 "bSuccess": {"type": "boolean", "description": "Whether the batch export operation was successful overall", "default": False},
                 "exportedCount": {"type": "number", "description": "Number of assets successfully exported", "default": 0},
                 "failedCount": {"type": "number", "description": "Number of assets that failed to export", "default": 0},
-                "exportedPaths": {"type": "array", "items": {"type": "string"}, "description": "Array of file paths for successfully exported assets", "default": []},
+                "exportedPaths": {"type": "array", "items": {"type": "string"}, "description": "Array of file paths for successfully exported assets (outputMode 'files' only)", "default": []},
                 "failedPaths": {"type": "array", "items": {"type": "string"}, "description": "Array of object paths that failed to export", "default": []},
+                "outputFile": {"type": "string", "description": "The NDJSON file holding every exported asset (outputMode 'ndjson' only)"},
+                "indexFile": {"type": "string", "description": "The index of outputFile: one {objectPath, offset, length} line per record (outputMode 'ndjson' only)"},
                 "error": {"type": "string", "description": "Error message if bSuccess is false"}
             },
             "required": ["bSuccess", "exportedCount", "failedCount"]
@@ -213,6 +231,11 @@ def get_asset_tools(enable_markdown_export: bool = True) -> Dict[str, Dict[str,
                 "classPath": {
                     "type": "string",
                     "description": "The class path of the object to import. C++ class format: '/Script/Engine.Texture2D', '/Script/Engine.StaticMesh', '/Script/Engine.SoundWave'. Blueprint class format: '/Game/Blueprints/BP_Player.BP_Player_C'. Examples: '/Script/Engine.Texture2D' (for textures), '/Script/Engine.StaticMesh' (for meshes), '/Script/Engine.SoundWave' (for sounds)."
+                },
+                "runAsJob": {
+                    "type": "boolean",
+                    "description": "Return a job id immediately instead of waiting for the result. Poll it with get_job_status and stop it with cancel_job.",
+                    "default": False
                 }
             },
             "required": ["packagePath", "classPath"]
@@ -232,10 +255,73 @@ def get_asset_tools(enable_markdown_export: bool = True) -> Dict[str, Dict[str,
         }
     }
     
+    # batch_import_assets
+    tools["batch_import_assets"] = {
+        "name": "batch_import_assets",
+        "description": "Import many files in one call, each with the arguments of import_asset (filePath and/or t3dFilePath, packagePath, classPath). All imports form one undo transaction. T3D property changes notify the editor (PostEditChange) once per asset after the last import instead of once per property, new assets are announced to the asset registry at the end, and the modified packages are saved together in one pass. Returns a result per asset in request order. Use this instead of repeated import_asset calls when changing many assets; run it with runAsJob for large batches.",
+        "inputSchema": {
+            "type": "object",
+            "properties": {
+                "assets": {
+                    "type": "array",
+                    "items": {
+                        "type": "object",
+                        "properties": {
+                            "filePath": {"type": "string", "description": "Binary file to import, as for import_asset. Optional if t3dFilePath is provided."},
+                            "t3dFilePath": {"type": "string", "description": "T3D file to import, as for import_asset. Optional if filePath is provided."},
+                            "packagePath": {"type": "string", "description": "Full object path of the asset, e.g. '/Game/Data/DA_Item.DA_Item'."},
+                            "classPath": {"type": "string", "description": "Class of the asset, e.g. '/Script/Engine.DataAsset' or '/Game/Blueprints/BP_Player.BP_Player_C'."}
+                        },
+                        "required": ["packagePath", "classPath"]
+                    },
+                    "description": "The imports to run, in order. Each is an object with the arguments of import_asset. The same path may appear more than once; later entries apply on top of earlier ones."
+                },
+                "bSave": {
+                    "type": "boolean",
+                    "description": "Save the packages of the imported assets once every import is done. Defaults to true. Packages whose file is read-only (e.g. not checked out) are reported as not saved.",
+                    "default": True
+                },
+                "runAsJob": {
+                    "type": "boolean",
+                    "description": "Return a job id immediately instead of waiting for the result. Poll it with get_job_status and stop it with cancel_job.",
+                    "default": False
+                }
+            },
+            "required": ["assets"]
+        },
+        "outputSchema": {
+            "type": "object",
+            "properties": {
+                "bSuccess": {"type": "boolean", "description": "Whether at least one asset was imported; check results for each asset", "default": False},
+                "importedCount": {"type": "number", "description": "Number of assets imported", "default": 0},
+                "failedCount": {"type": "number", "description": "Number of assets that failed to import", "default": 0},
+                "savedCount": {"type": "number", "description": "Number of imported assets whose package was saved", "default": 0},
+                "skippedCount": {"type": "number", "description": "Number of assets not attempted because the job was cancelled before the batch started", "default": 0},
+                "results": {
+                    "type": "array",
+                    "items": {
+                        "type": "object",
+                        "properties": {
+                            "packagePath": {"type": "string", "description": "Object path of the asset"},
+                            "bSuccess": {"type": "boolean", "description": "Whether the asset was imported"},
+                            "bSaved": {"type": "boolean", "description": "Whether its package was saved"},
+                            "importedObject": {"type": "string", "description": "Path of the imported object (if bSuccess is true)"},
+                            "error": {"type": "string", "description": "Why the import or save failed"}
+                        }
+                    },
+                    "description": "One entry per requested asset in request order",
+                    "default": []
+                },
+                "error": {"type": "string", "description": "Summary of failures, empty if every asset was imported and saved"}
+            },
+            "required": ["bSuccess", "importedCount", "failedCount", "results"]
+        }
+    }
+    
     # search_assets
     tools["search_assets"] = {
         "name": "search_assets",
-        "description": "Search for assets by package paths or package names, optionally filtered by class. Returns an array of asset information from the asset registry. More flexible than search_blueprints as it works with all asset types. REQUIRED: At least one of 'packagePaths' or 'packageNames' must be provided (non-empty array). Use packagePaths to search directories (e.g., '/Game/Blueprints' searches all assets in that folder), packageNames for exact or partial package matches (supports wildcards * and ?, or substring matching), and classPaths to filter by asset type (e.g., textures only). Returns array of asset information. Use bIncludeTags=true to get additional metadata tags. Use maxResults and offset for paging through large result sets. For large searches, use maxResults to limit results and offset for paging.",
+        "description": "Search for assets by package paths or package names, optionally filtered by class. Returns an array of asset information from the asset registry. More flexible than search_blueprints as it works with all asset types. REQUIRED: At least one of 'packagePaths' or 'packageNames' must be provided (non-empty array). Use packagePaths to search directories (e.g., '/Game/Blueprints' searches all assets in that folder), packageNames for exact or partial package matches (supports wildcards * and ?, or substring matching), and classPaths to filter by asset type (e.g., textures only). Returns array of asset information. Use bIncludeTags=true to get additional metadata tags. Use maxResults and offset for paging through large result sets. For large searches, use maxResults to limit results and pass each page's nextCursor as cursor to get the next page.",
         "inputSchema": {
             "type": "object",
             "properties": {
@@ -274,8 +360,12 @@ def get_asset_tools(enable_markdown_export: bool = True) -> Dict[str, Dict[str,
                 },
                 "offset": {
                     "type": "integer",
-                    "description": "Number of results to skip before returning results. Defaults to 0. Use with maxResults for paging: first page uses offset=0, second page uses offset=maxResults, etc.",
+                    "description": "Number of results to skip before returning results. Defaults to 0. Use with maxResults for paging: first page uses offset=0, second page uses offset=maxResults, etc. Prefer cursor for paging through large result sets.",
                     "default": 0
+                },
+                "cursor": {
+                    "type": "string",
+                    "description": "The nextCursor returned by the previous page. Pages through a server-side snapshot of the first page's results, so later pages are cheap; the search filters and offset are ignored when it is set, maxResults and bIncludeTags still apply. Cursors expire when unused for a while or when the asset registry changes; run the search again without a cursor then."
                 }
             },
             "required": [
@@ -308,7 +398,8 @@ def get_asset_tools(enable_markdown_export: bool = True) -> Dict[str, Dict[str,
                 "count": {"type": "integer", "description": "Number of assets returned in this page"},
                 "totalCount": {"type": "integer", "description": "Total number of assets found (before paging)"},
                 "offset": {"type": "integer", "description": "Offset used for this page"},
-                "hasMore": {"type": "boolean", "description": "Whether there are more results available (true if offset + count < totalCount)"}
+                "hasMore": {"type": "boolean", "description": "Whether there are more results available (true if offset + count < totalCount)"},
+                "nextCursor": {"type": "string", "description": "Pass as cursor to get the next page; absent on the last page"}
             },
             "required": ["assets", "count", "totalCount", "offset", "hasMore"]
         }
@@ -391,7 +482,7 @@ def get_asset_tools(enable_markdown_export: bool = True) -> Dict[str, Dict[str,
     # get_asset_dependency_tree
     tools["get_asset_dependency_tree"] = {
         "name": "get_asset_dependency_tree",
-        "description": "Get the complete dependency tree for a specified asset. Returns a recursive tree structure showing all dependencies and their dependencies. Use this for complete dependency mapping and recursive analysis. The tree includes depth information for each node. Very useful when doing asset searches and queries with existing tools. Supports both hard dependencies (direct references) and soft dependencies (searchable references). Use maxDepth to limit recursion depth and prevent infinite loops.",
+        "description": "Get the complete dependency tree for a specified asset. Returns a recursive tree structure showing all dependencies and their dependencies. Use this for complete dependency mapping and recursive analysis. The tree includes depth information for each node. Very useful when doing asset searches and queries with existing tools. Supports both hard dependencies (direct references) and soft dependencies (searchable references). Use maxDepth to limit recursion depth and prevent infinite loops. For assets with shared dependencies (material and Blueprint libraries), use outputMode 'dag' to get each package once with edges by node index, and maxNodes to bound the result.",
         "inputSchema": {
             "type": "object",
             "properties": {
@@ -413,6 +504,17 @@ def get_asset_tools(enable_markdown_export: bool = True) -> Dict[str, Dict[str,
                     "type": "boolean",
                     "description": "Whether to include soft dependencies (searchable references). Defaults to false. Soft dependencies are assets that are referenced via searchable references (e.g., string-based asset references).",
                     "default": False
+                },
+                "outputMode": {
+                    "type": "string",
+                    "enum": ["tree", "dag"],
+                    "description": "'tree' (default) returns the tree as a flat list of nodes, where a dependency shared by several assets appears once per path that reaches it. 'dag' walks the graph breadth-first and returns each package once in 'nodes', with its shortest depth from the root and its dependencies as indices into 'nodes'; much smaller and faster for heavily shared dependencies.",
+                    "default": "tree"
+                },
+                "maxNodes": {
+                    "type": "number",
+                    "description": "Maximum number of nodes to return. Defaults to 0 (no limit). When reached, the traversal stops adding nodes and bTruncated is set; in 'dag' mode nodes whose dependencies are incomplete have bDependenciesOmitted set.",
+                    "default": 0
                 }
             },
             "required": ["assetPath"]
@@ -427,16 +529,162 @@ def get_asset_tools(enable_markdown_export: bool = True) -> Dict[str, Dict[str,
                     "items": {
                         "type": "object"
                     },
-                    "description": "Array of dependency tree nodes, each containing assetPath, depth, and dependencies",
+                    "description": "Array of dependency tree nodes, each containing assetPath, depth, and dependencies. Empty in 'dag' mode",
+                    "default": []
+                },
+                "nodes": {
+                    "type": "array",
+                    "items": {
+                        "type": "object"
+                    },
+                    "description": "'dag' mode only: unique nodes in breadth-first order with the root first, each containing assetPath, depth (shortest from the root), dependencies (indices into nodes) and bDependenciesOmitted",
                     "default": []
                 },
                 "totalNodes": {"type": "number", "description": "Total number of nodes in the dependency tree", "default": 0},
                 "maxDepthReached": {"type": "number", "description": "Maximum depth reached in the dependency tree", "default": 0},
+                "bTruncated": {"type": "boolean", "description": "Whether maxNodes was reached before the traversal finished", "default": False},
                 "error": {"type": "string", "description": "Error message if bSuccess is false"}
             },
             "required": ["bSuccess", "assetPath", "tree", "totalNodes", "maxDepthReached"]
         }
     }
     
+    # batch_query_assets
+    tools["batch_query_assets"] = {
+        "name": "batch_query_assets",
+        "description": "Query many assets at once: the batch form of query_asset. Looks up every path with a single asset registry query and returns one compact, columnar result keyed by input path: row i of every column (exists, assetName, packagePath, classPath, objectPath, tags) describes assetPaths[i]. Missing assets are reported with exists false instead of failing the call. Prefer this over calling query_asset repeatedly.",
+        "inputSchema": {
+            "type": "object",
+            "properties": {
+                "assetPaths": {
+                    "type": "array",
+                    "items": {"type": "string"},
+                    "description": "Array of asset paths to query, in the formats query_asset accepts. Examples: ['/Game/MyAsset', '/Game/Blueprints/BP_Player.BP_Player', '/Engine/EditorMaterials/GridMaterial']. Duplicates are allowed and get their own row."
+                },
+                "bIncludeTags": {
+                    "type": "boolean",
+                    "description": "Whether to include asset tags in the response. Defaults to false. Set to true to fill the tags column with the metadata tags of each asset (e.g., 'ParentClass' for Blueprints, 'TextureGroup' for textures).",
+                    "default": False
+                }
+            },
+            "required": ["assetPaths"]
+        },
+        "outputSchema": {
+            "type": "object",
+            "properties": {
+                "assetPaths": {"type": "array", "items": {"type": "string"}, "description": "The queried asset paths in request order; row i of every other column belongs to assetPaths[i]", "default": []},
+                "exists": {"type": "array", "items": {"type": "boolean"}, "description": "Whether each asset exists", "default": []},
+                "assetName": {"type": "array", "items": {"type": "string"}, "description": "Name of each asset (empty if it doesn't exist)", "default": []},
+                "packagePath": {"type": "array", "items": {"type": "string"}, "description": "Package path of each asset (empty if it doesn't exist)", "default": []},
+                "classPath": {"type": "array", "items": {"type": "string"}, "description": "Class path of each asset (empty if it doesn't exist)", "default": []},
+                "objectPath": {"type": "array", "items": {"type": "string"}, "description": "Full object path of each asset (empty if it doesn't exist)", "default": []},
+                "tags": {"type": "array", "items": {"type": "object"}, "description": "Asset tags of each asset as {values: {tag: value}} (only if bIncludeTags was true)", "default": []},
+                "count": {"type": "number", "description": "Number of assets that exist", "default": 0}
+            },
+            "required": ["assetPaths", "exists", "count"]
+        }
+    }
+    
+    # batch_get_asset_dependencies and batch_get_asset_references share their output layout
+    batch_links_output_schema = {
+        "type": "object",
+        "properties": {
+            "assetPaths": {"type": "array", "items": {"type": "string"}, "description": "The queried asset paths in request order", "default": []},
+            "exists": {"type": "array", "items": {"type": "boolean"}, "description": "Whether each queried asset exists; missing assets have no links", "default": []},
+            "offsets": {"type": "array", "items": {"type": "number"}, "description": "assetPaths.length + 1 offsets into indices: the links of assetPaths[i] are indices[offsets[i]] up to, not including, indices[offsets[i + 1]]", "default": []},
+            "indices": {"type": "array", "items": {"type": "number"}, "description": "Indices into paths of the linked assets, grouped by queried asset", "default": []},
+            "paths": {"type": "array", "items": {"type": "string"}, "description": "Each distinct linked asset path once (the package name if the package has no assets)", "default": []},
+            "count": {"type": "number", "description": "Number of links over all queried assets", "default": 0}
+        },
+        "required": ["assetPaths", "exists", "offsets", "indices", "paths", "count"]
+    }
+    
+    # batch_get_asset_dependencies
+    tools["batch_get_asset_dependencies"] = {
+        "name": "batch_get_asset_dependencies",
+        "description": "Get the dependencies of many assets at once: the batch form of get_asset_dependencies. Resolves every path with a single asset registry query and turns each dependency package into an asset path once for the whole batch. Returns a compact, columnar result keyed by input path: every distinct dependency is listed once in 'paths', and the dependencies of assetPaths[i] are indices[offsets[i]] to indices[offsets[i + 1]] - 1, indices into 'paths'. Missing assets are reported with exists false instead of failing the call.",
+        "inputSchema": {
+            "type": "object",
+            "properties": {
+                "assetPaths": {
+                    "type": "array",
+                    "items": {"type": "string"},
+                    "description": "Array of asset paths to get dependencies for, in the formats get_asset_dependencies accepts. Examples: ['/Game/MyAsset', '/Game/Blueprints/BP_Player']."
+                },
+                "bIncludeHardDependencies": {
+                    "type": "boolean",
+                    "description": "Whether to include hard dependencies (direct references). Defaults to true.",
+                    "default": True
+                },
+                "bIncludeSoftDependencies": {
+                    "type": "boolean",
+                    "description": "Whether to include soft dependencies (searchable references). Defaults to false.",
+                    "default": False
+                }
+            },
+            "required": ["assetPaths"]
+        },
+        "outputSchema": batch_links_output_schema
+    }
+    
+    # batch_get_asset_references
+    tools["batch_get_asset_references"] = {
+        "name": "batch_get_asset_references",
+        "description": "Get the referencers of many assets at once: the batch form of get_asset_references. Resolves every path with a single asset registry query and turns each referencing package into an asset path once for the whole batch. Returns a compact, columnar result keyed by input path: every distinct referencer is listed once in 'paths', and the referencers of assetPaths[i] are indices[offsets[i]] to indices[offsets[i + 1]] - 1, indices into 'paths'. Missing assets are reported with exists false instead of failing the call.",
+        "inputSchema": {
+            "type": "object",
+            "properties": {
+                "assetPaths": {
+                    "type": "array",
+                    "items": {"type": "string"},
+                    "description": "Array of asset paths to get references for, in the formats get_asset_references accepts. Examples: ['/Game/MyAsset', '/Game/Blueprints/BP_Player']."
+                },
+                "bIncludeHardReferences": {
+                    "type": "boolean",
+                    "description": "Whether to include hard references (direct references). Defaults to true.",
+                    "default": True
+                },
+                "bIncludeSoftReferences": {
+                    "type": "boolean",
+                    "description": "Whether to include soft references (searchable references). Defaults to false.",
+                    "default": False
+                }
+            },
+            "required": ["assetPaths"]
+        },
+        "outputSchema": batch_links_output_schema
+    }
+    
+    # export_dependency_graph
+    tools["export_dependency_graph"] = {
+        "name": "export_dependency_graph",
+        "description": "Export the hard and soft package dependency graph of the whole project in one call, for build-impact analysis and cook-size audits. Writes a memory-mappable binary snapshot under the project's Saved/UnrealMCPServer/DependencyGraph folder: an interned table of package names plus compressed sparse row (CSR) adjacency arrays with hard/soft flags per edge. The file layout is documented in the tech spec. The first snapshot is built in the background once the asset registry has loaded; a call made before that build finishes waits for it (seconds on large projects). Returns the file path and the snapshot's generation. Pass that generation back as sinceGeneration to get only the packages whose dependencies changed since, as JSON, instead of a new file. Much faster than calling get_asset_dependencies for every asset.",
+        "inputSchema": {
+            "type": "object",
+            "properties": {
+                "sinceGeneration": {
+                    "type": "number",
+                    "description": "Generation of a snapshot you already have, or 0 for a full snapshot file. If the server still knows the changes since that generation, returns them as a delta (bDelta true) and writes no file; otherwise (for example after an editor restart) writes a full snapshot as if 0 was passed.",
+                    "default": 0
+                }
+            },
+            "required": ["sinceGeneration"]
+        },
+        "outputSchema": {
+            "type": "object",
+            "properties": {
+                "generation": {"type": "number", "description": "Generation of the returned snapshot or delta; pass it as sinceGeneration next time", "default": 0},
+                "bDelta": {"type": "boolean", "description": "Whether the result is a delta since sinceGeneration (changedPackages, removedPackages) rather than a full snapshot file", "default": False},
+                "filePath": {"type": "string", "description": "Absolute path of the binary snapshot file (full snapshots only)"},
+                "fileBytes": {"type": "number", "description": "Size of the snapshot file in bytes (full snapshots only)", "default": 0},
+                "packageCount": {"type": "number", "description": "Number of packages (nodes) in the graph", "default": 0},
+                "edgeCount": {"type": "number", "description": "Number of dependencies (edges) in the graph", "default": 0},
+                "changedPackages": {"type": "array", "items": {"type": "object"}, "description": "Delta only: packages that were added or whose dependencies may have changed, each with packageName, dependencies (package names) and edgeFlags (1 hard, 2 soft, 3 both)", "default": []},
+                "removedPackages": {"type": "array", "items": {"type": "string"}, "description": "Delta only: packages that no longer have assets. They stay in the graph as long as other packages depend on them", "default": []}
+            },
+            "required": ["generation", "bDelta", "packageCount", "edgeCount"]
+        }
+    }
+    
     return tools
 
@@ -25,18 +25,18 @@ def get_blueprint_tools(enable_markdown_export: bool = True) -> Dict[str, Dict[s
     # search_blueprints
     tools["search_blueprints"] = {
         "name": "search_blueprints",
-        "description": "Search for Blueprint assets based on various criteria including name patterns, parent classes, and package paths. Returns array of Blueprint asset information including paths, names, parent classes, and match details. Use 'name' searchType to find Blueprints by name pattern (e.g., 'BP_Player*'), 'parent_class' to find Blueprints that inherit from a class (e.g., 'Actor', 'Pawn', 'Character'), or 'all' for comprehensive search across all criteria.",
+        "description": "Search for Blueprint assets based on various criteria including name patterns, parent classes, and package paths. Returns array of Blueprint asset information including paths, names, parent classes, and match details. Use 'name' searchType to find Blueprints by name pattern (e.g., 'BP_Player*'), 'parent_class' to find Blueprints that inherit from a class (e.g., 'Actor', 'Pawn', 'Character'), 'function', 'variable', 'event', 'node_class' or 'interface' to find Blueprints by what their graphs contain, or 'all' for comprehensive search across all criteria. Graph content searches never load assets: they are answered from an index of Blueprints that were saved, loaded or indexed with index_blueprints, and report how many Blueprints in scope aren't indexed yet as unindexedCount. For large result sets, set maxResults and pass each page's nextCursor as cursor to get the next page.",
         "inputSchema": {
             "type": "object",
             "properties": {
                 "searchType": {
                     "type": "string",
-                    "enum": ["name", "parent_class", "all"],
-                    "description": "Type of search to perform. 'name': Find Blueprints by name pattern (e.g., 'BP_Player*' finds all Blueprints starting with 'BP_Player'). 'parent_class': Find Blueprints that inherit from a class (e.g., 'Actor', 'Pawn', 'Character'). 'all': Comprehensive search across all criteria."
+                    "enum": ["name", "parent_class", "function", "variable", "event", "node_class", "interface", "all"],
+                    "description": "Type of search to perform. 'name': Find Blueprints by name pattern (e.g., 'BP_Player*' finds all Blueprints starting with 'BP_Player'). 'parent_class': Find Blueprints that inherit from a class (e.g., 'Actor', 'Pawn', 'Character'). 'function': Find Blueprints that define or call a function (e.g., 'TakeDamage'). 'variable': Find Blueprints that declare or get/set a variable (e.g., 'Health'). 'event': Find Blueprints with an event or custom event node (e.g., 'ReceiveBeginPlay', 'OnDeath'). 'node_class': Find Blueprints using a graph node class (e.g., 'K2Node_Timeline'). 'interface': Find Blueprints implementing an interface (e.g., 'BPI_Interactable'). 'all': Comprehensive search across all criteria."
                 },
                 "searchTerm": {
                     "type": "string",
-                    "description": "Search term to match against. For 'name' type: Blueprint name pattern (e.g., 'BP_Player', 'Enemy'). For 'parent_class' type: Parent class name (e.g., 'Actor', 'Pawn', 'Character'). For 'all' type: Searches both name and parent class."
+                    "description": "Search term to match against. For 'name' type: Blueprint name pattern (e.g., 'BP_Player', 'Enemy'). For 'parent_class' type: Parent class name (e.g., 'Actor', 'Pawn', 'Character'). For the graph content types: part of the function, variable, event, node class or interface name, ignoring case. For 'all' type: Searches the name, parent class and graph content."
                 },
                 "packagePath": {
                     "type": "string",
@@ -54,8 +54,12 @@ def get_blueprint_tools(enable_markdown_export: bool = True) -> Dict[str, Dict[s
                 },
                 "offset": {
                     "type": "integer",
-                    "description": "Number of results to skip before returning results. Defaults to 0. Use with maxResults for paging: first page uses offset=0, second page uses offset=maxResults, etc.",
+                    "description": "Number of results to skip before returning results. Defaults to 0. Use with maxResults for paging: first page uses offset=0, second page uses offset=maxResults, etc. Prefer cursor for paging through large result sets.",
                     "default": 0
+                },
+                "cursor": {
+                    "type": "string",
+                    "description": "The nextCursor returned by the previous page. Pages through a server-side snapshot of the first page's matches, so later pages are cheap; the search criteria and offset of the first call are used when it is set, maxResults still applies. Cursors expire when unused for a while or when the asset registry changes; run the search again without a cursor then."
                 }
             },
             "required": ["searchType", "searchTerm"]
@@ -81,6 +85,8 @@ def get_blueprint_tools(enable_markdown_export: bool = True) -> Dict[str, Dict[s
                 "totalCount": {"type": "number", "description": "Total number of matching results"},
                 "offset": {"type": "number", "description": "Offset used for this page"},
                 "hasMore": {"type": "boolean", "description": "Whether there are more results available"},
+                "nextCursor": {"type": "string", "description": "Pass as cursor to get the next page; absent on the last page"},
+                "unindexedCount": {"type": "number", "description": "Graph content searches only, first page only: Blueprints in scope whose content isn't indexed yet and so can't match; run index_blueprints to cover them"},
                 "searchCriteria": {
                     "type": "object",
                     "description": "The search criteria used",
@@ -97,6 +103,48 @@ def get_blueprint_tools(enable_markdown_export: bool = True) -> Dict[str, Dict[s
         }
     }
     
+    # index_blueprints
+    tools["index_blueprints"] = {
+        "name": "index_blueprints",
+        "description": "Add the Blueprints that aren't indexed yet to the index behind the graph content searches of search_blueprints ('function', 'variable', 'event', 'node_class', 'interface'). Blueprints are indexed automatically when they are saved or loaded, and the index is kept across editor sessions, so this is only needed once per project (or after a large source control sync) to cover Blueprints nobody has opened. Loads each unindexed Blueprint in scope, one per editor tick; use runAsJob for large projects and poll get_job_status. Returns how many Blueprints were indexed.",
+        "inputSchema": {
+            "type": "object",
+            "properties": {
+                "packagePath": {
+                    "type": "string",
+                    "description": "Package path to limit indexing to, e.g. '/Game/Blueprints'. Use '/Game' for the whole project."
+                },
+                "bRecursive": {
+                    "type": "boolean",
+                    "description": "Whether to include subfolders of packagePath. Defaults to true.",
+                    "default": True
+                },
+                "maxBlueprints": {
+                    "type": "integer",
+                    "description": "Maximum number of Blueprints to load and index in this call. Defaults to 0 (no limit); the rest is reported as remainingCount.",
+                    "default": 0
+                },
+                "runAsJob": {
+                    "type": "boolean",
+                    "description": "Return a job id immediately instead of waiting for the result. Poll it with get_job_status and stop it with cancel_job.",
+                    "default": False
+                }
+            },
+            "required": ["packagePath"]
+        },
+        "outputSchema": {
+            "type": "object",
+            "properties": {
+                "indexedCount": {"type": "number", "description": "Number of Blueprints loaded and indexed", "default": 0},
+                "failedCount": {"type": "number", "description": "Number of Blueprints that failed to load, or have unsaved changes (those are indexed when they are saved)", "default": 0},
+                "alreadyIndexedCount": {"type": "number", "description": "Number of Blueprints in scope that were already indexed", "default": 0},
+                "remainingCount": {"type": "number", "description": "Number of unindexed Blueprints left because of maxBlueprints or a cancel", "default": 0},
+                "failedPaths": {"type": "array", "items": {"type": "string"}, "description": "Object paths of the Blueprints counted in failedCount", "default": []}
+            },
+            "required": ["indexedCount", "failedCount", "alreadyIndexedCount", "remainingCount"]
+        }
+    }
+    
     # export_blueprint_markdown
     export_bp_md_desc = (
         "Export Blueprint asset(s) to markdown format for graph inspection. "
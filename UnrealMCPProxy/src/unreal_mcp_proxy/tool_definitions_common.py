@@ -107,6 +107,67 @@ def get_common_tools(enable_markdown_export: bool = True) -> Dict[str, Dict[str,
         }
     }
     
+    # get_log_lines
+    tools["get_log_lines"] = {
+        "name": "get_log_lines",
+        "description": "Returns recent editor log lines from an in-memory buffer, without reading the log file. Every line has a sequence number; pass the returned nextCursor as cursor on the next call to get only the lines logged since. Call with cursor -1 before execute_console_command, request_editor_compile or an import to get a cursor, then again afterwards to see exactly what it logged. Filter by categories (e.g. ['LogBlueprint']), minVerbosity (e.g. 'Warning' for warnings and errors) and contains. The buffer keeps the most recent LogBufferLines lines (default 8192); missedLines reports lines that were overwritten before they were read.",
+        "inputSchema": {
+            "type": "object",
+            "properties": {
+                "cursor": {
+                    "type": "integer",
+                    "description": "nextCursor from the previous call. 0 (default) starts at the oldest line kept; -1 returns no lines, only the cursor for lines logged from now on.",
+                    "default": 0
+                },
+                "categories": {
+                    "type": "array",
+                    "items": {"type": "string"},
+                    "description": "Log categories to return, e.g. ['LogBlueprint', 'LogLiveCoding']. Empty (default) returns all categories.",
+                    "default": []
+                },
+                "minVerbosity": {
+                    "type": "string",
+                    "description": "Least severe verbosity to return: 'Fatal', 'Error', 'Warning', 'Display', 'Log', 'Verbose' or 'VeryVerbose'. 'Warning' returns warnings and errors. Empty (default) returns all."
+                },
+                "contains": {
+                    "type": "string",
+                    "description": "Only return lines containing this text, ignoring case."
+                },
+                "maxLines": {
+                    "type": "integer",
+                    "description": "Maximum number of lines to return (default 500, at most 5000). If more match, call again with nextCursor.",
+                    "default": 500
+                }
+            }
+        },
+        "outputSchema": {
+            "type": "object",
+            "properties": {
+                "lines": {
+                    "type": "array",
+                    "items": {
+                        "type": "object",
+                        "properties": {
+                            "sequence": {"type": "integer", "description": "Sequence number of the line"},
+                            "time": {"type": "number", "description": "Seconds since the editor started"},
+                            "category": {"type": "string", "description": "Log category"},
+                            "verbosity": {"type": "string", "description": "Verbosity, e.g. Warning"},
+                            "text": {"type": "string", "description": "The logged text"},
+                            "bTruncated": {"type": "boolean", "description": "Whether the text was cut at 1024 characters"}
+                        }
+                    },
+                    "description": "Matching lines in the order they were logged",
+                    "default": []
+                },
+                "nextCursor": {"type": "integer", "description": "Pass as cursor to get the lines logged after these"},
+                "missedLines": {"type": "integer", "description": "Lines after cursor that were overwritten in the buffer before they could be read", "default": 0},
+                "bufferCapacity": {"type": "integer", "description": "Number of lines the buffer keeps; 0 if it is disabled"},
+                "error": {"type": "string", "description": "Error message if the parameters were invalid"}
+            },
+            "required": ["lines", "nextCursor"]
+        }
+    }
+    
     # request_editor_compile
     tools["request_editor_compile"] = {
         "name": "request_editor_compile",
@@ -118,6 +179,11 @@ def get_common_tools(enable_markdown_export: bool = True) -> Dict[str, Dict[str,
                     "type": "number",
                     "description": "Optional timeout in seconds for waiting for compilation to complete. Default: 300 seconds (5 minutes). For large projects, you may need to increase this value. Compilation will be cancelled if it exceeds this timeout.",
                     "default": 300
+                },
+                "runAsJob": {
+                    "type": "boolean",
+                    "description": "Return a job id immediately instead of waiting for the result. Poll it with get_job_status and stop it with cancel_job.",
+                    "default": False
                 }
             },
             "required": ["timeoutSeconds"]
@@ -127,7 +193,7 @@ def get_common_tools(enable_markdown_export: bool = True) -> Dict[str, Dict[str,
             "properties": {
                 "bSuccess": {"type": "boolean", "description": "Whether the compilation completed successfully", "default": False},
                 "bCompileStarted": {"type": "boolean", "description": "Whether compilation was successfully initiated", "default": False},
-                "status": {"type": "string", "description": "Compilation status: 'completed', 'failed', 'timeout', 'not_available', or 'error'"},
+                "status": {"type": "string", "description": "Compilation status: 'completed', 'failed', 'timeout', 'cancelled', 'not_available', or 'error'"},
                 "buildLog": {"type": "string", "description": "Full build log output from the compilation"},
                 "errors": {"type": "array", "items": {"type": "string"}, "description": "Array of extracted error messages from the build log", "default": []},
                 "warnings": {"type": "array", "items": {"type": "string"}, "description": "Array of extracted warning messages from the build log", "default": []},
@@ -137,5 +203,65 @@ def get_common_tools(enable_markdown_export: bool = True) -> Dict[str, Dict[str,
         }
     }
     
+    # get_job_status
+    tools["get_job_status"] = {
+        "name": "get_job_status",
+        "description": "Get the status of a job started by calling a tool with runAsJob: true. Returns the status ('running', 'completed', 'failed' or 'cancelled'), the latest progress and, once the job is no longer running, the tool's result in 'result'. Poll this until the status is no longer 'running'. Finished jobs are kept for a limited time (10 minutes by default).",
+        "inputSchema": {
+            "type": "object",
+            "properties": {
+                "jobId": {
+                    "type": "string",
+                    "description": "The job id returned by a tool called with runAsJob: true."
+                }
+            },
+            "required": ["jobId"]
+        },
+        "outputSchema": {
+            "type": "object",
+            "properties": {
+                "jobId": {"type": "string", "description": "The job id"},
+                "toolName": {"type": "string", "description": "The tool the job is running"},
+                "status": {"type": "string", "description": "Job status: 'running', 'completed', 'failed' or 'cancelled'"},
+                "progress": {"type": "number", "description": "Progress reported by the tool so far", "default": 0},
+                "total": {"type": "number", "description": "Value progress counts up to, or 0 if unknown", "default": 0},
+                "message": {"type": "string", "description": "Latest progress message"},
+                "elapsedSeconds": {"type": "number", "description": "Seconds since the job started, up to when it finished", "default": 0},
+                "result": {"type": "object", "description": "Once the job is no longer running: the tools/call result of the job (content, isError and, for tools with an output schema, structuredContent)"}
+            },
+            "required": ["jobId", "status"]
+        }
+    }
+    
+    # cancel_job
+    tools["cancel_job"] = {
+        "name": "cancel_job",
+        "description": "Request cancellation of a running job started with runAsJob: true. The job stops at its next step and keeps the work it already finished (for example files already exported); poll get_job_status until the status is 'cancelled' to get the partial result. Cancelling a job that already finished has no effect. Returns the job status at the time of the request.",
+        "inputSchema": {
+            "type": "object",
+            "properties": {
+                "jobId": {
+                    "type": "string",
+                    "description": "The job id returned by a tool called with runAsJob: true."
+                }
+            },
+            "required": ["jobId"]
+        },
+        "outputSchema": {
+            "type": "object",
+            "properties": {
+                "jobId": {"type": "string", "description": "The job id"},
+                "toolName": {"type": "string", "description": "The tool the job is running"},
+                "status": {"type": "string", "description": "Job status: 'running', 'completed', 'failed' or 'cancelled'"},
+                "progress": {"type": "number", "description": "Progress reported by the tool so far", "default": 0},
+                "total": {"type": "number", "description": "Value progress counts up to, or 0 if unknown", "default": 0},
+                "message": {"type": "string", "description": "Latest progress message"},
+                "elapsedSeconds": {"type": "number", "description": "Seconds since the job started, up to when it finished", "default": 0},
+                "result": {"type": "object", "description": "Once the job is no longer running: the tools/call result of the job (content, isError and, for tools with an output schema, structuredContent)"}
+            },
+            "required": ["jobId", "status"]
+        }
+    }
+    
     return tools
 
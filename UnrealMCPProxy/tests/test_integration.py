@@ -26,23 +26,32 @@ from tests.test_assets import TEST_BLUEPRINT_PAWN, TEST_MATERIAL
 
 # Shared test constants
 EXPECTED_TOOLS = [
-    # Common tools (4)
+    # Common tools (7)
     "get_project_config",
     "execute_console_command",
     "get_log_file_path",
+    "get_log_lines",
     "request_editor_compile",
-    # Asset tools (9)
+    "get_job_status",
+    "cancel_job",
+    # Asset tools (14)
     "export_asset",
     "batch_export_assets",
     "export_class_default",
     "import_asset",
+    "batch_import_assets",
     "query_asset",
     "search_assets",
     "get_asset_dependencies",
     "get_asset_references",
     "get_asset_dependency_tree",
-    # Blueprint tools (2)
+    "batch_query_assets",
+    "batch_get_asset_dependencies",
+    "batch_get_asset_references",
+    "export_dependency_graph",
+    # Blueprint tools (3)
     "search_blueprints",
+    "index_blueprints",
     "export_blueprint_markdown"
 ]
 
@@ -124,9 +133,9 @@ async def test_all_tools_defined() -> bool:
         print(f"  [W] Extra tools (not in plugin): {', '.join(sorted(extra_tools))}")
     
     print(f"  [OK] All {len(EXPECTED_TOOLS)} expected tools are defined")
-    print(f"    Common tools: 4")
-    print(f"    Asset tools: 9")
-    print(f"    Blueprint tools: 2")
+    print(f"    Common tools: 7")
+    print(f"    Asset tools: 14")
+    print(f"    Blueprint tools: 3")
     
     return True
 
@@ -231,8 +240,8 @@ async def test_resource_definitions_file() -> bool:
         
         # Check for expected resource templates
         expected_templates = [
-            "unreal+t3d://{filepath}",
-            "unreal+md://{filepath}"
+            "unreal+t3d://{filepath}{?offset,length,block}",
+            "unreal+md://{filepath}{?offset,length}"
         ]
         
         template_uris = [t.get("uriTemplate", "") for t in templates]
@@ -731,7 +740,7 @@ async def test_resource_templates_list() -> bool:
         
         # Check for expected templates
         template_uris = [t.get("uriTemplate", "") for t in templates]
-        expected_templates = ["unreal+t3d://{filepath}", "unreal+md://{filepath}"]
+        expected_templates = ["unreal+t3d://{filepath}{?offset,length,block}", "unreal+md://{filepath}{?offset,length}"]
         found_templates = [uri for uri in expected_templates if uri in template_uris]
         
         if found_templates: